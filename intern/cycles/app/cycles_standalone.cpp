@@ -46,6 +46,7 @@ struct Options {
   SceneParams scene_params;
   SessionParams session_params;
   bool quiet;
+  bool server;
   bool show_help, interactive, pause;
   string output_filepath;
   string output_pass;
@@ -69,6 +70,12 @@ static void session_print(const string &str)
   fflush(stdout);
 }
 
+static void server_print(const string &str)
+{
+  /* Standard output is used for the replies to commands of the server. */
+  fprintf(stderr, "%s\n", str.c_str());
+}
+
 static void session_print_status()
 {
   string status, substatus;
@@ -140,7 +147,9 @@ static void session_init()
 
   if (!options.output_filepath.empty()) {
     options.session->set_output_driver(make_unique<OIIOOutputDriver>(
-        options.output_filepath, options.output_pass, session_print));
+        options.output_filepath,
+        options.output_pass,
+        options.server ? server_print : session_print));
   }
 
   if (options.session_params.background && !options.quiet) {
@@ -176,6 +185,97 @@ static void session_exit()
   }
 }
 
+/* Keep the session and its scene after the first render, and render again for commands read from
+ * the standard input. Only the changed data is updated on the device, so the scene is not loaded
+ * again, and the BVH and the kernels are reused. One command per line, every command is answered
+ * with a line starting with "ok" or "error":
+ *
+ * - `camera <12 floats>`: Set the camera to object transform, rows of a 3x4 matrix.
+ * - `samples <count>`: Set the number of samples.
+ * - `output <filepath>`: Set the file path the next render is written to.
+ * - `render`: Render and wait for the render to finish.
+ * - `quit`: Stop the server, same as the end of the input. */
+static void session_serve()
+{
+  char line[4096];
+  while (fgets(line, sizeof(line), stdin)) {
+    string command = line;
+    while (!command.empty() && (command.back() == '\n' || command.back() == '\r')) {
+      command.pop_back();
+    }
+
+    Transform matrix;
+    int samples;
+    if (command.empty()) {
+      continue;
+    }
+    else if (command == "quit") {
+      break;
+    }
+    else if (string_startswith(command, "camera ")) {
+      if (sscanf(command.c_str(),
+                 "camera %f %f %f %f %f %f %f %f %f %f %f %f",
+                 &matrix.x.x,
+                 &matrix.x.y,
+                 &matrix.x.z,
+                 &matrix.x.w,
+                 &matrix.y.x,
+                 &matrix.y.y,
+                 &matrix.y.z,
+                 &matrix.y.w,
+                 &matrix.z.x,
+                 &matrix.z.y,
+                 &matrix.z.z,
+                 &matrix.z.w) != 12)
+      {
+        printf("error: camera expects 12 values\n");
+      }
+      else {
+        thread_scoped_lock scene_lock(options.scene->mutex);
+        options.scene->camera->set_matrix(matrix);
+        options.scene->camera->need_flags_update = true;
+        options.scene->camera->need_device_update = true;
+        printf("ok\n");
+      }
+    }
+    else if (string_startswith(command, "samples ")) {
+      if (sscanf(command.c_str(), "samples %d", &samples) != 1 || samples < 1 ||
+          samples > Integrator::MAX_SAMPLES - options.session_params.sample_offset)
+      {
+        printf("error: invalid number of samples\n");
+      }
+      else {
+        options.session_params.samples = samples;
+        printf("ok\n");
+      }
+    }
+    else if (string_startswith(command, "output ")) {
+      options.output_filepath = command.substr(strlen("output "));
+      printf("ok\n");
+    }
+    else if (command == "render") {
+      if (!options.output_filepath.empty()) {
+        options.session->set_output_driver(make_unique<OIIOOutputDriver>(
+            options.output_filepath, options.output_pass, server_print));
+      }
+      options.session->reset(options.session_params, session_buffer_params());
+      options.session->start();
+      options.session->wait();
+
+      if (options.session->progress.get_error()) {
+        printf("error: %s\n", options.session->progress.get_error_message().c_str());
+      }
+      else {
+        printf("ok\n");
+      }
+    }
+    else {
+      printf("error: unknown command\n");
+    }
+    fflush(stdout);
+  }
+}
+
 #ifdef WITH_CYCLES_STANDALONE_GUI
 static void display_info(Progress &progress)
 {
@@ -408,9 +508,17 @@ static void options_parse(int argc, const char **argv)
              "--quiet",
              &options.quiet,
              "In background mode, don't print progress messages",
+             "--server",
+             &options.server,
+             "In background mode, keep the scene after rendering and read commands to update "
+             "the camera and render again from the standard input",
              "--samples %d",
              &options.session_params.samples,
              "Number of samples to render",
+             "--sample-offset %d",
+             &options.session_params.sample_offset,
+             "Number of samples to skip, to render parts of the samples of a frame on different "
+             "machines and combine them afterwards",
              "--output %s",
              &options.output_filepath,
              "File path to write output image",
@@ -494,6 +602,11 @@ static void options_parse(int argc, const char **argv)
   options.session_params.background = true;
 #endif
 
+  if (options.server) {
+    /* Standard output is used for the replies to commands. */
+    options.quiet = true;
+  }
+
   if (options.session_params.tile_size > 0) {
     options.session_params.use_auto_tile = true;
   }
@@ -529,6 +642,12 @@ static void options_parse(int argc, const char **argv)
     fprintf(stderr, "Invalid number of samples: %d\n", options.session_params.samples);
     exit(EXIT_FAILURE);
   }
+  else if (options.session_params.sample_offset < 0 ||
+           options.session_params.sample_offset >= Integrator::MAX_SAMPLES)
+  {
+    fprintf(stderr, "Invalid sample offset: %d\n", options.session_params.sample_offset);
+    exit(EXIT_FAILURE);
+  }
   else if (options.filepath == "") {
     fprintf(stderr, "No file path specified\n");
     exit(EXIT_FAILURE);
@@ -550,6 +669,9 @@ int main(int argc, const char **argv)
 #endif
     session_init();
     options.session->wait();
+    if (options.server) {
+      session_serve();
+    }
     session_exit();
 #ifdef WITH_CYCLES_STANDALONE_GUI
   }
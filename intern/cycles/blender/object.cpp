@@ -243,9 +243,11 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
     return NULL;
   }
 
-  /* Use task pool only for non-instances, since sync_dupli_particle accesses
-   * geometry. This restriction should be removed for better performance. */
-  TaskPool *object_geom_task_pool = (is_instance) ? NULL : geom_task_pool;
+  /* Don't use the task pool for particle instances, since sync_dupli_particle accesses the
+   * geometry. Instances from collections and geometry nodes have their geometry synced in
+   * parallel, same as regular objects. */
+  const bool is_particle_instance = is_instance && bool(b_instance.particle_system());
+  TaskPool *object_geom_task_pool = (is_particle_instance) ? NULL : geom_task_pool;
 
   /* key to lookup object */
   ObjectKey key(b_parent, persistent_id, b_ob_info.real_object, use_particle_hair);
@@ -312,6 +312,38 @@ struct BVHSpatialBin {
   __forceinline BVHSpatialBin() {}
 };
 
+/* BVH Spatial Bins
+ *
+ * Bins of all dimensions, for binning sub-ranges of references in parallel. */
+
+struct BVHSpatialBins {
+  BVHSpatialBin bins[3][BVHParams::NUM_SPATIAL_BINS];
+
+  static void clear(BVHSpatialBin bins[3][BVHParams::NUM_SPATIAL_BINS])
+  {
+    for (int dim = 0; dim < 3; dim++) {
+      for (int i = 0; i < BVHParams::NUM_SPATIAL_BINS; i++) {
+        BVHSpatialBin &bin = bins[dim][i];
+
+        bin.bounds = BoundBox::empty;
+        bin.enter = 0;
+        bin.exit = 0;
+      }
+    }
+  }
+
+  void merge(const BVHSpatialBins &other)
+  {
+    for (int dim = 0; dim < 3; dim++) {
+      for (int i = 0; i < BVHParams::NUM_SPATIAL_BINS; i++) {
+        bins[dim][i].bounds.grow(other.bins[dim][i].bounds);
+        bins[dim][i].enter += other.bins[dim][i].enter;
+        bins[dim][i].exit += other.bins[dim][i].exit;
+      }
+    }
+  }
+};
+
 /* BVH Spatial Storage
  *
  * The idea of this storage is have thread-specific storage for the spatial
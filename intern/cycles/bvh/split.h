@@ -89,6 +89,15 @@ class BVHSpatialSplit {
   const BVHUnaligned *unaligned_heuristic_;
   const Transform *aligned_space_;
 
+  /* Chop the references of [start, end) into the bins of all dimensions. */
+  void bin_references(const BVHBuild &builder,
+                      int start,
+                      int end,
+                      const float3 origin,
+                      const float3 binSize,
+                      const float3 invBinSize,
+                      BVHSpatialBin bins[3][BVHParams::NUM_SPATIAL_BINS]);
+
   /* Lower-level functions which calculates boundaries of left and right nodes
    * needed for spatial split.
    *
@@ -11,10 +11,14 @@
 #include "bvh/params.h"
 
 #include "util/boundbox.h"
+#include "util/tbb.h"
 #include "util/transform.h"
 
 CCL_NAMESPACE_BEGIN
 
+/* Number of references from which their aligned bounds are computed in parallel. */
+static const int BVH_UNALIGNED_PARALLEL_THRESHOLD = 16384;
+
 BVHUnaligned::BVHUnaligned(const vector<Object *> &objects) : objects_(objects) {}
 
 Transform BVHUnaligned::compute_aligned_space(const BVHObjectBinning &range,
@@ -100,19 +104,8 @@ BoundBox BVHUnaligned::compute_aligned_boundbox(const BVHObjectBinning &range,
                                                 const Transform &aligned_space,
                                                 BoundBox *cent_bounds) const
 {
-  BoundBox bounds = BoundBox::empty;
-  if (cent_bounds != NULL) {
-    *cent_bounds = BoundBox::empty;
-  }
-  for (int i = range.start(); i < range.end(); ++i) {
-    const BVHReference &ref = references[i];
-    BoundBox ref_bounds = compute_aligned_prim_boundbox(ref, aligned_space);
-    bounds.grow(ref_bounds);
-    if (cent_bounds != NULL) {
-      cent_bounds->grow(ref_bounds.center2());
-    }
-  }
-  return bounds;
+  return compute_aligned_boundbox(
+      static_cast<const BVHRange &>(range), references, aligned_space, cent_bounds);
 }
 
 BoundBox BVHUnaligned::compute_aligned_boundbox(const BVHRange &range,
@@ -120,19 +113,47 @@ BoundBox BVHUnaligned::compute_aligned_boundbox(const BVHRange &range,
                                                 const Transform &aligned_space,
                                                 BoundBox *cent_bounds) const
 {
-  BoundBox bounds = BoundBox::empty;
-  if (cent_bounds != NULL) {
-    *cent_bounds = BoundBox::empty;
-  }
-  for (int i = range.start(); i < range.end(); ++i) {
-    const BVHReference &ref = references[i];
-    BoundBox ref_bounds = compute_aligned_prim_boundbox(ref, aligned_space);
-    bounds.grow(ref_bounds);
-    if (cent_bounds != NULL) {
-      cent_bounds->grow(ref_bounds.center2());
+  /* Bounds of a sub-range of references, and bounds of their centers. */
+  struct AlignedBounds {
+    BoundBox bounds = BoundBox::empty;
+    BoundBox cent_bounds = BoundBox::empty;
+  };
+  auto grow_bounds = [&](const int start, const int end, AlignedBounds &result) {
+    for (int i = start; i < end; ++i) {
+      const BVHReference &ref = references[i];
+      BoundBox ref_bounds = compute_aligned_prim_boundbox(ref, aligned_space);
+      result.bounds.grow(ref_bounds);
+      result.cent_bounds.grow(ref_bounds.center2());
     }
+  };
+
+  AlignedBounds result;
+  if (range.size() < BVH_UNALIGNED_PARALLEL_THRESHOLD) {
+    grow_bounds(range.start(), range.end(), result);
   }
-  return bounds;
+  else {
+    /* Fitting curve segments to the aligned space is expensive, and it is done for every node
+     * with curves, starting with the nodes at the top of the hierarchy which contain all of
+     * them. Growing bounds is order independent, so the result is the same as fitting the
+     * references one after another. */
+    result = parallel_reduce(
+        blocked_range<int>(range.start(), range.end(), 1024),
+        AlignedBounds(),
+        [&](const blocked_range<int> &r, AlignedBounds local) {
+          grow_bounds(r.begin(), r.end(), local);
+          return local;
+        },
+        [](AlignedBounds a, const AlignedBounds &b) {
+          a.bounds.grow(b.bounds);
+          a.cent_bounds.grow(b.cent_bounds);
+          return a;
+        });
+  }
+
+  if (cent_bounds != NULL) {
+    *cent_bounds = result.cent_bounds;
+  }
+  return result.bounds;
 }
 
 Transform BVHUnaligned::compute_node_transform(const BoundBox &bounds,
@@ -56,6 +56,7 @@ PathTrace::PathTrace(Device *device,
 
   work_balance_infos_.resize(path_trace_works_.size());
   work_balance_do_initial(work_balance_infos_);
+  work_path_trace_time_.resize(path_trace_works_.size(), 0.0);
 
   render_scheduler.set_need_schedule_rebalance(path_trace_works_.size() > 1);
 }
@@ -135,6 +136,9 @@ void PathTrace::reset(const BufferParams &full_params,
   render_state_.tile_written = false;
 
   did_draw_after_reset_ = false;
+
+  std::fill(work_path_trace_time_.begin(), work_path_trace_time_.end(), 0.0);
+  path_trace_time_ = 0.0;
 }
 
 void PathTrace::device_free()
@@ -408,6 +412,7 @@ void PathTrace::path_trace(RenderWork &render_work)
     const double work_time = time_dt() - work_start_time;
     work_balance_infos_[i].time_spent += work_time;
     work_balance_infos_[i].occupancy = statistics.occupancy;
+    work_path_trace_time_[i] += work_time;
 
     VLOG_INFO << "Rendered " << num_samples << " samples in " << work_time << " seconds ("
               << work_time / num_samples
@@ -421,6 +426,7 @@ void PathTrace::path_trace(RenderWork &render_work)
   const float occupancy = occupancy_accum / num_works;
   render_scheduler_.report_path_trace_occupancy(render_work, occupancy);
 
+  path_trace_time_ += time_dt() - start_time;
   render_scheduler_.report_path_trace_time(
       render_work, time_dt() - start_time, is_cancel_requested());
 }
@@ -1274,6 +1280,31 @@ static string path_trace_devices_report(const vector<unique_ptr<PathTraceWork>>
   return device_info_list_report("Path tracing on", device_info);
 }
 
+static string path_trace_devices_utilization_report(
+    const vector<unique_ptr<PathTraceWork>> &path_trace_works,
+    const vector<WorkBalanceInfo> &work_balance_infos,
+    const vector<double> &work_path_trace_time,
+    const double path_trace_time)
+{
+  if (path_trace_works.size() < 2 || path_trace_time == 0.0) {
+    return "";
+  }
+
+  /* Devices wait for each other at the end of every path tracing step, so the utilization shows
+   * how well the work is balanced between them. */
+  string result = "\nPath tracing devices utilization:\n";
+  result += string_printf("  %-40s %12s %12s %12s\n", "", "Time", "Utilization", "Weight");
+  for (int i = 0; i < path_trace_works.size(); i++) {
+    result += string_printf("  %-40s %12f %11.1f%% %12f\n",
+                            path_trace_works[i]->get_device()->info.description.c_str(),
+                            work_path_trace_time[i],
+                            100.0 * work_path_trace_time[i] / path_trace_time,
+                            work_balance_infos[i].weight);
+  }
+
+  return result;
+}
+
 static string denoiser_device_report(const Denoiser *denoiser)
 {
   if (!denoiser) {
@@ -1297,6 +1328,8 @@ string PathTrace::full_report() const
   string result = "\nFull path tracing report\n";
 
   result += path_trace_devices_report(path_trace_works_);
+  result += path_trace_devices_utilization_report(
+      path_trace_works_, work_balance_infos_, work_path_trace_time_, path_trace_time_);
   result += denoiser_device_report(denoiser_.get());
 
   /* Report from the render scheduler, which includes:
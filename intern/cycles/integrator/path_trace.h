@@ -278,6 +278,11 @@ class PathTrace {
   /* Per-path trace work information needed for multi-device balancing. */
   vector<WorkBalanceInfo> work_balance_infos_;
 
+  /* Time every path trace work spent rendering samples since the last reset, and the wall time
+   * of the path tracing they were part of. Used to report the utilization of the devices. */
+  vector<double> work_path_trace_time_;
+  double path_trace_time_ = 0.0;
+
   /* Render buffer parameters of the full frame and current big tile. */
   BufferParams full_params_;
   BufferParams big_tile_params_;
@@ -560,6 +560,9 @@ class AlembicProcedural : public Procedural {
    * Object Nodes in the Cycles scene if none exist yet. */
   void read_subd(AlembicObject *abc_object, Alembic::AbcGeom::Abc::chrono_t frame_time);
 
+  /* Load the data of the object for all the frames it is needed for, if it is not cached yet. */
+  void build_cache(AlembicObject *object, Progress *progress);
+
   void build_caches(Progress &progress);
 
   size_t get_prefetch_cache_size_in_bytes() const
@@ -304,7 +304,7 @@ bool ImageLoader::is_vdb_loader() const
 
 /* Image Manager */
 
-ImageManager::ImageManager(const DeviceInfo &info)
+ImageManager::ImageManager(const DeviceInfo &info, const int texture_limit)
 {
   need_update_ = true;
   osl_texture_system = NULL;
@@ -312,6 +312,7 @@ ImageManager::ImageManager(const DeviceInfo &info)
 
   /* Set image limits */
   features.has_nanovdb = info.has_nanovdb;
+  features.texture_limit = texture_limit;
 }
 
 ImageManager::~ImageManager()
@@ -90,6 +90,9 @@ class ImageMetaData {
 class ImageDeviceFeatures {
  public:
   bool has_nanovdb;
+  /* Maximum width, height and depth of images, zero when not limited. Images that are bigger
+   * are scaled down, loaders can report a smaller resolution that is stored in the file. */
+  int texture_limit;
 };
 
 /* Image loader base class, that can be subclassed to load image data
@@ -169,7 +172,7 @@ class ImageHandle {
  * texture images and 3D volume images. */
 class ImageManager {
  public:
-  explicit ImageManager(const DeviceInfo &info);
+  ImageManager(const DeviceInfo &info, int texture_limit);
   ~ImageManager();
 
   ImageHandle add_image(const string &filename, const ImageParams &params);
@@ -510,6 +510,56 @@ void LightTree::recursive_build(const Child child,
   }
 }
 
+/* Number of emitters of which the buckets are filled by one task. Ranges that are larger are
+ * split into chunks of this size, which are filled in parallel and merged in order afterwards.
+ * The measures are not exactly associative, so the chunks don't depend on the number of threads
+ * to keep the tree the same between builds. */
+static const int LIGHT_TREE_BUCKETS_CHUNK_SIZE = 8192;
+
+using LightTreeBuckets = std::array<LightTreeBucket, LightTreeBucket::num_buckets>;
+
+static void fill_buckets(const LightTreeEmitter *emitters,
+                         const int start,
+                         const int end,
+                         const int dim,
+                         const float centroid_min,
+                         const float inv_extent,
+                         LightTreeBuckets &buckets)
+{
+  auto fill = [&](const int chunk_start, const int chunk_end, LightTreeBuckets &chunk_buckets) {
+    for (int i = chunk_start; i < chunk_end; i++) {
+      const LightTreeEmitter *emitter = emitters + i;
+
+      /* Place emitter into the appropriate bucket, where the centroid box is split into equal
+       * partitions. */
+      int bucket_idx = LightTreeBucket::num_buckets * (emitter->centroid[dim] - centroid_min) *
+                       inv_extent;
+      bucket_idx = clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
+
+      chunk_buckets[bucket_idx].add(*emitter);
+    }
+  };
+
+  const int num_emitters = end - start;
+  if (num_emitters < 2 * LIGHT_TREE_BUCKETS_CHUNK_SIZE) {
+    fill(start, end, buckets);
+    return;
+  }
+
+  const int num_chunks = divide_up(num_emitters, LIGHT_TREE_BUCKETS_CHUNK_SIZE);
+  vector<LightTreeBuckets> chunk_buckets(num_chunks);
+  parallel_for(0, num_chunks, [&](const int chunk) {
+    const int chunk_start = start + chunk * LIGHT_TREE_BUCKETS_CHUNK_SIZE;
+    const int chunk_end = min(chunk_start + LIGHT_TREE_BUCKETS_CHUNK_SIZE, end);
+    fill(chunk_start, chunk_end, chunk_buckets[chunk]);
+  });
+  for (const LightTreeBuckets &chunk : chunk_buckets) {
+    for (int i = 0; i < LightTreeBucket::num_buckets; i++) {
+      buckets[i] = buckets[i] + chunk[i];
+    }
+  }
+}
+
 bool LightTree::should_split(LightTreeEmitter *emitters,
                              const int start,
                              int &middle,
@@ -551,18 +601,8 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
     const float inv_extent = 1 / (centroid_bbox.size()[dim]);
 
     /* Fill in buckets with emitters. */
-    std::array<LightTreeBucket, LightTreeBucket::num_buckets> buckets;
-    for (int i = start; i < end; i++) {
-      const LightTreeEmitter *emitter = emitters + i;
-
-      /* Place emitter into the appropriate bucket, where the centroid box is split into equal
-       * partitions. */
-      int bucket_idx = LightTreeBucket::num_buckets *
-                       (emitter->centroid[dim] - centroid_bbox.min[dim]) * inv_extent;
-      bucket_idx = clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
-
-      buckets[bucket_idx].add(*emitter);
-    }
+    LightTreeBuckets buckets;
+    fill_buckets(emitters, start, end, dim, centroid_bbox.min[dim], inv_extent, buckets);
 
     /* Precompute the left bucket measure cumulatively. */
     std::array<LightTreeBucket, LightTreeBucket::num_buckets - 1> left_buckets;
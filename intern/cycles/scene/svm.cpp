@@ -27,7 +27,10 @@ SVMShaderManager::SVMShaderManager() {}
 
 SVMShaderManager::~SVMShaderManager() {}
 
-void SVMShaderManager::reset(Scene * /*scene*/) {}
+void SVMShaderManager::reset(Scene * /*scene*/)
+{
+  compiled_shaders_.clear();
+}
 
 void SVMShaderManager::device_update_shader(Scene *scene,
                                             Shader *shader,
@@ -73,19 +76,37 @@ void SVMShaderManager::device_update_specific(Device *device,
   /* test if we need to update */
   device_free(device, dscene, scene);
 
-  /* Build all shaders. */
+  /* Build all shaders which were modified since the previous update, the nodes of the other
+   * shaders are taken from the previous update. */
   TaskPool task_pool;
   vector<array<int4>> shader_svm_nodes(num_shaders);
+  vector<bool> shader_background(num_shaders);
+  int num_compiled_shaders = 0;
   for (int i = 0; i < num_shaders; i++) {
+    Shader *shader = scene->shaders[i];
+    shader_background[i] = (shader == scene->background->get_shader(scene));
+
+    auto it = compiled_shaders_.find(shader);
+    if (!shader->is_modified() && it != compiled_shaders_.end() &&
+        it->second.background == shader_background[i] && it->second.svm_nodes.size() != 0)
+    {
+      shader_svm_nodes[i].steal_data(it->second.svm_nodes);
+      continue;
+    }
+
     task_pool.push(function_bind(&SVMShaderManager::device_update_shader,
                                  this,
                                  scene,
-                                 scene->shaders[i],
+                                 shader,
                                  &progress,
                                  &shader_svm_nodes[i]));
+    num_compiled_shaders++;
   }
   task_pool.wait_work();
 
+  /* Nodes taken from the cache are not stored back, the cache is rebuilt below. */
+  compiled_shaders_.clear();
+
   if (progress.get_cancel()) {
     return;
   }
@@ -132,6 +153,13 @@ void SVMShaderManager::device_update_specific(Device *device,
     svm_nodes += shader_size;
   }
 
+  /* Keep the nodes for the next update, shaders which were removed from the scene are dropped. */
+  for (int i = 0; i < num_shaders; i++) {
+    CompiledShader &compiled = compiled_shaders_[scene->shaders[i]];
+    compiled.svm_nodes.steal_data(shader_svm_nodes[i]);
+    compiled.background = shader_background[i];
+  }
+
   if (progress.get_cancel()) {
     return;
   }
@@ -142,8 +170,8 @@ void SVMShaderManager::device_update_specific(Device *device,
 
   update_flags = UPDATE_NONE;
 
-  VLOG_INFO << "Shader manager updated " << num_shaders << " shaders in " << time_dt() - start_time
-            << " seconds.";
+  VLOG_INFO << "Shader manager updated " << num_shaders << " shaders (" << num_compiled_shaders
+            << " compiled) in " << time_dt() - start_time << " seconds.";
 }
 
 void SVMShaderManager::device_free(Device *device, DeviceScene *dscene, Scene *scene)
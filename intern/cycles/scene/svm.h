@@ -10,6 +10,7 @@
 #include "scene/shader_graph.h"
 
 #include "util/array.h"
+#include "util/map.h"
 #include "util/set.h"
 #include "util/string.h"
 #include "util/thread.h"
@@ -45,6 +46,16 @@ class SVMShaderManager : public ShaderManager {
                             Shader *shader,
                             Progress *progress,
                             array<int4> *svm_nodes);
+
+  /* Nodes of every shader compiled in the previous update, reused as long as the shader is not
+   * modified, so that only edited shaders are compiled again between frames and during
+   * interactive updates. */
+  struct CompiledShader {
+    array<int4> svm_nodes;
+    /* The background shader is compiled differently. */
+    bool background = false;
+  };
+  unordered_map<const Shader *, CompiledShader> compiled_shaders_;
 };
 
 /* Graph Compiler */
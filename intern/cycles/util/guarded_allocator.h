@@ -48,6 +48,7 @@ template<typename T> class GuardedAllocator {
      * far as i concerned. We might over-align on 32bit here, but that should
      * be all safe actually.
      */
+    MEM_ScopedCategory memory_category(MEM_CATEGORY_CYCLES);
     mem = (T *)MEM_mallocN_aligned(size, 16, "Cycles Alloc");
 #else
     mem = (T *)malloc(size);
@@ -148,6 +148,13 @@ enum MemHeadFlag {
   MEMHEAD_FLAG_FROM_CPP_NEW = 1 << 1,
 };
 
+/**
+ * The memory category of the block (see #MEM_category_set) is stored in the high byte of
+ * #MemHead::flag.
+ */
+#define MEMHEAD_CATEGORY_SHIFT 8
+#define MEMHEAD_CATEGORY(memhead) uint8_t((memhead)->flag >> MEMHEAD_CATEGORY_SHIFT)
+
 typedef struct MemTail {
   int tag3, pad;
 } MemTail;
@@ -501,7 +508,10 @@ static void make_memhead_header(MemHead *memh,
   memh->name = str;
   memh->nextname = nullptr;
   memh->len = len;
-  memh->flag = (allocation_type == AllocationType::NEW_DELETE ? MEMHEAD_FLAG_FROM_CPP_NEW : 0);
+  const uint8_t category = memory_category_for_new_block();
+  memh->flag = uint16_t(
+      (allocation_type == AllocationType::NEW_DELETE ? MEMHEAD_FLAG_FROM_CPP_NEW : 0) |
+      (category << MEMHEAD_CATEGORY_SHIFT));
   memh->alignment = 0;
   memh->tag2 = MEMTAG2;
 
@@ -518,6 +528,9 @@ static void make_memhead_header(MemHead *memh,
 
   atomic_add_and_fetch_u(&totblock, 1);
   atomic_add_and_fetch_z(&mem_in_use, len);
+  if (category) {
+    memory_usage_category_alloc(category, len);
+  }
 
   mem_lock_thread();
   addtail(membase, &memh->next);
@@ -1166,6 +1179,9 @@ static void rem_memblock(MemHead *memh)
 
   atomic_sub_and_fetch_u(&totblock, 1);
   atomic_sub_and_fetch_z(&mem_in_use, memh->len);
+  if (const uint8_t category = MEMHEAD_CATEGORY(memh)) {
+    memory_usage_category_free(category, memh->len);
+  }
 
 #ifdef DEBUG_MEMDUPLINAME
   if (memh->need_free_name)
@@ -80,6 +80,8 @@ size_t malloc_usable_size(void *ptr);
 
 #include "mallocn_inline.hh"
 
+#include <atomic>
+
 #define ALIGNED_MALLOC_MINIMUM_ALIGNMENT sizeof(void *)
 
 void *aligned_malloc(size_t size, size_t alignment);
@@ -96,6 +98,46 @@ size_t memory_usage_current(void);
 size_t memory_usage_peak(void);
 void memory_usage_peak_reset(void);
 
+/**
+ * Memory categories are stored per block in a few bits of its header. Blocks of
+ * #MEM_CATEGORY_OTHER are not counted separately, so that there is no overhead when categories
+ * are not in use.
+ */
+extern std::atomic<bool> memory_categories_enabled;
+extern thread_local uint8_t memory_category_current;
+
+/** \return The category to store in the header of a newly allocated block. */
+inline uint8_t memory_category_for_new_block()
+{
+  if (LIKELY(!memory_categories_enabled.load(std::memory_order_relaxed))) {
+    return MEM_CATEGORY_OTHER;
+  }
+  return memory_category_current;
+}
+
+void memory_usage_category_alloc(uint8_t category, size_t size);
+void memory_usage_category_free(uint8_t category, size_t size);
+
+/**
+ * Size class allocator for small blocks, used by the lock-free allocator when enabled, see
+ * #MEM_use_size_class_allocator. Sizes include the #MemHead. Blocks are aligned to 16 bytes.
+ */
+#define SIZE_CLASS_MAX_SIZE size_t(1024)
+#define SIZE_CLASS_ALIGNMENT size_t(16)
+extern std::atomic<bool> size_class_allocator_enabled;
+
+inline bool size_class_use_for(const size_t size)
+{
+  return size <= SIZE_CLASS_MAX_SIZE &&
+         size_class_allocator_enabled.load(std::memory_order_relaxed);
+}
+
+/** \return Null when the block has to be allocated by the system allocator instead. */
+void *size_class_alloc(size_t size);
+void size_class_free(void *ptr, size_t size);
+/** Memory reserved by the size class allocator, including unused blocks. */
+size_t size_class_slabs_memory();
+
 /**
  * Clear the listbase of allocated memory blocks.
  *
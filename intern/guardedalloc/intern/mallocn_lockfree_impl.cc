@@ -67,12 +67,29 @@ enum {
   MEMHEAD_FLAG_MASK = (1 << 2) - 1
 };
 
+/**
+ * The highest byte of the `len` member is never used by actual allocation sizes. It stores the
+ * memory category of the block (see #MEM_category_set) and whether the block was allocated by
+ * the size class allocator (see #MEM_use_size_class_allocator).
+ */
+#define MEMHEAD_CATEGORY_SHIFT 56
+static_assert(sizeof(size_t) == 8, "Memory categories require 64-bit sizes");
+static_assert(MEM_CATEGORY_NUM <= 128, "Memory category does not fit into MemHead");
+#define MEMHEAD_CATEGORY_MASK (size_t(0x7F) << MEMHEAD_CATEGORY_SHIFT)
+#define MEMHEAD_FLAG_SIZE_CLASS (size_t(1) << 63)
+
 #define MEMHEAD_FROM_PTR(ptr) (((MemHead *)ptr) - 1)
 #define PTR_FROM_MEMHEAD(memhead) (memhead + 1)
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & size_t(MEMHEAD_FLAG_ALIGN))
 #define MEMHEAD_IS_FROM_CPP_NEW(memhead) ((memhead)->len & size_t(MEMHEAD_FLAG_FROM_CPP_NEW))
-#define MEMHEAD_LEN(memhead) ((memhead)->len & ~size_t(MEMHEAD_FLAG_MASK))
+#define MEMHEAD_IS_SIZE_CLASS(memhead) ((memhead)->len & MEMHEAD_FLAG_SIZE_CLASS)
+#define MEMHEAD_LEN(memhead) \
+  ((memhead)->len & \
+   ~(size_t(MEMHEAD_FLAG_MASK) | MEMHEAD_CATEGORY_MASK | MEMHEAD_FLAG_SIZE_CLASS))
+#define MEMHEAD_CATEGORY(memhead) \
+  uint8_t(((memhead)->len & MEMHEAD_CATEGORY_MASK) >> MEMHEAD_CATEGORY_SHIFT)
+#define MEMHEAD_CATEGORY_BITS(category) (size_t(category) << MEMHEAD_CATEGORY_SHIFT)
 
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 0)))
@@ -161,19 +178,51 @@ void MEM_lockfree_freeN(void *vmemh, AllocationType allocation_type)
   }
 
   memory_usage_block_free(len);
+  if (const uint8_t category = MEMHEAD_CATEGORY(memh)) {
+    memory_usage_category_free(category, len);
+  }
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
   }
   if (UNLIKELY(MEMHEAD_IS_ALIGNED(memh))) {
     MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
-    aligned_free(MEMHEAD_REAL_PTR(memh_aligned));
+    if (MEMHEAD_IS_SIZE_CLASS(memh)) {
+      const size_t padding = MEMHEAD_ALIGN_PADDING(memh_aligned->alignment);
+      size_class_free(MEMHEAD_REAL_PTR(memh_aligned), len + padding + sizeof(MemHeadAligned));
+    }
+    else {
+      aligned_free(MEMHEAD_REAL_PTR(memh_aligned));
+    }
+  }
+  else if (MEMHEAD_IS_SIZE_CLASS(memh)) {
+    size_class_free(memh, len + sizeof(MemHead));
   }
   else {
     free(memh);
   }
 }
 
+/**
+ * Allocate a block with the size class allocator if it is enabled and the block is small enough.
+ * Otherwise the system allocator is used through `system_alloc`.
+ * \param r_size_class_flag: #MEMHEAD_FLAG_SIZE_CLASS when the size class allocator was used.
+ */
+template<typename SystemAllocFn>
+static void *mem_lockfree_alloc_block(const size_t size,
+                                      size_t *r_size_class_flag,
+                                      const SystemAllocFn &system_alloc)
+{
+  if (size_class_use_for(size)) {
+    if (void *ptr = size_class_alloc(size)) {
+      *r_size_class_flag = MEMHEAD_FLAG_SIZE_CLASS;
+      return ptr;
+    }
+  }
+  *r_size_class_flag = 0;
+  return system_alloc();
+}
+
 void *MEM_lockfree_dupallocN(const void *vmemh)
 {
   void *newp = nullptr;
@@ -297,11 +346,21 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+  const size_t size = len + sizeof(MemHead);
+  size_t size_class_flag;
+  memh = (MemHead *)mem_lockfree_alloc_block(
+      size, &size_class_flag, [&]() { return calloc(1, size); });
 
   if (LIKELY(memh)) {
-    memh->len = len;
+    if (size_class_flag) {
+      memset(memh + 1, 0, len);
+    }
+    const uint8_t category = memory_category_for_new_block();
+    memh->len = len | MEMHEAD_CATEGORY_BITS(category) | size_class_flag;
     memory_usage_block_alloc(len);
+    if (category) {
+      memory_usage_category_alloc(category, len);
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -339,7 +398,10 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 #endif
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)malloc(len + sizeof(MemHead));
+  const size_t size = len + sizeof(MemHead);
+  size_t size_class_flag;
+  memh = (MemHead *)mem_lockfree_alloc_block(
+      size, &size_class_flag, [&]() { return malloc(size); });
 
   if (LIKELY(memh)) {
 
@@ -357,8 +419,12 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 #endif /* WITH_MEM_VALGRIND */
     }
 
-    memh->len = len;
+    const uint8_t category = memory_category_for_new_block();
+    memh->len = len | MEMHEAD_CATEGORY_BITS(category) | size_class_flag;
     memory_usage_block_alloc(len);
+    if (category) {
+      memory_usage_category_alloc(category, len);
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -417,8 +483,16 @@ void *MEM_lockfree_mallocN_aligned(size_t len,
 #endif
   len = SIZET_ALIGN_4(len);
 
-  MemHeadAligned *memh = (MemHeadAligned *)aligned_malloc(
-      len + extra_padding + sizeof(MemHeadAligned), alignment);
+  const size_t size = len + extra_padding + sizeof(MemHeadAligned);
+  size_t size_class_flag = 0;
+  MemHeadAligned *memh;
+  if (alignment <= SIZE_CLASS_ALIGNMENT) {
+    memh = (MemHeadAligned *)mem_lockfree_alloc_block(
+        size, &size_class_flag, [&]() { return aligned_malloc(size, alignment); });
+  }
+  else {
+    memh = (MemHeadAligned *)aligned_malloc(size, alignment);
+  }
 
   if (LIKELY(memh)) {
     /* We keep padding in the beginning of MemHead,
@@ -441,11 +515,16 @@ void *MEM_lockfree_mallocN_aligned(size_t len,
 #endif /* WITH_MEM_VALGRIND */
     }
 
+    const uint8_t category = memory_category_for_new_block();
     memh->len = len | size_t(MEMHEAD_FLAG_ALIGN) |
                 size_t(allocation_type == AllocationType::NEW_DELETE ? MEMHEAD_FLAG_FROM_CPP_NEW :
-                                                                       0);
+                                                                       0) |
+                MEMHEAD_CATEGORY_BITS(category) | size_class_flag;
     memh->alignment = short(alignment);
     memory_usage_block_alloc(len);
+    if (category) {
+      memory_usage_category_alloc(category, len);
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -502,6 +581,9 @@ void MEM_lockfree_printmemlist_stats()
 {
   printf("\ntotal memory len: %.3f MB\n", double(memory_usage_current()) / double(1024 * 1024));
   printf("peak memory len: %.3f MB\n", double(memory_usage_peak()) / double(1024 * 1024));
+  if (const size_t slabs_memory = size_class_slabs_memory()) {
+    printf("size class slabs: %.3f MB\n", double(slabs_memory) / double(1024 * 1024));
+  }
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
       "argument.\n");
@@ -20,6 +20,16 @@ namespace {
 struct Local;
 struct Global;
 
+/**
+ * Memory counts of a single memory category, see #MEM_category_set.
+ */
+struct CategoryCounters {
+  /** Number of bytes, can be negative and is atomic for the same reasons as #Local::mem_in_use. */
+  std::atomic<int64_t> mem_in_use = 0;
+  /** Same as #Local::mem_in_use_during_peak_update, but for the category. */
+  std::atomic<int64_t> mem_in_use_during_peak_update = 0;
+};
+
 /**
  * This is stored per thread. Align to cache line size to avoid false sharing.
  */
@@ -54,6 +64,11 @@ struct alignas(128) Local {
    * accurate, but it's still good enough for practical purposes.
    */
   std::atomic<int64_t> mem_in_use_during_peak_update = 0;
+  /**
+   * Memory counts per category. The counters for #MEM_CATEGORY_OTHER are unused, that memory is
+   * derived from the total memory usage instead.
+   */
+  CategoryCounters categories[MEM_CATEGORY_NUM];
 
   Local();
   ~Local();
@@ -94,6 +109,14 @@ struct Global {
    * Peak memory usage since the last reset.
    */
   std::atomic<size_t> peak = 0;
+  /**
+   * Memory of the categories that is not tracked by #Local, see #mem_in_use_outside_locals.
+   */
+  std::atomic<int64_t> category_mem_in_use_outside_locals[MEM_CATEGORY_NUM] = {};
+  /**
+   * Peak memory usage per category since the last reset.
+   */
+  std::atomic<size_t> category_peak[MEM_CATEGORY_NUM] = {};
 };
 
 }  // namespace
@@ -152,6 +175,10 @@ Local::~Local()
   /* Don't forget the memory counts stored locally. */
   this->global->blocks_num_outside_locals.fetch_add(this->blocks_num, std::memory_order_relaxed);
   this->global->mem_in_use_outside_locals.fetch_add(this->mem_in_use, std::memory_order_relaxed);
+  for (int category = 0; category < MEM_CATEGORY_NUM; category++) {
+    this->global->category_mem_in_use_outside_locals[category].fetch_add(
+        this->categories[category].mem_in_use, std::memory_order_relaxed);
+  }
 
   if (this->is_main) {
     /* The main thread started shutting down. Use global counters from now on to avoid accessing
@@ -179,6 +206,32 @@ static void update_global_peak()
   }
 }
 
+static int64_t category_memory_usage_current(const Global &global, const int category)
+{
+  int64_t mem_in_use = global.category_mem_in_use_outside_locals[category];
+  for (const Local *local : global.locals) {
+    mem_in_use += local->categories[category].mem_in_use;
+  }
+  return mem_in_use;
+}
+
+/** Same as #update_global_peak, but for a single category. */
+static void update_category_peak(const int category)
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+
+  const size_t mem_in_use = size_t(std::max<int64_t>(
+      category_memory_usage_current(global, category), 0));
+  global.category_peak[category] = std::max<size_t>(global.category_peak[category], mem_in_use);
+
+  for (Local *local : global.locals) {
+    assert(!local->destructed);
+    CategoryCounters &counters = local->categories[category];
+    counters.mem_in_use_during_peak_update = counters.mem_in_use.load(std::memory_order_relaxed);
+  }
+}
+
 void memory_usage_init()
 {
   /* Makes sure that the static and thread-local variables on the main thread are initialized. */
@@ -226,6 +279,33 @@ void memory_usage_block_free(const size_t size)
   }
 }
 
+void memory_usage_category_alloc(const uint8_t category, const size_t size)
+{
+  if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
+    CategoryCounters &counters = get_local_data().categories[category];
+    counters.mem_in_use.fetch_add(int64_t(size), std::memory_order_relaxed);
+    if (counters.mem_in_use - counters.mem_in_use_during_peak_update > peak_update_threshold) {
+      update_category_peak(category);
+    }
+  }
+  else {
+    get_global().category_mem_in_use_outside_locals[category].fetch_add(
+        int64_t(size), std::memory_order_relaxed);
+  }
+}
+
+void memory_usage_category_free(const uint8_t category, const size_t size)
+{
+  if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
+    get_local_data().categories[category].mem_in_use.fetch_sub(int64_t(size),
+                                                               std::memory_order_relaxed);
+  }
+  else {
+    get_global().category_mem_in_use_outside_locals[category].fetch_sub(
+        int64_t(size), std::memory_order_relaxed);
+  }
+}
+
 size_t memory_usage_block_num()
 {
   Global &global = get_global();
@@ -273,3 +353,88 @@ void memory_usage_peak_reset()
   Global &global = get_global();
   global.peak = memory_usage_current();
 }
+
+/* -------------------------------------------------------------------- */
+/** \name Memory Categories
+ * \{ */
+
+std::atomic<bool> memory_categories_enabled = false;
+thread_local uint8_t memory_category_current = MEM_CATEGORY_OTHER;
+
+void MEM_use_memory_categories(const bool enabled)
+{
+  memory_categories_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool MEM_memory_categories_enabled()
+{
+  return memory_categories_enabled.load(std::memory_order_relaxed);
+}
+
+eMEM_Category MEM_category_set(const eMEM_Category category)
+{
+  assert(category >= 0 && category < MEM_CATEGORY_NUM);
+  const eMEM_Category previous_category = eMEM_Category(memory_category_current);
+  memory_category_current = uint8_t(category);
+  return previous_category;
+}
+
+eMEM_Category MEM_category_get()
+{
+  return eMEM_Category(memory_category_current);
+}
+
+const char *MEM_category_name(const eMEM_Category category)
+{
+  switch (category) {
+    case MEM_CATEGORY_OTHER:
+      return "Other";
+    case MEM_CATEGORY_MESH:
+      return "Mesh";
+    case MEM_CATEGORY_IMAGE:
+      return "Image";
+    case MEM_CATEGORY_DRAW:
+      return "Draw";
+    case MEM_CATEGORY_CYCLES:
+      return "Cycles";
+  }
+  return "";
+}
+
+size_t MEM_category_get_memory_in_use(const eMEM_Category category)
+{
+  Global &global = get_global();
+  if (category == MEM_CATEGORY_OTHER) {
+    /* The total memory usage is not necessarily counted by #Local (e.g. when the guarded allocator
+     * is used), so it is retrieved separately. */
+    int64_t mem_in_use = int64_t(MEM_get_memory_in_use());
+    std::lock_guard lock{global.locals_mutex};
+    for (int i = 1; i < MEM_CATEGORY_NUM; i++) {
+      mem_in_use -= category_memory_usage_current(global, i);
+    }
+    return size_t(std::max<int64_t>(mem_in_use, 0));
+  }
+  std::lock_guard lock{global.locals_mutex};
+  return size_t(std::max<int64_t>(category_memory_usage_current(global, category), 0));
+}
+
+size_t MEM_category_get_peak_memory(const eMEM_Category category)
+{
+  if (category == MEM_CATEGORY_OTHER) {
+    return 0;
+  }
+  update_category_peak(category);
+  return get_global().category_peak[category];
+}
+
+void MEM_category_reset_peak_memory()
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+  for (int category = 1; category < MEM_CATEGORY_NUM; category++) {
+    global.category_peak[category] = size_t(
+        std::max<int64_t>(category_memory_usage_current(global, category), 0));
+  }
+}
+
+/** \} */
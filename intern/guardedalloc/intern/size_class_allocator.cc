@@ -0,0 +1,263 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup intern_mem
+ *
+ * Allocator for small memory blocks, used by the lock-free allocator when enabled with
+ * #MEM_use_size_class_allocator.
+ *
+ * Block sizes are rounded up to a fixed set of size classes. Blocks of the same class are carved
+ * from larger slabs and recycled through intrusive free lists. Every thread has a cache with a free
+ * list per size class, so most allocations and frees don't need any synchronization. When a cache
+ * runs empty it takes a batch of blocks from the global free lists (or a new slab), when it grows
+ * too large a batch is moved back to the global free lists. Blocks may be freed by another thread
+ * than the one that allocated them, they are then reused by the freeing thread.
+ *
+ * Slabs are never returned to the system. In exchange there is no per-block overhead, the size of
+ * a block is known from its #MemHead when it is freed.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+#include "mallocn_intern.hh"
+
+#include "../../source/blender/blenlib/BLI_strict_flags.h"
+
+std::atomic<bool> size_class_allocator_enabled = false;
+
+namespace {
+
+/** Sizes up to this are rounded up to a multiple of #small_granularity. */
+constexpr size_t small_max_size = 256;
+constexpr size_t small_granularity = 16;
+/** Larger sizes are rounded up to a multiple of #large_granularity. */
+constexpr size_t large_granularity = 64;
+constexpr int small_classes_num = int(small_max_size / small_granularity);
+constexpr int size_classes_num = small_classes_num +
+                                 int((SIZE_CLASS_MAX_SIZE - small_max_size) / large_granularity);
+
+constexpr size_t slab_size = 64 * 1024;
+/** Approximate number of bytes moved between a thread cache and the global free lists at once. */
+constexpr size_t batch_size_in_bytes = 16 * 1024;
+
+static_assert(SIZE_CLASS_MAX_SIZE % large_granularity == 0);
+
+int size_class_index(const size_t size)
+{
+  assert(size > 0 && size <= SIZE_CLASS_MAX_SIZE);
+  if (size <= small_max_size) {
+    return int((size + small_granularity - 1) / small_granularity) - 1;
+  }
+  return small_classes_num +
+         int((size - small_max_size + large_granularity - 1) / large_granularity) - 1;
+}
+
+size_t size_class_block_size(const int index)
+{
+  if (index < small_classes_num) {
+    return size_t(index + 1) * small_granularity;
+  }
+  return small_max_size + size_t(index - small_classes_num + 1) * large_granularity;
+}
+
+int size_class_batch_blocks(const int index)
+{
+  return int(std::clamp<size_t>(batch_size_in_bytes / size_class_block_size(index), 8, 256));
+}
+
+/**
+ * Unused blocks store the free list in their own memory. Blocks are at least 16 bytes, so two
+ * pointers always fit.
+ */
+struct FreeBlock {
+  FreeBlock *next;
+  /** Only used by the first block of a batch in the global free lists. */
+  FreeBlock *next_batch;
+};
+
+struct GlobalSizeClass {
+  std::mutex mutex;
+  /** Stack of batches, linked by #FreeBlock::next_batch. */
+  FreeBlock *batches = nullptr;
+};
+
+struct Global {
+  GlobalSizeClass size_classes[size_classes_num];
+  std::mutex slabs_mutex;
+  /** All allocated slabs, kept so that they stay reachable for leak checkers. */
+  std::vector<void *> slabs;
+};
+
+/**
+ * Never destructed, blocks may still be freed during destruction of static variables.
+ */
+Global &get_global()
+{
+  static Global *global = new Global();
+  return *global;
+}
+
+void push_global_batch(const int index, FreeBlock *batch)
+{
+  GlobalSizeClass &size_class = get_global().size_classes[index];
+  std::lock_guard lock{size_class.mutex};
+  batch->next_batch = size_class.batches;
+  size_class.batches = batch;
+}
+
+FreeBlock *pop_global_batch(const int index)
+{
+  GlobalSizeClass &size_class = get_global().size_classes[index];
+  std::lock_guard lock{size_class.mutex};
+  FreeBlock *batch = size_class.batches;
+  if (batch) {
+    size_class.batches = batch->next_batch;
+  }
+  return batch;
+}
+
+/** \return A list of all blocks in a new slab. */
+FreeBlock *allocate_slab(const int index)
+{
+  char *slab = static_cast<char *>(malloc(slab_size));
+  if (slab == nullptr) {
+    return nullptr;
+  }
+  {
+    Global &global = get_global();
+    std::lock_guard lock{global.slabs_mutex};
+    global.slabs.push_back(slab);
+  }
+  const size_t block_size = size_class_block_size(index);
+  const size_t blocks_num = slab_size / block_size;
+  for (size_t i = 0; i < blocks_num - 1; i++) {
+    reinterpret_cast<FreeBlock *>(slab + i * block_size)->next = reinterpret_cast<FreeBlock *>(
+        slab + (i + 1) * block_size);
+  }
+  reinterpret_cast<FreeBlock *>(slab + (blocks_num - 1) * block_size)->next = nullptr;
+  return reinterpret_cast<FreeBlock *>(slab);
+}
+
+int list_length(const FreeBlock *list)
+{
+  int length = 0;
+  for (; list; list = list->next) {
+    length++;
+  }
+  return length;
+}
+
+/**
+ * Per thread cache of free blocks. Align to cache line size to avoid false sharing.
+ */
+struct alignas(128) ThreadCache {
+  struct Bin {
+    FreeBlock *head = nullptr;
+    int count = 0;
+  };
+  Bin bins[size_classes_num];
+  /** Blocks freed after the cache has been destructed are directly moved to the global lists. */
+  bool destructed = false;
+
+  ~ThreadCache()
+  {
+    for (int index = 0; index < size_classes_num; index++) {
+      if (bins[index].head) {
+        push_global_batch(index, bins[index].head);
+      }
+    }
+    destructed = true;
+  }
+
+  void *allocate(const int index)
+  {
+    Bin &bin = bins[index];
+    if (UNLIKELY(bin.head == nullptr)) {
+      bin.head = pop_global_batch(index);
+      if (bin.head == nullptr) {
+        bin.head = allocate_slab(index);
+        if (bin.head == nullptr) {
+          return nullptr;
+        }
+      }
+      bin.count = list_length(bin.head);
+    }
+    FreeBlock *block = bin.head;
+    bin.head = block->next;
+    bin.count--;
+    return block;
+  }
+
+  void free(const int index, void *ptr)
+  {
+    Bin &bin = bins[index];
+    FreeBlock *block = static_cast<FreeBlock *>(ptr);
+    block->next = bin.head;
+    bin.head = block;
+    bin.count++;
+
+    const int batch_blocks = size_class_batch_blocks(index);
+    if (UNLIKELY(bin.count > 2 * batch_blocks)) {
+      /* Move a batch of the least recently freed blocks to the global free lists, the most
+       * recently freed blocks are more likely to be in the cache. */
+      FreeBlock *last_kept = bin.head;
+      for (int i = 1; i < bin.count - batch_blocks; i++) {
+        last_kept = last_kept->next;
+      }
+      push_global_batch(index, last_kept->next);
+      last_kept->next = nullptr;
+      bin.count -= batch_blocks;
+    }
+  }
+};
+
+ThreadCache &get_thread_cache()
+{
+  static thread_local ThreadCache cache;
+  return cache;
+}
+
+}  // namespace
+
+void *size_class_alloc(const size_t size)
+{
+  ThreadCache &cache = get_thread_cache();
+  if (UNLIKELY(cache.destructed)) {
+    /* The thread is exiting, let the caller use the system allocator. */
+    return nullptr;
+  }
+  return cache.allocate(size_class_index(size));
+}
+
+void size_class_free(void *ptr, const size_t size)
+{
+  const int index = size_class_index(size);
+  ThreadCache &cache = get_thread_cache();
+  if (UNLIKELY(cache.destructed)) {
+    FreeBlock *block = static_cast<FreeBlock *>(ptr);
+    block->next = nullptr;
+    push_global_batch(index, block);
+    return;
+  }
+  cache.free(index, ptr);
+}
+
+size_t size_class_slabs_memory()
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.slabs_mutex};
+  return global.slabs.size() * slab_size;
+}
+
+void MEM_use_size_class_allocator(const bool enabled)
+{
+  size_class_allocator_enabled.store(enabled, std::memory_order_relaxed);
+}
@@ -0,0 +1,88 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include <thread>
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+void DoCategoryChecks()
+{
+  MEM_use_memory_categories(true);
+  const size_t mesh_in_use = MEM_category_get_memory_in_use(MEM_CATEGORY_MESH);
+  const size_t image_in_use = MEM_category_get_memory_in_use(MEM_CATEGORY_IMAGE);
+
+  void *mesh_data;
+  void *image_data;
+  {
+    MEM_ScopedCategory category(MEM_CATEGORY_MESH);
+    EXPECT_EQ(MEM_category_get(), MEM_CATEGORY_MESH);
+    mesh_data = MEM_mallocN(1000, __func__);
+    {
+      MEM_ScopedCategory nested_category(MEM_CATEGORY_IMAGE);
+      image_data = MEM_mallocN_aligned(400, 64, __func__);
+    }
+    EXPECT_EQ(MEM_category_get(), MEM_CATEGORY_MESH);
+  }
+  EXPECT_EQ(MEM_category_get(), MEM_CATEGORY_OTHER);
+  void *other_data = MEM_callocN(100, __func__);
+
+  EXPECT_EQ(MEM_category_get_memory_in_use(MEM_CATEGORY_MESH), mesh_in_use + 1000);
+  EXPECT_EQ(MEM_category_get_memory_in_use(MEM_CATEGORY_IMAGE), image_in_use + 400);
+  EXPECT_EQ(MEM_allocN_len(mesh_data), size_t(1000));
+
+  /* Blocks keep their category when being freed after tracking has been disabled. */
+  MEM_use_memory_categories(false);
+  {
+    MEM_ScopedCategory category(MEM_CATEGORY_MESH);
+    void *untracked_data = MEM_mallocN(1000, __func__);
+    EXPECT_EQ(MEM_category_get_memory_in_use(MEM_CATEGORY_MESH), mesh_in_use + 1000);
+    MEM_freeN(untracked_data);
+  }
+  MEM_freeN(mesh_data);
+  MEM_freeN(image_data);
+  MEM_freeN(other_data);
+  EXPECT_EQ(MEM_category_get_memory_in_use(MEM_CATEGORY_MESH), mesh_in_use);
+  EXPECT_EQ(MEM_category_get_memory_in_use(MEM_CATEGORY_IMAGE), image_in_use);
+}
+
+}  // namespace
+
+TEST_F(LockFreeAllocatorTest, MEM_category)
+{
+  DoCategoryChecks();
+}
+
+TEST_F(GuardedAllocatorTest, MEM_category)
+{
+  DoCategoryChecks();
+}
+
+TEST_F(LockFreeAllocatorTest, MEM_category_peak)
+{
+  MEM_use_memory_categories(true);
+  MEM_category_reset_peak_memory();
+  const size_t in_use = MEM_category_get_memory_in_use(MEM_CATEGORY_DRAW);
+  const size_t size = 4 * 1024 * 1024;
+
+  /* Allocate and free on different threads, the category is stored in the block. */
+  void *data = nullptr;
+  std::thread thread([&]() {
+    MEM_ScopedCategory category(MEM_CATEGORY_DRAW);
+    data = MEM_mallocN(size, __func__);
+  });
+  thread.join();
+  EXPECT_EQ(MEM_category_get_memory_in_use(MEM_CATEGORY_DRAW), in_use + size);
+  MEM_freeN(data);
+
+  EXPECT_EQ(MEM_category_get_memory_in_use(MEM_CATEGORY_DRAW), in_use);
+  EXPECT_GE(MEM_category_get_peak_memory(MEM_CATEGORY_DRAW), in_use + size);
+  MEM_category_reset_peak_memory();
+  EXPECT_EQ(MEM_category_get_peak_memory(MEM_CATEGORY_DRAW), in_use);
+  MEM_use_memory_categories(false);
+}
@@ -0,0 +1,127 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+class SizeClassAllocatorTest : public LockFreeAllocatorTest {
+ protected:
+  void SetUp() override
+  {
+    LockFreeAllocatorTest::SetUp();
+    MEM_use_size_class_allocator(true);
+  }
+
+  void TearDown() override
+  {
+    MEM_use_size_class_allocator(false);
+  }
+};
+
+}  // namespace
+
+TEST_F(SizeClassAllocatorTest, AllocFree)
+{
+  const size_t blocks_num_before = MEM_get_memory_blocks_in_use();
+  const size_t in_use_before = MEM_get_memory_in_use();
+
+  /* Fill all blocks with a different value to check that they don't overlap. */
+  std::vector<char *> blocks;
+  for (size_t size = 0; size < 2000; size += 7) {
+    char *block = static_cast<char *>(MEM_mallocN(size, __func__));
+    EXPECT_GE(MEM_allocN_len(block), size);
+    memset(block, int(size % 251), size);
+    blocks.push_back(block);
+  }
+  for (size_t block_index = 0; block_index < blocks.size(); block_index++) {
+    const size_t size = block_index * 7;
+    for (size_t i = 0; i < size; i++) {
+      EXPECT_EQ(blocks[block_index][i], char(size % 251));
+    }
+  }
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_num_before + blocks.size());
+  for (char *block : blocks) {
+    MEM_freeN(block);
+  }
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_num_before);
+  EXPECT_EQ(MEM_get_memory_in_use(), in_use_before);
+}
+
+TEST_F(SizeClassAllocatorTest, Calloc)
+{
+  /* Reused blocks are cleared as well. */
+  for (int iteration = 0; iteration < 2; iteration++) {
+    char *block = static_cast<char *>(MEM_callocN(100, __func__));
+    for (int i = 0; i < 100; i++) {
+      EXPECT_EQ(block[i], 0);
+    }
+    memset(block, 1, 100);
+    MEM_freeN(block);
+  }
+}
+
+TEST_F(SizeClassAllocatorTest, Aligned)
+{
+  for (const size_t alignment : {1, 8, 16, 32, 64}) {
+    for (const size_t size : {1, 24, 100, 500}) {
+      void *block = MEM_mallocN_aligned(size, alignment, __func__);
+      EXPECT_EQ(size_t(block) % alignment, 0);
+      memset(block, 0, size);
+      block = MEM_reallocN(block, size * 2);
+      EXPECT_EQ(size_t(block) % alignment, 0);
+      MEM_freeN(block);
+    }
+  }
+  int *value = MEM_new<int>(__func__, 5);
+  EXPECT_EQ(*value, 5);
+  MEM_delete(value);
+}
+
+TEST_F(SizeClassAllocatorTest, Toggle)
+{
+  /* Blocks can be freed after the size class allocator has been disabled and the other way
+   * around. */
+  void *size_class_block = MEM_mallocN(64, __func__);
+  MEM_use_size_class_allocator(false);
+  void *system_block = MEM_mallocN(64, __func__);
+  MEM_freeN(size_class_block);
+  MEM_use_size_class_allocator(true);
+  MEM_freeN(system_block);
+}
+
+TEST_F(SizeClassAllocatorTest, Threads)
+{
+  /* Blocks are allocated on one thread and freed on another. */
+  constexpr int blocks_num = 20000;
+  std::vector<void *> blocks(blocks_num);
+  std::thread producer([&]() {
+    for (int i = 0; i < blocks_num; i++) {
+      blocks[i] = MEM_mallocN(size_t(i % 300), __func__);
+    }
+  });
+  producer.join();
+
+  std::vector<std::thread> consumers;
+  for (int thread_index = 0; thread_index < 4; thread_index++) {
+    consumers.emplace_back([&, thread_index]() {
+      for (int i = thread_index; i < blocks_num; i += 4) {
+        MEM_freeN(blocks[i]);
+        /* Reuse the freed blocks on this thread. */
+        void *block = MEM_mallocN(size_t(i % 300), __func__);
+        MEM_freeN(block);
+      }
+    });
+  }
+  for (std::thread &thread : consumers) {
+    thread.join();
+  }
+}
@@ -0,0 +1,135 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+/** \file
+ * Compare the system allocator with the size class allocator (see #MEM_use_size_class_allocator)
+ * on allocation patterns that are typical for geometry nodes and sculpt mode.
+ *
+ * The system allocator is whatever `malloc` the executable uses. To compare different system
+ * allocators, run the benchmark with them preloaded, e.g.
+ * `LD_PRELOAD=libjemalloc.so ./guardedalloc_performance` or `LD_PRELOAD=libtbbmalloc_proxy.so`.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_timeit.hh"
+
+namespace {
+
+int threads_num()
+{
+  return std::max<int>(int(std::thread::hardware_concurrency()), 1);
+}
+
+void run_on_threads(const std::function<void(int thread_index)> &fn)
+{
+  std::vector<std::thread> threads;
+  for (int i = 0; i < threads_num(); i++) {
+    threads.emplace_back(fn, i);
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+}
+
+/**
+ * Every thread builds many short-lived containers that grow by reallocation, and keeps a pool of
+ * small objects alive that is replaced in random order. This is similar to evaluating many small
+ * geometry nodes trees with attribute and component allocations.
+ */
+void geometry_nodes_workload(const int iterations)
+{
+  run_on_threads([&](const int thread_index) {
+    std::mt19937 rng{uint32_t(thread_index)};
+    std::vector<void *> live_objects(1024, nullptr);
+    for (int iteration = 0; iteration < iterations; iteration++) {
+      /* Growing arrays. */
+      void *array = nullptr;
+      for (size_t size = 16; size <= 4096; size *= 2) {
+        array = MEM_reallocN_id(array, size, "array");
+        memset(array, 0, size);
+      }
+      MEM_freeN(array);
+
+      /* Replace some of the live objects. */
+      for (int i = 0; i < 16; i++) {
+        void *&object = live_objects[rng() % live_objects.size()];
+        if (object) {
+          MEM_freeN(object);
+        }
+        object = MEM_mallocN_aligned(16 + rng() % 240, 16, "object");
+      }
+    }
+    for (void *object : live_objects) {
+      if (object) {
+        MEM_freeN(object);
+      }
+    }
+  });
+}
+
+/**
+ * Threads allocate batches of fixed-size nodes which are freed later by another thread, similar
+ * to undo and BVH nodes being created in parallel and freed on the main thread.
+ */
+void sculpt_workload(const int iterations)
+{
+  const int batch_size = 4096;
+  std::vector<std::vector<void *>> batches{size_t(threads_num())};
+  for (int iteration = 0; iteration < iterations; iteration++) {
+    run_on_threads([&](const int thread_index) {
+      std::vector<void *> &batch = batches[size_t(thread_index)];
+      for (int i = 0; i < batch_size; i++) {
+        batch.push_back(MEM_callocN((i % 2) ? 64 : 160, "node"));
+      }
+    });
+    run_on_threads([&](const int thread_index) {
+      /* Free the batch of another thread. */
+      std::vector<void *> &batch = batches[size_t((thread_index + 1) % threads_num())];
+      for (void *node : batch) {
+        MEM_freeN(node);
+      }
+      batch.clear();
+    });
+  }
+}
+
+void run_benchmark(const char *name, const std::function<void()> &workload)
+{
+  MEM_use_lockfree_allocator();
+  for (const bool use_size_classes : {false, true}) {
+    MEM_use_size_class_allocator(use_size_classes);
+    /* Warm up, to measure the steady state instead of the first allocations from the system. */
+    workload();
+    const std::string timer_name = std::string(name) +
+                                   (use_size_classes ? " (size classes)" : " (system)");
+    SCOPED_TIMER(timer_name);
+    for (int i = 0; i < 5; i++) {
+      workload();
+    }
+  }
+  MEM_use_size_class_allocator(false);
+}
+
+}  // namespace
+
+TEST(guardedalloc_performance, GeometryNodes)
+{
+  run_benchmark("geometry nodes", []() { geometry_nodes_workload(20000); });
+}
+
+TEST(guardedalloc_performance, Sculpt)
+{
+  run_benchmark("sculpt", []() { sculpt_workload(50); });
+}
@@ -393,6 +393,11 @@ def enable(module_name, *, default_set=False, persistent=False, handle_error=Non
     if default_set:
         _addon_ensure(module_name)
 
+    # Time the import and the registration separately, see `--debug-startup`.
+    if debug_startup := _bpy.app.debug_startup:
+        from time import perf_counter
+        time_import = perf_counter()
+
     # Split registering up into 3 steps so we can undo
     # if it fails par way through.
 
@@ -476,6 +481,9 @@ def enable(module_name, *, default_set=False, persistent=False, handle_error=Non
                 # Always remove as this is not expected to exist and will be lazily initialized.
                 del mod.bl_info
 
+        if debug_startup:
+            time_register = perf_counter()
+
         # 2) Try register collected modules.
         # Removed register_module, addons need to handle their own registration now.
 
@@ -503,6 +511,14 @@ def enable(module_name, *, default_set=False, persistent=False, handle_error=Non
     if _bpy.app.debug_python:
         print("\taddon_utils.enable", mod.__name__)
 
+    if debug_startup:
+        time_end = perf_counter()
+        print("Add-on {:s}: import {:.4f} s, register {:.4f} s".format(
+            module_name,
+            time_register - time_import,
+            time_end - time_register,
+        ))
+
     return mod
 
 
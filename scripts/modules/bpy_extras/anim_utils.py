@@ -122,6 +122,30 @@ def bake_action_objects(
     if not (bake_options.do_pose or bake_options.do_object):
         return []
 
+    frames = tuple(frames)
+
+    # Evaluate several frames at the same time when the frames of the scene don't depend on the
+    # previous ones. Frame change handlers may modify the scene, they need the frames to be set
+    # on the scene one after another.
+    handlers = bpy.app.handlers
+    if not (handlers.frame_change_pre or handlers.frame_change_post):
+        bake_iters = tuple(
+            bake_action_iter(obj, action=action, bake_options=bake_options)
+            for (obj, action) in object_action_pairs
+        )
+        for bake_iter in bake_iters:
+            bake_iter.send(None)
+        frames_iter = iter(frames)
+
+        def bake_frame(depsgraph, _frame):
+            # Send the frames as they were passed in, not as floats.
+            frame = next(frames_iter)
+            for bake_iter in bake_iters:
+                bake_iter.send((frame, depsgraph))
+
+        if bpy.context.view_layer.evaluate_frames(frames, bake_frame):
+            return tuple(bake_iter.send(None) for bake_iter in bake_iters)
+
     iter = bake_action_objects_iter(object_action_pairs, bake_options=bake_options)
     iter.send(None)
     for frame in frames:
@@ -275,7 +299,15 @@ def bake_action_iter(
 
             # Bendy Bones
             if pbone.bone.bbone_segments > 1:
-                bbones[name] = {bb_prop: getattr(pbone, bb_prop) for bb_prop in BBONE_PROPS}
+                # Copy array values, they reference the pose bone which may not exist anymore
+                # (or has changed) by the time they are keyed.
+                bbones[name] = {
+                    bb_prop: (
+                        tuple(getattr(pbone, bb_prop)) if BBONE_PROPS_LENGTHS[bb_prop] > 1 else
+                        getattr(pbone, bb_prop)
+                    )
+                    for bb_prop in BBONE_PROPS
+                }
 
             # Custom Properties
             custom_props[name] = clean_custom_properties(pbone)
@@ -329,17 +361,23 @@ def bake_action_iter(
     # Collect transformations
 
     while True:
-        # Caller is responsible for setting the frame and updating the scene.
+        # Caller is responsible for setting the frame and updating the scene,
+        # or for sending the depsgraph the frame is evaluated in along with the frame.
         frame = yield None
 
         # Signal we're done!
         if frame is None:
             break
+        if isinstance(frame, tuple):
+            frame, depsgraph = frame
+            obj_eval = obj.evaluated_get(depsgraph)
+        else:
+            obj_eval = obj
         if bake_options.do_pose:
-            pose_info.append((frame, *pose_frame_info(obj)))
-            armature_info.append((frame, armature_frame_info(obj)))
+            pose_info.append((frame, *pose_frame_info(obj_eval)))
+            armature_info.append((frame, armature_frame_info(obj_eval)))
         if bake_options.do_object:
-            obj_info.append((frame, *obj_frame_info(obj)))
+            obj_info.append((frame, *obj_frame_info(obj_eval)))
 
     # -------------------------------------------------------------------------
     # Clean (store initial data)
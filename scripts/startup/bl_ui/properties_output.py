@@ -319,6 +319,7 @@ class RENDER_PT_output(RenderOutputButtonsPanel, Panel):
             col = layout.column(heading="Image Sequence")
             col.prop(rd, "use_overwrite")
             col.prop(rd, "use_placeholder")
+            col.prop(rd, "use_save_async")
 
 
 class RENDER_PT_output_views(RenderOutputButtonsPanel, Panel):
@@ -460,6 +461,9 @@ class RENDER_PT_encoding_video(RenderOutputButtonsPanel, Panel):
         if ffmpeg.codec == 'DNXHD':
             layout.prop(ffmpeg, "use_lossless_output")
 
+        if ffmpeg.codec == 'H264':
+            layout.prop(ffmpeg, "use_hardware_encoder")
+
         # Output quality
         use_crf = needs_codec and ffmpeg.codec in {
             'H264',
@@ -344,6 +344,47 @@ class VIEWLAYER_PT_filter(ViewLayerButtonsPanel, Panel):
         sub.active = scene.render.use_motion_blur
 
 
+class VIEWLAYER_PT_operation_profile(ViewLayerButtonsPanel, Panel):
+    bl_label = "Evaluation Profile"
+    bl_options = {'DEFAULT_CLOSED'}
+    COMPAT_ENGINES = {
+        'BLENDER_RENDER',
+        'BLENDER_EEVEE',
+        'BLENDER_EEVEE_NEXT',
+        'BLENDER_WORKBENCH',
+    }
+
+    # Number of the slowest operations to list.
+    slowest_num = 10
+
+    @classmethod
+    def poll(cls, context):
+        return context.view_layer.depsgraph is not None
+
+    def draw_header(self, context):
+        self.layout.prop(context.view_layer.depsgraph, "use_operation_profile", text="")
+
+    def draw(self, context):
+        layout = self.layout
+        depsgraph = context.view_layer.depsgraph
+        layout.active = depsgraph.use_operation_profile
+
+        profile = depsgraph.operation_profile
+        if len(profile) == 0:
+            layout.label(text="No evaluation recorded")
+            return
+
+        total = sum(entry.duration for entry in profile)
+        layout.label(text="{:d} operations, {:.2f} ms".format(len(profile), total * 1000.0), translate=False)
+
+        slowest = sorted(profile, key=lambda entry: entry.duration, reverse=True)[:self.slowest_num]
+        col = layout.column(align=True)
+        for entry in slowest:
+            split = col.split(factor=0.75)
+            split.label(text="{:s}: {:s}".format(entry.id_name[2:], entry.operation), translate=False)
+            split.label(text="{:.2f} ms".format(entry.duration * 1000.0), translate=False)
+
+
 class VIEWLAYER_PT_layer_custom_props(PropertyPanel, Panel):
     bl_space_type = 'PROPERTIES'
     bl_region_type = 'WINDOW'
@@ -366,6 +407,7 @@ classes = (
     VIEWLAYER_PT_layer_passes_aov,
     VIEWLAYER_PT_layer_passes_lightgroups,
     VIEWLAYER_PT_filter,
+    VIEWLAYER_PT_operation_profile,
     VIEWLAYER_PT_layer_custom_props,
     VIEWLAYER_UL_aov,
 )
@@ -7,6 +7,10 @@ from bpy.types import (
     Header,
     Menu,
     Panel,
+    UIList,
+)
+from bpy.props import (
+    EnumProperty,
 )
 from bpy.app.translations import (
     pgettext_iface as iface_,
@@ -1033,6 +1037,100 @@ class NODE_PT_node_tree_properties(Panel):
                 col.prop(group, "is_tool")
 
 
+def _memory_size_text(num_bytes):
+    for unit in ("B", "KiB", "MiB"):
+        if num_bytes < 1024.0:
+            return "{:.0f} {:s}".format(num_bytes, unit) if unit == "B" else "{:.1f} {:s}".format(num_bytes, unit)
+        num_bytes /= 1024.0
+    return "{:.1f} GiB".format(num_bytes)
+
+
+class NODE_UL_profile_nodes(UIList):
+    sort_by: EnumProperty(
+        name="Sort By",
+        items=(
+            ('RUN_TIME', "Run Time", "Sort by the time spent in the node"),
+            ('MEMORY', "Memory", "Sort by the memory used by the geometry output of the node"),
+            ('EXECUTIONS', "Executions", "Sort by the number of times the node has been executed"),
+        ),
+        default='RUN_TIME',
+    )
+
+    def draw_filter(self, _context, layout):
+        row = layout.row()
+        row.prop(self, "filter_name", text="")
+        row.prop(self, "use_filter_invert", text="", icon='ARROW_LEFTRIGHT')
+        row = layout.row()
+        row.prop(self, "sort_by", expand=True)
+        row.prop(self, "use_filter_sort_reverse", text="", icon='SORT_DESC')
+
+    def filter_items(self, _context, data, property):
+        profile_nodes = getattr(data, property)
+        flags = []
+        if self.filter_name:
+            flags = bpy.types.UI_UL_list.filter_items_by_name(
+                self.filter_name, self.bitflag_filter_item, profile_nodes, "node_name",
+                reverse=self.use_filter_invert)
+        if not flags:
+            flags = [self.bitflag_filter_item] * len(profile_nodes)
+
+        key = {
+            'RUN_TIME': "run_time",
+            'MEMORY': "output_geometry_memory",
+            'EXECUTIONS': "executions",
+        }[self.sort_by]
+        sort_data = [(i, getattr(item, key)) for i, item in enumerate(profile_nodes)]
+        indices = bpy.types.UI_UL_list.sort_items_helper(sort_data, lambda e: e[1], reverse=True)
+        return flags, indices
+
+    def draw_item(self, _context, layout, _data, item, _icon, _active_data, _active_propname, _index):
+        split = layout.split(factor=0.5)
+        split.label(text=item.node_name, translate=False)
+        sub = split.row()
+        sub.alignment = 'RIGHT'
+        sub.label(text="{:.2f} ms".format(item.run_time * 1000.0), translate=False)
+        sub.label(text=_memory_size_text(item.output_geometry_memory), translate=False)
+
+
+class NODE_PT_node_profile(Panel):
+    bl_space_type = 'NODE_EDITOR'
+    bl_region_type = 'UI'
+    bl_category = "Node"
+    bl_label = "Profile"
+    bl_options = {'DEFAULT_CLOSED'}
+
+    @staticmethod
+    def _active_nodes_modifier(context):
+        snode = context.space_data
+        if snode.tree_type != 'GeometryNodeTree' or snode.geometry_nodes_type != 'MODIFIER':
+            return None
+        ob = context.object
+        if ob is None:
+            return None
+        modifier = ob.modifiers.active
+        if modifier is None or modifier.type != 'NODES':
+            return None
+        return modifier
+
+    @classmethod
+    def poll(cls, context):
+        return cls._active_nodes_modifier(context) is not None
+
+    def draw(self, context):
+        layout = self.layout
+        modifier = self._active_nodes_modifier(context)
+
+        layout.prop(modifier, "use_profile")
+
+        profile_nodes = modifier.profile_nodes
+        run_time = sum(item.run_time for item in profile_nodes)
+        layout.label(text=iface_("Total: {:.2f} ms").format(run_time * 1000.0), translate=False)
+        layout.template_list(
+            "NODE_UL_profile_nodes", "", modifier, "profile_nodes", modifier, "active_profile_node_index",
+            rows=8,
+        )
+
+
 # Grease Pencil properties
 class NODE_PT_annotation(AnnotationDataPanel, Panel):
     bl_space_type = 'NODE_EDITOR'
@@ -1089,6 +1187,8 @@ classes = (
     NODE_PT_geometry_node_tool_options,
     NODE_PT_node_color_presets,
     NODE_PT_node_tree_properties,
+    NODE_UL_profile_nodes,
+    NODE_PT_node_profile,
     NODE_MT_node_tree_interface_context_menu,
     NODE_PT_node_tree_interface,
     NODE_PT_active_node_generic,
@@ -207,6 +207,8 @@ class AssetCatalogService {
 
   /** Implementation of #write_to_disk() that doesn't clear the "has unsaved changes" tag. */
   bool write_to_disk_ex(const CatalogFilePath &blend_file_path);
+  /** Write the catalog definition file, and remember that it's in sync with the catalogs. */
+  bool write_catalog_definition_file();
   void untag_has_unsaved_changes();
   bool is_catalog_known_with_unsaved_changes(CatalogID catalog_id) const;
 
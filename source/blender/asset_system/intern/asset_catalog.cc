@@ -401,6 +401,10 @@ void AssetCatalogService::reload_catalogs()
   if (!cdf || cdf->file_path.empty() || !BLI_is_file(cdf->file_path.c_str())) {
     return;
   }
+  if (!cdf->is_modified_on_disk()) {
+    /* The catalogs were read from or written to the file as it is now. */
+    return;
+  }
 
   /* Keeps track of the catalog IDs that are seen in the CDF, so that we also know what was deleted
    * from the file on disk. */
@@ -485,7 +489,7 @@ bool AssetCatalogService::write_to_disk_ex(const CatalogFilePath &blend_file_pat
   /* - Already loaded a CDF from disk? -> Always write to that file. */
   if (catalog_collection_->catalog_definition_file_) {
     this->reload_catalogs();
-    return catalog_collection_->catalog_definition_file_->write_to_disk();
+    return this->write_catalog_definition_file();
   }
 
   if (catalog_collection_->catalogs_.is_empty() &&
@@ -499,7 +503,18 @@ bool AssetCatalogService::write_to_disk_ex(const CatalogFilePath &blend_file_pat
       blend_file_path);
   catalog_collection_->catalog_definition_file_ = this->construct_cdf_in_memory(cdf_path_to_write);
   this->reload_catalogs();
-  return catalog_collection_->catalog_definition_file_->write_to_disk();
+  return this->write_catalog_definition_file();
+}
+
+bool AssetCatalogService::write_catalog_definition_file()
+{
+  AssetCatalogDefinitionFile &cdf = *catalog_collection_->catalog_definition_file_;
+  if (!cdf.write_to_disk()) {
+    return false;
+  }
+  /* The file now contains the in-memory catalogs, it doesn't have to be reloaded. */
+  cdf.tag_in_sync_with_disk();
+  return true;
 }
 
 void AssetCatalogService::prepare_to_merge_on_write()
@@ -6,8 +6,10 @@
  * \ingroup asset_system
  */
 
+#include <ctime>
 #include <iostream>
 
+#include "BLI_fileops.h"
 #include "BLI_fileops.hh"
 #include "BLI_path_util.h"
 
@@ -49,10 +51,47 @@ void AssetCatalogDefinitionFile::forget(CatalogID catalog_id)
   catalogs_.remove(catalog_id);
 }
 
+static bool file_stamp_get(const CatalogFilePath &file_path, int64_t *r_mtime, int64_t *r_size)
+{
+  BLI_stat_t status;
+  if (BLI_stat(file_path.c_str(), &status) == -1) {
+    return false;
+  }
+  *r_mtime = int64_t(status.st_mtime);
+  *r_size = int64_t(status.st_size);
+  return true;
+}
+
+bool AssetCatalogDefinitionFile::is_modified_on_disk() const
+{
+  int64_t mtime, size;
+  if (!file_stamp_get(this->file_path, &mtime, &size)) {
+    return true;
+  }
+  return mtime != disk_mtime_ || size != disk_size_;
+}
+
+void AssetCatalogDefinitionFile::tag_in_sync_with_disk()
+{
+  /* Modification times have a resolution of a second. When the file was modified in the current
+   * second, another change in the same second can't be detected, so don't rely on the stamp. */
+  if (!file_stamp_get(this->file_path, &disk_mtime_, &disk_size_) ||
+      disk_mtime_ >= int64_t(time(nullptr)))
+  {
+    disk_mtime_ = -1;
+    disk_size_ = -1;
+  }
+}
+
 void AssetCatalogDefinitionFile::parse_catalog_file(
     const CatalogFilePath &catalog_definition_file_path,
     AssetCatalogParsedFn catalog_loaded_callback)
 {
+  if (catalog_definition_file_path == this->file_path) {
+    /* Get the stamp before reading, so that changes while reading are detected later on. */
+    this->tag_in_sync_with_disk();
+  }
+
   fstream infile(catalog_definition_file_path, std::ios::in);
 
   if (!infile.is_open()) {
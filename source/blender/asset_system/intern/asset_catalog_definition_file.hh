@@ -27,6 +27,13 @@ class AssetCatalogDefinitionFile {
    * catalog is already known, without having to find the corresponding `AssetCatalog*`. */
   Map<CatalogID, AssetCatalog *> catalogs_;
 
+  /**
+   * Modification time and size of the file on disk when it was last read or written, see
+   * #is_modified_on_disk(). Negative when unknown.
+   */
+  int64_t disk_mtime_ = -1;
+  int64_t disk_size_ = -1;
+
  public:
   /* For now this is the only version of the catalog definition files that is supported.
    * Later versioning code may be added to handle older files. */
@@ -56,6 +63,15 @@ class AssetCatalogDefinitionFile {
    */
   bool write_to_disk(const CatalogFilePath &dest_file_path) const;
 
+  /**
+   * Whether the file on disk changed since it was last read or written, based on its
+   * modification time and size. Reading files can be slow (e.g. on network drives), so files that
+   * didn't change don't have to be parsed again.
+   */
+  bool is_modified_on_disk() const;
+  /** Remember the current modification time and size of the file on disk. */
+  void tag_in_sync_with_disk();
+
   bool contains(CatalogID catalog_id) const;
   /** Add a catalog, overwriting the one with the same catalog ID. */
   void add_overwrite(AssetCatalog *catalog);
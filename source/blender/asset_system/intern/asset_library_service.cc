@@ -6,11 +6,14 @@
  * \ingroup asset_system
  */
 
+#include <algorithm>
+
 #include "BKE_blender.hh"
 #include "BKE_preferences.h"
 
 #include "BLI_path_util.h"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 
 #include "DNA_asset_types.h"
 #include "DNA_userdef_types.h"
@@ -128,7 +131,12 @@ AssetLibrary *AssetLibraryService::get_asset_library_on_disk(eAssetLibraryType l
   if (lib_uptr_ptr != nullptr) {
     CLOG_INFO(&LOG, 2, "get \"%s\" (cached)", normalized_root_path.c_str());
     AssetLibrary *lib = lib_uptr_ptr->get();
-    lib->refresh_catalogs();
+    if (pending_catalog_loads_) {
+      pending_catalog_loads_->append({lib, false});
+    }
+    else {
+      lib->refresh_catalogs();
+    }
     return lib;
   }
 
@@ -147,7 +155,12 @@ AssetLibrary *AssetLibraryService::get_asset_library_on_disk(eAssetLibraryType l
 
   AssetLibrary *lib = lib_uptr.get();
 
-  lib->load_catalogs();
+  if (pending_catalog_loads_) {
+    pending_catalog_loads_->append({lib, true});
+  }
+  else {
+    lib->load_catalogs();
+  }
 
   on_disk_libraries_.add_new({library_type, normalized_root_path}, std::move(lib_uptr));
   CLOG_INFO(&LOG, 2, "get \"%s\" (loaded)", normalized_root_path.c_str());
@@ -213,7 +226,11 @@ AssetLibrary *AssetLibraryService::get_asset_library_all(const Main *bmain)
     return all_library_.get();
   }
 
-  /* (Re-)load all other asset libraries. */
+  /* (Re-)load all other asset libraries. Only gather the on-disk libraries first, reading their
+   * catalog definition files is independent and can be slow (e.g. for network drives), so it's
+   * done for all libraries in parallel below. */
+  Vector<PendingCatalogLoad> catalog_loads;
+  pending_catalog_loads_ = &catalog_loads;
   for (AssetLibraryReference &library_ref : all_valid_asset_library_refs()) {
     /* Skip self :) */
     if (library_ref.type == ASSET_LIBRARY_ALL) {
@@ -223,6 +240,29 @@ AssetLibrary *AssetLibraryService::get_asset_library_all(const Main *bmain)
     /* Ensure all asset libraries are loaded. */
     this->get_asset_library(bmain, library_ref);
   }
+  pending_catalog_loads_ = nullptr;
+
+  /* Multiple references may point to the same library, only load it once. */
+  Vector<PendingCatalogLoad> unique_catalog_loads;
+  for (const PendingCatalogLoad &load : catalog_loads) {
+    const bool is_known = std::any_of(
+        unique_catalog_loads.begin(),
+        unique_catalog_loads.end(),
+        [&](const PendingCatalogLoad &other) { return other.library == load.library; });
+    if (!is_known) {
+      unique_catalog_loads.append(load);
+    }
+  }
+  threading::parallel_for(unique_catalog_loads.index_range(), 1, [&](const IndexRange range) {
+    for (const PendingCatalogLoad &load : unique_catalog_loads.as_span().slice(range)) {
+      if (load.is_new) {
+        load.library->load_catalogs();
+      }
+      else {
+        load.library->refresh_catalogs();
+      }
+    }
+  });
 
   CLOG_INFO(&LOG, 2, "get all lib (loaded)");
   all_library_ = std::make_unique<AllAssetLibrary>();
@@ -15,6 +15,7 @@
 
 #include "BLI_function_ref.hh"
 #include "BLI_map.hh"
+#include "BLI_vector.hh"
 
 #include <memory>
 
@@ -60,6 +61,17 @@ class AssetLibraryService {
   /** The "all" asset library, merging all other libraries into one. */
   std::unique_ptr<AllAssetLibrary> all_library_;
 
+  /** On-disk library of which the catalogs still have to be loaded or refreshed. */
+  struct PendingCatalogLoad {
+    AssetLibrary *library;
+    bool is_new;
+  };
+  /**
+   * While set, #get_asset_library_on_disk() doesn't load catalogs, but adds the library here so
+   * that the catalogs of multiple libraries can be loaded in parallel.
+   */
+  Vector<PendingCatalogLoad> *pending_catalog_loads_ = nullptr;
+
   /** Handlers for managing the life cycle of the AssetLibraryService instance. */
   bCallbackFuncStore on_load_callback_store_;
   static bool atexit_handler_registered_;
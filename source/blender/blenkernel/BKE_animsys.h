@@ -362,6 +362,11 @@ void BKE_animsys_eval_driver(struct Depsgraph *depsgraph,
 
 void BKE_animsys_update_driver_array(struct ID *id);
 
+/**
+ * Free the resolved RNA paths which are cached for the evaluation of the animation data.
+ */
+void BKE_animsys_path_cache_free(struct AnimData *adt);
+
 /* ************************************* */
 
 #ifdef __cplusplus
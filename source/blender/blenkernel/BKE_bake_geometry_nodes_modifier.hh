@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include "BLI_sub_frame.hh"
 
 #include "BKE_bake_items.hh"
@@ -14,6 +17,7 @@ struct NodesModifierData;
 struct Main;
 struct Object;
 struct Scene;
+struct TaskPool;
 
 namespace blender::bke::bake {
 
@@ -37,6 +41,8 @@ struct FrameCache {
   BakeState state;
   /** Used when the baked data is loaded lazily. */
   std::optional<std::string> meta_path;
+  /** The state is being loaded by the #NodeBakeCache::prefetch_pool. */
+  std::atomic<bool> is_prefetching = false;
 };
 
 /**
@@ -62,6 +68,19 @@ struct NodeBakeCache {
   /** Used to avoid checking if a bake exists many times. */
   bool failed_finding_bake = false;
 
+  /**
+   * Loads the frames that follow the most recently read frame in background threads during
+   * playback. Null when nothing was prefetched yet.
+   */
+  TaskPool *prefetch_pool = nullptr;
+  /** Protects the #FrameCache::state of frames that may be loaded by the #prefetch_pool. */
+  std::mutex prefetch_mutex;
+  /** Index of the most recently read frame, to detect the playback direction. */
+  std::optional<int> last_read_frame_index;
+
+  NodeBakeCache() = default;
+  ~NodeBakeCache();
+
   /** Range spanning from the first to the last baked frame. */
   IndexRange frame_range() const;
 
@@ -10,6 +10,8 @@
 
 #include "BKE_bake_items.hh"
 
+struct BLI_mmap_file;
+
 namespace blender::bke::bake {
 
 /**
@@ -41,6 +43,14 @@ class BlobReader {
    */
   [[nodiscard]] virtual bool read_as_stream(const BlobSlice &slice,
                                             FunctionRef<bool(std::istream &)> fn) const;
+
+  /**
+   * Reference the data of the given slice without copying it, e.g. in a memory-mapped file. The
+   * returned sharing info keeps the data alive. Modifying the data must not change the blob.
+   * \return None if the data can't be referenced, it has to be copied with #read then.
+   */
+  [[nodiscard]] virtual std::optional<ImplicitSharingInfoAndData> read_mapped(
+      const BlobSlice &slice) const;
 };
 
 /**
@@ -152,10 +162,15 @@ class DiskBlobReader : public BlobReader {
   const std::string blobs_dir_;
   mutable std::mutex mutex_;
   mutable Map<std::string, std::unique_ptr<fstream>> open_input_streams_;
+  /** Blob files mapped into memory, null if the file can't be mapped. */
+  mutable Map<std::string, BLI_mmap_file *> mapped_files_;
 
  public:
   DiskBlobReader(std::string blobs_dir);
+  ~DiskBlobReader();
   [[nodiscard]] bool read(const BlobSlice &slice, void *r_data) const override;
+  [[nodiscard]] std::optional<ImplicitSharingInfoAndData> read_mapped(
+      const BlobSlice &slice) const override;
 };
 
 /**
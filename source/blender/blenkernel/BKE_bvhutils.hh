@@ -182,6 +182,16 @@ void free_bvhtree_from_pointcloud(BVHTreeFromPointCloud *data);
 bool bvhcache_has_tree(const BVHCache *bvh_cache, const BVHTree *tree);
 BVHCache *bvhcache_init();
 /**
- * Frees a BVH-cache.
+ * Share the BVH-cache with a copy of the mesh, returns the cache for convenience.
+ */
+BVHCache *bvhcache_add_user(BVHCache *bvh_cache);
+/**
+ * Removes a user of the BVH-cache, which is freed when it was the last user.
  */
 void bvhcache_free(BVHCache *bvh_cache);
+/**
+ * Called when the positions changed but the topology did not. Trees that can be updated are kept
+ * to be refit when they are requested again, the other trees are freed. A cache that is shared
+ * is not changed, but the mesh doesn't use it anymore.
+ */
+void bvhcache_tag_positions_changed(BVHCache **bvh_cache_p);
@@ -64,6 +64,12 @@ struct BMEditMesh {
    * Set #Main.is_memfile_undo_flush_needed when enabling.
    */
   char needs_flush_to_id;
+
+  /**
+   * Only the vertex positions changed since the last full update, set by transform and cleared by
+   * #EDBM_update. Lets the draw cache keep the buffers that don't depend on positions.
+   */
+  bool is_positions_only_update = false;
 };
 
 /* editmesh.cc */
@@ -599,8 +599,14 @@ void BKE_fcurve_correct_bezpart(const float v1[2], float v2[2], float v3[2], con
 
 /* -------- Evaluation -------- */
 
-/* evaluate fcurve */
-float evaluate_fcurve(const FCurve *fcu, float evaltime);
+/**
+ * Evaluate the F-Curve at the given time.
+ *
+ * \param segment_hint: Optional index of the keyframe found by the previous evaluation of the
+ * curve, which is updated. It makes finding the keyframes around the evaluation time cheaper when
+ * the curve is evaluated at increasing times, like during playback.
+ */
+float evaluate_fcurve(const FCurve *fcu, float evaltime, int *segment_hint = nullptr);
 float evaluate_fcurve_only_curve(const FCurve *fcu, float evaltime);
 float evaluate_fcurve_driver(PathResolvedRNA *anim_rna,
                              FCurve *fcu,
@@ -613,10 +619,13 @@ bool BKE_fcurve_is_empty(const FCurve *fcu);
 /**
  * Calculate the value of the given F-Curve at the given frame,
  * and store it's value in #FCurve.curval.
+ *
+ * \param segment_hint: See #evaluate_fcurve, not used for drivers.
  */
 float calculate_fcurve(PathResolvedRNA *anim_rna,
                        FCurve *fcu,
-                       const AnimationEvalContext *anim_eval_context);
+                       const AnimationEvalContext *anim_eval_context,
+                       int *segment_hint = nullptr);
 
 /* ************* F-Curve Samples API ******************** */
 
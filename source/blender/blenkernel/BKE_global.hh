@@ -258,6 +258,8 @@ enum {
 
   G_DEBUG_GHOST = (1 << 23),  /* Debug GHOST module. */
   G_DEBUG_WINTAB = (1 << 24), /* Debug Wintab. */
+
+  G_DEBUG_STARTUP = (1 << 25), /* Startup time profiling. */
 };
 
 #define G_DEBUG_ALL \
@@ -100,6 +100,12 @@ KeyBlock *BKE_keyblock_find_uid(Key *key, int uid);
  * \brief copy shape-key attributes, but not key data or name/UID.
  */
 void BKE_keyblock_copy_settings(KeyBlock *kb_dst, const KeyBlock *kb_src);
+/**
+ * Copy the settings of the key and all its key-blocks to another key with the same key-blocks,
+ * without copying the key-block data. Used to update evaluated copies of the key.
+ * \return False if the keys don't have matching key-blocks.
+ */
+bool BKE_key_copy_settings_for_eval(Key *key_dst, const Key *key_src);
 /**
  * Get RNA-Path for 'value' setting of the given shape-key.
  * \note the user needs to free the returned string once they're finished with it.
@@ -402,6 +402,16 @@ void BKE_maskrasterize_handle_init(MaskRasterHandle *mr_handle,
                                    bool do_mask_aa,
                                    bool do_feather);
 float BKE_maskrasterize_handle_sample(MaskRasterHandle *mr_handle, const float xy[2]);
+/**
+ * Sample the mask at the positions `(xs[i], y)` of a row, the same as calling
+ * #BKE_maskrasterize_handle_sample for every position. Layers are evaluated for many samples at
+ * once, which is faster when sampling many positions. Can be called from multiple threads.
+ */
+void BKE_maskrasterize_handle_sample_row(MaskRasterHandle *mr_handle,
+                                         const float *xs,
+                                         unsigned int xs_num,
+                                         float y,
+                                         float *r_values);
 
 /**
  * \brief Rasterize a buffer from a single mask (threaded execution).
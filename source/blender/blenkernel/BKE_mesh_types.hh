@@ -158,7 +158,10 @@ struct MeshRuntime {
   /** Cache for triangle to original face index map, accessed with #Mesh::corner_tri_faces(). */
   SharedCache<Array<int>> corner_tri_faces_cache;
 
-  /** Cache for BVH trees generated for the mesh. Defined in 'BKE_bvhutil.c' */
+  /**
+   * Cache for BVH trees generated for the mesh. Defined in 'BKE_bvhutil.c'. The cache is shared
+   * with copies of the mesh until their positions or topology change.
+   */
   BVHCache *bvh_cache = nullptr;
 
   /** Needed in case we need to lazily initialize the mesh. */
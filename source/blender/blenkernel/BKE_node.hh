@@ -559,6 +559,8 @@ bool node_tree_contains_tree(const bNodeTree *tree_to_search_in,
                              const bNodeTree *tree_to_search_for);
 
 void node_tree_update_all_users(Main *main, ID *id);
+/** Same as above for multiple IDs at once, only iterating over all node trees once. */
+void node_tree_update_all_users(Main *main, Span<ID *> ids);
 
 /**
  * XXX: old trees handle output flags automatically based on special output
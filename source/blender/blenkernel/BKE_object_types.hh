@@ -90,6 +90,13 @@ struct ObjectRuntime {
    */
   Mesh *mesh_deform_eval = nullptr;
 
+  /**
+   * Draw cache of the evaluated mesh that was freed when the object evaluation was reset. The draw
+   * code can reuse its buffers for the next evaluated mesh when the data they are extracted from
+   * didn't change, see #BKE_object_eval_reset.
+   */
+  void *mesh_batch_cache_previous = nullptr;
+
   /**
    * Evaluated mesh cage in edit mode.
    *
@@ -82,6 +82,12 @@ void BKE_previewimg_id_custom_set(ID *id, const char *filepath);
  */
 void BKE_previewimg_id_free(ID *id);
 
+/**
+ * Defer loading the preview of a linked ID from its library file to when it is displayed (using
+ * the same pipeline as file-system thumbnails), instead of keeping its pixels in memory.
+ */
+void BKE_previewimg_id_deferred_library_set(ID *id);
+
 /**
  * Create a new preview image.
  */
@@ -304,6 +304,13 @@ Depsgraph *BKE_scene_get_depsgraph(const Scene *scene, const ViewLayer *view_lay
  * \note Allocate new depsgraph if necessary.
  */
 Depsgraph *BKE_scene_ensure_depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer);
+/**
+ * Store \a depsgraph as the depsgraph of the view layer, and return the depsgraph it replaces
+ * (or null). Ownership of the returned depsgraph is passed to the caller.
+ *
+ * \note The new depsgraph must be created for the same scene and view layer.
+ */
+Depsgraph *BKE_scene_replace_depsgraph(Scene *scene, ViewLayer *view_layer, Depsgraph *depsgraph);
 
 GHash *BKE_scene_undo_depsgraphs_extract(Main *bmain);
 void BKE_scene_undo_depsgraphs_restore(Main *bmain, GHash *depsgraph_extract);
@@ -19,6 +19,8 @@ class OpenSubdiv_TopologyRefiner;
 
 namespace blender::bke::subdiv {
 
+struct MeshTopologyKey;
+
 enum VtxBoundaryInterpolation {
   /* Do not interpolate boundaries. */
   SUBDIV_VTX_BOUNDARY_NONE,
@@ -166,6 +168,9 @@ struct Subdiv {
   Displacement *displacement_evaluator;
   /* Statistics for debugging. */
   SubdivStats stats;
+  /* Implicitly shared arrays of the mesh the topology refiner was created from. When they are
+   * used by a mesh again, the topology is known to be unchanged without comparing it. */
+  MeshTopologyKey *mesh_topology_key;
 
   /* Cached values, are not supposed to be accessed directly. */
   struct {
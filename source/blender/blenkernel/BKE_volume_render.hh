@@ -28,8 +28,14 @@ struct DenseFloatVolumeGrid {
   float *voxels;
 };
 
+/**
+ * Extract the active voxels bounding box of the grid as dense floats. Nothing is extracted when
+ * the resolution along an axis is larger than \a max_resolution, so that no memory is allocated
+ * for a grid that can't be used.
+ */
 bool BKE_volume_grid_dense_floats(const Volume *volume,
                                   const blender::bke::VolumeGridData *volume_grid,
+                                  int max_resolution,
                                   DenseFloatVolumeGrid *r_dense_grid);
 void BKE_volume_dense_float_grid_clear(DenseFloatVolumeGrid *dense_grid);
 
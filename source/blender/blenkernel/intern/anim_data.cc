@@ -286,6 +286,9 @@ void BKE_animdata_free(ID *id, const bool do_id_user)
   /* free driver array cache */
   MEM_SAFE_FREE(adt->driver_array);
 
+  /* free resolved paths cache */
+  BKE_animsys_path_cache_free(adt);
+
   /* free overrides */
   /* TODO... */
 
@@ -396,6 +399,7 @@ AnimData *BKE_animdata_copy_in_lib(Main *bmain,
   /* duplicate drivers (F-Curves) */
   BKE_fcurves_copy(&dadt->drivers, &adt->drivers);
   dadt->driver_array = nullptr;
+  dadt->path_cache = nullptr;
 
   /* don't copy overrides */
   BLI_listbase_clear(&dadt->overrides);
@@ -1564,6 +1568,7 @@ void BKE_animdata_blend_read_data(BlendDataReader *reader, ID *id)
   BLO_read_struct_list(reader, FCurve, &adt->drivers);
   BKE_fcurve_blend_read_data_listbase(reader, &adt->drivers);
   adt->driver_array = nullptr;
+  adt->path_cache = nullptr;
 
   /* link overrides */
   /* TODO... */
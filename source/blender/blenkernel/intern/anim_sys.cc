@@ -19,10 +19,12 @@
 #include "BLI_blenlib.h"
 #include "BLI_dynstr.h"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -896,6 +898,151 @@ void animsys_blend_in_action(PointerRNA *ptr,
   animsys_blend_in_fcurves(ptr, &act->curves, anim_eval_context, blend_factor);
 }
 
+/* ----------------------------------------- */
+/* Resolved Paths Cache */
+
+struct AnimDataPathCacheItem {
+  PathResolvedRNA anim_rna;
+  /** The path could not be resolved, the F-Curve is skipped. */
+  bool is_invalid;
+  /** The path leads to another ID, it is resolved again on every evaluation. */
+  bool needs_resolve;
+  /** Keyframe found by the previous evaluation, see #evaluate_fcurve. */
+  int segment_hint;
+};
+
+/**
+ * F-Curve values of an action-clip strip, evaluated at #strip_time. Strips which are held or
+ * evaluated at a fixed time (e.g. poses that are blended on top of other strips) don't have to be
+ * evaluated again on every frame.
+ */
+struct NlaStripValuesCache {
+  const bAction *action = nullptr;
+  uint64_t id_tag_stamp = 0;
+  uint64_t action_tag_stamp = 0;
+  float strip_time = 0.0f;
+  /** Value of every F-Curve of the action with the modifiers applied, in the same order. */
+  blender::Vector<float> values;
+  /** Keyframes found by the previous evaluation, see #evaluate_fcurve. */
+  blender::Vector<int> segment_hints;
+};
+
+/**
+ * RNA paths of the F-Curves of the active action, resolved on the evaluated ID. Parsing the paths
+ * and looking up every part of them on every frame takes most of the animation evaluation time of
+ * rigs with many channels.
+ *
+ * The resolved pointers point into the evaluated ID. They stay valid until the ID or the action
+ * are tagged for an update, or the depsgraph relations are rebuilt, which changes their tag stamp
+ * (see #DEG_id_tag_stamp_get).
+ */
+struct AnimDataPathCache {
+  const bAction *action = nullptr;
+  uint64_t id_tag_stamp = 0;
+  uint64_t action_tag_stamp = 0;
+  /** One item for every F-Curve of the action, in the same order. */
+  blender::Vector<AnimDataPathCacheItem> items;
+  /** Evaluated values of the NLA action-clip strips, validated for every strip separately. */
+  blender::Map<const NlaStrip *, NlaStripValuesCache> strip_values;
+};
+
+void BKE_animsys_path_cache_free(AnimData *adt)
+{
+  MEM_delete(adt->path_cache);
+  adt->path_cache = nullptr;
+}
+
+static bool animsys_path_cache_supported(const Depsgraph *depsgraph, const ID *id)
+{
+  /* The evaluated ID has to be owned by the depsgraph, so that it is not shared with other
+   * depsgraphs which evaluate it at the same time. */
+  if (DEG_is_original_id(id) || DEG_id_tag_stamp_get(depsgraph, id) == 0) {
+    return false;
+  }
+  /* Writing to geometry attributes through RNA can reallocate them when they are shared, so
+   * pointers to their elements can't be kept. */
+  return !ELEM(GS(id->name), ID_ME, ID_CV, ID_PT, ID_GP, ID_VO);
+}
+
+static AnimDataPathCache &animsys_path_cache_get(AnimData *adt)
+{
+  if (adt->path_cache == nullptr) {
+    adt->path_cache = MEM_new<AnimDataPathCache>(__func__);
+  }
+  return *adt->path_cache;
+}
+
+static AnimDataPathCache &animsys_path_cache_ensure(const Depsgraph *depsgraph,
+                                                    PointerRNA *id_ptr,
+                                                    AnimData *adt)
+{
+  ID *id = id_ptr->owner_id;
+  const bAction *action = adt->action;
+  const uint64_t id_tag_stamp = DEG_id_tag_stamp_get(depsgraph, id);
+  const uint64_t action_tag_stamp = DEG_id_tag_stamp_get(depsgraph, &action->id);
+
+  AnimDataPathCache &cache = animsys_path_cache_get(adt);
+  if (cache.action == action && cache.id_tag_stamp == id_tag_stamp &&
+      cache.action_tag_stamp == action_tag_stamp)
+  {
+    return cache;
+  }
+
+  cache.action = action;
+  cache.id_tag_stamp = id_tag_stamp;
+  cache.action_tag_stamp = action_tag_stamp;
+  cache.items.clear();
+  LISTBASE_FOREACH (FCurve *, fcu, &action->curves) {
+    AnimDataPathCacheItem item{};
+    item.is_invalid = !BKE_animsys_rna_path_resolve(
+        id_ptr, fcu->rna_path, fcu->array_index, &item.anim_rna);
+    item.needs_resolve = !item.is_invalid && item.anim_rna.ptr.owner_id != id;
+    cache.items.append(item);
+  }
+  return cache;
+}
+
+/**
+ * Same as #animsys_evaluate_action, but resolves the paths of the F-Curves only when the
+ * evaluated ID or the action changed, and starts looking for the keyframes to interpolate at the
+ * ones of the previous evaluation.
+ */
+static void animsys_evaluate_action_cached_paths(const Depsgraph *depsgraph,
+                                                 PointerRNA *id_ptr,
+                                                 AnimData *adt,
+                                                 const AnimationEvalContext *anim_eval_context,
+                                                 const bool flush_to_original)
+{
+  bAction *act = adt->action;
+  if (!animsys_path_cache_supported(depsgraph, id_ptr->owner_id)) {
+    animsys_evaluate_action(id_ptr, act, anim_eval_context, flush_to_original);
+    return;
+  }
+
+  action_idcode_patch_check(id_ptr->owner_id, act);
+
+  AnimDataPathCache &cache = animsys_path_cache_ensure(depsgraph, id_ptr, adt);
+  int fcurve_index;
+  LISTBASE_FOREACH_INDEX (FCurve *, fcu, &act->curves, fcurve_index) {
+    AnimDataPathCacheItem &item = cache.items[fcurve_index];
+    if (item.is_invalid || !is_fcurve_evaluatable(fcu)) {
+      continue;
+    }
+    PathResolvedRNA anim_rna = item.anim_rna;
+    if (item.needs_resolve &&
+        !BKE_animsys_rna_path_resolve(id_ptr, fcu->rna_path, fcu->array_index, &anim_rna))
+    {
+      continue;
+    }
+    const float curval = calculate_fcurve(
+        &anim_rna, fcu, anim_eval_context, &item.segment_hint);
+    BKE_animsys_write_to_rna_path(&anim_rna, curval);
+    if (flush_to_original) {
+      animsys_write_orig_anim_rna(id_ptr, fcu->rna_path, fcu->array_index, curval);
+    }
+  }
+}
+
 /* ***************************************** */
 /* NLA System - Evaluation */
 
@@ -2607,14 +2754,73 @@ static void nlaeval_fmodifiers_split_stacks(ListBase *list1, ListBase *list2)
 
 /* ---------------------- */
 
-/** Fills \a r_snapshot with the \a action's evaluated fcurve values with modifiers applied. */
+/**
+ * Get the cache for the F-Curve values of an action-clip strip, or null when they can't be cached.
+ * \a r_is_valid is set when the cached values were evaluated at the current strip time already,
+ * otherwise they are evaluated again and stored in the cache.
+ */
+static NlaStripValuesCache *nlastrip_values_cache_get(PointerRNA *ptr,
+                                                      const NlaStrip *strip,
+                                                      const ListBase *modifiers,
+                                                      const AnimationEvalContext *anim_eval_context,
+                                                      bool *r_is_valid)
+{
+  *r_is_valid = false;
+  const Depsgraph *depsgraph = anim_eval_context->depsgraph;
+  ID *id = ptr->owner_id;
+  /* Modifiers of parent strips are joined into temporary lists, which can't be compared. */
+  if (depsgraph == nullptr || (modifiers != nullptr && modifiers->first != nullptr)) {
+    return nullptr;
+  }
+  if (!animsys_path_cache_supported(depsgraph, id)) {
+    return nullptr;
+  }
+  AnimData *adt = BKE_animdata_from_id(id);
+  if (adt == nullptr) {
+    return nullptr;
+  }
+  /* The modifiers of the strip itself are part of the ID, edits change its tag stamp. */
+  const uint64_t id_tag_stamp = DEG_id_tag_stamp_get(depsgraph, id);
+  const uint64_t action_tag_stamp = DEG_id_tag_stamp_get(depsgraph, &strip->act->id);
+  if (action_tag_stamp == 0) {
+    return nullptr;
+  }
+
+  NlaStripValuesCache &cache = animsys_path_cache_get(adt).strip_values.lookup_or_add_default(
+      strip);
+  if (cache.action == strip->act && cache.id_tag_stamp == id_tag_stamp &&
+      cache.action_tag_stamp == action_tag_stamp)
+  {
+    *r_is_valid = cache.strip_time == strip->strip_time;
+  }
+  else {
+    const int fcurves_num = BLI_listbase_count(&strip->act->curves);
+    cache.action = strip->act;
+    cache.id_tag_stamp = id_tag_stamp;
+    cache.action_tag_stamp = action_tag_stamp;
+    cache.values.reinitialize(fcurves_num);
+    cache.segment_hints = blender::Vector<int>(fcurves_num, 0);
+  }
+  cache.strip_time = strip->strip_time;
+  return &cache;
+}
+
+/**
+ * Fills \a r_snapshot with the \a action's evaluated fcurve values with modifiers applied.
+ *
+ * \param values_cache: Optional cache for the values evaluated at \a evaltime. They are read from
+ * it when \a use_cached_values is true, and written to it otherwise.
+ */
 static void nlasnapshot_from_action(PointerRNA *ptr,
                                     NlaEvalData *channels,
                                     ListBase *modifiers,
                                     bAction *action,
                                     const float evaltime,
-                                    NlaEvalSnapshot *r_snapshot)
+                                    NlaEvalSnapshot *r_snapshot,
+                                    NlaStripValuesCache *values_cache = nullptr,
+                                    const bool use_cached_values = false)
 {
+  BLI_assert(values_cache != nullptr || !use_cached_values);
   action_idcode_patch_check(ptr->owner_id, action);
 
   /* Evaluate modifiers which modify time to evaluate the base curves at. */
@@ -2623,10 +2829,13 @@ static void nlasnapshot_from_action(PointerRNA *ptr,
   storage.size_per_modifier = evaluate_fmodifiers_storage_size_per_modifier(modifiers);
   storage.buffer = alloca(storage.modifier_count * storage.size_per_modifier);
 
-  const float modified_evaltime = evaluate_time_fmodifiers(
-      &storage, modifiers, nullptr, 0.0f, evaltime);
+  const float modified_evaltime = use_cached_values ?
+                                      evaltime :
+                                      evaluate_time_fmodifiers(
+                                          &storage, modifiers, nullptr, 0.0f, evaltime);
 
-  LISTBASE_FOREACH (const FCurve *, fcu, &action->curves) {
+  int fcurve_index;
+  LISTBASE_FOREACH_INDEX (const FCurve *, fcu, &action->curves, fcurve_index) {
     if (!is_fcurve_evaluatable(fcu)) {
       continue;
     }
@@ -2644,8 +2853,20 @@ static void nlasnapshot_from_action(PointerRNA *ptr,
 
     NlaEvalChannelSnapshot *necs = nlaeval_snapshot_ensure_channel(r_snapshot, nec);
 
-    float value = evaluate_fcurve(fcu, modified_evaltime);
-    evaluate_value_fmodifiers(&storage, modifiers, fcu, &value, evaltime);
+    float value;
+    if (use_cached_values) {
+      value = values_cache->values[fcurve_index];
+    }
+    else if (values_cache != nullptr) {
+      value = evaluate_fcurve(
+          fcu, modified_evaltime, &values_cache->segment_hints[fcurve_index]);
+      evaluate_value_fmodifiers(&storage, modifiers, fcu, &value, evaltime);
+      values_cache->values[fcurve_index] = value;
+    }
+    else {
+      value = evaluate_fcurve(fcu, modified_evaltime);
+      evaluate_value_fmodifiers(&storage, modifiers, fcu, &value, evaltime);
+    }
     necs->values[fcu->array_index] = value;
 
     if (nec->mix_mode == NEC_MIX_QUATERNION) {
@@ -2663,7 +2884,8 @@ static void nlastrip_evaluate_actionclip(const int evaluation_mode,
                                          NlaEvalData *channels,
                                          ListBase *modifiers,
                                          NlaEvalStrip *nes,
-                                         NlaEvalSnapshot *snapshot)
+                                         NlaEvalSnapshot *snapshot,
+                                         const AnimationEvalContext *anim_eval_context)
 {
 
   NlaStrip *strip = nes->strip;
@@ -2683,14 +2905,24 @@ static void nlastrip_evaluate_actionclip(const int evaluation_mode,
   /* join this strip's modifiers to the parent's modifiers (own modifiers first) */
   nlaeval_fmodifiers_join_stacks(&tmp_modifiers, &strip->modifiers, modifiers);
 
+  bool use_cached_values = false;
+  NlaStripValuesCache *values_cache = nlastrip_values_cache_get(
+      ptr, strip, modifiers, anim_eval_context, &use_cached_values);
+
   switch (evaluation_mode) {
     case STRIP_EVAL_BLEND: {
 
       NlaEvalSnapshot strip_snapshot;
       nlaeval_snapshot_init(&strip_snapshot, channels, nullptr);
 
-      nlasnapshot_from_action(
-          ptr, channels, &tmp_modifiers, strip->act, strip->strip_time, &strip_snapshot);
+      nlasnapshot_from_action(ptr,
+                              channels,
+                              &tmp_modifiers,
+                              strip->act,
+                              strip->strip_time,
+                              &strip_snapshot,
+                              values_cache,
+                              use_cached_values);
       nlasnapshot_blend(
           channels, snapshot, &strip_snapshot, strip->blendmode, strip->influence, snapshot);
 
@@ -2703,8 +2935,14 @@ static void nlastrip_evaluate_actionclip(const int evaluation_mode,
       NlaEvalSnapshot strip_snapshot;
       nlaeval_snapshot_init(&strip_snapshot, channels, nullptr);
 
-      nlasnapshot_from_action(
-          ptr, channels, &tmp_modifiers, strip->act, strip->strip_time, &strip_snapshot);
+      nlasnapshot_from_action(ptr,
+                              channels,
+                              &tmp_modifiers,
+                              strip->act,
+                              strip->strip_time,
+                              &strip_snapshot,
+                              values_cache,
+                              use_cached_values);
       nlasnapshot_blend_get_inverted_lower_snapshot(
           channels, snapshot, &strip_snapshot, strip->blendmode, strip->influence, snapshot);
 
@@ -2713,8 +2951,14 @@ static void nlastrip_evaluate_actionclip(const int evaluation_mode,
       break;
     }
     case STRIP_EVAL_NOBLEND: {
-      nlasnapshot_from_action(
-          ptr, channels, &tmp_modifiers, strip->act, strip->strip_time, snapshot);
+      nlasnapshot_from_action(ptr,
+                              channels,
+                              &tmp_modifiers,
+                              strip->act,
+                              strip->strip_time,
+                              snapshot,
+                              values_cache,
+                              use_cached_values);
       break;
     }
   }
@@ -2969,7 +3213,8 @@ void nlastrip_evaluate(const int evaluation_mode,
   /* actions to take depend on the type of strip */
   switch (strip->type) {
     case NLASTRIP_TYPE_CLIP: /* action-clip */
-      nlastrip_evaluate_actionclip(evaluation_mode, ptr, channels, modifiers, nes, snapshot);
+      nlastrip_evaluate_actionclip(
+          evaluation_mode, ptr, channels, modifiers, nes, snapshot, anim_eval_context);
       break;
     case NLASTRIP_TYPE_TRANSITION: /* transition */
       nlastrip_evaluate_transition(evaluation_mode,
@@ -3915,11 +4160,16 @@ static void animsys_evaluate_overrides(PointerRNA *ptr, AnimData *adt)
  *   However, the code for this is relatively harmless, so is left in the code for now.
  */
 
-void BKE_animsys_evaluate_animdata(ID *id,
-                                   AnimData *adt,
-                                   const AnimationEvalContext *anim_eval_context,
-                                   eAnimData_Recalc recalc,
-                                   const bool flush_to_original)
+/**
+ * \param depsgraph: When not null, the resolved paths of the active action are cached for the
+ * evaluation of the ID in this depsgraph.
+ */
+static void animsys_evaluate_animdata_ex(ID *id,
+                                         AnimData *adt,
+                                         const AnimationEvalContext *anim_eval_context,
+                                         eAnimData_Recalc recalc,
+                                         const bool flush_to_original,
+                                         const Depsgraph *depsgraph)
 {
 
   /* sanity checks */
@@ -3950,6 +4200,10 @@ void BKE_animsys_evaluate_animdata(ID *id,
         blender::animrig::evaluate_and_apply_action(
             id_ptr, action, adt->slot_handle, *anim_eval_context, flush_to_original);
       }
+      else if (depsgraph != nullptr) {
+        animsys_evaluate_action_cached_paths(
+            depsgraph, &id_ptr, adt, anim_eval_context, flush_to_original);
+      }
       else {
         animsys_evaluate_action(&id_ptr, adt->action, anim_eval_context, flush_to_original);
       }
@@ -3974,6 +4228,15 @@ void BKE_animsys_evaluate_animdata(ID *id,
   animsys_evaluate_overrides(&id_ptr, adt);
 }
 
+void BKE_animsys_evaluate_animdata(ID *id,
+                                   AnimData *adt,
+                                   const AnimationEvalContext *anim_eval_context,
+                                   eAnimData_Recalc recalc,
+                                   const bool flush_to_original)
+{
+  animsys_evaluate_animdata_ex(id, adt, anim_eval_context, recalc, flush_to_original, nullptr);
+}
+
 void BKE_animsys_evaluate_all_animation(Main *main, Depsgraph *depsgraph, float ctime)
 {
   ID *id;
@@ -4133,7 +4396,8 @@ void BKE_animsys_eval_animdata(Depsgraph *depsgraph, ID *id)
 
   const AnimationEvalContext anim_eval_context = BKE_animsys_eval_context_construct(depsgraph,
                                                                                     ctime);
-  BKE_animsys_evaluate_animdata(id, adt, &anim_eval_context, ADT_RECALC_ANIM, flush_to_original);
+  animsys_evaluate_animdata_ex(
+      id, adt, &anim_eval_context, ADT_RECALC_ANIM, flush_to_original, depsgraph);
 }
 
 void BKE_animsys_update_driver_array(ID *id)
@@ -17,11 +17,18 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
+#include "BLI_generic_key.hh"
+#include "BLI_hash.hh"
+#include "BLI_implicit_sharing.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_memory_cache.hh"
+#include "BLI_memory_counter.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_armature_types.h"
@@ -229,6 +236,125 @@ static void pchan_bone_deform(const bPoseChannel *pchan,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Vertex Weights Cache
+ *
+ * The weights of every #MDeformVert are stored in a separate allocation, so reading them for all
+ * vertices jumps around in memory. For meshes, the weights are copied into a single contiguous
+ * array once, and stored in the #blender::memory_cache. The table is found again for every
+ * evaluation as long as the vertex group layer is not modified, also when it is shared between
+ * several evaluated meshes (e.g. the evaluated copies of different depsgraphs).
+ * \{ */
+
+namespace blender::bke {
+
+class DeformWeightsKey : public GenericKey {
+ public:
+  const ImplicitSharingInfo *sharing_info = nullptr;
+  int64_t version = 0;
+  int verts_num = 0;
+  /**
+   * The stored key is a weak user of the sharing info, so that the address is not reused for other
+   * data while the key exists.
+   */
+  bool is_weak_user = false;
+
+  DeformWeightsKey() = default;
+  DeformWeightsKey(const DeformWeightsKey &other) = delete;
+  DeformWeightsKey &operator=(const DeformWeightsKey &other) = delete;
+
+  ~DeformWeightsKey() override
+  {
+    if (is_weak_user) {
+      sharing_info->remove_weak_user_and_delete_if_last();
+    }
+  }
+
+  uint64_t hash() const override
+  {
+    return get_default_hash(this->sharing_info, this->version, this->verts_num);
+  }
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    if (const auto *other_typed = dynamic_cast<const DeformWeightsKey *>(&other)) {
+      return this->sharing_info == other_typed->sharing_info &&
+             this->version == other_typed->version && this->verts_num == other_typed->verts_num;
+    }
+    return false;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    auto key = std::make_unique<DeformWeightsKey>();
+    key->sharing_info = this->sharing_info;
+    key->version = this->version;
+    key->verts_num = this->verts_num;
+    key->sharing_info->add_weak_user();
+    key->is_weak_user = true;
+    return key;
+  }
+};
+
+/** The weights of vertex `i` are `weights[offsets[i]]` to `weights[offsets[i + 1]]`. */
+class DeformWeightsValue : public memory_cache::CachedValue {
+ public:
+  Array<int> offsets;
+  Array<MDeformWeight> weights;
+
+  void count_memory(MemoryCounter &memory) const override
+  {
+    memory.add(this->offsets.as_span().size_in_bytes());
+    memory.add(this->weights.as_span().size_in_bytes());
+  }
+};
+
+/**
+ * Get the contiguous weights of the mesh vertex groups, or null when the layer is not shared.
+ * Layers that are owned by the mesh alone are usually created during this evaluation (e.g. by
+ * a previous modifier), those would only add a new entry to the cache for every evaluation.
+ */
+static std::shared_ptr<const DeformWeightsValue> deform_weights_cache_get(const Mesh &mesh)
+{
+  const int layer_index = CustomData_get_layer_index(&mesh.vert_data, CD_MDEFORMVERT);
+  if (layer_index == -1) {
+    return {};
+  }
+  const CustomDataLayer &layer = mesh.vert_data.layers[layer_index];
+  if (layer.sharing_info == nullptr || layer.sharing_info->is_mutable()) {
+    return {};
+  }
+  DeformWeightsKey key;
+  key.sharing_info = layer.sharing_info;
+  key.version = layer.sharing_info->version();
+  key.verts_num = mesh.verts_num;
+
+  const Span<MDeformVert> dverts = mesh.deform_verts();
+  return memory_cache::get<DeformWeightsValue>(key, [&]() {
+    auto value = std::make_unique<DeformWeightsValue>();
+    value->offsets.reinitialize(dverts.size() + 1);
+    int offset = 0;
+    for (const int i : dverts.index_range()) {
+      value->offsets[i] = offset;
+      offset += dverts[i].totweight;
+    }
+    value->offsets.last() = offset;
+    value->weights.reinitialize(offset);
+    threading::parallel_for(dverts.index_range(), 1024, [&](const IndexRange range) {
+      for (const int i : range) {
+        value->weights.as_mutable_span()
+            .slice(value->offsets[i], dverts[i].totweight)
+            .copy_from({dverts[i].dw, dverts[i].totweight});
+      }
+    });
+    return value;
+  });
+}
+
+}  // namespace blender::bke
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Armature Deform #BKE_armature_deform_coords API
  *
@@ -251,6 +377,8 @@ struct ArmatureUserdata {
 
   const MDeformVert *dverts;
   int dverts_len;
+  /** Contiguous copy of the weights of #dverts when the target is a mesh, may be null. */
+  const blender::bke::DeformWeightsValue *weights_cache;
 
   bPoseChannel **pchan_from_defbase;
   int defbase_len;
@@ -264,9 +392,14 @@ struct ArmatureUserdata {
   } bmesh;
 };
 
-static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
-                                          const int i,
-                                          const MDeformVert *dvert)
+/**
+ * \param weights: The vertex group weights of the vertex.
+ * \param has_dvert: Whether the vertex has weights at all, as opposed to an empty weights array.
+ */
+static void armature_vert_task_with_weights(const ArmatureUserdata *data,
+                                            const int i,
+                                            const blender::Span<MDeformWeight> weights,
+                                            const bool has_dvert)
 {
   float(*const vert_coords)[3] = data->vert_coords;
   float(*const vert_deform_mats)[3][3] = data->vert_deform_mats;
@@ -301,8 +434,14 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
     }
   }
 
-  if (armature_def_nr != -1 && dvert) {
-    armature_weight = BKE_defvert_find_weight(dvert, armature_def_nr);
+  if (armature_def_nr != -1 && has_dvert) {
+    armature_weight = 0.0f;
+    for (const MDeformWeight &dw : weights) {
+      if (int(dw.def_nr) == armature_def_nr) {
+        armature_weight = dw.weight;
+        break;
+      }
+    }
 
     if (data->invert_vgroup) {
       armature_weight = 1.0f - armature_weight;
@@ -338,14 +477,12 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   /* Apply the object's matrix */
   mul_m4_v3(data->premat, co);
 
-  if (use_dverts && dvert && dvert->totweight) { /* use weight groups ? */
-    const MDeformWeight *dw = dvert->dw;
+  if (use_dverts && !weights.is_empty()) { /* use weight groups ? */
     int deformed = 0;
-    uint j;
-    for (j = dvert->totweight; j != 0; j--, dw++) {
-      const uint index = dw->def_nr;
+    for (const MDeformWeight &dw : weights) {
+      const uint index = dw.def_nr;
       if (index < data->defbase_len && (pchan = data->pchan_from_defbase[index])) {
-        float weight = dw->weight;
+        float weight = dw.weight;
         const Bone *bone = pchan->bone;
 
         deformed = 1;
@@ -429,6 +566,17 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   }
 }
 
+static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
+                                          const int i,
+                                          const MDeformVert *dvert)
+{
+  if (dvert == nullptr) {
+    armature_vert_task_with_weights(data, i, {}, false);
+    return;
+  }
+  armature_vert_task_with_weights(data, i, {dvert->dw, dvert->totweight}, true);
+}
+
 static void armature_vert_task(void *__restrict userdata,
                                const int i,
                                const TaskParallelTLS *__restrict /*tls*/)
@@ -436,6 +584,12 @@ static void armature_vert_task(void *__restrict userdata,
   const ArmatureUserdata *data = static_cast<const ArmatureUserdata *>(userdata);
   const MDeformVert *dvert;
   if (data->use_dverts || data->armature_def_nr != -1) {
+    if (const blender::bke::DeformWeightsValue *weights_cache = data->weights_cache) {
+      const blender::IndexRange range = blender::IndexRange::from_begin_end(
+          weights_cache->offsets[i], weights_cache->offsets[i + 1]);
+      armature_vert_task_with_weights(data, i, weights_cache->weights.as_span().slice(range), true);
+      return;
+    }
     if (data->me_target) {
       BLI_assert(i < data->me_target->verts_num);
       if (data->dverts != nullptr) {
@@ -501,6 +655,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
   bool use_dverts = false;
   int armature_def_nr = -1;
   int cd_dvert_offset = -1;
+  std::shared_ptr<const blender::bke::DeformWeightsValue> weights_cache;
 
   /* in editmode, or not an armature */
   if (arm->edbo || (ob_arm->pose == nullptr)) {
@@ -521,6 +676,9 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       if (em_target == nullptr) {
         const Mesh *mesh = (const Mesh *)target_data_id;
         dverts = mesh->deform_verts();
+        if (dverts.size() == vert_coords_len) {
+          weights_cache = blender::bke::deform_weights_cache_get(*mesh);
+        }
       }
     }
     else if (ob_target->type == OB_LATTICE) {
@@ -590,6 +748,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
   data.armature_def_nr = armature_def_nr;
   data.dverts = dverts.data();
   data.dverts_len = dverts.size();
+  data.weights_cache = weights_cache.get();
   data.pchan_from_defbase = pchan_from_defbase;
   data.defbase_len = defbase_len;
   data.bmesh.cd_dvert_offset = cd_dvert_offset;
@@ -15,6 +15,7 @@
 #include "BLI_fileops.hh"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 
 #include "MOD_nodes.hh"
 
@@ -32,6 +33,15 @@ void BakeNodeCache::reset()
   new (this) BakeNodeCache();
 }
 
+NodeBakeCache::~NodeBakeCache()
+{
+  if (this->prefetch_pool) {
+    /* Frames that are not loaded yet are skipped, the tasks reference this cache. */
+    BLI_task_pool_cancel(this->prefetch_pool);
+    BLI_task_pool_free(this->prefetch_pool);
+  }
+}
+
 void NodeBakeCache::reset()
 {
   std::destroy_at(this);
@@ -16,6 +16,7 @@
 #include "BLI_endian_defines.h"
 #include "BLI_endian_switch.h"
 #include "BLI_math_matrix_types.hh"
+#include "BLI_mmap.h"
 #include "BLI_path_util.h"
 
 #include "DNA_material_types.h"
@@ -24,10 +25,15 @@
 #include "RNA_access.hh"
 #include "RNA_enum_types.hh"
 
+#include <fcntl.h>
 #include <fmt/format.h>
 #include <sstream>
 #include <xxhash.h>
 
+#ifndef WIN32
+#  include <unistd.h>
+#endif
+
 #ifdef WITH_OPENVDB
 #  include <openvdb/io/Stream.h>
 #  include <openvdb/openvdb.h>
@@ -85,8 +91,92 @@ bool BlobReader::read_as_stream(const BlobSlice &slice, FunctionRef<bool(std::is
   return true;
 }
 
+std::optional<ImplicitSharingInfoAndData> BlobReader::read_mapped(const BlobSlice & /*slice*/) const
+{
+  return std::nullopt;
+}
+
+/**
+ * Files can't be deleted or overwritten while they are mapped on Windows, which would prevent
+ * baking again while baked data is still used.
+ */
+#ifndef WIN32
+#  define USE_MMAP_BLOBS
+#endif
+
+#ifdef USE_MMAP_BLOBS
+/** Smaller arrays share memory pages with other data, and are not worth referencing. */
+static constexpr int64_t mmap_blob_min_size = 64 * 1024;
+
+namespace {
+/** Keeps the memory-mapped blob file alive for as long as data referencing it is used. */
+class MappedBlobSharingInfo : public ImplicitSharingInfo {
+ private:
+  BLI_mmap_file *mmap_file_;
+
+ public:
+  MappedBlobSharingInfo(BLI_mmap_file *mmap_file) : mmap_file_(mmap_file)
+  {
+    BLI_mmap_add_user(mmap_file_);
+  }
+
+ private:
+  void delete_self_with_data() override
+  {
+    BLI_mmap_free(mmap_file_);
+    MEM_delete(this);
+  }
+};
+}  // namespace
+#endif
+
 DiskBlobReader::DiskBlobReader(std::string blobs_dir) : blobs_dir_(std::move(blobs_dir)) {}
 
+DiskBlobReader::~DiskBlobReader()
+{
+  for (BLI_mmap_file *mmap_file : mapped_files_.values()) {
+    if (mmap_file) {
+      BLI_mmap_free(mmap_file);
+    }
+  }
+}
+
+std::optional<ImplicitSharingInfoAndData> DiskBlobReader::read_mapped(
+    const BlobSlice &slice) const
+{
+#ifdef USE_MMAP_BLOBS
+  if (slice.range.size() < mmap_blob_min_size) {
+    return std::nullopt;
+  }
+
+  char blob_path[FILE_MAX];
+  BLI_path_join(blob_path, sizeof(blob_path), blobs_dir_.c_str(), slice.name.c_str());
+
+  std::lock_guard lock{mutex_};
+  BLI_mmap_file *mmap_file = mapped_files_.lookup_or_add_cb_as(
+      blob_path, [&]() -> BLI_mmap_file * {
+        const int file = BLI_open(blob_path, O_BINARY | O_RDONLY, 0);
+        if (file == -1) {
+          return nullptr;
+        }
+        BLI_mmap_file *new_mmap_file = BLI_mmap_open(file);
+        close(file);
+        return new_mmap_file;
+      });
+  if (mmap_file == nullptr) {
+    return std::nullopt;
+  }
+  if (slice.range.one_after_last() > int64_t(BLI_mmap_get_length(mmap_file))) {
+    return std::nullopt;
+  }
+  const void *data = POINTER_OFFSET(BLI_mmap_get_pointer(mmap_file), slice.range.start());
+  return ImplicitSharingInfoAndData{MEM_new<MappedBlobSharingInfo>(__func__, mmap_file), data};
+#else
+  UNUSED_VARS(slice);
+  return std::nullopt;
+#endif
+}
+
 [[nodiscard]] bool DiskBlobReader::read(const BlobSlice &slice, void *r_data) const
 {
   if (slice.range.is_empty()) {
@@ -108,6 +198,9 @@ DiskBlobReader::DiskBlobReader(std::string blobs_dir) : blobs_dir_(std::move(blo
   return true;
 }
 
+/** Larger than the alignment of all types that are written as arrays. */
+static constexpr int64_t blob_alignment = 16;
+
 DiskBlobWriter::DiskBlobWriter(std::string blob_dir, std::string base_name)
     : blob_dir_(std::move(blob_dir)), base_name_(std::move(base_name))
 {
@@ -123,6 +216,15 @@ BlobSlice DiskBlobWriter::write(const void *data, const int64_t size)
     blob_stream_.open(blob_path, std::ios::out | std::ios::binary);
   }
 
+  /* Align the start of every slice, so that the data can be used directly when the file is
+   * mapped into memory. */
+  const int64_t padding = (blob_alignment - current_offset_ % blob_alignment) % blob_alignment;
+  if (padding > 0) {
+    const char zeros[blob_alignment] = {};
+    blob_stream_.write(zeros, padding);
+    current_offset_ += padding;
+  }
+
   const int64_t old_offset = current_offset_;
   blob_stream_.write(static_cast<const char *>(data), size);
   current_offset_ += size;
@@ -398,6 +500,39 @@ static std::shared_ptr<DictionaryValue> write_blob_simple_gspan(BlobWriter &blob
   return false;
 }
 
+/**
+ * Reference the stored array directly instead of copying it, when it does not have to be changed
+ * to be used (same endianness and alignment).
+ */
+static std::optional<ImplicitSharingInfoAndData> read_blob_mapped_simple_gspan(
+    const BlobReader &blob_reader,
+    const DictionaryValue &io_data,
+    const CPPType &cpp_type,
+    const int size)
+{
+  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
+  if (!slice || slice->range.size() != cpp_type.size() * size) {
+    return std::nullopt;
+  }
+  const bool is_raw_bytes = cpp_type.size() == 1 || cpp_type.is<ColorGeometry4b>();
+  if (!is_raw_bytes) {
+    const StringRefNull stored_endian = io_data.lookup_str("endian").value_or("little");
+    if (stored_endian != get_endian_io_name(ENDIAN_ORDER)) {
+      return std::nullopt;
+    }
+  }
+  std::optional<ImplicitSharingInfoAndData> mapped_data = blob_reader.read_mapped(*slice);
+  if (!mapped_data) {
+    return std::nullopt;
+  }
+  if (uintptr_t(mapped_data->data) % uintptr_t(cpp_type.alignment()) != 0) {
+    /* Data written before slices were aligned. */
+    mapped_data->sharing_info->remove_user_and_delete_if_last();
+    return std::nullopt;
+  }
+  return mapped_data;
+}
+
 static std::shared_ptr<DictionaryValue> write_blob_shared_simple_gspan(
     BlobWriter &blob_writer,
     BlobWriteSharing &blob_sharing,
@@ -419,6 +554,11 @@ static std::shared_ptr<DictionaryValue> write_blob_shared_simple_gspan(
   const char *func = __func__;
   const std::optional<ImplicitSharingInfoAndData> sharing_info_and_data = blob_sharing.read_shared(
       io_data, [&]() -> std::optional<ImplicitSharingInfoAndData> {
+        if (std::optional<ImplicitSharingInfoAndData> mapped_data = read_blob_mapped_simple_gspan(
+                blob_reader, io_data, cpp_type, size))
+        {
+          return mapped_data;
+        }
         void *data_mem = MEM_mallocN_aligned(size * cpp_type.size(), cpp_type.alignment(), func);
         if (!read_blob_simple_gspan(blob_reader, io_data, {cpp_type, data_mem, size})) {
           MEM_freeN(data_mem);
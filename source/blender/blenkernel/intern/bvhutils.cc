@@ -9,8 +9,10 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_pointcloud_types.h"
 
+#include "BLI_implicit_sharing.hh"
 #include "BLI_math_geom.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_bvhutils.hh"
@@ -32,11 +34,48 @@ using blender::VArray;
 struct BVHCacheItem {
   bool is_filled;
   BVHTree *tree;
+  /**
+   * Tree built for previous vertex positions of the same topology. It is refit to the new
+   * positions when the tree is requested again, which is much cheaper than building it.
+   */
+  BVHTree *tree_to_refit;
+  /** Number of times #tree was refit since it was built. */
+  int refit_count;
 };
 
-struct BVHCache {
-  BVHCacheItem items[BVHTREE_MAX_ITEM];
+/**
+ * Refitting keeps the original hierarchy, which gets less efficient for queries the more the
+ * elements move relative to each other. Rebuild the tree from time to time to restore its quality.
+ */
+static constexpr int BVHTREE_REFIT_MAX = 32;
+
+/**
+ * The cache is shared between copies of a mesh until the positions or topology of one of them
+ * change, so that trees are not built again for unchanged copies (e.g. in geometry nodes).
+ */
+struct BVHCache : public blender::ImplicitSharingMixin {
+  BVHCacheItem items[BVHTREE_MAX_ITEM] = {};
   ThreadMutex mutex;
+
+  BVHCache()
+  {
+    BLI_mutex_init(&this->mutex);
+  }
+
+  ~BVHCache()
+  {
+    for (BVHCacheItem &item : this->items) {
+      BLI_bvhtree_free(item.tree);
+      BLI_bvhtree_free(item.tree_to_refit);
+    }
+    BLI_mutex_end(&this->mutex);
+  }
+
+ private:
+  void delete_self() override
+  {
+    MEM_delete(this);
+  }
 };
 
 /**
@@ -109,9 +148,7 @@ bool bvhcache_has_tree(const BVHCache *bvh_cache, const BVHTree *tree)
 
 BVHCache *bvhcache_init()
 {
-  BVHCache *cache = MEM_cnew<BVHCache>(__func__);
-  BLI_mutex_init(&cache->mutex);
-  return cache;
+  return MEM_new<BVHCache>(__func__);
 }
 /**
  * Inserts a BVHTree of the given type under the cache
@@ -129,15 +166,49 @@ static void bvhcache_insert(BVHCache *bvh_cache, BVHTree *tree, BVHCacheType typ
   item->is_filled = true;
 }
 
+BVHCache *bvhcache_add_user(BVHCache *bvh_cache)
+{
+  if (bvh_cache) {
+    bvh_cache->add_user();
+  }
+  return bvh_cache;
+}
+
 void bvhcache_free(BVHCache *bvh_cache)
 {
-  for (int index = 0; index < BVHTREE_MAX_ITEM; index++) {
-    BVHCacheItem *item = &bvh_cache->items[index];
-    BLI_bvhtree_free(item->tree);
-    item->tree = nullptr;
+  bvh_cache->remove_user_and_delete_if_last();
+}
+
+void bvhcache_tag_positions_changed(BVHCache **bvh_cache_p)
+{
+  BVHCache *bvh_cache = *bvh_cache_p;
+  if (bvh_cache == nullptr) {
+    return;
+  }
+  if (!bvh_cache->is_mutable()) {
+    /* The trees are still valid for the other users of the cache. */
+    bvhcache_free(bvh_cache);
+    *bvh_cache_p = nullptr;
+    return;
+  }
+  for (const int type : IndexRange(BVHTREE_MAX_ITEM)) {
+    BVHCacheItem &item = bvh_cache->items[type];
+    BLI_bvhtree_free(item.tree_to_refit);
+    item.tree_to_refit = nullptr;
+    if (item.is_filled &&
+        ELEM(type, BVHTREE_FROM_VERTS, BVHTREE_FROM_EDGES, BVHTREE_FROM_CORNER_TRIS))
+    {
+      /* Trees of the other types contain a subset of the elements, so the leaf indices don't
+       * correspond to the element indices. */
+      item.tree_to_refit = item.tree;
+    }
+    else {
+      BLI_bvhtree_free(item.tree);
+      item.refit_count = 0;
+    }
+    item.tree = nullptr;
+    item.is_filled = false;
   }
-  BLI_mutex_end(&bvh_cache->mutex);
-  MEM_freeN(bvh_cache);
 }
 
 /**
@@ -896,6 +967,67 @@ static BitVector<> corner_tris_no_hidden_map_get(const blender::OffsetIndices<in
   return corner_tris_mask;
 }
 
+/**
+ * Update the bounds of a tree that was built for the same elements with different positions.
+ * \return False if the tree does not match the elements.
+ */
+static bool bvhtree_refit(BVHTree *tree,
+                          const BVHCacheType bvh_cache_type,
+                          const int tree_type,
+                          const Span<float3> positions,
+                          const Span<blender::int2> edges,
+                          const Span<int> corner_verts,
+                          const Span<int3> corner_tris)
+{
+  using namespace blender;
+  if (BLI_bvhtree_get_tree_type(tree) != tree_type) {
+    return false;
+  }
+  int elements_num = 0;
+  switch (bvh_cache_type) {
+    case BVHTREE_FROM_VERTS:
+      elements_num = positions.size();
+      break;
+    case BVHTREE_FROM_EDGES:
+      elements_num = edges.size();
+      break;
+    case BVHTREE_FROM_CORNER_TRIS:
+      elements_num = corner_tris.size();
+      break;
+    default:
+      return false;
+  }
+  if (BLI_bvhtree_get_len(tree) != elements_num) {
+    return false;
+  }
+  /* Run in isolation because the cache mutex is locked, see #bvhtree_balance. */
+  threading::isolate_task([&]() {
+    threading::parallel_for(IndexRange(elements_num), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        float co[3][3];
+        int co_num = 0;
+        switch (bvh_cache_type) {
+          case BVHTREE_FROM_VERTS:
+            copy_v3_v3(co[co_num++], positions[i]);
+            break;
+          case BVHTREE_FROM_EDGES:
+            copy_v3_v3(co[co_num++], positions[edges[i][0]]);
+            copy_v3_v3(co[co_num++], positions[edges[i][1]]);
+            break;
+          default:
+            copy_v3_v3(co[co_num++], positions[corner_verts[corner_tris[i][0]]]);
+            copy_v3_v3(co[co_num++], positions[corner_verts[corner_tris[i][1]]]);
+            copy_v3_v3(co[co_num++], positions[corner_verts[corner_tris[i][2]]]);
+            break;
+        }
+        BLI_bvhtree_update_node(tree, i, co[0], nullptr, co_num);
+      }
+    });
+  });
+  BLI_bvhtree_update_tree(tree);
+  return true;
+}
+
 BVHTree *BKE_bvhtree_from_mesh_get(BVHTreeFromMesh *data,
                                    const Mesh *mesh,
                                    const BVHCacheType bvh_cache_type,
@@ -935,6 +1067,29 @@ BVHTree *BKE_bvhtree_from_mesh_get(BVHTreeFromMesh *data,
     return data->tree;
   }
 
+  /* Refit the tree built for the previous positions if possible. */
+  BVHCacheItem &cache_item = (*bvh_cache_p)->items[bvh_cache_type];
+  BVHTree *tree_to_refit = std::exchange(cache_item.tree_to_refit, nullptr);
+  if (tree_to_refit != nullptr && cache_item.refit_count < BVHTREE_REFIT_MAX) {
+    if (bvhtree_refit(tree_to_refit,
+                      bvh_cache_type,
+                      tree_type,
+                      positions,
+                      edges,
+                      corner_verts,
+                      corner_tris))
+    {
+      data->tree = tree_to_refit;
+      data->cached = true;
+      bvhcache_insert(*bvh_cache_p, data->tree, bvh_cache_type);
+      cache_item.refit_count++;
+      bvhcache_unlock(*bvh_cache_p, lock_started);
+      return data->tree;
+    }
+  }
+  BLI_bvhtree_free(tree_to_refit);
+  cache_item.refit_count = 0;
+
   /* Create BVHTree. */
 
   switch (bvh_cache_type) {
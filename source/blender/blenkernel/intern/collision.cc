@@ -18,6 +18,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -646,147 +647,199 @@ static void cloth_collision_impulse_vert(const float clamp_sq,
   vert->impulse_count++;
 }
 
-static int cloth_collision_response_static(ClothModifierData *clmd,
-                                           CollisionModifierData *collmd,
-                                           Object *collob,
-                                           CollPair *collpair,
-                                           uint collision_count,
-                                           const float dt)
-{
-  int result = 0;
-  Cloth *cloth = clmd->clothObject;
-  const float clamp_sq = square_f(clmd->coll_parms->clamp * dt);
-  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
-  const float epsilon2 = BLI_bvhtree_get_epsilon(collmd->bvhtree);
-  const float min_distance = (clmd->coll_parms->epsilon + epsilon2) * (8.0f / 9.0f);
+/**
+ * Impulses of the vertices of a collision pair, computed from the velocities before any impulse of
+ * the current iteration is applied.
+ */
+struct CollPairImpulses {
+  /** Impulses of the three vertices of the first triangle, followed by the second triangle. */
+  float impulses[6][3];
+  bool has_impulse;
+};
 
+/* Number of collision pairs of which the impulses are computed together on one thread. */
+#define COLLISION_PAIRS_GRAIN_SIZE 256
+
+static bool cloth_collision_pair_impulses(const ClothModifierData *clmd,
+                                          const CollisionModifierData *collmd,
+                                          const Object *collob,
+                                          const CollPair *collpair,
+                                          const float time_multiplier,
+                                          const float min_distance,
+                                          float r_impulses[3][3])
+{
+  const Cloth *cloth = clmd->clothObject;
   const bool is_hair = (clmd->hairdata != nullptr);
-  for (int i = 0; i < collision_count; i++, collpair++) {
-    float i1[3], i2[3], i3[3];
-    float v1[3], v2[3], relativeVelocity[3];
-    zero_v3(i1);
-    zero_v3(i2);
-    zero_v3(i3);
+  float *i1 = r_impulses[0], *i2 = r_impulses[1], *i3 = r_impulses[2];
+  float v1[3], v2[3], relativeVelocity[3];
+  zero_v3(i1);
+  zero_v3(i2);
+  zero_v3(i3);
 
-    /* Only handle static collisions here. */
-    if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
-      continue;
-    }
+  /* Compute barycentric coordinates and relative "velocity" for both collision points. */
+  float w1 = collpair->aw1, w2 = collpair->aw2, w3 = collpair->aw3;
+  float u1 = collpair->bw1, u2 = collpair->bw2, u3 = collpair->bw3;
 
-    /* Compute barycentric coordinates and relative "velocity" for both collision points. */
-    float w1 = collpair->aw1, w2 = collpair->aw2, w3 = collpair->aw3;
-    float u1 = collpair->bw1, u2 = collpair->bw2, u3 = collpair->bw3;
+  if (is_hair) {
+    interp_v3_v3v3(v1, cloth->verts[collpair->ap1].tv, cloth->verts[collpair->ap2].tv, w2);
+  }
+  else {
+    collision_interpolateOnTriangle(v1,
+                                    cloth->verts[collpair->ap1].tv,
+                                    cloth->verts[collpair->ap2].tv,
+                                    cloth->verts[collpair->ap3].tv,
+                                    w1,
+                                    w2,
+                                    w3);
+  }
 
-    if (is_hair) {
-      interp_v3_v3v3(v1, cloth->verts[collpair->ap1].tv, cloth->verts[collpair->ap2].tv, w2);
-    }
-    else {
-      collision_interpolateOnTriangle(v1,
-                                      cloth->verts[collpair->ap1].tv,
-                                      cloth->verts[collpair->ap2].tv,
-                                      cloth->verts[collpair->ap3].tv,
-                                      w1,
-                                      w2,
-                                      w3);
-    }
+  collision_interpolateOnTriangle(v2,
+                                  collmd->current_v[collpair->bp1],
+                                  collmd->current_v[collpair->bp2],
+                                  collmd->current_v[collpair->bp3],
+                                  u1,
+                                  u2,
+                                  u3);
 
-    collision_interpolateOnTriangle(v2,
-                                    collmd->current_v[collpair->bp1],
-                                    collmd->current_v[collpair->bp2],
-                                    collmd->current_v[collpair->bp3],
-                                    u1,
-                                    u2,
-                                    u3);
-
-    sub_v3_v3v3(relativeVelocity, v2, v1);
-
-    /* Calculate the normal component of the relative velocity
-     * (actually only the magnitude - the direction is stored in 'normal'). */
-    const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
-    const float d = min_distance - collpair->distance;
-
-    /* If magrelVel < 0 the edges are approaching each other. */
-    if (magrelVel > 0.0f) {
-      /* Calculate Impulse magnitude to stop all motion in normal direction. */
-      float magtangent = 0, repulse = 0;
-      double impulse = 0.0;
-      float vrel_t_pre[3];
-      float temp[3];
-
-      /* Calculate tangential velocity. */
-      copy_v3_v3(temp, collpair->normal);
-      mul_v3_fl(temp, magrelVel);
-      sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
-
-      /* Decrease in magnitude of relative tangential velocity due to coulomb friction
-       * in original formula "magrelVel" should be the
-       * "change of relative velocity in normal direction". */
-      magtangent = min_ff(collob->pd->pdef_cfrict * 0.01f * magrelVel, len_v3(vrel_t_pre));
-
-      /* Apply friction impulse. */
-      if (magtangent > ALMOST_ZERO) {
-        normalize_v3(vrel_t_pre);
-
-        impulse = magtangent / 1.5;
-
-        VECADDMUL(i1, vrel_t_pre, double(w1) * impulse);
-        VECADDMUL(i2, vrel_t_pre, double(w2) * impulse);
-
-        if (!is_hair) {
-          VECADDMUL(i3, vrel_t_pre, double(w3) * impulse);
-        }
-      }
+  sub_v3_v3v3(relativeVelocity, v2, v1);
 
-      /* Apply velocity stopping impulse. */
-      impulse = magrelVel / 1.5f;
+  /* Calculate the normal component of the relative velocity
+   * (actually only the magnitude - the direction is stored in 'normal'). */
+  const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
+  const float d = min_distance - collpair->distance;
 
-      VECADDMUL(i1, collpair->normal, double(w1) * impulse);
-      VECADDMUL(i2, collpair->normal, double(w2) * impulse);
-      if (!is_hair) {
-        VECADDMUL(i3, collpair->normal, double(w3) * impulse);
-      }
+  /* If magrelVel < 0 the edges are approaching each other. */
+  if (magrelVel > 0.0f) {
+    /* Calculate Impulse magnitude to stop all motion in normal direction. */
+    float magtangent = 0, repulse = 0;
+    double impulse = 0.0;
+    float vrel_t_pre[3];
+    float temp[3];
 
-      if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
-        repulse = std::min(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+    /* Calculate tangential velocity. */
+    copy_v3_v3(temp, collpair->normal);
+    mul_v3_fl(temp, magrelVel);
+    sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
 
-        /* Stay on the safe side and clamp repulse. */
-        if (impulse > ALMOST_ZERO) {
-          repulse = min_ff(repulse, 5.0f * impulse);
-        }
+    /* Decrease in magnitude of relative tangential velocity due to coulomb friction
+     * in original formula "magrelVel" should be the
+     * "change of relative velocity in normal direction". */
+    magtangent = min_ff(collob->pd->pdef_cfrict * 0.01f * magrelVel, len_v3(vrel_t_pre));
 
-        repulse = max_ff(impulse, repulse);
+    /* Apply friction impulse. */
+    if (magtangent > ALMOST_ZERO) {
+      normalize_v3(vrel_t_pre);
 
-        impulse = repulse / 1.5f;
+      impulse = magtangent / 1.5;
 
-        VECADDMUL(i1, collpair->normal, impulse);
-        VECADDMUL(i2, collpair->normal, impulse);
-        if (!is_hair) {
-          VECADDMUL(i3, collpair->normal, impulse);
-        }
+      VECADDMUL(i1, vrel_t_pre, double(w1) * impulse);
+      VECADDMUL(i2, vrel_t_pre, double(w2) * impulse);
+
+      if (!is_hair) {
+        VECADDMUL(i3, vrel_t_pre, double(w3) * impulse);
       }
+    }
 
-      result = 1;
+    /* Apply velocity stopping impulse. */
+    impulse = magrelVel / 1.5f;
+
+    VECADDMUL(i1, collpair->normal, double(w1) * impulse);
+    VECADDMUL(i2, collpair->normal, double(w2) * impulse);
+    if (!is_hair) {
+      VECADDMUL(i3, collpair->normal, double(w3) * impulse);
     }
-    else if (d > ALMOST_ZERO) {
+
+    if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
+      repulse = std::min(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+
       /* Stay on the safe side and clamp repulse. */
-      float repulse = d / time_multiplier;
-      float impulse = repulse / 4.5f;
+      if (impulse > ALMOST_ZERO) {
+        repulse = min_ff(repulse, 5.0f * impulse);
+      }
 
-      VECADDMUL(i1, collpair->normal, w1 * impulse);
-      VECADDMUL(i2, collpair->normal, w2 * impulse);
+      repulse = max_ff(impulse, repulse);
 
+      impulse = repulse / 1.5f;
+
+      VECADDMUL(i1, collpair->normal, impulse);
+      VECADDMUL(i2, collpair->normal, impulse);
       if (!is_hair) {
-        VECADDMUL(i3, collpair->normal, w3 * impulse);
+        VECADDMUL(i3, collpair->normal, impulse);
       }
+    }
+
+    return true;
+  }
+  else if (d > ALMOST_ZERO) {
+    /* Stay on the safe side and clamp repulse. */
+    float repulse = d / time_multiplier;
+    float impulse = repulse / 4.5f;
+
+    VECADDMUL(i1, collpair->normal, w1 * impulse);
+    VECADDMUL(i2, collpair->normal, w2 * impulse);
+
+    if (!is_hair) {
+      VECADDMUL(i3, collpair->normal, w3 * impulse);
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
+static int cloth_collision_response_static(ClothModifierData *clmd,
+                                           CollisionModifierData *collmd,
+                                           Object *collob,
+                                           CollPair *collpair,
+                                           uint collision_count,
+                                           const float dt)
+{
+  using namespace blender;
+  int result = 0;
+  Cloth *cloth = clmd->clothObject;
+  const float clamp_sq = square_f(clmd->coll_parms->clamp * dt);
+  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
+  const float epsilon2 = BLI_bvhtree_get_epsilon(collmd->bvhtree);
+  const float min_distance = (clmd->coll_parms->epsilon + epsilon2) * (8.0f / 9.0f);
+
+  const bool is_hair = (clmd->hairdata != nullptr);
 
+  /* The impulses only depend on the velocities of the vertices, which don't change until all
+   * impulses are applied, so the impulses of all pairs are computed in parallel. */
+  Array<CollPairImpulses> pair_impulses(collision_count);
+  threading::parallel_for(
+      pair_impulses.index_range(), COLLISION_PAIRS_GRAIN_SIZE, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          /* Only handle static collisions here. */
+          if (collpair[i].flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
+            continue;
+          }
+          pair_impulses[i].has_impulse = cloth_collision_pair_impulses(clmd,
+                                                                       collmd,
+                                                                       collob,
+                                                                       &collpair[i],
+                                                                       time_multiplier,
+                                                                       min_distance,
+                                                                       pair_impulses[i].impulses);
+        }
+      });
+
+  /* Vertices are shared by multiple pairs, the impulses are applied in order. */
+  for (int i = 0; i < collision_count; i++, collpair++) {
+    if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
+      continue;
+    }
+    const float(*impulses)[3] = pair_impulses[i].impulses;
+    if (pair_impulses[i].has_impulse) {
       result = 1;
     }
 
     if (result) {
-      cloth_collision_impulse_vert(clamp_sq, i1, &cloth->verts[collpair->ap1]);
-      cloth_collision_impulse_vert(clamp_sq, i2, &cloth->verts[collpair->ap2]);
+      cloth_collision_impulse_vert(clamp_sq, impulses[0], &cloth->verts[collpair->ap1]);
+      cloth_collision_impulse_vert(clamp_sq, impulses[1], &cloth->verts[collpair->ap2]);
       if (!is_hair) {
-        cloth_collision_impulse_vert(clamp_sq, i3, &cloth->verts[collpair->ap3]);
+        cloth_collision_impulse_vert(clamp_sq, impulses[2], &cloth->verts[collpair->ap3]);
       }
     }
   }
@@ -794,93 +847,104 @@ static int cloth_collision_response_static(ClothModifierData *clmd,
   return result;
 }
 
-static int cloth_selfcollision_response_static(ClothModifierData *clmd,
-                                               CollPair *collpair,
-                                               uint collision_count,
-                                               const float dt)
+static bool cloth_selfcollision_pair_impulses(const ClothModifierData *clmd,
+                                              const CollPair *collpair,
+                                              const float time_multiplier,
+                                              const float min_distance,
+                                              float r_impulses[6][3])
 {
-  int result = 0;
-  Cloth *cloth = clmd->clothObject;
-  const float clamp_sq = square_f(clmd->coll_parms->self_clamp * dt);
-  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
-  const float min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f);
+  const Cloth *cloth = clmd->clothObject;
+  float(*ia)[3] = r_impulses;
+  float(*ib)[3] = r_impulses + 3;
+  float v1[3], v2[3], relativeVelocity[3];
+  for (int i = 0; i < 6; i++) {
+    zero_v3(r_impulses[i]);
+  }
+
+  /* Retrieve barycentric coordinates for both collision points. */
+  float w1 = collpair->aw1, w2 = collpair->aw2, w3 = collpair->aw3;
+  float u1 = collpair->bw1, u2 = collpair->bw2, u3 = collpair->bw3;
+
+  /* Calculate relative "velocity". */
+  collision_interpolateOnTriangle(v1,
+                                  cloth->verts[collpair->ap1].tv,
+                                  cloth->verts[collpair->ap2].tv,
+                                  cloth->verts[collpair->ap3].tv,
+                                  w1,
+                                  w2,
+                                  w3);
+
+  collision_interpolateOnTriangle(v2,
+                                  cloth->verts[collpair->bp1].tv,
+                                  cloth->verts[collpair->bp2].tv,
+                                  cloth->verts[collpair->bp3].tv,
+                                  u1,
+                                  u2,
+                                  u3);
 
-  for (int i = 0; i < collision_count; i++, collpair++) {
-    float ia[3][3] = {{0.0f}};
-    float ib[3][3] = {{0.0f}};
-    float v1[3], v2[3], relativeVelocity[3];
+  sub_v3_v3v3(relativeVelocity, v2, v1);
 
-    /* Only handle static collisions here. */
-    if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
-      continue;
+  /* Calculate the normal component of the relative velocity
+   * (actually only the magnitude - the direction is stored in 'normal'). */
+  const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
+  const float d = min_distance - collpair->distance;
+
+  /* TODO: Impulses should be weighed by mass as this is self col,
+   * this has to be done after mass distribution is implemented. */
+
+  /* If magrelVel < 0 the edges are approaching each other. */
+  if (magrelVel > 0.0f) {
+    /* Calculate Impulse magnitude to stop all motion in normal direction. */
+    float magtangent = 0, repulse = 0;
+    double impulse = 0.0;
+    float vrel_t_pre[3];
+    float temp[3];
+
+    /* Calculate tangential velocity. */
+    copy_v3_v3(temp, collpair->normal);
+    mul_v3_fl(temp, magrelVel);
+    sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
+
+    /* Decrease in magnitude of relative tangential velocity due to coulomb friction
+     * in original formula "magrelVel" should be the
+     * "change of relative velocity in normal direction". */
+    magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
+
+    /* Apply friction impulse. */
+    if (magtangent > ALMOST_ZERO) {
+      normalize_v3(vrel_t_pre);
+
+      impulse = magtangent / 1.5;
+
+      VECADDMUL(ia[0], vrel_t_pre, double(w1) * impulse);
+      VECADDMUL(ia[1], vrel_t_pre, double(w2) * impulse);
+      VECADDMUL(ia[2], vrel_t_pre, double(w3) * impulse);
+
+      VECADDMUL(ib[0], vrel_t_pre, double(u1) * -impulse);
+      VECADDMUL(ib[1], vrel_t_pre, double(u2) * -impulse);
+      VECADDMUL(ib[2], vrel_t_pre, double(u3) * -impulse);
     }
 
-    /* Retrieve barycentric coordinates for both collision points. */
-    float w1 = collpair->aw1, w2 = collpair->aw2, w3 = collpair->aw3;
-    float u1 = collpair->bw1, u2 = collpair->bw2, u3 = collpair->bw3;
+    /* Apply velocity stopping impulse. */
+    impulse = magrelVel / 3.0f;
 
-    /* Calculate relative "velocity". */
-    collision_interpolateOnTriangle(v1,
-                                    cloth->verts[collpair->ap1].tv,
-                                    cloth->verts[collpair->ap2].tv,
-                                    cloth->verts[collpair->ap3].tv,
-                                    w1,
-                                    w2,
-                                    w3);
+    VECADDMUL(ia[0], collpair->normal, double(w1) * impulse);
+    VECADDMUL(ia[1], collpair->normal, double(w2) * impulse);
+    VECADDMUL(ia[2], collpair->normal, double(w3) * impulse);
+
+    VECADDMUL(ib[0], collpair->normal, double(u1) * -impulse);
+    VECADDMUL(ib[1], collpair->normal, double(u2) * -impulse);
+    VECADDMUL(ib[2], collpair->normal, double(u3) * -impulse);
+
+    if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
+      repulse = std::min(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
 
-    collision_interpolateOnTriangle(v2,
-                                    cloth->verts[collpair->bp1].tv,
-                                    cloth->verts[collpair->bp2].tv,
-                                    cloth->verts[collpair->bp3].tv,
-                                    u1,
-                                    u2,
-                                    u3);
-
-    sub_v3_v3v3(relativeVelocity, v2, v1);
-
-    /* Calculate the normal component of the relative velocity
-     * (actually only the magnitude - the direction is stored in 'normal'). */
-    const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
-    const float d = min_distance - collpair->distance;
-
-    /* TODO: Impulses should be weighed by mass as this is self col,
-     * this has to be done after mass distribution is implemented. */
-
-    /* If magrelVel < 0 the edges are approaching each other. */
-    if (magrelVel > 0.0f) {
-      /* Calculate Impulse magnitude to stop all motion in normal direction. */
-      float magtangent = 0, repulse = 0;
-      double impulse = 0.0;
-      float vrel_t_pre[3];
-      float temp[3];
-
-      /* Calculate tangential velocity. */
-      copy_v3_v3(temp, collpair->normal);
-      mul_v3_fl(temp, magrelVel);
-      sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
-
-      /* Decrease in magnitude of relative tangential velocity due to coulomb friction
-       * in original formula "magrelVel" should be the
-       * "change of relative velocity in normal direction". */
-      magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
-
-      /* Apply friction impulse. */
-      if (magtangent > ALMOST_ZERO) {
-        normalize_v3(vrel_t_pre);
-
-        impulse = magtangent / 1.5;
-
-        VECADDMUL(ia[0], vrel_t_pre, double(w1) * impulse);
-        VECADDMUL(ia[1], vrel_t_pre, double(w2) * impulse);
-        VECADDMUL(ia[2], vrel_t_pre, double(w3) * impulse);
-
-        VECADDMUL(ib[0], vrel_t_pre, double(u1) * -impulse);
-        VECADDMUL(ib[1], vrel_t_pre, double(u2) * -impulse);
-        VECADDMUL(ib[2], vrel_t_pre, double(u3) * -impulse);
+      if (impulse > ALMOST_ZERO) {
+        repulse = min_ff(repulse, 5.0 * impulse);
       }
 
-      /* Apply velocity stopping impulse. */
-      impulse = magrelVel / 3.0f;
+      repulse = max_ff(impulse, repulse);
+      impulse = repulse / 1.5f;
 
       VECADDMUL(ia[0], collpair->normal, double(w1) * impulse);
       VECADDMUL(ia[1], collpair->normal, double(w2) * impulse);
@@ -889,52 +953,72 @@ static int cloth_selfcollision_response_static(ClothModifierData *clmd,
       VECADDMUL(ib[0], collpair->normal, double(u1) * -impulse);
       VECADDMUL(ib[1], collpair->normal, double(u2) * -impulse);
       VECADDMUL(ib[2], collpair->normal, double(u3) * -impulse);
+    }
 
-      if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
-        repulse = std::min(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
-
-        if (impulse > ALMOST_ZERO) {
-          repulse = min_ff(repulse, 5.0 * impulse);
-        }
+    return true;
+  }
+  else if (d > ALMOST_ZERO) {
+    /* Stay on the safe side and clamp repulse. */
+    float repulse = d * 1.0f / time_multiplier;
+    float impulse = repulse / 9.0f;
 
-        repulse = max_ff(impulse, repulse);
-        impulse = repulse / 1.5f;
+    VECADDMUL(ia[0], collpair->normal, w1 * impulse);
+    VECADDMUL(ia[1], collpair->normal, w2 * impulse);
+    VECADDMUL(ia[2], collpair->normal, w3 * impulse);
 
-        VECADDMUL(ia[0], collpair->normal, double(w1) * impulse);
-        VECADDMUL(ia[1], collpair->normal, double(w2) * impulse);
-        VECADDMUL(ia[2], collpair->normal, double(w3) * impulse);
+    VECADDMUL(ib[0], collpair->normal, u1 * -impulse);
+    VECADDMUL(ib[1], collpair->normal, u2 * -impulse);
+    VECADDMUL(ib[2], collpair->normal, u3 * -impulse);
 
-        VECADDMUL(ib[0], collpair->normal, double(u1) * -impulse);
-        VECADDMUL(ib[1], collpair->normal, double(u2) * -impulse);
-        VECADDMUL(ib[2], collpair->normal, double(u3) * -impulse);
-      }
+    return true;
+  }
 
-      result = 1;
-    }
-    else if (d > ALMOST_ZERO) {
-      /* Stay on the safe side and clamp repulse. */
-      float repulse = d * 1.0f / time_multiplier;
-      float impulse = repulse / 9.0f;
+  return false;
+}
 
-      VECADDMUL(ia[0], collpair->normal, w1 * impulse);
-      VECADDMUL(ia[1], collpair->normal, w2 * impulse);
-      VECADDMUL(ia[2], collpair->normal, w3 * impulse);
+static int cloth_selfcollision_response_static(ClothModifierData *clmd,
+                                               CollPair *collpair,
+                                               uint collision_count,
+                                               const float dt)
+{
+  using namespace blender;
+  int result = 0;
+  Cloth *cloth = clmd->clothObject;
+  const float clamp_sq = square_f(clmd->coll_parms->self_clamp * dt);
+  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
+  const float min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f);
 
-      VECADDMUL(ib[0], collpair->normal, u1 * -impulse);
-      VECADDMUL(ib[1], collpair->normal, u2 * -impulse);
-      VECADDMUL(ib[2], collpair->normal, u3 * -impulse);
+  /* See #cloth_collision_response_static. */
+  Array<CollPairImpulses> pair_impulses(collision_count);
+  threading::parallel_for(
+      pair_impulses.index_range(), COLLISION_PAIRS_GRAIN_SIZE, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          /* Only handle static collisions here. */
+          if (collpair[i].flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
+            continue;
+          }
+          pair_impulses[i].has_impulse = cloth_selfcollision_pair_impulses(
+              clmd, &collpair[i], time_multiplier, min_distance, pair_impulses[i].impulses);
+        }
+      });
 
+  for (int i = 0; i < collision_count; i++, collpair++) {
+    if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
+      continue;
+    }
+    const float(*impulses)[3] = pair_impulses[i].impulses;
+    if (pair_impulses[i].has_impulse) {
       result = 1;
     }
 
     if (result) {
-      cloth_collision_impulse_vert(clamp_sq, ia[0], &cloth->verts[collpair->ap1]);
-      cloth_collision_impulse_vert(clamp_sq, ia[1], &cloth->verts[collpair->ap2]);
-      cloth_collision_impulse_vert(clamp_sq, ia[2], &cloth->verts[collpair->ap3]);
+      cloth_collision_impulse_vert(clamp_sq, impulses[0], &cloth->verts[collpair->ap1]);
+      cloth_collision_impulse_vert(clamp_sq, impulses[1], &cloth->verts[collpair->ap2]);
+      cloth_collision_impulse_vert(clamp_sq, impulses[2], &cloth->verts[collpair->ap3]);
 
-      cloth_collision_impulse_vert(clamp_sq, ib[0], &cloth->verts[collpair->bp1]);
-      cloth_collision_impulse_vert(clamp_sq, ib[1], &cloth->verts[collpair->bp2]);
-      cloth_collision_impulse_vert(clamp_sq, ib[2], &cloth->verts[collpair->bp3]);
+      cloth_collision_impulse_vert(clamp_sq, impulses[3], &cloth->verts[collpair->bp1]);
+      cloth_collision_impulse_vert(clamp_sq, impulses[4], &cloth->verts[collpair->bp2]);
+      cloth_collision_impulse_vert(clamp_sq, impulses[5], &cloth->verts[collpair->bp3]);
     }
   }
 
@@ -1426,6 +1510,33 @@ static bool cloth_bvh_selfcollisions_nearcheck(ClothModifierData *clmd,
   return data.collided;
 }
 
+/**
+ * Add the accumulated impulses to the "velocities" of the vertices (just xnew = xold + v; no dt in
+ * v), and return the number of vertices with impulses.
+ */
+static int cloth_collision_impulses_apply(ClothVertex *verts, const int mvert_num)
+{
+  using namespace blender;
+  return threading::parallel_reduce(
+      IndexRange(mvert_num),
+      1024,
+      0,
+      [&](const IndexRange range, int count) {
+        for (const int64_t i : range) {
+          if (verts[i].impulse_count) {
+            add_v3_v3(verts[i].tv, verts[i].impulse);
+            add_v3_v3(verts[i].dcvel, verts[i].impulse);
+            zero_v3(verts[i].impulse);
+            verts[i].impulse_count = 0;
+
+            count++;
+          }
+        }
+        return count;
+      },
+      [](const int a, const int b) { return a + b; });
+}
+
 static int cloth_bvh_objcollisions_resolve(ClothModifierData *clmd,
                                            Object **collobjs,
                                            CollPair **collisions,
@@ -1460,17 +1571,7 @@ static int cloth_bvh_objcollisions_resolve(ClothModifierData *clmd,
 
     /* Apply impulses in parallel. */
     if (result) {
-      for (i = 0; i < mvert_num; i++) {
-        // calculate "velocities" (just xnew = xold + v; no dt in v)
-        if (verts[i].impulse_count) {
-          add_v3_v3(verts[i].tv, verts[i].impulse);
-          add_v3_v3(verts[i].dcvel, verts[i].impulse);
-          zero_v3(verts[i].impulse);
-          verts[i].impulse_count = 0;
-
-          ret++;
-        }
-      }
+      ret += cloth_collision_impulses_apply(verts, mvert_num);
     }
     else {
       break;
@@ -1485,7 +1586,7 @@ static int cloth_bvh_selfcollisions_resolve(ClothModifierData *clmd,
                                             const float dt)
 {
   Cloth *cloth = clmd->clothObject;
-  int i = 0, j = 0, mvert_num = 0;
+  int j = 0, mvert_num = 0;
   ClothVertex *verts = nullptr;
   int ret = 0;
   int result = 0;
@@ -1500,17 +1601,7 @@ static int cloth_bvh_selfcollisions_resolve(ClothModifierData *clmd,
 
     /* Apply impulses in parallel. */
     if (result) {
-      for (i = 0; i < mvert_num; i++) {
-        if (verts[i].impulse_count) {
-          // VECADDMUL ( verts[i].tv, verts[i].impulse, 1.0f / verts[i].impulse_count );
-          add_v3_v3(verts[i].tv, verts[i].impulse);
-          add_v3_v3(verts[i].dcvel, verts[i].impulse);
-          zero_v3(verts[i].impulse);
-          verts[i].impulse_count = 0;
-
-          ret++;
-        }
-      }
+      ret += cloth_collision_impulses_apply(verts, mvert_num);
     }
 
     if (!result) {
@@ -1587,24 +1678,29 @@ int cloth_bvh_collision(
       coll_counts_obj = MEM_cnew_array<uint>(numcollobj, "CollCounts");
       overlap_obj = MEM_cnew_array<BVHTreeOverlap *>(numcollobj, "BVHOverlap");
 
-      for (i = 0; i < numcollobj; i++) {
-        Object *collob = collobjs[i];
-        CollisionModifierData *collmd = (CollisionModifierData *)BKE_modifiers_findby_type(
-            collob, eModifierType_Collision);
-
-        if (!collmd->bvhtree) {
-          continue;
-        }
-
-        /* Move object to position (step) in time. */
-        collision_move_object(collmd, step + dt, step, false);
-
-        overlap_obj[i] = BLI_bvhtree_overlap(cloth_bvh,
-                                             collmd->bvhtree,
-                                             &coll_counts_obj[i],
-                                             is_hair ? nullptr : cloth_bvh_obj_overlap_cb,
-                                             clmd);
-      }
+      /* Colliders are independent of each other, with many small colliders the threads of a
+       * single overlap query would not be used well. */
+      blender::threading::parallel_for(
+          blender::IndexRange(numcollobj), 1, [&](const blender::IndexRange range) {
+            for (const int64_t i : range) {
+              Object *collob = collobjs[i];
+              CollisionModifierData *collmd = (CollisionModifierData *)BKE_modifiers_findby_type(
+                  collob, eModifierType_Collision);
+
+              if (!collmd->bvhtree) {
+                continue;
+              }
+
+              /* Move object to position (step) in time. */
+              collision_move_object(collmd, step + dt, step, false);
+
+              overlap_obj[i] = BLI_bvhtree_overlap(cloth_bvh,
+                                                   collmd->bvhtree,
+                                                   &coll_counts_obj[i],
+                                                   is_hair ? nullptr : cloth_bvh_obj_overlap_cb,
+                                                   clmd);
+            }
+          });
     }
   }
 
@@ -1687,15 +1783,18 @@ int cloth_bvh_collision(
 
     /* Apply all collision resolution. */
     if (ret2) {
-      for (i = 0; i < mvert_num; i++) {
-        if (clmd->sim_parms->vgroup_mass > 0) {
-          if (verts[i].flags & CLOTH_VERT_FLAG_PINNED) {
-            continue;
-          }
-        }
-
-        add_v3_v3v3(verts[i].tx, verts[i].txold, verts[i].tv);
-      }
+      blender::threading::parallel_for(
+          blender::IndexRange(mvert_num), 1024, [&](const blender::IndexRange range) {
+            for (const int64_t i : range) {
+              if (clmd->sim_parms->vgroup_mass > 0) {
+                if (verts[i].flags & CLOTH_VERT_FLAG_PINNED) {
+                  continue;
+                }
+              }
+
+              add_v3_v3v3(verts[i].tx, verts[i].txold, verts[i].tv);
+            }
+          });
     }
 
     rounds++;
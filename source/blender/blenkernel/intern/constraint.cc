@@ -10,6 +10,7 @@
 #define DNA_DEPRECATED_ALLOW
 
 #include <algorithm>
+#include <array>
 #include <cfloat>
 #include <cmath>
 #include <cstddef>
@@ -19,6 +20,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_index_range.hh"
 #include "BLI_kdopbvh.h"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
@@ -858,6 +860,67 @@ static void default_get_tarmat_full_bbone(Depsgraph * /*depsgraph*/,
   }
 }
 
+/**
+ * Storage for the temporary targets of constraints that are being solved. The targets are created
+ * and freed again for every constraint on every evaluation, while solving they are taken from
+ * this buffer instead of being allocated. See #ConstraintTempTargetsScope.
+ */
+struct ConstraintTempTargets {
+  std::array<bConstraintTarget, 4> targets;
+  /** One bit for every target of the buffer that is used. */
+  uint8_t used_mask = 0;
+};
+
+static thread_local ConstraintTempTargets *constraint_temp_targets = nullptr;
+
+/** Take the temporary targets of the constraints solved in this scope from a local buffer. */
+class ConstraintTempTargetsScope {
+ private:
+  ConstraintTempTargets buffer_;
+  ConstraintTempTargets *previous_;
+
+ public:
+  ConstraintTempTargetsScope() : previous_(constraint_temp_targets)
+  {
+    constraint_temp_targets = &buffer_;
+  }
+
+  ~ConstraintTempTargetsScope()
+  {
+    BLI_assert_msg(buffer_.used_mask == 0, "Temporary constraint targets were not freed");
+    constraint_temp_targets = previous_;
+  }
+};
+
+static bConstraintTarget *constraint_temp_target_new()
+{
+  if (ConstraintTempTargets *buffer = constraint_temp_targets) {
+    for (const int i : blender::IndexRange(buffer->targets.size())) {
+      if ((buffer->used_mask & (1 << i)) == 0) {
+        buffer->used_mask |= (1 << i);
+        bConstraintTarget *ct = &buffer->targets[i];
+        memset(ct, 0, sizeof(*ct));
+        return ct;
+      }
+    }
+  }
+  return static_cast<bConstraintTarget *>(
+      MEM_callocN(sizeof(bConstraintTarget), "tempConstraintTarget"));
+}
+
+static void constraint_temp_target_free(ListBase *list, bConstraintTarget *ct)
+{
+  BLI_remlink(list, ct);
+  if (ConstraintTempTargets *buffer = constraint_temp_targets) {
+    const int64_t i = ct - buffer->targets.data();
+    if (i >= 0 && i < int64_t(buffer->targets.size())) {
+      buffer->used_mask &= ~(1 << i);
+      return;
+    }
+  }
+  MEM_freeN(ct);
+}
+
 /* This following macro should be used for all standard single-target *_get_tars functions
  * to save typing and reduce maintenance woes.
  * (Hopefully all compilers will be happy with the lines with just a space on them.
@@ -866,8 +929,7 @@ static void default_get_tarmat_full_bbone(Depsgraph * /*depsgraph*/,
 /* TODO: cope with getting rotation order... */
 #define SINGLETARGET_GET_TARS(con, datatar, datasubtarget, ct, list) \
   { \
-    ct = static_cast<bConstraintTarget *>( \
-        MEM_callocN(sizeof(bConstraintTarget), "tempConstraintTarget")); \
+    ct = constraint_temp_target_new(); \
 \
     ct->tar = datatar; \
     STRNCPY(ct->subtarget, datasubtarget); \
@@ -902,8 +964,7 @@ static void default_get_tarmat_full_bbone(Depsgraph * /*depsgraph*/,
 /* TODO: cope with getting rotation order... */
 #define SINGLETARGETNS_GET_TARS(con, datatar, ct, list) \
   { \
-    ct = static_cast<bConstraintTarget *>( \
-        MEM_callocN(sizeof(bConstraintTarget), "tempConstraintTarget")); \
+    ct = constraint_temp_target_new(); \
 \
     ct->tar = datatar; \
     ct->space = con->tarspace; \
@@ -932,7 +993,7 @@ static void default_get_tarmat_full_bbone(Depsgraph * /*depsgraph*/,
         con->tarspace = char(ct->space); \
       } \
 \
-      BLI_freelinkN(list, ct); \
+      constraint_temp_target_free(list, ct); \
       ct = ctn; \
     } \
   } \
@@ -953,7 +1014,7 @@ static void default_get_tarmat_full_bbone(Depsgraph * /*depsgraph*/,
         con->tarspace = char(ct->space); \
       } \
 \
-      BLI_freelinkN(list, ct); \
+      constraint_temp_target_free(list, ct); \
       ct = ctn; \
     } \
   } \
@@ -6304,7 +6365,7 @@ void BKE_constraint_targets_flush(bConstraint *con, ListBase *targets, bool no_c
       STRNCPY(con->space_subtarget, ct->subtarget);
     }
 
-    BLI_freelinkN(targets, ct);
+    constraint_temp_target_free(targets, ct);
   }
 
   /* Release the constraint-specific targets. */
@@ -6459,6 +6520,9 @@ void BKE_constraints_solve(Depsgraph *depsgraph,
     return;
   }
 
+  /* Avoid allocating the temporary targets of every constraint. */
+  ConstraintTempTargetsScope temp_targets_scope;
+
   /* loop over available constraints, solving and blending them */
   LISTBASE_FOREACH (bConstraint *, con, conlist) {
     const bConstraintTypeInfo *cti = BKE_constraint_typeinfo_get(con);
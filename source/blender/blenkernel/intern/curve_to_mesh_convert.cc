@@ -271,6 +271,8 @@ static ResultOffsets calculate_result_offsets(const CurvesInfo &info, const bool
   const OffsetIndices<int> main_offsets = info.main.evaluated_points_by_curve();
   const OffsetIndices<int> profile_offsets = info.profile.evaluated_points_by_curve();
 
+  const int profiles_num = profile_offsets.size();
+
   threading::parallel_invoke(
       result.total > 1024,
       [&]() {
@@ -279,65 +281,71 @@ static ResultOffsets calculate_result_offsets(const CurvesInfo &info, const bool
         result.loop.reinitialize(result.total + 1);
         result.face.reinitialize(result.total + 1);
 
-        int mesh_index = 0;
-        int vert_offset = 0;
-        int edge_offset = 0;
-        int loop_offset = 0;
-        int face_offset = 0;
-        for (const int i_main : main_offsets.index_range()) {
-          const bool main_cyclic = info.main_cyclic[i_main];
-          const int main_point_num = main_offsets[i_main].size();
-          const int main_segment_num = segments_num_no_duplicate_edge(main_point_num, main_cyclic);
-          for (const int i_profile : profile_offsets.index_range()) {
-            result.vert[mesh_index] = vert_offset;
-            result.edge[mesh_index] = edge_offset;
-            result.loop[mesh_index] = loop_offset;
-            result.face[mesh_index] = face_offset;
-
-            const bool profile_cyclic = info.profile_cyclic[i_profile];
-            const int profile_point_num = profile_offsets[i_profile].size();
-            const int profile_segment_num = curves::segments_num(profile_point_num,
-                                                                 profile_cyclic);
-
-            const bool has_caps = fill_caps && !main_cyclic && profile_cyclic &&
-                                  profile_point_num > 2;
-            const int tube_face_num = main_segment_num * profile_segment_num;
-
-            vert_offset += main_point_num * profile_point_num;
-
-            /* Add the ring edges, with one ring for every curve vertex, and the edge loops
-             * that run along the length of the curve, starting on the first profile. */
-            edge_offset += main_point_num * profile_segment_num +
-                           main_segment_num * profile_point_num;
-
-            /* Add two cap N-gons for every ending. */
-            face_offset += tube_face_num + (has_caps ? 2 : 0);
-
-            /* All faces on the tube are quads, and all cap faces are N-gons with an edge for each
-             * profile edge. */
-            loop_offset += tube_face_num * 4 + (has_caps ? profile_segment_num * 2 : 0);
-
-            mesh_index++;
+        /* Count the elements of every combination in parallel, then accumulate the counts.
+         * With many short main curves (e.g. hair) this is a significant part of the total. */
+        const int64_t grain_size = std::max<int64_t>(1, 4096 / std::max(profiles_num, 1));
+        threading::parallel_for(main_offsets.index_range(), grain_size, [&](IndexRange range) {
+          for (const int i_main : range) {
+            const bool main_cyclic = info.main_cyclic[i_main];
+            const int main_point_num = main_offsets[i_main].size();
+            const int main_segment_num = segments_num_no_duplicate_edge(main_point_num,
+                                                                        main_cyclic);
+            for (const int i_profile : profile_offsets.index_range()) {
+              const int mesh_index = i_main * profiles_num + i_profile;
+
+              const bool profile_cyclic = info.profile_cyclic[i_profile];
+              const int profile_point_num = profile_offsets[i_profile].size();
+              const int profile_segment_num = curves::segments_num(profile_point_num,
+                                                                   profile_cyclic);
+
+              const bool has_caps = fill_caps && !main_cyclic && profile_cyclic &&
+                                    profile_point_num > 2;
+              const int tube_face_num = main_segment_num * profile_segment_num;
+
+              result.vert[mesh_index] = main_point_num * profile_point_num;
+
+              /* Add the ring edges, with one ring for every curve vertex, and the edge loops
+               * that run along the length of the curve, starting on the first profile. */
+              result.edge[mesh_index] = main_point_num * profile_segment_num +
+                                        main_segment_num * profile_point_num;
+
+              /* Add two cap N-gons for every ending. */
+              result.face[mesh_index] = tube_face_num + (has_caps ? 2 : 0);
+
+              /* All faces on the tube are quads, and all cap faces are N-gons with an edge for
+               * each profile edge. */
+              result.loop[mesh_index] = tube_face_num * 4 +
+                                        (has_caps ? profile_segment_num * 2 : 0);
+            }
           }
-        }
+        });
 
-        result.vert.last() = vert_offset;
-        result.edge.last() = edge_offset;
-        result.loop.last() = loop_offset;
-        result.face.last() = face_offset;
+        threading::parallel_invoke(
+            result.total > 4096,
+            [&]() { offset_indices::accumulate_counts_to_offsets(result.vert); },
+            [&]() { offset_indices::accumulate_counts_to_offsets(result.edge); },
+            [&]() { offset_indices::accumulate_counts_to_offsets(result.loop); },
+            [&]() { offset_indices::accumulate_counts_to_offsets(result.face); });
       },
       [&]() {
         result.main_indices.reinitialize(result.total);
         result.profile_indices.reinitialize(result.total);
 
-        int mesh_index = 0;
-        for (const int i_main : main_offsets.index_range()) {
-          for (const int i_profile : profile_offsets.index_range()) {
-            result.main_indices[mesh_index] = i_main;
-            result.profile_indices[mesh_index] = i_profile;
-            mesh_index++;
-          }
+        if (profiles_num == 1) {
+          /* Common case of a single profile, e.g. when converting hair curves. */
+          array_utils::fill_index_range<int>(result.main_indices);
+          result.profile_indices.fill(0);
+          return;
         }
+        threading::parallel_for(main_offsets.index_range(), 1024, [&](IndexRange range) {
+          for (const int i_main : range) {
+            for (const int i_profile : profile_offsets.index_range()) {
+              const int mesh_index = i_main * profiles_num + i_profile;
+              result.main_indices[mesh_index] = i_main;
+              result.profile_indices[mesh_index] = i_profile;
+            }
+          }
+        });
       },
       [&]() { result.any_single_point_main = offsets_contain_single_point(main_offsets); },
       [&]() { result.any_single_point_profile = offsets_contain_single_point(profile_offsets); });
@@ -36,6 +36,7 @@
 #include "BLI_string_ref.hh"
 #include "BLI_string_utf8.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #ifndef NDEBUG
@@ -2383,12 +2384,21 @@ static void *copy_layer_data(const eCustomDataType type, const void *data, const
   const LayerTypeInfo &type_info = *layerType_getInfo(type);
   const int64_t size_in_bytes = int64_t(totelem) * type_info.size;
   void *new_data = MEM_mallocN_aligned(size_in_bytes, type_info.alignment, __func__);
-  if (type_info.copy) {
-    type_info.copy(data, new_data, totelem);
-  }
-  else {
-    memcpy(new_data, data, size_in_bytes);
-  }
+  /* Copying happens when shared layers are first modified, e.g. in every modifier that changes a
+   * layer of its input mesh, so use multiple threads for large layers. The copy callbacks of all
+   * types handle every element separately, so they can be called for slices. */
+  blender::threading::memory_bandwidth_bound_task(size_in_bytes * 2, [&]() {
+    blender::threading::parallel_for(IndexRange(totelem), 8192, [&](const IndexRange range) {
+      const void *src = POINTER_OFFSET(data, range.start() * type_info.size);
+      void *dst = POINTER_OFFSET(new_data, range.start() * type_info.size);
+      if (type_info.copy) {
+        type_info.copy(src, dst, int(range.size()));
+      }
+      else {
+        memcpy(dst, src, range.size() * type_info.size);
+      }
+    });
+  });
   return new_data;
 }
 
@@ -5508,6 +5518,21 @@ static void blend_read_layer_data(BlendDataReader *reader, CustomDataLayer &laye
   }
 }
 
+/**
+ * Reference the layer data directly from the memory-mapped file when possible, which is only
+ * valid for trivial types that don't need any processing after reading.
+ */
+static const ImplicitSharingInfo *blend_read_layer_data_mapped(BlendDataReader *reader,
+                                                               CustomDataLayer &layer,
+                                                               const int count)
+{
+  const LayerTypeInfo *typeInfo = layerType_getInfo(eCustomDataType(layer.type));
+  if (typeInfo->copy || typeInfo->free || (layer.flag & CD_FLAG_EXTERNAL)) {
+    return nullptr;
+  }
+  return BLO_read_mapped_data(reader, &layer.data, size_t(count) * typeInfo->size);
+}
+
 void CustomData_blend_read(BlendDataReader *reader, CustomData *data, const int count)
 {
   BLO_read_struct_array(reader, CustomDataLayer, data->totlayer, &data->layers);
@@ -5533,6 +5558,11 @@ void CustomData_blend_read(BlendDataReader *reader, CustomData *data, const int
     if (CustomData_verify_versions(data, i)) {
       layer->sharing_info = BLO_read_shared(
           reader, &layer->data, [&]() -> const ImplicitSharingInfo * {
+            if (const ImplicitSharingInfo *sharing_info = blend_read_layer_data_mapped(
+                    reader, *layer, count))
+            {
+              return sharing_info;
+            }
             blend_read_layer_data(reader, *layer, count);
             if (layer->data == nullptr) {
               return nullptr;
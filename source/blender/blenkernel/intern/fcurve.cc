@@ -6,6 +6,7 @@
  * \ingroup bke
  */
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <cstddef>
@@ -2076,12 +2077,54 @@ static float fcurve_eval_keyframes_extrapolate(const FCurve *fcu,
   return endpoint_bezt->vec[1][1] - (fac * dx);
 }
 
+/**
+ * Find the keyframe that #BKE_fcurve_bezt_binarysearch_index_ex would find for the evaluation
+ * time, by only looking at the keyframe of the previous evaluation and the one after it. Playback
+ * evaluates the same or the following segment of a curve on every frame.
+ *
+ * This only succeeds when the result is unambiguous, i.e. when there is no other keyframe within
+ * the threshold of the evaluation time.
+ */
+static bool fcurve_eval_keyframes_segment_from_hint(const FCurve *fcu,
+                                                    const BezTriple *bezts,
+                                                    const float evaltime,
+                                                    const float threshold,
+                                                    const int segment_hint,
+                                                    int *r_index,
+                                                    bool *r_exact)
+{
+  const int totvert = int(fcu->totvert);
+  const int end = std::min(segment_hint + 2, totvert);
+  for (int a = std::max(segment_hint, 1); a < end; a++) {
+    const float prev_frame = bezts[a - 1].vec[1][0];
+    const float frame = bezts[a].vec[1][0];
+    if (evaltime - prev_frame <= threshold) {
+      return false;
+    }
+    if (evaltime < frame - threshold) {
+      *r_index = a;
+      *r_exact = false;
+      return true;
+    }
+    if (evaltime <= frame + threshold) {
+      if (a + 1 < totvert && bezts[a + 1].vec[1][0] - evaltime <= threshold) {
+        return false;
+      }
+      *r_index = a;
+      *r_exact = true;
+      return true;
+    }
+  }
+  return false;
+}
+
 static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
                                                const BezTriple *bezts,
-                                               float evaltime)
+                                               float evaltime,
+                                               int *segment_hint)
 {
   const float eps = 1.e-8f;
-  uint a;
+  int a;
 
   /* Evaluation-time occurs somewhere in the middle of the curve. */
   bool exact = false;
@@ -2096,7 +2139,16 @@ static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
    *   Weird errors, like selecting the wrong keyframe range (see #39207), occur.
    *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
    */
-  a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  const float threshold = 0.0001f;
+  if (segment_hint == nullptr ||
+      !fcurve_eval_keyframes_segment_from_hint(
+          fcu, bezts, evaltime, threshold, *segment_hint, &a, &exact))
+  {
+    a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, threshold, &exact);
+  }
+  if (segment_hint != nullptr) {
+    *segment_hint = a;
+  }
   const BezTriple *bezt = bezts + a;
 
   if (exact) {
@@ -2340,7 +2392,10 @@ static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
 }
 
 /* Calculate F-Curve value for 'evaltime' using #BezTriple keyframes. */
-static float fcurve_eval_keyframes(const FCurve *fcu, const BezTriple *bezts, float evaltime)
+static float fcurve_eval_keyframes(const FCurve *fcu,
+                                   const BezTriple *bezts,
+                                   float evaltime,
+                                   int *segment_hint)
 {
   if (evaltime <= bezts->vec[1][0]) {
     return fcurve_eval_keyframes_extrapolate(fcu, bezts, evaltime, 0, +1);
@@ -2351,7 +2406,7 @@ static float fcurve_eval_keyframes(const FCurve *fcu, const BezTriple *bezts, fl
     return fcurve_eval_keyframes_extrapolate(fcu, bezts, evaltime, fcu->totvert - 1, -1);
   }
 
-  return fcurve_eval_keyframes_interpolate(fcu, bezts, evaltime);
+  return fcurve_eval_keyframes_interpolate(fcu, bezts, evaltime, segment_hint);
 }
 
 /* Calculate F-Curve value for 'evaltime' using #FPoint samples. */
@@ -2399,7 +2454,10 @@ static float fcurve_eval_samples(const FCurve *fcu, const FPoint *fpts, float ev
 /* Evaluate and return the value of the given F-Curve at the specified frame ("evaltime")
  * NOTE: this is also used for drivers.
  */
-static float evaluate_fcurve_ex(const FCurve *fcu, float evaltime, float cvalue)
+static float evaluate_fcurve_ex(const FCurve *fcu,
+                                float evaltime,
+                                float cvalue,
+                                int *segment_hint = nullptr)
 {
   /* Evaluate modifiers which modify time to evaluate the base curve at. */
   FModifiersStackStorage storage;
@@ -2415,7 +2473,7 @@ static float evaluate_fcurve_ex(const FCurve *fcu, float evaltime, float cvalue)
    *   F-Curve modifier on the stack requested the curve to be evaluated at.
    */
   if (fcu->bezt) {
-    cvalue = fcurve_eval_keyframes(fcu, fcu->bezt, devaltime);
+    cvalue = fcurve_eval_keyframes(fcu, fcu->bezt, devaltime, segment_hint);
   }
   else if (fcu->fpt) {
     cvalue = fcurve_eval_samples(fcu, fcu->fpt, devaltime);
@@ -2434,11 +2492,11 @@ static float evaluate_fcurve_ex(const FCurve *fcu, float evaltime, float cvalue)
   return cvalue;
 }
 
-float evaluate_fcurve(const FCurve *fcu, float evaltime)
+float evaluate_fcurve(const FCurve *fcu, float evaltime, int *segment_hint)
 {
   BLI_assert(fcu->driver == nullptr);
 
-  return evaluate_fcurve_ex(fcu, evaltime, 0.0);
+  return evaluate_fcurve_ex(fcu, evaltime, 0.0, segment_hint);
 }
 
 float evaluate_fcurve_only_curve(const FCurve *fcu, float evaltime)
@@ -2505,7 +2563,8 @@ bool BKE_fcurve_is_empty(const FCurve *fcu)
 
 float calculate_fcurve(PathResolvedRNA *anim_rna,
                        FCurve *fcu,
-                       const AnimationEvalContext *anim_eval_context)
+                       const AnimationEvalContext *anim_eval_context,
+                       int *segment_hint)
 {
   /* Only calculate + set curval (overriding the existing value) if curve has
    * any data which warrants this...
@@ -2520,7 +2579,7 @@ float calculate_fcurve(PathResolvedRNA *anim_rna,
     curval = evaluate_fcurve_driver(anim_rna, fcu, fcu->driver, anim_eval_context);
   }
   else {
-    curval = evaluate_fcurve(fcu, anim_eval_context->eval_time);
+    curval = evaluate_fcurve(fcu, anim_eval_context->eval_time, segment_hint);
   }
   fcu->curval = curval; /* Debug display only, not thread safe! */
   return curval;
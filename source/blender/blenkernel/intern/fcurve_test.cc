@@ -234,6 +234,41 @@ TEST(evaluate_fcurve, ExtrapolationBezierKeys)
   BKE_fcurve_free(fcu);
 }
 
+TEST(evaluate_fcurve, SegmentHint)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  const KeyframeSettings settings = get_keyframe_settings(false);
+  for (int i = 0; i < 10; i++) {
+    insert_vert_fcurve(fcu, {float(i), float(i % 3)}, settings, INSERTKEY_NOFLAGS);
+  }
+  BKE_fcurve_handles_recalc(fcu);
+
+  /* Playing forward, backward, jumping around and evaluating on and near keys gives the same
+   * result as evaluating without a hint, whatever the hint was. */
+  const float times[] = {0.5f, 1.0f, 1.5f, 2.0f, 2.00008f, 2.5f, 2.99992f, 3.0f, 8.5f,
+                         1.25f, 9.5f, -1.0f, 4.0f, 3.0f, 2.0f, 1.99992f, 0.25f};
+  int segment_hint = 0;
+  for (const float time : times) {
+    EXPECT_EQ(evaluate_fcurve(fcu, time, &segment_hint), evaluate_fcurve(fcu, time));
+  }
+  for (const float time : times) {
+    int invalid_hint = int(fcu->totvert) + 4;
+    EXPECT_EQ(evaluate_fcurve(fcu, time, &invalid_hint), evaluate_fcurve(fcu, time));
+  }
+
+  /* The hint is updated to the segment of the evaluation time. */
+  segment_hint = 0;
+  evaluate_fcurve(fcu, 4.5f, &segment_hint);
+  EXPECT_EQ(segment_hint, 5);
+  evaluate_fcurve(fcu, 5.0f, &segment_hint);
+  EXPECT_EQ(segment_hint, 5);
+  evaluate_fcurve(fcu, 5.5f, &segment_hint);
+  EXPECT_EQ(segment_hint, 6);
+
+  BKE_fcurve_free(fcu);
+}
+
 TEST(fcurve_subdivide, BKE_fcurve_bezt_subdivide_handles)
 {
   FCurve *fcu = BKE_fcurve_create();
@@ -237,6 +237,23 @@ static GVArray adapt_mesh_domain_corner_to_point(const Mesh &mesh, const GVArray
   return GVArray::ForGArray(std::move(values));
 }
 
+/**
+ * Call \a fn with an accessor for the values of \a varray, to be captured by the function of an
+ * adapted virtual array. When the values are a span that is not owned by the virtual array (e.g.
+ * an attribute of the mesh), the span is passed directly, so that reading source values doesn't
+ * need a virtual call for every element.
+ */
+template<typename T, typename Fn>
+static void devirtualize_adapted_varray(const VArray<T> &varray, const Fn &fn)
+{
+  const CommonVArrayInfo info = varray.common_info();
+  if (info.type == CommonVArrayInfo::Type::Span && !info.may_have_ownership) {
+    fn(Span<T>(static_cast<const T *>(info.data), varray.size()));
+    return;
+  }
+  fn(varray);
+}
+
 /**
  * Each corner's value is simply a copy of the value at its vertex.
  */
@@ -247,10 +264,11 @@ static GVArray adapt_mesh_domain_point_to_corner(const Mesh &mesh, const GVArray
   GVArray new_varray;
   attribute_math::convert_to_static_type(varray.type(), [&](auto dummy) {
     using T = decltype(dummy);
-    new_varray = VArray<T>::ForFunc(
-        mesh.corners_num, [corner_verts, varray = varray.typed<T>()](const int64_t corner) {
-          return varray[corner_verts[corner]];
-        });
+    devirtualize_adapted_varray(varray.typed<T>(), [&](auto src) {
+      new_varray = VArray<T>::ForFunc(mesh.corners_num, [corner_verts, src](const int64_t corner) {
+        return src[corner_verts[corner]];
+      });
+    });
   });
   return new_varray;
 }
@@ -264,29 +282,31 @@ static GVArray adapt_mesh_domain_corner_to_face(const Mesh &mesh, const GVArray
     using T = decltype(dummy);
     if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
       if constexpr (std::is_same_v<T, bool>) {
-        new_varray = VArray<T>::ForFunc(
-            faces.size(), [faces, varray = varray.typed<bool>()](const int face_index) {
-              /* A face is selected if all of its corners were selected. */
-              for (const int loop_index : faces[face_index]) {
-                if (!varray[loop_index]) {
-                  return false;
-                }
+        devirtualize_adapted_varray(varray.typed<bool>(), [&](auto src) {
+          new_varray = VArray<T>::ForFunc(faces.size(), [faces, src](const int face_index) {
+            /* A face is selected if all of its corners were selected. */
+            for (const int loop_index : faces[face_index]) {
+              if (!src[loop_index]) {
+                return false;
               }
-              return true;
-            });
+            }
+            return true;
+          });
+        });
       }
       else {
-        new_varray = VArray<T>::ForFunc(
-            faces.size(), [faces, varray = varray.typed<T>()](const int face_index) {
-              T return_value;
-              attribute_math::DefaultMixer<T> mixer({&return_value, 1});
-              for (const int loop_index : faces[face_index]) {
-                const T value = varray[loop_index];
-                mixer.mix_in(0, value);
-              }
-              mixer.finalize();
-              return return_value;
-            });
+        devirtualize_adapted_varray(varray.typed<T>(), [&](auto src) {
+          new_varray = VArray<T>::ForFunc(faces.size(), [faces, src](const int face_index) {
+            T return_value;
+            attribute_math::DefaultMixer<T> mixer({&return_value, 1});
+            for (const int loop_index : faces[face_index]) {
+              const T value = src[loop_index];
+              mixer.mix_in(0, value);
+            }
+            mixer.finalize();
+            return return_value;
+          });
+        });
       }
     }
   });
@@ -519,30 +539,32 @@ static GVArray adapt_mesh_domain_point_to_face(const Mesh &mesh, const GVArray &
     using T = decltype(dummy);
     if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
       if constexpr (std::is_same_v<T, bool>) {
-        new_varray = VArray<T>::ForFunc(
-            mesh.faces_num,
-            [corner_verts, faces, varray = varray.typed<bool>()](const int face_index) {
-              /* A face is selected if all of its vertices were selected. */
-              for (const int vert : corner_verts.slice(faces[face_index])) {
-                if (!varray[vert]) {
-                  return false;
-                }
+        devirtualize_adapted_varray(varray.typed<bool>(), [&](auto src) {
+          new_varray = VArray<T>::ForFunc(mesh.faces_num,
+          [corner_verts, faces, src](const int face_index) {
+            /* A face is selected if all of its vertices were selected. */
+            for (const int vert : corner_verts.slice(faces[face_index])) {
+              if (!src[vert]) {
+                return false;
               }
-              return true;
-            });
+            }
+            return true;
+          });
+        });
       }
       else {
-        new_varray = VArray<T>::ForFunc(
-            mesh.faces_num,
-            [corner_verts, faces, varray = varray.typed<T>()](const int face_index) {
-              T return_value;
-              attribute_math::DefaultMixer<T> mixer({&return_value, 1});
-              for (const int vert : corner_verts.slice(faces[face_index])) {
-                mixer.mix_in(0, varray[vert]);
-              }
-              mixer.finalize();
-              return return_value;
-            });
+        devirtualize_adapted_varray(varray.typed<T>(), [&](auto src) {
+          new_varray = VArray<T>::ForFunc(mesh.faces_num,
+          [corner_verts, faces, src](const int face_index) {
+            T return_value;
+            attribute_math::DefaultMixer<T> mixer({&return_value, 1});
+            for (const int vert : corner_verts.slice(faces[face_index])) {
+              mixer.mix_in(0, src[vert]);
+            }
+            mixer.finalize();
+            return return_value;
+          });
+        });
       }
     }
   });
@@ -559,23 +581,25 @@ static GVArray adapt_mesh_domain_point_to_edge(const Mesh &mesh, const GVArray &
     if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
       if constexpr (std::is_same_v<T, bool>) {
         /* An edge is selected if both of its vertices were selected. */
-        new_varray = VArray<bool>::ForFunc(
-            edges.size(), [edges, varray = varray.typed<bool>()](const int edge_index) {
-              const int2 &edge = edges[edge_index];
-              return varray[edge[0]] && varray[edge[1]];
-            });
+        devirtualize_adapted_varray(varray.typed<bool>(), [&](auto src) {
+          new_varray = VArray<bool>::ForFunc(edges.size(), [edges, src](const int edge_index) {
+            const int2 &edge = edges[edge_index];
+            return src[edge[0]] && src[edge[1]];
+          });
+        });
       }
       else {
-        new_varray = VArray<T>::ForFunc(
-            edges.size(), [edges, varray = varray.typed<T>()](const int edge_index) {
-              T return_value;
-              attribute_math::DefaultMixer<T> mixer({&return_value, 1});
-              const int2 &edge = edges[edge_index];
-              mixer.mix_in(0, varray[edge[0]]);
-              mixer.mix_in(0, varray[edge[1]]);
-              mixer.finalize();
-              return return_value;
-            });
+        devirtualize_adapted_varray(varray.typed<T>(), [&](auto src) {
+          new_varray = VArray<T>::ForFunc(edges.size(), [edges, src](const int edge_index) {
+            T return_value;
+            attribute_math::DefaultMixer<T> mixer({&return_value, 1});
+            const int2 &edge = edges[edge_index];
+            mixer.mix_in(0, src[edge[0]]);
+            mixer.mix_in(0, src[edge[1]]);
+            mixer.finalize();
+            return return_value;
+          });
+        });
       }
     }
   });
@@ -716,27 +740,31 @@ static GVArray adapt_mesh_domain_edge_to_face(const Mesh &mesh, const GVArray &v
     if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
       if constexpr (std::is_same_v<T, bool>) {
         /* A face is selected if all of its edges are selected. */
-        new_varray = VArray<bool>::ForFunc(
-            faces.size(), [corner_edges, faces, varray = varray.typed<T>()](const int face_index) {
-              for (const int edge : corner_edges.slice(faces[face_index])) {
-                if (!varray[edge]) {
-                  return false;
+        devirtualize_adapted_varray(varray.typed<T>(), [&](auto src) {
+          new_varray = VArray<bool>::ForFunc(
+              faces.size(), [corner_edges, faces, src](const int face_index) {
+                for (const int edge : corner_edges.slice(faces[face_index])) {
+                  if (!src[edge]) {
+                    return false;
+                  }
                 }
-              }
-              return true;
-            });
+                return true;
+              });
+        });
       }
       else {
-        new_varray = VArray<T>::ForFunc(
-            faces.size(), [corner_edges, faces, varray = varray.typed<T>()](const int face_index) {
-              T return_value;
-              attribute_math::DefaultMixer<T> mixer({&return_value, 1});
-              for (const int edge : corner_edges.slice(faces[face_index])) {
-                mixer.mix_in(0, varray[edge]);
-              }
-              mixer.finalize();
-              return return_value;
-            });
+        devirtualize_adapted_varray(varray.typed<T>(), [&](auto src) {
+          new_varray = VArray<T>::ForFunc(
+              faces.size(), [corner_edges, faces, src](const int face_index) {
+                T return_value;
+                attribute_math::DefaultMixer<T> mixer({&return_value, 1});
+                for (const int edge : corner_edges.slice(faces[face_index])) {
+                  mixer.mix_in(0, src[edge]);
+                }
+                mixer.finalize();
+                return return_value;
+              });
+        });
       }
     }
   });
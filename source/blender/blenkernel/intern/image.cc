@@ -532,7 +532,8 @@ static void imagecache_keydata(void *userkey, int *framenr, int *proxy, int *ren
   *render_flags = 0;
 }
 
-static void imagecache_put(Image *image, int index, ImBuf *ibuf)
+/** \param cost: Time in seconds it took to load \a ibuf, see #IMB_moviecache_put_ex. */
+static void imagecache_put(Image *image, int index, ImBuf *ibuf, const float cost = 0.0f)
 {
   ImageCacheKey key;
 
@@ -547,7 +548,7 @@ static void imagecache_put(Image *image, int index, ImBuf *ibuf)
 
   key.index = index;
 
-  IMB_moviecache_put(image->cache, &key, ibuf);
+  IMB_moviecache_put_ex(image->cache, &key, ibuf, cost);
 }
 
 static void imagecache_remove(Image *image, int index)
@@ -722,13 +723,14 @@ static ImBuf *image_get_cached_ibuf_for_index_entry(Image *ima,
   return imagecache_get(ima, index, r_is_cached_empty);
 }
 
-static void image_assign_ibuf(Image *ima, ImBuf *ibuf, int index, int entry)
+static void image_assign_ibuf(
+    Image *ima, ImBuf *ibuf, int index, int entry, const float cost = 0.0f)
 {
   if (index != IMA_NO_INDEX) {
     index = IMA_MAKE_INDEX(entry, index);
   }
 
-  imagecache_put(ima, index, ibuf);
+  imagecache_put(ima, index, ibuf, cost);
 }
 
 static void image_remove_ibuf(Image *ima, int index, int entry)
@@ -4149,8 +4151,9 @@ static ImBuf *image_load_movie_file(Image *ima, ImageUser *iuser, int frame)
   }
 
   if (!is_multiview) {
+    const double start_time = BLI_time_now_seconds();
     ibuf = load_movie_single(ima, iuser, frame, 0);
-    image_assign_ibuf(ima, ibuf, 0, frame);
+    image_assign_ibuf(ima, ibuf, 0, frame, float(BLI_time_now_seconds() - start_time));
   }
   else {
     const int totviews = BLI_listbase_count(&ima->views);
@@ -4309,10 +4312,11 @@ static ImBuf *image_load_image_file(
 
   if (!is_multiview) {
     bool put_in_cache;
+    const double start_time = BLI_time_now_seconds();
     ibuf = load_image_single(ima, iuser, cfra, 0, has_packed, is_sequence, &put_in_cache);
     if (put_in_cache) {
       const int index = (is_sequence || is_tiled) ? 0 : IMA_NO_INDEX;
-      image_assign_ibuf(ima, ibuf, index, entry);
+      image_assign_ibuf(ima, ibuf, index, entry, float(BLI_time_now_seconds() - start_time));
     }
   }
   else {
@@ -6,6 +6,8 @@
  * \ingroup bke
  */
 
+#include <algorithm>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_boxpack_2d.h"
@@ -13,6 +15,7 @@
 #include "BLI_listbase.h"
 #include "BLI_threads.h"
 #include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #include "DNA_image_types.h"
 #include "DNA_userdef_types.h"
@@ -580,11 +583,83 @@ void BKE_image_free_anim_gputextures(Main *bmain)
   }
 }
 
+/**
+ * Part of the GPU memory image textures can use before the least recently used ones are freed.
+ * The remaining memory is left for the draw engines and for other applications.
+ */
+#define IMAGE_GPU_MEMORY_BUDGET_FACTOR 0.5
+
+static size_t image_gpu_memory_size(const Image *ima)
+{
+  size_t size = 0;
+  for (int eye = 0; eye < 2; eye++) {
+    for (int i = 0; i < TEXTARGET_COUNT; i++) {
+      if (ima->gputexture[i][eye] != nullptr) {
+        size += GPU_texture_memory_size(ima->gputexture[i][eye]);
+      }
+    }
+  }
+  return size;
+}
+
+/**
+ * Free the GPU textures of the least recently used images when all image textures together use
+ * more than the budget, instead of waiting for the time-out. Images used since the last second
+ * are kept, they are likely to be needed for the next redraw.
+ */
+static void image_free_gputextures_over_budget(Main *bmain, const int ctime)
+{
+  if (!GPU_mem_stats_supported()) {
+    return;
+  }
+  int totalmem_kb = 0, freemem_kb = 0;
+  GPU_mem_stats_get(&totalmem_kb, &freemem_kb);
+  if (totalmem_kb <= 0) {
+    return;
+  }
+  const size_t budget = size_t(double(totalmem_kb) * 1024.0 * IMAGE_GPU_MEMORY_BUDGET_FACTOR);
+
+  struct ImageMemory {
+    Image *ima;
+    size_t size;
+  };
+  blender::Vector<ImageMemory> candidates;
+  size_t used = 0;
+  LISTBASE_FOREACH (Image *, ima, &bmain->images) {
+    const size_t size = image_gpu_memory_size(ima);
+    used += size;
+    if (size > 0 && (ima->flag & IMA_NOCOLLECT) == 0 && ima->lastused < ctime) {
+      candidates.append({ima, size});
+    }
+  }
+  if (used <= budget) {
+    return;
+  }
+
+  std::sort(candidates.begin(), candidates.end(), [](const ImageMemory &a, const ImageMemory &b) {
+    return a.ima->lastused < b.ima->lastused;
+  });
+  for (const ImageMemory &candidate : candidates) {
+    BKE_image_free_gputextures(candidate.ima);
+    used -= candidate.size;
+    if (used <= budget) {
+      break;
+    }
+  }
+}
+
 void BKE_image_free_old_gputextures(Main *bmain)
 {
   static int lasttime = 0;
+  static int lasttime_budget = 0;
   int ctime = int(BLI_time_now_seconds());
 
+  /* The budget is checked once per second, independently of the collector settings. */
+  if (!G.is_rendering && ctime != lasttime_budget) {
+    lasttime_budget = ctime;
+    image_free_gputextures_over_budget(bmain, ctime);
+  }
+
   /*
    * Run garbage collector once for every collecting period of time
    * if textimeout is 0, that's the option to NOT run the collector
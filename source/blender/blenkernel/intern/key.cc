@@ -1955,6 +1955,45 @@ void BKE_keyblock_copy_settings(KeyBlock *kb_dst, const KeyBlock *kb_src)
   kb_dst->slidermax = kb_src->slidermax;
 }
 
+bool BKE_key_copy_settings_for_eval(Key *key_dst, const Key *key_src)
+{
+  if (key_dst->totkey != key_src->totkey || key_dst->elemsize != key_src->elemsize) {
+    return false;
+  }
+  const KeyBlock *kb_src;
+  KeyBlock *kb_dst;
+  for (kb_src = static_cast<const KeyBlock *>(key_src->block.first),
+      kb_dst = static_cast<KeyBlock *>(key_dst->block.first);
+       kb_src && kb_dst;
+       kb_src = kb_src->next, kb_dst = kb_dst->next)
+  {
+    if (kb_dst->totelem != kb_src->totelem || kb_dst->uid != kb_src->uid) {
+      return false;
+    }
+  }
+  if (kb_src || kb_dst) {
+    return false;
+  }
+
+  for (kb_src = static_cast<const KeyBlock *>(key_src->block.first),
+      kb_dst = static_cast<KeyBlock *>(key_dst->block.first);
+       kb_dst;
+       kb_src = kb_src->next, kb_dst = kb_dst->next)
+  {
+    BKE_keyblock_copy_settings(kb_dst, kb_src);
+    kb_dst->flag = kb_src->flag;
+    STRNCPY(kb_dst->name, kb_src->name);
+    if (kb_src == key_src->refkey) {
+      key_dst->refkey = kb_dst;
+    }
+  }
+  key_dst->type = key_src->type;
+  key_dst->flag = key_src->flag;
+  key_dst->ctime = key_src->ctime;
+  key_dst->uidgen = key_src->uidgen;
+  return true;
+}
+
 std::optional<std::string> BKE_keyblock_curval_rnapath_get(const Key *key, const KeyBlock *kb)
 {
   if (ELEM(nullptr, key, kb)) {
@@ -2167,17 +2167,23 @@ void BKE_library_make_local(Main *bmain,
    * ID in a separated loop,
    * as lbarray ordering is not enough to ensure us we did catch all dependencies
    * (e.g. if making local a parent object before its child...). See #48907. */
-  /* TODO: This is now the biggest step by far (in term of processing time).
-   * We may be able to gain here by using again main->relations mapping, but...
-   * this implies BKE_libblock_remap & co to be able to update main->relations on the fly.
-   * Have to think about it a bit more, and see whether new code is OK first, anyway. */
+  /* NOTE: This is the biggest step by far (in term of processing time), so all IDs are remapped
+   * at once, this only iterates over the whole Main database and does the post-process updates
+   * of remapping once, instead of once for each copied ID. */
+  IDRemapper remapper;
   for (LinkNode *it = copied_ids; it; it = it->next) {
     ID *id = static_cast<ID *>(it->link);
 
     BLI_assert(id->newid != nullptr);
     BLI_assert(ID_IS_LINKED(id));
 
-    BKE_libblock_remap(bmain, id, id->newid, ID_REMAP_SKIP_INDIRECT_USAGE);
+    remapper.add(id, id->newid);
+  }
+  BKE_libblock_remap_multiple(bmain, remapper, ID_REMAP_SKIP_INDIRECT_USAGE);
+
+  for (LinkNode *it = copied_ids; it; it = it->next) {
+    ID *id = static_cast<ID *>(it->link);
+
     if (old_to_new_ids) {
       BLI_ghash_insert(old_to_new_ids, id, id->newid);
     }
@@ -12,7 +12,9 @@
 
 #include "BLI_array.hh"
 #include "BLI_linklist.h"
+#include "BLI_set.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "DNA_collection_types.h"
 #include "DNA_object_types.h"
@@ -423,12 +425,6 @@ static void libblock_remap_data_postprocess_obdata_relink(Main *bmain, Object *o
   }
 }
 
-static void libblock_remap_data_postprocess_nodetree_update(Main *bmain, ID *new_id)
-{
-  /* Update all group nodes using a node group. */
-  blender::bke::node_tree_update_all_users(bmain, new_id);
-}
-
 static void libblock_remap_data_update_tags(ID *old_id, ID *new_id, IDRemap *id_remap_data)
 {
   const int remap_flags = id_remap_data->flag;
@@ -453,6 +449,112 @@ static void libblock_remap_data_update_tags(ID *old_id, ID *new_id, IDRemap *id_
   }
 }
 
+/**
+ * Post-process updates that have to check the whole Main database. When remapping several IDs at
+ * once, they are gathered for all ID pairs and done once, instead of once for each pair.
+ */
+struct IDRemapPostprocess {
+  /** Objects that were remapped, meta-balls using them as basis have to be updated. */
+  blender::Vector<Object *> old_objects;
+  bool do_object_update = false;
+  /** Collections were unlinked, nullptr children have to be removed. */
+  bool do_collection_remove_nulls = false;
+  /** Collections were remapped to other collections, parent relations have to be rebuilt. */
+  bool do_collection_relations_rebuild = false;
+  /** New obdata IDs, objects using them have to be updated. */
+  blender::Set<ID *> relinked_obdata;
+  /** New IDs, node trees using them have to be updated. */
+  blender::Vector<ID *> new_ids;
+};
+
+static void libblock_remap_postprocess_gather(ID *old_id, ID *new_id, IDRemapPostprocess &data)
+{
+  /* Some after-process updates.
+   * This is a bit ugly, but cannot see a way to avoid it.
+   * Maybe we should do a per-ID callback for this instead? */
+  switch (GS(old_id->name)) {
+    case ID_OB:
+      data.old_objects.append((Object *)old_id);
+      data.do_object_update = true;
+      break;
+    case ID_GR:
+      if (new_id == nullptr) {
+        data.do_collection_remove_nulls = true;
+      }
+      else {
+        data.do_collection_relations_rebuild = true;
+      }
+      break;
+    case ID_ME:
+    case ID_CU_LEGACY:
+    case ID_MB:
+    case ID_CV:
+    case ID_PT:
+    case ID_VO:
+      if (new_id) { /* Only affects us in case obdata was relinked (changed). */
+        data.relinked_obdata.add(new_id);
+      }
+      break;
+    default:
+      break;
+  }
+
+  if (new_id != nullptr) {
+    data.new_ids.append(new_id);
+  }
+}
+
+static void libblock_remap_postprocess_apply(Main *bmain, const IDRemapPostprocess &data)
+{
+  bool do_sync_collection = false;
+  if (data.do_object_update) {
+    /* Will only effectively process collections that have been tagged with
+     * #COLLECTION_TAG_COLLECTION_OBJECT_DIRTY. See #collection_foreach_id callback. */
+    BKE_collections_object_remove_invalids(bmain);
+    do_sync_collection = true;
+  }
+  if (data.do_collection_remove_nulls) {
+    /* See #libblock_remap_data_postprocess_collection_update. */
+    BKE_collections_child_remove_nulls(bmain, nullptr, nullptr);
+    do_sync_collection = true;
+  }
+  if (data.do_collection_relations_rebuild) {
+    BKE_main_collections_parent_relations_rebuild(bmain);
+    do_sync_collection = true;
+  }
+  if (do_sync_collection) {
+    BKE_main_collection_sync_remap(bmain);
+  }
+
+  if (!data.old_objects.is_empty() || !data.relinked_obdata.is_empty()) {
+    for (Object *ob = static_cast<Object *>(bmain->objects.first); ob != nullptr;
+         ob = static_cast<Object *>(ob->id.next))
+    {
+      if (ob->type == OB_MBALL) {
+        for (Object *old_ob : data.old_objects) {
+          if (BKE_mball_is_basis_for(ob, old_ob)) {
+            DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
+            break;
+          }
+        }
+      }
+      if (ob->data != nullptr && data.relinked_obdata.contains(static_cast<ID *>(ob->data))) {
+        libblock_remap_data_postprocess_obdata_relink(bmain, ob, static_cast<ID *>(ob->data));
+      }
+    }
+  }
+
+  /* Node trees may virtually use any kind of data-block, update all group nodes using them. */
+  /* XXX Yuck!!!! nodetree update can do pretty much any thing when talking about py nodes,
+   *     including creating new data-blocks (see #50385), so we need to unlock main here. :(
+   *     Why can't we have re-entrent locks? */
+  if (!data.new_ids.is_empty()) {
+    BKE_main_unlock(bmain);
+    blender::bke::node_tree_update_all_users(bmain, data.new_ids);
+    BKE_main_lock(bmain);
+  }
+}
+
 static void libblock_remap_reset_remapping_status_fn(ID *old_id, ID *new_id)
 {
   BKE_libblock_runtime_reset_remapping_status(old_id);
@@ -552,7 +654,8 @@ static void libblock_remap_data(
   });
 }
 
-static void libblock_remap_foreach_idpair(ID *old_id, ID *new_id, Main *bmain, int remap_flags)
+static void libblock_remap_foreach_idpair(
+    ID *old_id, ID *new_id, const int remap_flags, IDRemapPostprocess &data)
 {
   if (old_id == new_id) {
     return;
@@ -598,46 +701,7 @@ static void libblock_remap_foreach_idpair(ID *old_id, ID *new_id, Main *bmain, i
     }
   }
 
-  /* Some after-process updates.
-   * This is a bit ugly, but cannot see a way to avoid it.
-   * Maybe we should do a per-ID callback for this instead? */
-  switch (GS(old_id->name)) {
-    case ID_OB:
-      libblock_remap_data_postprocess_object_update(
-          bmain, (Object *)old_id, (Object *)new_id, true);
-      break;
-    case ID_GR:
-      libblock_remap_data_postprocess_collection_update(
-          bmain, nullptr, (Collection *)old_id, (Collection *)new_id);
-      break;
-    case ID_ME:
-    case ID_CU_LEGACY:
-    case ID_MB:
-    case ID_CV:
-    case ID_PT:
-    case ID_VO:
-      if (new_id) { /* Only affects us in case obdata was relinked (changed). */
-        for (Object *ob = static_cast<Object *>(bmain->objects.first); ob;
-             ob = static_cast<Object *>(ob->id.next))
-        {
-          libblock_remap_data_postprocess_obdata_relink(bmain, ob, new_id);
-        }
-      }
-      break;
-    default:
-      break;
-  }
-
-  /* Node trees may virtually use any kind of data-block... */
-  /* XXX Yuck!!!! nodetree update can do pretty much any thing when talking about py nodes,
-   *     including creating new data-blocks (see #50385), so we need to unlock main here. :(
-   *     Why can't we have re-entrent locks? */
-  BKE_main_unlock(bmain);
-  libblock_remap_data_postprocess_nodetree_update(bmain, new_id);
-  BKE_main_lock(bmain);
-
-  /* Full rebuild of DEG! */
-  DEG_relations_tag_update(bmain);
+  libblock_remap_postprocess_gather(old_id, new_id, data);
 
   BKE_libblock_runtime_reset_remapping_status(old_id);
 }
@@ -651,9 +715,11 @@ void BKE_libblock_remap_multiple_locked(Main *bmain, IDRemapper &mappings, const
 
   libblock_remap_data(bmain, nullptr, ID_REMAP_TYPE_REMAP, mappings, remap_flags);
 
+  IDRemapPostprocess postprocess_data;
   mappings.iter([&](ID *old_id, ID *new_id) {
-    libblock_remap_foreach_idpair(old_id, new_id, bmain, remap_flags);
+    libblock_remap_foreach_idpair(old_id, new_id, remap_flags, postprocess_data);
   });
+  libblock_remap_postprocess_apply(bmain, postprocess_data);
 
   /* We assume editors do not hold references to their IDs... This is false in some cases
    * (Image is especially tricky here),
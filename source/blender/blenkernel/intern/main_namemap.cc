@@ -159,11 +159,11 @@ struct UniqueName_Value {
 
 /* Tracking of names for a single ID type. */
 struct UniqueName_TypeMap {
-  /* Set of full names that are in use. */
-  Set<UniqueName_Key> full_names;
+  /* Set of full names that are in use. Group probing avoids most of the name comparisons. */
+  Set<UniqueName_Key, 0, GroupProbingStrategy> full_names;
   /* For each base name (i.e. without numeric suffix), track the
    * numeric suffixes that are in use. */
-  Map<UniqueName_Key, UniqueName_Value> base_name_to_num_suffix;
+  Map<UniqueName_Key, UniqueName_Value, 0, GroupProbingStrategy> base_name_to_num_suffix;
 };
 
 struct UniqueName_Map {
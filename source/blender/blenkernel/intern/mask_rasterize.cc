@@ -1329,108 +1329,202 @@ static float layer_bucket_depth_from_xy(MaskRasterLayer *layer, const float xy[2
   return 1.0f;
 }
 
-float BKE_maskrasterize_handle_sample(MaskRasterHandle *mr_handle, const float xy[2])
-{
-  /* can't do this because some layers may invert */
-  /* if (BLI_rctf_isect_pt_v(&mr_handle->bounds, xy)) */
-
-  const uint layers_tot = mr_handle->layers_tot;
-  MaskRasterLayer *layer = mr_handle->layers;
-
-  /* return value */
-  float value = 0.0f;
-
-  for (uint i = 0; i < layers_tot; i++, layer++) {
-    float value_layer;
-
-    /* also used as signal for unused layer (when render is disabled) */
-    if (layer->alpha != 0.0f && BLI_rctf_isect_pt_v(&layer->bounds, xy)) {
-      value_layer = 1.0f - layer_bucket_depth_from_xy(layer, xy);
-
-      switch (layer->falloff) {
-        case PROP_SMOOTH:
-          /* ease - gives less hard lines for dilate/erode feather */
-          value_layer = (3.0f * value_layer * value_layer -
-                         2.0f * value_layer * value_layer * value_layer);
-          break;
-        case PROP_SPHERE:
-          value_layer = sqrtf(2.0f * value_layer - value_layer * value_layer);
-          break;
-        case PROP_ROOT:
-          value_layer = sqrtf(value_layer);
-          break;
-        case PROP_SHARP:
-          value_layer = value_layer * value_layer;
-          break;
-        case PROP_INVSQUARE:
-          value_layer = value_layer * (2.0f - value_layer);
-          break;
-        case PROP_LIN:
-        default:
-          /* nothing */
-          break;
-      }
+/**
+ * Number of samples of a row evaluated at once, small enough for the values of a layer and the
+ * accumulated values to stay on the stack.
+ */
+#define SAMPLE_CHUNK_SIZE 64
 
-      if (layer->blend != MASK_BLEND_REPLACE) {
-        value_layer *= layer->alpha;
-      }
-    }
-    else {
-      value_layer = 0.0f;
+/**
+ * Compute the values of a single layer, before it is blended with the other layers.
+ */
+static void maskrasterize_layer_sample_chunk(MaskRasterLayer *layer,
+                                             const float *xs,
+                                             const uint xs_num,
+                                             const float y,
+                                             float *r_values)
+{
+  /* also used as signal for unused layer (when render is disabled) */
+  if (layer->alpha == 0.0f || y < layer->bounds.ymin || y > layer->bounds.ymax) {
+    /* The whole row is outside of the layer, skip all bucket lookups. */
+    for (uint i = 0; i < xs_num; i++) {
+      r_values[i] = 0.0f;
     }
-
-    if (layer->blend_flag & MASK_BLENDFLAG_INVERT) {
-      value_layer = 1.0f - value_layer;
+  }
+  else {
+    for (uint i = 0; i < xs_num; i++) {
+      const float xy[2] = {xs[i], y};
+      r_values[i] = BLI_rctf_isect_pt_v(&layer->bounds, xy) ?
+                        1.0f - layer_bucket_depth_from_xy(layer, xy) :
+                        0.0f;
     }
 
-    switch (layer->blend) {
-      case MASK_BLEND_MERGE_ADD:
-        value += value_layer * (1.0f - value);
-        break;
-      case MASK_BLEND_MERGE_SUBTRACT:
-        value -= value_layer * value;
-        break;
-      case MASK_BLEND_ADD:
-        value += value_layer;
-        break;
-      case MASK_BLEND_SUBTRACT:
-        value -= value_layer;
-        break;
-      case MASK_BLEND_LIGHTEN:
-        value = max_ff(value, value_layer);
+    /* Zero values (outside of the layer) stay zero with all falloff types and the alpha, so the
+     * loops below don't need to check the bounds again. Keeping the switches outside of the loops
+     * lets them be vectorized. */
+    switch (layer->falloff) {
+      case PROP_SMOOTH:
+        /* ease - gives less hard lines for dilate/erode feather */
+        for (uint i = 0; i < xs_num; i++) {
+          const float v = r_values[i];
+          r_values[i] = (3.0f * v * v - 2.0f * v * v * v);
+        }
         break;
-      case MASK_BLEND_DARKEN:
-        value = min_ff(value, value_layer);
+      case PROP_SPHERE:
+        for (uint i = 0; i < xs_num; i++) {
+          const float v = r_values[i];
+          r_values[i] = sqrtf(2.0f * v - v * v);
+        }
         break;
-      case MASK_BLEND_MUL:
-        value *= value_layer;
+      case PROP_ROOT:
+        for (uint i = 0; i < xs_num; i++) {
+          r_values[i] = sqrtf(r_values[i]);
+        }
         break;
-      case MASK_BLEND_REPLACE:
-        value = (value * (1.0f - layer->alpha)) + (value_layer * layer->alpha);
+      case PROP_SHARP:
+        for (uint i = 0; i < xs_num; i++) {
+          r_values[i] = r_values[i] * r_values[i];
+        }
         break;
-      case MASK_BLEND_DIFFERENCE:
-        value = fabsf(value - value_layer);
+      case PROP_INVSQUARE:
+        for (uint i = 0; i < xs_num; i++) {
+          r_values[i] = r_values[i] * (2.0f - r_values[i]);
+        }
         break;
-      default: /* same as add */
-        CLOG_ERROR(&LOG, "unhandled blend type: %d", layer->blend);
-        BLI_assert(0);
-        value += value_layer;
+      case PROP_LIN:
+      default:
+        /* nothing */
         break;
     }
 
-    /* clamp after applying each layer so we don't get
-     * issues subtracting after accumulating over 1.0f */
-    CLAMP(value, 0.0f, 1.0f);
+    if (layer->blend != MASK_BLEND_REPLACE) {
+      for (uint i = 0; i < xs_num; i++) {
+        r_values[i] *= layer->alpha;
+      }
+    }
   }
 
+  if (layer->blend_flag & MASK_BLENDFLAG_INVERT) {
+    for (uint i = 0; i < xs_num; i++) {
+      r_values[i] = 1.0f - r_values[i];
+    }
+  }
+}
+
+/**
+ * Blend the values of a layer into the accumulated values of the previous layers.
+ */
+static void maskrasterize_layer_blend_chunk(const MaskRasterLayer *layer,
+                                            const float *layer_values,
+                                            const uint xs_num,
+                                            float *values)
+{
+  switch (layer->blend) {
+    case MASK_BLEND_MERGE_ADD:
+      for (uint i = 0; i < xs_num; i++) {
+        values[i] += layer_values[i] * (1.0f - values[i]);
+      }
+      break;
+    case MASK_BLEND_MERGE_SUBTRACT:
+      for (uint i = 0; i < xs_num; i++) {
+        values[i] -= layer_values[i] * values[i];
+      }
+      break;
+    case MASK_BLEND_ADD:
+      for (uint i = 0; i < xs_num; i++) {
+        values[i] += layer_values[i];
+      }
+      break;
+    case MASK_BLEND_SUBTRACT:
+      for (uint i = 0; i < xs_num; i++) {
+        values[i] -= layer_values[i];
+      }
+      break;
+    case MASK_BLEND_LIGHTEN:
+      for (uint i = 0; i < xs_num; i++) {
+        values[i] = max_ff(values[i], layer_values[i]);
+      }
+      break;
+    case MASK_BLEND_DARKEN:
+      for (uint i = 0; i < xs_num; i++) {
+        values[i] = min_ff(values[i], layer_values[i]);
+      }
+      break;
+    case MASK_BLEND_MUL:
+      for (uint i = 0; i < xs_num; i++) {
+        values[i] *= layer_values[i];
+      }
+      break;
+    case MASK_BLEND_REPLACE:
+      for (uint i = 0; i < xs_num; i++) {
+        values[i] = (values[i] * (1.0f - layer->alpha)) + (layer_values[i] * layer->alpha);
+      }
+      break;
+    case MASK_BLEND_DIFFERENCE:
+      for (uint i = 0; i < xs_num; i++) {
+        values[i] = fabsf(values[i] - layer_values[i]);
+      }
+      break;
+    default: /* same as add */
+      CLOG_ERROR(&LOG, "unhandled blend type: %d", layer->blend);
+      BLI_assert(0);
+      for (uint i = 0; i < xs_num; i++) {
+        values[i] += layer_values[i];
+      }
+      break;
+  }
+
+  /* clamp after applying each layer so we don't get
+   * issues subtracting after accumulating over 1.0f */
+  for (uint i = 0; i < xs_num; i++) {
+    CLAMP(values[i], 0.0f, 1.0f);
+  }
+}
+
+void BKE_maskrasterize_handle_sample_row(MaskRasterHandle *mr_handle,
+                                         const float *xs,
+                                         const uint xs_num,
+                                         const float y,
+                                         float *r_values)
+{
+  /* can't skip the row when it is outside of the handle bounds because some layers may invert */
+
+  const uint layers_tot = mr_handle->layers_tot;
+
+  for (uint chunk_start = 0; chunk_start < xs_num; chunk_start += SAMPLE_CHUNK_SIZE) {
+    const uint chunk_num = std::min<uint>(xs_num - chunk_start, SAMPLE_CHUNK_SIZE);
+    const float *chunk_xs = xs + chunk_start;
+    float *values = r_values + chunk_start;
+    float layer_values[SAMPLE_CHUNK_SIZE];
+
+    for (uint i = 0; i < chunk_num; i++) {
+      values[i] = 0.0f;
+    }
+
+    /* Evaluate the layers one after another for all samples of the chunk, so the data of a layer
+     * stays in cache and the blending is done for many samples at once. */
+    MaskRasterLayer *layer = mr_handle->layers;
+    for (uint i = 0; i < layers_tot; i++, layer++) {
+      maskrasterize_layer_sample_chunk(layer, chunk_xs, chunk_num, y, layer_values);
+      maskrasterize_layer_blend_chunk(layer, layer_values, chunk_num, values);
+    }
+  }
+}
+
+float BKE_maskrasterize_handle_sample(MaskRasterHandle *mr_handle, const float xy[2])
+{
+  float value;
+  BKE_maskrasterize_handle_sample_row(mr_handle, &xy[0], 1, xy[1], &value);
   return value;
 }
 
 struct MaskRasterizeBufferData {
   MaskRasterHandle *mr_handle;
-  float x_inv, y_inv;
-  float x_px_ofs, y_px_ofs;
+  float y_inv;
+  float y_px_ofs;
   uint width;
+  /** Sample coordinates of the columns, the same for all rows. */
+  const float *xs;
 
   float *buffer;
 };
@@ -1441,21 +1535,10 @@ static void maskrasterize_buffer_cb(void *__restrict userdata,
 {
   MaskRasterizeBufferData *data = static_cast<MaskRasterizeBufferData *>(userdata);
 
-  MaskRasterHandle *mr_handle = data->mr_handle;
-  float *buffer = data->buffer;
-
   const uint width = data->width;
-  const float x_inv = data->x_inv;
-  const float x_px_ofs = data->x_px_ofs;
-
-  uint i = uint(y) * width;
-  float xy[2];
-  xy[1] = (float(y) * data->y_inv) + data->y_px_ofs;
-  for (uint x = 0; x < width; x++, i++) {
-    xy[0] = (float(x) * x_inv) + x_px_ofs;
-
-    buffer[i] = BKE_maskrasterize_handle_sample(mr_handle, xy);
-  }
+  const float xy_y = (float(y) * data->y_inv) + data->y_px_ofs;
+  BKE_maskrasterize_handle_sample_row(
+      data->mr_handle, data->xs, width, xy_y, data->buffer + size_t(y) * width);
 }
 
 void BKE_maskrasterize_buffer(MaskRasterHandle *mr_handle,
@@ -1467,17 +1550,25 @@ void BKE_maskrasterize_buffer(MaskRasterHandle *mr_handle,
 {
   const float x_inv = 1.0f / float(width);
   const float y_inv = 1.0f / float(height);
+  const float x_px_ofs = x_inv * 0.5f;
 
   MaskRasterizeBufferData data{};
   data.mr_handle = mr_handle;
-  data.x_inv = x_inv;
   data.y_inv = y_inv;
-  data.x_px_ofs = x_inv * 0.5f;
   data.y_px_ofs = y_inv * 0.5f;
   data.width = width;
   data.buffer = buffer;
+
+  float *xs = static_cast<float *>(MEM_mallocN(sizeof(float) * width, __func__));
+  for (uint x = 0; x < width; x++) {
+    xs[x] = (float(x) * x_inv) + x_px_ofs;
+  }
+  data.xs = xs;
+
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
   settings.use_threading = (size_t(height) * width > 10000);
   BLI_task_parallel_range(0, int(height), &data, maskrasterize_buffer_cb, &settings);
+
+  MEM_freeN(xs);
 }
@@ -49,6 +49,7 @@
 #include "BKE_attribute.hh"
 #include "BKE_bake_data_block_id.hh"
 #include "BKE_bpath.hh"
+#include "BKE_bvhutils.hh"
 #include "BKE_deform.hh"
 #include "BKE_editmesh.hh"
 #include "BKE_editmesh_cache.hh"
@@ -153,6 +154,7 @@ static void mesh_copy_data(Main *bmain,
   mesh_dst->runtime->vert_to_face_map_cache = mesh_src->runtime->vert_to_face_map_cache;
   mesh_dst->runtime->vert_to_corner_map_cache = mesh_src->runtime->vert_to_corner_map_cache;
   mesh_dst->runtime->corner_to_face_map_cache = mesh_src->runtime->corner_to_face_map_cache;
+  mesh_dst->runtime->bvh_cache = bvhcache_add_user(mesh_src->runtime->bvh_cache);
   if (mesh_src->runtime->bake_materials) {
     mesh_dst->runtime->bake_materials = std::make_unique<blender::bke::bake::BakeMaterialsList>(
         *mesh_src->runtime->bake_materials);
@@ -367,7 +369,14 @@ static void mesh_blend_read_data(BlendDataReader *reader, ID *id)
 
   if (mesh->face_offset_indices) {
     mesh->runtime->face_offsets_sharing_info = BLO_read_shared(
-        reader, &mesh->face_offset_indices, [&]() {
+        reader, &mesh->face_offset_indices, [&]() -> const blender::ImplicitSharingInfo * {
+          if (const blender::ImplicitSharingInfo *sharing_info = BLO_read_mapped_data(
+                  reader,
+                  reinterpret_cast<void **>(&mesh->face_offset_indices),
+                  sizeof(int) * size_t(mesh->faces_num + 1)))
+          {
+            return sharing_info;
+          }
           BLO_read_int32_array(reader, mesh->faces_num + 1, &mesh->face_offset_indices);
           return blender::implicit_sharing::info_for_mem_free(mesh->face_offset_indices);
         });
@@ -30,7 +30,7 @@ static uint64_t edge_hash_2(const OrderedEdge &edge)
 }
 
 using EdgeMap = VectorSet<OrderedEdge,
-                          DefaultProbingStrategy,
+                          GroupProbingStrategy,
                           DefaultHash<OrderedEdge>,
                           DefaultEquality<OrderedEdge>,
                           SimpleVectorSetSlot<OrderedEdge, int>,
@@ -89,18 +89,21 @@ static void add_face_edges_to_hash_maps(const Mesh &mesh,
   });
 }
 
-static void serialize_and_initialize_deduplicated_edges(MutableSpan<EdgeMap> edge_maps,
-                                                        const OffsetIndices<int> edge_offsets,
-                                                        MutableSpan<int2> new_edges)
+/**
+ * Copy the deduplicated edges to their final array and free every hash map right after, so that
+ * the hash maps and the edges array only have to exist at the same time for a single map.
+ */
+static void serialize_deduplicated_edges_and_free_maps(MutableSpan<EdgeMap> edge_maps,
+                                                       const OffsetIndices<int> edge_offsets,
+                                                       MutableSpan<int2> new_edges)
 {
   threading::parallel_for_each(edge_maps, [&](EdgeMap &edge_map) {
     const int task_index = &edge_map - edge_maps.data();
-    if (edge_offsets[task_index].is_empty()) {
-      return;
+    if (!edge_offsets[task_index].is_empty()) {
+      MutableSpan<int2> result_edges = new_edges.slice(edge_offsets[task_index]);
+      result_edges.copy_from(edge_map.as_span().cast<int2>());
     }
-
-    MutableSpan<int2> result_edges = new_edges.slice(edge_offsets[task_index]);
-    result_edges.copy_from(edge_map.as_span().cast<int2>());
+    edge_map.clear_and_shrink();
   });
 }
 
@@ -148,11 +151,6 @@ static int get_parallel_maps_count(const Mesh &mesh)
   return power_of_2_min_i(std::min(8, system_thread_count));
 }
 
-static void clear_hash_tables(MutableSpan<EdgeMap> edge_maps)
-{
-  threading::parallel_for_each(edge_maps, [](EdgeMap &edge_map) { edge_map.clear_and_shrink(); });
-}
-
 static void deselect_known_edges(const OffsetIndices<int> edge_offsets,
                                  const Span<EdgeMap> edge_maps,
                                  const uint32_t parallel_mask,
@@ -195,12 +193,8 @@ void mesh_calc_edges(Mesh &mesh, bool keep_existing_edges, const bool select_new
   }
   const OffsetIndices<int> edge_offsets = offset_indices::accumulate_counts_to_offsets(edge_sizes);
 
-  /* Create new edges. */
   MutableAttributeAccessor attributes = mesh.attributes_for_write();
   attributes.add<int>(".corner_edge", AttrDomain::Corner, AttributeInitConstruct());
-  MutableSpan<int2> new_edges(MEM_cnew_array<int2>(edge_offsets.total_size(), __func__),
-                              edge_offsets.total_size());
-  calc_edges::serialize_and_initialize_deduplicated_edges(edge_maps, edge_offsets, new_edges);
   calc_edges::update_edge_indices_in_face_loops(mesh.faces(),
                                                 mesh.corner_verts(),
                                                 edge_maps,
@@ -208,28 +202,42 @@ void mesh_calc_edges(Mesh &mesh, bool keep_existing_edges, const bool select_new
                                                 edge_offsets,
                                                 mesh.corner_edges_for_write());
 
-  Array<int2> original_edges;
+  /* Find the new edges while the old edges still exist, to avoid copying them. */
+  bool *new_select_edge = nullptr;
   if (keep_existing_edges && select_new_edges) {
-    original_edges.reinitialize(mesh.edges_num);
-    array_utils::copy(mesh.edges(), original_edges.as_mutable_span());
+    new_select_edge = static_cast<bool *>(
+        MEM_malloc_arrayN(edge_offsets.total_size(), sizeof(bool), __func__));
+    MutableSpan<bool> selection(new_select_edge, edge_offsets.total_size());
+    selection.fill(true);
+    calc_edges::deselect_known_edges(
+        edge_offsets, edge_maps, parallel_mask, mesh.edges(), selection);
   }
 
+  /* Create new edges. Allocated memory is only used once the edges are written, so freeing every
+   * hash map once its edges are copied keeps the peak memory usage lower. */
+  MutableSpan<int2> new_edges(
+      static_cast<int2 *>(MEM_malloc_arrayN(edge_offsets.total_size(), sizeof(int2), __func__)),
+      edge_offsets.total_size());
+  calc_edges::serialize_deduplicated_edges_and_free_maps(edge_maps, edge_offsets, new_edges);
+
   /* Free old CustomData and assign new one. */
   CustomData_free(&mesh.edge_data, mesh.edges_num);
   CustomData_reset(&mesh.edge_data);
   mesh.edges_num = edge_offsets.total_size();
   attributes.add<int2>(".edge_verts", AttrDomain::Edge, AttributeInitMoveArray(new_edges.data()));
 
-  if (select_new_edges) {
-    MutableAttributeAccessor attributes = mesh.attributes_for_write();
+  if (new_select_edge) {
+    if (!attributes.add<bool>(
+            ".select_edge", AttrDomain::Edge, AttributeInitMoveArray(new_select_edge)))
+    {
+      MEM_freeN(new_select_edge);
+    }
+  }
+  else if (select_new_edges) {
     SpanAttributeWriter<bool> select_edge = attributes.lookup_or_add_for_write_span<bool>(
         ".select_edge", AttrDomain::Edge);
     if (select_edge) {
       select_edge.span.fill(true);
-      if (!original_edges.is_empty()) {
-        calc_edges::deselect_known_edges(
-            edge_offsets, edge_maps, parallel_mask, original_edges, select_edge.span);
-      }
       select_edge.finish();
     }
   }
@@ -238,9 +246,6 @@ void mesh_calc_edges(Mesh &mesh, bool keep_existing_edges, const bool select_new
     /* All edges are rebuilt from the faces, so there are no loose edges. */
     mesh.tag_loose_edges_none();
   }
-
-  /* Explicitly clear edge maps, because that way it can be parallelized. */
-  calc_edges::clear_hash_tables(edge_maps);
 }
 
 }  // namespace blender::bke
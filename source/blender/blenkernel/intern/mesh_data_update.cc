@@ -29,6 +29,7 @@
 #include "BLI_span.hh"
 #include "BLI_task.h"
 #include "BLI_task.hh"
+#include "BLI_timeit.hh"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
 
@@ -318,6 +319,8 @@ static void mesh_calc_modifiers(Depsgraph &depsgraph,
                                 Mesh **r_final,
                                 GeometrySet **r_geometry_set)
 {
+  SCOPED_TIMER_STATS("Mesh Modifiers");
+  MEM_ScopedCategory memory_category(MEM_CATEGORY_MESH);
   /* Input mesh shouldn't be modified. */
   Mesh &mesh_input = *static_cast<Mesh *>(ob.data);
   /* The final mesh is the result of calculating all enabled modifiers. */
@@ -775,6 +778,7 @@ static void editbmesh_calc_modifiers(Depsgraph &depsgraph,
                                      Mesh **r_final,
                                      GeometrySet **r_geometry_set)
 {
+  MEM_ScopedCategory memory_category(MEM_CATEGORY_MESH);
   Mesh &mesh_input = *static_cast<Mesh *>(ob.data);
   BMEditMesh &em_input = *mesh_input.runtime->edit_mesh;
 
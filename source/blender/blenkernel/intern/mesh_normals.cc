@@ -19,6 +19,7 @@
 
 #include "BLI_array_utils.hh"
 #include "BLI_bit_vector.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_linklist.h"
 #include "BLI_math_base.hh"
 #include "BLI_math_vector.hh"
@@ -26,6 +27,7 @@
 #include "BLI_span.hh"
 #include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector_set.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_customdata.hh"
@@ -142,6 +144,54 @@ float3 face_normal_calc(const Span<float3> vert_positions, const Span<int> face_
  * meshes can slow down high-poly meshes. For details on performance, see D11993.
  * \{ */
 
+/**
+ * Kernels for ranges of faces that only contain triangles or quads, which is the common case for
+ * most meshes. Corners of such faces are contiguous and have a known size, so there is no need to
+ * read the face offsets or to loop over the corners of every face.
+ */
+static void normals_calc_tris(const Span<float3> positions,
+                              const Span<int> corner_verts,
+                              MutableSpan<float3> face_normals)
+{
+  for (const int i : face_normals.index_range()) {
+    const int *verts = &corner_verts[i * 3];
+    float3 normal = math::cross(positions[verts[0]] - positions[verts[1]],
+                                positions[verts[1]] - positions[verts[2]]);
+    if (UNLIKELY(normalize_v3(normal) == 0.0f)) {
+      normal = float3(0.0f, 0.0f, 1.0f);
+    }
+    face_normals[i] = normal;
+  }
+}
+
+static void normals_calc_quads(const Span<float3> positions,
+                               const Span<int> corner_verts,
+                               MutableSpan<float3> face_normals)
+{
+  for (const int i : face_normals.index_range()) {
+    const int *verts = &corner_verts[i * 4];
+    /* The cross product of the diagonals is equal to the Newell normal of a quad. */
+    float3 normal = math::cross(positions[verts[0]] - positions[verts[2]],
+                                positions[verts[1]] - positions[verts[3]]);
+    if (UNLIKELY(normalize_v3(normal) == 0.0f)) {
+      normal = float3(0.0f, 0.0f, 1.0f);
+    }
+    face_normals[i] = normal;
+  }
+}
+
+static bool faces_are_quads(const OffsetIndices<int> faces)
+{
+  const Span<int> offsets = faces.data();
+  const int start = offsets.first();
+  for (const int i : offsets.index_range()) {
+    if (offsets[i] != start + i * 4) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void normals_calc_faces(const Span<float3> positions,
                         const OffsetIndices<int> faces,
                         const Span<int> corner_verts,
@@ -149,12 +199,46 @@ void normals_calc_faces(const Span<float3> positions,
 {
   BLI_assert(faces.size() == face_normals.size());
   threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
-    for (const int i : range) {
-      face_normals[i] = normal_calc_ngon(positions, corner_verts.slice(faces[i]));
+    const IndexRange corners = faces[range];
+    if (corners.size() == range.size() * 3) {
+      /* Every face has at least three corners, so all faces in the range are triangles. */
+      normals_calc_tris(positions, corner_verts.slice(corners), face_normals.slice(range));
+    }
+    else if (corners.size() == range.size() * 4 && faces_are_quads(faces.slice(range))) {
+      normals_calc_quads(positions, corner_verts.slice(corners), face_normals.slice(range));
+    }
+    else {
+      for (const int i : range) {
+        face_normals[i] = normal_calc_ngon(positions, corner_verts.slice(faces[i]));
+      }
     }
   });
 }
 
+static float3 vert_normal_calc(const Span<float3> positions,
+                               const OffsetIndices<int> faces,
+                               const Span<int> corner_verts,
+                               const Span<int> vert_faces,
+                               const Span<float3> face_normals,
+                               const int vert)
+{
+  if (vert_faces.is_empty()) {
+    return math::normalize(positions[vert]);
+  }
+
+  float3 vert_normal(0);
+  for (const int face : vert_faces) {
+    const int2 adjacent_verts = face_find_adjacent_verts(faces[face], corner_verts, vert);
+    const float3 dir_prev = math::normalize(positions[adjacent_verts[0]] - positions[vert]);
+    const float3 dir_next = math::normalize(positions[adjacent_verts[1]] - positions[vert]);
+    const float factor = math::safe_acos_approx(math::dot(dir_prev, dir_next));
+
+    vert_normal += face_normals[face] * factor;
+  }
+
+  return math::normalize(vert_normal);
+}
+
 void normals_calc_verts(const Span<float3> vert_positions,
                         const OffsetIndices<int> faces,
                         const Span<int> corner_verts,
@@ -162,26 +246,10 @@ void normals_calc_verts(const Span<float3> vert_positions,
                         const Span<float3> face_normals,
                         MutableSpan<float3> vert_normals)
 {
-  const Span<float3> positions = vert_positions;
-  threading::parallel_for(positions.index_range(), 1024, [&](const IndexRange range) {
+  threading::parallel_for(vert_positions.index_range(), 1024, [&](const IndexRange range) {
     for (const int vert : range) {
-      const Span<int> vert_faces = vert_to_face_map[vert];
-      if (vert_faces.is_empty()) {
-        vert_normals[vert] = math::normalize(positions[vert]);
-        continue;
-      }
-
-      float3 vert_normal(0);
-      for (const int face : vert_faces) {
-        const int2 adjacent_verts = face_find_adjacent_verts(faces[face], corner_verts, vert);
-        const float3 dir_prev = math::normalize(positions[adjacent_verts[0]] - positions[vert]);
-        const float3 dir_next = math::normalize(positions[adjacent_verts[1]] - positions[vert]);
-        const float factor = math::safe_acos_approx(math::dot(dir_prev, dir_next));
-
-        vert_normal += face_normals[face] * factor;
-      }
-
-      vert_normals[vert] = math::normalize(vert_normal);
+      vert_normals[vert] = vert_normal_calc(
+          vert_positions, faces, corner_verts, vert_to_face_map[vert], face_normals, vert);
     }
   });
 }
@@ -250,6 +318,64 @@ blender::Span<blender::float3> Mesh::vert_normals() const
   return this->runtime->vert_normals_cache.data();
 }
 
+void Mesh::tag_positions_changed_partial(const blender::IndexMask &changed_verts)
+{
+  using namespace blender;
+  using namespace blender::bke;
+  MeshRuntime &runtime = *this->runtime;
+  /* Without cached face normals there is nothing to update. When a large part of the mesh moved,
+   * recomputing all normals in parallel is faster than gathering the affected elements. */
+  if (!runtime.face_normals_cache.is_cached() || changed_verts.size() > this->verts_num / 8) {
+    this->tag_positions_changed();
+    return;
+  }
+
+  const Span<float3> positions = this->vert_positions();
+  const OffsetIndices faces = this->faces();
+  const Span<int> corner_verts = this->corner_verts();
+  const GroupedSpan<int> vert_to_face = this->vert_to_face_map();
+
+  VectorSet<int> affected_faces;
+  changed_verts.foreach_index(
+      [&](const int vert) { affected_faces.add_multiple(vert_to_face[vert]); });
+
+  /* Vertex normals depend on the normals of the surrounding faces and on the positions of the
+   * neighboring vertices in those faces, so all vertices of the affected faces change. */
+  const bool update_vert_normals = runtime.vert_normals_cache.is_cached();
+  VectorSet<int> affected_verts;
+  if (update_vert_normals) {
+    changed_verts.foreach_index([&](const int vert) { affected_verts.add(vert); });
+    for (const int face : affected_faces) {
+      affected_verts.add_multiple(corner_verts.slice(faces[face]));
+    }
+  }
+
+  this->tag_positions_changed_no_normals();
+  runtime.corner_normals_cache.tag_dirty();
+
+  runtime.face_normals_cache.update([&](Vector<float3> &r_data) {
+    threading::parallel_for(affected_faces.index_range(), 1024, [&](const IndexRange range) {
+      for (const int face : affected_faces.as_span().slice(range)) {
+        r_data[face] = mesh::normal_calc_ngon(positions, corner_verts.slice(faces[face]));
+      }
+    });
+  });
+
+  if (!update_vert_normals) {
+    runtime.vert_normals_cache.tag_dirty();
+    return;
+  }
+  const Span<float3> face_normals = runtime.face_normals_cache.data();
+  runtime.vert_normals_cache.update([&](Vector<float3> &r_data) {
+    threading::parallel_for(affected_verts.index_range(), 1024, [&](const IndexRange range) {
+      for (const int vert : affected_verts.as_span().slice(range)) {
+        r_data[vert] = mesh::vert_normal_calc(
+            positions, faces, corner_verts, vert_to_face[vert], face_normals, vert);
+      }
+    });
+  });
+}
+
 blender::Span<blender::float3> Mesh::face_normals() const
 {
   using namespace blender;
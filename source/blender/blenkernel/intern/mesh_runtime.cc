@@ -392,8 +392,13 @@ void Mesh::tag_positions_changed()
 
 void Mesh::tag_positions_changed_no_normals()
 {
-  free_bvh_cache(*this->runtime);
-  this->runtime->corner_tris_cache.tag_dirty();
+  bvhcache_tag_positions_changed(&this->runtime->bvh_cache);
+  /* Quads and N-gons are triangulated based on their shape, but the triangulation of a mesh with
+   * only triangles doesn't depend on positions, so it can stay shared with the original mesh.
+   * Every face has at least three corners, so that's the case when there are three per face. */
+  if (int64_t(this->corners_num) != int64_t(this->faces_num) * 3) {
+    this->runtime->corner_tris_cache.tag_dirty();
+  }
   this->runtime->bounds_cache.tag_dirty();
   this->runtime->shrinkwrap_boundary_cache.tag_dirty();
 }
@@ -401,7 +406,7 @@ void Mesh::tag_positions_changed_no_normals()
 void Mesh::tag_positions_changed_uniformly()
 {
   /* The normals and triangulation didn't change, since all verts moved by the same amount. */
-  free_bvh_cache(*this->runtime);
+  bvhcache_tag_positions_changed(&this->runtime->bvh_cache);
   this->runtime->bounds_cache.tag_dirty();
 }
 
@@ -4226,13 +4226,27 @@ void node_tree_update_all_users(Main *main, ID *id)
   if (id == nullptr) {
     return;
   }
+  node_tree_update_all_users(main, Span<ID *>(&id, 1));
+}
+
+void node_tree_update_all_users(Main *main, const Span<ID *> ids)
+{
+  Set<const ID *> ids_set;
+  for (const ID *id : ids) {
+    if (id != nullptr) {
+      ids_set.add(id);
+    }
+  }
+  if (ids_set.is_empty()) {
+    return;
+  }
 
   bool need_update = false;
 
   /* Update all users of ngroup, to add/remove sockets as needed. */
   FOREACH_NODETREE_BEGIN (main, ntree, owner_id) {
     for (bNode *node : ntree->all_nodes()) {
-      if (node->id == id) {
+      if (node->id != nullptr && ids_set.contains(node->id)) {
         BKE_ntree_update_tag_node_property(ntree, node);
         need_update = true;
       }
@@ -47,7 +47,19 @@ namespace deg = blender::deg;
 
 void BKE_object_eval_reset(Object *ob_eval)
 {
+  /* Keep the draw cache of the owned evaluated mesh, the buffers that don't depend on changed data
+   * can be reused for the mesh of this evaluation. */
+  void *mesh_batch_cache = nullptr;
+  ID *data_eval = ob_eval->runtime->data_eval;
+  if (data_eval != nullptr && ob_eval->runtime->is_data_eval_owned && GS(data_eval->name) == ID_ME)
+  {
+    Mesh *mesh_eval = reinterpret_cast<Mesh *>(data_eval);
+    mesh_batch_cache = std::exchange(mesh_eval->runtime->batch_cache, nullptr);
+  }
+
   BKE_object_free_derived_caches(ob_eval);
+
+  ob_eval->runtime->mesh_batch_cache_previous = mesh_batch_cache;
 }
 
 void BKE_object_eval_local_transform(Depsgraph *depsgraph, Object *ob)
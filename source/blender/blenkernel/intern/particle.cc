@@ -32,6 +32,7 @@
 #include "DNA_particle_types.h"
 #include "DNA_scene_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_kdopbvh.h"
 #include "BLI_kdtree.h"
@@ -41,8 +42,10 @@
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_math_vector_types.hh"
 #include "BLI_rand.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -2655,19 +2658,36 @@ void psys_find_parents(ParticleSimulationData *sim, const bool use_render_params
 
   BLI_kdtree_3d_balance(tree);
 
-  for (; p < totchild; p++, cpa++) {
-    psys_particle_on_emitter(sim->psmd,
-                             from,
-                             cpa->num,
-                             DMCACHE_ISCHILD,
-                             cpa->fuv,
-                             cpa->foffset,
-                             co,
-                             nullptr,
-                             nullptr,
-                             nullptr,
-                             orco);
-    cpa->parent = BLI_kdtree_3d_find_nearest(tree, orco, nullptr);
+  /* Gather the remaining children first, so their parents can be found in a single batch. */
+  const int children_num = std::max(totchild - p, 0);
+  blender::Array<blender::float3> child_orcos(children_num);
+  blender::Array<int> child_parents(children_num);
+  ChildParticle *first_child = cpa;
+  blender::threading::parallel_for(
+      blender::IndexRange(children_num), 1024, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          ChildParticle &child = first_child[i];
+          float child_co[3];
+          psys_particle_on_emitter(sim->psmd,
+                                   from,
+                                   child.num,
+                                   DMCACHE_ISCHILD,
+                                   child.fuv,
+                                   child.foffset,
+                                   child_co,
+                                   nullptr,
+                                   nullptr,
+                                   nullptr,
+                                   child_orcos[i]);
+        }
+      });
+  BLI_kdtree_3d_find_nearest_batch(tree,
+                                   reinterpret_cast<const float(*)[3]>(child_orcos.data()),
+                                   uint(children_num),
+                                   child_parents.data(),
+                                   nullptr);
+  for (int i = 0; i < children_num; i++) {
+    first_child[i].parent = child_parents[i];
   }
 
   BLI_kdtree_3d_free(tree);
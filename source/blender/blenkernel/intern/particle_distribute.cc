@@ -813,13 +813,11 @@ static void exec_distribute_child(TaskPool *__restrict /*pool*/, void *taskdata)
   ChildParticle *cpa;
   int p;
 
-  /* RNG skipping at the beginning */
-  cpa = psys->child;
-  for (p = 0; p < task->begin; p++, cpa++) {
-    BLI_rng_skip(task->rng, PSYS_RND_DIST_SKIP);
-  }
+  /* RNG skipping at the beginning, in a single step since skipping is cheap. */
+  BLI_rng_skip(task->rng, PSYS_RND_DIST_SKIP * task->begin);
 
-  for (; p < task->end; p++, cpa++) {
+  cpa = psys->child + task->begin;
+  for (p = task->begin; p < task->end; p++, cpa++) {
     distribute_children_exec(task, cpa, p);
   }
 }
@@ -142,73 +142,93 @@ static int partition_indices_material_faces(MutableSpan<int> indices,
   }
 }
 
-/* Add a vertex to the map, with a positive value for unique vertices and
- * a negative value for additional vertices */
-static int map_insert_vert(Map<int, int> &map,
-                           MutableSpan<bool> vert_bitmap,
-                           int *face_verts,
-                           int *uniq_verts,
-                           int vertex)
-{
-  return map.lookup_or_add_cb(vertex, [&]() {
-    int value;
-    if (!vert_bitmap[vertex]) {
-      vert_bitmap[vertex] = true;
-      value = *uniq_verts;
-      (*uniq_verts)++;
-    }
-    else {
-      value = ~(*face_verts);
-      (*face_verts)++;
-    }
-    return value;
-  });
-}
-
-/* Find vertices used by the faces in this node and update the draw buffers */
-static void build_mesh_leaf_node(const Span<int> corner_verts,
-                                 const Span<int3> corner_tris,
-                                 MutableSpan<bool> vert_bitmap,
-                                 Node &node)
+/**
+ * Find the vertices used by the faces of every leaf node, and the node-local vertex indices of
+ * every triangle. A vertex used by several nodes is unique to the node with the lowest index,
+ * and shared in the others. Unique vertices are stored first in #Node::vert_indices_.
+ *
+ * Only assigning the unique vertices depends on the order of nodes and is done serially,
+ * gathering and sorting the vertices of the nodes is done in parallel.
+ */
+static void build_mesh_leaf_nodes(const int verts_num,
+                                  const Span<int> corner_verts,
+                                  const Span<int3> corner_tris,
+                                  MutableSpan<Node> nodes)
 {
-  node.unique_verts_num_ = 0;
-  int shared_verts = 0;
-  const Span<int> prim_indices = node.prim_indices_;
-
-  /* reserve size is rough guess */
-  Map<int, int> map;
-  map.reserve(prim_indices.size());
-
-  node.face_vert_indices_.reinitialize(prim_indices.size());
-
-  for (const int i : prim_indices.index_range()) {
-    const int3 &tri = corner_tris[prim_indices[i]];
-    for (int j = 0; j < 3; j++) {
-      node.face_vert_indices_[i][j] = map_insert_vert(
-          map, vert_bitmap, &shared_verts, &node.unique_verts_num_, corner_verts[tri[j]]);
+  Vector<int> leaves;
+  for (const int i : nodes.index_range()) {
+    if (nodes[i].flag_ & PBVH_Leaf) {
+      leaves.append(i);
     }
   }
 
-  node.vert_indices_.reinitialize(node.unique_verts_num_ + shared_verts);
-
-  /* Build the vertex list, unique verts first */
-  for (const MapItem<int, int> item : map.items()) {
-    int value = item.value;
-    if (value < 0) {
-      value = -value + node.unique_verts_num_ - 1;
+  threading::parallel_for(leaves.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      Node &node = nodes[leaves[i]];
+      const Span<int> prim_indices = node.prim_indices_;
+
+      /* Reserve size is rough guess. */
+      VectorSet<int> verts;
+      verts.reserve(prim_indices.size());
+
+      node.face_vert_indices_.reinitialize(prim_indices.size());
+      for (const int j : prim_indices.index_range()) {
+        const int3 &tri = corner_tris[prim_indices[j]];
+        for (int k = 0; k < 3; k++) {
+          node.face_vert_indices_[j][k] = verts.index_of_or_add(corner_verts[tri[k]]);
+        }
+      }
+      node.vert_indices_ = verts.as_span();
     }
+  });
 
-    node.vert_indices_[value] = item.key;
+  /* Mark the vertices which are already unique to a previous node by negating them. */
+  Array<bool> vert_bitmap(verts_num, false);
+  for (const int i : leaves) {
+    Node &node = nodes[i];
+    for (int &vert : node.vert_indices_) {
+      if (vert_bitmap[vert]) {
+        vert = -vert - 1;
+      }
+      else {
+        vert_bitmap[vert] = true;
+      }
+    }
   }
 
-  for (const int i : prim_indices.index_range()) {
-    for (int j = 0; j < 3; j++) {
-      if (node.face_vert_indices_[i][j] < 0) {
-        node.face_vert_indices_[i][j] = -node.face_vert_indices_[i][j] + node.unique_verts_num_ -
-                                        1;
+  threading::parallel_for(leaves.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      Node &node = nodes[leaves[i]];
+      const Span<int> verts = node.vert_indices_;
+
+      Array<int> new_index(verts.size());
+      Array<int, 0> vert_indices(verts.size());
+      int unique_num = 0;
+      for (const int j : verts.index_range()) {
+        if (verts[j] >= 0) {
+          new_index[j] = unique_num;
+          vert_indices[unique_num] = verts[j];
+          unique_num++;
+        }
       }
+      int shared_num = 0;
+      for (const int j : verts.index_range()) {
+        if (verts[j] < 0) {
+          new_index[j] = unique_num + shared_num;
+          vert_indices[unique_num + shared_num] = -verts[j] - 1;
+          shared_num++;
+        }
+      }
+
+      for (int3 &face_verts : node.face_vert_indices_) {
+        for (int k = 0; k < 3; k++) {
+          face_verts[k] = new_index[face_verts[k]];
+        }
+      }
+      node.vert_indices_ = std::move(vert_indices);
+      node.unique_verts_num_ = unique_num;
     }
-  }
+  });
 }
 
 /* Return zero if all primitives in the node can be drawn with the
@@ -235,13 +255,10 @@ static bool leaf_needs_material_split(const Span<int> prim_indices,
   return false;
 }
 
-static void build_nodes_recursive_mesh(const Span<int> corner_verts,
-                                       const Span<int3> corner_tris,
-                                       const Span<int> tri_faces,
+static void build_nodes_recursive_mesh(const Span<int> tri_faces,
                                        const Span<int> material_indices,
                                        const Span<bool> sharp_faces,
                                        const int leaf_limit,
-                                       MutableSpan<bool> vert_bitmap,
                                        const int node_index,
                                        const Bounds<float3> *cb,
                                        const Span<Bounds<float3>> prim_bounds,
@@ -263,7 +280,6 @@ static void build_nodes_recursive_mesh(const Span<int> corner_verts,
       Node &node = nodes[node_index];
       node.flag_ |= PBVH_Leaf;
       node.prim_indices_ = prim_indices.as_span().slice(prim_offset, prims_num);
-      build_mesh_leaf_node(corner_verts, corner_tris, vert_bitmap, node);
       return;
     }
   }
@@ -307,13 +323,10 @@ static void build_nodes_recursive_mesh(const Span<int> corner_verts,
   }
 
   /* Build children */
-  build_nodes_recursive_mesh(corner_verts,
-                             corner_tris,
-                             tri_faces,
+  build_nodes_recursive_mesh(tri_faces,
                              material_indices,
                              sharp_faces,
                              leaf_limit,
-                             vert_bitmap,
                              nodes[node_index].children_offset_,
                              nullptr,
                              prim_bounds,
@@ -323,13 +336,10 @@ static void build_nodes_recursive_mesh(const Span<int> corner_verts,
                              depth + 1,
                              prim_indices,
                              nodes);
-  build_nodes_recursive_mesh(corner_verts,
-                             corner_tris,
-                             tri_faces,
+  build_nodes_recursive_mesh(tri_faces,
                              material_indices,
                              sharp_faces,
                              leaf_limit,
-                             vert_bitmap,
                              nodes[node_index].children_offset_ + 1,
                              nullptr,
                              prim_bounds,
@@ -367,8 +377,6 @@ std::unique_ptr<Tree> build_mesh(Mesh *mesh)
 
   const Span<int> tri_faces = mesh->corner_tri_faces();
 
-  Array<bool> vert_bitmap(mesh->verts_num, false);
-
   const int leaf_limit = LEAF_LIMIT;
 
   /* For each face, store the AABB and the AABB centroid */
@@ -401,13 +409,10 @@ std::unique_ptr<Tree> build_mesh(Mesh *mesh)
   array_utils::fill_index_range<int>(pbvh->prim_indices_);
 
   pbvh->nodes_.resize(1);
-  build_nodes_recursive_mesh(corner_verts,
-                             corner_tris,
-                             tri_faces,
+  build_nodes_recursive_mesh(tri_faces,
                              material_index,
                              sharp_face,
                              leaf_limit,
-                             vert_bitmap,
                              0,
                              &cb,
                              prim_bounds,
@@ -417,6 +422,7 @@ std::unique_ptr<Tree> build_mesh(Mesh *mesh)
                              0,
                              pbvh->prim_indices_,
                              pbvh->nodes_);
+  build_mesh_leaf_nodes(mesh->verts_num, corner_verts, corner_tris, pbvh->nodes_);
 
   update_bounds_mesh(vert_positions, *pbvh);
   store_bounds_orig(*pbvh);
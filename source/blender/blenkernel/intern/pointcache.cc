@@ -12,6 +12,7 @@
 #include <cstring>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <zstd.h>
 
 /* needed for directory lookup */
 #ifndef WIN32
@@ -40,6 +41,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
 
@@ -76,16 +78,27 @@
 #  else
 #    include "minilzo.h"
 #  endif
-#  define LZO_HEAP_ALLOC(var, size) \
-    lzo_align_t __LZO_MMODEL var[((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t)]
 #endif
 
-#define LZO_OUT_LEN(size) ((size) + (size) / 16 + 64 + 3)
-
 #ifdef WITH_LZMA
 #  include "LzmaLib.h"
 #endif
 
+/**
+ * Compression of a stream in a cache file, stored in the byte before the stream. Caches are
+ * written with ZSTD, LZO and LZMA streams of older caches are still read.
+ */
+enum {
+  PTCACHE_STREAM_UNCOMPRESSED = 0,
+  PTCACHE_STREAM_LZO = 1,
+  PTCACHE_STREAM_LZMA = 2,
+  PTCACHE_STREAM_ZSTD = 3,
+};
+
+/* ZSTD levels used for the #PTCACHE_COMPRESS_LZO and #PTCACHE_COMPRESS_LZMA settings. */
+#define PTCACHE_ZSTD_LEVEL_LITE 3
+#define PTCACHE_ZSTD_LEVEL_HEAVY 15
+
 #define PTCACHE_DATA_FROM(data, type, from) \
   if (data[type]) { \
     memcpy(data[type], from, ptcache_data_size[type]); \
@@ -124,8 +137,10 @@ static int ptcache_extra_datasize[] = {
 
 /* forward declarations */
 static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len);
-static int ptcache_file_compressed_write(
-    PTCacheFile *pf, uchar *in, uint in_len, uchar *out, int mode);
+static bool ptcache_file_compressed_write(PTCacheFile *pf,
+                                          const uchar *in,
+                                          uint in_len,
+                                          int mode);
 static int ptcache_file_write(PTCacheFile *pf, const void *f, uint tot, uint size);
 static int ptcache_file_read(PTCacheFile *pf, void *f, uint tot, uint size);
 
@@ -686,7 +701,6 @@ static int ptcache_dynamicpaint_write(PTCacheFile *pf, void *dp_v)
   if (surface->format != MOD_DPAINT_SURFACE_F_IMAGESEQ && surface->data) {
     int total_points = surface->data->total_points;
     uint in_len;
-    uchar *out;
 
     /* cache type */
     ptcache_file_write(pf, &surface->type, 1, sizeof(int));
@@ -704,11 +718,8 @@ static int ptcache_dynamicpaint_write(PTCacheFile *pf, void *dp_v)
       return 0;
     }
 
-    out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len), "pointcache_lzo_buffer");
-
     ptcache_file_compressed_write(
-        pf, (uchar *)surface->data->type_data, in_len, out, cache_compress);
-    MEM_freeN(out);
+        pf, (const uchar *)surface->data->type_data, in_len, cache_compress);
   }
   return 1;
 }
@@ -1501,124 +1512,140 @@ static void ptcache_file_close(PTCacheFile *pf)
   }
 }
 
-static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len)
-{
-  int r = 0;
-  uchar compressed = 0;
-  size_t in_len;
-#ifdef WITH_LZO
-  size_t out_len = len;
-#endif
+/**
+ * A stream of a cache file that is read into memory, so that several streams can be
+ * decompressed at the same time.
+ */
+struct PTCacheFileStream {
+  uchar compressed;
+  /** Compressed data, null when the stream is not compressed or empty. */
   uchar *in;
-  uchar *props = static_cast<uchar *>(MEM_callocN(sizeof(char[16]), "tmp"));
+  size_t in_len;
+  uchar props[16];
+  size_t props_len;
+  /** Decompressed data is written here. */
+  uchar *result;
+  uint len;
+};
 
-  ptcache_file_read(pf, &compressed, 1, sizeof(uchar));
-  if (compressed) {
-    uint size;
-    ptcache_file_read(pf, &size, 1, sizeof(uint));
-    in_len = size_t(size);
-    if (in_len == 0) {
-      /* do nothing */
-    }
-    else {
-      in = (uchar *)MEM_callocN(sizeof(uchar) * in_len, "pointcache_compressed_buffer");
-      ptcache_file_read(pf, in, in_len, sizeof(uchar));
-#ifdef WITH_LZO
-      if (compressed == 1) {
-        r = lzo1x_decompress_safe(in, (lzo_uint)in_len, result, (lzo_uint *)&out_len, nullptr);
-      }
-#endif
-#ifdef WITH_LZMA
-      if (compressed == 2) {
-        size_t sizeOfIt;
-        size_t leni = in_len, leno = len;
-        ptcache_file_read(pf, &size, 1, sizeof(uint));
-        sizeOfIt = size_t(size);
-        ptcache_file_read(pf, props, sizeOfIt, sizeof(uchar));
-        r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
-      }
-#endif
-      MEM_freeN(in);
-    }
-  }
-  else {
+/**
+ * Read a stream written by #ptcache_file_compressed_write. Uncompressed data is read into
+ * \a result directly, compressed data has to be decompressed with
+ * #ptcache_file_stream_decompress.
+ */
+static void ptcache_file_stream_read(PTCacheFile *pf,
+                                     PTCacheFileStream *stream,
+                                     uchar *result,
+                                     uint len)
+{
+  stream->compressed = PTCACHE_STREAM_UNCOMPRESSED;
+  stream->in = nullptr;
+  stream->in_len = 0;
+  stream->props_len = 0;
+  stream->result = result;
+  stream->len = len;
+
+  ptcache_file_read(pf, &stream->compressed, 1, sizeof(uchar));
+  if (stream->compressed == PTCACHE_STREAM_UNCOMPRESSED) {
     ptcache_file_read(pf, result, len, sizeof(uchar));
+    return;
   }
 
-  MEM_freeN(props);
+  uint size = 0;
+  ptcache_file_read(pf, &size, 1, sizeof(uint));
+  stream->in_len = size_t(size);
+  if (stream->in_len == 0) {
+    return;
+  }
+  stream->in = static_cast<uchar *>(MEM_mallocN(stream->in_len, "pointcache_compressed_buffer"));
+  ptcache_file_read(pf, stream->in, stream->in_len, sizeof(uchar));
 
-  return r;
+  if (stream->compressed == PTCACHE_STREAM_LZMA) {
+    ptcache_file_read(pf, &size, 1, sizeof(uint));
+    stream->props_len = std::min(size_t(size), sizeof(stream->props));
+    ptcache_file_read(pf, stream->props, stream->props_len, sizeof(uchar));
+  }
 }
-static int ptcache_file_compressed_write(
-    PTCacheFile *pf, uchar *in, uint in_len, uchar *out, int mode)
+
+/** Decompress a stream read by #ptcache_file_stream_read, can be called from any thread. */
+static int ptcache_file_stream_decompress(PTCacheFileStream *stream)
 {
   int r = 0;
-  uchar compressed = 0;
-  size_t out_len = 0;
-  uchar *props = static_cast<uchar *>(MEM_callocN(sizeof(char[16]), "tmp"));
-  size_t sizeOfIt = 5;
-
-  (void)mode; /* unused when building w/o compression */
+  if (stream->in == nullptr) {
+    return r;
+  }
 
+  switch (stream->compressed) {
 #ifdef WITH_LZO
-  out_len = LZO_OUT_LEN(in_len);
-  if (mode == PTCACHE_COMPRESS_LZO) {
-    LZO_HEAP_ALLOC(wrkmem, LZO1X_MEM_COMPRESS);
-
-    r = lzo1x_1_compress(in, (lzo_uint)in_len, out, (lzo_uint *)&out_len, wrkmem);
-    if (!(r == LZO_E_OK) || (out_len >= in_len)) {
-      compressed = 0;
-    }
-    else {
-      compressed = 1;
+    case PTCACHE_STREAM_LZO: {
+      size_t out_len = stream->len;
+      r = lzo1x_decompress_safe(
+          stream->in, (lzo_uint)stream->in_len, stream->result, (lzo_uint *)&out_len, nullptr);
+      break;
     }
-  }
 #endif
 #ifdef WITH_LZMA
-  if (mode == PTCACHE_COMPRESS_LZMA) {
-
-    r = LzmaCompress(out,
-                     &out_len,
-                     in,
-                     in_len, /* Assume `sizeof(char) == 1`. */
-                     props,
-                     &sizeOfIt,
-                     5,
-                     1 << 24,
-                     3,
-                     0,
-                     2,
-                     32,
-                     2);
-
-    if (!(r == SZ_OK) || (out_len >= in_len)) {
-      compressed = 0;
+    case PTCACHE_STREAM_LZMA: {
+      size_t leni = stream->in_len, leno = stream->len;
+      r = LzmaUncompress(
+          stream->result, &leno, stream->in, &leni, stream->props, stream->props_len);
+      break;
     }
-    else {
-      compressed = 2;
+#endif
+    case PTCACHE_STREAM_ZSTD: {
+      const size_t out_len = ZSTD_decompress(
+          stream->result, stream->len, stream->in, stream->in_len);
+      r = ZSTD_isError(out_len) ? 1 : 0;
+      break;
+    }
+  }
+
+  MEM_freeN(stream->in);
+  stream->in = nullptr;
+  return r;
+}
+
+static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len)
+{
+  PTCacheFileStream stream;
+  ptcache_file_stream_read(pf, &stream, result, len);
+  return ptcache_file_stream_decompress(&stream);
+}
+static bool ptcache_file_compressed_write(PTCacheFile *pf,
+                                          const uchar *in,
+                                          uint in_len,
+                                          int mode)
+{
+  uchar compressed = PTCACHE_STREAM_UNCOMPRESSED;
+  uchar *out = nullptr;
+  size_t out_len = 0;
+
+  if (mode != PTCACHE_COMPRESS_NO) {
+    const int level = (mode == PTCACHE_COMPRESS_LZMA) ? PTCACHE_ZSTD_LEVEL_HEAVY :
+                                                        PTCACHE_ZSTD_LEVEL_LITE;
+    const size_t out_capacity = ZSTD_compressBound(in_len);
+    out = static_cast<uchar *>(MEM_mallocN(out_capacity, "pointcache_compressed_buffer"));
+    out_len = ZSTD_compress(out, out_capacity, in, in_len, level);
+    if (!ZSTD_isError(out_len) && out_len < in_len) {
+      compressed = PTCACHE_STREAM_ZSTD;
     }
   }
-#endif
 
-  ptcache_file_write(pf, &compressed, 1, sizeof(uchar));
+  bool success = ptcache_file_write(pf, &compressed, 1, sizeof(uchar));
   if (compressed) {
     uint size = out_len;
-    ptcache_file_write(pf, &size, 1, sizeof(uint));
-    ptcache_file_write(pf, out, out_len, sizeof(uchar));
+    success &= ptcache_file_write(pf, &size, 1, sizeof(uint)) &&
+               ptcache_file_write(pf, out, out_len, sizeof(uchar));
   }
   else {
-    ptcache_file_write(pf, in, in_len, sizeof(uchar));
+    success &= ptcache_file_write(pf, in, in_len, sizeof(uchar));
   }
 
-  if (compressed == 2) {
-    uint size = sizeOfIt;
-    ptcache_file_write(pf, &sizeOfIt, 1, sizeof(uint));
-    ptcache_file_write(pf, props, size, sizeof(uchar));
+  if (out) {
+    MEM_freeN(out);
   }
 
-  MEM_freeN(props);
-
-  return r;
+  return success;
 }
 static int ptcache_file_read(PTCacheFile *pf, void *f, uint tot, uint size)
 {
@@ -1628,33 +1655,6 @@ static int ptcache_file_write(PTCacheFile *pf, const void *f, uint tot, uint siz
 {
   return (fwrite(f, size, tot, pf->fp) == tot);
 }
-static int ptcache_file_data_read(PTCacheFile *pf)
-{
-  int i;
-
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) && !ptcache_file_read(pf, pf->cur[i], 1, ptcache_data_size[i]))
-    {
-      return 0;
-    }
-  }
-
-  return 1;
-}
-static int ptcache_file_data_write(PTCacheFile *pf)
-{
-  int i;
-
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) &&
-        !ptcache_file_write(pf, pf->cur[i], 1, ptcache_data_size[i]))
-    {
-      return 0;
-    }
-  }
-
-  return 1;
-}
 static int ptcache_file_header_begin_read(PTCacheFile *pf)
 {
   uint typeflag = 0;
@@ -1825,17 +1825,6 @@ static void ptcache_data_free(PTCacheMem *pm)
     }
   }
 }
-static void ptcache_data_copy(void *from[], void *to[])
-{
-  int i;
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    /* NOTE: durian file 03.4b_comp crashes if to[i] is not tested
-     * its nullptr, not sure if this should be fixed elsewhere but for now its needed */
-    if (from[i] && to[i]) {
-      memcpy(to[i], from[i], ptcache_data_size[i]);
-    }
-  }
-}
 
 static void ptcache_extra_free(PTCacheMem *pm)
 {
@@ -1931,6 +1920,62 @@ static void ptcache_find_frames_around(PTCacheID *pid, uint frame, int *r_fra1,
   }
 }
 
+/**
+ * Size of the data of one point in an uncompressed cache file, which stores the data of all
+ * points interleaved.
+ */
+static size_t ptcache_point_size(const int data_types)
+{
+  size_t size = 0;
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    if (data_types & (1 << i)) {
+      size += ptcache_data_size[i];
+    }
+  }
+  return size;
+}
+
+/** Copy the interleaved data of all points into the separate data arrays of \a pm. */
+static void ptcache_points_deinterleave(PTCacheMem *pm, const uchar *points)
+{
+  const size_t point_size = ptcache_point_size(pm->data_types);
+  blender::threading::parallel_for(
+      blender::IndexRange(pm->totpoint), 4096, [&](const blender::IndexRange range) {
+        for (const int64_t point : range) {
+          const uchar *src = points + point * point_size;
+          for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+            if (pm->data_types & (1 << i)) {
+              memcpy(
+                  (char *)pm->data[i] + point * ptcache_data_size[i], src, ptcache_data_size[i]);
+              src += ptcache_data_size[i];
+            }
+          }
+        }
+      });
+}
+
+/** Copy the separate data arrays of \a pm into the interleaved data of all points. */
+static void ptcache_points_interleave(const PTCacheMem *pm, uchar *points)
+{
+  const size_t point_size = ptcache_point_size(pm->data_types);
+  blender::threading::parallel_for(
+      blender::IndexRange(pm->totpoint), 4096, [&](const blender::IndexRange range) {
+        for (const int64_t point : range) {
+          uchar *dst = points + point * point_size;
+          for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+            if (pm->data_types & (1 << i)) {
+              if (pm->data[i]) {
+                memcpy(dst,
+                       (const char *)pm->data[i] + point * ptcache_data_size[i],
+                       ptcache_data_size[i]);
+              }
+              dst += ptcache_data_size[i];
+            }
+          }
+        }
+      });
+}
+
 static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
 {
   PTCacheFile *pf = ptcache_file_open(pid, PTCACHE_FILE_READ, cfra);
@@ -1959,26 +2004,34 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
     ptcache_data_alloc(pm);
 
     if (pf->flag & PTCACHE_TYPEFLAG_COMPRESS) {
+      /* Read all streams before decompressing them in parallel. */
+      PTCacheFileStream streams[BPHYS_TOT_DATA];
+      int streams_num = 0;
       for (i = 0; i < BPHYS_TOT_DATA; i++) {
         uint out_len = pm->totpoint * ptcache_data_size[i];
         if (pf->data_types & (1 << i)) {
-          ptcache_file_compressed_read(pf, (uchar *)(pm->data[i]), out_len);
+          ptcache_file_stream_read(pf, &streams[streams_num++], (uchar *)(pm->data[i]), out_len);
         }
       }
+      blender::threading::parallel_for(
+          blender::IndexRange(streams_num), 1, [&](const blender::IndexRange range) {
+            for (const int64_t stream_index : range) {
+              ptcache_file_stream_decompress(&streams[stream_index]);
+            }
+          });
     }
     else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
-
-      for (i = 0; i < pm->totpoint; i++) {
-        if (!ptcache_file_data_read(pf)) {
-          error = 1;
-          break;
-        }
-        ptcache_data_copy(pf->cur, cur);
-        BKE_ptcache_mem_pointers_incr(cur);
+      /* The data of the points is interleaved, read it all at once instead of point by point. */
+      const size_t point_size = ptcache_point_size(pm->data_types);
+      uchar *points = static_cast<uchar *>(
+          MEM_mallocN(point_size * pm->totpoint, "pointcache_points_buffer"));
+      if (ptcache_file_read(pf, points, pm->totpoint, point_size)) {
+        ptcache_points_deinterleave(pm, points);
       }
+      else {
+        error = 1;
+      }
+      MEM_freeN(points);
     }
   }
 
@@ -2060,26 +2113,20 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
       for (i = 0; i < BPHYS_TOT_DATA; i++) {
         if (pm->data[i]) {
           uint in_len = pm->totpoint * ptcache_data_size[i];
-          uchar *out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
           ptcache_file_compressed_write(
-              pf, (uchar *)(pm->data[i]), in_len, out, pid->cache->compression);
-          MEM_freeN(out);
+              pf, (const uchar *)(pm->data[i]), in_len, pid->cache->compression);
         }
       }
     }
     else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
-
-      for (i = 0; i < pm->totpoint; i++) {
-        ptcache_data_copy(cur, pf->cur);
-        if (!ptcache_file_data_write(pf)) {
-          error = 1;
-          break;
-        }
-        BKE_ptcache_mem_pointers_incr(cur);
+      const size_t point_size = ptcache_point_size(pm->data_types);
+      uchar *points = static_cast<uchar *>(
+          MEM_callocN(point_size * pm->totpoint, "pointcache_points_buffer"));
+      ptcache_points_interleave(pm, points);
+      if (!ptcache_file_write(pf, points, pm->totpoint, point_size)) {
+        error = 1;
       }
+      MEM_freeN(points);
     }
   }
 
@@ -2096,10 +2143,8 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
 
       if (pid->cache->compression) {
         uint in_len = extra->totdata * ptcache_extra_datasize[extra->type];
-        uchar *out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
         ptcache_file_compressed_write(
-            pf, (uchar *)(extra->data), in_len, out, pid->cache->compression);
-        MEM_freeN(out);
+            pf, (const uchar *)(extra->data), in_len, pid->cache->compression);
       }
       else {
         ptcache_file_write(pf, extra->data, extra->totdata, ptcache_extra_datasize[extra->type]);
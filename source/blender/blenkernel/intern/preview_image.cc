@@ -18,12 +18,15 @@
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_screen_types.h"
+#include "DNA_space_types.h"
 #include "DNA_texture_types.h"
 #include "DNA_world_types.h"
 
 #include "BKE_icons.h"
+#include "BKE_idtype.hh"
 
 #include "BLI_ghash.h"
+#include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_ref.hh"
 #ifndef NDEBUG
@@ -218,6 +221,27 @@ PreviewImage *BKE_previewimg_id_get(const ID *id)
   return prv_p ? *prv_p : nullptr;
 }
 
+void BKE_previewimg_id_deferred_library_set(ID *id)
+{
+  BLI_assert(ID_IS_LINKED(id));
+  PreviewImage *prv = BKE_previewimg_id_get(id);
+  if (prv == nullptr || prv->runtime->deferred_loading_data) {
+    return;
+  }
+
+  char filepath[FILE_MAX_LIBEXTRA];
+  BLI_path_join(filepath,
+                sizeof(filepath),
+                id->lib->runtime.filepath_abs,
+                BKE_idtype_idcode_to_name(GS(id->name)),
+                id->name + 2);
+
+  prv->runtime->deferred_loading_data =
+      std::make_unique<blender::bke::PreviewDeferredLoadingData>();
+  prv->runtime->deferred_loading_data->filepath = filepath;
+  prv->runtime->deferred_loading_data->source = THB_SOURCE_BLEND;
+}
+
 void BKE_previewimg_id_free(ID *id)
 {
   PreviewImage **prv_p = BKE_previewimg_id_get_p(id);
@@ -491,8 +515,16 @@ void BKE_previewimg_blend_read(BlendDataReader *reader, PreviewImage *prv)
 
   prv->runtime = MEM_new<blender::bke::PreviewImageRuntime>(__func__);
 
+  /* Previews of linked data are only loaded from their library when displayed, see
+   * #BKE_previewimg_id_deferred_library_set. */
+  const bool skip_pixels = !BLO_read_data_is_undo(reader) &&
+                           BLO_read_data_current_library(reader) != nullptr;
+
   for (int i = 0; i < NUM_ICON_SIZES; i++) {
-    if (prv->rect[i]) {
+    if (skip_pixels) {
+      prv->rect[i] = nullptr;
+    }
+    else if (prv->rect[i]) {
       BLO_read_uint32_array(reader, prv->w[i] * prv->h[i], &prv->rect[i]);
     }
 
@@ -3346,6 +3346,17 @@ Depsgraph *BKE_scene_ensure_depsgraph(Main *bmain, Scene *scene, ViewLayer *view
   return (depsgraph_ptr != nullptr) ? *depsgraph_ptr : nullptr;
 }
 
+Depsgraph *BKE_scene_replace_depsgraph(Scene *scene, ViewLayer *view_layer, Depsgraph *depsgraph)
+{
+  BLI_assert(DEG_get_input_scene(depsgraph) == scene);
+  BLI_assert(DEG_get_input_view_layer(depsgraph) == view_layer);
+
+  Depsgraph **depsgraph_ptr = scene_get_depsgraph_p(scene, view_layer, true);
+  Depsgraph *depsgraph_old = *depsgraph_ptr;
+  *depsgraph_ptr = depsgraph;
+  return depsgraph_old;
+}
+
 static char *scene_undo_depsgraph_gen_key(Scene *scene, ViewLayer *view_layer, char *key_full)
 {
   if (key_full == nullptr) {
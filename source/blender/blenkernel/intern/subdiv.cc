@@ -11,8 +11,13 @@
 #include "DNA_mesh_types.h"
 #include "DNA_modifier_types.h"
 
+#include "BLI_implicit_sharing_ptr.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
+#include "BKE_attribute.hh"
+#include "BKE_customdata.hh"
+#include "BKE_mesh_types.hh"
 #include "BKE_subdiv_modifier.hh"
 
 #include "MEM_guardedalloc.h"
@@ -118,6 +123,7 @@ Subdiv *new_from_converter(const Settings *settings, OpenSubdiv_Converter *conve
   subdiv->topology_refiner = osd_topology_refiner;
   subdiv->evaluator = nullptr;
   subdiv->displacement_evaluator = nullptr;
+  subdiv->mesh_topology_key = nullptr;
   stats_end(&stats, SUBDIV_STATS_TOPOLOGY_REFINER_CREATION_TIME);
   subdiv->stats = stats;
   return subdiv;
@@ -137,6 +143,65 @@ Subdiv *new_from_mesh(const Settings *settings, const Mesh *mesh)
 
 /* Creation with cached-aware semantic. */
 
+struct MeshTopologyKey {
+  int verts_num;
+  /** Null for arrays that don't exist on the mesh, e.g. when there are no creases. */
+  Vector<ImplicitSharingPtr<>> arrays;
+
+  friend bool operator==(const MeshTopologyKey &a, const MeshTopologyKey &b)
+  {
+    return a.verts_num == b.verts_num && a.arrays.as_span() == b.arrays.as_span();
+  }
+};
+
+/**
+ * Get the implicitly shared arrays that the topology refiner is created from. Positions are not
+ * part of the key since they don't affect the topology. Returns nothing when one of the arrays
+ * is not implicitly shared, then its identity can't be tracked.
+ */
+static std::optional<MeshTopologyKey> mesh_topology_key_get(const Settings &settings,
+                                                            const Mesh &mesh)
+{
+  MeshTopologyKey key;
+  key.verts_num = mesh.verts_num;
+  bool is_valid = true;
+  auto add_array = [&](const ImplicitSharingInfo *sharing_info) {
+    if (sharing_info == nullptr) {
+      is_valid = false;
+      return;
+    }
+    sharing_info->add_user();
+    key.arrays.append(ImplicitSharingPtr<>(sharing_info));
+  };
+
+  add_array(mesh.runtime->face_offsets_sharing_info);
+  const AttributeAccessor attributes = mesh.attributes();
+  for (const StringRef name : {".edge_verts", ".corner_vert", ".corner_edge"}) {
+    add_array(attributes.lookup(name).sharing_info);
+  }
+  if (settings.use_creases) {
+    for (const StringRef name : {"crease_vert", "crease_edge"}) {
+      if (const GAttributeReader reader = attributes.lookup(name)) {
+        add_array(reader.sharing_info);
+      }
+      else {
+        key.arrays.append(nullptr);
+      }
+    }
+  }
+  /* UV maps define the face-varying topology. */
+  for (const CustomDataLayer &layer : Span(mesh.corner_data.layers, mesh.corner_data.totlayer)) {
+    if (layer.type == CD_PROP_FLOAT2) {
+      add_array(layer.sharing_info);
+    }
+  }
+
+  if (!is_valid) {
+    return std::nullopt;
+  }
+  return key;
+}
+
 Subdiv *update_from_converter(Subdiv *subdiv,
                               const Settings *settings,
                               OpenSubdiv_Converter *converter)
@@ -169,10 +234,24 @@ Subdiv *update_from_converter(Subdiv *subdiv,
 
 Subdiv *update_from_mesh(Subdiv *subdiv, const Settings *settings, const Mesh *mesh)
 {
+  std::optional<MeshTopologyKey> key = mesh_topology_key_get(*settings, *mesh);
+  if (key && subdiv != nullptr && subdiv->topology_refiner != nullptr &&
+      subdiv->mesh_topology_key != nullptr && *subdiv->mesh_topology_key == *key &&
+      settings_equal(&subdiv->settings, settings))
+  {
+    /* Same topology arrays as the mesh the topology refiner was created from, this avoids the
+     * comparison, which has to build face-varying topology for every UV map. */
+    return subdiv;
+  }
   OpenSubdiv_Converter converter;
   converter_init_for_mesh(&converter, settings, mesh);
   subdiv = update_from_converter(subdiv, settings, &converter);
   converter_free(&converter);
+  if (subdiv != nullptr) {
+    MEM_delete(subdiv->mesh_topology_key);
+    subdiv->mesh_topology_key = key ? MEM_new<MeshTopologyKey>(__func__, std::move(*key)) :
+                                      nullptr;
+  }
   return subdiv;
 }
 
@@ -193,6 +272,7 @@ void free(Subdiv *subdiv)
     openSubdiv_deleteTopologyRefiner(subdiv->topology_refiner);
   }
   displacement_detach(subdiv);
+  MEM_delete(subdiv->mesh_topology_key);
   if (subdiv->cache_.face_ptex_offset != nullptr) {
     MEM_freeN(subdiv->cache_.face_ptex_offset);
   }
@@ -11,6 +11,8 @@
 #  include "BLI_memory_cache.hh"
 #  include "BLI_memory_counter.hh"
 
+#  include "DNA_userdef_types.h"
+
 #  include <openvdb/openvdb.h>
 
 namespace blender::bke::volume_grid::file_cache {
@@ -162,9 +164,16 @@ class GridReadValue : public memory_cache::CachedValue {
  public:
   ImplicitSharingPtr<> tree_sharing_info;
   openvdb::GridBase::Ptr grid;
+  /** The leaf buffers of the tree are read from the file when they are accessed. */
+  bool is_delay_loaded = false;
 
   void count_memory(MemoryCounter &memory) const override
   {
+    if (is_delay_loaded) {
+      /* The memory usage grows as leaf buffers are loaded. */
+      memory.add(grid->baseTree().memUsage());
+      return;
+    }
     /* Avoid computing the amount of memory from scratch every time. */
     if (bytes_ == 0) {
       this->bytes_ = grid->baseTree().memUsage();
@@ -173,17 +182,21 @@ class GridReadValue : public memory_cache::CachedValue {
   }
 };
 
+static bool use_delay_load()
+{
+  return U.experimental.use_volume_delay_load;
+}
+
 /**
  * Load a single grid by name from a file. This loads the full grid including meta-data, transforms
- * and the tree.
+ * and the tree. With delay loading, the leaf buffers of the tree are only read when accessed.
  */
 static openvdb::GridBase::Ptr load_single_grid_from_disk(const StringRef file_path,
-                                                         const StringRef grid_name)
+                                                         const StringRef grid_name,
+                                                         const bool delay_load)
 {
-  /* Disable delay loading and file copying, this has poor performance
-   * on network drivers. */
-  const bool delay_load = false;
-
+  /* Disable file copying, this has poor performance on network drivers. Delay loading memory
+   * maps the file instead, which is why it is disabled by default. */
   openvdb::io::File file(file_path);
   file.setCopyMaxBytes(0);
   file.open(delay_load);
@@ -205,8 +218,10 @@ static LazyLoadedGrid load_single_grid_from_disk_cached(const StringRef file_pat
 
   std::shared_ptr<const GridReadValue> value = memory_cache::get<GridReadValue>(key, [&key]() {
     openvdb::GridBase::Ptr grid;
+    bool is_delay_loaded = false;
     if (key.simplify_level == 0) {
-      grid = load_single_grid_from_disk(key.file_path, key.grid_name);
+      is_delay_loaded = use_delay_load();
+      grid = load_single_grid_from_disk(key.file_path, key.grid_name, is_delay_loaded);
     }
     else {
       /* Build the simplified grid from the main grid. */
@@ -219,6 +234,7 @@ static LazyLoadedGrid load_single_grid_from_disk_cached(const StringRef file_pat
     }
     auto value = std::make_unique<GridReadValue>();
     value->grid = std::move(grid);
+    value->is_delay_loaded = is_delay_loaded;
     value->tree_sharing_info = OpenvdbTreeSharingInfo::make(value->grid->baseTreePtr());
     return value;
   });
@@ -26,6 +26,7 @@
 
 #  include "BLI_endian_defines.h"
 #  include "BLI_math_base.h"
+#  include "BLI_task.h"
 #  include "BLI_threads.h"
 #  include "BLI_utildefines.h"
 #  include "BLI_vector.hh"
@@ -49,6 +50,7 @@ extern "C" {
 #  include <libavutil/cpu.h>
 #  include <libavutil/imgutils.h>
 #  include <libavutil/opt.h>
+#  include <libavutil/pixdesc.h>
 #  include <libavutil/rational.h>
 #  include <libavutil/samplefmt.h>
 #  include <libswscale/swscale.h>
@@ -100,10 +102,22 @@ struct FFMpegContext {
   AVFrame *current_frame; /* Image frame in output pixel format. */
   int video_time;
 
-  /* Image frame in Blender's own pixel format, may need conversion to the output pixel format. */
-  AVFrame *img_convert_frame;
+  /* Converts appended frames to the output pixel format, null when it is Blender's own format. */
   SwsContext *img_convert_ctx;
 
+  /**
+   * Serial background pool which converts and encodes the appended frames and writes them to the
+   * output file, so that encoding overlaps with rendering the next frame. The output file and
+   * codecs are only accessed from this pool while frames are queued.
+   */
+  TaskPool *encode_pool;
+  /** Frames pushed to #encode_pool which are not encoded yet, up to #FFMPEG_ENCODE_QUEUE_SIZE. */
+  int encode_queue_size;
+  /** Set when encoding a queued frame failed, reported when the next frame is appended. */
+  bool encode_failed;
+  ThreadMutex encode_queue_mutex;
+  ThreadCondition encode_queue_cond;
+
   uint8_t *audio_input_buffer;
   uint8_t *audio_deinterleave_buffer;
   int audio_input_samples;
@@ -121,6 +135,9 @@ struct FFMpegContext {
 
 #  define FFMPEG_AUTOSPLIT_SIZE 2000000000
 
+/* Maximum number of rendered frames waiting to be encoded, every frame is kept in memory. */
+#  define FFMPEG_ENCODE_QUEUE_SIZE 4
+
 #  define PRINT \
     if (G.debug & G_DEBUG_FFMPEG) \
     printf
@@ -342,7 +359,8 @@ static const char **get_file_extensions(int format)
 /* Write a frame to the output file */
 static bool write_video_frame(FFMpegContext *context, AVFrame *frame, ReportList *reports)
 {
-  int ret, success = 1;
+  int ret;
+  bool success = true;
   AVPacket *packet = av_packet_alloc();
 
   AVCodecContext *c = context->video_codec;
@@ -356,7 +374,7 @@ static bool write_video_frame(FFMpegContext *context, AVFrame *frame, ReportList
     /* Can't send frame to encoder. This shouldn't happen. */
     av_make_error_string(error_str, AV_ERROR_MAX_STRING_SIZE, ret);
     fprintf(stderr, "Can't send video frame: %s\n", error_str);
-    success = -1;
+    success = false;
   }
 
   while (ret >= 0) {
@@ -379,7 +397,7 @@ static bool write_video_frame(FFMpegContext *context, AVFrame *frame, ReportList
 #  endif
 
     if (av_interleaved_write_frame(context->outfile, packet) != 0) {
-      success = -1;
+      success = false;
       break;
     }
   }
@@ -395,7 +413,7 @@ static bool write_video_frame(FFMpegContext *context, AVFrame *frame, ReportList
   return success;
 }
 
-/* read and encode a frame of video from the buffer */
+/* Copy the pixels of the image into a new frame in Blender's own pixel format. */
 static AVFrame *generate_video_frame(FFMpegContext *context, const ImBuf *image)
 {
   /* For now only 8-bit/channel images are supported. */
@@ -406,21 +424,11 @@ static AVFrame *generate_video_frame(FFMpegContext *context, const ImBuf *image)
 
   AVCodecParameters *codec = context->video_stream->codecpar;
   int height = codec->height;
-  AVFrame *rgb_frame;
-
-  if (context->img_convert_frame != nullptr) {
-    /* Pixel format conversion is needed. */
-    rgb_frame = context->img_convert_frame;
-  }
-  else {
-    /* The output pixel format is Blender's internal pixel format. */
-    rgb_frame = context->current_frame;
+  AVFrame *rgb_frame = alloc_picture(AV_PIX_FMT_RGBA, codec->width, codec->height);
+  if (rgb_frame == nullptr) {
+    return nullptr;
   }
 
-  /* Ensure frame is writable. Some video codecs might have made previous frame
-   * shared (i.e. not writable). */
-  av_frame_make_writable(rgb_frame);
-
   /* Copy the Blender pixels into the FFMPEG data-structure, taking care of endianness and flipping
    * the image vertically. */
   int linesize = rgb_frame->linesize[0];
@@ -448,14 +456,19 @@ static AVFrame *generate_video_frame(FFMpegContext *context, const ImBuf *image)
 #  endif
   }
 
-  /* Convert to the output pixel format, if it's different that Blender's internal one. */
-  if (context->img_convert_frame != nullptr) {
-    BLI_assert(context->img_convert_ctx != NULL);
-    /* Ensure the frame we are scaling to is writable as well. */
-    av_frame_make_writable(context->current_frame);
-    BKE_ffmpeg_sws_scale_frame(context->img_convert_ctx, context->current_frame, rgb_frame);
-  }
+  return rgb_frame;
+}
 
+/* Convert a frame from Blender's own pixel format to the output pixel format, if they differ. */
+static AVFrame *convert_video_frame(FFMpegContext *context, AVFrame *rgb_frame)
+{
+  if (context->img_convert_ctx == nullptr) {
+    return rgb_frame;
+  }
+  /* Ensure the frame we are scaling to is writable. Some video codecs might have made previous
+   * frame shared (i.e. not writable). */
+  av_frame_make_writable(context->current_frame);
+  BKE_ffmpeg_sws_scale_frame(context->img_convert_ctx, context->current_frame, rgb_frame);
   return context->current_frame;
 }
 
@@ -871,6 +884,65 @@ void BKE_ffmpeg_sws_scale_frame(SwsContext *ctx, AVFrame *dst, const AVFrame *sr
 
 /* prepare a video stream for the output file */
 
+/**
+ * Hardware H.264 encoders, in order of preference. All of them accept frames in system memory,
+ * VAAPI is not used because it only encodes frames which are uploaded to the device.
+ */
+static const char *hardware_h264_encoder_names[] = {
+    "h264_nvenc",
+    "h264_qsv",
+    "h264_videotoolbox",
+    "h264_amf",
+};
+
+/* First pixel format of the encoder which is not a hardware surface format. */
+static AVPixelFormat get_software_pix_fmt(const AVCodec *codec)
+{
+  if (codec->pix_fmts == nullptr) {
+    return AV_PIX_FMT_NONE;
+  }
+  for (const AVPixelFormat *pix_fmt = codec->pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if ((av_pix_fmt_desc_get(*pix_fmt)->flags & AV_PIX_FMT_FLAG_HWACCEL) == 0) {
+      return *pix_fmt;
+    }
+  }
+  return AV_PIX_FMT_NONE;
+}
+
+/**
+ * Find a hardware encoder for the codec which works on this system. Encoders are built into
+ * FFmpeg whether or not the device and driver exist, so every candidate is opened once with the
+ * output size to check that.
+ */
+static const AVCodec *get_hardware_encoder(AVCodecID codec_id, int rectx, int recty)
+{
+  if (codec_id != AV_CODEC_ID_H264) {
+    return nullptr;
+  }
+  for (const char *name : hardware_h264_encoder_names) {
+    const AVCodec *codec = avcodec_find_encoder_by_name(name);
+    if (codec == nullptr) {
+      continue;
+    }
+    const AVPixelFormat pix_fmt = get_software_pix_fmt(codec);
+    if (pix_fmt == AV_PIX_FMT_NONE) {
+      continue;
+    }
+    AVCodecContext *c = avcodec_alloc_context3(codec);
+    c->width = rectx;
+    c->height = recty;
+    c->time_base = av_make_q(1, 25);
+    c->pix_fmt = pix_fmt;
+    const bool is_available = avcodec_open2(c, codec, nullptr) >= 0;
+    avcodec_free_context(&c);
+    if (is_available) {
+      PRINT("Using hardware encoder %s\n", name);
+      return codec;
+    }
+  }
+  return nullptr;
+}
+
 static AVStream *alloc_video_stream(FFMpegContext *context,
                                     RenderData *rd,
                                     AVCodecID codec_id,
@@ -881,7 +953,7 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
                                     int error_size)
 {
   AVStream *st;
-  const AVCodec *codec;
+  const AVCodec *codec = nullptr;
   AVDictionary *opts = nullptr;
 
   error[0] = '\0';
@@ -900,13 +972,19 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
     codec = get_av1_encoder(context, rd, &opts, rectx, recty);
   }
   else {
-    codec = avcodec_find_encoder(codec_id);
+    if (rd->ffcodecdata.flags & FFMPEG_USE_HARDWARE_ENCODER) {
+      codec = get_hardware_encoder(codec_id, rectx, recty);
+    }
+    if (!codec) {
+      codec = avcodec_find_encoder(codec_id);
+    }
   }
   if (!codec) {
     fprintf(stderr, "Couldn't find valid video codec\n");
     context->video_codec = nullptr;
     return nullptr;
   }
+  const bool is_hardware_encoder = (codec->capabilities & AV_CODEC_CAP_HARDWARE) != 0;
 
   context->video_codec = avcodec_alloc_context3(codec);
   AVCodecContext *c = context->video_codec;
@@ -960,6 +1038,12 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
      * We don't care about bit rate in CRF mode. */
     c->bit_rate = 0;
     ffmpeg_dict_set_int(&opts, "crf", context->ffmpeg_crf);
+    if (is_hardware_encoder) {
+      /* Hardware encoders have no CRF, use their constant quality modes on the same scale:
+       * "cq" for NVENC, the global quality (ICQ) for Quick Sync. */
+      ffmpeg_dict_set_int(&opts, "cq", context->ffmpeg_crf);
+      c->global_quality = context->ffmpeg_crf;
+    }
   }
   else {
     c->bit_rate = context->ffmpeg_video_bitrate * 1000;
@@ -968,7 +1052,9 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
     c->rc_buffer_size = rd->ffcodecdata.rc_buffer_size * 1024;
   }
 
-  if (context->ffmpeg_preset) {
+  /* The presets of hardware encoders have different names, and an unknown name fails to open the
+   * encoder. Use their default presets. */
+  if (context->ffmpeg_preset && !is_hardware_encoder) {
     /* 'preset' is used by h.264, 'deadline' is used by WEBM/VP9. I'm not
      * setting those properties conditionally based on the video codec,
      * as the FFmpeg encoder simply ignores unknown settings anyway. */
@@ -1057,6 +1143,11 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
     }
   }
 
+  if (is_hardware_encoder) {
+    /* Hardware encoders only support a few formats, usually not 4:4:4 for lossless. */
+    c->pix_fmt = get_software_pix_fmt(codec);
+  }
+
   if (of->oformat->flags & AVFMT_GLOBALHEADER) {
     PRINT("Using global header\n");
     c->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
@@ -1101,12 +1192,10 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
 
   if (c->pix_fmt == AV_PIX_FMT_RGBA) {
     /* Output pixel format is the same we use internally, no conversion necessary. */
-    context->img_convert_frame = nullptr;
     context->img_convert_ctx = nullptr;
   }
   else {
-    /* Output pixel format is different, allocate frame for conversion. */
-    context->img_convert_frame = alloc_picture(AV_PIX_FMT_RGBA, c->width, c->height);
+    /* Output pixel format is different, frames are converted before encoding. */
     context->img_convert_ctx = BKE_ffmpeg_sws_get_context(
         c->width, c->height, AV_PIX_FMT_RGBA, c->pix_fmt, SWS_BICUBIC);
   }
@@ -1712,6 +1801,54 @@ static void write_audio_frames(FFMpegContext *context, double to_pts)
 }
 #  endif
 
+struct FFMpegEncodeTask {
+  /** Appended image in Blender's own pixel format. */
+  AVFrame *rgb_frame;
+  /** Audio is encoded up until this time, after the frame. */
+  double audio_to_pts;
+  ReportList *reports;
+};
+
+static void ffmpeg_encode_task_free(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  FFMpegEncodeTask *encode_task = static_cast<FFMpegEncodeTask *>(taskdata);
+  delete_picture(encode_task->rgb_frame);
+  MEM_freeN(encode_task);
+}
+
+static void ffmpeg_encode_task(TaskPool *__restrict pool, void *taskdata)
+{
+  FFMpegContext *context = static_cast<FFMpegContext *>(BLI_task_pool_user_data(pool));
+  FFMpegEncodeTask *encode_task = static_cast<FFMpegEncodeTask *>(taskdata);
+
+  AVFrame *avframe = convert_video_frame(context, encode_task->rgb_frame);
+  const bool success = write_video_frame(context, avframe, encode_task->reports);
+#  ifdef WITH_AUDASPACE
+  write_audio_frames(context, encode_task->audio_to_pts);
+#  endif
+
+  BLI_mutex_lock(&context->encode_queue_mutex);
+  context->encode_queue_size--;
+  context->encode_failed |= !success;
+  BLI_condition_notify_all(&context->encode_queue_cond);
+  BLI_mutex_unlock(&context->encode_queue_mutex);
+}
+
+/**
+ * Wait until no more than \a max_queue_size frames are waiting to be encoded, zero waits until
+ * all appended frames are written. Returns false when encoding any of the frames failed.
+ */
+static bool ffmpeg_encode_queue_wait(FFMpegContext *context, const int max_queue_size)
+{
+  BLI_mutex_lock(&context->encode_queue_mutex);
+  while (context->encode_queue_size > max_queue_size) {
+    BLI_condition_wait(&context->encode_queue_cond, &context->encode_queue_mutex);
+  }
+  const bool success = !context->encode_failed;
+  BLI_mutex_unlock(&context->encode_queue_mutex);
+  return success;
+}
+
 bool BKE_ffmpeg_append(void *context_v,
                        RenderData *rd,
                        int start_frame,
@@ -1721,23 +1858,37 @@ bool BKE_ffmpeg_append(void *context_v,
                        ReportList *reports)
 {
   FFMpegContext *context = static_cast<FFMpegContext *>(context_v);
-  AVFrame *avframe;
   bool success = true;
 
   PRINT("Writing frame %i, render width=%d, render height=%d\n", frame, image->x, image->y);
 
   if (context->video_stream) {
-    avframe = generate_video_frame(context, image);
-    success = (avframe && write_video_frame(context, avframe, reports));
-#  ifdef WITH_AUDASPACE
-    /* Add +1 frame because we want to encode audio up until the next video frame. */
-    write_audio_frames(
-        context, (frame - start_frame + 1) / (double(rd->frs_sec) / double(rd->frs_sec_base)));
-#  else
-    UNUSED_VARS(start_frame);
-#  endif
+    /* Keep the number of rendered frames in memory bounded when encoding is slower. */
+    success = ffmpeg_encode_queue_wait(context, FFMPEG_ENCODE_QUEUE_SIZE - 1);
+
+    AVFrame *rgb_frame = success ? generate_video_frame(context, image) : nullptr;
+    if (rgb_frame) {
+      FFMpegEncodeTask *encode_task = static_cast<FFMpegEncodeTask *>(
+          MEM_mallocN(sizeof(FFMpegEncodeTask), __func__));
+      encode_task->rgb_frame = rgb_frame;
+      /* Add +1 frame because we want to encode audio up until the next video frame. */
+      encode_task->audio_to_pts = (frame - start_frame + 1) /
+                                  (double(rd->frs_sec) / double(rd->frs_sec_base));
+      encode_task->reports = reports;
+
+      BLI_mutex_lock(&context->encode_queue_mutex);
+      context->encode_queue_size++;
+      BLI_mutex_unlock(&context->encode_queue_mutex);
+      BLI_task_pool_push(
+          context->encode_pool, ffmpeg_encode_task, encode_task, true, ffmpeg_encode_task_free);
+    }
+    else {
+      success = false;
+    }
 
     if (context->ffmpeg_autosplit) {
+      /* The file size is only known once all queued frames are written. */
+      success &= ffmpeg_encode_queue_wait(context, 0);
       if (avio_tell(context->outfile->pb) > FFMPEG_AUTOSPLIT_SIZE) {
         end_ffmpeg_impl(context, true);
         context->ffmpeg_autosplit_count++;
@@ -1754,6 +1905,10 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
 {
   PRINT("Closing FFMPEG...\n");
 
+  /* Write the queued frames before flushing the encoders. */
+  ffmpeg_encode_queue_wait(context, 0);
+  context->encode_failed = false;
+
 #  ifdef WITH_AUDASPACE
   if (is_autosplit == false) {
     if (context->audio_mixdown_device) {
@@ -1795,10 +1950,6 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
     delete_picture(context->current_frame);
     context->current_frame = nullptr;
   }
-  if (context->img_convert_frame != nullptr) {
-    delete_picture(context->img_convert_frame);
-    context->img_convert_frame = nullptr;
-  }
 
   if (context->outfile != nullptr && context->outfile->oformat) {
     if (!(context->outfile->oformat->flags & AVFMT_NOFILE)) {
@@ -1971,6 +2122,10 @@ void *BKE_ffmpeg_context_create()
   context->stamp_data = nullptr;
   context->audio_time_total = 0.0;
 
+  context->encode_pool = BLI_task_pool_create_background_serial(context, TASK_PRIORITY_HIGH);
+  BLI_mutex_init(&context->encode_queue_mutex);
+  BLI_condition_init(&context->encode_queue_cond);
+
   return context;
 }
 
@@ -1983,6 +2138,9 @@ void BKE_ffmpeg_context_free(void *context_v)
   if (context->stamp_data) {
     MEM_freeN(context->stamp_data);
   }
+  BLI_task_pool_free(context->encode_pool);
+  BLI_mutex_end(&context->encode_queue_mutex);
+  BLI_condition_end(&context->encode_queue_cond);
   MEM_freeN(context);
 }
 
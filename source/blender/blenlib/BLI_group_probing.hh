@@ -0,0 +1,314 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Shared probing loop for the open addressing hash tables (#Set, #Map and #VectorSet), and the
+ * #GroupProbingStrategy which matches many slots at once using SIMD.
+ *
+ * By default, the hash tables use probing strategies as described in `BLI_probing_strategies.hh`.
+ * The slots are inspected one after another and the key stored in every slot that is visited is
+ * compared to the searched key. This is fast when there are few collisions, but becomes slow when
+ * comparing keys is expensive (e.g. strings) or when the table contains many removed slots.
+ *
+ * When #GroupProbingStrategy is passed as probing strategy, the hash table additionally stores one
+ * control byte per slot (in the style of "Swiss tables"). The byte contains 7 bits of the hash of
+ * the key stored in the slot, or a marker for empty and removed slots. Slots are probed in groups
+ * of 16 and the control bytes of a group are compared with the searched hash in a few SIMD
+ * instructions. Only slots whose control byte matches (or that are empty) are inspected at all, so
+ * almost all unnecessary key comparisons and cache misses on the slot array are avoided.
+ *
+ * The additional memory is one byte per slot, which is typically small compared to the slots.
+ * Since the group index and the stored bits are derived from a remixed hash, this strategy also
+ * works well with weak hash functions like the identity hash used for integers.
+ */
+
+#include "BLI_array.hh"
+#include "BLI_math_bits.h"
+#include "BLI_probing_strategies.hh"
+#include "BLI_simd.hh"
+
+namespace blender {
+
+/**
+ * Probing strategy that makes hash tables store control bytes for all slots, which are matched
+ * in groups of 16 slots at a time. See the file description for more details.
+ *
+ * Unlike other probing strategies, this type is never instantiated, it only selects the
+ * #HashTableControl specialization below.
+ */
+struct GroupProbingStrategy {};
+
+/* -------------------------------------------------------------------- */
+/** \name Probing with Classic Probing Strategies
+ * \{ */
+
+/**
+ * Iterates over the slot indices returned by a probing strategy. Every step of the probing
+ * strategy results in a range of #ProbingStrategy::linear_steps candidate slots.
+ */
+template<typename ProbingStrategy> class SlotProber {
+ private:
+  ProbingStrategy strategy_;
+  uint64_t slot_mask_;
+
+ public:
+  class Candidates {
+   private:
+    uint64_t hash_;
+    uint64_t slot_mask_;
+    int64_t linear_offset_ = 0;
+    int64_t linear_steps_;
+
+   public:
+    Candidates(const uint64_t hash, const uint64_t slot_mask, const int64_t linear_steps)
+        : hash_(hash), slot_mask_(slot_mask), linear_steps_(linear_steps)
+    {
+    }
+
+    bool is_done() const
+    {
+      return linear_offset_ >= linear_steps_;
+    }
+
+    int64_t index() const
+    {
+      return int64_t((hash_ + uint64_t(linear_offset_)) & slot_mask_);
+    }
+
+    void next()
+    {
+      linear_offset_++;
+    }
+  };
+
+  SlotProber(const uint64_t hash, const uint64_t slot_mask)
+      : strategy_(hash), slot_mask_(slot_mask)
+  {
+  }
+
+  Candidates candidates() const
+  {
+    return {strategy_.get(), slot_mask_, strategy_.linear_steps()};
+  }
+
+  void next()
+  {
+    strategy_.next();
+  }
+};
+
+/**
+ * Hash tables always contain a control object. With classic probing strategies it is empty and
+ * all methods are no-ops, that are optimized away completely.
+ */
+template<typename ProbingStrategy, typename Allocator> class HashTableControl {
+ public:
+  HashTableControl(Allocator /*allocator*/ = {}) noexcept {}
+
+  void reinitialize(const int64_t /*slots_num*/) {}
+  void occupy(const int64_t /*slot_index*/, const uint64_t /*hash*/) {}
+  void remove(const int64_t /*slot_index*/) {}
+
+  SlotProber<ProbingStrategy> prober(const uint64_t hash, const uint64_t slot_mask) const
+  {
+    return {hash, slot_mask};
+  }
+
+  int64_t size_in_bytes() const
+  {
+    return 0;
+  }
+};
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Probing with Control Bytes
+ * \{ */
+
+namespace group_probing {
+
+/** Number of slots whose control bytes are matched at once. */
+constexpr int64_t group_size = 16;
+
+/** Control bytes of occupied slots are in the range [0, 127]. */
+constexpr uint8_t control_empty = 0x80;
+/** Also used for the padding bytes of tables with fewer slots than a group. */
+constexpr uint8_t control_removed = 0xFE;
+
+/** Remix the hash, so that also weak hash functions use many bits for the group and the tag. */
+inline uint64_t remix_hash(const uint64_t hash)
+{
+  return hash * uint64_t(0x9E3779B97F4A7C15);
+}
+
+inline uint8_t control_tag(const uint64_t mixed_hash)
+{
+  return uint8_t(mixed_hash >> 57);
+}
+
+/**
+ * \return A bit mask of the slots in the group whose control byte is the tag or empty.
+ */
+inline uint32_t match_candidates(const uint8_t *group, const uint8_t tag)
+{
+#if BLI_HAVE_SSE2
+  const __m128i control = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+  const __m128i tag_match = _mm_cmpeq_epi8(control, _mm_set1_epi8(char(tag)));
+  const __m128i empty_match = _mm_cmpeq_epi8(control, _mm_set1_epi8(char(control_empty)));
+  return uint32_t(_mm_movemask_epi8(_mm_or_si128(tag_match, empty_match)));
+#else
+  uint32_t mask = 0;
+  for (int i = 0; i < group_size; i++) {
+    mask |= uint32_t(ELEM(group[i], tag, control_empty)) << i;
+  }
+  return mask;
+#endif
+}
+
+}  // namespace group_probing
+
+/**
+ * Iterates over groups of slots. The candidates of a group are all slots whose control byte
+ * matches the hash or which are empty. Groups are visited with triangular probing, which reaches
+ * every group because the number of groups is a power of two.
+ */
+class GroupProber {
+ private:
+  const uint8_t *control_;
+  uint64_t group_mask_;
+  uint64_t group_index_;
+  uint64_t step_ = 0;
+  uint8_t tag_;
+
+ public:
+  class Candidates {
+   private:
+    int64_t group_start_;
+    uint32_t mask_;
+
+   public:
+    Candidates(const int64_t group_start, const uint32_t mask)
+        : group_start_(group_start), mask_(mask)
+    {
+    }
+
+    bool is_done() const
+    {
+      return mask_ == 0;
+    }
+
+    int64_t index() const
+    {
+      return group_start_ + int64_t(bitscan_forward_uint(mask_));
+    }
+
+    void next()
+    {
+      mask_ &= mask_ - 1;
+    }
+  };
+
+  GroupProber(const uint8_t *control, const uint64_t hash, const uint64_t slot_mask)
+      : control_(control)
+  {
+    const uint64_t mixed_hash = group_probing::remix_hash(hash);
+    tag_ = group_probing::control_tag(mixed_hash);
+    /* Tables with fewer slots than a group have a single, padded group. */
+    group_mask_ = slot_mask / uint64_t(group_probing::group_size);
+    group_index_ = mixed_hash & group_mask_;
+  }
+
+  Candidates candidates() const
+  {
+    const int64_t group_start = int64_t(group_index_) * group_probing::group_size;
+    return {group_start, group_probing::match_candidates(control_ + group_start, tag_)};
+  }
+
+  void next()
+  {
+    step_++;
+    group_index_ = (group_index_ + step_) & group_mask_;
+  }
+};
+
+template<typename Allocator> class HashTableControl<GroupProbingStrategy, Allocator> {
+ private:
+  Array<uint8_t, group_probing::group_size, Allocator> bytes_;
+
+ public:
+  HashTableControl(Allocator allocator = {}) noexcept : bytes_(allocator)
+  {
+    this->reinitialize(1);
+  }
+
+  /**
+   * Mark all slots as empty. There are always at least as many control bytes as in a group, the
+   * bytes that don't correspond to a slot never match.
+   */
+  void reinitialize(const int64_t slots_num)
+  {
+    bytes_.reinitialize(std::max(slots_num, group_probing::group_size));
+    bytes_.as_mutable_span().take_front(slots_num).fill(group_probing::control_empty);
+    bytes_.as_mutable_span().drop_front(slots_num).fill(group_probing::control_removed);
+  }
+
+  void occupy(const int64_t slot_index, const uint64_t hash)
+  {
+    bytes_[slot_index] = group_probing::control_tag(group_probing::remix_hash(hash));
+  }
+
+  void remove(const int64_t slot_index)
+  {
+    bytes_[slot_index] = group_probing::control_removed;
+  }
+
+  GroupProber prober(const uint64_t hash, const uint64_t slot_mask) const
+  {
+    return {bytes_.data(), hash, slot_mask};
+  }
+
+  int64_t size_in_bytes() const
+  {
+    return bytes_.size();
+  }
+};
+
+/** \} */
+
+/* Turning off clang format here, because otherwise it will mess up the alignment between the
+ * macros. */
+// clang-format off
+
+/**
+ * Both macros together form a loop that iterates over the candidate slot indices for a hash in a
+ * hash table with a power-of-two size. Which slots are candidates depends on the probing strategy
+ * of the #HashTableControl. Slots that are skipped are guaranteed to not contain the key and to
+ * not be empty.
+ *
+ * The same rules as for #SLOT_PROBING_BEGIN apply: only `return` out of the loop is permitted.
+ *
+ * CONTROL: The #HashTableControl of the hash table.
+ * HASH: The initial hash as produced by a hash function.
+ * MASK: A bit mask such that (hash & MASK) is a valid slot index.
+ * R_SLOT_INDEX: Name of the variable that will contain the slot index.
+ */
+#define HASH_TABLE_PROBING_BEGIN(CONTROL, HASH, MASK, R_SLOT_INDEX) \
+  auto slot_prober = (CONTROL).prober(HASH, MASK); \
+  do { \
+    for (auto candidates = slot_prober.candidates(); !candidates.is_done(); candidates.next()) { \
+      const int64_t R_SLOT_INDEX = candidates.index();
+
+#define HASH_TABLE_PROBING_END() \
+    } \
+    slot_prober.next(); \
+  } while (true)
+
+// clang-format on
+
+}  // namespace blender
@@ -221,6 +221,20 @@ int BLI_bvhtree_find_nearest(const BVHTree *tree,
                              BVHTree_NearestPointCallback callback,
                              void *userdata);
 
+/**
+ * Run #BLI_bvhtree_find_nearest_ex for each of the \a points_num points in \a co, in parallel.
+ * Each item of \a nearests must be initialized like for a single query.
+ *
+ * \note The \a callback is called from multiple threads.
+ */
+void BLI_bvhtree_find_nearest_batch(const BVHTree *tree,
+                                    const float (*co)[3],
+                                    int points_num,
+                                    BVHTreeNearest *nearests,
+                                    BVHTree_NearestPointCallback callback,
+                                    void *userdata,
+                                    int flag);
+
 /**
  * Find the first node nearby.
  * Favors speed over quality since it doesn't find the best target node.
@@ -247,6 +261,26 @@ int BLI_bvhtree_ray_cast(const BVHTree *tree,
                          BVHTree_RayCastCallback callback,
                          void *userdata);
 
+/**
+ * Cast \a rays_num rays with origins \a co and normalized directions \a dir, giving the same
+ * result as calling #BLI_bvhtree_ray_cast_ex with a zero radius for each of them. Rays are
+ * traversed in small packets that share the node box tests, so neighboring rays should be
+ * coherent (e.g. rays from nearby points or with similar directions). Packets are cast in
+ * parallel.
+ *
+ * \param hits: The hit of each ray, which must be initialized like for a single ray cast
+ * (typically with index -1 and the maximum distance).
+ * \note The \a callback is called from multiple threads.
+ */
+void BLI_bvhtree_ray_cast_batch(const BVHTree *tree,
+                                const float (*co)[3],
+                                const float (*dir)[3],
+                                int rays_num,
+                                BVHTreeRayHit *hits,
+                                BVHTree_RayCastCallback callback,
+                                void *userdata,
+                                int flag);
+
 /**
  * Calls the callback for every ray intersection
  *
@@ -39,6 +39,22 @@ int BLI_kdtree_nd_(find_nearest)(const KDTree *tree,
                                  const float co[KD_DIMS],
                                  KDTreeNearest *r_nearest) ATTR_NONNULL(1, 2);
 
+/**
+ * Find the nearest node for each of the \a co_len points in \a co, which is faster than calling
+ * #BLI_kdtree_nd_(find_nearest) for each point when there are many queries: the queries are sorted
+ * spatially and searched in parallel.
+ *
+ * \param r_index: Receives the index of the nearest node for each query, -1 for an empty tree.
+ * \param r_dist: Optionally receives the distance to the nearest node for each query.
+ *
+ * \note When several nodes are equally near, the one with the lowest index is used.
+ */
+void BLI_kdtree_nd_(find_nearest_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        uint co_len,
+                                        int *r_index,
+                                        float *r_dist) ATTR_NONNULL(1, 4);
+
 int BLI_kdtree_nd_(find_nearest_n)(const KDTree *tree,
                                    const float co[KD_DIMS],
                                    KDTreeNearest *r_nearest,
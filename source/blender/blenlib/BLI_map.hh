@@ -55,6 +55,7 @@
 #include <optional>
 
 #include "BLI_array.hh"
+#include "BLI_group_probing.hh"
 #include "BLI_hash.hh"
 #include "BLI_hash_tables.hh"
 #include "BLI_map_slots.hh"
@@ -102,6 +103,8 @@ template<
     int64_t InlineBufferCapacity = default_inline_buffer_capacity(sizeof(Key) + sizeof(Value)),
     /**
      * The strategy used to deal with collisions. They are defined in BLI_probing_strategies.hh.
+     * #GroupProbingStrategy (see BLI_group_probing.hh) can be used to store additional control
+     * bytes that are matched with SIMD instructions.
      */
     typename ProbingStrategy = DefaultProbingStrategy,
     /**
@@ -171,11 +174,15 @@ class Map {
    */
   SlotArray slots_;
 
+  /** Control bytes of all slots, this is empty unless #GroupProbingStrategy is used. */
+  using Control = HashTableControl<ProbingStrategy, Allocator>;
+  BLI_NO_UNIQUE_ADDRESS Control control_;
+
   /** Iterate over a slot index sequence for a given hash. */
 #define MAP_SLOT_PROBING_BEGIN(HASH, R_SLOT) \
-  SLOT_PROBING_BEGIN (ProbingStrategy, HASH, slot_mask_, SLOT_INDEX) \
+  HASH_TABLE_PROBING_BEGIN (control_, HASH, slot_mask_, SLOT_INDEX) \
     auto &R_SLOT = slots_[SLOT_INDEX];
-#define MAP_SLOT_PROBING_END() SLOT_PROBING_END()
+#define MAP_SLOT_PROBING_END() HASH_TABLE_PROBING_END()
 
  public:
   /**
@@ -190,7 +197,8 @@ class Map {
         slot_mask_(0),
         hash_(),
         is_equal_(),
-        slots_(1, allocator)
+        slots_(1, allocator),
+        control_(allocator)
   {
   }
 
@@ -215,6 +223,7 @@ class Map {
         throw;
       }
     }
+    control_ = std::move(other.control_);
     removed_slots_ = other.removed_slots_;
     occupied_and_removed_slots_ = other.occupied_and_removed_slots_;
     usable_slots_ = other.usable_slots_;
@@ -352,6 +361,7 @@ class Map {
       return false;
     }
     slot->remove();
+    control_.remove(slot - slots_.data());
     removed_slots_++;
     return true;
   }
@@ -368,6 +378,7 @@ class Map {
   {
     Slot &slot = this->lookup_slot(key, hash_(key));
     slot.remove();
+    control_.remove(&slot - slots_.data());
     removed_slots_++;
   }
 
@@ -384,6 +395,7 @@ class Map {
     Slot &slot = this->lookup_slot(key, hash_(key));
     Value value = std::move(*slot.value());
     slot.remove();
+    control_.remove(&slot - slots_.data());
     removed_slots_++;
     return value;
   }
@@ -404,6 +416,7 @@ class Map {
     }
     std::optional<Value> value = std::move(*slot->value());
     slot->remove();
+    control_.remove(slot - slots_.data());
     removed_slots_++;
     return value;
   }
@@ -429,6 +442,7 @@ class Map {
     }
     Value value = std::move(*slot->value());
     slot->remove();
+    control_.remove(slot - slots_.data());
     removed_slots_++;
     return value;
   }
@@ -887,6 +901,7 @@ class Map {
     Slot &slot = iterator.current_slot();
     BLI_assert(slot.is_occupied());
     slot.remove();
+    control_.remove(&slot - slots_.data());
     removed_slots_++;
   }
 
@@ -905,6 +920,7 @@ class Map {
         Value &value = *slot.value();
         if (predicate(MutableItem{key, value})) {
           slot.remove();
+          control_.remove(&slot - slots_.data());
           removed_slots_++;
         }
       }
@@ -969,7 +985,7 @@ class Map {
    */
   int64_t size_in_bytes() const
   {
-    return int64_t(sizeof(Slot) * slots_.size());
+    return int64_t(sizeof(Slot) * slots_.size()) + control_.size_in_bytes();
   }
 
   /**
@@ -992,6 +1008,7 @@ class Map {
       slot.~Slot();
       new (&slot) Slot();
     }
+    control_.reinitialize(slots_.size());
 
     removed_slots_ = 0;
     occupied_and_removed_slots_ = 0;
@@ -1057,6 +1074,7 @@ class Map {
     if (this->size() == 0) {
       try {
         slots_.reinitialize(total_slots);
+        control_.reinitialize(total_slots);
       }
       catch (...) {
         this->noexcept_reset();
@@ -1072,13 +1090,16 @@ class Map {
     SlotArray new_slots(total_slots);
 
     try {
+      Control new_control(slots_.allocator());
+      new_control.reinitialize(total_slots);
       for (Slot &slot : slots_) {
         if (slot.is_occupied()) {
-          this->add_after_grow(slot, new_slots, new_slot_mask);
+          this->add_after_grow(slot, new_slots, new_control, new_slot_mask);
           slot.remove();
         }
       }
       slots_ = std::move(new_slots);
+      control_ = std::move(new_control);
     }
     catch (...) {
       this->noexcept_reset();
@@ -1091,17 +1112,21 @@ class Map {
     slot_mask_ = new_slot_mask;
   }
 
-  void add_after_grow(Slot &old_slot, SlotArray &new_slots, uint64_t new_slot_mask)
+  void add_after_grow(Slot &old_slot,
+                      SlotArray &new_slots,
+                      Control &new_control,
+                      uint64_t new_slot_mask)
   {
     uint64_t hash = old_slot.get_hash(Hash());
-    SLOT_PROBING_BEGIN (ProbingStrategy, hash, new_slot_mask, slot_index) {
+    HASH_TABLE_PROBING_BEGIN (new_control, hash, new_slot_mask, slot_index) {
       Slot &slot = new_slots[slot_index];
       if (slot.is_empty()) {
         slot.occupy(std::move(*old_slot.key()), hash, std::move(*old_slot.value()));
+        new_control.occupy(slot_index, hash);
         return;
       }
     }
-    SLOT_PROBING_END();
+    HASH_TABLE_PROBING_END();
   }
 
   void noexcept_reset() noexcept
@@ -1121,6 +1146,7 @@ class Map {
     MAP_SLOT_PROBING_BEGIN (hash, slot) {
       if (slot.is_empty()) {
         slot.occupy(std::forward<ForwardKey>(key), hash, std::forward<ForwardValue>(value)...);
+        control_.occupy(SLOT_INDEX, hash);
         BLI_assert(hash_(*slot.key()) == hash);
         occupied_and_removed_slots_++;
         return;
@@ -1137,6 +1163,7 @@ class Map {
     MAP_SLOT_PROBING_BEGIN (hash, slot) {
       if (slot.is_empty()) {
         slot.occupy(std::forward<ForwardKey>(key), hash, std::forward<ForwardValue>(value)...);
+        control_.occupy(SLOT_INDEX, hash);
         BLI_assert(hash_(*slot.key()) == hash);
         occupied_and_removed_slots_++;
         return true;
@@ -1167,12 +1194,14 @@ class Map {
         if constexpr (std::is_void_v<CreateReturnT>) {
           create_value(value_ptr);
           slot.occupy_no_value(std::forward<ForwardKey>(key), hash);
+          control_.occupy(SLOT_INDEX, hash);
           occupied_and_removed_slots_++;
           return;
         }
         else {
           auto &&return_value = create_value(value_ptr);
           slot.occupy_no_value(std::forward<ForwardKey>(key), hash);
+          control_.occupy(SLOT_INDEX, hash);
           occupied_and_removed_slots_++;
           return return_value;
         }
@@ -1193,6 +1222,7 @@ class Map {
     MAP_SLOT_PROBING_BEGIN (hash, slot) {
       if (slot.is_empty()) {
         slot.occupy(std::forward<ForwardKey>(key), hash, create_value());
+        control_.occupy(SLOT_INDEX, hash);
         BLI_assert(hash_(*slot.key()) == hash);
         occupied_and_removed_slots_++;
         return *slot.value();
@@ -1212,6 +1242,7 @@ class Map {
     MAP_SLOT_PROBING_BEGIN (hash, slot) {
       if (slot.is_empty()) {
         slot.occupy(std::forward<ForwardKey>(key), hash, std::forward<ForwardValue>(value)...);
+        control_.occupy(SLOT_INDEX, hash);
         BLI_assert(hash_(*slot.key()) == hash);
         occupied_and_removed_slots_++;
         return *slot.value();
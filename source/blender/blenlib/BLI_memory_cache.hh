@@ -4,9 +4,14 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "BLI_function_ref.hh"
 #include "BLI_generic_key.hh"
 #include "BLI_memory_counter_fwd.hh"
+#include "BLI_span.hh"
+#include "BLI_string_ref.hh"
+#include "BLI_vector.hh"
 
 namespace blender::memory_cache {
 
@@ -23,13 +28,31 @@ class CachedValue {
    * full.
    */
   virtual void count_memory(MemoryCounter &memory) const = 0;
+
+  /**
+   * Write the value into a buffer, so that it can be moved to the disk cache instead of being
+   * freed when the cache is full (see #set_disk_cache_directory). Types that support this also
+   * have to implement a static `std::unique_ptr<T> deserialize(Span<std::byte> data)` function
+   * which restores the value from the buffer.
+   *
+   * \return False if the value can't be serialized, it is just freed then.
+   */
+  virtual bool serialize(Vector<std::byte> & /*r_data*/) const
+  {
+    return false;
+  }
 };
 
+/** Restores a value written by #CachedValue::serialize. Returns null on failure. */
+using DeserializeFn = std::unique_ptr<CachedValue> (*)(Span<std::byte> data);
+
 /**
  * Returns the value that corresponds to the given key. If it's not cached yet, #compute_fn is
  * called and its result is cached for the next time.
  *
- * If the cache is full, older values may be freed.
+ * If the cache is full, older values may be freed. When the disk cache is enabled and the type
+ * supports serialization, they are moved to disk instead and are restored from there by the next
+ * call to this function.
  */
 template<typename T>
 std::shared_ptr<const T> get(const GenericKey &key, FunctionRef<std::unique_ptr<T>()> compute_fn);
@@ -38,7 +61,8 @@ std::shared_ptr<const T> get(const GenericKey &key, FunctionRef<std::unique_ptr<
  * A non-templated version of the main entry point above.
  */
 std::shared_ptr<CachedValue> get_base(const GenericKey &key,
-                                      FunctionRef<std::unique_ptr<CachedValue>()> compute_fn);
+                                      FunctionRef<std::unique_ptr<CachedValue>()> compute_fn,
+                                      DeserializeFn deserialize_fn = nullptr);
 
 /**
  * Set how much memory the cache is allowed to use. This is only an approximation because counting
@@ -46,6 +70,39 @@ std::shared_ptr<CachedValue> get_base(const GenericKey &key,
  */
 void set_approximate_size_limit(int64_t limit_in_bytes);
 
+/**
+ * Enable the disk cache, which stores compressed values that are freed from memory in the given
+ * directory. Values stored in a previous directory are removed. An empty directory disables the
+ * disk cache.
+ *
+ * The values on disk are only valid for the current session, they are removed again on exit.
+ */
+void set_disk_cache_directory(StringRefNull directory);
+
+/**
+ * Set how much disk space the disk cache is allowed to use. Least recently used values are
+ * removed when it is exceeded.
+ */
+void set_disk_cache_size_limit(int64_t limit_in_bytes);
+
+struct Statistics {
+  /** Number of lookups that found the value in memory. */
+  int64_t memory_hits = 0;
+  /** Number of lookups that restored the value from disk. */
+  int64_t disk_hits = 0;
+  /** Number of lookups that had to compute the value. */
+  int64_t misses = 0;
+  /** Number of values that were written to disk. */
+  int64_t disk_writes = 0;
+  int64_t memory_size_in_bytes = 0;
+  int64_t disk_size_in_bytes = 0;
+};
+
+/**
+ * Get the usage statistics of the cache since the start of the session.
+ */
+Statistics get_statistics();
+
 /**
  * Remove all elements from the cache. Note that this does not guarantee that no elements are in
  * the cache after the function returned. This is because another thread may have added a new
@@ -57,11 +114,26 @@ void clear();
 /** \name Inline Functions
  * \{ */
 
+namespace detail {
+template<typename T, typename = void> struct is_deserializable : std::false_type {};
+template<typename T>
+struct is_deserializable<T, std::void_t<decltype(T::deserialize(std::declval<Span<std::byte>>()))>>
+    : std::true_type {};
+}  // namespace detail
+
 template<typename T>
 inline std::shared_ptr<const T> get(const GenericKey &key,
                                     FunctionRef<std::unique_ptr<T>()> compute_fn)
 {
-  return std::dynamic_pointer_cast<const T>(get_base(key, compute_fn));
+  if constexpr (detail::is_deserializable<T>::value) {
+    return std::dynamic_pointer_cast<const T>(
+        get_base(key, compute_fn, [](const Span<std::byte> data) -> std::unique_ptr<CachedValue> {
+          return T::deserialize(data);
+        }));
+  }
+  else {
+    return std::dynamic_pointer_cast<const T>(get_base(key, compute_fn));
+  }
 }
 
 /** \} */
@@ -93,6 +93,15 @@ enum {
    * order of allocation when no chunks have been freed.
    */
   BLI_MEMPOOL_ALLOW_ITER = (1 << 0),
+  /**
+   * Allow allocating and freeing elements from multiple threads at once.
+   *
+   * #BLI_mempool_alloc and #BLI_mempool_free lock the pool, threaded code that creates or frees
+   * many elements should use a #BLI_mempool_thread_cache for each thread instead.
+   *
+   * \note Other functions (iteration, clearing, ...) are still not thread-safe.
+   */
+  BLI_MEMPOOL_ALLOW_THREADS = (1 << 1),
 };
 
 /**
@@ -104,6 +113,40 @@ void BLI_mempool_iternew(BLI_mempool *pool, BLI_mempool_iter *iter) ATTR_NONNULL
  */
 void *BLI_mempool_iterstep(BLI_mempool_iter *iter) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL();
 
+/**
+ * Thread cache, a list of free elements owned by a single thread.
+ *
+ * Elements are taken from and returned to the pool in batches, so allocating and freeing through
+ * the cache doesn't need any locking most of the time. Elements can be freed through another cache
+ * (or #BLI_mempool_free) than the one they were allocated from, they always return to the pool
+ * that owns them.
+ *
+ * Free elements held by caches count as used in #BLI_mempool_len. All caches must be
+ * destroyed before the pool is iterated, cleared or destroyed.
+ */
+typedef struct BLI_mempool_thread_cache BLI_mempool_thread_cache;
+
+/**
+ * Create a cache for use by a single thread, #BLI_MEMPOOL_ALLOW_THREADS flag must be set.
+ */
+BLI_mempool_thread_cache *BLI_mempool_thread_cache_create(BLI_mempool *pool)
+    ATTR_WARN_UNUSED_RESULT ATTR_RETURNS_NONNULL ATTR_NONNULL(1);
+void *BLI_mempool_thread_cache_alloc(BLI_mempool_thread_cache *cache)
+    ATTR_MALLOC ATTR_WARN_UNUSED_RESULT ATTR_RETURNS_NONNULL ATTR_NONNULL(1);
+void *BLI_mempool_thread_cache_calloc(BLI_mempool_thread_cache *cache)
+    ATTR_MALLOC ATTR_WARN_UNUSED_RESULT ATTR_RETURNS_NONNULL ATTR_NONNULL(1);
+/**
+ * Free an element of the cache's pool, the element may have been allocated from any thread.
+ *
+ * \note doesn't protect against double frees, take care!
+ */
+void BLI_mempool_thread_cache_free(BLI_mempool_thread_cache *cache, void *addr)
+    ATTR_NONNULL(1, 2);
+/**
+ * Return all free elements of the cache to its pool and free the cache itself.
+ */
+void BLI_mempool_thread_cache_destroy(BLI_mempool_thread_cache *cache) ATTR_NONNULL(1);
+
 #ifdef __cplusplus
 }
 #endif
@@ -35,6 +35,12 @@ bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length
 void *BLI_mmap_get_pointer(BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT;
 size_t BLI_mmap_get_length(const BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT;
 
+/* Adds a user to the mapping, which is only unmapped once #BLI_mmap_free has been called for
+ * every user. This allows referencing the mapped memory directly after reading is done.
+ * Note that on Linux and macOS the memory is mapped copy-on-write, modifying it does not change
+ * the file. */
+void BLI_mmap_add_user(BLI_mmap_file *file) ATTR_NONNULL(1);
+
 void BLI_mmap_free(BLI_mmap_file *file) ATTR_NONNULL(1);
 
 #ifdef __cplusplus
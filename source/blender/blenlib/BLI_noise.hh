@@ -5,6 +5,7 @@
 #pragma once
 
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 namespace blender::noise {
 
@@ -133,6 +134,47 @@ float3 perlin_float3_fractal_distorted(float4 position,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Batched Perlin Noise
+ *
+ * Evaluate the noise functions above for many 3D positions with the same parameters. The results
+ * are identical to calling the single position functions for every position, but multiple
+ * positions are evaluated at once using SIMD instructions when they are available.
+ * \{ */
+
+void perlin_signed(Span<float3> positions, MutableSpan<float> r_values);
+
+void perlin_fbm(Span<float3> positions,
+                float detail,
+                float roughness,
+                float lacunarity,
+                bool normalize,
+                MutableSpan<float> r_values);
+
+void perlin_fractal_distorted(Span<float3> positions,
+                              float detail,
+                              float roughness,
+                              float lacunarity,
+                              float offset,
+                              float gain,
+                              float distortion,
+                              int type,
+                              bool normalize,
+                              MutableSpan<float> r_values);
+
+void perlin_float3_fractal_distorted(Span<float3> positions,
+                                     float detail,
+                                     float roughness,
+                                     float lacunarity,
+                                     float offset,
+                                     float gain,
+                                     float distortion,
+                                     int type,
+                                     bool normalize,
+                                     MutableSpan<float3> r_values);
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Voronoi Noise
  * \{ */
@@ -29,6 +29,8 @@
  *
  * The SLOT_PROBING_BEGIN and SLOT_PROBING_END macros can be used to implement a loop that iterates
  * over a probing sequence.
+ * The hash tables in Blender use the HASH_TABLE_PROBING_BEGIN and HASH_TABLE_PROBING_END macros
+ * from BLI_group_probing.hh instead, which also support the #GroupProbingStrategy.
  *
  * Probing strategies can be evaluated with many different criteria. Different use cases often
  * have different optimal strategies. Examples:
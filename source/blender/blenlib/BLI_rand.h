@@ -75,9 +75,8 @@ void BLI_rng_shuffle_array(struct RNG *rng,
 void BLI_rng_shuffle_bitmap(struct RNG *rng, unsigned int *bitmap, unsigned int bits_num)
     ATTR_NONNULL(1, 2);
 
-/** Note that skipping is as slow as generating n numbers! */
 /**
- * Simulate getting \a n random values.
+ * Simulate getting \a n random values, the state after \a n values is computed directly.
  *
  * \note Useful when threaded code needs consistent values, independent of task division.
  */
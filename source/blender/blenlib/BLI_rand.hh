@@ -131,22 +131,36 @@ class RandomNumberGenerator {
   void get_bytes(MutableSpan<char> r_bytes);
 
   /**
-   * Simulate getting \a n random values.
+   * Simulate getting \a n random values. The state after \a n steps is computed directly with
+   * O(log(n)) operations, so skipping to any position in a sequence is cheap.
    */
   void skip(int64_t n)
   {
-    while (n--) {
-      this->step();
+    /* Steps are the affine transform `x -> multiplier * x + addend`, apply the transform composed
+     * \a n times by squaring. Arithmetic with unsigned overflow is modulo 2^64, the mask on the
+     * result gives the same value as masking every step. */
+    uint64_t n_multiplier = 1;
+    uint64_t n_addend = 0;
+    uint64_t step_multiplier = multiplier;
+    uint64_t step_addend = addend;
+    for (; n > 0; n >>= 1) {
+      if (n & 1) {
+        n_multiplier *= step_multiplier;
+        n_addend = n_addend * step_multiplier + step_addend;
+      }
+      step_addend *= step_multiplier + 1;
+      step_multiplier *= step_multiplier;
     }
+    x_ = (n_multiplier * x_ + n_addend) & mask;
   }
 
  private:
+  static constexpr uint64_t multiplier = 0x5DEECE66Dll;
+  static constexpr uint64_t addend = 0xB;
+  static constexpr uint64_t mask = 0x0000FFFFFFFFFFFFll;
+
   void step()
   {
-    constexpr uint64_t multiplier = 0x5DEECE66Dll;
-    constexpr uint64_t addend = 0xB;
-    constexpr uint64_t mask = 0x0000FFFFFFFFFFFFll;
-
     x_ = (multiplier * x_ + addend) & mask;
   }
 };
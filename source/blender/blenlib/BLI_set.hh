@@ -56,6 +56,7 @@
  */
 
 #include "BLI_array.hh"
+#include "BLI_group_probing.hh"
 #include "BLI_hash.hh"
 #include "BLI_hash_tables.hh"
 #include "BLI_probing_strategies.hh"
@@ -77,6 +78,8 @@ template<
     int64_t InlineBufferCapacity = default_inline_buffer_capacity(sizeof(Key)),
     /**
      * The strategy used to deal with collisions. They are defined in BLI_probing_strategies.hh.
+     * #GroupProbingStrategy (see BLI_group_probing.hh) can be used to store additional control
+     * bytes that are matched with SIMD instructions.
      */
     typename ProbingStrategy = DefaultProbingStrategy,
     /**
@@ -153,11 +156,15 @@ class Set {
    */
   SlotArray slots_;
 
+  /** Control bytes of all slots, this is empty unless #GroupProbingStrategy is used. */
+  using Control = HashTableControl<ProbingStrategy, Allocator>;
+  BLI_NO_UNIQUE_ADDRESS Control control_;
+
   /** Iterate over a slot index sequence for a given hash. */
 #define SET_SLOT_PROBING_BEGIN(HASH, R_SLOT) \
-  SLOT_PROBING_BEGIN (ProbingStrategy, HASH, slot_mask_, SLOT_INDEX) \
+  HASH_TABLE_PROBING_BEGIN (control_, HASH, slot_mask_, SLOT_INDEX) \
     auto &R_SLOT = slots_[SLOT_INDEX];
-#define SET_SLOT_PROBING_END() SLOT_PROBING_END()
+#define SET_SLOT_PROBING_END() HASH_TABLE_PROBING_END()
 
  public:
   /**
@@ -170,7 +177,8 @@ class Set {
         occupied_and_removed_slots_(0),
         usable_slots_(0),
         slot_mask_(0),
-        slots_(1, allocator)
+        slots_(1, allocator),
+        control_(allocator)
   {
   }
 
@@ -206,6 +214,7 @@ class Set {
         throw;
       }
     }
+    control_ = std::move(other.control_);
     removed_slots_ = other.removed_slots_;
     occupied_and_removed_slots_ = other.occupied_and_removed_slots_;
     usable_slots_ = other.usable_slots_;
@@ -484,6 +493,7 @@ class Set {
     Slot &slot = const_cast<Slot &>(it.current_slot());
     BLI_assert(slot.is_occupied());
     slot.remove();
+    control_.remove(&slot - slots_.data());
     removed_slots_++;
   }
 
@@ -501,6 +511,7 @@ class Set {
         const Key &key = *slot.key();
         if (predicate(key)) {
           slot.remove();
+          control_.remove(&slot - slots_.data());
           removed_slots_++;
         }
       }
@@ -535,6 +546,7 @@ class Set {
       slot.~Slot();
       new (&slot) Slot();
     }
+    control_.reinitialize(slots_.size());
 
     removed_slots_ = 0;
     occupied_and_removed_slots_ = 0;
@@ -604,7 +616,7 @@ class Set {
    */
   int64_t size_in_bytes() const
   {
-    return sizeof(Slot) * slots_.size();
+    return sizeof(Slot) * slots_.size() + control_.size_in_bytes();
   }
 
   /**
@@ -677,6 +689,7 @@ class Set {
     if (this->size() == 0) {
       try {
         slots_.reinitialize(total_slots);
+        control_.reinitialize(total_slots);
       }
       catch (...) {
         this->noexcept_reset();
@@ -693,13 +706,16 @@ class Set {
     SlotArray new_slots(total_slots);
 
     try {
+      Control new_control(slots_.allocator());
+      new_control.reinitialize(total_slots);
       for (Slot &slot : slots_) {
         if (slot.is_occupied()) {
-          this->add_after_grow(slot, new_slots, new_slot_mask);
+          this->add_after_grow(slot, new_slots, new_control, new_slot_mask);
           slot.remove();
         }
       }
       slots_ = std::move(new_slots);
+      control_ = std::move(new_control);
     }
     catch (...) {
       this->noexcept_reset();
@@ -712,18 +728,22 @@ class Set {
     slot_mask_ = new_slot_mask;
   }
 
-  void add_after_grow(Slot &old_slot, SlotArray &new_slots, const uint64_t new_slot_mask)
+  void add_after_grow(Slot &old_slot,
+                      SlotArray &new_slots,
+                      Control &new_control,
+                      const uint64_t new_slot_mask)
   {
     const uint64_t hash = old_slot.get_hash(Hash());
 
-    SLOT_PROBING_BEGIN (ProbingStrategy, hash, new_slot_mask, slot_index) {
+    HASH_TABLE_PROBING_BEGIN (new_control, hash, new_slot_mask, slot_index) {
       Slot &slot = new_slots[slot_index];
       if (slot.is_empty()) {
         slot.occupy(std::move(*old_slot.key()), hash);
+        new_control.occupy(slot_index, hash);
         return;
       }
     }
-    SLOT_PROBING_END();
+    HASH_TABLE_PROBING_END();
   }
 
   /**
@@ -787,6 +807,7 @@ class Set {
     SET_SLOT_PROBING_BEGIN (hash, slot) {
       if (slot.is_empty()) {
         slot.occupy(std::forward<ForwardKey>(key), hash);
+        control_.occupy(SLOT_INDEX, hash);
         BLI_assert(hash_(*slot.key()) == hash);
         occupied_and_removed_slots_++;
         return;
@@ -802,6 +823,7 @@ class Set {
     SET_SLOT_PROBING_BEGIN (hash, slot) {
       if (slot.is_empty()) {
         slot.occupy(std::forward<ForwardKey>(key), hash);
+        control_.occupy(SLOT_INDEX, hash);
         BLI_assert(hash_(*slot.key()) == hash);
         occupied_and_removed_slots_++;
         return true;
@@ -818,6 +840,7 @@ class Set {
     SET_SLOT_PROBING_BEGIN (hash, slot) {
       if (slot.contains(key, is_equal_, hash)) {
         slot.remove();
+        control_.remove(SLOT_INDEX);
         removed_slots_++;
         return true;
       }
@@ -836,6 +859,7 @@ class Set {
     SET_SLOT_PROBING_BEGIN (hash, slot) {
       if (slot.contains(key, is_equal_, hash)) {
         slot.remove();
+        control_.remove(SLOT_INDEX);
         removed_slots_++;
         return;
       }
@@ -854,6 +878,7 @@ class Set {
       }
       if (slot.is_empty()) {
         slot.occupy(std::forward<ForwardKey>(key), hash);
+        control_.occupy(SLOT_INDEX, hash);
         BLI_assert(hash_(*slot.key()) == hash);
         occupied_and_removed_slots_++;
         return *slot.key();
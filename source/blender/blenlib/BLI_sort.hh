@@ -14,6 +14,8 @@
 #  include <algorithm>
 #endif
 
+#include "BLI_span.hh"
+
 namespace blender {
 
 #ifdef WITH_TBB
@@ -31,4 +33,28 @@ void parallel_sort(RandomAccessIterator begin, RandomAccessIterator end, const C
 }
 #endif
 
+/**
+ * Reorder the indices so that the keys they refer to (`keys[r_indices[i]]`) are in ascending
+ * order. This is a parallel LSD radix sort, so the run time is linear in the number of indices and
+ * usually limited by memory bandwidth, unlike comparison based sorting. All indices have to be
+ * valid indices into the keys, but they don't have to cover all of them.
+ *
+ * The sort is stable: indices with equal keys keep their relative order. This allows sorting by
+ * multiple keys by sorting by the least significant key first:
+ * \code{.cc}
+ * array_utils::fill_index_range<int>(indices);
+ * parallel_radix_sort_indices(secondary_keys, indices);
+ * parallel_radix_sort_indices(primary_keys, indices);
+ * \endcode
+ *
+ * Floating point keys are ordered like with `operator<`, where negative and positive zero are
+ * equal. NaN values are sorted before or after all other values depending on their sign bit.
+ */
+void parallel_radix_sort_indices(Span<int32_t> keys, MutableSpan<int> r_indices);
+void parallel_radix_sort_indices(Span<uint32_t> keys, MutableSpan<int> r_indices);
+void parallel_radix_sort_indices(Span<int64_t> keys, MutableSpan<int> r_indices);
+void parallel_radix_sort_indices(Span<uint64_t> keys, MutableSpan<int> r_indices);
+void parallel_radix_sort_indices(Span<float> keys, MutableSpan<int> r_indices);
+void parallel_radix_sort_indices(Span<double> keys, MutableSpan<int> r_indices);
+
 }  // namespace blender
@@ -0,0 +1,126 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Opt-in tracing of the work done by the task system (#threading::parallel_for chunks and
+ * #TaskPool tasks). When enabled, the begin and end time as well as the executing thread of every
+ * task is recorded, together with a label supplied by the code that scheduled the work. The result
+ * can be exported in the Chrome trace event format, which can be inspected with
+ * `chrome://tracing` or https://ui.perfetto.dev.
+ *
+ * Events are recorded into per-thread buffers without any locking. Starting and stopping a trace
+ * must happen while no tasks are running, e.g. from the main thread between operators.
+ */
+
+#include <atomic>
+#include <string>
+
+#include "BLI_utildefines.h"
+
+namespace blender::threading::trace {
+
+namespace detail {
+extern std::atomic<bool> is_enabled;
+extern thread_local const char *current_label;
+
+void event_begin(int64_t *r_begin);
+void event_end(const char *label, const char *category, int64_t begin, int64_t size);
+}  // namespace detail
+
+/** Check whether a trace is currently being recorded. */
+inline bool is_enabled()
+{
+  return detail::is_enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Start recording a new trace. Events of a previous trace are discarded.
+ */
+void start();
+/**
+ * Stop recording. The recorded events are kept until the next #start.
+ */
+void stop();
+
+/**
+ * \return The events of the last trace in the Chrome trace event JSON format.
+ */
+std::string chrome_trace_json();
+/**
+ * Write the events of the last trace in the Chrome trace event format to a file.
+ * \return False when the file could not be written.
+ */
+bool chrome_trace_write(const char *filepath);
+
+/**
+ * Label of the work that is currently being done on this thread. Tasks take over the label that is
+ * active when they are scheduled, so nested work is attributed to the same caller.
+ */
+inline const char *current_label()
+{
+  return detail::current_label;
+}
+
+/**
+ * Set the label of all tasks scheduled from this thread while the scope is active.
+ *
+ * \note The label is not copied and must stay valid until the trace is exported, typically it is
+ * a string literal.
+ */
+class ScopedLabel {
+  const char *previous_label_;
+
+ public:
+  explicit ScopedLabel(const char *label) : previous_label_(detail::current_label)
+  {
+    detail::current_label = label;
+  }
+
+  ~ScopedLabel()
+  {
+    detail::current_label = previous_label_;
+  }
+
+  ScopedLabel(const ScopedLabel &other) = delete;
+  ScopedLabel &operator=(const ScopedLabel &other) = delete;
+};
+
+/**
+ * Record the execution of a task while the scope is active. Used by the task system itself.
+ * The label becomes the current label while the task runs, see #current_label.
+ */
+class TaskScope {
+  const char *label_;
+  const char *category_;
+  const char *previous_label_;
+  int64_t size_;
+  int64_t begin_ = -1;
+
+ public:
+  TaskScope(const char *label, const char *category, const int64_t size = 0)
+      : label_(label), category_(category), previous_label_(detail::current_label), size_(size)
+  {
+    if (is_enabled()) {
+      detail::current_label = label;
+      detail::event_begin(&begin_);
+    }
+  }
+
+  ~TaskScope()
+  {
+    if (begin_ != -1) {
+      detail::event_end(label_, category_, begin_, size_);
+      detail::current_label = previous_label_;
+    }
+  }
+
+  TaskScope(const TaskScope &other) = delete;
+  TaskScope &operator=(const TaskScope &other) = delete;
+};
+
+}  // namespace blender::threading::trace
@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <string>
+#include <vector>
 
 #include "BLI_sys_types.h"
 
@@ -56,6 +58,80 @@ class ScopedTimerAveraged {
   ~ScopedTimerAveraged();
 };
 
+/* -------------------------------------------------------------------- */
+/** \name Timer Statistics
+ *
+ * Named timing scopes that are aggregated in a global registry instead of being printed. They
+ * are meant to stay in production code: when the statistics are disabled (the default), a scope
+ * only checks an atomic flag.
+ *
+ * Scopes that are entered while another scope is active on the same thread are nested below it.
+ * For every nested scope, the number of times it was entered and the total, minimum and maximum
+ * duration are accumulated over all threads.
+ * \{ */
+
+struct TimerStats {
+  std::string name;
+  /** Names of the scope and all its parents, separated by a slash. */
+  std::string path;
+  /** Number of parent scopes. */
+  int depth;
+  int64_t count;
+  Nanoseconds total_time;
+  Nanoseconds min_time;
+  Nanoseconds max_time;
+};
+
+namespace detail {
+struct TimerStatsNode;
+extern std::atomic<bool> timer_stats_enabled;
+TimerStatsNode *timer_stats_scope_begin(const char *name);
+void timer_stats_scope_end(TimerStatsNode *node, Nanoseconds duration);
+}  // namespace detail
+
+inline bool timer_stats_enabled()
+{
+  return detail::timer_stats_enabled.load(std::memory_order_relaxed);
+}
+void timer_stats_enable(bool enable);
+/** Clear the statistics of all scopes. */
+void timer_stats_reset();
+/** \return The statistics of all scopes that were entered since the last reset, parents first. */
+std::vector<TimerStats> timer_stats_get();
+/** \return The statistics of all scopes as human readable text. */
+std::string timer_stats_report();
+
+/**
+ * Adds the duration of its lifetime to the statistics of the scope with the given name.
+ * \note The name is not copied, it should be a string literal.
+ */
+class ScopedTimerStats {
+ private:
+  detail::TimerStatsNode *node_ = nullptr;
+  TimePoint start_;
+
+ public:
+  explicit ScopedTimerStats(const char *name)
+  {
+    if (timer_stats_enabled()) {
+      node_ = detail::timer_stats_scope_begin(name);
+      start_ = Clock::now();
+    }
+  }
+
+  ~ScopedTimerStats()
+  {
+    if (node_ != nullptr) {
+      detail::timer_stats_scope_end(node_, Clock::now() - start_);
+    }
+  }
+
+  ScopedTimerStats(const ScopedTimerStats &other) = delete;
+  ScopedTimerStats &operator=(const ScopedTimerStats &other) = delete;
+};
+
+/** \} */
+
 }  // namespace blender::timeit
 
 #define SCOPED_TIMER(name) blender::timeit::ScopedTimer scoped_timer(name)
@@ -69,3 +145,9 @@ class ScopedTimerAveraged {
   static blender::timeit::Nanoseconds total_time_; \
   static blender::timeit::Nanoseconds min_time_ = blender::timeit::Nanoseconds::max(); \
   blender::timeit::ScopedTimerAveraged scoped_timer(name, total_count_, total_time_, min_time_)
+
+/**
+ * Accumulate the runtime of the scope in the timer statistics, see #timer_stats_get.
+ * The name should be a string literal.
+ */
+#define SCOPED_TIMER_STATS(name) blender::timeit::ScopedTimerStats scoped_timer_stats(name)
@@ -36,6 +36,9 @@ bool BLI_timer_is_registered(uintptr_t uuid);
 /** Returns False when the timer does not exist (anymore). */
 bool BLI_timer_unregister(uintptr_t uuid);
 
+/** Check whether any registered function is due, so that #BLI_timer_execute would call it. */
+bool BLI_timer_has_due(void);
+
 /** Execute all registered functions that are due. */
 void BLI_timer_execute(void);
 
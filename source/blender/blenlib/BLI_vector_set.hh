@@ -48,6 +48,7 @@
  */
 
 #include "BLI_array.hh"
+#include "BLI_group_probing.hh"
 #include "BLI_hash.hh"
 #include "BLI_hash_tables.hh"
 #include "BLI_probing_strategies.hh"
@@ -63,6 +64,8 @@ template<
     typename Key,
     /**
      * The strategy used to deal with collisions. They are defined in BLI_probing_strategies.hh.
+     * #GroupProbingStrategy (see BLI_group_probing.hh) can be used to store additional control
+     * bytes that are matched with SIMD instructions.
      */
     typename ProbingStrategy = DefaultProbingStrategy,
     /**
@@ -136,6 +139,10 @@ class VectorSet {
    */
   SlotArray slots_;
 
+  /** Control bytes of all slots, this is empty unless #GroupProbingStrategy is used. */
+  using Control = HashTableControl<ProbingStrategy, Allocator>;
+  BLI_NO_UNIQUE_ADDRESS Control control_;
+
   /**
    * Pointer to an array that contains all keys. The keys are sorted by insertion order as long as
    * no keys are removed. The first set->size() elements in this array are initialized. The
@@ -145,9 +152,9 @@ class VectorSet {
 
   /** Iterate over a slot index sequence for a given hash. */
 #define VECTOR_SET_SLOT_PROBING_BEGIN(HASH, R_SLOT) \
-  SLOT_PROBING_BEGIN (ProbingStrategy, HASH, slot_mask_, SLOT_INDEX) \
+  HASH_TABLE_PROBING_BEGIN (control_, HASH, slot_mask_, SLOT_INDEX) \
     auto &R_SLOT = slots_[SLOT_INDEX];
-#define VECTOR_SET_SLOT_PROBING_END() SLOT_PROBING_END()
+#define VECTOR_SET_SLOT_PROBING_END() HASH_TABLE_PROBING_END()
 
  public:
   /**
@@ -161,6 +168,7 @@ class VectorSet {
         usable_slots_(0),
         slot_mask_(0),
         slots_(1, allocator),
+        control_(allocator),
         keys_(nullptr)
   {
   }
@@ -188,7 +196,7 @@ class VectorSet {
     }
   }
 
-  VectorSet(const VectorSet &other) : slots_(other.slots_)
+  VectorSet(const VectorSet &other) : slots_(other.slots_), control_(other.control_)
   {
     keys_ = this->allocate_keys_array(other.usable_slots_);
     try {
@@ -213,6 +221,7 @@ class VectorSet {
         usable_slots_(other.usable_slots_),
         slot_mask_(other.slot_mask_),
         slots_(std::move(other.slots_)),
+        control_(std::move(other.control_)),
         keys_(other.keys_)
   {
     other.removed_slots_ = 0;
@@ -220,6 +229,7 @@ class VectorSet {
     other.usable_slots_ = 0;
     other.slot_mask_ = 0;
     other.slots_ = SlotArray(1);
+    other.control_.reinitialize(1);
     other.keys_ = nullptr;
   }
 
@@ -534,7 +544,8 @@ class VectorSet {
    */
   int64_t size_in_bytes() const
   {
-    return int64_t(sizeof(Slot) * slots_.size() + sizeof(Key) * usable_slots_);
+    return int64_t(sizeof(Slot) * slots_.size() + sizeof(Key) * usable_slots_) +
+           control_.size_in_bytes();
   }
 
   /**
@@ -557,6 +568,7 @@ class VectorSet {
       slot.~Slot();
       new (&slot) Slot();
     }
+    control_.reinitialize(slots_.size());
 
     removed_slots_ = 0;
     occupied_and_removed_slots_ = 0;
@@ -593,6 +605,7 @@ class VectorSet {
     if (this->size() == 0) {
       try {
         slots_.reinitialize(total_slots);
+        control_.reinitialize(total_slots);
         if (keys_ != nullptr) {
           this->deallocate_keys_array(keys_);
           keys_ = nullptr;
@@ -613,13 +626,16 @@ class VectorSet {
     SlotArray new_slots(total_slots);
 
     try {
+      Control new_control(slots_.allocator());
+      new_control.reinitialize(total_slots);
       for (Slot &slot : slots_) {
         if (slot.is_occupied()) {
-          this->add_after_grow(slot, new_slots, new_slot_mask);
+          this->add_after_grow(slot, new_slots, new_control, new_slot_mask);
           slot.remove();
         }
       }
       slots_ = std::move(new_slots);
+      control_ = std::move(new_control);
     }
     catch (...) {
       this->noexcept_reset();
@@ -644,19 +660,23 @@ class VectorSet {
     slot_mask_ = new_slot_mask;
   }
 
-  void add_after_grow(Slot &old_slot, SlotArray &new_slots, const uint64_t new_slot_mask)
+  void add_after_grow(Slot &old_slot,
+                      SlotArray &new_slots,
+                      Control &new_control,
+                      const uint64_t new_slot_mask)
   {
     const Key &key = keys_[old_slot.index()];
     const uint64_t hash = old_slot.get_hash(key, Hash());
 
-    SLOT_PROBING_BEGIN (ProbingStrategy, hash, new_slot_mask, slot_index) {
+    HASH_TABLE_PROBING_BEGIN (new_control, hash, new_slot_mask, slot_index) {
       Slot &slot = new_slots[slot_index];
       if (slot.is_empty()) {
         slot.occupy(old_slot.index(), hash);
+        new_control.occupy(slot_index, hash);
         return;
       }
     }
-    SLOT_PROBING_END();
+    HASH_TABLE_PROBING_END();
   }
 
   void noexcept_reset() noexcept
@@ -693,6 +713,7 @@ class VectorSet {
         new (dst) Key(std::forward<ForwardKey>(key));
         BLI_assert(hash_(*dst) == hash);
         slot.occupy(index, hash);
+        control_.occupy(SLOT_INDEX, hash);
         occupied_and_removed_slots_++;
         return;
       }
@@ -711,6 +732,7 @@ class VectorSet {
         new (dst) Key(std::forward<ForwardKey>(key));
         BLI_assert(hash_(*dst) == hash);
         slot.occupy(index, hash);
+        control_.occupy(SLOT_INDEX, hash);
         occupied_and_removed_slots_++;
         return true;
       }
@@ -763,6 +785,7 @@ class VectorSet {
         new (dst) Key(std::forward<ForwardKey>(key));
         BLI_assert(hash_(*dst) == hash);
         slot.occupy(index, hash);
+        control_.occupy(SLOT_INDEX, hash);
         occupied_and_removed_slots_++;
         return index;
       }
@@ -784,6 +807,7 @@ class VectorSet {
     VECTOR_SET_SLOT_PROBING_BEGIN (hash, slot) {
       if (slot.has_index(index_to_pop)) {
         slot.remove();
+        control_.remove(SLOT_INDEX);
         return key;
       }
     }
@@ -831,6 +855,7 @@ class VectorSet {
 
     keys_[last_element_index].~Key();
     slot.remove();
+    control_.remove(&slot - slots_.data());
     removed_slots_++;
     return;
   }
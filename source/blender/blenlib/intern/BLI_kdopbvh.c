@@ -55,6 +55,16 @@
 #  define KDOPBVH_THREAD_LEAF_THRESHOLD 1024
 #endif
 
+/** Branches with at least this many leafs compute their bounds in parallel. */
+#ifndef NDEBUG
+#  define KDOPBVH_REFIT_THREAD_LEAF_THRESHOLD 1024
+#else
+#  define KDOPBVH_REFIT_THREAD_LEAF_THRESHOLD 65536
+#endif
+
+/** Number of rays traversed together by #BLI_bvhtree_ray_cast_batch. */
+#define KDOPBVH_RAY_PACKET_SIZE 8
+
 /* -------------------------------------------------------------------- */
 /** \name Struct Definitions
  * \{ */
@@ -400,6 +410,70 @@ static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int e
   }
 }
 
+typedef struct BVHRefitData {
+  const BVHTree *tree;
+  BVHNode *node;
+} BVHRefitData;
+
+static void refit_kdop_hull_task_cb(void *__restrict userdata,
+                                    const int j,
+                                    const TaskParallelTLS *__restrict tls)
+{
+  const BVHRefitData *data = userdata;
+  const BVHTree *tree = data->tree;
+  float *__restrict bv = tls->userdata_chunk;
+  const float *__restrict node_bv = tree->nodes[j]->bv;
+
+  for (axis_t axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+    bv[(2 * axis_iter)] = min_ff(bv[(2 * axis_iter)], node_bv[(2 * axis_iter)]);
+    bv[(2 * axis_iter) + 1] = max_ff(bv[(2 * axis_iter) + 1], node_bv[(2 * axis_iter) + 1]);
+  }
+}
+
+static void refit_kdop_hull_reduce(const void *__restrict userdata,
+                                   void *__restrict chunk_join,
+                                   void *__restrict chunk)
+{
+  const BVHRefitData *data = userdata;
+  const BVHTree *tree = data->tree;
+  float *__restrict bv_join = chunk_join;
+  const float *__restrict bv = chunk;
+
+  for (axis_t axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+    bv_join[(2 * axis_iter)] = min_ff(bv_join[(2 * axis_iter)], bv[(2 * axis_iter)]);
+    bv_join[(2 * axis_iter) + 1] = max_ff(bv_join[(2 * axis_iter) + 1],
+                                          bv[(2 * axis_iter) + 1]);
+  }
+}
+
+/**
+ * Multi-threaded version of #refit_kdop_hull, used for the top levels of large trees where there
+ * are fewer branches to build than threads.
+ */
+static void refit_kdop_hull_threaded(const BVHTree *tree, BVHNode *node, int start, int end)
+{
+  if (end - start < KDOPBVH_REFIT_THREAD_LEAF_THRESHOLD) {
+    refit_kdop_hull(tree, node, start, end);
+    return;
+  }
+
+  float bv[26];
+  BLI_assert(tree->axis <= ARRAY_SIZE(bv));
+  node_minmax_init(tree, node);
+  memcpy(bv, node->bv, sizeof(float) * (size_t)tree->axis);
+
+  BVHRefitData data = {tree, node};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = KDOPBVH_REFIT_THREAD_LEAF_THRESHOLD / 8;
+  settings.userdata_chunk = bv;
+  settings.userdata_chunk_size = sizeof(float) * (size_t)tree->axis;
+  settings.func_reduce = refit_kdop_hull_reduce;
+  BLI_task_parallel_range(start, end, &data, refit_kdop_hull_task_cb, &settings);
+
+  memcpy(node->bv, bv, sizeof(float) * (size_t)tree->axis);
+}
+
 /**
  * Only supports x,y,z axis in the moment
  * but we should use a plain and simple function here for speed sake.
@@ -713,7 +787,7 @@ static void non_recursive_bvh_div_nodes_task_cb(void *__restrict userdata,
 
   /* This calculates the bounding box of this branch
    * and chooses the largest axis as the axis to divide leafs */
-  refit_kdop_hull(data->tree, parent, parent_leafs_begin, parent_leafs_end);
+  refit_kdop_hull_threaded(data->tree, parent, parent_leafs_begin, parent_leafs_end);
   split_axis = get_largest_axis(parent->bv);
 
   /* Save split axis (this can be used on ray-tracing to speedup the query time) */
@@ -1718,6 +1792,53 @@ int BLI_bvhtree_find_nearest(const BVHTree *tree,
 /** \name BLI_bvhtree_find_nearest_first
  * \{ */
 
+typedef struct BVHNearestBatchData {
+  const BVHTree *tree;
+  const float (*co)[3];
+  BVHTreeNearest *nearests;
+  BVHTree_NearestPointCallback callback;
+  void *userdata;
+  int flag;
+} BVHNearestBatchData;
+
+static void bvhtree_find_nearest_batch_task_cb(void *__restrict userdata,
+                                               const int i,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHNearestBatchData *batch = userdata;
+  BLI_bvhtree_find_nearest_ex(batch->tree,
+                              batch->co[i],
+                              &batch->nearests[i],
+                              batch->callback,
+                              batch->userdata,
+                              batch->flag);
+}
+
+void BLI_bvhtree_find_nearest_batch(const BVHTree *tree,
+                                    const float (*co)[3],
+                                    const int points_num,
+                                    BVHTreeNearest *nearests,
+                                    BVHTree_NearestPointCallback callback,
+                                    void *userdata,
+                                    const int flag)
+{
+  const BVHNearestBatchData batch = {
+      .tree = tree,
+      .co = co,
+      .nearests = nearests,
+      .callback = callback,
+      .userdata = userdata,
+      .flag = flag,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = points_num > KDOPBVH_THREAD_LEAF_THRESHOLD;
+  settings.min_iter_per_thread = 128;
+  BLI_task_parallel_range(
+      0, points_num, (void *)&batch, bvhtree_find_nearest_batch_task_cb, &settings);
+}
+
 static bool isect_aabb_v3(BVHNode *node, const float co[3])
 {
   const BVHTreeAxisRange *bv = (const BVHTreeAxisRange *)node->bv;
@@ -2044,6 +2165,189 @@ int BLI_bvhtree_ray_cast(const BVHTree *tree,
       tree, co, dir, radius, hit, callback, userdata, BVH_RAYCAST_DEFAULT);
 }
 
+/**
+ * Rays that are traversed together, sharing the node fetches and box tests.
+ * The box test data is stored per component so the tests vectorize over the rays.
+ */
+typedef struct BVHRayPacket {
+  int rays_num;
+  /** Per ray state, passed to the callbacks. */
+  BVHRayCastData rays[KDOPBVH_RAY_PACKET_SIZE];
+
+  float origin[3][KDOPBVH_RAY_PACKET_SIZE];
+  float idot_axis[3][KDOPBVH_RAY_PACKET_SIZE];
+  /** Current hit distance of every ray, negative for unused rays so they never hit. */
+  float dist[KDOPBVH_RAY_PACKET_SIZE];
+  /** Sum of the ray directions, used to pick the order in which children are traversed. */
+  float ray_dot_axis_sum[3];
+} BVHRayPacket;
+
+typedef struct BVHRayCastBatchData {
+  const BVHTree *tree;
+  const float (*co)[3];
+  const float (*dir)[3];
+  int rays_num;
+  BVHTreeRayHit *hits;
+  BVHTree_RayCastCallback callback;
+  void *userdata;
+  int flag;
+} BVHRayCastBatchData;
+
+/**
+ * Test the axis aligned bounds of \a bv against all rays in the packet that are active in
+ * \a mask_parent.
+ * \return True when any of the rays hits the node.
+ */
+static bool ray_packet_nearest_hit(const BVHRayPacket *packet,
+                                   const float bv[6],
+                                   const bool mask_parent[KDOPBVH_RAY_PACKET_SIZE],
+                                   bool r_mask[KDOPBVH_RAY_PACKET_SIZE],
+                                   float r_dist[KDOPBVH_RAY_PACKET_SIZE])
+{
+  bool any_hit = false;
+  for (int i = 0; i < KDOPBVH_RAY_PACKET_SIZE; i++) {
+    /* Same test as #fast_ray_nearest_hit: the entry distance may be negative when the ray starts
+     * inside the box. */
+    float low = -FLT_MAX;
+    float upper = FLT_MAX;
+    for (int axis = 0; axis < 3; axis++) {
+      const float t1 = (bv[2 * axis] - packet->origin[axis][i]) * packet->idot_axis[axis][i];
+      const float t2 = (bv[2 * axis + 1] - packet->origin[axis][i]) * packet->idot_axis[axis][i];
+      low = max_ff(low, min_ff(t1, t2));
+      upper = min_ff(upper, max_ff(t1, t2));
+    }
+    r_mask[i] = mask_parent[i] && (low <= upper) && (upper >= 0.0f) && (low < packet->dist[i]);
+    r_dist[i] = low;
+    any_hit |= r_mask[i];
+  }
+  return any_hit;
+}
+
+static void dfs_raycast_packet(BVHRayPacket *packet,
+                               const BVHNode *node,
+                               const bool mask_parent[KDOPBVH_RAY_PACKET_SIZE])
+{
+  bool mask[KDOPBVH_RAY_PACKET_SIZE];
+  float dist[KDOPBVH_RAY_PACKET_SIZE];
+  if (!ray_packet_nearest_hit(packet, node->bv, mask_parent, mask, dist)) {
+    return;
+  }
+
+  if (node->node_num == 0) {
+    for (int i = 0; i < packet->rays_num; i++) {
+      if (!mask[i]) {
+        continue;
+      }
+      BVHRayCastData *data = &packet->rays[i];
+      if (data->callback) {
+        data->callback(data->userdata, node->index, &data->ray, &data->hit);
+      }
+      else {
+        data->hit.index = node->index;
+        data->hit.dist = dist[i];
+        madd_v3_v3v3fl(data->hit.co, data->ray.origin, data->ray.direction, dist[i]);
+      }
+      packet->dist[i] = data->hit.dist;
+    }
+    return;
+  }
+
+  /* Pick loop direction to dive into the tree (based on the ray directions and split axis). */
+  if (packet->ray_dot_axis_sum[node->main_axis] > 0.0f) {
+    for (int i = 0; i != node->node_num; i++) {
+      dfs_raycast_packet(packet, node->children[i], mask);
+    }
+  }
+  else {
+    for (int i = node->node_num - 1; i >= 0; i--) {
+      dfs_raycast_packet(packet, node->children[i], mask);
+    }
+  }
+}
+
+static void bvhtree_ray_cast_batch_task_cb(void *__restrict userdata,
+                                           const int packet_index,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHRayCastBatchData *batch = userdata;
+  const int ray_start = packet_index * KDOPBVH_RAY_PACKET_SIZE;
+
+  BVHRayPacket packet;
+  packet.rays_num = min_ii(KDOPBVH_RAY_PACKET_SIZE, batch->rays_num - ray_start);
+  zero_v3(packet.ray_dot_axis_sum);
+
+  bool mask[KDOPBVH_RAY_PACKET_SIZE];
+  for (int i = 0; i < KDOPBVH_RAY_PACKET_SIZE; i++) {
+    mask[i] = i < packet.rays_num;
+    if (!mask[i]) {
+      for (int axis = 0; axis < 3; axis++) {
+        packet.origin[axis][i] = 0.0f;
+        packet.idot_axis[axis][i] = 0.0f;
+      }
+      packet.dist[i] = -1.0f;
+      continue;
+    }
+
+    BVHRayCastData *data = &packet.rays[i];
+    const int ray_index = ray_start + i;
+    BLI_ASSERT_UNIT_V3(batch->dir[ray_index]);
+    data->tree = batch->tree;
+    data->callback = batch->callback;
+    data->userdata = batch->userdata;
+    copy_v3_v3(data->ray.origin, batch->co[ray_index]);
+    copy_v3_v3(data->ray.direction, batch->dir[ray_index]);
+    data->ray.radius = 0.0f;
+    bvhtree_ray_cast_data_precalc(data, batch->flag);
+    data->hit = batch->hits[ray_index];
+
+    for (int axis = 0; axis < 3; axis++) {
+      packet.origin[axis][i] = data->ray.origin[axis];
+      packet.idot_axis[axis][i] = data->idot_axis[axis];
+    }
+    packet.dist[i] = data->hit.dist;
+    add_v3_v3(packet.ray_dot_axis_sum, data->ray_dot_axis);
+  }
+
+  dfs_raycast_packet(&packet, batch->tree->nodes[batch->tree->leaf_num], mask);
+
+  for (int i = 0; i < packet.rays_num; i++) {
+    batch->hits[ray_start + i] = packet.rays[i].hit;
+  }
+}
+
+void BLI_bvhtree_ray_cast_batch(const BVHTree *tree,
+                                const float (*co)[3],
+                                const float (*dir)[3],
+                                const int rays_num,
+                                BVHTreeRayHit *hits,
+                                BVHTree_RayCastCallback callback,
+                                void *userdata,
+                                const int flag)
+{
+  if (rays_num == 0 || tree->nodes[tree->leaf_num] == NULL) {
+    return;
+  }
+
+  const BVHRayCastBatchData batch = {
+      .tree = tree,
+      .co = co,
+      .dir = dir,
+      .rays_num = rays_num,
+      .hits = hits,
+      .callback = callback,
+      .userdata = userdata,
+      .flag = flag,
+  };
+  const int packets_num = (int)divide_ceil_u((uint)rays_num, KDOPBVH_RAY_PACKET_SIZE);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = rays_num > KDOPBVH_THREAD_LEAF_THRESHOLD;
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(
+      0, packets_num, (void *)&batch, bvhtree_ray_cast_batch_task_cb, &settings);
+}
+
 float BLI_bvhtree_bb_raycast(const float bv[6],
                              const float light_start[3],
                              const float light_end[3],
@@ -12,6 +12,9 @@
  * - Freeing chunks.
  * - Iterating over allocated chunks
  *   (optionally when using the #BLI_MEMPOOL_ALLOW_ITER flag).
+ * - Allocating and freeing from multiple threads
+ *   (optionally when using the #BLI_MEMPOOL_ALLOW_THREADS flag),
+ *   with per-thread caches of free elements (see #BLI_mempool_thread_cache).
  */
 
 #include <stdlib.h>
@@ -24,10 +27,7 @@
 #include "BLI_asan.h"
 #include "BLI_mempool.h"         /* own include */
 #include "BLI_mempool_private.h" /* own include */
-
-#ifdef WITH_ASAN
-#  include "BLI_threads.h"
-#endif
+#include "BLI_threads.h"
 
 #include "MEM_guardedalloc.h"
 
@@ -126,8 +126,23 @@ struct BLI_mempool {
   BLI_freenode *free;
   /** Use to know how many chunks to keep for #BLI_mempool_clear. */
   uint maxchunks;
-  /** Number of elements currently in use. */
+  /** Number of elements currently in use (including elements held by thread caches). */
   uint totused;
+
+  /** Protects all of the above when #BLI_MEMPOOL_ALLOW_THREADS is set. */
+  SpinLock thread_lock;
+};
+
+/**
+ * Free elements owned by a single thread, taken from and returned to #BLI_mempool.free in
+ * batches of #BLI_mempool.pchunk elements, so the pool only needs to be locked once per batch.
+ */
+struct BLI_mempool_thread_cache {
+  BLI_mempool *pool;
+  /** Free element list, the elements are counted as used in #BLI_mempool.totused. */
+  BLI_freenode *free;
+  /** Number of elements in #free. */
+  uint free_len;
 };
 
 #define MEMPOOL_ELEM_SIZE_MIN (sizeof(void *) * 2)
@@ -158,6 +173,39 @@ static void mempool_asan_lock(BLI_mempool *pool)
 #endif
 }
 
+static void mempool_thread_lock(BLI_mempool *pool)
+{
+  if (pool->flag & BLI_MEMPOOL_ALLOW_THREADS) {
+    BLI_spin_lock(&pool->thread_lock);
+  }
+}
+
+static void mempool_thread_unlock(BLI_mempool *pool)
+{
+  if (pool->flag & BLI_MEMPOOL_ALLOW_THREADS) {
+    BLI_spin_unlock(&pool->thread_lock);
+  }
+}
+
+/**
+ * Make a free node readable, to follow the free list.
+ */
+BLI_INLINE void mempool_freenode_access_begin(const BLI_mempool *pool, BLI_freenode *node)
+{
+  BLI_asan_unpoison(node, pool->esize - POISON_REDZONE_SIZE);
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MAKE_MEM_DEFINED(node, pool->esize - POISON_REDZONE_SIZE);
+#endif
+}
+
+BLI_INLINE void mempool_freenode_access_end(const BLI_mempool *pool, BLI_freenode *node)
+{
+  BLI_asan_poison(node, pool->esize);
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MAKE_MEM_UNDEFINED(node, pool->esize);
+#endif
+}
+
 #ifdef USE_CHUNK_POW2
 static uint power_of_2_max_u(uint x)
 {
@@ -342,6 +390,9 @@ BLI_mempool *BLI_mempool_create(uint esize, uint elem_num, uint pchunk, uint fla
 #ifdef WITH_ASAN
   BLI_mutex_init(&pool->mutex);
 #endif
+  if (flag & BLI_MEMPOOL_ALLOW_THREADS) {
+    BLI_spin_init(&pool->thread_lock);
+  }
 
   /* set the elem size */
   if (esize < (int)MEMPOOL_ELEM_SIZE_MIN) {
@@ -399,7 +450,7 @@ BLI_mempool *BLI_mempool_create(uint esize, uint elem_num, uint pchunk, uint fla
   return pool;
 }
 
-void *BLI_mempool_alloc(BLI_mempool *pool)
+static void *mempool_alloc(BLI_mempool *pool)
 {
   BLI_freenode *free_pop;
 
@@ -440,6 +491,14 @@ void *BLI_mempool_alloc(BLI_mempool *pool)
   return (void *)free_pop;
 }
 
+void *BLI_mempool_alloc(BLI_mempool *pool)
+{
+  mempool_thread_lock(pool);
+  void *retval = mempool_alloc(pool);
+  mempool_thread_unlock(pool);
+  return retval;
+}
+
 void *BLI_mempool_calloc(BLI_mempool *pool)
 {
   void *retval = BLI_mempool_alloc(pool);
@@ -449,6 +508,74 @@ void *BLI_mempool_calloc(BLI_mempool *pool)
   return retval;
 }
 
+#ifndef NDEBUG
+static void mempool_debug_check_free(const BLI_mempool *pool, void *addr)
+{
+  BLI_mempool_chunk *chunk;
+  bool found = false;
+  for (chunk = pool->chunks; chunk; chunk = chunk->next) {
+    if (ARRAY_HAS_ITEM((char *)addr, (char *)CHUNK_DATA(chunk), pool->csize)) {
+      found = true;
+      break;
+    }
+  }
+  if (!found) {
+    BLI_assert_msg(0, "Attempt to free data which is not in pool.\n");
+  }
+
+  /* Enable for debugging. */
+  if (UNLIKELY(mempool_debug_memset)) {
+    memset(addr, 255, pool->esize - POISON_REDZONE_SIZE);
+  }
+}
+#endif
+
+/**
+ * Nothing is in use; free all the chunks except the first.
+ */
+static void mempool_free_unused_chunks(BLI_mempool *pool)
+{
+  const uint esize = pool->esize;
+  BLI_freenode *curnode;
+  uint j;
+  BLI_mempool_chunk *first;
+
+  first = pool->chunks;
+  mempool_chunk_free_all(first->next, pool);
+  first->next = NULL;
+  pool->chunk_tail = first;
+
+  /* Temporary allocation so VALGRIND doesn't complain when setting freed blocks 'next'. */
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_ALLOC(pool, CHUNK_DATA(first), pool->csize);
+#endif
+
+  curnode = CHUNK_DATA(first);
+  pool->free = curnode;
+
+  j = pool->pchunk;
+  while (j--) {
+    BLI_asan_unpoison(curnode, pool->esize - POISON_REDZONE_SIZE);
+    BLI_freenode *next = curnode->next = NODE_STEP_NEXT(curnode);
+    BLI_asan_poison(curnode, pool->esize);
+    curnode = next;
+  }
+
+  BLI_asan_unpoison(curnode, pool->esize - POISON_REDZONE_SIZE);
+  BLI_freenode *prev = NODE_STEP_PREV(curnode);
+  BLI_asan_poison(curnode, pool->esize);
+
+  curnode = prev;
+
+  BLI_asan_unpoison(curnode, pool->esize - POISON_REDZONE_SIZE);
+  curnode->next = NULL; /* terminate the list */
+  BLI_asan_poison(curnode, pool->esize);
+
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_FREE(pool, CHUNK_DATA(first));
+#endif
+}
+
 /**
  * Free an element from the mempool.
  *
@@ -458,25 +585,10 @@ void BLI_mempool_free(BLI_mempool *pool, void *addr)
 {
   BLI_freenode *newhead = addr;
 
-#ifndef NDEBUG
-  {
-    BLI_mempool_chunk *chunk;
-    bool found = false;
-    for (chunk = pool->chunks; chunk; chunk = chunk->next) {
-      if (ARRAY_HAS_ITEM((char *)addr, (char *)CHUNK_DATA(chunk), pool->csize)) {
-        found = true;
-        break;
-      }
-    }
-    if (!found) {
-      BLI_assert_msg(0, "Attempt to free data which is not in pool.\n");
-    }
-  }
+  mempool_thread_lock(pool);
 
-  /* Enable for debugging. */
-  if (UNLIKELY(mempool_debug_memset)) {
-    memset(addr, 255, pool->esize - POISON_REDZONE_SIZE);
-  }
+#ifndef NDEBUG
+  mempool_debug_check_free(pool, addr);
 #endif
 
   if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
@@ -498,50 +610,186 @@ void BLI_mempool_free(BLI_mempool *pool, void *addr)
   VALGRIND_MEMPOOL_FREE(pool, addr);
 #endif
 
-  /* Nothing is in use; free all the chunks except the first. */
   if (UNLIKELY(pool->totused == 0) && (pool->chunks->next)) {
-    const uint esize = pool->esize;
-    BLI_freenode *curnode;
-    uint j;
-    BLI_mempool_chunk *first;
+    mempool_free_unused_chunks(pool);
+  }
+
+  mempool_thread_unlock(pool);
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Thread Cache
+ * \{ */
+
+BLI_mempool_thread_cache *BLI_mempool_thread_cache_create(BLI_mempool *pool)
+{
+  BLI_assert(pool->flag & BLI_MEMPOOL_ALLOW_THREADS);
+
+  BLI_mempool_thread_cache *cache = MEM_mallocN(sizeof(*cache), __func__);
+  cache->pool = pool;
+  cache->free = NULL;
+  cache->free_len = 0;
+  return cache;
+}
+
+/**
+ * Move up to a chunk worth of free elements from the pool into the (empty) cache,
+ * allocating a new chunk when the pool has no free elements left.
+ */
+static void mempool_thread_cache_refill(BLI_mempool_thread_cache *cache)
+{
+  BLI_mempool *pool = cache->pool;
+  BLI_assert(cache->free == NULL);
+
+  mempool_thread_lock(pool);
+
+  if (pool->free == NULL) {
+    BLI_mempool_chunk *mpchunk = mempool_chunk_alloc(pool);
+    mempool_chunk_add(pool, mpchunk, NULL);
+  }
+
+  BLI_freenode *first = pool->free;
+  BLI_freenode *last = first;
+  uint len = 1;
+  mempool_freenode_access_begin(pool, last);
+  while (len < pool->pchunk && last->next) {
+    BLI_freenode *next = last->next;
+    mempool_freenode_access_end(pool, last);
+    last = next;
+    mempool_freenode_access_begin(pool, last);
+    len++;
+  }
+  pool->free = last->next;
+  last->next = NULL;
+  mempool_freenode_access_end(pool, last);
+
+  pool->totused += len;
+
+  mempool_thread_unlock(pool);
+
+  cache->free = first;
+  cache->free_len = len;
+}
+
+/**
+ * Move the first \a len free elements of the cache back into the pool.
+ */
+static void mempool_thread_cache_release(BLI_mempool_thread_cache *cache, const uint len)
+{
+  BLI_mempool *pool = cache->pool;
+  BLI_assert(len > 0 && len <= cache->free_len);
+
+  /* Find the end of the released elements without holding the lock. */
+  BLI_freenode *first = cache->free;
+  BLI_freenode *last = first;
+  mempool_freenode_access_begin(pool, last);
+  for (uint i = 1; i < len; i++) {
+    BLI_freenode *next = last->next;
+    mempool_freenode_access_end(pool, last);
+    last = next;
+    mempool_freenode_access_begin(pool, last);
+  }
+  cache->free = last->next;
+  cache->free_len -= len;
+
+  mempool_thread_lock(pool);
+
+  last->next = pool->free;
+  mempool_freenode_access_end(pool, last);
+  pool->free = first;
+  pool->totused -= len;
+
+  if (UNLIKELY(pool->totused == 0) && (pool->chunks->next)) {
+    mempool_free_unused_chunks(pool);
+  }
+
+  mempool_thread_unlock(pool);
+}
 
-    first = pool->chunks;
-    mempool_chunk_free_all(first->next, pool);
-    first->next = NULL;
-    pool->chunk_tail = first;
+void *BLI_mempool_thread_cache_alloc(BLI_mempool_thread_cache *cache)
+{
+  BLI_mempool *pool = cache->pool;
+
+  if (UNLIKELY(cache->free == NULL)) {
+    mempool_thread_cache_refill(cache);
+  }
 
-    /* Temporary allocation so VALGRIND doesn't complain when setting freed blocks 'next'. */
+  BLI_freenode *free_pop = cache->free;
+
+  BLI_asan_unpoison(free_pop, pool->esize - POISON_REDZONE_SIZE);
 #ifdef WITH_MEM_VALGRIND
-    VALGRIND_MEMPOOL_ALLOC(pool, CHUNK_DATA(first), pool->csize);
+  VALGRIND_MEMPOOL_ALLOC(pool, free_pop, pool->esize - POISON_REDZONE_SIZE);
+  VALGRIND_MAKE_MEM_DEFINED(free_pop, pool->esize - POISON_REDZONE_SIZE);
 #endif
 
-    curnode = CHUNK_DATA(first);
-    pool->free = curnode;
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+    free_pop->freeword = USEDWORD;
+  }
 
-    j = pool->pchunk;
-    while (j--) {
-      BLI_asan_unpoison(curnode, pool->esize - POISON_REDZONE_SIZE);
-      BLI_freenode *next = curnode->next = NODE_STEP_NEXT(curnode);
-      BLI_asan_poison(curnode, pool->esize);
-      curnode = next;
-    }
+  cache->free = free_pop->next;
+  cache->free_len--;
 
-    BLI_asan_unpoison(curnode, pool->esize - POISON_REDZONE_SIZE);
-    BLI_freenode *prev = NODE_STEP_PREV(curnode);
-    BLI_asan_poison(curnode, pool->esize);
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MAKE_MEM_UNDEFINED(free_pop, pool->esize - POISON_REDZONE_SIZE);
+#endif
 
-    curnode = prev;
+  return (void *)free_pop;
+}
 
-    BLI_asan_unpoison(curnode, pool->esize - POISON_REDZONE_SIZE);
-    curnode->next = NULL; /* terminate the list */
-    BLI_asan_poison(curnode, pool->esize);
+void *BLI_mempool_thread_cache_calloc(BLI_mempool_thread_cache *cache)
+{
+  void *retval = BLI_mempool_thread_cache_alloc(cache);
+
+  memset(retval, 0, (size_t)cache->pool->esize - POISON_REDZONE_SIZE);
+
+  return retval;
+}
+
+void BLI_mempool_thread_cache_free(BLI_mempool_thread_cache *cache, void *addr)
+{
+  BLI_mempool *pool = cache->pool;
+  BLI_freenode *newhead = addr;
+
+#ifndef NDEBUG
+  mempool_thread_lock(pool);
+  mempool_debug_check_free(pool, addr);
+  mempool_thread_unlock(pool);
+#endif
+
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+#ifndef NDEBUG
+    /* This will detect double free's. */
+    BLI_assert(newhead->freeword != FREEWORD);
+#endif
+    newhead->freeword = FREEWORD;
+  }
+
+  newhead->next = cache->free;
+  cache->free = newhead;
+  cache->free_len++;
+
+  BLI_asan_poison(newhead, pool->esize);
 
 #ifdef WITH_MEM_VALGRIND
-    VALGRIND_MEMPOOL_FREE(pool, CHUNK_DATA(first));
+  VALGRIND_MEMPOOL_FREE(pool, addr);
 #endif
+
+  /* Keep one batch around for following allocations, return the rest to the pool. */
+  if (UNLIKELY(cache->free_len >= pool->pchunk * 2)) {
+    mempool_thread_cache_release(cache, pool->pchunk);
   }
 }
 
+void BLI_mempool_thread_cache_destroy(BLI_mempool_thread_cache *cache)
+{
+  if (cache->free_len) {
+    mempool_thread_cache_release(cache, cache->free_len);
+  }
+  MEM_freeN(cache);
+}
+
+/** \} */
+
 int BLI_mempool_len(const BLI_mempool *pool)
 {
   int ret = (int)pool->totused;
@@ -862,6 +1110,10 @@ void BLI_mempool_destroy(BLI_mempool *pool)
 {
   mempool_chunk_free_all(pool->chunks, pool);
 
+  if (pool->flag & BLI_MEMPOOL_ALLOW_THREADS) {
+    BLI_spin_end(&pool->thread_lock);
+  }
+
 #ifdef WITH_MEM_VALGRIND
   VALGRIND_DESTROY_MEMPOOL(pool);
 #endif
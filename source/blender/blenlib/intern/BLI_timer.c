@@ -80,6 +80,17 @@ bool BLI_timer_is_registered(uintptr_t uuid)
   return false;
 }
 
+bool BLI_timer_has_due(void)
+{
+  const double current_time = GET_TIME();
+  LISTBASE_FOREACH (TimedFunction *, timed_func, &GlobalTimer.funcs) {
+    if (!timed_func->tag_removal && timed_func->next_time <= current_time) {
+      return true;
+    }
+  }
+  return false;
+}
+
 static void execute_functions_if_necessary(void)
 {
   double current_time = GET_TIME();
@@ -11,6 +11,8 @@
 
 #include "BLI_filereader.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 
 #ifdef __BIG_ENDIAN__
 #  include "BLI_endian_switch.h"
@@ -18,6 +20,12 @@
 
 #include "MEM_guardedalloc.h"
 
+/**
+ * Maximum number of frames that are decompressed at once (on multiple threads) when the file is
+ * read sequentially. Frames written by Blender are 1 MB each (see `ZSTD_CHUNK_SIZE`).
+ */
+#define ZSTD_READAHEAD_FRAMES_MAX 16
+
 typedef struct {
   FileReader reader;
 
@@ -32,8 +40,12 @@ typedef struct {
     size_t *compressed_ofs;
     size_t *uncompressed_ofs;
 
-    char *cached_content;
+    /** Decompressed frames, the first one being `cached_frame`. */
+    char *cached_content[ZSTD_READAHEAD_FRAMES_MAX];
     int cached_frame;
+    int cached_frames_num;
+    /** Amount of frames to decompress together when the file is read sequentially. */
+    int readahead_frames_num;
   } seek;
 } ZstdReader;
 
@@ -130,6 +142,9 @@ static bool zstd_read_seek_table(ZstdReader *zstd)
   }
 
   zstd->seek.cached_frame = -1;
+  zstd->seek.cached_frames_num = 0;
+  zstd->seek.readahead_frames_num = clamp_i(
+      BLI_system_thread_count(), 1, ZSTD_READAHEAD_FRAMES_MAX);
 
   return true;
 }
@@ -157,42 +172,121 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
-static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
+static void zstd_free_cache(ZstdReader *zstd)
 {
-  if (zstd->seek.cached_frame == frame) {
-    /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
+  for (int i = 0; i < zstd->seek.cached_frames_num; i++) {
+    MEM_SAFE_FREE(zstd->seek.cached_content[i]);
   }
+  zstd->seek.cached_frame = -1;
+  zstd->seek.cached_frames_num = 0;
+}
 
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
-  MEM_SAFE_FREE(zstd->seek.cached_content);
-
-  size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
-  size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
-                             zstd->seek.uncompressed_ofs[frame];
+typedef struct ZstdDecompressData {
+  ZstdReader *zstd;
+  int first_frame;
+  const char *compressed_data;
+  /** The reader's context can only be used when decompressing on the calling thread. */
+  bool use_reader_context;
+  /** Result of decompression for each frame, NULL on error. */
+  char **uncompressed_data;
+} ZstdDecompressData;
+
+static void zstd_decompress_frame_fn(void *__restrict userdata,
+                                     const int iter,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ZstdDecompressData *data = userdata;
+  ZstdReader *zstd = data->zstd;
+  const int frame = data->first_frame + iter;
+
+  const size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] -
+                                 zstd->seek.compressed_ofs[frame];
+  const size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
+                                   zstd->seek.uncompressed_ofs[frame];
+  const size_t compressed_offset = zstd->seek.compressed_ofs[frame] -
+                                   zstd->seek.compressed_ofs[data->first_frame];
+  const char *compressed_data = data->compressed_data + compressed_offset;
 
   char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
+  size_t res = data->use_reader_context ?
+                   ZSTD_decompressDCtx(zstd->ctx,
+                                       uncompressed_data,
+                                       uncompressed_size,
+                                       compressed_data,
+                                       compressed_size) :
+                   ZSTD_decompress(
+                       uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+  if (ZSTD_isError(res) || res < uncompressed_size) {
+    MEM_freeN(uncompressed_data);
+    uncompressed_data = NULL;
+  }
+  data->uncompressed_data[iter] = uncompressed_data;
+}
+
+/**
+ * Ensure that the given frame is loaded. When reading sequentially, the following frames are
+ * decompressed as well, in parallel, so that following reads don't have to wait for them.
+ */
+static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
+{
+  if (frame >= zstd->seek.cached_frame &&
+      frame < zstd->seek.cached_frame + zstd->seek.cached_frames_num)
+  {
+    /* Cached frame matches, so just return it. */
+    return zstd->seek.cached_content[frame - zstd->seek.cached_frame];
+  }
+
+  /* Only read ahead when the previously cached frames were consumed in order, random access
+   * (e.g. for #BHead data read on demand) would waste time decompressing unused frames. */
+  const bool is_sequential = zstd->seek.cached_frames_num > 0 &&
+                             frame == zstd->seek.cached_frame + zstd->seek.cached_frames_num;
+  const int frames_num = is_sequential ?
+                             min_ii(zstd->seek.readahead_frames_num,
+                                    zstd->seek.frames_num - frame) :
+                             1;
+
+  /* Cached frames don't match, so discard them and cache the wanted ones instead. */
+  zstd_free_cache(zstd);
+
+  /* Consecutive frames are stored contiguously, so read them all at once. */
+  const size_t compressed_size = zstd->seek.compressed_ofs[frame + frames_num] -
+                                 zstd->seek.compressed_ofs[frame];
   char *compressed_data = MEM_mallocN(compressed_size, __func__);
   if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
       zstd->base->read(zstd->base, compressed_data, compressed_size) < compressed_size)
   {
     MEM_freeN(compressed_data);
-    MEM_freeN(uncompressed_data);
     return NULL;
   }
 
-  size_t res = ZSTD_decompressDCtx(
-      zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+  ZstdDecompressData data = {
+      zstd, frame, compressed_data, frames_num == 1, zstd->seek.cached_content};
+  if (frames_num == 1) {
+    zstd_decompress_frame_fn(&data, 0, NULL);
+  }
+  else {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(0, frames_num, &data, zstd_decompress_frame_fn, &settings);
+  }
   MEM_freeN(compressed_data);
-  if (ZSTD_isError(res) || res < uncompressed_size) {
-    MEM_freeN(uncompressed_data);
+
+  /* Only keep the frames up to the first failure, so that reads stop at the same point. */
+  int valid_frames_num = 0;
+  while (valid_frames_num < frames_num && zstd->seek.cached_content[valid_frames_num]) {
+    valid_frames_num++;
+  }
+  for (int i = valid_frames_num; i < frames_num; i++) {
+    MEM_SAFE_FREE(zstd->seek.cached_content[i]);
+  }
+  if (valid_frames_num == 0) {
     return NULL;
   }
 
   zstd->seek.cached_frame = frame;
-  zstd->seek.cached_content = uncompressed_data;
-  return uncompressed_data;
+  zstd->seek.cached_frames_num = valid_frames_num;
+  return zstd->seek.cached_content[0];
 }
 
 static int64_t zstd_read_seekable(FileReader *reader, void *buffer, size_t size)
@@ -285,10 +379,7 @@ static void zstd_close(FileReader *reader)
   if (zstd->reader.seek) {
     MEM_freeN(zstd->seek.uncompressed_ofs);
     MEM_freeN(zstd->seek.compressed_ofs);
-    /* When an error has occurred this may be NULL, see: #99744. */
-    if (zstd->seek.cached_content) {
-      MEM_freeN(zstd->seek.cached_content);
-    }
+    zstd_free_cache(zstd);
   }
   else {
     MEM_freeN((void *)zstd->in_buf.src);
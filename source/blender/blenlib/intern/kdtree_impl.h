@@ -10,8 +10,10 @@
 
 #include "BLI_kdtree_impl.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "BLI_strict_flags.h" /* Keep last. */
@@ -50,6 +52,11 @@ struct KDTree {
 
 #define KD_NODE_UNSET ((uint)-1)
 
+/** Sub-trees with at least this many nodes are balanced in a separate task. */
+#define KD_BALANCE_TASK_THRESHOLD 16384
+/** Below this number of queries, batched searches are done without sorting or threading. */
+#define KD_BATCH_QUERY_THRESHOLD 1024
+
 /**
  * When set we know all values are unbalanced,
  * otherwise clear them when re-balancing: see #62210.
@@ -139,7 +146,46 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
 #endif
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+typedef struct KDTreeBalanceTaskData {
+  KDTreeNode *nodes;
+  uint nodes_len;
+  uint axis;
+  uint ofs;
+  /** Where the root of the balanced sub-tree is written to. */
+  uint *r_root;
+} KDTreeBalanceTaskData;
+
+static uint kdtree_balance(
+    KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs, TaskPool *pool);
+
+static void kdtree_balance_task(TaskPool *__restrict pool, void *taskdata)
+{
+  KDTreeBalanceTaskData *data = taskdata;
+  *data->r_root = kdtree_balance(data->nodes, data->nodes_len, data->axis, data->ofs, pool);
+}
+
+/**
+ * Balance the sub-tree in \a nodes and write its root into \a r_root.
+ * Large sub-trees are balanced in a task of \a pool when given.
+ */
+static void kdtree_balance_subtree(
+    KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs, TaskPool *pool, uint *r_root)
+{
+  if (pool == NULL || nodes_len < KD_BALANCE_TASK_THRESHOLD) {
+    *r_root = kdtree_balance(nodes, nodes_len, axis, ofs, pool);
+    return;
+  }
+  KDTreeBalanceTaskData *data = MEM_mallocN(sizeof(*data), __func__);
+  data->nodes = nodes;
+  data->nodes_len = nodes_len;
+  data->axis = axis;
+  data->ofs = ofs;
+  data->r_root = r_root;
+  BLI_task_pool_push(pool, kdtree_balance_task, data, true, NULL);
+}
+
+static uint kdtree_balance(
+    KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs, TaskPool *pool)
 {
   KDTreeNode *node;
   float co;
@@ -188,9 +234,14 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   node = &nodes[median];
   node->d = axis;
   axis = (axis + 1) % KD_DIMS;
-  node->left = kdtree_balance(nodes, median, axis, ofs);
-  node->right = kdtree_balance(
-      nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs);
+  /* The sub-trees use disjoint ranges of nodes, so they can be balanced in parallel. */
+  kdtree_balance_subtree(nodes, median, axis, ofs, pool, &node->left);
+  kdtree_balance_subtree(nodes + median + 1,
+                         (nodes_len - (median + 1)),
+                         axis,
+                         (median + 1) + ofs,
+                         pool,
+                         &node->right);
 
   return median + ofs;
 }
@@ -204,7 +255,15 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if (tree->nodes_len < KD_BALANCE_TASK_THRESHOLD) {
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0, NULL);
+  }
+  else {
+    TaskPool *pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0, pool);
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+  }
 
 #ifndef NDEBUG
   tree->is_balanced = true;
@@ -326,6 +385,176 @@ int BLI_kdtree_nd_(find_nearest)(const KDTree *tree,
   return min_node->index;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Batched Nearest Search
+ * \{ */
+
+typedef struct KDTreeBatchQuery {
+  /** The node where descending the tree for this query ends, used for sorting and seeding. */
+  uint leaf;
+  uint index;
+} KDTreeBatchQuery;
+
+typedef struct KDTreeBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  KDTreeBatchQuery *queries;
+  int *r_index;
+  float *r_dist;
+} KDTreeBatchData;
+
+/**
+ * Descend the tree towards \a co without backtracking.
+ *
+ * The nodes are stored in the same order as an in-order traversal of the tree, so queries ending
+ * in nearby nodes are spatially close, and the node itself is a good first nearest candidate.
+ */
+static uint kdtree_descend(const KDTree *tree, const float co[KD_DIMS])
+{
+  const KDTreeNode *nodes = tree->nodes;
+  uint node_index = tree->root;
+  while (true) {
+    const KDTreeNode *node = &nodes[node_index];
+    const uint next = (co[node->d] < node->co[node->d]) ? node->left : node->right;
+    if (next == KD_NODE_UNSET) {
+      return node_index;
+    }
+    node_index = next;
+  }
+}
+
+/**
+ * Same as #BLI_kdtree_nd_(find_nearest), starting with the given \a seed node as candidate.
+ * Ties are resolved by taking the lowest index, so the result doesn't depend on the seed.
+ */
+static uint kdtree_find_nearest_seeded(const KDTree *tree,
+                                       const float co[KD_DIMS],
+                                       const uint seed,
+                                       float *r_dist_sq)
+{
+  const KDTreeNode *nodes = tree->nodes;
+  uint *stack, stack_default[KD_STACK_INIT];
+  uint stack_len_capacity = KD_STACK_INIT, cur = 0;
+
+  uint min_node = seed;
+  float min_dist = len_squared_vnvn(nodes[seed].co, co);
+
+  stack = stack_default;
+  stack[cur++] = tree->root;
+
+  while (cur--) {
+    const uint node_index = stack[cur];
+    const KDTreeNode *node = &nodes[node_index];
+    const float plane_dist = node->co[node->d] - co[node->d];
+    const uint near_child = (plane_dist < 0.0f) ? node->right : node->left;
+    const uint far_child = (plane_dist < 0.0f) ? node->left : node->right;
+
+    if (square_f(plane_dist) <= min_dist) {
+      const float dist = len_squared_vnvn(node->co, co);
+      if (dist < min_dist || (dist == min_dist && node->index < nodes[min_node].index)) {
+        min_dist = dist;
+        min_node = node_index;
+      }
+      if (far_child != KD_NODE_UNSET) {
+        stack[cur++] = far_child;
+      }
+    }
+    /* Pushed last, so the side of the query point is searched first. */
+    if (near_child != KD_NODE_UNSET) {
+      stack[cur++] = near_child;
+    }
+    if (UNLIKELY(cur + KD_DIMS > stack_len_capacity)) {
+      stack = realloc_nodes(stack, &stack_len_capacity, stack_default != stack);
+    }
+  }
+
+  if (stack != stack_default) {
+    MEM_freeN(stack);
+  }
+
+  *r_dist_sq = min_dist;
+  return min_node;
+}
+
+static int kdtree_batch_query_cmp(const void *a_v, const void *b_v)
+{
+  const KDTreeBatchQuery *a = a_v;
+  const KDTreeBatchQuery *b = b_v;
+  if (a->leaf != b->leaf) {
+    return (a->leaf < b->leaf) ? -1 : 1;
+  }
+  return (a->index < b->index) ? -1 : (a->index > b->index);
+}
+
+static void kdtree_batch_descend_fn(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  KDTreeBatchData *data = userdata;
+  KDTreeBatchQuery *query = &data->queries[i];
+  query->index = (uint)i;
+  query->leaf = kdtree_descend(data->tree, data->co[i]);
+}
+
+static void kdtree_batch_find_nearest_fn(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  KDTreeBatchData *data = userdata;
+  const KDTreeBatchQuery *query = &data->queries[i];
+  float dist_sq;
+  const uint node_index = kdtree_find_nearest_seeded(
+      data->tree, data->co[query->index], query->leaf, &dist_sq);
+  data->r_index[query->index] = data->tree->nodes[node_index].index;
+  if (data->r_dist) {
+    data->r_dist[query->index] = sqrtf(dist_sq);
+  }
+}
+
+void BLI_kdtree_nd_(find_nearest_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        const uint co_len,
+                                        int *r_index,
+                                        float *r_dist)
+{
+#ifndef NDEBUG
+  BLI_assert(tree->is_balanced == true);
+#endif
+
+  if (UNLIKELY(tree->root == KD_NODE_UNSET)) {
+    for (uint i = 0; i < co_len; i++) {
+      r_index[i] = -1;
+      if (r_dist) {
+        r_dist[i] = FLT_MAX;
+      }
+    }
+    return;
+  }
+
+  KDTreeBatchData data;
+  data.tree = tree;
+  data.co = co;
+  data.queries = MEM_mallocN(sizeof(KDTreeBatchQuery) * co_len, __func__);
+  data.r_index = r_index;
+  data.r_dist = r_dist;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = co_len >= KD_BATCH_QUERY_THRESHOLD;
+  settings.min_iter_per_thread = KD_BATCH_QUERY_THRESHOLD / 4;
+
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_batch_descend_fn, &settings);
+  if (co_len >= KD_BATCH_QUERY_THRESHOLD) {
+    /* Process spatially close queries together, for better cache usage. */
+    qsort(data.queries, co_len, sizeof(KDTreeBatchQuery), kdtree_batch_query_cmp);
+  }
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_batch_find_nearest_fn, &settings);
+
+  MEM_freeN(data.queries);
+}
+
+/** \} */
+
 /**
  * A version of #BLI_kdtree_3d_find_nearest which runs a callback
  * to filter out values.
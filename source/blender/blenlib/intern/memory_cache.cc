@@ -7,11 +7,21 @@
  */
 
 #include <atomic>
+#include <cstdio>
 #include <mutex>
 
+#include <zstd.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
 #include "BLI_concurrent_map.hh"
+#include "BLI_fileops.h"
+#include "BLI_map.hh"
 #include "BLI_memory_cache.hh"
 #include "BLI_memory_counter.hh"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
 #include "BLI_task.hh"
 
 namespace blender::memory_cache {
@@ -51,6 +61,10 @@ struct Cache {
    * thread-safe iteration.
    */
   Vector<const GenericKey *> keys;
+
+  std::atomic<int64_t> memory_hits = 0;
+  std::atomic<int64_t> disk_hits = 0;
+  std::atomic<int64_t> misses = 0;
 };
 
 static Cache &get_cache()
@@ -59,7 +73,57 @@ static Cache &get_cache()
   return cache;
 }
 
+/** A value that has been written to the disk cache. */
+struct DiskEntry {
+  /** Owns the key that is referenced in #DiskCache::entries. */
+  std::shared_ptr<const GenericKey> key;
+  std::string filepath;
+  /** Size of the compressed file, zero while it is still being written. */
+  int64_t size_in_bytes = 0;
+  int64_t last_use_time = 0;
+};
+
+/**
+ * Second tier of the cache: values that don't fit into memory anymore are serialized, compressed
+ * and written to files in a scratch directory. The files are only used within the same session.
+ */
+struct DiskCache {
+  std::mutex mutex;
+  std::atomic<bool> is_enabled = false;
+  std::string directory;
+  int64_t size_limit = 4ll * 1024 * 1024 * 1024;
+  int64_t size_in_bytes = 0;
+  Map<std::reference_wrapper<const GenericKey>, DiskEntry> entries;
+  /** Used to create unique file names. */
+  int64_t file_counter = 0;
+  std::atomic<int64_t> writes = 0;
+
+  ~DiskCache()
+  {
+    this->remove_all_files();
+  }
+
+  void remove_all_files()
+  {
+    for (const DiskEntry &entry : this->entries.values()) {
+      BLI_delete(entry.filepath.c_str(), false, false);
+    }
+    this->entries.clear();
+    this->size_in_bytes = 0;
+  }
+};
+
+static DiskCache &get_disk_cache()
+{
+  static DiskCache cache;
+  return cache;
+}
+
 static void try_enforce_limit();
+static void try_enforce_limit_impl(Vector<StoredValue> &r_freed_values);
+static std::unique_ptr<CachedValue> disk_cache_load(const GenericKey &key,
+                                                    DeserializeFn deserialize_fn,
+                                                    int64_t use_time);
 
 static void set_new_logical_time(const StoredValue &stored_value, const int64_t new_time)
 {
@@ -72,7 +136,8 @@ static void set_new_logical_time(const StoredValue &stored_value, const int64_t
 }
 
 std::shared_ptr<CachedValue> get_base(const GenericKey &key,
-                                      const FunctionRef<std::unique_ptr<CachedValue>()> compute_fn)
+                                      const FunctionRef<std::unique_ptr<CachedValue>()> compute_fn,
+                                      const DeserializeFn deserialize_fn)
 {
   Cache &cache = get_cache();
   /* "Touch" the cached value so that we know that it is still used. This makes it less likely that
@@ -83,6 +148,7 @@ std::shared_ptr<CachedValue> get_base(const GenericKey &key,
     CacheMap::ConstAccessor accessor;
     if (cache.map.lookup(accessor, std::ref(key))) {
       set_new_logical_time(accessor->second, new_time);
+      cache.memory_hits.fetch_add(1, std::memory_order_relaxed);
       return accessor->second.value;
     }
   }
@@ -90,7 +156,17 @@ std::shared_ptr<CachedValue> get_base(const GenericKey &key,
   /* Compute value while no locks are held to avoid potential for dead-locks. Not using a lock also
    * means that the value may be computed more than once, but that's still better than locking all
    * the time. It may be possible to implement something smarter in the future. */
-  std::shared_ptr<CachedValue> result = compute_fn();
+  std::shared_ptr<CachedValue> result;
+  if (deserialize_fn) {
+    result = disk_cache_load(key, deserialize_fn, new_time);
+  }
+  if (result) {
+    cache.disk_hits.fetch_add(1, std::memory_order_relaxed);
+  }
+  else {
+    cache.misses.fetch_add(1, std::memory_order_relaxed);
+    result = compute_fn();
+  }
   /* Result should be valid. Use exception to propagate error if necessary. */
   BLI_assert(result);
 
@@ -136,8 +212,48 @@ void set_approximate_size_limit(const int64_t limit_in_bytes)
   try_enforce_limit();
 }
 
+void set_disk_cache_directory(const StringRefNull directory)
+{
+  DiskCache &disk_cache = get_disk_cache();
+  std::lock_guard lock{disk_cache.mutex};
+  disk_cache.remove_all_files();
+  disk_cache.directory = directory;
+  disk_cache.is_enabled = !directory.is_empty() &&
+                          BLI_dir_create_recursive(disk_cache.directory.c_str());
+}
+
+void set_disk_cache_size_limit(const int64_t limit_in_bytes)
+{
+  DiskCache &disk_cache = get_disk_cache();
+  std::lock_guard lock{disk_cache.mutex};
+  disk_cache.size_limit = limit_in_bytes;
+}
+
+Statistics get_statistics()
+{
+  Cache &cache = get_cache();
+  DiskCache &disk_cache = get_disk_cache();
+  Statistics statistics;
+  statistics.memory_hits = cache.memory_hits.load(std::memory_order_relaxed);
+  statistics.disk_hits = cache.disk_hits.load(std::memory_order_relaxed);
+  statistics.misses = cache.misses.load(std::memory_order_relaxed);
+  statistics.disk_writes = disk_cache.writes.load(std::memory_order_relaxed);
+  statistics.memory_size_in_bytes = cache.size_in_bytes.load(std::memory_order_relaxed);
+  {
+    std::lock_guard lock{disk_cache.mutex};
+    statistics.disk_size_in_bytes = disk_cache.size_in_bytes;
+  }
+  return statistics;
+}
+
 void clear()
 {
+  {
+    DiskCache &disk_cache = get_disk_cache();
+    std::lock_guard lock{disk_cache.mutex};
+    disk_cache.remove_all_files();
+  }
+
   Cache &cache = get_cache();
   std::lock_guard lock{cache.global_mutex};
 
@@ -152,7 +268,165 @@ void clear()
   cache.memory.reset();
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Disk Cache
+ * \{ */
+
+static std::unique_ptr<CachedValue> disk_cache_load(const GenericKey &key,
+                                                    const DeserializeFn deserialize_fn,
+                                                    const int64_t use_time)
+{
+  DiskCache &disk_cache = get_disk_cache();
+  if (!disk_cache.is_enabled.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  std::string filepath;
+  {
+    std::lock_guard lock{disk_cache.mutex};
+    DiskEntry *entry = disk_cache.entries.lookup_ptr(std::ref(key));
+    if (entry == nullptr || entry->size_in_bytes == 0) {
+      return nullptr;
+    }
+    entry->last_use_time = use_time;
+    filepath = entry->filepath;
+  }
+
+  /* The file may have been removed in the mean time, then the value is just computed again. */
+  size_t compressed_size = 0;
+  void *compressed_data = BLI_file_read_binary_as_mem(filepath.c_str(), 0, &compressed_size);
+  if (compressed_data == nullptr) {
+    return nullptr;
+  }
+  std::unique_ptr<CachedValue> value;
+  const uint64_t data_size = ZSTD_getFrameContentSize(compressed_data, compressed_size);
+  if (!ELEM(data_size, ZSTD_CONTENTSIZE_UNKNOWN, ZSTD_CONTENTSIZE_ERROR)) {
+    Array<std::byte> data(int64_t(data_size), NoInitialization{});
+    const size_t decompressed_size = ZSTD_decompress(
+        data.data(), size_t(data.size()), compressed_data, compressed_size);
+    if (!ZSTD_isError(decompressed_size) && decompressed_size == data_size) {
+      value = deserialize_fn(data);
+    }
+  }
+  MEM_freeN(compressed_data);
+  return value;
+}
+
+/**
+ * Remove the least recently used files until the disk cache fits into its limit.
+ * \return The files to delete once the lock is released.
+ */
+static Vector<std::string> disk_cache_enforce_limit_locked(DiskCache &disk_cache)
+{
+  Vector<std::string> files_to_delete;
+  if (disk_cache.size_in_bytes <= disk_cache.size_limit) {
+    return files_to_delete;
+  }
+  Vector<std::pair<int64_t, const GenericKey *>> keys_with_time;
+  for (const DiskEntry &entry : disk_cache.entries.values()) {
+    if (entry.size_in_bytes > 0) {
+      keys_with_time.append({entry.last_use_time, entry.key.get()});
+    }
+  }
+  /* Oldest entries first. */
+  std::sort(keys_with_time.begin(), keys_with_time.end());
+  for (const std::pair<int64_t, const GenericKey *> &item : keys_with_time) {
+    if (disk_cache.size_in_bytes <= disk_cache.size_limit) {
+      break;
+    }
+    DiskEntry entry = disk_cache.entries.pop(std::ref(*item.second));
+    disk_cache.size_in_bytes -= entry.size_in_bytes;
+    files_to_delete.append(std::move(entry.filepath));
+  }
+  return files_to_delete;
+}
+
+/**
+ * Write values that were freed from memory to the disk cache, if they support serialization and
+ * are not stored on disk already.
+ */
+static void disk_cache_store(const Span<StoredValue> values)
+{
+  DiskCache &disk_cache = get_disk_cache();
+  for (const StoredValue &stored_value : values) {
+    std::string filepath;
+    {
+      std::lock_guard lock{disk_cache.mutex};
+      if (!disk_cache.is_enabled || disk_cache.entries.contains(std::ref(*stored_value.key))) {
+        continue;
+      }
+      char filename[64];
+      SNPRINTF(filename, "%lld.blcache", (long long)disk_cache.file_counter++);
+      char filepath_buf[FILE_MAX];
+      BLI_path_join(filepath_buf, sizeof(filepath_buf), disk_cache.directory.c_str(), filename);
+      filepath = filepath_buf;
+      /* Reserve the entry, so that other threads don't store the same value. */
+      DiskEntry entry;
+      entry.key = stored_value.key;
+      entry.filepath = filepath;
+      entry.last_use_time = stored_value.last_use_time;
+      disk_cache.entries.add_new(std::ref(*entry.key), std::move(entry));
+    }
+
+    Vector<std::byte> data;
+    bool success = stored_value.value->serialize(data);
+    int64_t file_size = 0;
+    if (success) {
+      /* Use a fast compression level, this is mainly used to save space for repetitive data. */
+      Array<std::byte> compressed_data(int64_t(ZSTD_compressBound(size_t(data.size()))),
+                                        NoInitialization());
+      const size_t compressed_size = ZSTD_compress(compressed_data.data(),
+                                                   size_t(compressed_data.size()),
+                                                   data.data(),
+                                                   size_t(data.size()),
+                                                   1);
+      success = false;
+      if (!ZSTD_isError(compressed_size)) {
+        if (FILE *file = BLI_fopen(filepath.c_str(), "wb")) {
+          success = fwrite(compressed_data.data(), 1, compressed_size, file) == compressed_size;
+          success &= fclose(file) == 0;
+        }
+      }
+      /* Empty files can't be restored, see #DiskEntry::size_in_bytes. */
+      file_size = std::max<int64_t>(int64_t(compressed_size), 1);
+    }
+
+    Vector<std::string> files_to_delete;
+    {
+      std::lock_guard lock{disk_cache.mutex};
+      DiskEntry *entry = disk_cache.entries.lookup_ptr(std::ref(*stored_value.key));
+      /* The entry may have been removed by a concurrent clear. */
+      const bool is_reserved = entry != nullptr && entry->filepath == filepath;
+      if (success && is_reserved) {
+        entry->size_in_bytes = file_size;
+        disk_cache.size_in_bytes += file_size;
+        disk_cache.writes.fetch_add(1, std::memory_order_relaxed);
+        files_to_delete = disk_cache_enforce_limit_locked(disk_cache);
+      }
+      else {
+        if (is_reserved) {
+          disk_cache.entries.remove(std::ref(*stored_value.key));
+        }
+        files_to_delete.append(filepath);
+      }
+    }
+    for (const std::string &file : files_to_delete) {
+      BLI_delete(file.c_str(), false, false);
+    }
+  }
+}
+
+/** \} */
+
 static void try_enforce_limit()
+{
+  Vector<StoredValue> freed_values;
+  try_enforce_limit_impl(freed_values);
+  if (!freed_values.is_empty()) {
+    disk_cache_store(freed_values);
+  }
+}
+
+static void try_enforce_limit_impl(Vector<StoredValue> &r_freed_values)
 {
   Cache &cache = get_cache();
   const int64_t old_size = cache.size_in_bytes.load(std::memory_order_relaxed);
@@ -216,9 +490,16 @@ static void try_enforce_limit()
     need_memory_recount = true;
   }
 
-  /* Remove elements that don't fit anymore. */
+  /* Remove elements that don't fit anymore. Keep them alive until they are moved to disk. */
+  const bool use_disk_cache = get_disk_cache().is_enabled.load(std::memory_order_relaxed);
   for (const int i : keys_with_time.index_range().drop_front(*first_bad_index)) {
     const GenericKey &key = *keys_with_time[i].second;
+    if (use_disk_cache) {
+      CacheMap::ConstAccessor accessor;
+      if (cache.map.lookup(accessor, key)) {
+        r_freed_values.append(accessor->second);
+      }
+    }
     cache.map.remove(key);
   }
 
@@ -0,0 +1,191 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ *
+ * Parallel LSD radix sort, see #parallel_radix_sort_indices.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "BLI_array.hh"
+#include "BLI_array_utils.hh"
+#include "BLI_math_base.h"
+#include "BLI_sort.hh"
+#include "BLI_task.hh"
+
+namespace blender {
+
+/** Every pass sorts by 8 bits of the keys. */
+constexpr int radix_bits = 8;
+constexpr int radix_size = 1 << radix_bits;
+/**
+ * Number of keys that are counted and scattered by a single task. Large enough that the counts
+ * of all chunks are small compared to the keys.
+ */
+constexpr int64_t radix_chunk_size = 1 << 16;
+/** Smaller inputs are sorted with a comparison sort, which has less overhead. */
+constexpr int64_t radix_sort_min_size = 2048;
+
+/**
+ * Map keys to unsigned integers with the same order. Signed integers are offset, floats are
+ * ordered by flipping the sign bit of positive and all bits of negative values.
+ */
+static uint32_t to_radix(const int32_t key)
+{
+  return uint32_t(key) ^ (uint32_t(1) << 31);
+}
+static uint32_t to_radix(const uint32_t key)
+{
+  return key;
+}
+static uint64_t to_radix(const int64_t key)
+{
+  return uint64_t(key) ^ (uint64_t(1) << 63);
+}
+static uint64_t to_radix(const uint64_t key)
+{
+  return key;
+}
+static uint32_t to_radix(const float key)
+{
+  /* Negative zero is equal to positive zero. */
+  const float value = key == 0.0f ? 0.0f : key;
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return (bits & (uint32_t(1) << 31)) ? ~bits : bits | (uint32_t(1) << 31);
+}
+static uint64_t to_radix(const double key)
+{
+  const double value = key == 0.0 ? 0.0 : key;
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return (bits & (uint64_t(1) << 63)) ? ~bits : bits | (uint64_t(1) << 63);
+}
+
+template<typename KeyT>
+static void radix_sort_indices(const Span<KeyT> keys, MutableSpan<int> indices)
+{
+  using RadixT = decltype(to_radix(KeyT()));
+  const int64_t size = indices.size();
+  if (size < radix_sort_min_size) {
+    std::stable_sort(indices.begin(), indices.end(), [&](const int a, const int b) {
+      return to_radix(keys[a]) < to_radix(keys[b]);
+    });
+    return;
+  }
+
+  /* The keys are moved together with the indices, so that every pass reads them sequentially. */
+  Array<RadixT> radix_buffer(size);
+  Array<RadixT> radix_buffer_tmp(size);
+  Array<int> indices_tmp(size);
+  threading::parallel_for(indices.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      radix_buffer[i] = to_radix(keys[indices[i]]);
+    }
+  });
+
+  const int64_t chunks_num = int64_t(divide_ceil_ul(uint64_t(size), uint64_t(radix_chunk_size)));
+  const auto chunk_range = [&](const int64_t chunk) {
+    const int64_t start = chunk * radix_chunk_size;
+    return IndexRange(start, std::min(radix_chunk_size, size - start));
+  };
+  /* For every chunk, the number of keys per digit. Later the first position of
+   * the chunk's keys with that digit in the sorted result. */
+  Array<int> chunk_offsets(chunks_num * radix_size);
+
+  MutableSpan<RadixT> src_radix = radix_buffer;
+  MutableSpan<RadixT> dst_radix = radix_buffer_tmp;
+  MutableSpan<int> src_indices = indices;
+  MutableSpan<int> dst_indices = indices_tmp;
+  for (int shift = 0; shift < int(sizeof(RadixT)) * 8; shift += radix_bits) {
+    const auto digit = [&](const RadixT radix) {
+      return int((radix >> shift) & RadixT(radix_size - 1));
+    };
+
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+      for (const int64_t chunk : chunks) {
+        MutableSpan<int> counts = chunk_offsets.as_mutable_span().slice(chunk * radix_size,
+                                                                        radix_size);
+        counts.fill(0);
+        for (const int64_t i : chunk_range(chunk)) {
+          counts[digit(src_radix[i])]++;
+        }
+      }
+    });
+
+    /* Skip passes over digits that are the same for all keys, which is common for the most
+     * significant digits. */
+    const int first_digit = digit(src_radix[0]);
+    int64_t first_digit_count = 0;
+    for (const int64_t chunk : IndexRange(chunks_num)) {
+      first_digit_count += chunk_offsets[chunk * radix_size + first_digit];
+    }
+    if (first_digit_count == size) {
+      continue;
+    }
+
+    /* Keys with smaller digits come first, the chunks are ordered to keep the sort stable. */
+    int offset = 0;
+    for (const int d : IndexRange(radix_size)) {
+      for (const int64_t chunk : IndexRange(chunks_num)) {
+        const int count = chunk_offsets[chunk * radix_size + d];
+        chunk_offsets[chunk * radix_size + d] = offset;
+        offset += count;
+      }
+    }
+
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+      for (const int64_t chunk : chunks) {
+        MutableSpan<int> offsets = chunk_offsets.as_mutable_span().slice(chunk * radix_size,
+                                                                         radix_size);
+        for (const int64_t i : chunk_range(chunk)) {
+          const int dst = offsets[digit(src_radix[i])]++;
+          dst_radix[dst] = src_radix[i];
+          dst_indices[dst] = src_indices[i];
+        }
+      }
+    });
+    std::swap(src_radix, dst_radix);
+    std::swap(src_indices, dst_indices);
+  }
+
+  if (src_indices.data() != indices.data()) {
+    array_utils::copy(src_indices.as_span(), indices);
+  }
+}
+
+void parallel_radix_sort_indices(const Span<int32_t> keys, MutableSpan<int> r_indices)
+{
+  radix_sort_indices(keys, r_indices);
+}
+
+void parallel_radix_sort_indices(const Span<uint32_t> keys, MutableSpan<int> r_indices)
+{
+  radix_sort_indices(keys, r_indices);
+}
+
+void parallel_radix_sort_indices(const Span<int64_t> keys, MutableSpan<int> r_indices)
+{
+  radix_sort_indices(keys, r_indices);
+}
+
+void parallel_radix_sort_indices(const Span<uint64_t> keys, MutableSpan<int> r_indices)
+{
+  radix_sort_indices(keys, r_indices);
+}
+
+void parallel_radix_sort_indices(const Span<float> keys, MutableSpan<int> r_indices)
+{
+  radix_sort_indices(keys, r_indices);
+}
+
+void parallel_radix_sort_indices(const Span<double> keys, MutableSpan<int> r_indices)
+{
+  radix_sort_indices(keys, r_indices);
+}
+
+}  // namespace blender
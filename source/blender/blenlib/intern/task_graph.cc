@@ -8,9 +8,7 @@
  * Task graph.
  */
 
-#ifdef WITH_CXX_GUARDEDALLOC
-#  include "MEM_guardedalloc.h"
-#endif
+#include "MEM_guardedalloc.h"
 
 #include "BLI_task.h"
 
@@ -48,6 +46,8 @@ struct TaskNode {
   /* Optional callback to free task data along with the graph. If task data
    * is shared between nodes, only a single task node should free the data. */
   TaskGraphNodeFreeFunction free_func;
+  /* Memory category of the code that created the node, see #MEM_category_set. */
+  eMEM_Category memory_category;
 
   TaskNode(TaskGraph *task_graph,
            TaskGraphNodeRunFunction run_func,
@@ -61,7 +61,8 @@ struct TaskNode {
 #endif
         run_func(run_func),
         task_data(task_data),
-        free_func(free_func)
+        free_func(free_func),
+        memory_category(MEM_category_get())
   {
 #ifndef WITH_TBB
     UNUSED_VARS(task_graph);
@@ -81,6 +82,7 @@ struct TaskNode {
 #ifdef WITH_TBB
   tbb::flow::continue_msg run(const tbb::flow::continue_msg /*input*/)
   {
+    MEM_ScopedCategory memory_category_scope(memory_category);
     run_func(task_data);
     return tbb::flow::continue_msg();
   }
@@ -88,6 +90,7 @@ struct TaskNode {
 
   void run_serial()
   {
+    MEM_ScopedCategory memory_category_scope(memory_category);
     run_func(task_data);
     for (TaskNode *successor : successors) {
       successor->run_serial();
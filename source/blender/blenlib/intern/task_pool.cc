@@ -18,6 +18,7 @@
 
 #include "BLI_mempool.h"
 #include "BLI_task.h"
+#include "BLI_task_trace.hh"
 #include "BLI_threads.h"
 
 #ifdef WITH_TBB
@@ -38,13 +39,23 @@ class Task {
   void *taskdata;
   bool free_taskdata;
   TaskFreeFunction freedata;
+  /** Label of the code that pushed the task, see #blender::threading::trace::current_label. */
+  const char *trace_label;
+  /** Memory category of the code that pushed the task, see #MEM_category_set. */
+  eMEM_Category memory_category;
 
   Task(TaskPool *pool,
        TaskRunFunction run,
        void *taskdata,
        bool free_taskdata,
        TaskFreeFunction freedata)
-      : pool(pool), run(run), taskdata(taskdata), free_taskdata(free_taskdata), freedata(freedata)
+      : pool(pool),
+        run(run),
+        taskdata(taskdata),
+        free_taskdata(free_taskdata),
+        freedata(freedata),
+        trace_label(blender::threading::trace::current_label()),
+        memory_category(MEM_category_get())
   {
   }
 
@@ -69,7 +80,9 @@ class Task {
         run(other.run),
         taskdata(other.taskdata),
         free_taskdata(other.free_taskdata),
-        freedata(other.freedata)
+        freedata(other.freedata),
+        trace_label(other.trace_label),
+        memory_category(other.memory_category)
   {
     other.pool = nullptr;
     other.run = nullptr;
@@ -89,7 +102,9 @@ class Task {
         run(other.run),
         taskdata(other.taskdata),
         free_taskdata(other.free_taskdata),
-        freedata(other.freedata)
+        freedata(other.freedata),
+        trace_label(other.trace_label),
+        memory_category(other.memory_category)
   {
     ((Task &)other).pool = nullptr;
     ((Task &)other).run = nullptr;
@@ -168,6 +183,8 @@ struct TaskPool {
 /* Execute task. */
 void Task::operator()() const
 {
+  blender::threading::trace::TaskScope trace_scope(trace_label, "task_pool");
+  MEM_ScopedCategory memory_category_scope(memory_category);
   run(pool, taskdata);
 }
 
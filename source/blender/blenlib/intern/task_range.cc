@@ -17,6 +17,7 @@
 #include "BLI_offset_indices.hh"
 #include "BLI_task.h"
 #include "BLI_task.hh"
+#include "BLI_task_trace.hh"
 #include "BLI_threads.h"
 #include "BLI_vector.hh"
 
@@ -166,8 +167,13 @@ static void parallel_for_impl_static_size(const IndexRange range,
                                           const int64_t grain_size,
                                           const FunctionRef<void(IndexRange)> function)
 {
+  const char *trace_label = trace::current_label();
+  const eMEM_Category memory_category = MEM_category_get();
   tbb::parallel_for(tbb::blocked_range<int64_t>(range.first(), range.one_after_last(), grain_size),
-                    [function](const tbb::blocked_range<int64_t> &subrange) {
+                    [function, trace_label, memory_category](
+                        const tbb::blocked_range<int64_t> &subrange) {
+                      trace::TaskScope trace_scope(trace_label, "parallel_for", subrange.size());
+                      MEM_ScopedCategory memory_category_scope(memory_category);
                       function(IndexRange(subrange.begin(), subrange.size()));
                     });
 }
@@ -226,11 +232,13 @@ static void parallel_for_impl_accumulated_size_lookup(
   BLI_assert(!range.is_empty());
   if (range.size() == 1) {
     /* Can't subdivide further. */
+    trace::TaskScope trace_scope(trace::current_label(), "parallel_for", range.size());
     function(range);
     return;
   }
   const int64_t total_size = size_hints.lookup_accumulated_size(range);
   if (total_size <= grain_size) {
+    trace::TaskScope trace_scope(trace::current_label(), "parallel_for", range.size());
     function(range);
     return;
   }
@@ -0,0 +1,188 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ *
+ * Recording and export of task traces, see `BLI_task_trace.hh`.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "BLI_fileops.h"
+#include "BLI_string.h"
+#include "BLI_task_trace.hh"
+
+namespace blender::threading::trace {
+
+namespace detail {
+std::atomic<bool> is_enabled = false;
+thread_local const char *current_label = nullptr;
+}  // namespace detail
+
+struct TraceEvent {
+  const char *label;
+  const char *category;
+  int64_t begin;
+  int64_t end;
+  int64_t size;
+};
+
+/**
+ * Events recorded by a single thread. Only the owning thread adds events, so no locking is
+ * needed. Standard containers are used on purpose: buffers live until exit, after the guarded
+ * allocator checks for leaks.
+ */
+struct ThreadBuffer {
+  int thread_index;
+  /** The trace the events belong to, buffers of older traces are cleared lazily. */
+  uint64_t trace_id = 0;
+  std::vector<TraceEvent> events;
+};
+
+struct TraceState {
+  std::mutex buffers_mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  std::atomic<uint64_t> trace_id = 0;
+  int64_t start_time = 0;
+};
+
+static TraceState &trace_state()
+{
+  static TraceState state;
+  return state;
+}
+
+static thread_local ThreadBuffer *thread_buffer = nullptr;
+
+static int64_t time_now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static ThreadBuffer &thread_buffer_ensure()
+{
+  if (thread_buffer == nullptr) {
+    TraceState &state = trace_state();
+    std::lock_guard lock{state.buffers_mutex};
+    std::unique_ptr<ThreadBuffer> buffer = std::make_unique<ThreadBuffer>();
+    buffer->thread_index = int(state.buffers.size());
+    thread_buffer = buffer.get();
+    state.buffers.push_back(std::move(buffer));
+  }
+  return *thread_buffer;
+}
+
+void detail::event_begin(int64_t *r_begin)
+{
+  *r_begin = time_now();
+}
+
+void detail::event_end(const char *label,
+                       const char *category,
+                       const int64_t begin,
+                       const int64_t size)
+{
+  const int64_t end = time_now();
+  TraceState &state = trace_state();
+  ThreadBuffer &buffer = thread_buffer_ensure();
+  const uint64_t trace_id = state.trace_id.load(std::memory_order_relaxed);
+  if (buffer.trace_id != trace_id) {
+    buffer.events.clear();
+    buffer.trace_id = trace_id;
+  }
+  buffer.events.push_back({label, category, begin, end, size});
+}
+
+void start()
+{
+  TraceState &state = trace_state();
+  state.start_time = time_now();
+  state.trace_id.fetch_add(1, std::memory_order_relaxed);
+  detail::is_enabled.store(true, std::memory_order_relaxed);
+}
+
+void stop()
+{
+  detail::is_enabled.store(false, std::memory_order_relaxed);
+}
+
+static void json_string_append(std::string &json, const char *str)
+{
+  json += '"';
+  for (const char *c = str; *c; c++) {
+    if (ELEM(*c, '"', '\\')) {
+      json += '\\';
+      json += *c;
+    }
+    else if (uchar(*c) < 0x20) {
+      char escaped[8];
+      SNPRINTF(escaped, "\\u%04x", int(*c));
+      json += escaped;
+    }
+    else {
+      json += *c;
+    }
+  }
+  json += '"';
+}
+
+std::string chrome_trace_json()
+{
+  TraceState &state = trace_state();
+  std::lock_guard lock{state.buffers_mutex};
+  const uint64_t trace_id = state.trace_id.load(std::memory_order_relaxed);
+
+  std::string json = "{\"traceEvents\":[\n";
+  bool is_first = true;
+  char buf[256];
+  for (const std::unique_ptr<ThreadBuffer> &buffer : state.buffers) {
+    if (buffer->trace_id != trace_id || buffer->events.empty()) {
+      continue;
+    }
+    SNPRINTF(buf,
+             "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+             "\"args\":{\"name\":\"Thread %d\"}}",
+             is_first ? "" : ",\n",
+             buffer->thread_index,
+             buffer->thread_index);
+    json += buf;
+    is_first = false;
+
+    for (const TraceEvent &event : buffer->events) {
+      json += ",\n{\"name\":";
+      json_string_append(json, event.label ? event.label : event.category);
+      SNPRINTF(buf,
+               ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,"
+               "\"args\":{\"size\":%lld}}",
+               event.category,
+               buffer->thread_index,
+               double(event.begin - state.start_time) / 1000.0,
+               double(event.end - event.begin) / 1000.0,
+               (long long)event.size);
+      json += buf;
+    }
+  }
+  json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return json;
+}
+
+bool chrome_trace_write(const char *filepath)
+{
+  const std::string json = chrome_trace_json();
+  FILE *file = BLI_fopen(filepath, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  const bool success = fwrite(json.data(), 1, json.size(), file) == json.size();
+  return (fclose(file) == 0) && success;
+}
+
+}  // namespace blender::threading::trace
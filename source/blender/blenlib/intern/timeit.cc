@@ -6,8 +6,12 @@
 #include "BLI_timeit.hh"
 
 #include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include <fmt/format.h>
 
@@ -78,4 +82,213 @@ ScopedTimerAveraged::~ScopedTimerAveraged()
   std::cout << StringRef(buf.data(), buf.size());
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Timer Statistics
+ * \{ */
+
+/**
+ * A node in the tree of nested scopes. Nodes are never freed, so that threads can cache them.
+ * Standard containers are used on purpose: the nodes live until exit, after the guarded allocator
+ * checks for leaks.
+ */
+struct detail::TimerStatsNode {
+  const char *name = nullptr;
+  TimerStatsNode *parent = nullptr;
+  /** Protected by #TimerStatsRegistry::mutex. */
+  std::vector<std::unique_ptr<TimerStatsNode>> children;
+
+  std::atomic<int64_t> count = 0;
+  std::atomic<int64_t> total_ns = 0;
+  std::atomic<int64_t> min_ns = INT64_MAX;
+  std::atomic<int64_t> max_ns = 0;
+
+  void reset()
+  {
+    count.store(0, std::memory_order_relaxed);
+    total_ns.store(0, std::memory_order_relaxed);
+    min_ns.store(INT64_MAX, std::memory_order_relaxed);
+    max_ns.store(0, std::memory_order_relaxed);
+  }
+};
+
+std::atomic<bool> detail::timer_stats_enabled = false;
+
+using detail::TimerStatsNode;
+
+struct TimerStatsRegistry {
+  std::mutex mutex;
+  TimerStatsNode root;
+};
+
+static TimerStatsRegistry &timer_stats_registry()
+{
+  static TimerStatsRegistry registry;
+  return registry;
+}
+
+/** The innermost active scope of this thread, the root when no scope is active. */
+static thread_local TimerStatsNode *current_timer_stats_node = nullptr;
+
+struct TimerStatsChildKey {
+  const TimerStatsNode *parent;
+  const char *name;
+
+  bool operator==(const TimerStatsChildKey &other) const
+  {
+    return parent == other.parent && name == other.name;
+  }
+};
+
+struct TimerStatsChildKeyHash {
+  size_t operator()(const TimerStatsChildKey &key) const
+  {
+    return std::hash<const void *>()(key.parent) ^ (std::hash<const void *>()(key.name) * 31);
+  }
+};
+
+using TimerStatsChildCache =
+    std::unordered_map<TimerStatsChildKey, TimerStatsNode *, TimerStatsChildKeyHash>;
+
+/** Child nodes that were used by this thread before, to avoid locking the registry. */
+static thread_local TimerStatsChildCache timer_stats_child_cache;
+
+static TimerStatsNode *timer_stats_child_ensure(TimerStatsNode &parent, const char *name)
+{
+  TimerStatsNode *&cached_child = timer_stats_child_cache[{&parent, name}];
+  if (cached_child) {
+    return cached_child;
+  }
+  TimerStatsRegistry &registry = timer_stats_registry();
+  std::lock_guard lock{registry.mutex};
+  /* Scopes with the same name are merged, even if the name is a different string. */
+  for (const std::unique_ptr<TimerStatsNode> &child : parent.children) {
+    if (STREQ(child->name, name)) {
+      cached_child = child.get();
+      return cached_child;
+    }
+  }
+  std::unique_ptr<TimerStatsNode> child = std::make_unique<TimerStatsNode>();
+  child->name = name;
+  child->parent = &parent;
+  cached_child = child.get();
+  parent.children.push_back(std::move(child));
+  return cached_child;
+}
+
+TimerStatsNode *detail::timer_stats_scope_begin(const char *name)
+{
+  TimerStatsNode *parent = current_timer_stats_node;
+  if (parent == nullptr) {
+    parent = &timer_stats_registry().root;
+  }
+  TimerStatsNode *node = timer_stats_child_ensure(*parent, name);
+  current_timer_stats_node = node;
+  return node;
+}
+
+static void atomic_min(std::atomic<int64_t> &value, const int64_t new_value)
+{
+  int64_t old_value = value.load(std::memory_order_relaxed);
+  while (new_value < old_value &&
+         !value.compare_exchange_weak(old_value, new_value, std::memory_order_relaxed))
+  {
+  }
+}
+
+static void atomic_max(std::atomic<int64_t> &value, const int64_t new_value)
+{
+  int64_t old_value = value.load(std::memory_order_relaxed);
+  while (new_value > old_value &&
+         !value.compare_exchange_weak(old_value, new_value, std::memory_order_relaxed))
+  {
+  }
+}
+
+void detail::timer_stats_scope_end(TimerStatsNode *node, const Nanoseconds duration)
+{
+  const int64_t duration_ns = duration.count();
+  node->count.fetch_add(1, std::memory_order_relaxed);
+  node->total_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+  atomic_min(node->min_ns, duration_ns);
+  atomic_max(node->max_ns, duration_ns);
+  current_timer_stats_node = node->parent;
+}
+
+void timer_stats_enable(const bool enable)
+{
+  detail::timer_stats_enabled.store(enable, std::memory_order_relaxed);
+}
+
+static void timer_stats_reset_recursive(TimerStatsNode &node)
+{
+  node.reset();
+  for (const std::unique_ptr<TimerStatsNode> &child : node.children) {
+    timer_stats_reset_recursive(*child);
+  }
+}
+
+void timer_stats_reset()
+{
+  TimerStatsRegistry &registry = timer_stats_registry();
+  std::lock_guard lock{registry.mutex};
+  timer_stats_reset_recursive(registry.root);
+}
+
+static void timer_stats_gather_recursive(const TimerStatsNode &node,
+                                         const std::string &parent_path,
+                                         const int depth,
+                                         std::vector<TimerStats> &r_stats)
+{
+  for (const std::unique_ptr<TimerStatsNode> &child : node.children) {
+    const std::string path = parent_path.empty() ? std::string(child->name) :
+                                                   parent_path + "/" + child->name;
+    const int64_t count = child->count.load(std::memory_order_relaxed);
+    if (count > 0) {
+      TimerStats stats;
+      stats.name = child->name;
+      stats.path = path;
+      stats.depth = depth;
+      stats.count = count;
+      stats.total_time = Nanoseconds(child->total_ns.load(std::memory_order_relaxed));
+      stats.min_time = Nanoseconds(child->min_ns.load(std::memory_order_relaxed));
+      stats.max_time = Nanoseconds(child->max_ns.load(std::memory_order_relaxed));
+      r_stats.push_back(std::move(stats));
+    }
+    timer_stats_gather_recursive(*child, path, depth + 1, r_stats);
+  }
+}
+
+std::vector<TimerStats> timer_stats_get()
+{
+  TimerStatsRegistry &registry = timer_stats_registry();
+  std::lock_guard lock{registry.mutex};
+  std::vector<TimerStats> stats;
+  timer_stats_gather_recursive(registry.root, "", 0, stats);
+  return stats;
+}
+
+std::string timer_stats_report()
+{
+  fmt::memory_buffer buf;
+  for (const TimerStats &stats : timer_stats_get()) {
+    fmt::format_to(fmt::appender(buf),
+                   FMT_STRING("{:{}}{}: (Count: {}, Total: "),
+                   "",
+                   stats.depth * 2,
+                   stats.name,
+                   stats.count);
+    format_duration(stats.total_time, buf);
+    buf.append(StringRef(", Average: "));
+    format_duration(stats.total_time / stats.count, buf);
+    buf.append(StringRef(", Min: "));
+    format_duration(stats.min_time, buf);
+    buf.append(StringRef(", Max: "));
+    format_duration(stats.max_time, buf);
+    buf.append(StringRef(")\n"));
+  }
+  return std::string(buf.data(), buf.size());
+}
+
+/** \} */
+
 }  // namespace blender::timeit
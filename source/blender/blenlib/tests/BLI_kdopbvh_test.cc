@@ -4,7 +4,7 @@
 
 #include "testing/testing.h"
 
-/* TODO: ray intersection, overlap ... etc. */
+/* TODO: overlap ... etc. */
 
 #include "MEM_guardedalloc.h"
 
@@ -134,3 +134,64 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+static void ray_cast_batch_test(int boxes_len, int rays_len, int random_seed)
+{
+  RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = BLI_bvhtree_new(boxes_len, 0.0, 2, 6);
+  for (int i = 0; i < boxes_len; i++) {
+    float box[2][3];
+    rng_v3_round(box[0], 3, rng, 1000, 1.0f);
+    for (int j = 0; j < 3; j++) {
+      box[1][j] = box[0][j] + BLI_rng_get_float(rng) * 0.05f;
+    }
+    BLI_bvhtree_insert(tree, i, box[0], 2);
+  }
+  BLI_bvhtree_balance(tree);
+
+  void *co_mem = MEM_mallocN(sizeof(float[3]) * rays_len, __func__);
+  void *dir_mem = MEM_mallocN(sizeof(float[3]) * rays_len, __func__);
+  float(*co)[3] = (float(*)[3])co_mem;
+  float(*dir)[3] = (float(*)[3])dir_mem;
+  BVHTreeRayHit *hits = (BVHTreeRayHit *)MEM_mallocN(sizeof(BVHTreeRayHit) * rays_len, __func__);
+  for (int i = 0; i < rays_len; i++) {
+    rng_v3_round(co[i], 3, rng, 1000, 2.0f);
+    rng_v3_round(dir[i], 3, rng, 1000, 1.0f);
+    /* Also test axis aligned rays. */
+    if (i % 7 == 0) {
+      dir[i][i % 3] = 0.0f;
+    }
+    if (normalize_v3(dir[i]) == 0.0f) {
+      dir[i][0] = 1.0f;
+    }
+    hits[i].index = -1;
+    hits[i].dist = (i % 3 == 0) ? 0.5f : BVH_RAYCAST_DIST_MAX;
+  }
+
+  BLI_bvhtree_ray_cast_batch(
+      tree, co, dir, rays_len, hits, nullptr, nullptr, BVH_RAYCAST_DEFAULT);
+
+  for (int i = 0; i < rays_len; i++) {
+    BVHTreeRayHit hit;
+    hit.index = -1;
+    hit.dist = (i % 3 == 0) ? 0.5f : BVH_RAYCAST_DIST_MAX;
+    BLI_bvhtree_ray_cast(tree, co[i], dir[i], 0.0f, &hit, nullptr, nullptr);
+    EXPECT_EQ(hits[i].index, hit.index);
+    EXPECT_FLOAT_EQ(hits[i].dist, hit.dist);
+  }
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(co_mem);
+  MEM_freeN(dir_mem);
+  MEM_freeN(hits);
+}
+
+TEST(kdopbvh, RayCastBatch_1)
+{
+  ray_cast_batch_test(1, 20, 1234);
+}
+TEST(kdopbvh, RayCastBatch_5000)
+{
+  ray_cast_batch_test(5000, 3001, 12);
+}
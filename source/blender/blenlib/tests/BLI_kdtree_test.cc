@@ -5,7 +5,10 @@
 #include "testing/testing.h"
 
 #include "BLI_kdtree.h"
+#include "BLI_rand.hh"
+#include "BLI_vector.hh"
 
+#include <array>
 #include <cmath>
 
 /* -------------------------------------------------------------------- */
@@ -54,6 +57,38 @@ static void deduplicate_test()
   }
 }
 
+static void find_nearest_batch_test(const int tree_size, const int queries_num)
+{
+  blender::RandomNumberGenerator rng(123);
+  KDTree_3d *tree = BLI_kdtree_3d_new(tree_size);
+  for (int i = 0; i < tree_size; i++) {
+    const float co[3] = {rng.get_float(), rng.get_float(), rng.get_float()};
+    BLI_kdtree_3d_insert(tree, i, co);
+  }
+  BLI_kdtree_3d_balance(tree);
+
+  blender::Vector<std::array<float, 3>> queries(queries_num);
+  for (std::array<float, 3> &co : queries) {
+    co = {rng.get_float() * 1.2f - 0.1f, rng.get_float(), rng.get_float()};
+  }
+
+  blender::Vector<int> indices(queries_num);
+  blender::Vector<float> distances(queries_num);
+  BLI_kdtree_3d_find_nearest_batch(tree,
+                                   reinterpret_cast<const float(*)[3]>(queries.data()),
+                                   uint(queries_num),
+                                   indices.data(),
+                                   distances.data());
+
+  for (int i = 0; i < queries_num; i++) {
+    KDTreeNearest_3d nearest;
+    const int index = BLI_kdtree_3d_find_nearest(tree, queries[i].data(), &nearest);
+    EXPECT_EQ(indices[i], index);
+    EXPECT_FLOAT_EQ(distances[i], nearest.dist);
+  }
+  BLI_kdtree_3d_free(tree);
+}
+
 TEST(kdtree, Standard)
 {
   standard_test();
@@ -63,3 +98,22 @@ TEST(kdtree, Deduplicate)
 {
   deduplicate_test();
 }
+
+TEST(kdtree, FindNearestBatch)
+{
+  find_nearest_batch_test(1, 10);
+  find_nearest_batch_test(100, 50);
+  /* Large enough for threaded balancing and sorted queries. */
+  find_nearest_batch_test(40000, 5000);
+}
+
+TEST(kdtree, FindNearestBatchEmpty)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(0);
+  BLI_kdtree_3d_balance(tree);
+  const float co[1][3] = {{0.0f, 0.0f, 0.0f}};
+  int index = 0;
+  BLI_kdtree_3d_find_nearest_batch(tree, co, 1, &index, nullptr);
+  EXPECT_EQ(index, -1);
+  BLI_kdtree_3d_free(tree);
+}
@@ -711,6 +711,43 @@ TEST(map, Equality)
   EXPECT_NE(a, b);
 }
 
+TEST(map, GroupProbing)
+{
+  Map<int, int, 4, GroupProbingStrategy> map;
+  for (int i = 0; i < 1000; i++) {
+    map.add_new(i, i * 2);
+  }
+  EXPECT_FALSE(map.add(5, 0));
+  EXPECT_EQ(map.size(), 1000);
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(map.lookup(i), i * 2);
+  }
+  EXPECT_EQ(map.lookup_ptr(1000), nullptr);
+  EXPECT_EQ(map.pop(10), 20);
+  EXPECT_FALSE(map.pop_try(10).has_value());
+  EXPECT_EQ(map.pop_default(11, -1), 22);
+  EXPECT_TRUE(map.remove(12));
+  EXPECT_FALSE(map.remove(12));
+  map.remove_contained(13);
+  EXPECT_EQ(map.size(), 996);
+  EXPECT_FALSE(map.contains(13));
+
+  map.add_overwrite(14, 5);
+  EXPECT_EQ(map.lookup(14), 5);
+  map.lookup_or_add(13, 26) += 1;
+  EXPECT_EQ(map.lookup(13), 27);
+  EXPECT_EQ(map.lookup_or_add_cb(12, []() { return 3; }), 3);
+  EXPECT_EQ(map.lookup_or_add_default(11), 0);
+  EXPECT_EQ(map.remove_if([](const auto item) { return item.key >= 500; }), 500);
+  EXPECT_EQ(map.size(), 499);
+
+  const Map<int, int, 4, GroupProbingStrategy> copied_map = map;
+  map.clear();
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_EQ(copied_map.lookup(1), 2);
+}
+
 /**
  * Set this to 1 to activate the benchmark. It is disabled by default, because it prints a lot.
  */
@@ -2,9 +2,14 @@
  *
  * SPDX-License-Identifier: Apache-2.0 */
 
+#include <cstring>
+
+#include "BLI_fileops.h"
 #include "BLI_hash.hh"
 #include "BLI_memory_cache.hh"
 #include "BLI_memory_counter.hh"
+#include "BLI_path_util.h"
+#include "BLI_tempfile.h"
 
 #include "testing/testing.h"
 
@@ -80,4 +85,88 @@ TEST(memory_cache, Simple)
   }
 }
 
+class CachedSerializableArray : public memory_cache::CachedValue {
+ public:
+  Vector<int> values;
+
+  CachedSerializableArray(Vector<int> initial_values) : values(std::move(initial_values)) {}
+
+  void count_memory(MemoryCounter &memory) const override
+  {
+    memory.add(values.as_span().size_in_bytes());
+  }
+
+  bool serialize(Vector<std::byte> &r_data) const override
+  {
+    r_data.resize(values.as_span().size_in_bytes());
+    memcpy(r_data.data(), values.data(), size_t(r_data.size()));
+    return true;
+  }
+
+  static std::unique_ptr<CachedSerializableArray> deserialize(const Span<std::byte> data)
+  {
+    Vector<int> result(data.size() / int64_t(sizeof(int)));
+    memcpy(result.data(), data.data(), size_t(data.size()));
+    return std::make_unique<CachedSerializableArray>(std::move(result));
+  }
+};
+
+TEST(memory_cache, DiskCache)
+{
+  char temp_dir[FILE_MAX];
+  BLI_temp_directory_path_get(temp_dir, sizeof(temp_dir));
+  BLI_path_append(temp_dir, sizeof(temp_dir), "blender_memory_cache_test");
+
+  memory_cache::clear();
+  memory_cache::set_disk_cache_directory(temp_dir);
+  /* Only a few values fit into memory. */
+  memory_cache::set_approximate_size_limit(4096);
+
+  const auto get_value = [&](const int key, bool &r_newly_computed) {
+    return memory_cache::get<CachedSerializableArray>(GenericIntKey(key), [&]() {
+      r_newly_computed = true;
+      Vector<int> values(200);
+      for (const int64_t i : values.index_range()) {
+        values[i] = key * 1000 + int(i);
+      }
+      return std::make_unique<CachedSerializableArray>(std::move(values));
+    });
+  };
+
+  const memory_cache::Statistics old_statistics = memory_cache::get_statistics();
+  for (int key = 0; key < 16; key++) {
+    bool newly_computed = false;
+    get_value(key, newly_computed);
+    EXPECT_TRUE(newly_computed);
+  }
+  const memory_cache::Statistics statistics = memory_cache::get_statistics();
+  EXPECT_EQ(statistics.misses - old_statistics.misses, 16);
+  EXPECT_GT(statistics.disk_writes - old_statistics.disk_writes, 0);
+  EXPECT_GT(statistics.disk_size_in_bytes, 0);
+
+  /* The first value was freed from memory, but can be restored from disk. */
+  {
+    bool newly_computed = false;
+    std::shared_ptr<const CachedSerializableArray> value = get_value(0, newly_computed);
+    EXPECT_FALSE(newly_computed);
+    EXPECT_EQ(value->values.size(), 200);
+    EXPECT_EQ(value->values[10], 10);
+    EXPECT_EQ(memory_cache::get_statistics().disk_hits - old_statistics.disk_hits, 1);
+  }
+
+  /* Clearing also removes the values on disk. */
+  memory_cache::clear();
+  EXPECT_EQ(memory_cache::get_statistics().disk_size_in_bytes, 0);
+  {
+    bool newly_computed = false;
+    get_value(0, newly_computed);
+    EXPECT_TRUE(newly_computed);
+  }
+
+  memory_cache::set_disk_cache_directory("");
+  memory_cache::set_approximate_size_limit(1024 * 1024 * 1024);
+  memory_cache::clear();
+  BLI_delete(temp_dir, true, true);
+}
+
 }  // namespace blender::memory_cache::tests
@@ -0,0 +1,111 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_mempool.h"
+#include "BLI_task.hh"
+
+namespace blender::tests {
+
+TEST(mempool, AllocFree)
+{
+  BLI_mempool *pool = BLI_mempool_create(sizeof(int), 0, 16, BLI_MEMPOOL_ALLOW_ITER);
+  Array<int *> elems(100);
+  for (const int i : elems.index_range()) {
+    elems[i] = static_cast<int *>(BLI_mempool_alloc(pool));
+    *elems[i] = i;
+  }
+  EXPECT_EQ(BLI_mempool_len(pool), 100);
+  for (const int i : elems.index_range()) {
+    EXPECT_EQ(*elems[i], i);
+  }
+  EXPECT_EQ(BLI_mempool_findelem(pool, 10), elems[10]);
+  for (int *elem : elems) {
+    BLI_mempool_free(pool, elem);
+  }
+  EXPECT_EQ(BLI_mempool_len(pool), 0);
+  BLI_mempool_destroy(pool);
+}
+
+TEST(mempool, ThreadCache)
+{
+  BLI_mempool *pool = BLI_mempool_create(
+      sizeof(int), 0, 16, BLI_MEMPOOL_ALLOW_ITER | BLI_MEMPOOL_ALLOW_THREADS);
+  BLI_mempool_thread_cache *cache = BLI_mempool_thread_cache_create(pool);
+
+  Array<int *> elems(1000);
+  for (const int i : elems.index_range()) {
+    elems[i] = static_cast<int *>(BLI_mempool_thread_cache_alloc(cache));
+    *elems[i] = i;
+  }
+  /* Free elements held by the cache count as used. */
+  EXPECT_GE(BLI_mempool_len(pool), 1000);
+  for (const int i : elems.index_range().drop_back(10)) {
+    BLI_mempool_thread_cache_free(cache, elems[i]);
+  }
+  BLI_mempool_thread_cache_destroy(cache);
+  EXPECT_EQ(BLI_mempool_len(pool), 10);
+
+  /* Remaining elements can be iterated and freed without a cache. */
+  BLI_mempool_iter iter;
+  BLI_mempool_iternew(pool, &iter);
+  int sum = 0;
+  while (int *elem = static_cast<int *>(BLI_mempool_iterstep(&iter))) {
+    sum += *elem;
+  }
+  EXPECT_EQ(sum, 990 + 991 + 992 + 993 + 994 + 995 + 996 + 997 + 998 + 999);
+  for (int *elem : elems.as_span().take_back(10)) {
+    BLI_mempool_free(pool, elem);
+  }
+  EXPECT_EQ(BLI_mempool_len(pool), 0);
+  BLI_mempool_destroy(pool);
+}
+
+TEST(mempool, ThreadCacheParallel)
+{
+  BLI_mempool *pool = BLI_mempool_create(
+      sizeof(int), 0, 64, BLI_MEMPOOL_ALLOW_ITER | BLI_MEMPOOL_ALLOW_THREADS);
+
+  Array<int *> elems(20000);
+  threading::parallel_for(elems.index_range(), 1024, [&](const IndexRange range) {
+    BLI_mempool_thread_cache *cache = BLI_mempool_thread_cache_create(pool);
+    for (const int i : range) {
+      elems[i] = static_cast<int *>(BLI_mempool_thread_cache_alloc(cache));
+      *elems[i] = i;
+    }
+    BLI_mempool_thread_cache_destroy(cache);
+  });
+  EXPECT_EQ(BLI_mempool_len(pool), elems.size());
+
+  BLI_mempool_iter iter;
+  BLI_mempool_iternew(pool, &iter);
+  int64_t sum = 0;
+  int count = 0;
+  while (int *elem = static_cast<int *>(BLI_mempool_iterstep(&iter))) {
+    sum += *elem;
+    count++;
+  }
+  EXPECT_EQ(count, elems.size());
+  EXPECT_EQ(sum, int64_t(elems.size()) * (elems.size() - 1) / 2);
+
+  /* Free every other element from different threads than the ones that allocated them. */
+  threading::parallel_for(IndexRange(elems.size() / 2), 512, [&](const IndexRange range) {
+    BLI_mempool_thread_cache *cache = BLI_mempool_thread_cache_create(pool);
+    for (const int i : range) {
+      BLI_mempool_thread_cache_free(cache, elems[elems.size() - 1 - i * 2]);
+    }
+    BLI_mempool_thread_cache_destroy(cache);
+  });
+  EXPECT_EQ(BLI_mempool_len(pool), elems.size() / 2);
+  for (int i = 0; i < elems.size(); i += 2) {
+    EXPECT_EQ(*elems[i], i);
+    BLI_mempool_free(pool, elems[i]);
+  }
+  EXPECT_EQ(BLI_mempool_len(pool), 0);
+  BLI_mempool_destroy(pool);
+}
+
+}  // namespace blender::tests
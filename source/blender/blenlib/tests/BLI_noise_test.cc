@@ -0,0 +1,67 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_noise.hh"
+#include "BLI_rand.hh"
+
+#include "BLI_strict_flags.h" /* Keep last. */
+
+namespace blender::noise::tests {
+
+static Array<float3> random_positions(const int64_t size, const float range)
+{
+  RandomNumberGenerator rng(42);
+  Array<float3> positions(size);
+  for (float3 &position : positions) {
+    position = (float3(rng.get_float(), rng.get_float(), rng.get_float()) * 2.0f - 1.0f) * range;
+  }
+  return positions;
+}
+
+TEST(noise, PerlinSignedBatch)
+{
+  /* Include positions far away from the origin, which are wrapped differently. */
+  for (const float range : {1.0f, 100.0f, 5000000.0f}) {
+    /* The size is not a multiple of the SIMD width. */
+    const Array<float3> positions = random_positions(1001, range);
+    Array<float> values(positions.size());
+    perlin_signed(positions, values);
+    for (const int64_t i : positions.index_range()) {
+      EXPECT_EQ(values[i], perlin_signed(positions[i]));
+    }
+  }
+}
+
+TEST(noise, PerlinFractalDistortedBatch)
+{
+  const Array<float3> positions = random_positions(1000, 20.0f);
+  Array<float> values(positions.size());
+  Array<float3> colors(positions.size());
+  for (const int type : {0, 1, 2, 3, 4}) {
+    for (const float detail : {0.0f, 2.0f, 5.7f}) {
+      for (const float distortion : {0.0f, 0.6f}) {
+        for (const bool normalize : {false, true}) {
+          perlin_fractal_distorted(
+              positions, detail, 0.5f, 2.0f, 0.3f, 1.2f, distortion, type, normalize, values);
+          perlin_float3_fractal_distorted(
+              positions, detail, 0.5f, 2.0f, 0.3f, 1.2f, distortion, type, normalize, colors);
+          for (const int64_t i : positions.index_range()) {
+            const float3 position = positions[i];
+            EXPECT_EQ(values[i],
+                      perlin_fractal_distorted(
+                          position, detail, 0.5f, 2.0f, 0.3f, 1.2f, distortion, type, normalize));
+            EXPECT_EQ(colors[i],
+                      perlin_float3_fractal_distorted(
+                          position, detail, 0.5f, 2.0f, 0.3f, 1.2f, distortion, type, normalize));
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace blender::noise::tests
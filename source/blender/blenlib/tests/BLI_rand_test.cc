@@ -0,0 +1,35 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_rand.hh"
+
+namespace blender::tests {
+
+TEST(rand, SkipMatchesSteps)
+{
+  for (const int64_t n : {0, 1, 2, 3, 7, 100, 1000, 65537}) {
+    RandomNumberGenerator rng_step(42);
+    RandomNumberGenerator rng_skip(42);
+    for (int64_t i = 0; i < n; i++) {
+      rng_step.get_uint32();
+    }
+    rng_skip.skip(n);
+    EXPECT_EQ(rng_step.get_uint32(), rng_skip.get_uint32());
+    EXPECT_EQ(rng_step.get_uint32(), rng_skip.get_uint32());
+  }
+}
+
+TEST(rand, SkipLarge)
+{
+  RandomNumberGenerator rng_step(7);
+  RandomNumberGenerator rng_skip(7);
+  rng_step.skip(3'000'000);
+  rng_step.skip(5'000'000);
+  rng_skip.skip(8'000'000);
+  EXPECT_EQ(rng_step.get_uint64(), rng_skip.get_uint64());
+}
+
+}  // namespace blender::tests
@@ -626,6 +626,62 @@ TEST(set, Equality)
   EXPECT_NE(f, a);
 }
 
+TEST(set, GroupProbing)
+{
+  Set<int, 4, GroupProbingStrategy> set;
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_TRUE(set.add(i * 7));
+  }
+  EXPECT_FALSE(set.add(0));
+  EXPECT_EQ(set.size(), 1000);
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_TRUE(set.contains(i * 7));
+    EXPECT_FALSE(set.contains(i * 7 + 1));
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    EXPECT_TRUE(set.remove(i * 7));
+  }
+  EXPECT_EQ(set.size(), 500);
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(set.contains(i * 7), i % 2 == 1);
+  }
+  /* Reuse the table many times, so that it contains many removed slots. */
+  for (int i = 0; i < 10000; i++) {
+    set.add_new(-i - 1);
+    set.remove_contained(-i - 1);
+  }
+  EXPECT_EQ(set.size(), 500);
+  EXPECT_EQ(set.remove_if([](const int key) { return key % 3 == 0; }), 167);
+  EXPECT_EQ(set.size(), 333);
+
+  Set<int, 4, GroupProbingStrategy> moved_set = std::move(set);
+  EXPECT_EQ(moved_set.size(), 333);
+  EXPECT_TRUE(moved_set.contains(7));
+  EXPECT_TRUE(set.is_empty());
+  EXPECT_FALSE(set.contains(7));
+  set.add(7);
+  EXPECT_TRUE(set.contains(7));
+
+  const Set<int, 4, GroupProbingStrategy> copied_set = moved_set;
+  EXPECT_EQ(copied_set, moved_set);
+  moved_set.clear();
+  EXPECT_TRUE(moved_set.is_empty());
+  EXPECT_FALSE(moved_set.contains(7));
+  EXPECT_TRUE(copied_set.contains(7));
+}
+
+TEST(set, GroupProbingStrings)
+{
+  Set<std::string, 0, GroupProbingStrategy> set;
+  for (int i = 0; i < 100; i++) {
+    set.add(std::to_string(i));
+  }
+  EXPECT_TRUE(set.contains_as("42"));
+  EXPECT_TRUE(set.contains_as(StringRef("99")));
+  EXPECT_FALSE(set.contains_as("100"));
+  EXPECT_EQ(set.lookup_key_as("7"), "7");
+}
+
 /**
  * Set this to 1 to activate the benchmark. It is disabled by default, because it prints a lot.
  */
@@ -0,0 +1,127 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "BLI_array.hh"
+#include "BLI_array_utils.hh"
+#include "BLI_rand.hh"
+#include "BLI_sort.hh"
+
+#include "BLI_strict_flags.h" /* Keep last. */
+
+namespace blender::tests {
+
+template<typename T> static void expect_radix_sort_matches_stable_sort(const Span<T> keys)
+{
+  Array<int> indices(keys.size());
+  array_utils::fill_index_range<int>(indices);
+  parallel_radix_sort_indices(keys, indices);
+
+  Array<int> expected(keys.size());
+  array_utils::fill_index_range<int>(expected);
+  std::stable_sort(expected.begin(), expected.end(), [&](const int a, const int b) {
+    return keys[a] < keys[b];
+  });
+  EXPECT_EQ(indices.as_span(), expected.as_span());
+}
+
+TEST(radix_sort, Empty)
+{
+  Array<int> indices;
+  parallel_radix_sort_indices(Span<float>(), indices);
+  EXPECT_TRUE(indices.is_empty());
+}
+
+TEST(radix_sort, SmallInt)
+{
+  const Array<int32_t> keys = {5, -3, 7, 0, -3, 2, 5, std::numeric_limits<int32_t>::min()};
+  Array<int> indices(keys.size());
+  array_utils::fill_index_range<int>(indices);
+  parallel_radix_sort_indices(keys.as_span(), indices);
+  EXPECT_EQ(indices.as_span(), Span<int>({7, 1, 4, 3, 5, 0, 6, 2}));
+}
+
+TEST(radix_sort, LargeInt)
+{
+  RandomNumberGenerator rng(3);
+  Array<int32_t> keys(300000);
+  for (int32_t &key : keys) {
+    /* Many duplicates to check that the sort is stable. */
+    key = rng.get_int32(1000) - 500;
+  }
+  expect_radix_sort_matches_stable_sort(keys.as_span());
+}
+
+TEST(radix_sort, LargeUInt64)
+{
+  RandomNumberGenerator rng(4);
+  Array<uint64_t> keys(200000);
+  for (uint64_t &key : keys) {
+    key = (uint64_t(rng.get_uint32()) << 32) | rng.get_uint32();
+  }
+  expect_radix_sort_matches_stable_sort(keys.as_span());
+}
+
+TEST(radix_sort, LargeFloat)
+{
+  RandomNumberGenerator rng(5);
+  Array<float> keys(250000);
+  for (float &key : keys) {
+    key = (rng.get_float() - 0.5f) * 1000.0f;
+  }
+  keys[10] = 0.0f;
+  keys[11] = -0.0f;
+  keys[12] = 0.0f;
+  keys[13] = std::numeric_limits<float>::infinity();
+  keys[14] = -std::numeric_limits<float>::infinity();
+  expect_radix_sort_matches_stable_sort(keys.as_span());
+}
+
+TEST(radix_sort, Double)
+{
+  const Array<double> keys = {1.5, -2.0, 0.0, -0.0, -1e300, 1e-300, -2.0};
+  Array<int> indices(keys.size());
+  array_utils::fill_index_range<int>(indices);
+  parallel_radix_sort_indices(keys.as_span(), indices);
+  EXPECT_EQ(indices.as_span(), Span<int>({4, 1, 6, 2, 3, 5, 0}));
+}
+
+TEST(radix_sort, SubsetOfIndices)
+{
+  const Array<float> keys = {4.0f, 3.0f, 2.0f, 1.0f, 0.0f};
+  Array<int> indices = {4, 0, 2};
+  parallel_radix_sort_indices(keys.as_span(), indices);
+  EXPECT_EQ(indices.as_span(), Span<int>({4, 2, 0}));
+}
+
+TEST(radix_sort, MultipleKeys)
+{
+  RandomNumberGenerator rng(6);
+  Array<int32_t> primary(100000);
+  Array<float> secondary(primary.size());
+  for (const int64_t i : primary.index_range()) {
+    primary[i] = rng.get_int32(20);
+    secondary[i] = float(rng.get_int32(50));
+  }
+  Array<int> indices(primary.size());
+  array_utils::fill_index_range<int>(indices);
+  parallel_radix_sort_indices(secondary.as_span(), indices);
+  parallel_radix_sort_indices(primary.as_span(), indices);
+
+  Array<int> expected(primary.size());
+  array_utils::fill_index_range<int>(expected);
+  std::stable_sort(expected.begin(), expected.end(), [&](const int a, const int b) {
+    if (primary[a] != primary[b]) {
+      return primary[a] < primary[b];
+    }
+    return secondary[a] < secondary[b];
+  });
+  EXPECT_EQ(indices.as_span(), expected.as_span());
+}
+
+}  // namespace blender::tests
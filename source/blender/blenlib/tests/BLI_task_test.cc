@@ -16,6 +16,7 @@
 #include "BLI_mempool.h"
 #include "BLI_task.h"
 #include "BLI_task.hh"
+#include "BLI_task_trace.hh"
 
 #define ITEMS_NUM 10000
 
@@ -245,3 +246,42 @@ TEST(task, ParallelInvoke)
                                       [&]() { counter++; });
   EXPECT_EQ(counter, 6);
 }
+
+static void task_trace_pool_run_func(TaskPool *__restrict pool, void * /*taskdata*/)
+{
+  std::atomic<int> *counter = static_cast<std::atomic<int> *>(BLI_task_pool_user_data(pool));
+  (*counter)++;
+}
+
+TEST(task, TraceTaskPool)
+{
+  namespace trace = blender::threading::trace;
+  BLI_threadapi_init();
+
+  std::atomic<int> counter = 0;
+  trace::start();
+  {
+    trace::ScopedLabel label("Test \"Pool\"");
+    TaskPool *pool = BLI_task_pool_create(&counter, TASK_PRIORITY_HIGH);
+    for (int i = 0; i < 16; i++) {
+      BLI_task_pool_push(pool, task_trace_pool_run_func, nullptr, false, nullptr);
+    }
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+  }
+  trace::stop();
+  EXPECT_EQ(counter, 16);
+  EXPECT_EQ(trace::current_label(), nullptr);
+
+  const std::string json = trace::chrome_trace_json();
+  EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"Test \\\"Pool\\\"\",\"cat\":\"task_pool\""),
+            std::string::npos);
+
+  /* Starting a new trace discards the events of the previous one. */
+  trace::start();
+  trace::stop();
+  EXPECT_EQ(trace::chrome_trace_json().find("task_pool"), std::string::npos);
+
+  BLI_threadapi_exit();
+}
@@ -0,0 +1,94 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <thread>
+
+#include "BLI_timeit.hh"
+
+#include "BLI_strict_flags.h" /* Keep last. */
+
+namespace blender::timeit::tests {
+
+static const TimerStats *find_stats(const std::vector<TimerStats> &stats, const char *path)
+{
+  for (const TimerStats &item : stats) {
+    if (item.path == path) {
+      return &item;
+    }
+  }
+  return nullptr;
+}
+
+TEST(timer_stats, Disabled)
+{
+  timer_stats_enable(false);
+  timer_stats_reset();
+  {
+    SCOPED_TIMER_STATS("Disabled");
+  }
+  EXPECT_EQ(find_stats(timer_stats_get(), "Disabled"), nullptr);
+}
+
+TEST(timer_stats, Nested)
+{
+  timer_stats_enable(true);
+  timer_stats_reset();
+  for (int i = 0; i < 3; i++) {
+    SCOPED_TIMER_STATS("Outer");
+    for (int j = 0; j < 2; j++) {
+      ScopedTimerStats inner_timer("Inner");
+    }
+  }
+  {
+    SCOPED_TIMER_STATS("Inner");
+  }
+  timer_stats_enable(false);
+
+  const std::vector<TimerStats> stats = timer_stats_get();
+  const TimerStats *outer = find_stats(stats, "Outer");
+  const TimerStats *outer_inner = find_stats(stats, "Outer/Inner");
+  const TimerStats *inner = find_stats(stats, "Inner");
+  ASSERT_NE(outer, nullptr);
+  ASSERT_NE(outer_inner, nullptr);
+  ASSERT_NE(inner, nullptr);
+  EXPECT_EQ(outer->count, 3);
+  EXPECT_EQ(outer->depth, 0);
+  EXPECT_EQ(outer_inner->count, 6);
+  EXPECT_EQ(outer_inner->depth, 1);
+  EXPECT_EQ(outer_inner->name, "Inner");
+  EXPECT_EQ(inner->count, 1);
+  EXPECT_LE(outer->min_time, outer->max_time);
+  EXPECT_GE(outer->total_time, outer_inner->total_time);
+  EXPECT_NE(timer_stats_report().find("Inner"), std::string::npos);
+
+  timer_stats_reset();
+  EXPECT_EQ(find_stats(timer_stats_get(), "Outer"), nullptr);
+}
+
+TEST(timer_stats, Threads)
+{
+  timer_stats_enable(true);
+  timer_stats_reset();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < 100; j++) {
+        SCOPED_TIMER_STATS("Thread");
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  timer_stats_enable(false);
+
+  const std::vector<TimerStats> stats = timer_stats_get();
+  const TimerStats *thread_stats = find_stats(stats, "Thread");
+  ASSERT_NE(thread_stats, nullptr);
+  EXPECT_EQ(thread_stats->count, 400);
+}
+
+}  // namespace blender::timeit::tests
@@ -298,4 +298,33 @@ TEST(vector_set, GrowWhenEmpty)
   set.reserve(100);
 }
 
+TEST(vector_set, GroupProbing)
+{
+  VectorSet<int, GroupProbingStrategy> set;
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(set.index_of_or_add(i * 3), i);
+  }
+  EXPECT_FALSE(set.add(0));
+  EXPECT_EQ(set.index_of(300), 100);
+  EXPECT_EQ(set.index_of_try(301), -1);
+  EXPECT_TRUE(set.remove(0));
+  /* The last key is moved to the index of the removed key. */
+  EXPECT_EQ(set.index_of(2997), 0);
+  EXPECT_EQ(set.pop(), 2994);
+  EXPECT_FALSE(set.contains(2994));
+  EXPECT_EQ(set.remove_if([](const int key) { return key % 2 == 0; }), 498);
+  EXPECT_EQ(set.size(), 500);
+  for (const int64_t i : set.index_range()) {
+    EXPECT_EQ(set.index_of(set[i]), i);
+  }
+
+  VectorSet<int, GroupProbingStrategy> moved_set = std::move(set);
+  EXPECT_EQ(moved_set.size(), 500);
+  EXPECT_FALSE(set.contains(3));
+  set.add(3);
+  EXPECT_TRUE(set.contains(3));
+  moved_set.clear();
+  EXPECT_FALSE(moved_set.contains(3));
+}
+
 }  // namespace blender::tests
@@ -358,6 +358,19 @@ const blender::ImplicitSharingInfo *BLO_read_shared(
   return shared_data.sharing_info;
 }
 
+/**
+ * Try to reference the data at the given (old) pointer directly from the memory-mapped file,
+ * instead of reading it into a new allocation. This is only possible for large arrays that do not
+ * need any conversion, and when the file is not compressed.
+ *
+ * \return A sharing-info keeping the mapping alive when the pointer was changed to the mapped
+ * data, which can then be modified like regular (implicitly shared) data. Null otherwise, in which
+ * case the data has to be read with the regular functions above.
+ */
+const blender::ImplicitSharingInfo *BLO_read_mapped_data(BlendDataReader *reader,
+                                                         void **ptr_p,
+                                                         size_t expected_size);
+
 int BLO_read_fileversion_get(BlendDataReader *reader);
 bool BLO_read_requires_endian_switch(BlendDataReader *reader);
 bool BLO_read_data_is_undo(BlendDataReader *reader);
@@ -96,18 +96,32 @@ struct BlendFileReadParams {
   int undo_direction; /* #eUndoStepDir */
 };
 
+/** Time spent in the different stages of reading a blend-file, in seconds. */
+struct BlendFileReadDurations {
+  double whole;
+  /** Reading and reconstructing the data-blocks of the main file. */
+  double read_data;
+  /** All versioning code, including the one of linked libraries. */
+  double versioning;
+  /** Reading linked libraries and ID pointers remapping, includes #lib_link. */
+  double libraries;
+  /** Remapping ID pointers of the data-blocks, and related post-processing. */
+  double lib_link;
+  double lib_overrides;
+  double lib_overrides_resync;
+  double lib_overrides_recursive_resync;
+  /** Replacing the current #Main and the rest of the setup of the new one. */
+  double setup;
+  /** Post-read handling in the window-manager (e.g. application handlers). */
+  double post;
+};
+
 struct BlendFileReadReport {
   /** General reports handling. */
   ReportList *reports;
 
   /** Timing information. */
-  struct {
-    double whole;
-    double libraries;
-    double lib_overrides;
-    double lib_overrides_resync;
-    double lib_overrides_recursive_resync;
-  } duration;
+  BlendFileReadDurations duration;
 
   /** Count information. */
   struct {
@@ -12,6 +12,7 @@
 #include "BLI_filereader.h"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
+#include "BLI_span.hh"
 
 namespace blender {
 class ImplicitSharingInfo;
@@ -43,6 +44,11 @@ struct MemFileChunk {
   /** Session UID of the ID being currently written (MAIN_ID_SESSION_UID_UNSET when not writing
    * ID-related data). Used to find matching chunks in previous memundo step. */
   uint id_session_uid;
+  /**
+   * When not zero, #buf is zstd compressed and this is its size, see #BLO_memfile_compress.
+   * Chunks sharing the same buffer are always compressed together.
+   */
+  size_t compressed_size;
 };
 
 struct MemFile {
@@ -109,6 +115,22 @@ void BLO_memfile_merge(MemFile *first, MemFile *second);
  */
 void BLO_memfile_clear_future(MemFile *memfile);
 
+/**
+ * Compress the chunk buffers of `memfiles[index]` which are not used by any later memfile anymore
+ * (i.e. not by `memfiles[index + 1]`), in all memfiles sharing them.
+ * Used to reduce the memory usage of old undo steps, which are unlikely to be read again.
+ *
+ * \param memfiles: All memfiles sharing chunks, from oldest to newest.
+ */
+void BLO_memfile_compress(blender::Span<MemFile *> memfiles, int64_t index);
+/**
+ * Decompress all compressed chunk buffers used by `memfiles[index]`, so that it can be read or
+ * used as reference for writing a new memfile again.
+ *
+ * \param memfiles: All memfiles sharing chunks, from oldest to newest.
+ */
+void BLO_memfile_decompress(blender::Span<MemFile *> memfiles, int64_t index);
+
 /* Utilities. */
 
 Main *BLO_memfile_main_get(MemFile *memfile, Main *bmain, Scene **r_scene);
@@ -9,6 +9,7 @@
  * \brief external `writefile.cc` function prototypes.
  */
 
+struct BlendFileDeferredWrite;
 struct BlendThumbnail;
 struct Main;
 struct MemFile;
@@ -59,4 +60,28 @@ extern bool BLO_write_file(Main *mainvar,
  */
 extern bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, int write_flags);
 
+/**
+ * Serialize \a mainvar into memory, without writing anything to disk yet. This allows to do the
+ * (possibly slow) actual file writing and compression in a background thread, while \a mainvar
+ * can be modified again, see #BLO_write_file_deferred_finish.
+ *
+ * \return The serialized data, or null on failure.
+ */
+extern BlendFileDeferredWrite *BLO_write_file_deferred_begin(Main *mainvar,
+                                                             const char *filepath,
+                                                             int write_flags,
+                                                             const BlendFileWriteParams *params,
+                                                             ReportList *reports);
+/**
+ * Write the data serialized by #BLO_write_file_deferred_begin to disk.
+ * Does not access any #Main, so it can be called from any thread.
+ *
+ * \param r_progress: Optionally updated with the written fraction of the file.
+ * \return Success.
+ */
+extern bool BLO_write_file_deferred_finish(const BlendFileDeferredWrite *deferred_write,
+                                           ReportList *reports,
+                                           float *r_progress);
+extern void BLO_write_file_deferred_free(BlendFileDeferredWrite *deferred_write);
+
 /** \} */
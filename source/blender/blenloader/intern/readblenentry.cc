@@ -19,6 +19,7 @@
 #include "BLI_linklist.h"
 #include "BLI_path_util.h" /* Only for assertions. */
 #include "BLI_string.h"
+#include "BLI_timeit.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_genfile.h"
@@ -305,6 +306,7 @@ BlendFileData *BLO_read_from_file(const char *filepath,
 {
   BLI_assert(!BLI_path_is_rel(filepath));
   BLI_assert(BLI_path_is_abs_from_cwd(filepath));
+  SCOPED_TIMER_STATS("Read Blend File");
 
   BlendFileData *bfd = nullptr;
   FileData *fd;
@@ -57,9 +57,12 @@
 #include "BLI_linklist.h"
 #include "BLI_map.hh"
 #include "BLI_memarena.h"
+#include "BLI_mmap.h"
 #include "BLI_mempool.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -85,6 +88,7 @@
 #include "BKE_node.hh" /* for tree type defines */
 #include "BKE_object.hh"
 #include "BKE_packedFile.hh"
+#include "BKE_preview_image.hh"
 #include "BKE_preferences.h"
 #include "BKE_report.hh"
 #include "BKE_scene.hh"
@@ -177,6 +181,28 @@
 /** Use #GHash for restoring pointers by name. */
 #define USE_GHASH_RESTORE_POINTER
 
+/**
+ * Reconstruct the DNA of the data-blocks belonging to a single ID in parallel, when there are
+ * enough of them that need actual conversion (see #read_data_into_datamap).
+ */
+#define USE_PARALLEL_DATA_RECONSTRUCT
+
+/**
+ * Reference large arrays directly from memory-mapped blend-files when they are read through
+ * #BLO_read_mapped_data, instead of copying them into new allocations. Their content is only read
+ * when regular reading functions ask for it.
+ *
+ * \note Disabled in debug builds, since checks relying on guarded allocations
+ * (e.g. #MEM_allocN_len) would fail on such data. Also disabled on WIN32, where a file cannot be
+ * replaced (e.g. when saving over it) while it is still mapped.
+ */
+#if defined(NDEBUG) && !defined(WIN32) && defined(USE_BHEAD_READ_ON_DEMAND) && \
+    defined(USE_PARALLEL_DATA_RECONSTRUCT)
+#  define USE_MMAP_SHARED_DATA
+/** Smaller arrays share memory pages with other data, and are not worth referencing. */
+#  define MMAP_SHARED_DATA_MIN_SIZE (64 * 1024)
+#endif
+
 static CLG_LogRef LOG = {"blo.readfile"};
 static CLG_LogRef LOG_UNDO = {"blo.readfile.undo"};
 
@@ -248,8 +274,17 @@ struct NewAddress {
   int nr;
 };
 
+/** Data-block which content is not read yet, see #USE_MMAP_SHARED_DATA. */
+struct DeferredData {
+  BHead *bhead;
+  const char *allocname;
+  int id_type_index;
+};
+
 struct OldNewMap {
   blender::Map<const void *, NewAddress> map;
+  /** Only used by #FileData.datamap. */
+  blender::Map<const void *, DeferredData> deferred;
 };
 
 static OldNewMap *oldnewmap_new()
@@ -318,6 +353,7 @@ static void oldnewmap_clear(OldNewMap *onm)
     }
   }
   onm->map.clear_and_shrink();
+  onm->deferred.clear();
 }
 
 static void oldnewmap_free(OldNewMap *onm)
@@ -617,6 +653,9 @@ struct BlendDataReader {
    * corresponding value is the shared data at run-time.
    */
   blender::Map<const void *, blender::ImplicitSharingInfoAndData> shared_data_by_stored_address;
+
+  /** Library of the ID being read, null for local data. */
+  Library *library = nullptr;
 };
 
 struct BlendLibReader {
@@ -1450,15 +1489,47 @@ short BLO_version_from_file(const char *filepath)
  * \{ */
 
 /* Only direct data-blocks. */
+#ifdef USE_MMAP_SHARED_DATA
+/**
+ * Read a data-block which has not been referenced from the memory-mapped file, for consumers that
+ * need their own copy of it.
+ */
+static void *datamap_read_deferred(FileData *fd, const void *adr, const bool increase_users)
+{
+  const std::optional<DeferredData> deferred = fd->datamap->deferred.pop_try(adr);
+  if (!deferred) {
+    return nullptr;
+  }
+  void *data = read_struct(fd, deferred->bhead, deferred->allocname, deferred->id_type_index);
+  if (data == nullptr) {
+    return nullptr;
+  }
+  oldnewmap_insert(fd->datamap, adr, data, 0);
+  return oldnewmap_lookup_and_inc(fd->datamap, adr, increase_users);
+}
+#endif
+
 static void *newdataadr(FileData *fd, const void *adr)
 {
-  return oldnewmap_lookup_and_inc(fd->datamap, adr, true);
+  void *new_address = oldnewmap_lookup_and_inc(fd->datamap, adr, true);
+#ifdef USE_MMAP_SHARED_DATA
+  if (new_address == nullptr && adr != nullptr) {
+    new_address = datamap_read_deferred(fd, adr, true);
+  }
+#endif
+  return new_address;
 }
 
 /* Only direct data-blocks. */
 static void *newdataadr_no_us(FileData *fd, const void *adr)
 {
-  return oldnewmap_lookup_and_inc(fd->datamap, adr, false);
+  void *new_address = oldnewmap_lookup_and_inc(fd->datamap, adr, false);
+#ifdef USE_MMAP_SHARED_DATA
+  if (new_address == nullptr && adr != nullptr) {
+    new_address = datamap_read_deferred(fd, adr, false);
+  }
+#endif
+  return new_address;
 }
 
 void *blo_read_get_new_globaldata_address(FileData *fd, const void *adr)
@@ -2423,6 +2494,7 @@ static bool direct_link_id(FileData *fd, Main *main, const int tag, ID *id, ID *
   /* Sharing is only allowed within individual data-blocks currently. The clearing is done
    * explicitly here, in case the `reader` is used by multiple IDs in the future. */
   reader.shared_data_by_stored_address.clear();
+  reader.library = main->curlib;
 
   /* Read part of datablock that is common between real and embedded datablocks. */
   direct_link_id_common(&reader, main->curlib, id, id_old, tag);
@@ -2438,6 +2510,11 @@ static bool direct_link_id(FileData *fd, Main *main, const int tag, ID *id, ID *
     id_type->blend_read_data(&reader, id);
   }
 
+  if (reader.library != nullptr && !BLO_read_data_is_undo(&reader)) {
+    /* Pixels of linked previews are not read, see #BKE_previewimg_blend_read. */
+    BKE_previewimg_id_deferred_library_set(id);
+  }
+
   /* XXX Very weakly handled currently, see comment in read_libblock() before trying to
    * use it for anything new. */
   bool success = true;
@@ -2463,6 +2540,155 @@ static bool direct_link_id(FileData *fd, Main *main, const int tag, ID *id, ID *
   return success;
 }
 
+#ifdef USE_PARALLEL_DATA_RECONSTRUCT
+
+/** Minimum amount of data-blocks needing DNA conversion to go through the threaded code-path. */
+#  define PARALLEL_RECONSTRUCT_MIN_BLOCKS 32
+
+/**
+ * Whether reading the given data-block requires more than a plain copy of its content, i.e. an
+ * endian switch or a DNA reconstruction.
+ */
+static bool read_struct_needs_conversion(const FileData *fd, const BHead *bh)
+{
+  if (bh->len == 0 || fd->compflags[bh->SDNAnr] == SDNA_CMP_REMOVED) {
+    return false;
+  }
+  if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+    return true;
+  }
+  return (bh->SDNAnr > SDNA_RAW_DATA_STRUCT_INDEX) && (fd->flags & FD_FLAGS_SWITCH_ENDIAN);
+}
+
+/**
+ * Same as #read_struct for a #BHead which data is already in memory, but without accessing the
+ * file or the allocation name storage, so that it can be called from multiple threads.
+ */
+static void *read_struct_loaded(FileData *fd, BHead *bh, const char *alloc_name)
+{
+  if (bh->SDNAnr > SDNA_RAW_DATA_STRUCT_INDEX && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
+    switch_endian_structs(fd->filesdna, bh);
+  }
+  if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+    return DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1), alloc_name);
+  }
+  const int alignment = DNA_struct_alignment(fd->filesdna, bh->SDNAnr);
+  void *temp = MEM_mallocN_aligned(bh->len, alignment, alloc_name);
+  memcpy(temp, (bh + 1), bh->len);
+  return temp;
+}
+
+/**
+ * Read all data-blocks (`bheads`) of an ID, converting those which differ from the current DNA
+ * in parallel. File access (for blocks read on demand) and allocation names lookup remain
+ * single-threaded.
+ *
+ * 
+eturn false when too few data-blocks need conversion to make threading worth it. In that
+ * case nothing has been read, and the caller is expected to use #read_struct instead.
+ */
+static bool read_data_structs_parallel(FileData *fd,
+                                       const blender::Span<BHead *> bheads,
+                                       const char *allocname,
+                                       const int id_type_index,
+                                       blender::MutableSpan<void *> r_data)
+{
+  using namespace blender;
+
+  if (bheads.size() < PARALLEL_RECONSTRUCT_MIN_BLOCKS) {
+    return false;
+  }
+  Vector<int64_t> convert_indices;
+  for (const int64_t i : bheads.index_range()) {
+    if (read_struct_needs_conversion(fd, bheads[i])) {
+      convert_indices.append(i);
+    }
+  }
+  if (convert_indices.size() < PARALLEL_RECONSTRUCT_MIN_BLOCKS) {
+    return false;
+  }
+
+  /* Blocks only needing a copy are read directly, this also avoids a temporary buffer for the
+   * blocks read on demand. */
+  r_data.fill(nullptr);
+  for (const int64_t i : bheads.index_range()) {
+    if (!read_struct_needs_conversion(fd, bheads[i])) {
+      r_data[i] = read_struct(fd, bheads[i], allocname, id_type_index);
+    }
+  }
+
+  Array<BHead *> loaded_bheads(convert_indices.size());
+  Array<const char *> alloc_names(convert_indices.size());
+  for (const int64_t i : convert_indices.index_range()) {
+    BHead *bh = bheads[convert_indices[i]];
+    alloc_names[i] = get_alloc_name(fd, bh, allocname, id_type_index);
+#  ifdef USE_BHEAD_READ_ON_DEMAND
+    if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
+      bh = blo_bhead_read_full(fd, bh);
+      if (UNLIKELY(bh == nullptr)) {
+        fd->flags &= ~FD_FLAGS_FILE_OK;
+      }
+    }
+#  endif
+    loaded_bheads[i] = bh;
+  }
+
+  threading::parallel_for(convert_indices.index_range(), 8, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      if (loaded_bheads[i] != nullptr) {
+        r_data[convert_indices[i]] = read_struct_loaded(fd, loaded_bheads[i], alloc_names[i]);
+      }
+    }
+  });
+
+#  ifdef USE_BHEAD_READ_ON_DEMAND
+  for (const int64_t i : convert_indices.index_range()) {
+    if (loaded_bheads[i] != nullptr && loaded_bheads[i] != bheads[convert_indices[i]]) {
+      MEM_freeN(BHEADN_FROM_BHEAD(loaded_bheads[i]));
+    }
+  }
+#  endif
+  return true;
+}
+
+#endif /* USE_PARALLEL_DATA_RECONSTRUCT */
+
+#ifdef USE_MMAP_SHARED_DATA
+
+/**
+ * Whether the data-block content can be used as is from the memory-mapped file, in which case
+ * reading it is deferred until it's known whether it's referenced or copied.
+ */
+static bool read_data_can_be_mapped(FileData *fd, BHead *bhead)
+{
+  const BHeadN *bheadn = BHEADN_FROM_BHEAD(bhead);
+  if (bhead->len < MMAP_SHARED_DATA_MIN_SIZE || bheadn->has_data) {
+    return false;
+  }
+  if (fd->compflags[bhead->SDNAnr] != SDNA_CMP_EQUAL || (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
+    return false;
+  }
+  if (BLI_filereader_get_mmap(fd->file) == nullptr) {
+    return false;
+  }
+  /* The mapping starts at a page boundary, so the file offset defines the alignment. */
+  const int alignment = DNA_struct_alignment(fd->filesdna, bhead->SDNAnr);
+  return (bheadn->file_offset % alignment) == 0;
+}
+
+#endif /* USE_MMAP_SHARED_DATA */
+
+static void read_data_into_datamap_insert(FileData *fd, const BHead *bhead, void *data)
+{
+  const bool is_new = oldnewmap_insert(fd->datamap, bhead->old, data, 0);
+  if (!is_new) {
+    CLOG_ERROR(&LOG,
+               "Blendfile corruption: Invalid, or multiple `bhead` with same old address "
+               "value (%p) for a given ID.",
+               bhead->old);
+  }
+}
+
 /* Read all data associated with a datablock into datamap. */
 static BHead *read_data_into_datamap(FileData *fd,
                                      BHead *bhead,
@@ -2471,16 +2697,44 @@ static BHead *read_data_into_datamap(FileData *fd,
 {
   bhead = blo_bhead_next(fd, bhead);
 
+#ifdef USE_PARALLEL_DATA_RECONSTRUCT
+  /* Undo always uses the current DNA, so there is nothing to reconstruct. */
+  if ((fd->flags & FD_FLAGS_IS_MEMFILE) == 0) {
+    blender::Vector<BHead *> bheads;
+    for (; bhead && bhead->code == BLO_CODE_DATA; bhead = blo_bhead_next(fd, bhead)) {
+#  ifdef USE_MMAP_SHARED_DATA
+      if (read_data_can_be_mapped(fd, bhead)) {
+        if (!fd->datamap->deferred.add(bhead->old, {bhead, allocname, id_type_index})) {
+          CLOG_ERROR(&LOG,
+                     "Blendfile corruption: Invalid, or multiple `bhead` with same old address "
+                     "value (%p) for a given ID.",
+                     bhead->old);
+        }
+        continue;
+      }
+#  endif
+      bheads.append(bhead);
+    }
+    blender::Array<void *> data(bheads.size());
+    if (!read_data_structs_parallel(fd, bheads, allocname, id_type_index, data)) {
+      for (const int64_t i : bheads.index_range()) {
+        data[i] = read_struct(fd, bheads[i], allocname, id_type_index);
+      }
+    }
+    /* Inserting into the map is kept in file order, for deterministic handling of duplicates. */
+    for (const int64_t i : bheads.index_range()) {
+      if (data[i]) {
+        read_data_into_datamap_insert(fd, bheads[i], data[i]);
+      }
+    }
+    return bhead;
+  }
+#endif
+
   while (bhead && bhead->code == BLO_CODE_DATA) {
     void *data = read_struct(fd, bhead, allocname, id_type_index);
     if (data) {
-      const bool is_new = oldnewmap_insert(fd->datamap, bhead->old, data, 0);
-      if (!is_new) {
-        CLOG_ERROR(&LOG,
-                   "Blendfile corruption: Invalid, or multiple `bhead` with same old address "
-                   "value (%p) for a given ID.",
-                   bhead->old);
-      }
+      read_data_into_datamap_insert(fd, bhead, data);
     }
 
     bhead = blo_bhead_next(fd, bhead);
@@ -3104,10 +3358,27 @@ static void do_versions_userdef(FileData * /*fd*/, BlendFileData *bfd)
   blo_do_versions_userdef(user);
 }
 
+/**
+ * Whether versioning code only handling files older than \a version_next and
+ * \a subversion_next may affect \a main. Allows to skip whole versioning passes (which often loop
+ * over many data-blocks) for recent files.
+ *
+ * \note The given version must be newer than the most recent version check done in the skipped
+ * versioning code.
+ */
+static bool do_versions_needed(const Main *main,
+                               const int version_next,
+                               const int subversion_next)
+{
+  return !MAIN_VERSION_FILE_ATLEAST(main, version_next, subversion_next);
+}
+
 static void do_versions(FileData *fd, Library *lib, Main *main)
 {
   /* WATCH IT!!!: pointers from libdata have not been converted */
 
+  const double time_start = BLI_time_now_seconds();
+
   /* Don't allow versioning to create new data-blocks. */
   main->is_locked_for_linking = true;
 
@@ -3132,37 +3403,54 @@ static void do_versions(FileData *fd, Library *lib, Main *main)
               main->build_hash);
   }
 
-  if (!main->is_read_invalid) {
+  /* Versioning code of older release series only affects older files, skip it entirely for more
+   * recent files. */
+  if (!main->is_read_invalid && do_versions_needed(main, 250, 0)) {
     blo_do_versions_pre250(fd, lib, main);
   }
-  if (!main->is_read_invalid) {
+  if (!main->is_read_invalid && do_versions_needed(main, 260, 0)) {
     blo_do_versions_250(fd, lib, main);
   }
-  if (!main->is_read_invalid) {
+  if (!main->is_read_invalid && do_versions_needed(main, 280, 60)) {
     blo_do_versions_260(fd, lib, main);
   }
-  if (!main->is_read_invalid) {
+  if (!main->is_read_invalid && do_versions_needed(main, 280, 0)) {
     blo_do_versions_270(fd, lib, main);
   }
-  if (!main->is_read_invalid) {
+  if (!main->is_read_invalid && do_versions_needed(main, 300, 39)) {
     blo_do_versions_280(fd, lib, main);
   }
-  if (!main->is_read_invalid) {
+  if (!main->is_read_invalid && do_versions_needed(main, 300, 0)) {
     blo_do_versions_290(fd, lib, main);
   }
-  if (!main->is_read_invalid) {
+  if (!main->is_read_invalid && do_versions_needed(main, 400, 0)) {
     blo_do_versions_300(fd, lib, main);
   }
+  /* Always run, this also contains the versioning code of the current release. */
   if (!main->is_read_invalid) {
     blo_do_versions_400(fd, lib, main);
   }
 
+  /* Files from 2.80 on do get a valid `win->screen` pointer written for backward compatibility,
+   * however this should never be used nor needed, so clear these pointers here. */
+  if (MAIN_VERSION_FILE_ATLEAST(main, 280, 1)) {
+    LISTBASE_FOREACH (wmWindowManager *, wm, &main->wm) {
+      LISTBASE_FOREACH (wmWindow *, win, &wm->windows) {
+        win->screen = nullptr;
+      }
+    }
+  }
+
   /* WATCH IT!!!: pointers from libdata have not been converted yet here! */
   /* WATCH IT 2!: Userdef struct init see do_versions_userdef() above! */
 
   /* don't forget to set version number in BKE_blender_version.h! */
 
   main->is_locked_for_linking = false;
+
+  if (fd->reports) {
+    fd->reports->duration.versioning += BLI_time_now_seconds() - time_start;
+  }
 }
 
 static void do_versions_after_linking(FileData *fd, Main *main)
@@ -3177,25 +3465,28 @@ static void do_versions_after_linking(FileData *fd, Main *main)
             main->versionfile,
             main->subversionfile);
 
+  const double time_start = BLI_time_now_seconds();
+
   /* Don't allow versioning to create new data-blocks. */
   main->is_locked_for_linking = true;
 
-  if (!main->is_read_invalid) {
+  /* See #do_versions for the skipped versioning passes. */
+  if (!main->is_read_invalid && do_versions_needed(main, 260, 0)) {
     do_versions_after_linking_250(main);
   }
-  if (!main->is_read_invalid) {
+  if (!main->is_read_invalid && do_versions_needed(main, 270, 0)) {
     do_versions_after_linking_260(main);
   }
-  if (!main->is_read_invalid) {
+  if (!main->is_read_invalid && do_versions_needed(main, 280, 0)) {
     do_versions_after_linking_270(main);
   }
-  if (!main->is_read_invalid) {
+  if (!main->is_read_invalid && do_versions_needed(main, 300, 39)) {
     do_versions_after_linking_280(fd, main);
   }
-  if (!main->is_read_invalid) {
+  if (!main->is_read_invalid && do_versions_needed(main, 300, 0)) {
     do_versions_after_linking_290(fd, main);
   }
-  if (!main->is_read_invalid) {
+  if (!main->is_read_invalid && do_versions_needed(main, 400, 0)) {
     do_versions_after_linking_300(fd, main);
   }
   if (!main->is_read_invalid) {
@@ -3203,6 +3494,10 @@ static void do_versions_after_linking(FileData *fd, Main *main)
   }
 
   main->is_locked_for_linking = false;
+
+  if (fd->reports) {
+    fd->reports->duration.versioning += BLI_time_now_seconds() - time_start;
+  }
 }
 
 /** \} */
@@ -3580,6 +3875,8 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     read_undo_reuse_noundo_local_ids(fd);
   }
 
+  fd->reports->duration.read_data = BLI_time_now_seconds();
+
   while (bhead) {
     switch (bhead->code) {
       case BLO_CODE_DATA:
@@ -3635,6 +3932,8 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     }
   }
 
+  fd->reports->duration.read_data = BLI_time_now_seconds() - fd->reports->duration.read_data;
+
   if (is_undo) {
     /* Move the remaining Library IDs and their linked data to the new main.
      *
@@ -3679,8 +3978,10 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 
     blo_join_main(&mainlist);
 
+    const double lib_link_time_start = BLI_time_now_seconds();
     lib_link_all(fd, bfd->main);
     after_liblink_merged_bmain_process(bfd->main, fd->reports);
+    fd->reports->duration.lib_link = BLI_time_now_seconds() - lib_link_time_start;
 
     if (is_undo) {
       /* Ensure ID usages of reused 'no undo' IDs remain valid. */
@@ -5085,6 +5386,54 @@ blender::ImplicitSharingInfoAndData blo_read_shared_impl(
   return shared_data;
 }
 
+#ifdef USE_MMAP_SHARED_DATA
+namespace {
+/** Keeps the memory-mapped file alive for as long as data referencing it is used. */
+class MappedDataSharingInfo : public blender::ImplicitSharingInfo {
+ private:
+  BLI_mmap_file *mmap_file_;
+
+ public:
+  MappedDataSharingInfo(BLI_mmap_file *mmap_file) : mmap_file_(mmap_file)
+  {
+    BLI_mmap_add_user(mmap_file_);
+  }
+
+ private:
+  void delete_self_with_data() override
+  {
+    BLI_mmap_free(mmap_file_);
+    MEM_delete(this);
+  }
+};
+}  // namespace
+#endif
+
+const blender::ImplicitSharingInfo *BLO_read_mapped_data(BlendDataReader *reader,
+                                                         void **ptr_p,
+                                                         const size_t expected_size)
+{
+#ifdef USE_MMAP_SHARED_DATA
+  FileData *fd = reader->fd;
+  const DeferredData *deferred = fd->datamap->deferred.lookup_ptr(*ptr_p);
+  if (deferred == nullptr) {
+    return nullptr;
+  }
+  const BHead *bhead = deferred->bhead;
+  if (size_t(bhead->len) < expected_size) {
+    /* Let the regular reading code handle corrupted data. */
+    return nullptr;
+  }
+  BLI_mmap_file *mmap_file = BLI_filereader_get_mmap(fd->file);
+  *ptr_p = POINTER_OFFSET(BLI_mmap_get_pointer(mmap_file),
+                          BHEADN_FROM_BHEAD(bhead)->file_offset);
+  return MEM_new<MappedDataSharingInfo>(__func__, mmap_file);
+#else
+  UNUSED_VARS(reader, ptr_p, expected_size);
+  return nullptr;
+#endif
+}
+
 bool BLO_read_data_is_undo(BlendDataReader *reader)
 {
   return (reader->fd->flags & FD_FLAGS_IS_MEMFILE);
@@ -5100,6 +5449,11 @@ void BLO_read_glob_list(BlendDataReader *reader, ListBase *list)
   link_glob_list(reader->fd, list);
 }
 
+Library *BLO_read_data_current_library(BlendDataReader *reader)
+{
+  return reader->library;
+}
+
 BlendFileReadReport *BLO_read_data_reports(BlendDataReader *reader)
 {
   return reader->fd->reports;
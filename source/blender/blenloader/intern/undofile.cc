@@ -24,8 +24,12 @@
 
 #include "DNA_listBase.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_implicit_sharing.hh"
+#include "BLI_set.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "BLO_readfile.hh"
 #include "BLO_undofile.hh"
@@ -34,6 +38,8 @@
 #include "BKE_main.hh"
 #include "BKE_undo_system.hh"
 
+#include <zstd.h>
+
 #include "BLI_strict_flags.h" /* Keep last. */
 
 /* **************** support for memory-write, for undo buffers *************** */
@@ -143,6 +149,7 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
    * will then not be undo. Though it's not entirely clear that is wrong behavior. */
   curchunk->is_identical_future = true;
   curchunk->id_session_uid = mem_data->current_id_session_uid;
+  curchunk->compressed_size = 0;
   BLI_addtail(&memfile->chunks, curchunk);
 
   /* we compare compchunk with buf */
@@ -167,6 +174,139 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   }
 }
 
+/* **************** compression of old undo buffers *************** */
+
+/* Compression speed matters more than ratio here, since it happens on undo pushes. */
+#define MEMFILE_COMPRESSION_LEVEL 1
+
+/**
+ * Replace the buffers of all chunks in \a memfiles using one of the keys of \a new_buffers,
+ * freeing the replaced buffers and updating the memory usage of their owner memfile.
+ */
+static void memfile_chunk_buffers_replace(
+    blender::Span<MemFile *> memfiles,
+    const blender::Map<const char *, std::pair<const char *, size_t>> &new_buffers)
+{
+  blender::Vector<const char *> buffers_to_free;
+  for (MemFile *memfile : memfiles) {
+    LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+      const std::pair<const char *, size_t> *new_buffer = new_buffers.lookup_ptr(chunk->buf);
+      if (new_buffer == nullptr) {
+        continue;
+      }
+      if (!chunk->is_identical) {
+        const size_t old_size = chunk->compressed_size ? chunk->compressed_size : chunk->size;
+        const size_t new_size = new_buffer->second ? new_buffer->second : chunk->size;
+        memfile->size = memfile->size - old_size + new_size;
+        buffers_to_free.append(chunk->buf);
+      }
+      chunk->buf = new_buffer->first;
+      chunk->compressed_size = new_buffer->second;
+    }
+  }
+  /* Only free at the end, so that freed addresses cannot match any new buffer address. */
+  for (const char *buf : buffers_to_free) {
+    MEM_freeN((void *)buf);
+  }
+}
+
+void BLO_memfile_compress(blender::Span<MemFile *> memfiles, const int64_t index)
+{
+  using namespace blender;
+  MemFile *memfile = memfiles[index];
+
+  /* Buffers still used by the next memfile are kept as is, they will be compressed when that
+   * memfile gets compressed. */
+  Set<const char *> buffers_used_later;
+  if (index + 1 < memfiles.size()) {
+    LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfiles[index + 1]->chunks) {
+      if (chunk->is_identical) {
+        buffers_used_later.add(chunk->buf);
+      }
+    }
+  }
+
+  Vector<const MemFileChunk *> chunks_to_compress;
+  Set<const char *> buffers_to_compress;
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    if (chunk->compressed_size == 0 && !buffers_used_later.contains(chunk->buf) &&
+        buffers_to_compress.add(chunk->buf))
+    {
+      chunks_to_compress.append(chunk);
+    }
+  }
+  if (chunks_to_compress.is_empty()) {
+    return;
+  }
+
+  Array<std::pair<const char *, size_t>> compressed_buffers(chunks_to_compress.size());
+  threading::parallel_for(chunks_to_compress.index_range(), 16, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const MemFileChunk *chunk = chunks_to_compress[i];
+      const size_t out_buf_len = ZSTD_compressBound(chunk->size);
+      void *out_buf = MEM_mallocN(out_buf_len, "MemFileChunk compressed buffer");
+      const size_t out_size = ZSTD_compress(
+          out_buf, out_buf_len, chunk->buf, chunk->size, MEMFILE_COMPRESSION_LEVEL);
+      if (ZSTD_isError(out_size) || out_size >= chunk->size) {
+        /* Not worth it, keep the uncompressed data. */
+        MEM_freeN(out_buf);
+        compressed_buffers[i] = {nullptr, 0};
+        continue;
+      }
+      compressed_buffers[i] = {static_cast<const char *>(MEM_reallocN(out_buf, out_size)),
+                               out_size};
+    }
+  });
+
+  Map<const char *, std::pair<const char *, size_t>> new_buffers;
+  for (const int64_t i : chunks_to_compress.index_range()) {
+    if (compressed_buffers[i].first != nullptr) {
+      new_buffers.add_new(chunks_to_compress[i]->buf, compressed_buffers[i]);
+    }
+  }
+
+  /* All other users of these buffers are in this memfile and older ones. */
+  memfile_chunk_buffers_replace(memfiles.take_front(index + 1), new_buffers);
+}
+
+void BLO_memfile_decompress(blender::Span<MemFile *> memfiles, const int64_t index)
+{
+  using namespace blender;
+  MemFile *memfile = memfiles[index];
+
+  Vector<const MemFileChunk *> chunks_to_decompress;
+  Set<const char *> buffers_to_decompress;
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    if (chunk->compressed_size != 0 && buffers_to_decompress.add(chunk->buf)) {
+      chunks_to_decompress.append(chunk);
+    }
+  }
+  if (chunks_to_decompress.is_empty()) {
+    return;
+  }
+
+  Array<const char *> decompressed_buffers(chunks_to_decompress.size());
+  threading::parallel_for(chunks_to_decompress.index_range(), 16, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const MemFileChunk *chunk = chunks_to_decompress[i];
+      char *out_buf = static_cast<char *>(MEM_mallocN(chunk->size, "Chunk buffer"));
+      const size_t out_size = ZSTD_decompress(
+          out_buf, chunk->size, chunk->buf, chunk->compressed_size);
+      BLI_assert(out_size == chunk->size);
+      UNUSED_VARS_NDEBUG(out_size);
+      decompressed_buffers[i] = out_buf;
+    }
+  });
+
+  Map<const char *, std::pair<const char *, size_t>> new_buffers;
+  for (const int64_t i : chunks_to_decompress.index_range()) {
+    new_buffers.add_new(chunks_to_decompress[i]->buf, {decompressed_buffers[i], 0});
+  }
+
+  /* The other users of these buffers can be older as well as newer memfiles. */
+  memfile_chunk_buffers_replace(memfiles, new_buffers);
+}
+
 Main *BLO_memfile_main_get(MemFile *memfile, Main *bmain, Scene **r_scene)
 {
   Main *bmain_undo = nullptr;
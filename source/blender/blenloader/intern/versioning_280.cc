@@ -3205,16 +3205,6 @@ void blo_do_versions_280(FileData *fd, Library * /*lib*/, Main *bmain)
     }
   }
 
-  /* Files from this version included do get a valid `win->screen` pointer written for backward
-   * compatibility, however this should never be used nor needed, so clear these pointers here. */
-  if (MAIN_VERSION_FILE_ATLEAST(bmain, 280, 1)) {
-    LISTBASE_FOREACH (wmWindowManager *, wm, &bmain->wm) {
-      LISTBASE_FOREACH (wmWindow *, win, &wm->windows) {
-        win->screen = nullptr;
-      }
-    }
-  }
-
   if (!MAIN_VERSION_FILE_ATLEAST(bmain, 280, 3)) {
     /* init grease pencil grids and paper */
     if (!DNA_struct_member_exists(
@@ -4699,7 +4689,7 @@ void blo_do_versions_280(FileData *fd, Library * /*lib*/, Main *bmain)
                          R_MODE_UNUSED_5 | R_MODE_UNUSED_6 | R_MODE_UNUSED_7 | R_MODE_UNUSED_8 |
                          R_MODE_UNUSED_10 | R_MODE_UNUSED_13 | R_MODE_UNUSED_16 |
                          R_MODE_UNUSED_17 | R_MODE_UNUSED_18 | R_MODE_UNUSED_19 |
-                         R_MODE_UNUSED_20 | R_MODE_UNUSED_21 | R_MODE_UNUSED_27);
+                         R_MODE_UNUSED_20 | R_MODE_UNUSED_21 | R_SAVE_ASYNC);
 
       scene->r.scemode &= ~(R_SCEMODE_UNUSED_8 | R_SCEMODE_UNUSED_11 | R_SCEMODE_UNUSED_13 |
                             R_SCEMODE_UNUSED_16 | R_SCEMODE_UNUSED_17 | R_SCEMODE_UNUSED_19);
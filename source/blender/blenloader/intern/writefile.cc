@@ -65,6 +65,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <fcntl.h>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #ifdef WIN32
 #  include "BLI_winstuff.h"
@@ -87,6 +90,7 @@
 #include "DNA_key_types.h"
 #include "DNA_sdna_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_endian_defines.h"
@@ -94,10 +98,13 @@
 #include "BLI_implicit_sharing.hh"
 #include "BLI_link_utils.h"
 #include "BLI_linklist.h"
+#include "BLI_map.hh"
 #include "BLI_math_base.h"
 #include "BLI_mempool.h"
 #include "BLI_set.hh"
 #include "BLI_threads.h"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
 
 #include "MEM_guardedalloc.h" /* MEM_freeN */
 
@@ -130,6 +137,7 @@
 
 #include "readfile.hh"
 
+#include <xxhash.h>
 #include <zstd.h>
 
 /* Make preferences read-only. */
@@ -146,6 +154,12 @@
 
 #define ZSTD_COMPRESSION_LEVEL 3
 
+/**
+ * Upper limit for the compressed frames kept in memory between two saves of the same file,
+ * see #ZstdFrameCache.
+ */
+#define ZSTD_FRAME_CACHE_MAX_SIZE (1 << 28) /* 256mb */
+
 static CLG_LogRef LOG = {"blo.writefile"};
 
 /** Use if we want to store how many bytes have been written to the file. */
@@ -155,13 +169,52 @@ static CLG_LogRef LOG = {"blo.writefile"};
 /** \name Internal Write Wrapper's (Abstracts Compression)
  * \{ */
 
+/** Identifies the uncompressed content of a frame. */
+struct ZstdFrameKey {
+  XXH128_hash_t content_hash;
+  size_t size;
+
+  uint64_t hash() const
+  {
+    return content_hash.low64;
+  }
+
+  friend bool operator==(const ZstdFrameKey &a, const ZstdFrameKey &b)
+  {
+    return XXH128_isEqual(a.content_hash, b.content_hash) && a.size == b.size;
+  }
+};
+
 struct ZstdFrame {
   ZstdFrame *next, *prev;
 
   uint32_t compressed_size;
   uint32_t uncompressed_size;
+
+  ZstdFrameKey key;
+};
+
+/**
+ * Compressed frames of the last compressed save of a file.
+ *
+ * Saving the same file again mostly produces the same uncompressed frames (frame boundaries are
+ * aligned to ID ends, see #mywrite_id_end), so unchanged frames can be written out directly
+ * instead of compressing them again. This makes repeated saves of big files (autosave, manual
+ * saves after small edits) much cheaper, since compression is the most expensive part of
+ * writing compressed files.
+ *
+ * Uses standard containers since the cache can outlive the guarded allocator leak checks.
+ */
+struct ZstdFrameCache {
+  /** File path the frames have been written to. */
+  std::string filepath;
+  blender::Map<ZstdFrameKey, std::vector<char>> frames;
+  size_t total_size = 0;
 };
 
+static ZstdFrameCache g_zstd_frame_cache;
+static std::mutex g_zstd_frame_cache_mutex;
+
 class WriteWrap {
  public:
   virtual bool open(const char *filepath) = 0;
@@ -216,6 +269,11 @@ class ZstdWriteWrap : public WriteWrap {
 
   ListBase frames = {};
 
+  /** Frames of the previous save of the same file, only read while writing. */
+  ZstdFrameCache previous_cache;
+  /** Newly compressed frames, protected by #mutex. */
+  ZstdFrameCache cache;
+
   bool write_error = false;
 
  public:
@@ -230,6 +288,7 @@ class ZstdWriteWrap : public WriteWrap {
   void write_task(ZstdWriteBlockTask *task);
   void write_u32_le(uint32_t val);
   void write_seekable_frames();
+  void cache_update();
 };
 
 struct ZstdWriteWrap::ZstdWriteBlockTask {
@@ -249,10 +308,24 @@ struct ZstdWriteWrap::ZstdWriteBlockTask {
 
 void ZstdWriteWrap::write_task(ZstdWriteBlockTask *task)
 {
-  size_t out_buf_len = ZSTD_compressBound(task->size);
-  void *out_buf = MEM_mallocN(out_buf_len, "Zstd out buffer");
-  size_t out_size = ZSTD_compress(
-      out_buf, out_buf_len, task->data, task->size, ZSTD_COMPRESSION_LEVEL);
+  ZstdFrameKey key;
+  key.content_hash = XXH3_128bits(task->data, task->size);
+  key.size = task->size;
+
+  /* Reuse the compressed data from the previous save when the frame did not change. */
+  const std::vector<char> *cached_frame = previous_cache.frames.lookup_ptr(key);
+
+  void *out_buf = nullptr;
+  size_t out_size;
+  if (cached_frame) {
+    out_size = cached_frame->size();
+  }
+  else {
+    size_t out_buf_len = ZSTD_compressBound(task->size);
+    out_buf = MEM_mallocN(out_buf_len, "Zstd out buffer");
+    out_size = ZSTD_compress(
+        out_buf, out_buf_len, task->data, task->size, ZSTD_COMPRESSION_LEVEL);
+  }
 
   MEM_freeN(task->data);
 
@@ -266,12 +339,21 @@ void ZstdWriteWrap::write_task(ZstdWriteBlockTask *task)
     write_error = true;
   }
   else {
-    if (base_wrap.write(out_buf, out_size)) {
+    const void *out_data = cached_frame ? cached_frame->data() : out_buf;
+    if (base_wrap.write(out_data, out_size)) {
       ZstdFrame *frameinfo = static_cast<ZstdFrame *>(
           MEM_mallocN(sizeof(ZstdFrame), "zstd frameinfo"));
       frameinfo->uncompressed_size = task->size;
       frameinfo->compressed_size = out_size;
+      frameinfo->key = key;
       BLI_addtail(&frames, frameinfo);
+
+      if (!cached_frame && cache.total_size + out_size <= ZSTD_FRAME_CACHE_MAX_SIZE) {
+        const char *out_begin = static_cast<const char *>(out_buf);
+        if (cache.frames.add(key, std::vector<char>(out_begin, out_begin + out_size))) {
+          cache.total_size += out_size;
+        }
+      }
     }
     else {
       write_error = true;
@@ -283,7 +365,9 @@ void ZstdWriteWrap::write_task(ZstdWriteBlockTask *task)
   BLI_mutex_unlock(&mutex);
   BLI_condition_notify_all(&condition);
 
-  MEM_freeN(out_buf);
+  if (out_buf) {
+    MEM_freeN(out_buf);
+  }
 }
 
 bool ZstdWriteWrap::open(const char *filepath)
@@ -292,6 +376,15 @@ bool ZstdWriteWrap::open(const char *filepath)
     return false;
   }
 
+  {
+    std::lock_guard lock(g_zstd_frame_cache_mutex);
+    if (g_zstd_frame_cache.filepath == filepath) {
+      previous_cache = std::move(g_zstd_frame_cache);
+    }
+    g_zstd_frame_cache = {};
+  }
+  cache.filepath = filepath;
+
   /* Leave one thread open for the main writing logic, unless we only have one HW thread. */
   int num_threads = max_ii(1, BLI_system_thread_count() - 1);
   BLI_threadpool_init(&threadpool, ZstdWriteBlockTask::write_task, num_threads);
@@ -351,11 +444,41 @@ bool ZstdWriteWrap::close()
   BLI_condition_end(&condition);
 
   write_seekable_frames();
+  cache_update();
   BLI_freelistN(&frames);
 
   return base_wrap.close() && !write_error;
 }
 
+/**
+ * Keep the frames of this save for the next one: reused frames are moved over from the previous
+ * cache, frames that are not part of the file anymore are discarded.
+ */
+void ZstdWriteWrap::cache_update()
+{
+  if (write_error) {
+    return;
+  }
+
+  LISTBASE_FOREACH (ZstdFrame *, frame, &frames) {
+    if (cache.frames.contains(frame->key)) {
+      continue;
+    }
+    std::vector<char> *cached_frame = previous_cache.frames.lookup_ptr(frame->key);
+    if (cached_frame == nullptr || cache.total_size + cached_frame->size() >
+                                       ZSTD_FRAME_CACHE_MAX_SIZE)
+    {
+      continue;
+    }
+    cache.total_size += cached_frame->size();
+    cache.frames.add_new(frame->key, std::move(*cached_frame));
+  }
+  previous_cache = {};
+
+  std::lock_guard lock(g_zstd_frame_cache_mutex);
+  g_zstd_frame_cache = std::move(cache);
+}
+
 bool ZstdWriteWrap::write(const void *buf, size_t buf_len)
 {
   if (write_error) {
@@ -393,6 +516,32 @@ bool ZstdWriteWrap::write(const void *buf, size_t buf_len)
   return true;
 }
 
+/**
+ * Keeps the written data in memory, so that it can be written to the file later
+ * (see #BLO_write_file_deferred_begin).
+ */
+class MemoryWriteWrap : public WriteWrap {
+ public:
+  blender::Vector<blender::Array<char, 0>> chunks;
+  size_t total_size = 0;
+
+  bool open(const char * /*filepath*/) override
+  {
+    return true;
+  }
+  bool close() override
+  {
+    return true;
+  }
+  bool write(const void *buf, size_t buf_len) override
+  {
+    chunks.append(
+        blender::Array<char, 0>(blender::Span(static_cast<const char *>(buf), int64_t(buf_len))));
+    total_size += buf_len;
+    return true;
+  }
+};
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -668,9 +817,9 @@ static void mywrite_id_begin(WriteData *wd, ID *id)
 }
 
 /**
- * Start writing of data related to a single ID.
+ * End writing of data related to a single ID.
  *
- * Only does something when storing an undo step.
+ * Mostly does something when storing an undo step.
  */
 static void mywrite_id_end(WriteData *wd, ID * /*id*/)
 {
@@ -680,6 +829,11 @@ static void mywrite_id_end(WriteData *wd, ID * /*id*/)
     mywrite_flush(wd);
     wd->mem.current_id_session_uid = MAIN_ID_SESSION_UID_UNSET;
   }
+  else if (wd->buffer.used_len >= wd->buffer.chunk_size) {
+    /* Align compressed frames to ID boundaries, so that an edited ID only changes the frames
+     * around it, and the others can be reused on the next save (see #ZstdFrameCache). */
+    mywrite_flush(wd);
+  }
 
   wd->validation_data.per_id_addresses_set.clear();
   wd->per_id_written_shared_addresses.clear();
@@ -1589,20 +1743,19 @@ static void write_file_main_validate_post(Main *bmain, ReportList *reports)
   }
 }
 
-static bool BLO_write_file_impl(Main *mainvar,
-                                const char *filepath,
-                                const int write_flags,
-                                const BlendFileWriteParams *params,
-                                ReportList *reports,
-                                WriteWrap &ww)
+/**
+ * Write \a mainvar into \a ww, opened at \a tempname.
+ * Does not touch the final file yet, see #write_file_commit.
+ */
+static bool write_file_serialize(Main *mainvar,
+                                 const char *filepath,
+                                 const char *tempname,
+                                 const int write_flags,
+                                 const BlendFileWriteParams *params,
+                                 ReportList *reports,
+                                 WriteWrap &ww)
 {
-  BLI_assert(!BLI_path_is_rel(filepath));
-  BLI_assert(BLI_path_is_abs_from_cwd(filepath));
-
-  char tempname[FILE_MAX + 1];
-
   eBLO_WritePathRemap remap_mode = params->remap_mode;
-  const bool use_save_versions = params->use_save_versions;
   const bool use_save_as_copy = params->use_save_as_copy;
   const bool use_userdef = params->use_userdef;
   const BlendThumbnail *thumb = params->thumb;
@@ -1624,8 +1777,6 @@ static bool BLO_write_file_impl(Main *mainvar,
   write_file_main_validate_pre(mainvar, reports);
 
   /* Open temporary file, so we preserve the original in case we crash. */
-  SNPRINTF(tempname, "%s@", filepath);
-
   if (ww.open(tempname) == false) {
     BKE_reportf(
         reports, RPT_ERROR, "Cannot open file %s for writing: %s", tempname, strerror(errno));
@@ -1733,6 +1884,17 @@ static bool BLO_write_file_impl(Main *mainvar,
     return false;
   }
 
+  return true;
+}
+
+/**
+ * Replace the file at \a filepath by the successfully written \a tempname.
+ */
+static bool write_file_commit(const char *filepath,
+                              const char *tempname,
+                              const bool use_save_versions,
+                              ReportList *reports)
+{
   /* File save to temporary file was successful, now do reverse file history
    * (move `.blend1` -> `.blend2`, `.blend` -> `.blend1` .. etc). */
   if (use_save_versions) {
@@ -1747,6 +1909,29 @@ static bool BLO_write_file_impl(Main *mainvar,
     return false;
   }
 
+  return true;
+}
+
+static bool BLO_write_file_impl(Main *mainvar,
+                                const char *filepath,
+                                const int write_flags,
+                                const BlendFileWriteParams *params,
+                                ReportList *reports,
+                                WriteWrap &ww)
+{
+  BLI_assert(!BLI_path_is_rel(filepath));
+  BLI_assert(BLI_path_is_abs_from_cwd(filepath));
+
+  char tempname[FILE_MAX + 1];
+  SNPRINTF(tempname, "%s@", filepath);
+
+  if (!write_file_serialize(mainvar, filepath, tempname, write_flags, params, reports, ww)) {
+    return false;
+  }
+  if (!write_file_commit(filepath, tempname, params->use_save_versions, reports)) {
+    return false;
+  }
+
   write_file_main_validate_post(mainvar, reports);
 
   return true;
@@ -1764,6 +1949,7 @@ bool BLO_write_file(Main *mainvar,
                     const BlendFileWriteParams *params,
                     ReportList *reports)
 {
+  SCOPED_TIMER_STATS("Write Blend File");
   RawWriteWrap raw_wrap;
 
   if (write_flags & G_FILE_COMPRESS) {
@@ -1774,6 +1960,104 @@ bool BLO_write_file(Main *mainvar,
   return BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, raw_wrap);
 }
 
+struct BlendFileDeferredWrite {
+  char filepath[FILE_MAX];
+  char tempname[FILE_MAX + 1];
+  int write_flags;
+  bool use_save_versions;
+  MemoryWriteWrap memory_wrap;
+};
+
+BlendFileDeferredWrite *BLO_write_file_deferred_begin(Main *mainvar,
+                                                      const char *filepath,
+                                                      const int write_flags,
+                                                      const BlendFileWriteParams *params,
+                                                      ReportList *reports)
+{
+  BLI_assert(!BLI_path_is_rel(filepath));
+  BLI_assert(BLI_path_is_abs_from_cwd(filepath));
+
+  BlendFileDeferredWrite *deferred_write = MEM_new<BlendFileDeferredWrite>(__func__);
+  STRNCPY(deferred_write->filepath, filepath);
+  SNPRINTF(deferred_write->tempname, "%s@", filepath);
+  deferred_write->write_flags = write_flags;
+  deferred_write->use_save_versions = params->use_save_versions;
+
+  if (!write_file_serialize(mainvar,
+                            filepath,
+                            deferred_write->tempname,
+                            write_flags,
+                            params,
+                            reports,
+                            deferred_write->memory_wrap))
+  {
+    MEM_delete(deferred_write);
+    return nullptr;
+  }
+
+  write_file_main_validate_post(mainvar, reports);
+
+  return deferred_write;
+}
+
+static bool write_file_deferred_to_disk(const BlendFileDeferredWrite *deferred_write,
+                                        WriteWrap &ww,
+                                        ReportList *reports,
+                                        float *r_progress)
+{
+  const char *tempname = deferred_write->tempname;
+  if (ww.open(tempname) == false) {
+    BKE_reportf(
+        reports, RPT_ERROR, "Cannot open file %s for writing: %s", tempname, strerror(errno));
+    return false;
+  }
+
+  const MemoryWriteWrap &memory_wrap = deferred_write->memory_wrap;
+  bool write_success = true;
+  size_t written_size = 0;
+  for (const blender::Array<char, 0> &chunk : memory_wrap.chunks) {
+    if (!ww.write(chunk.data(), size_t(chunk.size()))) {
+      write_success = false;
+      break;
+    }
+    written_size += size_t(chunk.size());
+    if (r_progress) {
+      *r_progress = float(double(written_size) / double(memory_wrap.total_size));
+    }
+  }
+  if (!ww.close()) {
+    write_success = false;
+  }
+
+  if (!write_success) {
+    BKE_report(reports, RPT_ERROR, strerror(errno));
+    remove(tempname);
+    return false;
+  }
+
+  return write_file_commit(
+      deferred_write->filepath, tempname, deferred_write->use_save_versions, reports);
+}
+
+bool BLO_write_file_deferred_finish(const BlendFileDeferredWrite *deferred_write,
+                                    ReportList *reports,
+                                    float *r_progress)
+{
+  RawWriteWrap raw_wrap;
+
+  if (deferred_write->write_flags & G_FILE_COMPRESS) {
+    ZstdWriteWrap zstd_wrap(raw_wrap);
+    return write_file_deferred_to_disk(deferred_write, zstd_wrap, reports, r_progress);
+  }
+
+  return write_file_deferred_to_disk(deferred_write, raw_wrap, reports, r_progress);
+}
+
+void BLO_write_file_deferred_free(BlendFileDeferredWrite *deferred_write)
+{
+  MEM_delete(deferred_write);
+}
+
 bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, int write_flags)
 {
   bool use_userdef = false;
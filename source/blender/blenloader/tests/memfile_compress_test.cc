@@ -0,0 +1,80 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
+#include "BLI_listbase.h"
+#include "BLI_vector.hh"
+
+#include "BLO_undofile.hh"
+
+namespace blender::blenloader::tests {
+
+static void memfile_write(MemFile *memfile, MemFile *reference, Span<Array<char>> chunks)
+{
+  MemFileWriteData mem_data;
+  BLO_memfile_write_init(&mem_data, memfile, reference);
+  for (const Array<char> &chunk : chunks) {
+    BLO_memfile_chunk_add(&mem_data, chunk.data(), size_t(chunk.size()));
+  }
+  BLO_memfile_write_finalize(&mem_data);
+}
+
+static void expect_memfile_content(const MemFile *memfile, Span<Array<char>> chunks)
+{
+  int64_t i = 0;
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    EXPECT_EQ(chunk->compressed_size, 0);
+    ASSERT_EQ(chunk->size, size_t(chunks[i].size()));
+    EXPECT_EQ(memcmp(chunk->buf, chunks[i].data(), chunk->size), 0);
+    i++;
+  }
+  EXPECT_EQ(i, chunks.size());
+}
+
+TEST(memfile, CompressDecompressShared)
+{
+  Array<char> chunk_a(4096, 'a');
+  Array<char> chunk_b(4096, 'b');
+  Array<char> chunk_c(4096, 'c');
+
+  const Vector<Array<char>> chunks_old = {chunk_a, chunk_b};
+  const Vector<Array<char>> chunks_new = {chunk_a, chunk_c};
+
+  MemFile memfile_old = {};
+  MemFile memfile_new = {};
+  memfile_write(&memfile_old, nullptr, chunks_old);
+  memfile_write(&memfile_new, &memfile_old, chunks_new);
+
+  const MemFileChunk *chunk_new_first = static_cast<const MemFileChunk *>(
+      memfile_new.chunks.first);
+  EXPECT_TRUE(chunk_new_first->is_identical);
+
+  const Vector<MemFile *> memfiles = {&memfile_old, &memfile_new};
+  const size_t size_old = memfile_old.size;
+  BLO_memfile_compress(memfiles, 0);
+
+  /* Only the buffer that is not used by the newer memfile anymore can be compressed. */
+  const MemFileChunk *chunk_old_first = static_cast<const MemFileChunk *>(
+      memfile_old.chunks.first);
+  const MemFileChunk *chunk_old_last = static_cast<const MemFileChunk *>(memfile_old.chunks.last);
+  EXPECT_EQ(chunk_old_first->compressed_size, 0);
+  EXPECT_NE(chunk_old_last->compressed_size, 0);
+  EXPECT_LT(memfile_old.size, size_old);
+  expect_memfile_content(&memfile_new, chunks_new);
+
+  BLO_memfile_decompress(memfiles, 0);
+  EXPECT_EQ(memfile_old.size, size_old);
+  expect_memfile_content(&memfile_old, chunks_old);
+  expect_memfile_content(&memfile_new, chunks_new);
+
+  BLO_memfile_merge(&memfile_old, &memfile_new);
+  expect_memfile_content(&memfile_new, chunks_new);
+  BLO_memfile_free(&memfile_new);
+}
+
+}  // namespace blender::blenloader::tests
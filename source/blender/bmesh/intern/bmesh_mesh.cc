@@ -8,6 +8,8 @@
  * BM mesh level functions.
  */
 
+#include <algorithm>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_listBase.h"
@@ -16,6 +18,7 @@
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_customdata.hh"
 #include "BKE_mesh.hh"
@@ -25,6 +28,8 @@
 using blender::Array;
 using blender::float3;
 using blender::MutableSpan;
+using blender::Span;
+using blender::Vector;
 
 const BMAllocTemplate bm_mesh_allocsize_default = {512, 1024, 2048, 512};
 const BMAllocTemplate bm_mesh_chunksize_default = {512, 1024, 2048, 512};
@@ -1328,6 +1333,100 @@ void BM_mesh_toolflags_set(BMesh *bm, bool use_toolflags)
   bm->use_toolflags = use_toolflags;
 }
 
+/**
+ * Move the attribute blocks of all elements to a new memory pool, in the order of \a headers.
+ */
+static void bm_customdata_pool_compact(CustomData &data,
+                                       const Span<BMHeader *> headers,
+                                       const char htype)
+{
+  if (data.pool == nullptr) {
+    return;
+  }
+  BLI_mempool *pool_src = data.pool;
+  data.pool = nullptr;
+  CustomData_bmesh_init_pool(&data, int(headers.size()), htype);
+  for (BMHeader *head : headers) {
+    if (head->data == nullptr) {
+      continue;
+    }
+    /* Moving the block transfers ownership of any data it references. */
+    void *block = BLI_mempool_alloc(data.pool);
+    memcpy(block, head->data, size_t(data.totsize));
+    head->data = block;
+  }
+  BLI_mempool_destroy(pool_src);
+}
+
+void BM_mesh_compact(BMesh *bm)
+{
+  for (const CustomData *data : {&bm->vdata, &bm->edata, &bm->ldata, &bm->pdata}) {
+    if (CustomData_has_layer(data, CD_BM_ELEM_PYPTR)) {
+      /* Python element wrappers reference the element memory directly. */
+      return;
+    }
+  }
+
+  const BMAllocTemplate allocsize = BMALLOC_TEMPLATE_FROM_BM(bm);
+
+  /* Tool flags are only used during operators and allocated again by them when necessary, so they
+   * don't have to be moved. */
+  BM_mesh_elem_toolflags_clear(bm);
+
+  BLI_mempool *vpool_dst = nullptr;
+  BLI_mempool *epool_dst = nullptr;
+  BLI_mempool *lpool_dst = nullptr;
+  BLI_mempool *fpool_dst = nullptr;
+  bm_mempool_init_ex(
+      &allocsize, bm->use_toolflags, &vpool_dst, &epool_dst, &lpool_dst, &fpool_dst);
+
+  BMeshCreateParams params = {};
+  params.use_toolflags = bm->use_toolflags;
+  BM_mesh_rebuild(bm, &params, vpool_dst, epool_dst, lpool_dst, fpool_dst);
+
+  /* Loop normal spaces reference loops, they are built again when needed. */
+  if (bm->lnor_spacearr) {
+    BKE_lnor_spacearr_free(bm->lnor_spacearr);
+    MEM_freeN(bm->lnor_spacearr);
+    bm->lnor_spacearr = nullptr;
+    bm->spacearr_dirty |= BM_SPACEARR_DIRTY_ALL;
+  }
+
+  /* Gather the elements in iteration order, which is the order of their new memory. */
+  Vector<BMHeader *> headers;
+  headers.reserve(std::max({bm->totvert, bm->totedge, bm->totloop, bm->totface}));
+  BMIter iter;
+  BMVert *v;
+  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
+    headers.append(&v->head);
+  }
+  bm_customdata_pool_compact(bm->vdata, headers, BM_VERT);
+
+  headers.clear();
+  BMEdge *e;
+  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
+    headers.append(&e->head);
+  }
+  bm_customdata_pool_compact(bm->edata, headers, BM_EDGE);
+
+  headers.clear();
+  BMFace *f;
+  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+    BMLoop *l_iter, *l_first;
+    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+    do {
+      headers.append(&l_iter->head);
+    } while ((l_iter = l_iter->next) != l_first);
+  }
+  bm_customdata_pool_compact(bm->ldata, headers, BM_LOOP);
+
+  headers.clear();
+  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+    headers.append(&f->head);
+  }
+  bm_customdata_pool_compact(bm->pdata, headers, BM_FACE);
+}
+
 /* -------------------------------------------------------------------- */
 /** \name BMesh Coordinate Access
  * \{ */
@@ -171,6 +171,17 @@ void BM_mesh_rebuild(BMesh *bm,
                      BLI_mempool *lpool,
                      BLI_mempool *fpool);
 
+/**
+ * Move all elements and their attributes to new memory pools without gaps, keeping their order.
+ * After many elements were removed, this frees unused memory and makes iteration over the
+ * elements more cache friendly.
+ *
+ * \note Tool flags are cleared. Nothing is done while Python references elements of the mesh.
+ * \warning Pointers to elements and their attribute data are invalid afterwards,
+ * as with #BM_mesh_rebuild.
+ */
+void BM_mesh_compact(BMesh *bm);
+
 struct BMAllocTemplate {
   int totvert, totedge, totloop, totface;
 };
@@ -948,144 +948,150 @@ bool BM_face_point_inside_test(const BMFace *f, const float co[3])
   return isect_point_poly_v2(co_2d, projverts, f->len);
 }
 
-void BM_face_triangulate(BMesh *bm,
-                         BMFace *f,
-                         BMFace **r_faces_new,
-                         int *r_faces_new_tot,
-                         BMEdge **r_edges_new,
-                         int *r_edges_new_tot,
-                         LinkNode **r_faces_double,
-                         const int quad_method,
-                         const int ngon_method,
-                         const bool use_tag,
-                         /* use for ngons only! */
-                         MemArena *pf_arena,
-
-                         /* use for MOD_TRIANGULATE_NGON_BEAUTY only! */
-                         Heap *pf_heap)
+void BM_face_triangulate_calc(BMFace *f,
+                              const int quad_method,
+                              const int ngon_method,
+                              BMLoop **loops,
+                              uint (*tris)[3],
+                              MemArena *pf_arena,
+                              Heap *pf_heap)
 {
-  const int cd_loop_mdisp_offset = CustomData_get_offset(&bm->ldata, CD_MDISPS);
   const bool use_beauty = (ngon_method == MOD_TRIANGULATE_NGON_BEAUTY);
-  BMLoop *l_first, *l_new;
-  BMFace *f_new;
-  int nf_i = 0;
-  int ne_i = 0;
+  BMLoop *l_first;
+  int i;
 
   BLI_assert(BM_face_is_normal_valid(f));
-
-  /* ensure both are valid or nullptr */
-  BLI_assert((r_faces_new == nullptr) == (r_faces_new_tot == nullptr));
-
   BLI_assert(f->len > 3);
 
-  {
-    BMLoop **loops = BLI_array_alloca(loops, f->len);
-    uint(*tris)[3] = BLI_array_alloca(tris, f->len);
-    const int totfilltri = f->len - 2;
-    const int last_tri = f->len - 3;
-    int i;
-    /* for mdisps */
-    float f_center[3];
-
-    if (f->len == 4) {
-      /* even though we're not using BLI_polyfill, fill in 'tris' and 'loops'
-       * so we can share code to handle face creation afterwards. */
-      BMLoop *l_v1, *l_v2;
+  if (f->len == 4) {
+    /* even though we're not using BLI_polyfill, fill in 'tris' and 'loops'
+     * so we can share code to handle face creation afterwards. */
+    BMLoop *l_v1, *l_v2;
 
-      l_first = BM_FACE_FIRST_LOOP(f);
+    l_first = BM_FACE_FIRST_LOOP(f);
 
-      switch (quad_method) {
-        case MOD_TRIANGULATE_QUAD_FIXED: {
-          l_v1 = l_first;
-          l_v2 = l_first->next->next;
-          break;
+    switch (quad_method) {
+      case MOD_TRIANGULATE_QUAD_FIXED: {
+        l_v1 = l_first;
+        l_v2 = l_first->next->next;
+        break;
+      }
+      case MOD_TRIANGULATE_QUAD_ALTERNATE: {
+        l_v1 = l_first->next;
+        l_v2 = l_first->prev;
+        break;
+      }
+      case MOD_TRIANGULATE_QUAD_SHORTEDGE:
+      case MOD_TRIANGULATE_QUAD_LONGEDGE:
+      case MOD_TRIANGULATE_QUAD_BEAUTY:
+      default: {
+        BMLoop *l_v3, *l_v4;
+        bool split_24;
+
+        l_v1 = l_first->next;
+        l_v2 = l_first->next->next;
+        l_v3 = l_first->prev;
+        l_v4 = l_first;
+
+        if (quad_method == MOD_TRIANGULATE_QUAD_SHORTEDGE) {
+          float d1, d2;
+          d1 = len_squared_v3v3(l_v4->v->co, l_v2->v->co);
+          d2 = len_squared_v3v3(l_v1->v->co, l_v3->v->co);
+          split_24 = ((d2 - d1) > 0.0f);
         }
-        case MOD_TRIANGULATE_QUAD_ALTERNATE: {
-          l_v1 = l_first->next;
-          l_v2 = l_first->prev;
-          break;
+        else if (quad_method == MOD_TRIANGULATE_QUAD_LONGEDGE) {
+          float d1, d2;
+          d1 = len_squared_v3v3(l_v4->v->co, l_v2->v->co);
+          d2 = len_squared_v3v3(l_v1->v->co, l_v3->v->co);
+          split_24 = ((d2 - d1) < 0.0f);
         }
-        case MOD_TRIANGULATE_QUAD_SHORTEDGE:
-        case MOD_TRIANGULATE_QUAD_LONGEDGE:
-        case MOD_TRIANGULATE_QUAD_BEAUTY:
-        default: {
-          BMLoop *l_v3, *l_v4;
-          bool split_24;
-
-          l_v1 = l_first->next;
-          l_v2 = l_first->next->next;
-          l_v3 = l_first->prev;
-          l_v4 = l_first;
-
-          if (quad_method == MOD_TRIANGULATE_QUAD_SHORTEDGE) {
-            float d1, d2;
-            d1 = len_squared_v3v3(l_v4->v->co, l_v2->v->co);
-            d2 = len_squared_v3v3(l_v1->v->co, l_v3->v->co);
-            split_24 = ((d2 - d1) > 0.0f);
+        else {
+          /* first check if the quad is concave on either diagonal */
+          const int flip_flag = is_quad_flip_v3(
+              l_v1->v->co, l_v2->v->co, l_v3->v->co, l_v4->v->co);
+          if (UNLIKELY(flip_flag & (1 << 0))) {
+            split_24 = true;
           }
-          else if (quad_method == MOD_TRIANGULATE_QUAD_LONGEDGE) {
-            float d1, d2;
-            d1 = len_squared_v3v3(l_v4->v->co, l_v2->v->co);
-            d2 = len_squared_v3v3(l_v1->v->co, l_v3->v->co);
-            split_24 = ((d2 - d1) < 0.0f);
+          else if (UNLIKELY(flip_flag & (1 << 1))) {
+            split_24 = false;
           }
           else {
-            /* first check if the quad is concave on either diagonal */
-            const int flip_flag = is_quad_flip_v3(
-                l_v1->v->co, l_v2->v->co, l_v3->v->co, l_v4->v->co);
-            if (UNLIKELY(flip_flag & (1 << 0))) {
-              split_24 = true;
-            }
-            else if (UNLIKELY(flip_flag & (1 << 1))) {
-              split_24 = false;
-            }
-            else {
-              split_24 = (BM_verts_calc_rotate_beauty(l_v1->v, l_v2->v, l_v3->v, l_v4->v, 0, 0) >
-                          0.0f);
-            }
+            split_24 = (BM_verts_calc_rotate_beauty(l_v1->v, l_v2->v, l_v3->v, l_v4->v, 0, 0) >
+                        0.0f);
           }
+        }
 
-          /* named confusingly, l_v1 is in fact the second vertex */
-          if (split_24) {
-            l_v1 = l_v4;
-            // l_v2 = l_v2;
-          }
-          else {
-            // l_v1 = l_v1;
-            l_v2 = l_v3;
-          }
-          break;
+        /* named confusingly, l_v1 is in fact the second vertex */
+        if (split_24) {
+          l_v1 = l_v4;
+          // l_v2 = l_v2;
+        }
+        else {
+          // l_v1 = l_v1;
+          l_v2 = l_v3;
         }
+        break;
       }
+    }
+
+    loops[0] = l_v1;
+    loops[1] = l_v1->next;
+    loops[2] = l_v2;
+    loops[3] = l_v2->next;
+
+    ARRAY_SET_ITEMS(tris[0], 0, 1, 2);
+    ARRAY_SET_ITEMS(tris[1], 0, 2, 3);
+  }
+  else {
+    BMLoop *l_iter;
+    float axis_mat[3][3];
+    float(*projverts)[2] = BLI_array_alloca(projverts, f->len);
 
-      loops[0] = l_v1;
-      loops[1] = l_v1->next;
-      loops[2] = l_v2;
-      loops[3] = l_v2->next;
+    axis_dominant_v3_to_m3_negate(axis_mat, f->no);
 
-      ARRAY_SET_ITEMS(tris[0], 0, 1, 2);
-      ARRAY_SET_ITEMS(tris[1], 0, 2, 3);
+    for (i = 0, l_iter = BM_FACE_FIRST_LOOP(f); i < f->len; i++, l_iter = l_iter->next) {
+      loops[i] = l_iter;
+      mul_v2_m3v3(projverts[i], axis_mat, l_iter->v->co);
     }
-    else {
-      BMLoop *l_iter;
-      float axis_mat[3][3];
-      float(*projverts)[2] = BLI_array_alloca(projverts, f->len);
 
-      axis_dominant_v3_to_m3_negate(axis_mat, f->no);
+    BLI_polyfill_calc_arena(projverts, f->len, 1, tris, pf_arena);
 
-      for (i = 0, l_iter = BM_FACE_FIRST_LOOP(f); i < f->len; i++, l_iter = l_iter->next) {
-        loops[i] = l_iter;
-        mul_v2_m3v3(projverts[i], axis_mat, l_iter->v->co);
-      }
+    if (use_beauty) {
+      BLI_polyfill_beautify(projverts, f->len, tris, pf_arena, pf_heap);
+    }
 
-      BLI_polyfill_calc_arena(projverts, f->len, 1, tris, pf_arena);
+    BLI_memarena_clear(pf_arena);
+  }
+}
 
-      if (use_beauty) {
-        BLI_polyfill_beautify(projverts, f->len, tris, pf_arena, pf_heap);
-      }
+void BM_face_triangulate_from_tris(BMesh *bm,
+                                   BMFace *f,
+                                   BMLoop **loops,
+                                   const uint (*tris)[3],
+                                   BMFace **r_faces_new,
+                                   int *r_faces_new_tot,
+                                   BMEdge **r_edges_new,
+                                   int *r_edges_new_tot,
+                                   LinkNode **r_faces_double,
+                                   const bool use_tag)
+{
+  const int cd_loop_mdisp_offset = CustomData_get_offset(&bm->ldata, CD_MDISPS);
+  BMLoop *l_first, *l_new;
+  BMFace *f_new;
+  int nf_i = 0;
+  int ne_i = 0;
 
-      BLI_memarena_clear(pf_arena);
-    }
+  /* ensure both are valid or nullptr */
+  BLI_assert((r_faces_new == nullptr) == (r_faces_new_tot == nullptr));
+
+  BLI_assert(f->len > 3);
+
+  {
+    const int totfilltri = f->len - 2;
+    const int last_tri = f->len - 3;
+    int i;
+    /* for mdisps */
+    float f_center[3];
 
     if (cd_loop_mdisp_offset != -1) {
       BM_face_calc_center_median(f, f_center);
@@ -1177,6 +1183,38 @@ void BM_face_triangulate(BMesh *bm,
   }
 }
 
+void BM_face_triangulate(BMesh *bm,
+                         BMFace *f,
+                         BMFace **r_faces_new,
+                         int *r_faces_new_tot,
+                         BMEdge **r_edges_new,
+                         int *r_edges_new_tot,
+                         LinkNode **r_faces_double,
+                         const int quad_method,
+                         const int ngon_method,
+                         const bool use_tag,
+                         /* use for ngons only! */
+                         MemArena *pf_arena,
+
+                         /* use for MOD_TRIANGULATE_NGON_BEAUTY only! */
+                         Heap *pf_heap)
+{
+  BMLoop **loops = BLI_array_alloca(loops, f->len);
+  uint(*tris)[3] = BLI_array_alloca(tris, f->len);
+
+  BM_face_triangulate_calc(f, quad_method, ngon_method, loops, tris, pf_arena, pf_heap);
+  BM_face_triangulate_from_tris(bm,
+                                f,
+                                loops,
+                                tris,
+                                r_faces_new,
+                                r_faces_new_tot,
+                                r_edges_new,
+                                r_edges_new_tot,
+                                r_faces_double,
+                                use_tag);
+}
+
 void BM_face_splits_check_legal(BMesh *bm, BMFace *f, BMLoop *(*loops)[2], int len)
 {
   float out[2] = {-FLT_MAX, -FLT_MAX};
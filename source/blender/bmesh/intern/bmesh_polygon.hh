@@ -228,6 +228,39 @@ void BM_face_triangulate(BMesh *bm,
                          struct MemArena *pf_arena,
                          struct Heap *pf_heap) ATTR_NONNULL(1, 2);
 
+/**
+ * Calculate the triangles #BM_face_triangulate creates for \a f, without modifying the mesh.
+ * This only reads the face, so it can run for many faces in parallel (with an arena and heap
+ * for each thread), the result is then passed to #BM_face_triangulate_from_tris.
+ *
+ * \param loops: Array of #BMFace.len loops, filled with the corners the triangles index into.
+ * \param tris: Array of (#BMFace.len - 2) triangles.
+ */
+void BM_face_triangulate_calc(BMFace *f,
+                              int quad_method,
+                              int ngon_method,
+                              BMLoop **loops,
+                              uint (*tris)[3],
+                              struct MemArena *pf_arena,
+                              struct Heap *pf_heap) ATTR_NONNULL(1, 4, 5);
+/**
+ * Create the triangles calculated by #BM_face_triangulate_calc,
+ * the arguments match #BM_face_triangulate.
+ *
+ * \note The loops of other faces are not affected, so triangles calculated for several faces
+ * up-front stay valid while the faces are triangulated one after another.
+ */
+void BM_face_triangulate_from_tris(BMesh *bm,
+                                   BMFace *f,
+                                   BMLoop **loops,
+                                   const uint (*tris)[3],
+                                   BMFace **r_faces_new,
+                                   int *r_faces_new_tot,
+                                   BMEdge **r_edges_new,
+                                   int *r_edges_new_tot,
+                                   struct LinkNode **r_faces_double,
+                                   bool use_tag) ATTR_NONNULL(1, 2, 3, 4);
+
 /**
  * each pair of loops defines a new edge, a split.  this function goes
  * through and sets pairs that are geometrically invalid to null.  a
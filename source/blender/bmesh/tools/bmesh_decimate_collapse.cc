@@ -13,6 +13,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_alloca.h"
+#include "BLI_array.hh"
 #include "BLI_heap.h"
 #include "BLI_linklist.h"
 #include "BLI_math_geom.h"
@@ -20,7 +21,9 @@
 #include "BLI_memarena.h"
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
+#include "BLI_math_vector_types.hh"
 #include "BLI_quadric.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines_stack.h"
 
 #include "BKE_customdata.hh"
@@ -66,62 +69,83 @@ ENUM_OPERATORS(CD_UseFlag, CD_DO_LOOP)
 /* BMesh Helper Functions
  * ********************** */
 
+static void bm_decim_face_plane(const BMFace *f, double r_plane[4])
+{
+  float center[3];
+  BM_face_calc_center_median(f, center);
+  copy_v3db_v3fl(r_plane, f->no);
+  r_plane[3] = -dot_v3db_v3fl(r_plane, center);
+}
+
 /**
- * \param vquadrics: must be calloc'd
+ * \return false when the boundary edge doesn't define a plane.
  */
-static void bm_decim_build_quadrics(BMesh *bm, Quadric *vquadrics)
+static bool bm_decim_boundary_edge_quadric(const BMEdge *e, Quadric *r_q)
 {
-  BMIter iter;
-  BMFace *f;
-  BMEdge *e;
+  float edge_vector[3];
+  float edge_plane[3];
+  double edge_plane_db[4];
+  sub_v3_v3v3(edge_vector, e->v2->co, e->v1->co);
 
-  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
-    BMLoop *l_first;
-    BMLoop *l_iter;
+  cross_v3_v3v3(edge_plane, edge_vector, e->l->f->no);
+  copy_v3db_v3fl(edge_plane_db, edge_plane);
 
+  if (normalize_v3_db(edge_plane_db) > double(FLT_EPSILON)) {
     float center[3];
-    double plane_db[4];
-    Quadric q;
-
-    BM_face_calc_center_median(f, center);
-    copy_v3db_v3fl(plane_db, f->no);
-    plane_db[3] = -dot_v3db_v3fl(plane_db, center);
 
-    BLI_quadric_from_plane(&q, plane_db);
+    mid_v3_v3v3(center, e->v1->co, e->v2->co);
 
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(l_iter->v)], &q);
-    } while ((l_iter = l_iter->next) != l_first);
+    edge_plane_db[3] = -dot_v3db_v3fl(edge_plane_db, center);
+    BLI_quadric_from_plane(r_q, edge_plane_db);
+    BLI_quadric_mul(r_q, BOUNDARY_PRESERVE_WEIGHT);
+    return true;
   }
+  return false;
+}
 
-  /* boundary edges */
-  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
-    if (UNLIKELY(BM_edge_is_boundary(e))) {
-      float edge_vector[3];
-      float edge_plane[3];
-      double edge_plane_db[4];
-      sub_v3_v3v3(edge_vector, e->v2->co, e->v1->co);
-      f = e->l->f;
+/**
+ * \param vquadrics: must be calloc'd
+ */
+static void bm_decim_build_quadrics(BMesh *bm, Quadric *vquadrics)
+{
+  using namespace blender;
+  BM_mesh_elem_index_ensure(bm, BM_FACE);
+  BM_mesh_elem_table_ensure(bm, BM_VERT | BM_FACE);
+
+  /* Calculate the face planes first, so the quadric of every vertex can then be accumulated
+   * from its own faces & boundary edges, without threads writing to the same vertices. */
+  Array<double4> face_planes(bm->totface);
+  threading::parallel_for(IndexRange(bm->totface), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      bm_decim_face_plane(bm->ftable[i], face_planes[i]);
+    }
+  });
 
-      cross_v3_v3v3(edge_plane, edge_vector, f->no);
-      copy_v3db_v3fl(edge_plane_db, edge_plane);
+  threading::parallel_for(IndexRange(bm->totvert), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMVert *v = bm->vtable[i];
+      Quadric *v_quadric = &vquadrics[BM_elem_index_get(v)];
+      BMIter iter;
+      BMLoop *l;
+      BMEdge *e;
 
-      if (normalize_v3_db(edge_plane_db) > double(FLT_EPSILON)) {
+      BM_ITER_ELEM (l, &iter, v, BM_LOOPS_OF_VERT) {
         Quadric q;
-        float center[3];
-
-        mid_v3_v3v3(center, e->v1->co, e->v2->co);
-
-        edge_plane_db[3] = -dot_v3db_v3fl(edge_plane_db, center);
-        BLI_quadric_from_plane(&q, edge_plane_db);
-        BLI_quadric_mul(&q, BOUNDARY_PRESERVE_WEIGHT);
+        BLI_quadric_from_plane(&q, face_planes[BM_elem_index_get(l->f)]);
+        BLI_quadric_add_qu_qu(v_quadric, &q);
+      }
 
-        BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(e->v1)], &q);
-        BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(e->v2)], &q);
+      /* boundary edges */
+      BM_ITER_ELEM (e, &iter, v, BM_EDGES_OF_VERT) {
+        if (UNLIKELY(BM_edge_is_boundary(e))) {
+          Quadric q;
+          if (bm_decim_boundary_edge_quadric(e, &q)) {
+            BLI_quadric_add_qu_qu(v_quadric, &q);
+          }
+        }
       }
     }
-  }
+  });
 }
 
 static void bm_decim_calc_target_co_db(BMEdge *e, double optimize_co[3], const Quadric *vquadrics)
@@ -227,19 +251,21 @@ static float bm_decim_build_edge_cost_single__topology(BMEdge *e)
 
 #endif /* USE_TOPOLOGY_FALLBACK */
 
-static void bm_decim_build_edge_cost_single(BMEdge *e,
-                                            const Quadric *vquadrics,
-                                            const float *vweights,
-                                            const float vweight_factor,
-                                            Heap *eheap,
-                                            HeapNode **eheap_table)
+/**
+ * \return false when the edge can't be collapsed.
+ */
+static bool bm_decim_edge_cost_calc(BMEdge *e,
+                                    const Quadric *vquadrics,
+                                    const float *vweights,
+                                    const float vweight_factor,
+                                    float *r_cost)
 {
   float cost;
 
   if (UNLIKELY(vweights && ((vweights[BM_elem_index_get(e->v1)] == 0.0f) ||
                             (vweights[BM_elem_index_get(e->v2)] == 0.0f))))
   {
-    goto clear;
+    return false;
   }
 
   /* Check we can collapse, some edges we better not touch. */
@@ -249,7 +275,7 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* Only collapse triangles. */
-      goto clear;
+      return false;
     }
   }
   else if (BM_edge_is_manifold(e)) {
@@ -258,11 +284,11 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* Only collapse triangles. */
-      goto clear;
+      return false;
     }
   }
   else {
-    goto clear;
+    return false;
   }
   /* End sanity check. */
 
@@ -315,10 +341,23 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
   }
 
-  BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
-  return;
+  *r_cost = cost;
+  return true;
+}
+
+static void bm_decim_build_edge_cost_single(BMEdge *e,
+                                            const Quadric *vquadrics,
+                                            const float *vweights,
+                                            const float vweight_factor,
+                                            Heap *eheap,
+                                            HeapNode **eheap_table)
+{
+  float cost;
+  if (bm_decim_edge_cost_calc(e, vquadrics, vweights, vweight_factor, &cost)) {
+    BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
+    return;
+  }
 
-clear:
   if (eheap_table[BM_elem_index_get(e)]) {
     BLI_heap_remove(eheap, eheap_table[BM_elem_index_get(e)]);
   }
@@ -340,14 +379,26 @@ static void bm_decim_build_edge_cost(BMesh *bm,
                                      Heap *eheap,
                                      HeapNode **eheap_table)
 {
+  using namespace blender;
   BMIter iter;
   BMEdge *e;
   uint i;
 
+  /* Calculating the cost is independent for every edge, only filling the heap is serial. */
+  BM_mesh_elem_table_ensure(bm, BM_EDGE);
+  Array<float> costs(bm->totedge);
+  Array<bool> can_collapse(bm->totedge);
+  threading::parallel_for(IndexRange(bm->totedge), 2048, [&](const IndexRange range) {
+    for (const int edge_i : range) {
+      BMEdge *e_iter = bm->etable[edge_i];
+      const int e_index = BM_elem_index_get(e_iter);
+      can_collapse[e_index] = bm_decim_edge_cost_calc(
+          e_iter, vquadrics, vweights, vweight_factor, &costs[e_index]);
+    }
+  });
+
   BM_ITER_MESH_INDEX (e, &iter, bm, BM_EDGES_OF_MESH, i) {
-    /* keep sanity check happy */
-    eheap_table[i] = nullptr;
-    bm_decim_build_edge_cost_single(e, vquadrics, vweights, vweight_factor, eheap, eheap_table);
+    eheap_table[i] = can_collapse[i] ? BLI_heap_insert(eheap, costs[i], e) : nullptr;
   }
 }
 
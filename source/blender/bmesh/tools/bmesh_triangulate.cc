@@ -13,10 +13,16 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_alloca.h"
+#include "BLI_array.hh"
+#include "BLI_enumerable_thread_specific.hh"
 #include "BLI_heap.h"
 #include "BLI_linklist.h"
+#include "BLI_math_vector_types.hh"
 #include "BLI_memarena.h"
+#include "BLI_offset_indices.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 /* only for defines */
 #include "BLI_polyfill_2d.h"
@@ -26,39 +32,40 @@
 
 #include "bmesh_triangulate.hh" /* own include */
 
+using blender::Array;
+using blender::IndexRange;
+using blender::OffsetIndices;
+using blender::Span;
+using blender::uint3;
+using blender::Vector;
+
 /**
- * a version of #BM_face_triangulate that maps to #BMOpSlot
+ * a version of #BM_face_triangulate_from_tris that maps to #BMOpSlot
  */
 static void bm_face_triangulate_mapping(BMesh *bm,
                                         BMFace *face,
-                                        const int quad_method,
-                                        const int ngon_method,
+                                        BMLoop **loops,
+                                        const uint (*tris)[3],
                                         const bool use_tag,
                                         BMOperator *op,
                                         BMOpSlot *slot_facemap_out,
-                                        BMOpSlot *slot_facemap_double_out,
-
-                                        MemArena *pf_arena,
-                                        /* use for MOD_TRIANGULATE_NGON_BEAUTY only! */
-                                        Heap *pf_heap)
+                                        BMOpSlot *slot_facemap_double_out)
 {
   int faces_array_tot = face->len - 3;
   BMFace **faces_array = BLI_array_alloca(faces_array, faces_array_tot);
   LinkNode *faces_double = nullptr;
   BLI_assert(face->len > 3);
 
-  BM_face_triangulate(bm,
-                      face,
-                      faces_array,
-                      &faces_array_tot,
-                      nullptr,
-                      nullptr,
-                      &faces_double,
-                      quad_method,
-                      ngon_method,
-                      use_tag,
-                      pf_arena,
-                      pf_heap);
+  BM_face_triangulate_from_tris(bm,
+                                face,
+                                loops,
+                                tris,
+                                faces_array,
+                                &faces_array_tot,
+                                nullptr,
+                                nullptr,
+                                &faces_double,
+                                use_tag);
 
   if (faces_array_tot) {
     int i;
@@ -76,6 +83,55 @@ static void bm_face_triangulate_mapping(BMesh *bm,
   }
 }
 
+/** Polyfill memory, allocated on first use by every thread. */
+struct TriangulateThreadData {
+  MemArena *pf_arena = nullptr;
+  Heap *pf_heap = nullptr;
+};
+
+/**
+ * Calculate the triangles of all faces up-front, this only reads the mesh so it's done in
+ * parallel. The triangles of the face at index `i` start at `faces_loops[i].start() - i * 2`.
+ */
+static void bm_mesh_triangulate_calc(const Span<BMFace *> faces,
+                                     const OffsetIndices<int> faces_loops,
+                                     const int quad_method,
+                                     const int ngon_method,
+                                     BMLoop **loops,
+                                     uint (*tris)[3])
+{
+  blender::threading::EnumerableThreadSpecific<TriangulateThreadData> all_data;
+  blender::threading::parallel_for(faces.index_range(), 256, [&](const IndexRange range) {
+    TriangulateThreadData &data = all_data.local();
+    for (const int i : range) {
+      BMFace *face = faces[i];
+      if (face->len > 4 && data.pf_arena == nullptr) {
+        data.pf_arena = BLI_memarena_new(BLI_POLYFILL_ARENA_SIZE, __func__);
+        if (ngon_method == MOD_TRIANGULATE_NGON_BEAUTY) {
+          data.pf_heap = BLI_heap_new_ex(BLI_POLYFILL_ALLOC_NGON_RESERVE);
+        }
+      }
+      const int loop_start = faces_loops[i].start();
+      BM_face_triangulate_calc(face,
+                               quad_method,
+                               ngon_method,
+                               &loops[loop_start],
+                               &tris[loop_start - i * 2],
+                               data.pf_arena,
+                               data.pf_heap);
+    }
+  });
+
+  for (TriangulateThreadData &data : all_data) {
+    if (data.pf_arena) {
+      BLI_memarena_free(data.pf_arena);
+    }
+    if (data.pf_heap) {
+      BLI_heap_free(data.pf_heap, nullptr);
+    }
+  }
+}
+
 void BM_mesh_triangulate(BMesh *bm,
                          const int quad_method,
                          const int ngon_method,
@@ -87,57 +143,64 @@ void BM_mesh_triangulate(BMesh *bm,
 {
   BMIter iter;
   BMFace *face;
-  MemArena *pf_arena;
-  Heap *pf_heap;
 
-  pf_arena = BLI_memarena_new(BLI_POLYFILL_ARENA_SIZE, __func__);
-
-  if (ngon_method == MOD_TRIANGULATE_NGON_BEAUTY) {
-    pf_heap = BLI_heap_new_ex(BLI_POLYFILL_ALLOC_NGON_RESERVE);
-  }
-  else {
-    pf_heap = nullptr;
-  }
-
-  if (slot_facemap_out) {
-    /* same as below but call: bm_face_triangulate_mapping() */
+  Vector<BMFace *> faces;
+  Array<int> loop_offsets_data;
+  {
+    Vector<int> face_sizes;
     BM_ITER_MESH (face, &iter, bm, BM_FACES_OF_MESH) {
       if (face->len >= min_vertices) {
         if (tag_only == false || BM_elem_flag_test(face, BM_ELEM_TAG)) {
-          bm_face_triangulate_mapping(bm,
-                                      face,
-                                      quad_method,
-                                      ngon_method,
-                                      tag_only,
-                                      op,
-                                      slot_facemap_out,
-                                      slot_facemap_double_out,
-                                      pf_arena,
-                                      pf_heap);
+          faces.append(face);
+          face_sizes.append(face->len);
         }
       }
     }
+    face_sizes.append(0);
+    loop_offsets_data = face_sizes.as_span();
+  }
+  if (faces.is_empty()) {
+    return;
+  }
+
+  /* Creating the triangles modifies the mesh and stays single threaded, calculating which
+   * triangles to create (polyfill & beautify for ngons) is the expensive part. */
+  const OffsetIndices<int> faces_loops = blender::offset_indices::accumulate_counts_to_offsets(
+      loop_offsets_data);
+  Array<BMLoop *> loops(faces_loops.total_size());
+  Array<uint3> tris(faces_loops.total_size() - faces.size() * 2);
+  uint(*tris_ptr)[3] = reinterpret_cast<uint(*)[3]>(tris.data());
+  bm_mesh_triangulate_calc(faces, faces_loops, quad_method, ngon_method, loops.data(), tris_ptr);
+
+  if (slot_facemap_out) {
+    /* same as below but call: bm_face_triangulate_mapping() */
+    for (const int i : faces.index_range()) {
+      const int loop_start = faces_loops[i].start();
+      bm_face_triangulate_mapping(bm,
+                                  faces[i],
+                                  &loops[loop_start],
+                                  &tris_ptr[loop_start - i * 2],
+                                  tag_only,
+                                  op,
+                                  slot_facemap_out,
+                                  slot_facemap_double_out);
+    }
   }
   else {
     LinkNode *faces_double = nullptr;
 
-    BM_ITER_MESH (face, &iter, bm, BM_FACES_OF_MESH) {
-      if (face->len >= min_vertices) {
-        if (tag_only == false || BM_elem_flag_test(face, BM_ELEM_TAG)) {
-          BM_face_triangulate(bm,
-                              face,
-                              nullptr,
-                              nullptr,
-                              nullptr,
-                              nullptr,
-                              &faces_double,
-                              quad_method,
-                              ngon_method,
-                              tag_only,
-                              pf_arena,
-                              pf_heap);
-        }
-      }
+    for (const int i : faces.index_range()) {
+      const int loop_start = faces_loops[i].start();
+      BM_face_triangulate_from_tris(bm,
+                                    faces[i],
+                                    &loops[loop_start],
+                                    &tris_ptr[loop_start - i * 2],
+                                    nullptr,
+                                    nullptr,
+                                    nullptr,
+                                    nullptr,
+                                    &faces_double,
+                                    tag_only);
     }
 
     while (faces_double) {
@@ -147,10 +210,4 @@ void BM_mesh_triangulate(BMesh *bm,
       faces_double = next;
     }
   }
-
-  BLI_memarena_free(pf_arena);
-
-  if (ngon_method == MOD_TRIANGULATE_NGON_BEAUTY) {
-    BLI_heap_free(pf_heap, nullptr);
-  }
 }
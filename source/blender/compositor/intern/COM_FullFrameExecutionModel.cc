@@ -97,6 +97,32 @@ MemoryBuffer *FullFrameExecutionModel::create_operation_buffer(NodeOperation *op
   return new MemoryBuffer(data_type, rect, is_a_single_elem);
 }
 
+MemoryBuffer *FullFrameExecutionModel::take_in_place_buffer(NodeOperation *op)
+{
+  if (!op->get_flags().can_be_in_place || op->get_flags().is_constant_operation) {
+    return nullptr;
+  }
+
+  const DataType data_type = op->get_output_socket(0)->get_data_type();
+  const int num_inputs = op->get_number_of_input_sockets();
+  for (int i = 0; i < num_inputs; i++) {
+    NodeOperation *input = op->get_input_operation(i);
+    if (input->get_number_of_output_sockets() == 0 ||
+        input->get_output_socket(0)->get_data_type() != data_type ||
+        !BLI_rcti_compare(&input->get_canvas(), &op->get_canvas()))
+    {
+      continue;
+    }
+    if (active_buffers_.get_rendered_buffer(input)->is_a_single_elem()) {
+      continue;
+    }
+    if (std::unique_ptr<MemoryBuffer> buffer = active_buffers_.take_buffer_for_in_place(input)) {
+      return buffer.release();
+    }
+  }
+  return nullptr;
+}
+
 void FullFrameExecutionModel::render_operation(NodeOperation *op)
 {
   /* Output has no offset for easier image algorithms implementation on operations. */
@@ -106,9 +132,20 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
   const timeit::TimePoint before_time = timeit::Clock::now();
 
   const bool has_outputs = op->get_number_of_output_sockets() > 0;
-  MemoryBuffer *op_buf = has_outputs ? create_operation_buffer(op, output_x, output_y) : nullptr;
-  if (op->get_width() > 0 && op->get_height() > 0) {
-    Vector<MemoryBuffer *> input_bufs = get_input_buffers(op, output_x, output_y);
+  const bool has_size = op->get_width() > 0 && op->get_height() > 0;
+  /* Get the input buffers first, an input buffer may be reused for the output. */
+  Vector<MemoryBuffer *> input_bufs;
+  if (has_size) {
+    input_bufs = get_input_buffers(op, output_x, output_y);
+  }
+  MemoryBuffer *op_buf = nullptr;
+  if (has_outputs) {
+    op_buf = has_size ? take_in_place_buffer(op) : nullptr;
+    if (op_buf == nullptr) {
+      op_buf = create_operation_buffer(op, output_x, output_y);
+    }
+  }
+  if (has_size) {
     const int op_offset_x = output_x - op->get_canvas().xmin;
     const int op_offset_y = output_y - op->get_canvas().ymin;
     Vector<rcti> areas = active_buffers_.get_areas_to_render(op, op_offset_x, op_offset_y);
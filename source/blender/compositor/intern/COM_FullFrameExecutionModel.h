@@ -63,6 +63,11 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   Vector<MemoryBuffer *> get_input_buffers(NodeOperation *op, int output_x, int output_y);
   MemoryBuffer *create_operation_buffer(NodeOperation *op, int output_x, int output_y);
+  /**
+   * Returns the buffer of an input the operation can write its output to, taking its ownership.
+   * Returns null if there is none.
+   */
+  MemoryBuffer *take_in_place_buffer(NodeOperation *op);
   void render_operation(NodeOperation *op);
 
   void operation_finished(NodeOperation *operation);
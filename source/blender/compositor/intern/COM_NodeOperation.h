@@ -206,6 +206,13 @@ struct NodeOperationFlags {
    */
   bool can_be_constant : 1;
 
+  /**
+   * Whether operation only reads its inputs at the pixel it writes, and reads the input channels
+   * of a pixel before writing the output channels that depend on them. Its output can then be
+   * written in place of an input buffer which no other operation reads.
+   */
+  bool can_be_in_place : 1;
+
   NodeOperationFlags()
   {
     use_render_border = false;
@@ -217,6 +224,7 @@ struct NodeOperationFlags {
     use_datatype_conversion = true;
     is_constant_operation = false;
     can_be_constant = false;
+    can_be_in_place = false;
   }
 };
 
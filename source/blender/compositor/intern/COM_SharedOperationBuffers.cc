@@ -80,6 +80,16 @@ MemoryBuffer *SharedOperationBuffers::get_rendered_buffer(NodeOperation *op)
   return get_buffer_data(op).buffer.get();
 }
 
+std::unique_ptr<MemoryBuffer> SharedOperationBuffers::take_buffer_for_in_place(NodeOperation *op)
+{
+  BLI_assert(is_operation_rendered(op));
+  BufferData &buf_data = get_buffer_data(op);
+  if (buf_data.registered_reads - buf_data.received_reads != 1) {
+    return nullptr;
+  }
+  return std::move(buf_data.buffer);
+}
+
 void SharedOperationBuffers::read_finished(NodeOperation *read_op)
 {
   BufferData &buf_data = get_buffer_data(read_op);
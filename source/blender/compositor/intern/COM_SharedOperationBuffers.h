@@ -71,6 +71,11 @@ class SharedOperationBuffers {
    * Get given operation rendered buffer.
    */
   MemoryBuffer *get_rendered_buffer(NodeOperation *op);
+  /**
+   * Take ownership of given operation rendered buffer when only one read of it is left, so that
+   * the reading operation can write its output in place. Returns null otherwise.
+   */
+  std::unique_ptr<MemoryBuffer> take_buffer_for_in_place(NodeOperation *op);
 
   /**
    * Reports an operation has finished reading given operation. If all given operation dependencies
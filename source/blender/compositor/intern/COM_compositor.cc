@@ -12,6 +12,7 @@
 #include "BKE_node_runtime.hh"
 #include "BKE_scene.hh"
 
+#include "COM_DenoiseOperation.h"
 #include "COM_ExecutionSystem.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.hh"
@@ -107,6 +108,7 @@ void COM_deinitialize()
   if (g_compositor.is_initialized) {
     BLI_mutex_lock(&g_compositor.mutex);
     blender::compositor::WorkScheduler::deinitialize();
+    blender::compositor::COM_denoise_cache_free();
     g_compositor.is_initialized = false;
     BLI_mutex_unlock(&g_compositor.mutex);
     BLI_mutex_end(&g_compositor.mutex);
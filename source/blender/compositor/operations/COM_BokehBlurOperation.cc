@@ -8,6 +8,8 @@
 #include "COM_BokehBlurOperation.h"
 #include "COM_ConstantOperation.h"
 
+#include "COM_algorithm_fft_convolution.hh"
+
 namespace blender::compositor {
 
 constexpr int IMAGE_INPUT_INDEX = 0;
@@ -29,6 +31,7 @@ BokehBlurOperation::BokehBlurOperation()
   sizeavailable_ = false;
 
   extend_bounds_ = false;
+  use_fft_convolution_ = false;
 }
 
 void BokehBlurOperation::init_data()
@@ -96,12 +99,55 @@ void BokehBlurOperation::get_area_of_interest(const int input_idx,
   }
 }
 
+int BokehBlurOperation::get_radius() const
+{
+  const float max_dim = std::max(this->get_width(), this->get_height());
+  return size_ * max_dim / 100.0f;
+}
+
+void BokehBlurOperation::update_memory_buffer_started(MemoryBuffer *output,
+                                                      const rcti &area,
+                                                      Span<MemoryBuffer *> inputs)
+{
+  /* The cost of direct convolution grows with the square of the radius, so large radii are
+   * convolved in the frequency domain for the whole area at once. The bounding box is then
+   * applied in update_memory_buffer_partial. */
+  const int radius = this->get_radius();
+  use_fft_convolution_ = radius >= realtime_compositor::FFT_CONVOLUTION_MINIMUM_RADIUS &&
+                         realtime_compositor::is_fft_convolution_supported();
+  if (!use_fft_convolution_) {
+    return;
+  }
+
+  const MemoryBuffer *image_input = inputs[IMAGE_INPUT_INDEX];
+  const MemoryBuffer *bokeh_input = inputs[BOKEH_INPUT_INDEX];
+  const int2 bokeh_size = int2(bokeh_input->get_width(), bokeh_input->get_height());
+  const int2 area_offset = int2(area.xmin, area.ymin);
+  realtime_compositor::fft_convolve(
+      int2(BLI_rcti_size_x(&area), BLI_rcti_size_y(&area)),
+      radius,
+      [&](const int2 texel) {
+        const int2 image_texel = area_offset + texel;
+        return float4(image_input->get_elem_clamped(image_texel.x, image_texel.y));
+      },
+      [&](const int2 offset) {
+        /* Same as the weights of the direct convolution in update_memory_buffer_partial. */
+        const float2 normalized_texel = (float2(offset) + radius + 0.5f) /
+                                        (radius * 2.0f + 1.0f);
+        const float2 weight_texel = (1.0f - normalized_texel) * float2(bokeh_size - 1);
+        return float4(bokeh_input->get_elem(int(weight_texel.x), int(weight_texel.y)));
+      },
+      [&](const int2 texel, const float4 color) {
+        const int2 output_texel = area_offset + texel;
+        copy_v4_v4(output->get_elem(output_texel.x, output_texel.y), color);
+      });
+}
+
 void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                       const rcti &area,
                                                       Span<MemoryBuffer *> inputs)
 {
-  const float max_dim = std::max(this->get_width(), this->get_height());
-  const int radius = size_ * max_dim / 100.0f;
+  const int radius = this->get_radius();
 
   const MemoryBuffer *image_input = inputs[IMAGE_INPUT_INDEX];
   const MemoryBuffer *bokeh_input = inputs[BOKEH_INPUT_INDEX];
@@ -117,6 +163,11 @@ void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
       continue;
     }
 
+    /* Already convolved in update_memory_buffer_started. */
+    if (use_fft_convolution_) {
+      continue;
+    }
+
     float4 accumulated_color = float4(0.0f);
     float4 accumulated_weight = float4(0.0f);
     for (int yi = -radius; yi <= radius; ++yi) {
@@ -16,6 +16,12 @@ class BokehBlurOperation : public MultiThreadedOperation {
 
   bool extend_bounds_;
 
+  /* True if the current execution convolves in the frequency domain, see
+   * update_memory_buffer_started. */
+  bool use_fft_convolution_;
+
+  int get_radius() const;
+
  public:
   BokehBlurOperation();
 
@@ -35,6 +41,9 @@ class BokehBlurOperation : public MultiThreadedOperation {
   void determine_canvas(const rcti &preferred_area, rcti &r_area) override;
 
   void get_area_of_interest(int input_idx, const rcti &output_area, rcti &r_input_area) override;
+  void update_memory_buffer_started(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
@@ -2,7 +2,12 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <mutex>
+
+#include <xxhash.h>
+
 #include "COM_DenoiseOperation.h"
+#include "BLI_array.hh"
 #include "BLI_system.h"
 #ifdef WITH_OPENIMAGEDENOISE
 #  include "BLI_threads.h"
@@ -114,6 +119,111 @@ class DenoiseFilter {
 #endif
 };
 
+/* -------------------------------------------------------------------- */
+/** \name Denoise Cache
+ *
+ * Denoising is usually the most expensive operation of a node tree. Its outputs are kept between
+ * executions, identified by a hash of the inputs and settings, so that editing the nodes that
+ * come after a denoise node does not denoise again.
+ * \{ */
+
+/** Least recently used outputs are freed when the cache grows larger than this. */
+static constexpr int64_t DENOISE_CACHE_MAX_BYTES = int64_t(512) << 20;
+
+struct DenoiseCacheEntry {
+  uint64_t hash;
+  int width;
+  int height;
+  Array<float> result;
+};
+
+static struct {
+  std::mutex mutex;
+  /** Most recently used entry last. */
+  Vector<std::unique_ptr<DenoiseCacheEntry>> entries;
+  int64_t bytes = 0;
+} g_denoise_cache;
+
+static int64_t buffer_floats_num(const MemoryBuffer *buffer)
+{
+  if (buffer->is_a_single_elem()) {
+    return buffer->get_num_channels();
+  }
+  return int64_t(buffer->get_width()) * buffer->get_height() * buffer->get_num_channels();
+}
+
+static uint64_t denoise_cache_hash(const StringRef name,
+                                   const Span<int> params,
+                                   const Span<MemoryBuffer *> inputs)
+{
+  uint64_t hash = XXH3_64bits(name.data(), name.size());
+  hash = XXH3_64bits_withSeed(params.data(), params.size_in_bytes(), hash);
+  for (MemoryBuffer *input : inputs) {
+    const int info[4] = {input->get_width(),
+                         input->get_height(),
+                         input->get_num_channels(),
+                         input->is_a_single_elem()};
+    hash = XXH3_64bits_withSeed(info, sizeof(info), hash);
+    hash = XXH3_64bits_withSeed(
+        input->get_buffer(), buffer_floats_num(input) * sizeof(float), hash);
+  }
+  return hash;
+}
+
+/** Copy the cached result into \a output, return false if there is none. */
+static bool denoise_cache_lookup(const uint64_t hash, MemoryBuffer *output)
+{
+  std::scoped_lock lock(g_denoise_cache.mutex);
+  Vector<std::unique_ptr<DenoiseCacheEntry>> &entries = g_denoise_cache.entries;
+  for (const int i : entries.index_range()) {
+    DenoiseCacheEntry &entry = *entries[i];
+    if (entry.hash != hash || entry.width != output->get_width() ||
+        entry.height != output->get_height() || entry.result.size() != buffer_floats_num(output))
+    {
+      continue;
+    }
+    memcpy(output->get_buffer(), entry.result.data(), entry.result.as_span().size_in_bytes());
+    std::unique_ptr<DenoiseCacheEntry> used = std::move(entries[i]);
+    entries.remove(i);
+    entries.append(std::move(used));
+    return true;
+  }
+  return false;
+}
+
+static void denoise_cache_add(const uint64_t hash, MemoryBuffer *output)
+{
+  const int64_t floats_num = buffer_floats_num(output);
+  const int64_t bytes = floats_num * int64_t(sizeof(float));
+  if (bytes > DENOISE_CACHE_MAX_BYTES) {
+    return;
+  }
+
+  std::unique_ptr<DenoiseCacheEntry> entry = std::make_unique<DenoiseCacheEntry>();
+  entry->hash = hash;
+  entry->width = output->get_width();
+  entry->height = output->get_height();
+  entry->result = Span<float>(output->get_buffer(), floats_num);
+
+  std::scoped_lock lock(g_denoise_cache.mutex);
+  Vector<std::unique_ptr<DenoiseCacheEntry>> &entries = g_denoise_cache.entries;
+  while (!entries.is_empty() && g_denoise_cache.bytes + bytes > DENOISE_CACHE_MAX_BYTES) {
+    g_denoise_cache.bytes -= entries.first()->result.as_span().size_in_bytes();
+    entries.remove(0);
+  }
+  entries.append(std::move(entry));
+  g_denoise_cache.bytes += bytes;
+}
+
+void COM_denoise_cache_free()
+{
+  std::scoped_lock lock(g_denoise_cache.mutex);
+  g_denoise_cache.entries.clear_and_shrink();
+  g_denoise_cache.bytes = 0;
+}
+
+/** \} */
+
 DenoiseBaseOperation::DenoiseBaseOperation()
 {
   flags_.can_be_constant = true;
@@ -198,7 +308,15 @@ void DenoiseOperation::update_memory_buffer(MemoryBuffer *output,
                                             Span<MemoryBuffer *> inputs)
 {
   if (!output_rendered_) {
-    this->generate_denoise(output, inputs[0], inputs[1], inputs[2], settings_);
+    const int hdr = settings_ ? settings_->hdr : 0;
+    const int clean_aux = settings_ ? are_guiding_passes_noise_free(settings_) : 0;
+    const uint64_t hash = denoise_cache_hash("Denoise", {hdr, clean_aux}, inputs);
+    if (!denoise_cache_lookup(hash, output)) {
+      this->generate_denoise(output, inputs[0], inputs[1], inputs[2], settings_);
+      if (!output->is_a_single_elem() && !this->is_braked()) {
+        denoise_cache_add(hash, output);
+      }
+    }
     output_rendered_ = true;
   }
 }
@@ -236,7 +354,13 @@ void DenoisePrefilterOperation::update_memory_buffer(MemoryBuffer *output,
                                                      Span<MemoryBuffer *> inputs)
 {
   if (!output_rendered_) {
-    this->generate_denoise(output, inputs[0]);
+    const uint64_t hash = denoise_cache_hash(image_name_, {}, inputs);
+    if (!denoise_cache_lookup(hash, output)) {
+      this->generate_denoise(output, inputs[0]);
+      if (!output->is_a_single_elem() && !this->is_braked()) {
+        denoise_cache_add(hash, output);
+      }
+    }
     output_rendered_ = true;
   }
 }
@@ -12,6 +12,7 @@ GammaOperation::GammaOperation()
   this->add_input_socket(DataType::Value);
   this->add_output_socket(DataType::Color);
   flags_.can_be_constant = true;
+  flags_.can_be_in_place = true;
 }
 
 void GammaOperation::update_memory_buffer_row(PixelCursor &p)
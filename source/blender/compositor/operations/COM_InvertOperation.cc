@@ -15,6 +15,7 @@ InvertOperation::InvertOperation()
   alpha_ = false;
   set_canvas_input_index(1);
   flags_.can_be_constant = true;
+  flags_.can_be_in_place = true;
 }
 
 void InvertOperation::update_memory_buffer_partial(MemoryBuffer *output,
@@ -5,9 +5,30 @@
 #include "COM_MixOperation.h"
 
 #include "BLI_math_color.h"
+#include "BLI_simd.hh"
 
 namespace blender::compositor {
 
+/**
+ * Write `a * fac_a + b * fac_b` to the color channels of \a out, and the alpha of \a a.
+ * The pixels are loaded before \a out is written, so it may be one of the inputs.
+ */
+BLI_INLINE void mix_rgb_keep_alpha(
+    float out[4], const float a[4], const float fac_a, const float b[4], const float fac_b)
+{
+  const float alpha = a[3];
+#if BLI_HAVE_SSE2
+  const __m128 result = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(fac_a)),
+                                   _mm_mul_ps(_mm_loadu_ps(b), _mm_set1_ps(fac_b)));
+  _mm_storeu_ps(out, result);
+#else
+  out[0] = a[0] * fac_a + b[0] * fac_b;
+  out[1] = a[1] * fac_a + b[1] * fac_b;
+  out[2] = a[2] * fac_a + b[2] * fac_b;
+#endif
+  out[3] = alpha;
+}
+
 /* ******** Mix Base Operation ******** */
 
 MixBaseOperation::MixBaseOperation()
@@ -69,16 +90,13 @@ void MixBaseOperation::update_memory_buffer_partial(MemoryBuffer *output,
 
 void MixBaseOperation::update_memory_buffer_row(PixelCursor &p)
 {
+  const bool use_value_alpha_multiply = this->use_value_alpha_multiply();
   while (p.out < p.row_end) {
     float value = p.value[0];
-    if (this->use_value_alpha_multiply()) {
+    if (use_value_alpha_multiply) {
       value *= p.color2[3];
     }
-    const float value_m = 1.0f - value;
-    p.out[0] = value_m * p.color1[0] + value * p.color2[0];
-    p.out[1] = value_m * p.color1[1] + value * p.color2[1];
-    p.out[2] = value_m * p.color1[2] + value * p.color2[2];
-    p.out[3] = p.color1[3];
+    mix_rgb_keep_alpha(p.out, p.color1, 1.0f - value, p.color2, value);
     p.next();
   }
 }
@@ -87,15 +105,13 @@ void MixBaseOperation::update_memory_buffer_row(PixelCursor &p)
 
 void MixAddOperation::update_memory_buffer_row(PixelCursor &p)
 {
+  const bool use_value_alpha_multiply = this->use_value_alpha_multiply();
   while (p.out < p.row_end) {
     float value = p.value[0];
-    if (this->use_value_alpha_multiply()) {
+    if (use_value_alpha_multiply) {
       value *= p.color2[3];
     }
-    p.out[0] = p.color1[0] + value * p.color2[0];
-    p.out[1] = p.color1[1] + value * p.color2[1];
-    p.out[2] = p.color1[2] + value * p.color2[2];
-    p.out[3] = p.color1[3];
+    mix_rgb_keep_alpha(p.out, p.color1, 1.0f, p.color2, value);
 
     clamp_if_needed(p.out);
     p.next();
@@ -106,16 +122,13 @@ void MixAddOperation::update_memory_buffer_row(PixelCursor &p)
 
 void MixBlendOperation::update_memory_buffer_row(PixelCursor &p)
 {
+  const bool use_value_alpha_multiply = this->use_value_alpha_multiply();
   while (p.out < p.row_end) {
     float value = p.value[0];
-    if (this->use_value_alpha_multiply()) {
+    if (use_value_alpha_multiply) {
       value *= p.color2[3];
     }
-    float value_m = 1.0f - value;
-    p.out[0] = value_m * p.color1[0] + value * p.color2[0];
-    p.out[1] = value_m * p.color1[1] + value * p.color2[1];
-    p.out[2] = value_m * p.color1[2] + value * p.color2[2];
-    p.out[3] = p.color1[3];
+    mix_rgb_keep_alpha(p.out, p.color1, 1.0f - value, p.color2, value);
 
     clamp_if_needed(p.out);
     p.next();
@@ -618,15 +631,13 @@ void MixSoftLightOperation::update_memory_buffer_row(PixelCursor &p)
 
 void MixSubtractOperation::update_memory_buffer_row(PixelCursor &p)
 {
+  const bool use_value_alpha_multiply = this->use_value_alpha_multiply();
   while (p.out < p.row_end) {
     float value = p.value[0];
-    if (this->use_value_alpha_multiply()) {
+    if (use_value_alpha_multiply) {
       value *= p.color2[3];
     }
-    p.out[0] = p.color1[0] - value * p.color2[0];
-    p.out[1] = p.color1[1] - value * p.color2[1];
-    p.out[2] = p.color1[2] - value * p.color2[2];
-    p.out[3] = p.color1[3];
+    mix_rgb_keep_alpha(p.out, p.color1, 1.0f, p.color2, -value);
 
     clamp_if_needed(p.out);
     p.next();
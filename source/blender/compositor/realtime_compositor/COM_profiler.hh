@@ -6,11 +6,16 @@
 
 #include "BLI_map.hh"
 #include "BLI_timeit.hh"
+#include "BLI_vector.hh"
 
 #include "DNA_node_types.h"
 
 #include "NOD_derived_node_tree.hh"
 
+namespace blender::gpu {
+class QueryPool;
+}
+
 namespace blender::realtime_compositor {
 
 class Context;
@@ -28,6 +33,23 @@ class Profiler {
    * evaluation time of each individual node. */
   Map<bNodeInstanceKey, timeit::Nanoseconds> nodes_evaluation_times_;
 
+  /* The GPU work of an operation is only submitted during its evaluation and executed later, so
+   * the evaluation time of nodes evaluated on the GPU is measured using GPU timestamps recorded
+   * before and after their evaluation. The timestamps are only read back in the finalize method,
+   * so that the GPU is not stalled during evaluation. The pool is null if no node was evaluated
+   * on the GPU or if timer queries are not supported by the GPU backend. */
+  gpu::QueryPool *gpu_timestamps_ = nullptr;
+  int gpu_timestamps_count_ = 0;
+
+  /* The node instance key of the node evaluated on the GPU along with the indices of its start
+   * and end timestamps in the gpu_timestamps_ pool. */
+  struct GPUNodeTimer {
+    bNodeInstanceKey node_instance_key;
+    int start_timestamp;
+    int end_timestamp;
+  };
+  Vector<GPUNodeTimer> gpu_node_timers_;
+
  public:
   /* Returns a reference to the nodes evaluation times. */
   Map<bNodeInstanceKey, timeit::Nanoseconds> &get_nodes_evaluation_times();
@@ -35,10 +57,29 @@ class Profiler {
   /* Set the evaluation time of the node identified by the given node instance key. */
   void set_node_evaluation_time(bNodeInstanceKey node_instance_key, timeit::Nanoseconds time);
 
-  /* Finalize profiling by computing node group times. This should be called after evaluation. */
+  /* Returns true if the evaluation time of nodes evaluated on the GPU can be measured using GPU
+   * timestamps, in which case begin_gpu_node_evaluation and end_gpu_node_evaluation should be
+   * used instead of set_node_evaluation_time. Should be called from the GPU context of the
+   * evaluation. */
+  bool use_gpu_timestamps() const;
+
+  /* Record the GPU timestamps before and after the evaluation of the node identified by the given
+   * node instance key. Evaluations can't be nested. */
+  void begin_gpu_node_evaluation(bNodeInstanceKey node_instance_key);
+  void end_gpu_node_evaluation();
+
+  /* Finalize profiling by reading back the GPU timestamps and computing node group times. This
+   * should be called after evaluation from the GPU context of the evaluation. */
   void finalize(const bNodeTree &node_tree);
 
  private:
+  /* Record a GPU timestamp and return its index in the gpu_timestamps_ pool. */
+  int record_gpu_timestamp();
+
+  /* Read back the GPU timestamps and add the GPU evaluation times to the nodes evaluation times,
+   * then free the timestamps pool. */
+  void resolve_gpu_timestamps();
+
   /* Computes the evaluation time of every group node inside the given tree recursively by
    * accumulating the evaluation time of its nodes, setting the computed time to the group nodes.
    * The time is returned since the method is called recursively. */
@@ -9,6 +9,7 @@
 #include "COM_cached_mask.hh"
 #include "COM_cached_shader.hh"
 #include "COM_cached_texture.hh"
+#include "COM_denoised_image.hh"
 #include "COM_deriche_gaussian_coefficients.hh"
 #include "COM_distortion_grid.hh"
 #include "COM_fog_glow_kernel.hh"
@@ -63,6 +64,7 @@ class StaticCacheManager {
   DericheGaussianCoefficientsContainer deriche_gaussian_coefficients;
   VanVlietGaussianCoefficientsContainer van_vliet_gaussian_coefficients;
   FogGlowKernelContainer fog_glow_kernels;
+  DenoisedImageContainer denoised_images;
 
  private:
   /* The cache manager should skip the next reset. See the skip_next_reset() method for more
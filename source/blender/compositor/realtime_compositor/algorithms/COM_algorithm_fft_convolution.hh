@@ -0,0 +1,38 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "BLI_function_ref.hh"
+#include "BLI_math_vector_types.hh"
+
+namespace blender::realtime_compositor {
+
+/* The radius starting from which convolving an image in the frequency domain is faster than direct
+ * convolution. The cost of direct convolution grows with the square of the radius, while the cost
+ * in the frequency domain only depends on the size of the image. The value was chosen by
+ * comparing timings on typical image sizes. */
+constexpr int FFT_CONVOLUTION_MINIMUM_RADIUS = 24;
+
+/* Returns true if images can be convolved in the frequency domain, that is, if Blender was built
+ * with FFTW. */
+bool is_fft_convolution_supported();
+
+/* Convolves an image of the given size with a square kernel of the given radius in the frequency
+ * domain on the CPU. The result is the same as computing, for every pixel, the sum of the pixels
+ * in the window of the given radius around it multiplied by their weight, divided by the sum of
+ * the weights, where every channel is weighted and normalized independently.
+ *
+ * The read_input function is called with texels in the range [-radius, size + radius), that is,
+ * it defines the boundary condition of the image. The read_weight function is called with offsets
+ * in the range [-radius, radius] and returns the weight of the pixel at that offset from the
+ * pixel being computed. The write_output function is called once for every texel in the range
+ * [0, size) with the convolved color. All functions can be called from multiple threads. */
+void fft_convolve(int2 size,
+                  int radius,
+                  FunctionRef<float4(int2 texel)> read_input,
+                  FunctionRef<float4(int2 offset)> read_weight,
+                  FunctionRef<void(int2 texel, float4 color)> write_output);
+
+}  // namespace blender::realtime_compositor
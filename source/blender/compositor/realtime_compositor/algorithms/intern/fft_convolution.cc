@@ -0,0 +1,207 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <complex>
+
+#if defined(WITH_FFTW3)
+#  include <fftw3.h>
+#endif
+
+#include "BLI_assert.h"
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_fftw.hh"
+#include "BLI_function_ref.hh"
+#include "BLI_index_range.hh"
+#include "BLI_math_base.h"
+#include "BLI_math_vector_types.hh"
+#include "BLI_task.hh"
+
+#include "COM_algorithm_fft_convolution.hh"
+
+namespace blender::realtime_compositor {
+
+bool is_fft_convolution_supported()
+{
+#if defined(WITH_FFTW3)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void fft_convolve([[maybe_unused]] const int2 size,
+                  [[maybe_unused]] const int radius,
+                  [[maybe_unused]] FunctionRef<float4(int2 texel)> read_input,
+                  [[maybe_unused]] FunctionRef<float4(int2 offset)> read_weight,
+                  [[maybe_unused]] FunctionRef<void(int2 texel, float4 color)> write_output)
+{
+#if defined(WITH_FFTW3)
+  fftw::initialize_float();
+
+  /* Since we will be doing a circular convolution, we need to pad the input image by the radius
+   * on both sides to avoid the kernel affecting the pixels at the other side of image. The padding
+   * is read from the input, so the boundary condition is defined by the read_input function. */
+  const int2 padded_size = size + radius * 2;
+  const int2 spatial_size = fftw::optimal_size_for_real_transform(padded_size);
+
+  /* The FFTW real to complex transforms utilizes the hermitian symmetry of real transforms and
+   * stores only half the output since the other half is redundant, so we only allocate half of the
+   * first dimension. See Section 4.3.4 Real-data DFT Array Format in the FFTW manual for more
+   * information. */
+  const int2 frequency_size = int2(spatial_size.x / 2 + 1, spatial_size.y);
+
+  const int channels_count = 4;
+  const int64_t spatial_pixels_per_channel = int64_t(spatial_size.x) * spatial_size.y;
+  const int64_t frequency_pixels_per_channel = int64_t(frequency_size.x) * frequency_size.y;
+  const int64_t spatial_pixels_count = spatial_pixels_per_channel * channels_count;
+  const int64_t frequency_pixels_count = frequency_pixels_per_channel * channels_count;
+
+  /* The spatial domain buffer is shared by the kernel and the image, each channel is stored in
+   * planar format for better cache locality, that is, RRRR...GGGG...BBBB...AAAA. */
+  float *spatial_domain = fftwf_alloc_real(spatial_pixels_count);
+  std::complex<float> *kernel_frequency_domain = reinterpret_cast<std::complex<float> *>(
+      fftwf_alloc_complex(frequency_pixels_count));
+  std::complex<float> *image_frequency_domain = reinterpret_cast<std::complex<float> *>(
+      fftwf_alloc_complex(frequency_pixels_count));
+
+  /* Create the plans using the image buffers, but the same plans will be used for the kernel since
+   * they both have the same dimensions. The arrays are not written to by the planner since
+   * FFTW_ESTIMATE is used. */
+  fftwf_plan forward_plan = fftwf_plan_dft_r2c_2d(
+      spatial_size.y,
+      spatial_size.x,
+      spatial_domain,
+      reinterpret_cast<fftwf_complex *>(image_frequency_domain),
+      FFTW_ESTIMATE);
+  fftwf_plan backward_plan = fftwf_plan_dft_c2r_2d(
+      spatial_size.y,
+      spatial_size.x,
+      reinterpret_cast<fftwf_complex *>(image_frequency_domain),
+      spatial_domain,
+      FFTW_ESTIMATE);
+
+  const auto forward_transform = [&](std::complex<float> *frequency_domain) {
+    threading::parallel_for(IndexRange(channels_count), 1, [&](const IndexRange sub_range) {
+      for (const int64_t channel : sub_range) {
+        fftwf_execute_dft_r2c(forward_plan,
+                              spatial_domain + spatial_pixels_per_channel * channel,
+                              reinterpret_cast<fftwf_complex *>(frequency_domain) +
+                                  frequency_pixels_per_channel * channel);
+      }
+    });
+  };
+
+  threading::parallel_for(IndexRange(spatial_pixels_count), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      spatial_domain[i] = 0.0f;
+    }
+  });
+
+  /* Use a double to sum the weights since floats are not stable with threaded summation. */
+  threading::EnumerableThreadSpecific<double4> sum_by_thread([]() { return double4(0.0); });
+
+  /* Write the kernel centered at the zero point with wrap around, which is the expected format
+   * for doing circular convolutions in the frequency domain. The kernel is mirrored because the
+   * weights are given for the pixels around the one being computed, while a convolution weights
+   * the pixel at an offset by the kernel value at the negated offset. */
+  const int kernel_size = radius * 2 + 1;
+  threading::parallel_for(IndexRange(kernel_size), 1, [&](const IndexRange sub_y_range) {
+    double4 &sum = sum_by_thread.local();
+    for (const int64_t y : sub_y_range) {
+      for (const int64_t x : IndexRange(kernel_size)) {
+        const int2 offset = int2(x, y) - radius;
+        const float4 weight = read_weight(offset);
+        const int64_t output_x = mod_i(-offset.x, spatial_size.x);
+        const int64_t output_y = mod_i(-offset.y, spatial_size.y);
+        const int64_t base_index = output_x + output_y * spatial_size.x;
+        for (const int channel : IndexRange(channels_count)) {
+          spatial_domain[base_index + spatial_pixels_per_channel * channel] = weight[channel];
+        }
+        sum += double4(weight);
+      }
+    }
+  });
+
+  double4 weights_sum = double4(0.0);
+  for (const double4 &sum : sum_by_thread) {
+    weights_sum += sum;
+  }
+
+  forward_transform(kernel_frequency_domain);
+
+  /* Pad the image to the required spatial domain size. Only the padded size is read from the
+   * input, the rest of the spatial domain is zero. */
+  threading::parallel_for(IndexRange(spatial_size.y), 1, [&](const IndexRange sub_y_range) {
+    for (const int64_t y : sub_y_range) {
+      for (const int64_t x : IndexRange(spatial_size.x)) {
+        const bool is_inside_image = x < padded_size.x && y < padded_size.y;
+        const float4 color = is_inside_image ? read_input(int2(x, y) - radius) : float4(0.0f);
+        const int64_t base_index = x + y * spatial_size.x;
+        for (const int channel : IndexRange(channels_count)) {
+          spatial_domain[base_index + spatial_pixels_per_channel * channel] = color[channel];
+        }
+      }
+    }
+  });
+
+  forward_transform(image_frequency_domain);
+
+  /* Multiply the kernel and the image in the frequency domain to perform the convolution. The
+   * FFT is not normalized, meaning the result of the FFT followed by an inverse FFT will result
+   * in an image that is scaled by a factor of the product of the width and height, so we take
+   * that into account by dividing by that scale. And since the Fourier transform is linear, the
+   * weights are normalized in the frequency domain as well. Channels whose weights sum to zero
+   * are zero, like a safe division. See Section 4.8.6 Multi-dimensional Transforms of the FFTW
+   * manual for more information. */
+  float4 normalization_scale;
+  for (const int channel : IndexRange(channels_count)) {
+    const double scale = double(spatial_pixels_per_channel) * weights_sum[channel];
+    normalization_scale[channel] = scale == 0.0 ? 0.0f : float(1.0 / scale);
+  }
+  threading::parallel_for(IndexRange(frequency_size.y), 1, [&](const IndexRange sub_y_range) {
+    for (const int channel : IndexRange(channels_count)) {
+      for (const int64_t y : sub_y_range) {
+        for (const int64_t x : IndexRange(frequency_size.x)) {
+          const int64_t index = x + y * frequency_size.x + frequency_pixels_per_channel * channel;
+          image_frequency_domain[index] *= kernel_frequency_domain[index] *
+                                           normalization_scale[channel];
+        }
+      }
+    }
+  });
+
+  threading::parallel_for(IndexRange(channels_count), 1, [&](const IndexRange sub_range) {
+    for (const int64_t channel : sub_range) {
+      fftwf_execute_dft_c2r(backward_plan,
+                            reinterpret_cast<fftwf_complex *>(image_frequency_domain) +
+                                frequency_pixels_per_channel * channel,
+                            spatial_domain + spatial_pixels_per_channel * channel);
+    }
+  });
+
+  /* Write the result skipping the padding. */
+  threading::parallel_for(IndexRange(size.y), 1, [&](const IndexRange sub_y_range) {
+    for (const int64_t y : sub_y_range) {
+      for (const int64_t x : IndexRange(size.x)) {
+        const int64_t base_index = (x + radius) + (y + radius) * spatial_size.x;
+        float4 color;
+        for (const int channel : IndexRange(channels_count)) {
+          color[channel] = spatial_domain[base_index + spatial_pixels_per_channel * channel];
+        }
+        write_output(int2(x, y), color);
+      }
+    }
+  });
+
+  fftwf_destroy_plan(forward_plan);
+  fftwf_destroy_plan(backward_plan);
+  fftwf_free(spatial_domain);
+  fftwf_free(kernel_frequency_domain);
+  fftwf_free(image_frequency_domain);
+#else
+  BLI_assert_unreachable();
+#endif
+}
+
+}  // namespace blender::realtime_compositor
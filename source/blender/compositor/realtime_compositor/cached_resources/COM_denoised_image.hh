@@ -0,0 +1,76 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "BLI_array.hh"
+#include "BLI_map.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+
+#include "COM_cached_resource.hh"
+
+namespace blender::realtime_compositor {
+
+/* Computes a hash of the given pixels starting from the given seed, such that hashes of multiple
+ * buffers and settings can be chained to identify the inputs of a DenoisedImage. */
+uint64_t hash_denoise_input(Span<float> pixels, uint64_t seed);
+
+/* ------------------------------------------------------------------------------------------------
+ * Denoised Image Key.
+ */
+class DenoisedImageKey {
+ public:
+  uint64_t inputs_hash;
+  int2 size;
+
+  DenoisedImageKey(uint64_t inputs_hash, int2 size);
+
+  uint64_t hash() const;
+};
+
+bool operator==(const DenoisedImageKey &a, const DenoisedImageKey &b);
+
+/* -------------------------------------------------------------------------------------------------
+ * Denoised Image.
+ *
+ * A cached resource that stores the pixels of an image denoised on the CPU, identified by a hash
+ * of the pixels of its inputs and the denoise settings. Denoising is typically the most expensive
+ * operation of the node tree, and its inputs rarely change while the nodes after it are edited,
+ * so it is only done again when its inputs change. This is used for both the denoised images and
+ * their denoised auxiliary passes, such that the auxiliary passes are not denoised again when only
+ * the image changes. */
+class DenoisedImage : public CachedResource {
+ public:
+  Array<float> pixels;
+
+  DenoisedImage(Span<float> pixels);
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Denoised Image Container.
+ */
+class DenoisedImageContainer : CachedResourceContainer {
+ private:
+  Map<DenoisedImageKey, std::unique_ptr<DenoisedImage>> map_;
+
+ public:
+  void reset() override;
+
+  /* Check if there is an available DenoisedImage cached resource with the given key in the
+   * container, if one exists, tag it as needed to keep it cached for the next evaluation and
+   * return it, otherwise, return nullptr. Unlike other containers, the resource can't be created
+   * here since it is computed by the node, so it should be added using the add method. */
+  DenoisedImage *get(const DenoisedImageKey &key);
+
+  /* Add a DenoisedImage cached resource with the given key and a copy of the given pixels to the
+   * container. This should only be called after the denoising finished, since a canceled
+   * denoising would give an incomplete result. */
+  void add(const DenoisedImageKey &key, Span<float> pixels);
+};
+
+}  // namespace blender::realtime_compositor
@@ -114,21 +114,31 @@ CachedMask::CachedMask(Context &context,
   Vector<MaskRasterHandle *> handles = get_mask_raster_handles(
       mask, size, frame, use_feather, motion_blur_samples, motion_blur_shutter);
 
+  /* Compute the coordinates in the [0, 1] range and add 0.5 to evaluate the mask at the center
+   * of pixels. Do aspect ratio correction around the center 0.5 point. The horizontal coordinates
+   * are the same for all rows, so compute them once. */
+  Array<float> xs(size.x);
+  for (const int64_t x : xs.index_range()) {
+    xs[x] = ((float(x) + 0.5f) / float(size.x) - 0.5f) + 0.5f;
+  }
+
   Array<float> evaluated_mask(size.x * size.y);
   threading::parallel_for(IndexRange(size.y), 1, [&](const IndexRange sub_y_range) {
+    Array<float> handle_values(size.x);
     for (const int64_t y : sub_y_range) {
-      for (const int64_t x : IndexRange(size.x)) {
-        /* Compute the coordinates in the [0, 1] range and add 0.5 to evaluate the mask at the
-         * center of pixels. */
-        float2 coordinates = (float2(x, y) + 0.5f) / float2(size);
-        /* Do aspect ratio correction around the center 0.5 point. */
-        coordinates = (coordinates - float2(0.5)) * float2(1.0, aspect_ratio) + float2(0.5);
-
-        float mask_value = 0.0f;
-        for (MaskRasterHandle *handle : handles) {
-          mask_value += BKE_maskrasterize_handle_sample(handle, coordinates);
+      const float coordinate_y = ((float(y) + 0.5f) / float(size.y) - 0.5f) * aspect_ratio + 0.5f;
+      MutableSpan<float> row_values = evaluated_mask.as_mutable_span().slice(y * size.x, size.x);
+      row_values.fill(0.0f);
+      /* Sample whole rows at once, which is faster than sampling single pixels. */
+      for (MaskRasterHandle *handle : handles) {
+        BKE_maskrasterize_handle_sample_row(
+            handle, xs.data(), uint(size.x), coordinate_y, handle_values.data());
+        for (const int64_t x : row_values.index_range()) {
+          row_values[x] += handle_values[x];
         }
-        evaluated_mask[y * size.x + x] = mask_value / handles.size();
+      }
+      for (const int64_t x : row_values.index_range()) {
+        row_values[x] /= handles.size();
       }
     }
   });
@@ -0,0 +1,80 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <cstdint>
+#include <memory>
+
+#include <xxhash.h>
+
+#include "BLI_hash.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+
+#include "COM_denoised_image.hh"
+
+namespace blender::realtime_compositor {
+
+uint64_t hash_denoise_input(const Span<float> pixels, const uint64_t seed)
+{
+  return XXH3_64bits_withSeed(pixels.data(), pixels.size_in_bytes(), seed);
+}
+
+/* --------------------------------------------------------------------
+ * Denoised Image Key.
+ */
+
+DenoisedImageKey::DenoisedImageKey(uint64_t inputs_hash, int2 size)
+    : inputs_hash(inputs_hash), size(size)
+{
+}
+
+uint64_t DenoisedImageKey::hash() const
+{
+  return get_default_hash(inputs_hash, size);
+}
+
+bool operator==(const DenoisedImageKey &a, const DenoisedImageKey &b)
+{
+  return a.inputs_hash == b.inputs_hash && a.size == b.size;
+}
+
+/* --------------------------------------------------------------------
+ * Denoised Image.
+ */
+
+DenoisedImage::DenoisedImage(Span<float> pixels) : pixels(pixels) {}
+
+/* --------------------------------------------------------------------
+ * Denoised Image Container.
+ */
+
+void DenoisedImageContainer::reset()
+{
+  /* First, delete all resources that are no longer needed. */
+  map_.remove_if([](auto item) { return !item.value->needed; });
+
+  /* Second, reset the needed status of the remaining resources to false to ready them to track
+   * their needed status for the next evaluation. */
+  for (auto &value : map_.values()) {
+    value->needed = false;
+  }
+}
+
+DenoisedImage *DenoisedImageContainer::get(const DenoisedImageKey &key)
+{
+  std::unique_ptr<DenoisedImage> *image = map_.lookup_ptr(key);
+  if (image == nullptr) {
+    return nullptr;
+  }
+
+  (*image)->needed = true;
+  return image->get();
+}
+
+void DenoisedImageContainer::add(const DenoisedImageKey &key, Span<float> pixels)
+{
+  map_.add_overwrite(key, std::make_unique<DenoisedImage>(pixels));
+}
+
+}  // namespace blender::realtime_compositor
@@ -50,11 +50,22 @@ NodeOperation::NodeOperation(Context &context, DNode node) : Operation(context),
 
 void NodeOperation::evaluate()
 {
+  Profiler *profiler = context().profiler();
+
+  /* The CPU time of GPU evaluations only covers the submission of the work, so measure the
+   * execution time on the GPU instead when possible. */
+  if (profiler && context().use_gpu() && profiler->use_gpu_timestamps()) {
+    profiler->begin_gpu_node_evaluation(node_.instance_key());
+    Operation::evaluate();
+    profiler->end_gpu_node_evaluation();
+    return;
+  }
+
   const timeit::TimePoint before_time = timeit::Clock::now();
   Operation::evaluate();
   const timeit::TimePoint after_time = timeit::Clock::now();
-  if (context().profiler()) {
-    context().profiler()->set_node_evaluation_time(node_.instance_key(), after_time - before_time);
+  if (profiler) {
+    profiler->set_node_evaluation_time(node_.instance_key(), after_time - before_time);
   }
 }
 
@@ -2,6 +2,7 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_array.hh"
 #include "BLI_timeit.hh"
 
 #include "DNA_node_types.h"
@@ -10,6 +11,11 @@
 
 #include "NOD_derived_node_tree.hh"
 
+#include "GPU_capabilities.hh"
+
+#include "gpu_backend.hh"
+#include "gpu_query.hh"
+
 #include "COM_context.hh"
 #include "COM_profiler.hh"
 
@@ -26,6 +32,59 @@ void Profiler::set_node_evaluation_time(bNodeInstanceKey node_instance_key,
   nodes_evaluation_times_.lookup_or_add(node_instance_key, timeit::Nanoseconds::zero()) += time;
 }
 
+bool Profiler::use_gpu_timestamps() const
+{
+  return GPU_timer_query_support();
+}
+
+int Profiler::record_gpu_timestamp()
+{
+  if (gpu_timestamps_ == nullptr) {
+    gpu_timestamps_ = gpu::GPUBackend::get()->querypool_alloc();
+    gpu_timestamps_->init(gpu::GPU_QUERY_TIMESTAMP);
+    gpu_timestamps_count_ = 0;
+  }
+  gpu_timestamps_->query_timestamp();
+  return gpu_timestamps_count_++;
+}
+
+void Profiler::begin_gpu_node_evaluation(bNodeInstanceKey node_instance_key)
+{
+  BLI_assert(this->use_gpu_timestamps());
+  BLI_assert(gpu_node_timers_.is_empty() || gpu_node_timers_.last().end_timestamp != -1);
+  GPUNodeTimer timer;
+  timer.node_instance_key = node_instance_key;
+  timer.start_timestamp = this->record_gpu_timestamp();
+  timer.end_timestamp = -1;
+  gpu_node_timers_.append(timer);
+}
+
+void Profiler::end_gpu_node_evaluation()
+{
+  GPUNodeTimer &timer = gpu_node_timers_.last();
+  BLI_assert(timer.end_timestamp == -1);
+  timer.end_timestamp = this->record_gpu_timestamp();
+}
+
+void Profiler::resolve_gpu_timestamps()
+{
+  if (gpu_timestamps_ == nullptr) {
+    return;
+  }
+
+  Array<uint64_t> timestamps(gpu_timestamps_count_);
+  gpu_timestamps_->get_timestamp_result(timestamps);
+  for (const GPUNodeTimer &timer : gpu_node_timers_) {
+    const uint64_t time = timestamps[timer.end_timestamp] - timestamps[timer.start_timestamp];
+    this->set_node_evaluation_time(timer.node_instance_key, timeit::Nanoseconds(time));
+  }
+
+  delete gpu_timestamps_;
+  gpu_timestamps_ = nullptr;
+  gpu_timestamps_count_ = 0;
+  gpu_node_timers_.clear();
+}
+
 timeit::Nanoseconds Profiler::accumulate_node_group_times(const bNodeTree &node_tree,
                                                           bNodeInstanceKey instance_key)
 {
@@ -65,6 +124,8 @@ timeit::Nanoseconds Profiler::accumulate_node_group_times(const bNodeTree &node_
 
 void Profiler::finalize(const bNodeTree &node_tree)
 {
+  this->resolve_gpu_timestamps();
+
   /* Compute the evaluation time of all node groups starting from the root tree. */
   this->accumulate_node_group_times(node_tree, bke::NODE_INSTANCE_KEY_BASE);
 }
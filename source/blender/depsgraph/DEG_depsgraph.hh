@@ -123,6 +123,17 @@ void DEG_id_tag_update_ex(Main *bmain, ID *id, unsigned int flags);
 
 void DEG_graph_id_tag_update(Main *bmain, Depsgraph *depsgraph, ID *id, unsigned int flags);
 
+/**
+ * Tag given ID for an update in all the dependency graphs, after only parameters stored in the ID
+ * itself changed (such as shape key values or custom properties), but no data owned by the ID
+ * (such as mesh attributes or shape key positions). Evaluated copies which are not tagged for
+ * any other reason are then patched instead of being copied again.
+ *
+ * The \a flags are tagged in addition to #ID_RECALC_PARAMETERS, and must not imply changes to
+ * the data owned by the ID.
+ */
+void DEG_id_tag_update_parameters_only(Main *bmain, ID *id, unsigned int flags);
+
 /**
  * Tag the given ID for an update in the given depsgraph even though it evaluated state might not
  * have changed. This can be used when some data is required that is generated as a side effect of
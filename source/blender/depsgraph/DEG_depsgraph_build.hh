@@ -72,6 +72,14 @@ void DEG_graph_relations_update(Depsgraph *graph);
 /** Tag all relations in the database for update. */
 void DEG_relations_tag_update(Main *bmain);
 
+/**
+ * Tag relations for update after a change which only affects the relations of the given ID, for
+ * example when a modifier or constraint is added to an object. Only the graphs that contain the
+ * ID are rebuilt, use #DEG_relations_tag_update for changes which can affect other IDs as well
+ * (for example linking data-blocks into a collection).
+ */
+void DEG_id_relations_tag_update(Main *bmain, ID *id);
+
 /* Add Dependencies  ----------------------------- */
 
 /**
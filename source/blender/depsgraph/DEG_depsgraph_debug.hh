@@ -11,6 +11,9 @@
 #pragma once
 
 #include <cstdio>
+#include <string>
+
+#include "BLI_span.hh"
 
 struct Depsgraph;
 struct Main;
@@ -50,6 +53,40 @@ void DEG_debug_stats_gnuplot(const Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* ************************************************ */
+/* Operation Evaluation Profile */
+
+/** Evaluation of a single operation, see #DEG_debug_operation_profile_enable. */
+struct DEGOperationProfileEntry {
+  /** Name of the ID the operation belongs to, including the ID code. */
+  std::string id_name;
+  std::string component_name;
+  std::string operation_name;
+  /** Identifier of the thread which evaluated the operation. */
+  int thread_index;
+  /** In seconds, relative to the start of the evaluation. */
+  double start_time;
+  /** In seconds. */
+  double duration;
+};
+
+/**
+ * Record the start time, duration and thread of every evaluated operation. The profile is
+ * replaced on every evaluation of the graph.
+ */
+void DEG_debug_operation_profile_enable(Depsgraph *graph, bool enable);
+bool DEG_debug_operation_profile_is_enabled(const Depsgraph *graph);
+
+/** Profile of the last evaluation, ordered by start time. */
+blender::Span<DEGOperationProfileEntry> DEG_debug_operation_profile_get(const Depsgraph *graph);
+
+/**
+ * Write the profile of the last evaluation in the Chrome trace event format, which can be
+ * inspected with https://ui.perfetto.dev or `chrome://tracing`.
+ * \return False when the file could not be written.
+ */
+bool DEG_debug_operation_profile_write_trace(const Depsgraph *graph, const char *filepath);
+
 /* ************************************************ */
 
 /** Compare two dependency graphs. */
@@ -0,0 +1,43 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Evaluation of several frames at the same time, each in its own depsgraph.
+ *
+ * All depsgraphs share the same original data-blocks, every depsgraph has its own copy-on-write
+ * evaluated copies. This is only possible when the evaluated state of a frame does not depend on
+ * the evaluation of the previous frames (no simulations or point caches), and when evaluation
+ * does not write to data shared between depsgraphs.
+ */
+
+#pragma once
+
+#include "BLI_function_ref.hh"
+#include "BLI_span.hh"
+
+struct Depsgraph;
+
+/**
+ * Check whether frames of the depsgraph can be evaluated in parallel with other depsgraphs which
+ * are built from the same scene, view layer and evaluation mode.
+ */
+bool DEG_frame_parallel_evaluation_supported(const Depsgraph *depsgraph);
+
+/**
+ * Evaluate the depsgraphs for the given frames, and call \a consume for every frame in order
+ * from the calling thread. The evaluated state of the depsgraph passed to \a consume stays valid
+ * until the callback returns. Evaluation stops when \a consume returns false.
+ *
+ * Up to `graphs.size()` frames are evaluated at the same time. All depsgraphs must be built from
+ * the same scene, view layer and evaluation mode, and must not be active. When frame-parallel
+ * evaluation is not supported by the depsgraphs, all frames are evaluated in the first depsgraph.
+ *
+ * The original scene frame is not changed, frames are set on the depsgraphs only.
+ */
+void DEG_evaluate_frames_parallel(
+    blender::Span<Depsgraph *> graphs,
+    blender::Span<float> frames,
+    blender::FunctionRef<bool(Depsgraph *depsgraph, float frame)> consume);
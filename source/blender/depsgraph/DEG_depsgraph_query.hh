@@ -144,6 +144,16 @@ bool DEG_is_fully_evaluated(const Depsgraph *depsgraph);
  */
 bool DEG_id_is_fully_evaluated(const Depsgraph *depsgraph, const ID *id_eval);
 
+/**
+ * Get a value which changes every time the data-block is tagged for update in the depsgraph, and
+ * when the depsgraph relations are rebuilt. Changes of the evaluated data-block which are not
+ * caused by a tag, like animated properties, do not change it. Works with original and evaluated
+ * data-blocks.
+ *
+ * \return 0 when the data-block is not in the depsgraph.
+ */
+uint64_t DEG_id_tag_stamp_get(const Depsgraph *depsgraph, const ID *id);
+
 /**
  * Returns false when the objects geometry is not fully evaluated in its depsgraph yet. In this
  * case, the geometry must not be accessed. Otherwise returns true when geometry is fully evaluated
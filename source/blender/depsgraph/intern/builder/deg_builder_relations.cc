@@ -18,8 +18,10 @@
 #include "DNA_modifier_types.h"
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_action_types.h"
@@ -3471,8 +3473,25 @@ void DepsgraphRelationBuilder::build_vfont(VFont *vfont)
 
 void DepsgraphRelationBuilder::build_copy_on_write_relations()
 {
-  for (IDNode *id_node : graph_->id_nodes) {
-    build_copy_on_write_relations(id_node);
+  /* Finding the relations of an ID only reads the inputs of operations of that ID which are not
+   * part of its copy-on-evaluation component. None of the relations added for other IDs point
+   * there, so the result is the same as building the relations one ID after the other. */
+  const Span<IDNode *> id_nodes = graph_->id_nodes;
+  Array<Vector<PendingRelation>> relations(id_nodes.size());
+  threading::parallel_for(id_nodes.index_range(), 64, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      find_copy_on_write_relations(id_nodes[i], relations[i]);
+    }
+  });
+  for (const Span<PendingRelation> id_relations : relations) {
+    add_pending_relations(id_relations);
+  }
+}
+
+void DepsgraphRelationBuilder::add_pending_relations(const Span<PendingRelation> relations)
+{
+  for (const PendingRelation &relation : relations) {
+    add_operation_relation(relation.from, relation.to, relation.description, relation.flags);
   }
 }
 
@@ -3513,6 +3532,14 @@ void DepsgraphRelationBuilder::build_nested_shapekey(ID *owner, Key *key)
 }
 
 void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
+{
+  Vector<PendingRelation> relations;
+  find_copy_on_write_relations(id_node, relations);
+  add_pending_relations(relations);
+}
+
+void DepsgraphRelationBuilder::find_copy_on_write_relations(
+    IDNode *id_node, Vector<PendingRelation> &r_relations) const
 {
   ID *id_orig = id_node->id_orig;
 
@@ -3576,8 +3603,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
      * copy of ID. */
     OperationNode *op_entry = comp_node->get_entry_operation();
     if (op_entry != nullptr) {
-      Relation *rel = graph_->add_new_relation(op_cow, op_entry, "Copy-on-Eval Dependency");
-      rel->flag |= rel_flag;
+      r_relations.append({op_cow, op_entry, "Copy-on-Eval Dependency", rel_flag});
     }
     /* All dangling operations should also be executed after copy-on-evaluation. */
     for (OperationNode *op_node : comp_node->operations_map->values()) {
@@ -3585,8 +3611,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
         continue;
       }
       if (op_node->inlinks.is_empty()) {
-        Relation *rel = graph_->add_new_relation(op_cow, op_node, "Copy-on-Eval Dependency");
-        rel->flag |= rel_flag;
+        r_relations.append({op_cow, op_node, "Copy-on-Eval Dependency", rel_flag});
       }
       else {
         bool has_same_comp_dependency = false;
@@ -3601,8 +3626,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
           }
         }
         if (!has_same_comp_dependency) {
-          Relation *rel = graph_->add_new_relation(op_cow, op_node, "Copy-on-Eval Dependency");
-          rel->flag |= rel_flag;
+          r_relations.append({op_cow, op_node, "Copy-on-Eval Dependency", rel_flag});
         }
       }
     }
@@ -3623,8 +3647,10 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
       if (deg_eval_copy_is_needed(object_data_id)) {
         OperationKey data_copy_on_write_key(
             object_data_id, NodeType::COPY_ON_EVAL, OperationCode::COPY_ON_EVAL);
-        add_relation(
-            data_copy_on_write_key, copy_on_write_key, "Eval Order", RELATION_FLAG_GODMODE);
+        OperationNode *op_data_cow = get_node(data_copy_on_write_key);
+        if (op_data_cow != nullptr) {
+          r_relations.append({op_data_cow, op_cow, "Eval Order", RELATION_FLAG_GODMODE});
+        }
       }
     }
     else {
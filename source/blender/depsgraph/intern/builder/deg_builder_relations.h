@@ -74,6 +74,7 @@ struct ComponentNode;
 struct DepsNodeHandle;
 struct Depsgraph;
 class DepsgraphBuilderCache;
+struct DriverGroups;
 struct IDNode;
 struct Node;
 struct OperationNode;
@@ -276,6 +277,11 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
                                          bool add_absorption,
                                          const char *name);
 
+  /**
+   * Relations which only involve nodes of a single ID are added for all IDs at once. The
+   * relations of every ID are found in parallel, and added to the graph in the order of
+   * #Depsgraph::id_nodes afterwards, so that the resulting graph does not depend on scheduling.
+   */
   virtual void build_copy_on_write_relations();
   virtual void build_copy_on_write_relations(IDNode *id_node);
   virtual void build_driver_relations();
@@ -310,6 +316,20 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
                                    const char *description,
                                    int flags = 0);
 
+  /** Relation which has been found by a parallel pass and is yet to be added to the graph. */
+  struct PendingRelation {
+    OperationNode *from;
+    OperationNode *to;
+    const char *description;
+    int flags;
+  };
+
+  /** Only reads the graph, so it can be called for multiple IDs in parallel. */
+  void find_copy_on_write_relations(IDNode *id_node, Vector<PendingRelation> &r_relations) const;
+  void add_pending_relations(Span<PendingRelation> relations);
+
+  void build_driver_relations(const DriverGroups &driver_groups);
+
   template<typename KeyType>
   DepsNodeHandle create_node_handle(const KeyType &key, const char *default_name = "");
 
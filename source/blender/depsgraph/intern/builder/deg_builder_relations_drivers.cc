@@ -11,8 +11,11 @@
 #include "intern/builder/deg_builder_relations_drivers.h"
 
 #include <cstring>
+#include <memory>
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
+#include "BLI_task.hh"
 
 #include "DNA_anim_types.h"
 
@@ -136,16 +139,64 @@ static bool is_reachable(const Node *const from, const Node *const to)
   return false;
 }
 
+void DriverGroups::fill(ID *id)
+{
+  AnimData *adt = BKE_animdata_from_id(id);
+  if (adt == nullptr) {
+    return;
+  }
+
+  id_ptr = RNA_id_pointer_create(id);
+
+  LISTBASE_FOREACH (FCurve *, fcu, &adt->drivers) {
+    if (fcu->rna_path == nullptr) {
+      continue;
+    }
+
+    DriverDescriptor driver_desc(&id_ptr, fcu);
+    if (!driver_desc.driver_relations_needed()) {
+      continue;
+    }
+
+    groups.lookup_or_add_default_as(driver_desc.rna_prefix).append(driver_desc);
+  }
+}
+
 /* **** DepsgraphRelationBuilder functions **** */
 
 void DepsgraphRelationBuilder::build_driver_relations()
 {
-  for (IDNode *id_node : graph_->id_nodes) {
-    build_driver_relations(id_node);
+  /* Resolving the RNA paths of all drivers is the expensive part for rigs with many drivers, it
+   * is done in parallel. The relations are added afterwards in the order of the ID nodes, because
+   * adding a relation affects which relations are needed for the following drivers. */
+  const Span<IDNode *> id_nodes = graph_->id_nodes;
+  Array<std::unique_ptr<DriverGroups>> driver_groups(id_nodes.size());
+  threading::parallel_for(id_nodes.index_range(), 64, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      ID *id_orig = id_nodes[i]->id_orig;
+      const AnimData *adt = BKE_animdata_from_id(id_orig);
+      if (adt == nullptr || BLI_listbase_is_empty(&adt->drivers)) {
+        continue;
+      }
+      driver_groups[i] = std::make_unique<DriverGroups>();
+      driver_groups[i]->fill(id_orig);
+    }
+  });
+  for (const std::unique_ptr<DriverGroups> &id_driver_groups : driver_groups) {
+    if (id_driver_groups) {
+      build_driver_relations(*id_driver_groups);
+    }
   }
 }
 
 void DepsgraphRelationBuilder::build_driver_relations(IDNode *id_node)
+{
+  DriverGroups driver_groups;
+  driver_groups.fill(id_node->id_orig);
+  build_driver_relations(driver_groups);
+}
+
+void DepsgraphRelationBuilder::build_driver_relations(const DriverGroups &driver_groups)
 {
   /* Add relations between drivers that write to the same datablock.
    *
@@ -157,31 +208,7 @@ void DepsgraphRelationBuilder::build_driver_relations(IDNode *id_node)
    *   value will write the entire int containing the bit, in a non-thread-safe
    *   way.
    */
-  ID *id_orig = id_node->id_orig;
-  AnimData *adt = BKE_animdata_from_id(id_orig);
-  if (adt == nullptr) {
-    return;
-  }
-
-  /* Mapping from RNA prefix -> set of driver descriptors: */
-  Map<string, Vector<DriverDescriptor>> driver_groups;
-
-  PointerRNA id_ptr = RNA_id_pointer_create(id_orig);
-
-  LISTBASE_FOREACH (FCurve *, fcu, &adt->drivers) {
-    if (fcu->rna_path == nullptr) {
-      continue;
-    }
-
-    DriverDescriptor driver_desc(&id_ptr, fcu);
-    if (!driver_desc.driver_relations_needed()) {
-      continue;
-    }
-
-    driver_groups.lookup_or_add_default_as(driver_desc.rna_prefix).append(driver_desc);
-  }
-
-  for (Span<DriverDescriptor> prefix_group : driver_groups.values()) {
+  for (Span<DriverDescriptor> prefix_group : driver_groups.groups.values()) {
     /* For each node in the driver group, try to connect it to another node
      * in the same group without creating any cycles. */
     int num_drivers = prefix_group.size();
@@ -59,4 +59,18 @@ class DriverDescriptor {
   bool resolve_rna();
 };
 
+/** Drivers of an ID which need relations between each other, grouped by their RNA prefix. */
+struct DriverGroups {
+  /** Referenced by the descriptors, so the groups must not be moved once they are filled. */
+  PointerRNA id_ptr;
+  Map<string, Vector<DriverDescriptor>> groups;
+
+  DriverGroups() = default;
+  DriverGroups(const DriverGroups &other) = delete;
+  DriverGroups &operator=(const DriverGroups &other) = delete;
+
+  /** Only reads the ID, so it can be called for multiple IDs in parallel. */
+  void fill(ID *id);
+};
+
 }  // namespace blender::deg
@@ -20,7 +20,10 @@
 
 namespace blender::deg {
 
-DepsgraphDebug::DepsgraphDebug() : flags(G.debug), graph_evaluation_start_time_(0) {}
+DepsgraphDebug::DepsgraphDebug()
+    : flags(G.debug), do_operation_profile(false), graph_evaluation_start_time_(0)
+{
+}
 
 bool DepsgraphDebug::do_time_debug() const
 {
@@ -32,6 +32,11 @@ class DepsgraphDebug {
    * created for different view layer). */
   string name;
 
+  /* Record the evaluation of every operation, see #DEG_debug_operation_profile_enable. */
+  bool do_operation_profile;
+  /* Operations evaluated during the last evaluation, when #do_operation_profile is enabled. */
+  Vector<DEGOperationProfileEntry> operation_profile;
+
  protected:
   /* Maximum number of counters used to calculate frame rate of depsgraph update. */
   static const constexpr int MAX_FPS_COUNTERS = 64;
@@ -0,0 +1,126 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Per operation evaluation profile, and its export to the Chrome trace event format.
+ */
+
+#include <cstdio>
+
+#include "DEG_depsgraph_debug.hh"
+
+#include "BLI_fileops.h"
+#include "BLI_set.hh"
+#include "BLI_string.h"
+#include "BLI_utildefines.h"
+
+#include "intern/depsgraph.hh"
+
+namespace deg = blender::deg;
+
+namespace blender::deg {
+namespace {
+
+void json_string_append(string &json, const StringRef str)
+{
+  json += '"';
+  for (const char c : str) {
+    if (ELEM(c, '"', '\\')) {
+      json += '\\';
+      json += c;
+    }
+    else if (uchar(c) < 0x20) {
+      char escaped[8];
+      SNPRINTF(escaped, "\\u%04x", int(c));
+      json += escaped;
+    }
+    else {
+      json += c;
+    }
+  }
+  json += '"';
+}
+
+string operation_profile_trace_json(const Depsgraph &graph)
+{
+  const Span<DEGOperationProfileEntry> profile = graph.debug.operation_profile;
+
+  string json = "{\"traceEvents\":[\n";
+  char buf[256];
+
+  /* Name the process after the graph, and give every thread a name so that they are sorted. */
+  json += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":";
+  json_string_append(json, graph.debug.name.empty() ? "Depsgraph" : graph.debug.name);
+  json += "}}";
+  Set<int> thread_indices;
+  for (const DEGOperationProfileEntry &entry : profile) {
+    if (thread_indices.add(entry.thread_index)) {
+      SNPRINTF(buf,
+               ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+               "\"args\":{\"name\":\"Thread %d\"}}",
+               entry.thread_index,
+               entry.thread_index);
+      json += buf;
+    }
+  }
+
+  for (const DEGOperationProfileEntry &entry : profile) {
+    /* Skip the ID code in the event name, it is available in the arguments. */
+    json += ",\n{\"name\":";
+    json_string_append(json, StringRef(entry.id_name).drop_prefix(2) + " " + entry.operation_name);
+    SNPRINTF(buf,
+             ",\"cat\":\"depsgraph\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,",
+             entry.thread_index,
+             entry.start_time * 1e6,
+             entry.duration * 1e6);
+    json += buf;
+    json += "\"args\":{\"id\":";
+    json_string_append(json, entry.id_name);
+    json += ",\"component\":";
+    json_string_append(json, entry.component_name);
+    json += ",\"operation\":";
+    json_string_append(json, entry.operation_name);
+    json += "}}";
+  }
+  json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return json;
+}
+
+}  // namespace
+}  // namespace blender::deg
+
+void DEG_debug_operation_profile_enable(Depsgraph *graph, const bool enable)
+{
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
+  deg_graph->debug.do_operation_profile = enable;
+  if (!enable) {
+    deg_graph->debug.operation_profile.clear_and_shrink();
+  }
+}
+
+bool DEG_debug_operation_profile_is_enabled(const Depsgraph *graph)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
+  return deg_graph->debug.do_operation_profile;
+}
+
+blender::Span<DEGOperationProfileEntry> DEG_debug_operation_profile_get(const Depsgraph *graph)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
+  return deg_graph->debug.operation_profile;
+}
+
+bool DEG_debug_operation_profile_write_trace(const Depsgraph *graph, const char *filepath)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
+  const std::string json = deg::operation_profile_trace_json(*deg_graph);
+  FILE *file = BLI_fopen(filepath, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  const bool success = fwrite(json.data(), 1, json.size(), file) == json.size();
+  return (fclose(file) == 0) && success;
+}
@@ -82,7 +82,7 @@ struct Depsgraph {
 
   /* <ID : IDNode> mapping from ID blocks to nodes representing these
    * blocks, used for quick lookups. */
-  Map<const ID *, IDNode *> id_hash;
+  NodeLookupMap<const ID *, IDNode *> id_hash;
 
   /* Ordered list of ID nodes, order matches ID allocation order.
    * Used for faster iteration, especially for areas which are critical to
@@ -0,0 +1,115 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "BLI_index_range.hh"
+#include "BLI_listbase.h"
+#include "BLI_task.hh"
+
+#include "DNA_modifier_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_frame_parallel.hh"
+
+#include "intern/depsgraph.hh"
+#include "intern/node/deg_node_id.hh"
+
+namespace deg = blender::deg;
+
+namespace blender::deg {
+
+static bool object_has_simulation(const Object *object)
+{
+  LISTBASE_FOREACH (const ModifierData *, md, &object->modifiers) {
+    if (md->type == eModifierType_Nodes) {
+      /* Simulation zones and bake nodes have a bake, their state is stored in the original
+       * modifier and depends on the previous frames. */
+      if (reinterpret_cast<const NodesModifierData *>(md)->bakes_num > 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static bool id_node_supports_frame_parallel_evaluation(const IDNode &id_node)
+{
+  /* Point caches are used by all simulations which step from the previous frame: particles,
+   * cloth, soft bodies, dynamic paint and fluids. */
+  if (id_node.find_component(NodeType::POINT_CACHE) != nullptr) {
+    return false;
+  }
+  switch (id_node.id_type) {
+    case ID_SCE:
+      return reinterpret_cast<const Scene *>(id_node.id_orig)->rigidbody_world == nullptr;
+    case ID_OB:
+      return !object_has_simulation(reinterpret_cast<const Object *>(id_node.id_orig));
+    case ID_MB:
+      /* Meta-ball evaluation iterates over the scene bases with a static iterator. */
+      return false;
+    default:
+      return true;
+  }
+}
+
+}  // namespace blender::deg
+
+bool DEG_frame_parallel_evaluation_supported(const Depsgraph *depsgraph)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
+  for (const deg::IDNode *id_node : deg_graph->id_nodes) {
+    if (!deg::id_node_supports_frame_parallel_evaluation(*id_node)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void DEG_evaluate_frames_parallel(
+    const blender::Span<Depsgraph *> graphs,
+    const blender::Span<float> frames,
+    const blender::FunctionRef<bool(Depsgraph *depsgraph, float frame)> consume)
+{
+  using namespace blender;
+  BLI_assert(!graphs.is_empty());
+
+  bool use_parallel = graphs.size() > 1;
+  for (const Depsgraph *graph : graphs) {
+    BLI_assert(!DEG_is_active(graph));
+    if (use_parallel && !DEG_frame_parallel_evaluation_supported(graph)) {
+      use_parallel = false;
+    }
+  }
+  if (!use_parallel) {
+    for (const float frame : frames) {
+      DEG_evaluate_on_framechange(graphs.first(), frame);
+      if (!consume(graphs.first(), frame)) {
+        return;
+      }
+    }
+    return;
+  }
+
+  for (int64_t batch_start = 0; batch_start < frames.size(); batch_start += graphs.size()) {
+    const IndexRange batch = frames.index_range().drop_front(batch_start).take_front(
+        graphs.size());
+    /* Every frame evaluation is parallel on its own already, so use the smallest grain size to
+     * have all frames of the batch started as soon as there are threads available. */
+    threading::parallel_for(batch.index_range(), 1, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        DEG_evaluate_on_framechange(graphs[i], frames[batch[i]]);
+      }
+    });
+    for (const int64_t i : batch.index_range()) {
+      if (!consume(graphs[i], frames[batch[i]])) {
+        return;
+      }
+    }
+  }
+}
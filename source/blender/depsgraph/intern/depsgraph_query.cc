@@ -365,6 +365,18 @@ bool DEG_id_is_fully_evaluated(const Depsgraph *depsgraph, const ID *id_eval)
   return true;
 }
 
+uint64_t DEG_id_tag_stamp_get(const Depsgraph *depsgraph, const ID *id)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
+  /* Only use the original ID pointer to look up the IDNode, do not dereference it. */
+  const ID *id_orig = deg::get_original_id(id);
+  const deg::IDNode *id_node = deg_graph->find_id_node(id_orig);
+  if (!id_node) {
+    return 0;
+  }
+  return id_node->tag_stamp;
+}
+
 static bool operation_needs_update(const ID &id,
                                    const deg::NodeType component_type,
                                    const deg::OperationCode opcode)
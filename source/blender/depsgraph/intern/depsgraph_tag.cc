@@ -18,6 +18,7 @@
 #include "BLI_math_bits.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "DNA_anim_types.h"
 #include "DNA_curve_types.h"
@@ -270,6 +271,24 @@ void depsgraph_id_tag_copy_on_write(Depsgraph *graph, IDNode *id_node, eUpdateSo
   cow_comp->tag_update(graph, update_source);
 }
 
+/* Check whether the evaluated copy of the ID can still be updated by only copying parameters from
+ * the original, which is the case when it is not yet tagged for update for any other reason. */
+bool cow_update_can_be_parameters_only(const IDNode &id_node)
+{
+  if (id_node.is_cow_parameters_only_tagged) {
+    return true;
+  }
+  if (id_node.is_cow_explicitly_tagged) {
+    return false;
+  }
+  const ComponentNode *cow_comp = id_node.find_component(NodeType::COPY_ON_EVAL);
+  if (cow_comp == nullptr) {
+    return false;
+  }
+  const OperationNode *cow_node = cow_comp->find_operation(OperationCode::COPY_ON_EVAL);
+  return cow_node != nullptr && (cow_node->flag & DEPSOP_FLAG_NEEDS_UPDATE) == 0;
+}
+
 void depsgraph_tag_component(Depsgraph *graph,
                              IDNode *id_node,
                              NodeType component_type,
@@ -723,6 +742,8 @@ void graph_id_tag_update(
    * Allows to have more granularity than a node-factory based flags. */
   if (id_node != nullptr) {
     id_node->id_cow->recalc |= flags;
+    id_node->is_cow_parameters_only_tagged = false;
+    id_node->tag_stamp = IDNode::new_tag_stamp();
   }
   /* When ID is tagged for update based on an user edits store the recalc flags in the original ID.
    * This way IDs in the undo steps will have this flag preserved, making it possible to restore
@@ -845,6 +866,28 @@ void DEG_id_tag_update_ex(Main *bmain, ID *id, uint flags)
   deg::id_tag_update(bmain, id, flags, deg::DEG_UPDATE_SOURCE_USER_EDIT);
 }
 
+void DEG_id_tag_update_parameters_only(Main *bmain, ID *id, uint flags)
+{
+  if (id == nullptr) {
+    return;
+  }
+  blender::Vector<deg::IDNode *> parameters_only_id_nodes;
+  for (deg::Depsgraph *depsgraph : deg::get_all_registered_graphs(bmain)) {
+    if (depsgraph->is_evaluating) {
+      continue;
+    }
+    deg::IDNode *id_node = depsgraph->find_id_node(id);
+    if (id_node != nullptr && deg::cow_update_can_be_parameters_only(*id_node)) {
+      parameters_only_id_nodes.append(id_node);
+    }
+  }
+  deg::id_tag_update(bmain, id, flags | ID_RECALC_PARAMETERS, deg::DEG_UPDATE_SOURCE_USER_EDIT);
+  /* Tagging resets the state, restore it for the graphs in which no other change is pending. */
+  for (deg::IDNode *id_node : parameters_only_id_nodes) {
+    id_node->is_cow_parameters_only_tagged = true;
+  }
+}
+
 void DEG_id_tag_update_for_side_effect_request(Depsgraph *depsgraph, ID *id, uint flags)
 {
   BLI_assert(depsgraph != nullptr);
@@ -964,6 +1007,7 @@ void DEG_ids_clear_recalc(Depsgraph *depsgraph, const bool backup)
      * the recalc flag. */
     id_node->is_user_modified = false;
     id_node->is_cow_explicitly_tagged = false;
+    id_node->is_cow_parameters_only_tagged = false;
     deg_graph_clear_id_recalc_flags(id_node->id_cow);
     if (deg_graph->is_active) {
       deg_graph_clear_id_recalc_flags(id_node->id_orig);
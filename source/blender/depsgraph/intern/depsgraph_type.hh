@@ -48,6 +48,16 @@ using std::make_pair;
 using std::max;
 using std::to_string;
 
+/**
+ * Map used to look up nodes by their key. Lookups are very frequent while the graph is built and
+ * many keys contain names, so group probing is used to skip most of the key comparisons.
+ */
+template<typename Key, typename Value>
+using NodeLookupMap = Map<Key,
+                          Value,
+                          default_inline_buffer_capacity(sizeof(Key) + sizeof(Value)),
+                          GroupProbingStrategy>;
+
 /* Function bindings. */
 using std::function;
 using namespace std::placeholders;
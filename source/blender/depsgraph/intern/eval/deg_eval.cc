@@ -10,10 +10,17 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <algorithm>
+#include <mutex>
+#include <queue>
+#include <utility>
+#include <vector>
+
 #include "BLI_compiler_attrs.h"
 #include "BLI_function_ref.hh"
 #include "BLI_gsqueue.h"
 #include "BLI_task.h"
+#include "BLI_task_trace.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
 
@@ -77,14 +84,35 @@ enum class EvaluationStage {
   SINGLE_THREADED_WORKAROUND,
 };
 
+struct CriticalPathLess {
+  bool operator()(const OperationNode *a, const OperationNode *b) const
+  {
+    return a->critical_path_time < b->critical_path_time;
+  }
+};
+
 struct DepsgraphEvalState {
   Depsgraph *graph;
   bool do_stats;
+  bool do_operation_profile;
   EvaluationStage stage;
   bool need_update_pending_parents = true;
   bool need_single_thread_pass = false;
+
+  /* Operations which are ready to be evaluated by the task pool. Every task pushed to the pool
+   * evaluates the operation with the longest critical path at the time it starts, so that long
+   * chains of operations are not delayed by cheap operations that happened to be ready first. */
+  std::priority_queue<OperationNode *, std::vector<OperationNode *>, CriticalPathLess>
+      ready_operations;
+  std::mutex ready_operations_mutex;
 };
 
+/* Weight of the latest evaluation time of an operation in its estimate. */
+constexpr float eval_time_estimate_factor = 0.2f;
+/* Cost which is added to every operation, accounting for the scheduling overhead and giving
+ * operations which were never evaluated a non-zero estimate. */
+constexpr float eval_time_overhead = 1e-6f;
+
 void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
 {
   ::Depsgraph *depsgraph = reinterpret_cast<::Depsgraph *>(state->graph);
@@ -92,13 +120,24 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
   /* Perform operation. */
+  const double start_time = BLI_time_now_seconds();
+  operation_node->evaluate(depsgraph);
+  const double time = BLI_time_now_seconds() - start_time;
   if (state->do_stats) {
-    const double start_time = BLI_time_now_seconds();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += BLI_time_now_seconds() - start_time;
+    operation_node->stats.current_time += time;
+  }
+  if (state->do_operation_profile) {
+    operation_node->profile_start_time = start_time;
+    operation_node->profile_duration = time;
+    operation_node->profile_thread_index = BLI_task_parallel_thread_id(nullptr);
+  }
+  /* Only accessed by the thread evaluating the operation, until the next update is scheduled. */
+  if (operation_node->eval_time_estimate == 0.0f) {
+    operation_node->eval_time_estimate = float(time);
   }
   else {
-    operation_node->evaluate(depsgraph);
+    operation_node->eval_time_estimate += (float(time) - operation_node->eval_time_estimate) *
+                                          eval_time_estimate_factor;
   }
 
   /* Clear the flag early on, allowing partial updates without re-evaluating the same node multiple
@@ -108,19 +147,51 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   operation_node->flag &= ~DEPSOP_FLAG_CLEAR_ON_EVAL;
 }
 
-void deg_task_run_func(TaskPool *pool, void *taskdata)
+void push_ready_operation(DepsgraphEvalState *state, TaskPool *pool, OperationNode *node)
+{
+  {
+    std::lock_guard lock(state->ready_operations_mutex);
+    state->ready_operations.push(node);
+  }
+  /* The task evaluates whichever ready operation is the most critical when it runs. There is a
+   * task for every operation in the queue, so it is never empty when a task starts. */
+  BLI_task_pool_push(pool, deg_task_run_func, nullptr, false, nullptr);
+}
+
+void deg_task_run_func(TaskPool *pool, void * /*taskdata*/)
 {
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
-  OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  OperationNode *operation_node;
+  {
+    std::lock_guard lock(state->ready_operations_mutex);
+    BLI_assert(!state->ready_operations.empty());
+    operation_node = state->ready_operations.top();
+    state->ready_operations.pop();
+  }
+
+  /* Continue with one of the children that became ready in the same task, and only push the
+   * others to the pool. Long chains of cheap operations are common (e.g. the operations of every
+   * bone of a rig, following the bone hierarchy), and going through the queue and the task pool
+   * for each of them costs more than their evaluation. The child with the longest critical path
+   * is kept, the same one the queue would prefer. */
+  while (operation_node != nullptr) {
+    evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, [&](OperationNode *node) {
-    BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
-  });
+    OperationNode *next_node = nullptr;
+    schedule_children(state, operation_node, [&](OperationNode *node) {
+      if (next_node == nullptr) {
+        next_node = node;
+        return;
+      }
+      if (node->critical_path_time > next_node->critical_path_time) {
+        std::swap(node, next_node);
+      }
+      push_ready_operation(state, pool, node);
+    });
+    operation_node = next_node;
+  }
 }
 
 bool check_operation_node_visible(const DepsgraphEvalState *state, OperationNode *op_node)
@@ -186,6 +257,68 @@ void calculate_pending_parents_if_needed(DepsgraphEvalState *state)
   state->need_update_pending_parents = false;
 }
 
+bool is_critical_path_relation(const Relation *rel)
+{
+  if (rel->from->type != NodeType::OPERATION || rel->to->type != NodeType::OPERATION) {
+    return false;
+  }
+  if (rel->flag & RELATION_FLAG_CYCLIC) {
+    return false;
+  }
+  const OperationNode *from = static_cast<const OperationNode *>(rel->from);
+  const OperationNode *to = static_cast<const OperationNode *>(rel->to);
+  return (from->flag & DEPSOP_FLAG_NEEDS_UPDATE) && (to->flag & DEPSOP_FLAG_NEEDS_UPDATE);
+}
+
+float operation_time_estimate(const OperationNode *node)
+{
+  if (node->is_noop()) {
+    return 0.0f;
+  }
+  return node->eval_time_estimate + eval_time_overhead;
+}
+
+/* Calculate the critical path time of all operations which are tagged for update, using the
+ * estimates from the previous evaluations. The graph without the cyclic relations is acyclic, so
+ * the operations are visited in reverse topological order: every operation is handled after all
+ * operations depending on it. */
+void calculate_critical_path_times(Depsgraph *graph)
+{
+  Vector<OperationNode *> queue;
+  for (OperationNode *node : graph->operations) {
+    node->custom_flags = 0;
+    if ((node->flag & DEPSOP_FLAG_NEEDS_UPDATE) == 0) {
+      node->critical_path_time = 0.0f;
+      continue;
+    }
+    node->critical_path_time = operation_time_estimate(node);
+    for (const Relation *rel : node->outlinks) {
+      if (is_critical_path_relation(rel)) {
+        /* Use the custom flags as the number of dependent operations that are not handled yet. */
+        node->custom_flags++;
+      }
+    }
+    if (node->custom_flags == 0) {
+      queue.append(node);
+    }
+  }
+
+  while (!queue.is_empty()) {
+    const OperationNode *node = queue.pop_last();
+    for (const Relation *rel : node->inlinks) {
+      if (!is_critical_path_relation(rel)) {
+        continue;
+      }
+      OperationNode *from = static_cast<OperationNode *>(rel->from);
+      from->critical_path_time = std::max(from->critical_path_time,
+                                          operation_time_estimate(from) + node->critical_path_time);
+      if (--from->custom_flags == 0) {
+        queue.append(from);
+      }
+    }
+  }
+}
+
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
   /* Clear tags and other things which needs to be clear. */
@@ -194,6 +327,12 @@ void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
       node->stats.reset_current();
     }
   }
+  if (state->do_operation_profile) {
+    for (OperationNode *node : graph->operations) {
+      node->profile_start_time = -1.0;
+    }
+  }
+  calculate_critical_path_times(graph);
 }
 
 bool is_metaball_object_operation(const OperationNode *operation_node)
@@ -317,9 +456,8 @@ void evaluate_graph_threaded_stage(DepsgraphEvalState *state,
 
   calculate_pending_parents_if_needed(state);
 
-  schedule_graph(state, [&](OperationNode *node) {
-    BLI_task_pool_push(task_pool, deg_task_run_func, node, false, nullptr);
-  });
+  schedule_graph(state,
+                 [&](OperationNode *node) { push_ready_operation(state, task_pool, node); });
   BLI_task_pool_work_and_wait(task_pool);
 }
 
@@ -398,10 +536,15 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   graph->is_evaluating = true;
   depsgraph_ensure_view_layer(graph);
 
+  threading::trace::ScopedLabel trace_label("Depsgraph Evaluation");
+
+  const double evaluation_start_time = BLI_time_now_seconds();
+
   /* Set up evaluation state. */
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
+  state.do_operation_profile = graph->debug.do_operation_profile;
 
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
@@ -456,6 +599,9 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  if (state.do_operation_profile) {
+    deg_eval_operation_profile_gather(graph, evaluation_start_time);
+  }
 
   /* Clear any uncleared tags. */
   deg_graph_clear_tags(graph);
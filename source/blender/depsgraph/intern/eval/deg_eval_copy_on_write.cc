@@ -74,7 +74,9 @@
 #include "BKE_animsys.h"
 #include "BKE_armature.hh"
 #include "BKE_editmesh.hh"
+#include "BKE_key.hh"
 #include "BKE_lib_query.hh"
+#include "BKE_mesh.h"
 #include "BKE_modifier.hh"
 #include "BKE_object.hh"
 #include "BKE_pointcache.h"
@@ -745,6 +747,54 @@ void update_id_after_copy(const Depsgraph *depsgraph,
   BKE_animsys_update_driver_array(id_cow);
 }
 
+/* Replace ID properties of the evaluated copy with the ones of the original, remapping ID pointers
+ * to their evaluated copies. */
+void update_id_properties_from_orig(const Depsgraph *depsgraph, const ID *id_orig, ID *id_cow)
+{
+  if (id_cow->properties != nullptr) {
+    IDP_FreeProperty_ex(id_cow->properties, false);
+    id_cow->properties = nullptr;
+  }
+  if (id_orig->properties == nullptr) {
+    return;
+  }
+  id_cow->properties = IDP_CopyProperty_ex(id_orig->properties, LIB_ID_CREATE_NO_USER_REFCOUNT);
+  IDP_foreach_property(id_cow->properties, IDP_TYPE_FILTER_ID, [&](IDProperty *id_property) {
+    ID *id = IDP_Id(id_property);
+    if (id != nullptr && deg_eval_copy_is_needed(id)) {
+      ID *id_property_cow = depsgraph->get_cow_id(id);
+      BLI_assert(id_property_cow != nullptr);
+      id_property->data.pointer = id_property_cow;
+    }
+  });
+}
+
+/* Update the evaluated copy when only parameters stored in the original ID itself changed, see
+ * #DEG_id_tag_update_parameters_only. Data owned by the ID (mesh attributes, shape key positions)
+ * is kept as-is, so is the runtime data of the evaluated copy.
+ *
+ * Returns false if this is not supported for the ID, in which case a full copy is needed. */
+bool update_parameters_from_orig(const Depsgraph *depsgraph, const ID *id_orig, ID *id_cow)
+{
+  switch (GS(id_orig->name)) {
+    case ID_ME:
+      BKE_mesh_copy_parameters(reinterpret_cast<Mesh *>(id_cow),
+                               reinterpret_cast<const Mesh *>(id_orig));
+      break;
+    case ID_KE:
+      if (!BKE_key_copy_settings_for_eval(reinterpret_cast<Key *>(id_cow),
+                                          reinterpret_cast<const Key *>(id_orig)))
+      {
+        return false;
+      }
+      break;
+    default:
+      return false;
+  }
+  update_id_properties_from_orig(depsgraph, id_orig, id_cow);
+  return true;
+}
+
 /* This callback is used to validate that all nested ID data-blocks are
  * properly expanded. */
 int foreach_libblock_validate_callback(LibraryIDLinkCallbackData *cb_data)
@@ -896,6 +946,13 @@ ID *deg_update_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_
       BKE_gpencil_update_on_write((bGPdata *)id_orig, (bGPdata *)id_cow);
       return id_cow;
     }
+    /* Only parameters of the original changed, patch them in the evaluated copy instead of copying
+     * all the data owned by the ID again. */
+    if (id_node->is_cow_parameters_only_tagged &&
+        update_parameters_from_orig(depsgraph, id_orig, id_cow))
+    {
+      return id_cow;
+    }
   }
 
   RuntimeBackup backup(depsgraph);
@@ -8,8 +8,12 @@
 
 #include "intern/eval/deg_eval_stats.h"
 
+#include <algorithm>
+
 #include "BLI_utildefines.h"
 
+#include "DNA_ID.h"
+
 #include "intern/depsgraph.hh"
 
 #include "intern/node/deg_node.hh"
@@ -39,4 +43,29 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+void deg_eval_operation_profile_gather(Depsgraph *graph, const double evaluation_start_time)
+{
+  Vector<DEGOperationProfileEntry> &profile = graph->debug.operation_profile;
+  profile.clear();
+  for (const OperationNode *op_node : graph->operations) {
+    if (op_node->profile_start_time < 0.0) {
+      continue;
+    }
+    const ComponentNode *comp_node = op_node->owner;
+    DEGOperationProfileEntry entry;
+    entry.id_name = comp_node->owner->id_orig->name;
+    entry.component_name = comp_node->identifier();
+    entry.operation_name = op_node->identifier();
+    entry.thread_index = op_node->profile_thread_index;
+    entry.start_time = op_node->profile_start_time - evaluation_start_time;
+    entry.duration = op_node->profile_duration;
+    profile.append(std::move(entry));
+  }
+  std::sort(profile.begin(),
+            profile.end(),
+            [](const DEGOperationProfileEntry &a, const DEGOperationProfileEntry &b) {
+              return a.start_time < b.start_time;
+            });
+}
+
 }  // namespace blender::deg
@@ -15,4 +15,8 @@ struct Depsgraph;
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Gather the evaluated operations into the operation profile of the graph.
+ * The start times are stored relative to the given evaluation start time. */
+void deg_eval_operation_profile_gather(Depsgraph *graph, double evaluation_start_time);
+
 }  // namespace blender::deg
@@ -73,7 +73,7 @@ ComponentNode::ComponentNode()
       possibly_affects_visible_id(false),
       affects_visible_id(false)
 {
-  operations_map = new Map<ComponentNode::OperationIDKey, OperationNode *>();
+  operations_map = new NodeLookupMap<ComponentNode::OperationIDKey, OperationNode *>();
 }
 
 void ComponentNode::init(const ID * /*id*/, const char * /*subdata*/)
@@ -116,7 +116,7 @@ struct ComponentNode : public Node {
 
   /* Operations stored as a hash map, for faster build.
    * This hash map will be freed when graph is fully built. */
-  Map<ComponentNode::OperationIDKey, OperationNode *> *operations_map;
+  NodeLookupMap<ComponentNode::OperationIDKey, OperationNode *> *operations_map;
 
   /* This is a "normal" list of operations, used by evaluation
    * and other routines after construction. */
@@ -8,6 +8,7 @@
 
 #include "intern/node/deg_node_id.hh"
 
+#include <atomic>
 #include <cstdio>
 #include <cstring> /* required for STREQ later on. */
 
@@ -56,6 +57,12 @@ uint64_t IDNode::ComponentIDKey::hash() const
                                     BLI_ghashutil_strhash_p(name));
 }
 
+uint64_t IDNode::new_tag_stamp()
+{
+  static std::atomic<uint64_t> last_tag_stamp = 0;
+  return ++last_tag_stamp;
+}
+
 void IDNode::init(const ID *id, const char * /*subdata*/)
 {
   BLI_assert(id != nullptr);
@@ -73,6 +80,8 @@ void IDNode::init(const ID *id, const char * /*subdata*/)
   is_collection_fully_expanded = false;
   has_base = false;
   is_user_modified = false;
+  is_cow_parameters_only_tagged = false;
+  tag_stamp = new_tag_stamp();
   id_cow_recalc_backup = 0;
 
   visible_components_mask = 0;
@@ -59,6 +59,9 @@ struct IDNode : public Node {
 
   IDComponentsMask get_visible_components_mask() const;
 
+  /* Get a value for #tag_stamp which was never used before. */
+  static uint64_t new_tag_stamp();
+
   /* Type of the ID stored separately, so it's possible to perform check whether evaluated copy is
    * needed without de-referencing the id_cow (which is not safe when ID is NOT covered by
    * copy-on-evaluation and has been deleted from the main database.) */
@@ -78,7 +81,7 @@ struct IDNode : public Node {
   ID *id_cow;
 
   /* Hash to make it faster to look up components. */
-  Map<ComponentIDKey, ComponentNode *> components;
+  NodeLookupMap<ComponentIDKey, ComponentNode *> components;
 
   /* Additional flags needed for scene evaluation.
    * TODO(sergey): Only needed for until really granular updates
@@ -121,6 +124,15 @@ struct IDNode : public Node {
   /* Copy-on-Write component has been explicitly tagged for update. */
   bool is_cow_explicitly_tagged;
 
+  /* Copy-on-Write component has only been tagged for update by changes to the parameters stored
+   * in the original ID itself, see #DEG_id_tag_update_parameters_only. The evaluated copy can
+   * then be updated without copying the data owned by the ID again. */
+  bool is_cow_parameters_only_tagged;
+
+  /* Unique value which changes every time the ID is tagged for update, and which is different for
+   * every new ID node, see #DEG_id_tag_stamp_get. */
+  uint64_t tag_stamp;
+
   /* Accumulate recalc flags from multiple update passes. */
   int id_cow_recalc_backup;
 
@@ -209,7 +209,16 @@ const char *operationCodeAsString(OperationCode opcode)
   return "UNKNOWN";
 }
 
-OperationNode::OperationNode() : name_tag(-1), flag(0) {}
+OperationNode::OperationNode()
+    : eval_time_estimate(0.0f),
+      critical_path_time(0.0f),
+      profile_start_time(-1.0),
+      profile_duration(0.0),
+      profile_thread_index(0),
+      name_tag(-1),
+      flag(0)
+{
+}
 
 string OperationNode::identifier() const
 {
@@ -281,6 +281,19 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Estimated evaluation time in seconds, averaged over the previous evaluations. */
+  float eval_time_estimate;
+  /* Estimated time needed to evaluate this operation and the longest chain of operations which
+   * depend on it in the current update. Operations with the longest remaining chain are
+   * evaluated first. */
+  float critical_path_time;
+
+  /* Evaluation of this operation in the current update, only set when the operation profile is
+   * enabled. The start time is negative when the operation was not evaluated. */
+  double profile_start_time;
+  double profile_duration;
+  int profile_thread_index;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -104,6 +104,12 @@ class HiZBuffer {
 
   void debug_draw(View &view, GPUFrameBuffer *view_fb);
 
+  /** Ratio between the render extent and the size of the HiZ textures. */
+  float2 uv_scale_get() const
+  {
+    return data_.uv_scale;
+  }
+
   /* Back is Previous layer depth (ex: For refraction). Front for current layer depth. */
   struct {
     /** References to the textures in the swap-chain. */
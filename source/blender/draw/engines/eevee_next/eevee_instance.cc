@@ -348,6 +348,18 @@ void Instance::end_sync()
 }
 
 void Instance::render_sync()
+{
+  render_sync_objects();
+
+  if (materials.queued_shaders_count > 0) {
+    /* The materials were compiled in parallel while they were all requested by the first sync,
+     * which used the default materials in their place. Sync again once they are ready. */
+    DRW_render_shader_compilation_wait();
+    render_sync_objects();
+  }
+}
+
+void Instance::render_sync_objects()
 {
   /* TODO: Remove old draw manager calls. */
   DRW_cache_restart();
@@ -328,6 +328,8 @@ class Instance {
                                  Object *ob,
                                  RenderEngine *engine,
                                  Depsgraph *depsgraph);
+  /** Sync all objects of the render, part of #render_sync. */
+  void render_sync_objects();
   void render_sample();
   void render_read_result(RenderLayer *render_layer, const char *view_name);
 
@@ -13,6 +13,8 @@
 #include "BKE_node.hh"
 #include "NOD_shader.h"
 
+#include "GPU_capabilities.hh"
+
 #include "eevee_instance.hh"
 
 #include "eevee_material.hh"
@@ -146,6 +148,10 @@ MaterialModule::~MaterialModule()
   BKE_id_free(nullptr, metallic_mat);
   BKE_id_free(nullptr, diffuse_mat);
   BKE_id_free(nullptr, error_mat_);
+
+  for (MaterialFallback &fallback : fallback_map_.values()) {
+    GPU_material_release(fallback.gpumat);
+  }
 }
 
 void MaterialModule::begin_sync()
@@ -153,10 +159,68 @@ void MaterialModule::begin_sync()
   queued_shaders_count = 0;
   queued_optimize_shaders_count = 0;
 
+  /* Release the fallbacks of materials that are not drawn anymore. */
+  fallback_map_.remove_if([](const auto item) {
+    if (!item.value.is_used) {
+      GPU_material_release(item.value.gpumat);
+      return true;
+    }
+    return false;
+  });
+  for (MaterialFallback &fallback : fallback_map_.values()) {
+    fallback.is_used = false;
+  }
+
   material_map_.clear();
   shader_map_.clear();
 }
 
+void MaterialModule::material_fallback_set(const ::Material *blender_mat, GPUMaterial *gpumat)
+{
+  const std::pair key(blender_mat, GPU_material_uuid_get(gpumat));
+  MaterialFallback &fallback = fallback_map_.lookup_or_add_cb(key, [&]() {
+    GPU_material_acquire(gpumat);
+    return MaterialFallback{gpumat, true};
+  });
+  if (fallback.gpumat != gpumat) {
+    GPU_material_release(fallback.gpumat);
+    GPU_material_acquire(gpumat);
+    fallback.gpumat = gpumat;
+  }
+  fallback.is_used = true;
+}
+
+GPUMaterial *MaterialModule::material_fallback_get(const ::Material *blender_mat,
+                                                   GPUMaterial *gpumat)
+{
+  const std::pair key(blender_mat, GPU_material_uuid_get(gpumat));
+  MaterialFallback *fallback = fallback_map_.lookup_ptr(key);
+  if (fallback == nullptr) {
+    return nullptr;
+  }
+  fallback->is_used = true;
+  /* The previous version can reference images which were removed from the node-tree since, and
+   * which might be freed. Only use it if all its images are still used by the new version. */
+  ListBase textures = GPU_material_textures(gpumat);
+  ListBase fallback_textures = GPU_material_textures(fallback->gpumat);
+  LISTBASE_FOREACH (GPUMaterialTexture *, fallback_tex, &fallback_textures) {
+    if (fallback_tex->ima == nullptr) {
+      continue;
+    }
+    bool found = false;
+    LISTBASE_FOREACH (GPUMaterialTexture *, tex, &textures) {
+      if (tex->ima == fallback_tex->ima) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      return nullptr;
+    }
+  }
+  return fallback->gpumat;
+}
+
 MaterialPass MaterialModule::material_pass_get(Object *ob,
                                                ::Material *blender_mat,
                                                eMaterialPipeline pipeline_type,
@@ -168,10 +232,18 @@ MaterialPass MaterialModule::material_pass_get(Object *ob,
                          default_surface_ntree_.nodetree_get(blender_mat);
 
   bool use_deferred_compilation = inst_.is_viewport();
+  /* Final renders request all the materials of the scene before waiting for them, so they are
+   * compiled in parallel instead of one after another. See #Instance::render_sync. */
+  bool use_parallel_render_compilation = inst_.is_image_render() &&
+                                         GPU_use_parallel_compilation();
 
   MaterialPass matpass = MaterialPass();
   matpass.gpumat = inst_.shaders.material_shader_get(
-      blender_mat, ntree, pipeline_type, geometry_type, use_deferred_compilation);
+      blender_mat,
+      ntree,
+      pipeline_type,
+      geometry_type,
+      use_deferred_compilation || use_parallel_render_compilation);
 
   const bool is_volume = ELEM(pipeline_type, MAT_PIPE_VOLUME_OCCUPANCY, MAT_PIPE_VOLUME_MATERIAL);
   const bool is_forward = ELEM(pipeline_type,
@@ -187,12 +259,22 @@ MaterialPass MaterialModule::material_pass_get(Object *ob,
       if (optimization_status == GPU_MAT_OPTIMIZATION_QUEUED) {
         queued_optimize_shaders_count++;
       }
+      if (use_deferred_compilation) {
+        material_fallback_set(blender_mat, matpass.gpumat);
+      }
       break;
     }
-    case GPU_MAT_QUEUED:
+    case GPU_MAT_QUEUED: {
       queued_shaders_count++;
-      matpass.gpumat = inst_.shaders.material_default_shader_get(pipeline_type, geometry_type);
+      /* Keep drawing the previous version of the material while the new one compiles. */
+      if (GPUMaterial *fallback = material_fallback_get(blender_mat, matpass.gpumat)) {
+        matpass.gpumat = fallback;
+      }
+      else {
+        matpass.gpumat = inst_.shaders.material_default_shader_get(pipeline_type, geometry_type);
+      }
       break;
+    }
     case GPU_MAT_FAILED:
     default:
       matpass.gpumat = inst_.shaders.material_shader_get(
@@ -357,6 +357,18 @@ class MaterialModule {
   Map<MaterialKey, Material> material_map_;
   Map<ShaderKey, PassMain::Sub *> shader_map_;
 
+  struct MaterialFallback {
+    GPUMaterial *gpumat;
+    /** Was used by the current sync. Unused fallbacks are released on the next one. */
+    bool is_used;
+  };
+  /**
+   * Last successfully compiled #GPUMaterial of each material and shader UUID. Used instead of the
+   * default material while an updated version of the material compiles in the viewport.
+   * The stored materials are acquired.
+   */
+  Map<std::pair<const ::Material *, uint64_t>, MaterialFallback> fallback_map_;
+
   MaterialArray material_array_;
 
   DefaultSurfaceNodeTree default_surface_ntree_;
@@ -392,6 +404,14 @@ class MaterialModule {
                                  eMaterialPipeline pipeline_type,
                                  eMaterialGeometry geometry_type,
                                  eMaterialProbe probe_capture = MAT_PROBE_NONE);
+
+  /** Store \a gpumat as the fallback to use for next versions of \a blender_mat. */
+  void material_fallback_set(const ::Material *blender_mat, GPUMaterial *gpumat);
+  /**
+   * Return a previous version of \a blender_mat which can be drawn while \a gpumat compiles, or
+   * nullptr if there is none.
+   */
+  GPUMaterial *material_fallback_get(const ::Material *blender_mat, GPUMaterial *gpumat);
 };
 
 /** \} */
@@ -812,7 +812,11 @@ GPUTexture *DeferredLayer::render(View &main_view,
   inst_.shadows.set_view(render_view, extent);
 
   inst_.gbuffer.bind(gbuffer_fb);
+  /* Every surface of the G-buffer pass is in the prepass. Skip the ones that are completely
+   * behind the prepass depth, they would not pass the depth test anyway. */
+  render_view.occlusion_test_set(inst_.hiz_buffer.front.ref_tx_, inst_.hiz_buffer.uv_scale_get());
   inst_.manager->submit(gbuffer_ps_, render_view);
+  render_view.occlusion_test_set(nullptr);
 
   for (int i = 0; i < ARRAY_SIZE(direct_radiance_txs_); i++) {
     direct_radiance_txs_[i].acquire(
@@ -197,8 +197,17 @@ void RayTraceModule::sync()
     GPUShader *sh = inst_.shaders.static_shader_get(RAY_DENOISE_TEMPORAL);
     pass.init();
     pass.specialize_constant(sh, "closure_index", &data_.closure_index);
+    /* In the viewport, the previous camera of the velocity module is the one of the previous
+     * redraw, which is also where the history comes from. For final renders it is the previous
+     * motion blur step. */
+    pass.specialize_constant(sh, "use_velocity_reprojection", inst_.is_viewport());
     pass.shader_set(sh);
     pass.bind_resources(inst_.uniform_data);
+    pass.bind_ubo("camera_prev", &(*inst_.velocity.camera_steps[STEP_PREVIOUS]));
+    pass.bind_ubo("camera_curr", &(*inst_.velocity.camera_steps[STEP_CURRENT]));
+    /* Only the previous motion is used. Still bind a valid step to avoid undefined behavior. */
+    pass.bind_ubo("camera_next", &(*inst_.velocity.camera_steps[STEP_PREVIOUS]));
+    pass.bind_texture("vector_tx", &inst_.render_buffers.vector_tx);
     pass.bind_texture("radiance_history_tx", &radiance_history_tx_);
     pass.bind_texture("variance_history_tx", &variance_history_tx_);
     pass.bind_texture("tilemask_history_tx", &tilemask_history_tx_);
@@ -746,8 +746,18 @@ void ShadowModule::sync_object(const Object *ob,
   shadow_ob.used = true;
   const bool is_initialized = shadow_ob.resource_handle.raw != 0;
   const bool has_jittered_transparency = has_transparent_shadows && data_.use_jitter;
-  if (is_shadow_caster && (handle.recalc || !is_initialized || has_jittered_transparency)) {
-    if (handle.recalc && is_initialized) {
+  bool is_updated = handle.recalc != 0;
+  if (is_initialized && handle.recalc == ID_RECALC_TRANSFORM &&
+      shadow_ob.object_to_world == ob->object_to_world())
+  {
+    /* Animated objects are tagged on every frame change, even when their animation holds the
+     * same transform. Keep their cached pages, which matters during playback when most of the
+     * casters are static. */
+    is_updated = false;
+  }
+  if (is_shadow_caster && (is_updated || !is_initialized || has_jittered_transparency)) {
+    shadow_ob.object_to_world = ob->object_to_world();
+    if (is_updated && is_initialized) {
       past_casters_updated_.append(shadow_ob.resource_handle.raw);
     }
 
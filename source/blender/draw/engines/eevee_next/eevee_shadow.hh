@@ -165,6 +165,8 @@ struct ShadowTileMapPool {
 /* Can be either a shadow caster or a shadow receiver. */
 struct ShadowObject {
   ResourceHandle resource_handle = {0};
+  /** Object matrix at the last update of the shadow pages it is casting onto. */
+  float4x4 object_to_world = float4x4::identity();
   bool used = true;
 };
 
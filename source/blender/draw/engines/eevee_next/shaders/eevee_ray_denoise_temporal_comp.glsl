@@ -20,6 +20,7 @@
 #pragma BLENDER_REQUIRE(gpu_shader_utildefines_lib.glsl)
 #pragma BLENDER_REQUIRE(gpu_shader_math_matrix_lib.glsl)
 #pragma BLENDER_REQUIRE(eevee_colorspace_lib.glsl)
+#pragma BLENDER_REQUIRE(eevee_velocity_lib.glsl)
 
 struct LocalStatistics {
   vec3 mean;
@@ -110,10 +111,13 @@ vec4 radiance_history_fetch(ivec2 texel, float bilinear_weight)
   return vec4(history_radiance * bilinear_weight, bilinear_weight);
 }
 
-vec4 radiance_history_sample(vec3 P, LocalStatistics local)
+vec2 history_uv_from_point(vec3 P)
 {
-  vec2 uv = project_point(uniform_buf.raytrace.history_persmat, P).xy * 0.5 + 0.5;
+  return project_point(uniform_buf.raytrace.history_persmat, P).xy * 0.5 + 0.5;
+}
 
+vec4 radiance_history_sample(vec2 uv, LocalStatistics local)
+{
   /* FIXME(fclem): Find why we need this half pixel offset. */
   vec2 texel_co = uv * vec2(textureSize(radiance_history_tx, 0).xy) - 0.5;
   vec4 bilinear_weights = bilinear_weights_from_subpixel_coord(fract(texel_co));
@@ -138,10 +142,8 @@ vec4 radiance_history_sample(vec3 P, LocalStatistics local)
   return history_radiance_YCoCg * weight;
 }
 
-vec2 variance_history_sample(vec3 P)
+vec2 variance_history_sample(vec2 uv)
 {
-  vec2 uv = project_point(uniform_buf.raytrace.history_persmat, P).xy * 0.5 + 0.5;
-
   if (!in_range_exclusive(uv, vec2(0.0), vec2(1.0))) {
     /* Out of history view. Return sample without weight. */
     return vec2(0.0);
@@ -188,14 +190,23 @@ void main()
   /* Radiance. */
 
   /* Surface reprojection. */
-  /* TODO(fclem): Use per pixel velocity. Is this worth it? */
   float scene_depth = texelFetch(depth_tx, texel_fullres, 0).r;
-  vec3 P = drw_point_screen_to_world(vec3(uv, scene_depth));
-  vec4 history_radiance = radiance_history_sample(P, local);
+  vec2 surface_history_uv;
+  if (use_velocity_reprojection) {
+    /* Follow the surface motion, so that the history of moving objects is found too. */
+    vec4 motion = velocity_resolve(vector_tx, texel_fullres, scene_depth);
+    surface_history_uv = uv + motion.xy;
+  }
+  else {
+    vec3 P = drw_point_screen_to_world(vec3(uv, scene_depth));
+    surface_history_uv = history_uv_from_point(P);
+  }
+  vec4 history_radiance = radiance_history_sample(surface_history_uv, local);
   /* Reflection reprojection. */
   float hit_depth = imageLoadFast(hit_depth_img, texel_fullres).r;
   vec3 P_hit = drw_point_screen_to_world(vec3(uv, hit_depth));
-  history_radiance += radiance_history_sample(P_hit, local);
+  vec2 hit_history_uv = history_uv_from_point(P_hit);
+  history_radiance += radiance_history_sample(hit_history_uv, local);
   /* Finalize accumulation. */
   history_radiance *= safe_rcp(history_radiance.w);
   /* Clamp resulting history radiance (slide 47). */
@@ -214,7 +225,7 @@ void main()
   /* Variance. */
 
   /* Reflection reprojection. */
-  vec2 history_variance = variance_history_sample(P_hit);
+  vec2 history_variance = variance_history_sample(hit_history_uv);
   /* Blend history with new variance. */
   float mix_variance_fac = (history_variance.y == 0.0) ? 0.0 : 0.90;
   float out_variance = mix(in_variance, history_variance.x, mix_variance_fac);
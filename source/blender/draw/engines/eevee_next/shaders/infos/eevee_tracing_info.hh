@@ -144,11 +144,12 @@ GPU_SHADER_CREATE_INFO(eevee_ray_denoise_spatial)
 GPU_SHADER_CREATE_INFO(eevee_ray_denoise_temporal)
     .do_static_compilation(true)
     .local_group_size(RAYTRACE_GROUP_SIZE, RAYTRACE_GROUP_SIZE)
-    .additional_info("eevee_shared", "eevee_global_ubo", "draw_view")
+    .additional_info("eevee_shared", "eevee_global_ubo", "eevee_velocity_camera", "draw_view")
     .sampler(0, ImageType::FLOAT_2D, "radiance_history_tx")
     .sampler(1, ImageType::FLOAT_2D, "variance_history_tx")
     .sampler(2, ImageType::UINT_2D_ARRAY, "tilemask_history_tx")
     .sampler(3, ImageType::DEPTH_2D, "depth_tx")
+    .sampler(4, ImageType::FLOAT_2D, "vector_tx")
     .image(0, GPU_R32F, Qualifier::READ, ImageType::FLOAT_2D, "hit_depth_img")
     .image(1, RAYTRACE_RADIANCE_FORMAT, Qualifier::READ, ImageType::FLOAT_2D, "in_radiance_img")
     .image(2, RAYTRACE_RADIANCE_FORMAT, Qualifier::WRITE, ImageType::FLOAT_2D, "out_radiance_img")
@@ -159,6 +160,7 @@ GPU_SHADER_CREATE_INFO(eevee_ray_denoise_temporal)
     /* Metal: Provide compiler with hint to tune per-thread resource allocation. */
     .mtl_max_total_threads_per_threadgroup(512)
     .specialization_constant(Type::INT, "closure_index", 0)
+    .specialization_constant(Type::BOOL, "use_velocity_reprojection", false)
     .compute_source("eevee_ray_denoise_temporal_comp.glsl");
 
 GPU_SHADER_CREATE_INFO(eevee_ray_denoise_bilateral)
@@ -11,3 +11,7 @@
 #define SELECT_DATA 4
 #define SELECT_ID_IN 5
 #define SELECT_ID_OUT 6
+
+#define SELECT_BITMAP_GROUP_SIZE 16
+#define SELECT_BITMAP_MASK 0
+#define SELECT_BITMAP_OUT 1
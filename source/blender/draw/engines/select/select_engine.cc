@@ -32,6 +32,8 @@ struct SelectEngineData {
   GPUTexture *texture_u32;
 
   SELECTID_Shaders sh_data[GPU_SHADER_CFG_LEN];
+  /** Indexed by the use of a mask. */
+  GPUShader *select_id_bitmap_sh[2];
   SELECTID_Context context;
 };
 
@@ -287,6 +289,9 @@ static void select_engine_free()
     DRW_SHADER_FREE_SAFE(sh_data->select_id_flat);
     DRW_SHADER_FREE_SAFE(sh_data->select_id_uniform);
   }
+  for (GPUShader *&shader : e_data.select_id_bitmap_sh) {
+    DRW_SHADER_FREE_SAFE(shader);
+  }
 
   DRW_TEXTURE_FREE_SAFE(e_data.texture_u32);
   GPU_FRAMEBUFFER_FREE_SAFE(e_data.framebuffer_select_id);
@@ -368,6 +373,17 @@ GPUTexture *DRW_engine_select_texture_get()
   return e_data.texture_u32;
 }
 
+GPUShader *DRW_engine_select_bitmap_shader_get(const bool use_mask)
+{
+  SelectEngineData &e_data = get_engine_data();
+  GPUShader *&shader = e_data.select_id_bitmap_sh[use_mask];
+  if (shader == nullptr) {
+    shader = GPU_shader_create_from_info_name(use_mask ? "select_id_bitmap_masked" :
+                                                         "select_id_bitmap");
+  }
+  return shader;
+}
+
 /** \} */
 
 #undef SELECT_ENGINE
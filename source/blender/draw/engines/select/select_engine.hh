@@ -22,6 +22,8 @@ extern DrawEngineType draw_engine_debug_select_type;
 struct SELECTID_Context *DRW_select_engine_context_get();
 struct GPUFrameBuffer *DRW_engine_select_framebuffer_get();
 struct GPUTexture *DRW_engine_select_texture_get();
+/** Compute shader filling a bitmap of the select IDs inside a region of the select texture. */
+struct GPUShader *DRW_engine_select_bitmap_shader_get(bool use_mask);
 
 /* select_instance.cc */
 
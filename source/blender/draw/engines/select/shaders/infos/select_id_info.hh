@@ -60,6 +60,29 @@ GPU_SHADER_CREATE_INFO(select_id_patch)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Select ID Bitmap
+ * \{ */
+
+GPU_SHADER_CREATE_INFO(select_id_bitmap)
+    .local_group_size(SELECT_BITMAP_GROUP_SIZE, SELECT_BITMAP_GROUP_SIZE)
+    .push_constant(Type::IVEC2, "rect_min")
+    .push_constant(Type::IVEC2, "rect_size")
+    .push_constant(Type::INT, "circle_radius")
+    .push_constant(Type::INT, "bitmap_len")
+    .sampler(0, ImageType::UINT_2D, "select_id_tx")
+    .storage_buf(SELECT_BITMAP_OUT, Qualifier::READ_WRITE, "uint", "out_bitmap_buf[]")
+    .compute_source("select_id_bitmap_comp.glsl")
+    .do_static_compilation(true);
+
+GPU_SHADER_CREATE_INFO(select_id_bitmap_masked)
+    .define("SELECT_MASK")
+    .storage_buf(SELECT_BITMAP_MASK, Qualifier::READ, "uint", "mask_buf[]")
+    .additional_info("select_id_bitmap")
+    .do_static_compilation(true);
+
+/** \} */
+
 GPU_SHADER_CREATE_INFO(select_debug_fullscreen)
     .additional_info("draw_fullscreen")
     .fragment_source("select_debug_frag.glsl")
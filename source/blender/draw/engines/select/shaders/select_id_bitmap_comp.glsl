@@ -0,0 +1,41 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * Fill the bitmap of the select IDs found inside the selection region, so that only the bitmap
+ * needs to be read back instead of every pixel of the region.
+ */
+
+void main()
+{
+  ivec2 local_texel = ivec2(gl_GlobalInvocationID.xy);
+  if (any(greaterThanEqual(local_texel, rect_size))) {
+    return;
+  }
+  ivec2 texel = rect_min + local_texel;
+  if (any(lessThan(texel, ivec2(0))) || any(greaterThanEqual(texel, textureSize(select_id_tx, 0))))
+  {
+    return;
+  }
+
+  if (circle_radius >= 0) {
+    ivec2 offset = local_texel - circle_radius;
+    if (offset.x * offset.x + offset.y * offset.y >= circle_radius * circle_radius) {
+      return;
+    }
+  }
+
+#ifdef SELECT_MASK
+  uint mask_index = uint(local_texel.y * rect_size.x + local_texel.x);
+  if ((mask_buf[mask_index >> 5u] & (1u << (mask_index & 31u))) == 0u) {
+    return;
+  }
+#endif
+
+  /* Intentionally wrap to max value if this is zero. */
+  uint index = texelFetch(select_id_tx, texel, 0).r - 1u;
+  if (index < uint(bitmap_len)) {
+    atomicOr(out_bitmap_buf[index >> 5u], 1u << (index & 31u));
+  }
+}
@@ -70,6 +70,7 @@ class Instance {
   void begin_sync()
   {
     resources.material_buf.clear_and_trim();
+    resources.material_index_map.clear();
 
     opaque_ps.sync(scene_state, resources);
     transparent_ps.sync(scene_state, resources);
@@ -87,6 +88,15 @@ class Instance {
     resources.material_buf.push_update();
   }
 
+  /** Index of \a material in the material buffer, only added once per sync. */
+  int material_index_get(const Material &material)
+  {
+    return resources.material_index_map.lookup_or_add_cb(material, [&]() {
+      resources.material_buf.append(material);
+      return int(resources.material_buf.size() - 1);
+    });
+  }
+
   Material get_material(ObjectRef ob_ref, eV3DShadingColorType color_type, int slot = 0)
   {
     switch (color_type) {
@@ -226,8 +236,7 @@ class Instance {
                  const MaterialTexture *texture = nullptr,
                  bool show_missing_texture = false)
   {
-    resources.material_buf.append(material);
-    int material_index = resources.material_buf.size() - 1;
+    int material_index = material_index_get(material);
 
     if (show_missing_texture && (!texture || !texture->gpu.texture)) {
       texture = &resources.missing_texture;
@@ -345,8 +354,7 @@ class Instance {
     ResourceHandle handle = manager.resource_handle(ob_ref);
 
     Material mat = get_material(ob_ref, object_state.color_type);
-    resources.material_buf.append(mat);
-    int material_index = resources.material_buf.size() - 1;
+    int material_index = material_index_get(mat);
 
     draw_to_mesh_pass(ob_ref, mat.is_transparent(), [&](MeshPass &mesh_pass) {
       PassMain::Sub &pass =
@@ -371,8 +379,7 @@ class Instance {
     if (object_state.color_type == V3D_SHADING_TEXTURE_COLOR) {
       texture = MaterialTexture(ob_ref.object, psys->part->omat - 1);
     }
-    resources.material_buf.append(mat);
-    int material_index = resources.material_buf.size() - 1;
+    int material_index = material_index_get(mat);
 
     draw_to_mesh_pass(ob_ref, mat.is_transparent(), [&](MeshPass &mesh_pass) {
       PassMain::Sub &pass =
@@ -389,8 +396,7 @@ class Instance {
     ResourceHandle handle = manager.resource_handle(ob_ref.object->object_to_world());
 
     Material mat = get_material(ob_ref, object_state.color_type);
-    resources.material_buf.append(mat);
-    int material_index = resources.material_buf.size() - 1;
+    int material_index = material_index_get(mat);
 
     draw_to_mesh_pass(ob_ref, mat.is_transparent(), [&](MeshPass &mesh_pass) {
       PassMain::Sub &pass = mesh_pass.get_subpass(eGeometryType::CURVES).sub("Curves SubPass");
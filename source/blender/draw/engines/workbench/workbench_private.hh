@@ -13,6 +13,8 @@
 
 #include "GPU_capabilities.hh"
 
+#include "BLI_struct_equality_utils.hh"
+
 extern "C" DrawEngineType draw_engine_workbench;
 
 namespace blender::workbench {
@@ -135,6 +137,13 @@ struct Material {
   static uint32_t pack_data(float metallic, float roughness, float alpha);
 
   bool is_transparent();
+
+  uint64_t hash() const
+  {
+    return get_default_hash(base_color, packed_data);
+  }
+
+  BLI_STRUCT_EQUALITY_OPERATORS_2(Material, base_color, packed_data)
 };
 
 ImageGPUTextures get_material_texture(GPUSamplerState &sampler_state);
@@ -283,6 +292,11 @@ struct SceneResources {
   Framebuffer clear_in_front_fb = {"Clear In Front"};
 
   StorageVectorBuffer<Material> material_buf = {"material_buf"};
+  /**
+   * Index of every material in #material_buf. Objects sharing the same material share the same
+   * entry, so the buffer doesn't grow with the object count in scenes with many objects.
+   */
+  Map<Material, int> material_index_map;
   UniformBuffer<WorldData> world_buf = {};
   UniformArrayBuffer<float4, 6> clip_planes_buf;
 
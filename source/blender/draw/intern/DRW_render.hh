@@ -280,6 +280,12 @@ GPUMaterial *DRW_shader_from_material(
     void *thunk,
     GPUMaterialPassReplacementCallbackFn pass_replacement_cb = nullptr);
 void DRW_shader_queue_optimize_material(GPUMaterial *mat);
+/**
+ * Wait for the compilation of the materials that were requested with deferred compilation during
+ * an image render. These are compiled in parallel when the GPU backend supports it, and are
+ * #GPU_MAT_QUEUED until then.
+ */
+void DRW_render_shader_compilation_wait();
 void DRW_shader_free(GPUShader *shader);
 #define DRW_SHADER_FREE_SAFE(shader) \
   do { \
@@ -3387,6 +3387,8 @@ void drw_batch_cache_validate(Object *ob)
 void drw_batch_cache_generate_requested(Object *ob)
 {
   using namespace blender::draw;
+  /* Also attributes the extraction tasks created here to the draw category. */
+  MEM_ScopedCategory memory_category(MEM_CATEGORY_DRAW);
   const DRWContextState *draw_ctx = DRW_context_state_get();
   const Scene *scene = draw_ctx->scene;
   const enum eContextObjectMode mode = CTX_data_mode_enum_ex(
@@ -3425,6 +3427,7 @@ void drw_batch_cache_generate_requested_evaluated_mesh_or_curve(Object *ob)
 {
   using namespace blender::draw;
   /* NOTE: Logic here is duplicated from #drw_batch_cache_generate_requested. */
+  MEM_ScopedCategory memory_category(MEM_CATEGORY_DRAW);
 
   const DRWContextState *draw_ctx = DRW_context_state_get();
   const Scene *scene = draw_ctx->scene;
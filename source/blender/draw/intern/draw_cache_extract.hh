@@ -8,8 +8,13 @@
 
 #pragma once
 
+#include <optional>
+#include <string>
+
+#include "BLI_implicit_sharing_ptr.hh"
 #include "BLI_math_matrix_types.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "GPU_shader.hh"
 
@@ -230,6 +235,53 @@ struct MeshBufferCache {
                  &batch_cache.cage : \
                  ((mbc == &batch_cache.cage) ? &batch_cache.uv_cage : nullptr))
 
+/**
+ * Identity of the mesh data that the buffers of a #MeshBatchCache are extracted from, except for
+ * the vertex positions. When it doesn't change between evaluations, only the buffers that depend
+ * on the positions have to be extracted again.
+ */
+struct MeshBatchCacheSources {
+  struct Layer {
+    int domain;
+    int type;
+    std::string name;
+    int flag;
+    int active;
+    int active_rnd;
+    int active_clone;
+    int active_mask;
+    /** Holds a weak user, so the pointer can't be reused for other data meanwhile. */
+    WeakImplicitSharingPtr sharing_info;
+    int64_t version;
+
+    friend bool operator==(const Layer &a, const Layer &b)
+    {
+      return a.domain == b.domain && a.type == b.type && a.name == b.name && a.flag == b.flag &&
+             a.active == b.active && a.active_rnd == b.active_rnd &&
+             a.active_clone == b.active_clone && a.active_mask == b.active_mask &&
+             a.sharing_info == b.sharing_info && a.version == b.version;
+    }
+  };
+
+  int verts_num;
+  int edges_num;
+  int faces_num;
+  int corners_num;
+  Vector<Layer> layers;
+  Vector<std::string> vertex_group_names;
+  std::string active_color_attribute;
+  std::string default_color_attribute;
+
+  friend bool operator==(const MeshBatchCacheSources &a, const MeshBatchCacheSources &b)
+  {
+    return a.verts_num == b.verts_num && a.edges_num == b.edges_num &&
+           a.faces_num == b.faces_num && a.corners_num == b.corners_num && a.layers == b.layers &&
+           a.vertex_group_names == b.vertex_group_names &&
+           a.active_color_attribute == b.active_color_attribute &&
+           a.default_color_attribute == b.default_color_attribute;
+  }
+};
+
 struct MeshBatchCache {
   MeshBufferCache final, cage, uv_cage;
 
@@ -252,6 +304,8 @@ struct MeshBatchCache {
   int mat_len;
   /* Instantly invalidates cache, skipping mesh check */
   bool is_dirty;
+  /** Not set when the mesh data can't be identified, e.g. in edit mode. */
+  std::optional<MeshBatchCacheSources> sources;
   bool is_editmode;
   bool is_uvsyncsel;
 
@@ -179,6 +179,7 @@ static void clear_edit_data(CurvesBatchCache *cache)
 static void clear_final_data(CurvesEvalFinalCache &final_cache)
 {
   GPU_VERTBUF_DISCARD_SAFE(final_cache.proc_buf);
+  GPU_BATCH_DISCARD_SAFE(final_cache.proc_hairs_simplified);
   GPU_BATCH_DISCARD_SAFE(final_cache.proc_hairs);
   for (const int j : IndexRange(GPU_MAX_ATTR)) {
     GPU_VERTBUF_DISCARD_SAFE(final_cache.attributes_buf[j]);
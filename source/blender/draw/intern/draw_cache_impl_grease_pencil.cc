@@ -13,10 +13,13 @@
 #include "BKE_deform.hh"
 #include "BKE_grease_pencil.h"
 #include "BKE_grease_pencil.hh"
+#include "BKE_material.h"
 
+#include "BLI_struct_equality_utils.hh"
 #include "BLI_task.hh"
 
 #include "DNA_grease_pencil_types.h"
+#include "DNA_material_types.h"
 
 #include "DRW_engine.hh"
 #include "DRW_render.hh"
@@ -33,6 +36,26 @@
 
 namespace blender::draw {
 
+/**
+ * Everything the stroke geometry buffers are built from. The frame change re-evaluates and tags
+ * the grease pencil for every frame, but often the same drawings are displayed on the next frame.
+ */
+struct GreasePencilGeomKey {
+  /** Strokes using hidden materials are not in the buffers. */
+  Vector<bool> hidden_materials;
+  /**
+   * The visible drawings and their attribute arrays. The arrays are shared with the original
+   * drawings, editing them makes a copy so the pointers change.
+   */
+  Vector<const void *> drawing_data;
+  /** Layer index and onion skinning offset of every visible drawing. */
+  Vector<int> drawing_info;
+  Vector<float4x4> layer_to_object;
+
+  BLI_STRUCT_EQUALITY_OPERATORS_4(
+      GreasePencilGeomKey, hidden_materials, drawing_data, drawing_info, layer_to_object)
+};
+
 struct GreasePencilBatchCache {
   /** Instancing Data */
   gpu::VertBuf *vbo;
@@ -58,6 +81,18 @@ struct GreasePencilBatchCache {
   /* Indices for lines segments. */
   gpu::IndexBuf *edit_line_indices;
 
+  /** Inputs of #vbo, #vbo_col and #ibo. */
+  GreasePencilGeomKey geom_key;
+  /**
+   * Geometry buffers from before the cache was cleared, reused when they are built from the same
+   * inputs.
+   */
+  gpu::VertBuf *prev_vbo;
+  gpu::VertBuf *prev_vbo_col;
+  gpu::IndexBuf *prev_ibo;
+  gpu::Batch *prev_geom_batch;
+  GreasePencilGeomKey prev_geom_key;
+
   /** Cache is dirty. */
   bool is_dirty;
   /** Last cached frame. */
@@ -130,7 +165,13 @@ static GreasePencilBatchCache *grease_pencil_batch_cache_init(GreasePencil &grea
     grease_pencil.runtime->batch_cache = cache;
   }
   else {
-    *cache = {};
+    GreasePencilBatchCache new_cache = {};
+    new_cache.prev_vbo = cache->prev_vbo;
+    new_cache.prev_vbo_col = cache->prev_vbo_col;
+    new_cache.prev_ibo = cache->prev_ibo;
+    new_cache.prev_geom_batch = cache->prev_geom_batch;
+    new_cache.prev_geom_key = std::move(cache->prev_geom_key);
+    *cache = std::move(new_cache);
   }
 
   cache->is_dirty = false;
@@ -139,6 +180,15 @@ static GreasePencilBatchCache *grease_pencil_batch_cache_init(GreasePencil &grea
   return cache;
 }
 
+static void grease_pencil_batch_cache_prev_geom_discard(GreasePencilBatchCache &cache)
+{
+  GPU_BATCH_DISCARD_SAFE(cache.prev_geom_batch);
+  GPU_VERTBUF_DISCARD_SAFE(cache.prev_vbo);
+  GPU_VERTBUF_DISCARD_SAFE(cache.prev_vbo_col);
+  GPU_INDEXBUF_DISCARD_SAFE(cache.prev_ibo);
+  cache.prev_geom_key = {};
+}
+
 static void grease_pencil_batch_cache_clear(GreasePencil &grease_pencil)
 {
   BLI_assert(grease_pencil.runtime != nullptr);
@@ -148,10 +198,15 @@ static void grease_pencil_batch_cache_clear(GreasePencil &grease_pencil)
     return;
   }
 
-  GPU_BATCH_DISCARD_SAFE(cache->geom_batch);
-  GPU_VERTBUF_DISCARD_SAFE(cache->vbo);
-  GPU_VERTBUF_DISCARD_SAFE(cache->vbo_col);
-  GPU_INDEXBUF_DISCARD_SAFE(cache->ibo);
+  /* Keep the geometry buffers for #grease_pencil_geom_batch_ensure. */
+  if (cache->vbo != nullptr) {
+    grease_pencil_batch_cache_prev_geom_discard(*cache);
+    cache->prev_geom_batch = std::exchange(cache->geom_batch, nullptr);
+    cache->prev_vbo = std::exchange(cache->vbo, nullptr);
+    cache->prev_vbo_col = std::exchange(cache->vbo_col, nullptr);
+    cache->prev_ibo = std::exchange(cache->ibo, nullptr);
+    cache->prev_geom_key = std::move(cache->geom_key);
+  }
 
   GPU_BATCH_DISCARD_SAFE(cache->edit_points);
   GPU_BATCH_DISCARD_SAFE(cache->edit_lines);
@@ -1016,6 +1071,33 @@ static VArray<T> attribute_interpolate(const VArray<T> &input, const bke::Curves
   return VArray<T>::ForContainer(std::move(out));
 };
 
+static GreasePencilGeomKey grease_pencil_geom_key(
+    Object &object,
+    const GreasePencil &grease_pencil,
+    const Span<ed::greasepencil::DrawingInfo> drawings)
+{
+  GreasePencilGeomKey key;
+  for (const int mat_i : IndexRange(object.totcol)) {
+    const Material *material = BKE_object_material_get(&object, mat_i + 1);
+    key.hidden_materials.append(material != nullptr && material->gp_style != nullptr &&
+                                (material->gp_style->flag & GP_MATERIAL_HIDE) != 0);
+  }
+  for (const ed::greasepencil::DrawingInfo &info : drawings) {
+    const bke::CurvesGeometry &curves = info.drawing.strokes();
+    key.drawing_data.append(&info.drawing);
+    key.drawing_data.append(curves.curve_offsets);
+    for (const CustomData *data : {&curves.point_data, &curves.curve_data}) {
+      for (const CustomDataLayer &layer : Span(data->layers, data->totlayer)) {
+        key.drawing_data.append(layer.data);
+      }
+    }
+    key.drawing_info.append(info.layer_index);
+    key.drawing_info.append(info.onion_id);
+    key.layer_to_object.append(grease_pencil.layer(info.layer_index)->to_object_space(object));
+  }
+  return key;
+}
+
 static void grease_pencil_geom_batch_ensure(Object &object,
                                             const GreasePencil &grease_pencil,
                                             const Scene &scene)
@@ -1037,6 +1119,20 @@ static void grease_pencil_geom_batch_ensure(Object &object,
   const Vector<ed::greasepencil::DrawingInfo> drawings =
       ed::greasepencil::retrieve_visible_drawings(scene, grease_pencil, true);
 
+  GreasePencilGeomKey geom_key = grease_pencil_geom_key(object, grease_pencil, drawings);
+  if (cache->prev_vbo != nullptr && cache->prev_geom_key == geom_key) {
+    cache->geom_batch = std::exchange(cache->prev_geom_batch, nullptr);
+    cache->vbo = std::exchange(cache->prev_vbo, nullptr);
+    cache->vbo_col = std::exchange(cache->prev_vbo_col, nullptr);
+    cache->ibo = std::exchange(cache->prev_ibo, nullptr);
+    cache->geom_key = std::move(geom_key);
+    cache->prev_geom_key = {};
+    cache->is_dirty = false;
+    return;
+  }
+  grease_pencil_batch_cache_prev_geom_discard(*cache);
+  cache->geom_key = std::move(geom_key);
+
   /* First, count how many vertices and triangles are needed for the whole object. Also record the
    * offsets into the curves for the vertices and triangles. */
   int total_verts_num = 0;
@@ -1324,6 +1420,11 @@ void DRW_grease_pencil_batch_cache_validate(GreasePencil *grease_pencil)
 void DRW_grease_pencil_batch_cache_free(GreasePencil *grease_pencil)
 {
   grease_pencil_batch_cache_clear(*grease_pencil);
+  if (GreasePencilBatchCache *cache = static_cast<GreasePencilBatchCache *>(
+          grease_pencil->runtime->batch_cache))
+  {
+    grease_pencil_batch_cache_prev_geom_discard(*cache);
+  }
   MEM_delete(static_cast<GreasePencilBatchCache *>(grease_pencil->runtime->batch_cache));
   grease_pencil->runtime->batch_cache = nullptr;
 }
@@ -41,6 +41,7 @@
 #include "BKE_modifier.hh"
 #include "BKE_object.hh"
 #include "BKE_object_deform.h"
+#include "BKE_object_types.hh"
 #include "BKE_paint.hh"
 #include "BKE_pbvh_api.hh"
 #include "BKE_subdiv_modifier.hh"
@@ -573,6 +574,62 @@ static bool mesh_batch_cache_valid(Object &object, Mesh &mesh)
   return true;
 }
 
+static std::optional<MeshBatchCacheSources> mesh_batch_cache_sources_gather(const Mesh &mesh)
+{
+  /* Edit-mesh wrappers don't store their data in the custom data layers. */
+  if (mesh.runtime->edit_mesh != nullptr || mesh.runtime->wrapper_type != ME_WRAPPER_TYPE_MDATA) {
+    return std::nullopt;
+  }
+  MeshBatchCacheSources sources;
+  sources.verts_num = mesh.verts_num;
+  sources.edges_num = mesh.edges_num;
+  sources.faces_num = mesh.faces_num;
+  sources.corners_num = mesh.corners_num;
+  const std::array<const CustomData *, 4> domains = {
+      &mesh.vert_data, &mesh.edge_data, &mesh.face_data, &mesh.corner_data};
+  for (const int domain : IndexRange(domains.size())) {
+    const CustomData &data = *domains[domain];
+    for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+      if (domain == 0 && layer.type == CD_PROP_FLOAT3 && STREQ(layer.name, "position")) {
+        continue;
+      }
+      if (layer.data != nullptr && layer.sharing_info == nullptr) {
+        return std::nullopt;
+      }
+      if (layer.sharing_info != nullptr) {
+        layer.sharing_info->add_weak_user();
+      }
+      const int64_t version = layer.sharing_info ? layer.sharing_info->version() : 0;
+      sources.layers.append({domain,
+                             layer.type,
+                             layer.name,
+                             layer.flag,
+                             layer.active,
+                             layer.active_rnd,
+                             layer.active_clone,
+                             layer.active_mask,
+                             WeakImplicitSharingPtr(layer.sharing_info),
+                             version});
+    }
+  }
+  if (mesh.face_offset_indices != nullptr) {
+    const ImplicitSharingInfo *face_offsets = mesh.runtime->face_offsets_sharing_info;
+    if (face_offsets == nullptr) {
+      return std::nullopt;
+    }
+    const int64_t version = face_offsets->version();
+    face_offsets->add_weak_user();
+    sources.layers.append(
+        {-1, -1, "", 0, 0, 0, 0, 0, WeakImplicitSharingPtr(face_offsets), version});
+  }
+  LISTBASE_FOREACH (const bDeformGroup *, group, &mesh.vertex_group_names) {
+    sources.vertex_group_names.append(group->name);
+  }
+  sources.active_color_attribute = StringRef(mesh.active_color_attribute);
+  sources.default_color_attribute = StringRef(mesh.default_color_attribute);
+  return sources;
+}
+
 static void mesh_batch_cache_init(Object &object, Mesh &mesh)
 {
   if (!mesh.runtime->batch_cache) {
@@ -591,20 +648,139 @@ static void mesh_batch_cache_init(Object &object, Mesh &mesh)
     // cache->face_len = mesh_render_faces_len_get(mesh);
     // cache->vert_len = mesh_render_verts_len_get(mesh);
   }
+  else {
+    const BMEditMesh &em = *mesh.runtime->edit_mesh;
+    cache->edge_len = em.bm->totedge;
+    cache->tri_len = int(em.looptris.size());
+    cache->face_len = em.bm->totface;
+    cache->vert_len = em.bm->totvert;
+  }
 
   cache->mat_len = mesh_render_mat_len_get(object, mesh);
   cache->surface_per_mat = Array<gpu::Batch *>(cache->mat_len, nullptr);
   cache->tris_per_mat = Array<gpu::IndexBuf *>(cache->mat_len, nullptr);
 
   cache->is_dirty = false;
+  cache->sources = mesh_batch_cache_sources_gather(mesh);
   cache->batch_ready = (DRWBatchFlag)0;
   cache->batch_requested = (DRWBatchFlag)0;
 
   drw_mesh_weight_state_clear(&cache->weight_state);
 }
 
+static void mesh_batch_cache_discard_positions(MeshBatchCache &cache)
+{
+  FOREACH_MESH_BUFFER_CACHE (cache, mbc) {
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edge_fac);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.tan);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_area);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_angle);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.mesh_analysis);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.skin_roots);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.vnor);
+    /* The positions can also be drawn as a generic attribute. */
+    for (int i = 0; i < cache.attr_used.num_requests; i++) {
+      if (STREQ(cache.attr_used.requests[i].attribute_name, "position")) {
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.attr[i]);
+      }
+    }
+  }
+  DRWBatchFlag batch_map = BATCH_MAP(vbo.pos,
+                                     vbo.nor,
+                                     vbo.edge_fac,
+                                     vbo.tan,
+                                     vbo.edituv_stretch_area,
+                                     vbo.edituv_stretch_angle,
+                                     vbo.mesh_analysis,
+                                     vbo.fdots_pos,
+                                     vbo.fdots_nor,
+                                     vbo.skin_roots) |
+                           BATCH_MAP(vbo.vnor, vbo.attr[0]);
+  mesh_batch_cache_discard_batch(cache, batch_map);
+}
+
+/**
+ * In edit mode the mesh data can't be compared, but transform tells when it only moved vertices.
+ * The element counts are compared as well, in case the topology changed without clearing it.
+ */
+static bool mesh_batch_cache_edit_positions_only_changed(const MeshBatchCache &cache, Mesh &mesh)
+{
+  BMEditMesh *em = mesh.runtime->edit_mesh.get();
+  if (em == nullptr || !em->is_positions_only_update) {
+    return false;
+  }
+  /* Deformed cages store their own positions. */
+  if (!mesh.runtime->is_original_bmesh || mesh.runtime->wrapper_type != ME_WRAPPER_TYPE_BMESH) {
+    return false;
+  }
+  const BMesh &bm = *em->bm;
+  return cache.vert_len == bm.totvert && cache.edge_len == bm.totedge &&
+         cache.face_len == bm.totface && cache.tri_len == int(em->looptris.size());
+}
+
+/**
+ * Keep the buffers of a dirty cache that don't depend on the vertex positions, when no other data
+ * of the mesh changed. That is the case for a mesh deformed by an armature for example, where
+ * only the positions and normals have to be extracted again.
+ */
+static bool mesh_batch_cache_reuse_for_new_positions(Object &object, Mesh &mesh)
+{
+  MeshBatchCache *cache = static_cast<MeshBatchCache *>(mesh.runtime->batch_cache);
+  if (cache == nullptr || !cache->is_dirty) {
+    return false;
+  }
+  /* GPU subdivision evaluates all buffers from the positions. */
+  if (cache->subdiv_cache != nullptr) {
+    return false;
+  }
+  if (cache->is_editmode != (mesh.runtime->edit_mesh != nullptr)) {
+    return false;
+  }
+  if (cache->mat_len != mesh_render_mat_len_get(object, mesh)) {
+    return false;
+  }
+  if (cache->is_editmode) {
+    if (!mesh_batch_cache_edit_positions_only_changed(*cache, mesh)) {
+      return false;
+    }
+    mesh.runtime->edit_mesh->is_positions_only_update = false;
+    /* The generated coordinates of edit-meshes are computed from the current positions. */
+    MeshBatchCache &batch_cache = *cache;
+    FOREACH_MESH_BUFFER_CACHE (batch_cache, mbc) {
+      GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.orco);
+    }
+    mesh_batch_cache_discard_batch(batch_cache, BATCH_MAP(vbo.orco));
+  }
+  else {
+    if (!cache->sources.has_value()) {
+      return false;
+    }
+    const std::optional<MeshBatchCacheSources> sources = mesh_batch_cache_sources_gather(mesh);
+    if (!sources.has_value() || !(*sources == *cache->sources)) {
+      return false;
+    }
+  }
+  mesh_batch_cache_discard_positions(*cache);
+  cache->is_dirty = false;
+  return true;
+}
+
 void DRW_mesh_batch_cache_validate(Object &object, Mesh &mesh)
 {
+  if (mesh.runtime->batch_cache == nullptr && object.runtime->mesh_batch_cache_previous &&
+      object.runtime->data_eval == &mesh.id)
+  {
+    /* Continue from the cache of the mesh of the previous evaluation of the object. */
+    mesh.runtime->batch_cache = std::exchange(object.runtime->mesh_batch_cache_previous, nullptr);
+    static_cast<MeshBatchCache *>(mesh.runtime->batch_cache)->is_dirty = true;
+  }
+  if (mesh_batch_cache_reuse_for_new_positions(object, mesh)) {
+    return;
+  }
   if (!mesh_batch_cache_valid(object, mesh)) {
     if (mesh.runtime->batch_cache) {
       mesh_batch_cache_clear(*static_cast<MeshBatchCache *>(mesh.runtime->batch_cache));
@@ -826,6 +1002,7 @@ static void mesh_batch_cache_clear(MeshBatchCache &cache)
 
   cache.batch_ready = (DRWBatchFlag)0;
   drw_mesh_weight_state_clear(&cache.weight_state);
+  cache.sources.reset();
 
   mesh_batch_cache_free_subdiv_cache(cache);
 }
@@ -302,7 +302,7 @@ static DRWVolumeGrid *volume_grid_cache_get(const Volume *volume,
   }
 
   DenseFloatVolumeGrid dense_grid;
-  if (BKE_volume_grid_dense_floats(volume, grid, &dense_grid)) {
+  if (BKE_volume_grid_dense_floats(volume, grid, GPU_max_texture_3d_size(), &dense_grid)) {
     cache_grid->texture_to_object = float4x4(dense_grid.texture_to_object);
     cache_grid->object_to_texture = math::invert(cache_grid->texture_to_object);
 
@@ -314,8 +314,7 @@ static DRWVolumeGrid *volume_grid_cache_get(const Volume *volume,
                                                 format,
                                                 GPU_TEXTURE_USAGE_SHADER_READ,
                                                 dense_grid.voxels);
-    /* The texture can be null if the resolution along one axis is larger than
-     * GL_MAX_3D_TEXTURE_SIZE. */
+    /* The texture can be null if the GPU runs out of memory. */
     if (cache_grid->texture != nullptr) {
       GPU_texture_swizzle_set(cache_grid->texture, (channels == 3) ? "rgb1" : "rrr1");
       GPU_texture_extend_mode(cache_grid->texture, GPU_SAMPLER_EXTEND_MODE_CLAMP_TO_BORDER);
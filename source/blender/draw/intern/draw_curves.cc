@@ -16,6 +16,7 @@
 #include "BKE_attribute.hh"
 #include "BKE_curves.hh"
 #include "BKE_customdata.hh"
+#include "BKE_scene.hh"
 
 #include "GPU_batch.hh"
 #include "GPU_capabilities.hh"
@@ -192,6 +193,44 @@ gpu::VertBuf *DRW_curves_pos_buffer_get(Object *object)
   return cache->final.proc_buf;
 }
 
+/**
+ * The "Max Child Particles" simplify setting of the scene also limits the number of displayed
+ * hair curves. Only the first curves are kept, so that the subset is stable across redraws, and
+ * their radius is scaled to keep about the same coverage.
+ */
+static gpu::Batch *curves_simplified_batch_get(CurvesEvalCache &cache,
+                                               const Scene &scene,
+                                               float &r_radius_scale)
+{
+  r_radius_scale = 1.0f;
+  gpu::Batch *batch = cache.final.proc_hairs;
+  const int curves_num = cache.curves_num;
+  if (batch->elem == nullptr || curves_num == 0) {
+    return batch;
+  }
+  const int display_num = std::max(
+      get_render_child_particle_number(&scene.r, curves_num, DRW_state_is_scene_render()), 1);
+  if (display_num >= curves_num) {
+    return batch;
+  }
+  r_radius_scale = math::sqrt(float(curves_num) / float(display_num));
+
+  CurvesEvalFinalCache &final_cache = cache.final;
+  if (final_cache.proc_hairs_simplified_num != display_num) {
+    GPU_BATCH_DISCARD_SAFE(final_cache.proc_hairs_simplified);
+  }
+  if (final_cache.proc_hairs_simplified == nullptr) {
+    /* Every curve uses the same number of indices. */
+    const uint curve_index_len = batch->elem->index_len_get() / curves_num;
+    gpu::IndexBuf *elem = GPU_indexbuf_create_subrange(
+        batch->elem, 0, curve_index_len * display_num);
+    final_cache.proc_hairs_simplified = GPU_batch_create_ex(
+        batch->prim_type, batch->verts[0], elem, GPU_BATCH_OWNS_INDEX);
+    final_cache.proc_hairs_simplified_num = display_num;
+  }
+  return final_cache.proc_hairs_simplified;
+}
+
 static int attribute_index_in_material(GPUMaterial *gpu_material, const char *name)
 {
   if (!gpu_material) {
@@ -227,6 +266,8 @@ DRWShadingGroup *DRW_shgroup_curves_create_sub(Object *object,
 
   CurvesEvalCache *curves_cache = drw_curves_cache_get(
       curves_id, gpu_material, subdiv, thickness_res);
+  float radius_scale;
+  gpu::Batch *geom = curves_simplified_batch_get(*curves_cache, *scene, radius_scale);
 
   DRWShadingGroup *shgrp = DRW_shgroup_create_sub(shgrp_parent);
 
@@ -254,8 +295,8 @@ DRWShadingGroup *DRW_shgroup_curves_create_sub(Object *object,
     const float first_radius = radii[first_curve_points.first()];
     const float last_radius = radii[first_curve_points.last()];
     const float middle_radius = radii[first_curve_points.size() / 2];
-    hair_rad_root = radii[first_curve_points.first()];
-    hair_rad_tip = radii[first_curve_points.last()];
+    hair_rad_root = radii[first_curve_points.first()] * radius_scale;
+    hair_rad_tip = radii[first_curve_points.last()] * radius_scale;
     hair_rad_shape = std::clamp(
         math::safe_divide(middle_radius - first_radius, last_radius - first_radius) * 2.0f - 1.0f,
         -1.0f,
@@ -331,7 +372,6 @@ DRWShadingGroup *DRW_shgroup_curves_create_sub(Object *object,
   }
   /* TODO(fclem): Until we have a better way to cull the curves and render with orco, bypass
    * culling test. */
-  gpu::Batch *geom = curves_cache->final.proc_hairs;
   DRW_shgroup_call_no_cull(shgrp, geom, object);
 
   return shgrp;
@@ -472,6 +512,8 @@ gpu::Batch *curves_sub_pass_setup_implementation(PassT &sub_ps,
 
   CurvesEvalCache *curves_cache = drw_curves_cache_get(
       curves_id, gpu_material, subdiv, thickness_res);
+  float radius_scale;
+  gpu::Batch *geom = curves_simplified_batch_get(*curves_cache, *scene, radius_scale);
 
   /* Fix issue with certain driver not drawing anything if there is nothing bound to
    * "ac", "au", "u" or "c". */
@@ -497,8 +539,8 @@ gpu::Batch *curves_sub_pass_setup_implementation(PassT &sub_ps,
     const float first_radius = radii[first_curve_points.first()];
     const float last_radius = radii[first_curve_points.last()];
     const float middle_radius = radii[first_curve_points.size() / 2];
-    hair_rad_root = radii[first_curve_points.first()];
-    hair_rad_tip = radii[first_curve_points.last()];
+    hair_rad_root = radii[first_curve_points.first()] * radius_scale;
+    hair_rad_tip = radii[first_curve_points.last()] * radius_scale;
     hair_rad_shape = std::clamp(
         math::safe_divide(middle_radius - first_radius, last_radius - first_radius) * 2.0f - 1.0f,
         -1.0f,
@@ -568,7 +610,7 @@ gpu::Batch *curves_sub_pass_setup_implementation(PassT &sub_ps,
   sub_ps.push_constant("hairRadTip", hair_rad_tip);
   sub_ps.push_constant("hairCloseTip", hair_close_tip);
 
-  return curves_cache->final.proc_hairs;
+  return geom;
 }
 
 gpu::Batch *curves_sub_pass_setup(PassMain::Sub &ps,
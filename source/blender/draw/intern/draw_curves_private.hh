@@ -41,6 +41,12 @@ struct CurvesEvalFinalCache {
 
   /** Just contains a huge index buffer used to draw the final curves. */
   gpu::Batch *proc_hairs;
+  /**
+   * Draws the first #proc_hairs_simplified_num curves of #proc_hairs, when the scene simplify
+   * settings reduce the number of displayed curves.
+   */
+  gpu::Batch *proc_hairs_simplified;
+  int proc_hairs_simplified_num;
 
   /** Points per curve, at least 2. */
   int resolution;
@@ -2052,6 +2052,9 @@ void DRW_render_to_image(RenderEngine *engine, Depsgraph *depsgraph)
 
   RE_engine_end_result(engine, render_result, false, false, false);
 
+  /* Don't leave materials compiling when the engine didn't wait for them. */
+  DRW_render_shader_compilation_wait();
+
   if (engine_type->draw_engine->store_metadata) {
     RenderResult *final_render_result = RE_engine_get_result(engine);
     engine_type->draw_engine->store_metadata(data, final_render_result);
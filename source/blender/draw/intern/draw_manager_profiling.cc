@@ -8,6 +8,7 @@
 
 #include <algorithm>
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
@@ -20,24 +21,33 @@
 
 #include "draw_manager_c.hh"
 
+#include "GPU_capabilities.hh"
 #include "GPU_debug.hh"
+#include "GPU_storage_buffer.hh"
 #include "GPU_texture.hh"
 
 #include "UI_resources.hh"
 
 #include "draw_manager_profiling.hh"
 
+#include "gpu_backend.hh"
+#include "gpu_query.hh"
+
 #define MAX_TIMER_NAME 32
 #define MAX_NESTED_TIMER 8
 #define MIM_RANGE_LEN 8
 #define GPU_TIMER_FALLOFF 0.1
 
+using blender::gpu::GPUBackend;
+using blender::gpu::QueryPool;
+
 struct DRWTimer {
-  uint32_t query[2];
+  /** Index of the start and end GPU timestamps of the timer, -1 when not recorded. */
+  int query[2];
   uint64_t time_average;
   char name[MAX_TIMER_NAME];
   int lvl;       /* Hierarchy level for nested timer. */
-  bool is_query; /* Does this timer actually perform queries or is it just a group. */
+  bool is_query; /* Is this timer a single pass or a group of timers. */
 };
 
 static struct DRWTimerPool {
@@ -48,15 +58,17 @@ static struct DRWTimerPool {
   int end_increment;   /* Keep track of bad usage. */
   bool is_recording;   /* Are we in the render loop? */
   bool is_querying;    /* Keep track of bad usage. */
+  /** Index of the timers that are not ended yet, indexed by their level. */
+  int timer_stack[MAX_NESTED_TIMER];
+  /** GPU timestamps of the frame being recorded, null when not supported. */
+  QueryPool *timestamps;
+  int timestamps_len;
 } DTP = {nullptr};
 
 void DRW_stats_free()
 {
+  BLI_assert(DTP.timestamps == nullptr);
   if (DTP.timers != nullptr) {
-    // for (int i = 0; i < DTP.timer_count; i++) {
-    // DRWTimer *timer = &DTP.timers[i];
-    // glDeleteQueries(2, timer->query);
-    // }
     MEM_freeN(DTP.timers);
     DTP.timers = nullptr;
   }
@@ -78,6 +90,13 @@ void DRW_stats_begin()
     DRW_stats_free();
   }
 
+  if (DTP.is_recording && GPU_timer_query_support()) {
+    BLI_assert(DTP.timestamps == nullptr);
+    DTP.timestamps = GPUBackend::get()->querypool_alloc();
+    DTP.timestamps->init(blender::gpu::GPU_QUERY_TIMESTAMP);
+    DTP.timestamps_len = 0;
+  }
+
   DTP.is_querying = false;
   DTP.timer_increment = 0;
   DTP.end_increment = 0;
@@ -96,6 +115,16 @@ static DRWTimer *drw_stats_timer_get()
   return &DTP.timers[DTP.timer_increment++];
 }
 
+/** Record a GPU timestamp and return its index, -1 when timestamps are not supported. */
+static int drw_stats_timestamp_query()
+{
+  if (DTP.timestamps == nullptr) {
+    return -1;
+  }
+  DTP.timestamps->query_timestamp();
+  return DTP.timestamps_len++;
+}
+
 static void drw_stats_timer_start_ex(const char *name, const bool is_query)
 {
   if (DTP.is_recording) {
@@ -104,21 +133,27 @@ static void drw_stats_timer_start_ex(const char *name, const bool is_query)
     timer->lvl = DTP.timer_increment - DTP.end_increment - 1;
     timer->is_query = is_query;
 
+    BLI_assert(timer->lvl < MAX_NESTED_TIMER);
+    DTP.timer_stack[timer->lvl] = DTP.timer_increment - 1;
+
     /* Queries cannot be nested or interleaved. */
     BLI_assert(!DTP.is_querying);
     if (timer->is_query) {
-      if (timer->query[0] == 0) {
-        // glGenQueries(1, timer->query);
-      }
-
-      // glFinish();
-      /* Issue query for the next frame */
-      // glBeginQuery(GL_TIME_ELAPSED, timer->query[0]);
       DTP.is_querying = true;
     }
+    timer->query[0] = drw_stats_timestamp_query();
   }
 }
 
+static void drw_stats_timer_end()
+{
+  DTP.end_increment++;
+  const int lvl = DTP.timer_increment - DTP.end_increment;
+  BLI_assert(lvl >= 0 && lvl < MAX_NESTED_TIMER);
+  DRWTimer *timer = &DTP.timers[DTP.timer_stack[lvl]];
+  timer->query[1] = drw_stats_timestamp_query();
+}
+
 void DRW_stats_group_start(const char *name)
 {
   drw_stats_timer_start_ex(name, false);
@@ -131,7 +166,7 @@ void DRW_stats_group_end()
   GPU_debug_group_end();
   if (DTP.is_recording) {
     BLI_assert(!DTP.is_querying);
-    DTP.end_increment++;
+    drw_stats_timer_end();
   }
 }
 
@@ -145,9 +180,8 @@ void DRW_stats_query_end()
 {
   GPU_debug_group_end();
   if (DTP.is_recording) {
-    DTP.end_increment++;
     BLI_assert(DTP.is_querying);
-    // glEndQuery(GL_TIME_ELAPSED);
+    drw_stats_timer_end();
     DTP.is_querying = false;
   }
 }
@@ -160,34 +194,24 @@ void DRW_stats_reset()
                  "You forgot a DRW_stats_group/query_start somewhere!");
 
   if (DTP.is_recording) {
-    uint64_t lvl_time[MAX_NESTED_TIMER] = {0};
-
-    /* Swap queries for the next frame and sum up each lvl time. */
-    for (int i = DTP.timer_increment - 1; i >= 0; i--) {
-      DRWTimer *timer = &DTP.timers[i];
-      std::swap(timer->query[0], timer->query[1]);
-
-      BLI_assert(timer->lvl < MAX_NESTED_TIMER);
-
-      if (timer->is_query) {
-        uint64_t time = 0;
-        if (timer->query[0] != 0) {
-          // glGetQueryObjectui64v(timer->query[0], GL_QUERY_RESULT, &time);
-        }
-        else {
-          time = 1000000000; /* 1ms default */
-        }
-
+    /* Resolve the timestamps of the frame. The query objects are not shared between the GPU
+     * contexts of different windows, so they are read back right away. This waits for the GPU to
+     * finish the frame, which is acceptable when the statistics are displayed. */
+    if (DTP.timestamps != nullptr) {
+      blender::Array<uint64_t> timestamps(DTP.timestamps_len);
+      DTP.timestamps->get_timestamp_result(timestamps);
+
+      for (int i = 0; i < DTP.timer_increment; i++) {
+        DRWTimer *timer = &DTP.timers[i];
+        const uint64_t time = timestamps[timer->query[1]] - timestamps[timer->query[0]];
         timer->time_average = timer->time_average * (1.0 - GPU_TIMER_FALLOFF) +
                               time * GPU_TIMER_FALLOFF;
         timer->time_average = std::min(timer->time_average, uint64_t(1000000000));
       }
-      else {
-        timer->time_average = lvl_time[timer->lvl + 1];
-        lvl_time[timer->lvl + 1] = 0;
-      }
 
-      lvl_time[timer->lvl] += timer->time_average;
+      delete DTP.timestamps;
+      DTP.timestamps = nullptr;
+      DTP.timestamps_len = 0;
     }
 
     DTP.is_recording = false;
@@ -290,12 +314,13 @@ void DRW_stats_draw(const rcti *rect)
   /* ------------------------------------------ */
 
   /* Memory Stats */
-  uint tex_mem = GPU_texture_memory_usage_get();
-  uint vbo_mem = GPU_vertbuf_get_memory_usage();
+  size_t tex_mem = GPU_texture_memory_usage_get();
+  size_t vbo_mem = GPU_vertbuf_get_memory_usage();
+  size_t ssbo_mem = GPU_storagebuf_memory_usage_get();
 
   STRNCPY(stat_string, "GPU Memory");
   draw_stat(rect, 0, v, stat_string, sizeof(stat_string));
-  SNPRINTF(stat_string, "%.2fMB", double(tex_mem + vbo_mem) / 1000000.0);
+  SNPRINTF(stat_string, "%.2fMB", double(tex_mem + vbo_mem + ssbo_mem) / 1000000.0);
   draw_stat_5row(rect, 1, v++, stat_string, sizeof(stat_string));
   STRNCPY(stat_string, "Textures");
   draw_stat(rect, 1, v, stat_string, sizeof(stat_string));
@@ -305,12 +330,21 @@ void DRW_stats_draw(const rcti *rect)
   draw_stat(rect, 1, v, stat_string, sizeof(stat_string));
   SNPRINTF(stat_string, "%.2fMB", double(vbo_mem) / 1000000.0);
   draw_stat_5row(rect, 1, v++, stat_string, sizeof(stat_string));
+  STRNCPY(stat_string, "Storage Buffers");
+  draw_stat(rect, 1, v, stat_string, sizeof(stat_string));
+  SNPRINTF(stat_string, "%.2fMB", double(ssbo_mem) / 1000000.0);
+  draw_stat_5row(rect, 1, v++, stat_string, sizeof(stat_string));
   v += 1;
 
   /* GPU Timings */
   STRNCPY(stat_string, "GPU Render Timings");
   draw_stat(rect, 0, v++, stat_string, sizeof(stat_string));
 
+  if (!GPU_timer_query_support()) {
+    STRNCPY(stat_string, "Not supported by the GPU backend");
+    draw_stat(rect, 1, v++, stat_string, sizeof(stat_string));
+  }
+
   for (int i = 0; i < DTP.timer_increment; i++) {
     double time_ms, time_percent;
     DRWTimer *timer = &DTP.timers[i];
@@ -15,8 +15,8 @@ void DRW_stats_begin();
 void DRW_stats_reset();
 
 /**
- * Use this to group the queries. It does NOT keep track
- * of the time, it only sum what the queries inside it.
+ * Use this to group the queries. The GPU time of the whole group is measured,
+ * groups can be nested.
  */
 void DRW_stats_group_start(const char *name);
 void DRW_stats_group_end();
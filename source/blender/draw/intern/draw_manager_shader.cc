@@ -285,12 +285,49 @@ static void drw_deferred_queue_append(GPUMaterial *mat, bool is_optimization_job
   WM_jobs_start(wm, wm_job);
 }
 
+/**
+ * Materials of an image render whose compilation was started with
+ * #drw_render_shader_async_compile. Only accessed from the thread that renders.
+ */
+static blender::Vector<GPUMaterial *> &drw_render_async_materials()
+{
+  static blender::Vector<GPUMaterial *> materials;
+  return materials;
+}
+
+/**
+ * Start the compilation of a material of an image render without waiting for it, so that all the
+ * materials of the render are compiled at the same time.
+ * Return false when the material has to be compiled in a blocking manner instead.
+ */
+static bool drw_render_shader_async_compile(GPUMaterial *mat)
+{
+  blender::Vector<GPUMaterial *> &materials = drw_render_async_materials();
+  /* The material could be in the queue of the viewport compilation job. */
+  DRW_deferred_shader_remove(mat);
+  if (GPU_material_status(mat) == GPU_MAT_CREATED) {
+    GPU_material_acquire(mat);
+    GPU_material_status_set(mat, GPU_MAT_QUEUED);
+    GPU_material_async_compile(mat);
+    materials.append(mat);
+    return true;
+  }
+  /* Otherwise it is already compiling, either for this render or in the viewport job. */
+  return materials.contains(mat);
+}
+
 static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
 {
   if (ELEM(GPU_material_status(mat), GPU_MAT_SUCCESS, GPU_MAT_FAILED)) {
     return;
   }
 
+  if (deferred && DRW_state_is_image_render() && GPU_use_parallel_compilation()) {
+    if (drw_render_shader_async_compile(mat)) {
+      return;
+    }
+  }
+
   /* Do not defer the compilation if we are rendering for image.
    * deferred rendering is only possible when `evil_C` is available */
   if (DST.draw_ctx.evil_C == nullptr || DRW_state_is_image_render() || !USE_DEFERRED_COMPILATION) {
@@ -485,11 +522,8 @@ GPUMaterial *DRW_shader_from_material(Material *ma,
 
   drw_register_shader_vlattrs(mat);
 
-  if (DRW_state_is_image_render()) {
-    /* Do not deferred if doing render. */
-    deferred = false;
-  }
-
+  /* For image renders, deferred materials are only compiled in parallel, the engine has to wait
+   * for them with #DRW_render_shader_compilation_wait. */
   drw_deferred_shader_add(mat, deferred);
   DRW_shader_queue_optimize_material(mat);
   return mat;
@@ -538,6 +572,23 @@ void DRW_shader_queue_optimize_material(GPUMaterial *mat)
   drw_deferred_queue_append(mat, true);
 }
 
+void DRW_render_shader_compilation_wait()
+{
+  blender::Vector<GPUMaterial *> &materials = drw_render_async_materials();
+  while (!materials.is_empty()) {
+    materials.remove_if([](GPUMaterial *mat) {
+      if (GPU_material_async_try_finalize(mat)) {
+        GPU_material_release(mat);
+        return true;
+      }
+      return false;
+    });
+    if (!materials.is_empty()) {
+      BLI_time_sleep_ms(1);
+    }
+  }
+}
+
 void DRW_shader_free(GPUShader *shader)
 {
   GPU_shader_free(shader);
@@ -19,6 +19,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_bitmap.h"
 #include "BLI_function_ref.hh"
 #include "BLI_ghash.h"
@@ -44,6 +45,7 @@
 #include "BKE_subdiv_ccg.hh"
 
 #include "GPU_batch.hh"
+#include "GPU_context.hh"
 
 #include "DRW_engine.hh"
 #include "DRW_pbvh.hh"
@@ -100,6 +102,12 @@ struct PBVHVbo {
   AttributeRequest request;
   gpu::VertBuf *vert_buf = nullptr;
   std::string key;
+  /**
+   * Byte range of #vert_buf that changed in the last update, when only that part has to be
+   * uploaded. Empty when nothing changed.
+   */
+  IndexRange sub_update_range;
+  bool use_sub_update = false;
 
   PBVHVbo(const AttributeRequest &request) : request(request)
   {
@@ -901,11 +909,69 @@ static void fill_vbo_faces(PBVHVbo &vbo, const PBVH_GPU_Args &args)
   }
 }
 
+/**
+ * Find the bytes of the buffer which differ from the previously uploaded data, rounded to whole
+ * vertices. Strokes usually only change a part of the vertices of a node, and often don't change
+ * some attributes at all (e.g. face sets or masks while moving vertices).
+ */
+static IndexRange calc_changed_range(const Span<char> previous, const Span<char> data, int stride)
+{
+  BLI_assert(previous.size() == data.size());
+  const char *first = std::mismatch(data.begin(), data.end(), previous.begin()).first;
+  if (first == data.end()) {
+    return {};
+  }
+  const char *last = std::mismatch(data.rbegin(), data.rend(), previous.rbegin()).first.base();
+  const int64_t start = (first - data.begin()) / stride * stride;
+  const int64_t end = std::min<int64_t>(ceil_to_multiple_ul(last - data.begin(), stride),
+                                        data.size());
+  return IndexRange::from_begin_end(start, end);
+}
+
+/**
+ * Decide whether the buffer data filled by an update is uploaded entirely, partially or not at
+ * all, by comparing it with the data from before the update.
+ */
+static void tag_vbo_upload(PBVHVbo &vbo, const Span<char> previous)
+{
+  gpu::VertBuf &vert_buf = *vbo.vert_buf;
+  vbo.use_sub_update = false;
+  if (previous.is_empty() || (vert_buf.flag & GPU_VERTBUF_DATA_DIRTY)) {
+    /* Newly allocated. */
+    GPU_vertbuf_tag_dirty(&vert_buf);
+    return;
+  }
+  const Span<char> data = vert_buf.data<char>().take_front(vert_buf.size_used_get());
+  if (previous.size() != data.size()) {
+    GPU_vertbuf_tag_dirty(&vert_buf);
+    return;
+  }
+  const IndexRange range = calc_changed_range(previous, data, vert_buf.format.stride);
+  /* Partial updates aren't implemented for Vulkan yet. Uploading most of the buffer in one go
+   * isn't slower than a partial update either. */
+  if (!range.is_empty() &&
+      (GPU_backend_get_type() == GPU_BACKEND_VULKAN || range.size() > data.size() / 2))
+  {
+    GPU_vertbuf_tag_dirty(&vert_buf);
+    return;
+  }
+  vbo.sub_update_range = range;
+  vbo.use_sub_update = true;
+}
+
 static void gpu_flush(MutableSpan<PBVHVbo> vbos)
 {
   for (PBVHVbo &vbo : vbos) {
     if (vbo.vert_buf && vbo.vert_buf->data<char>().data()) {
+      /* Binds the buffer, which is necessary for partial updates. */
       GPU_vertbuf_use(vbo.vert_buf);
+      if (vbo.use_sub_update && !vbo.sub_update_range.is_empty()) {
+        GPU_vertbuf_update_sub(vbo.vert_buf,
+                               vbo.sub_update_range.start(),
+                               vbo.sub_update_range.size(),
+                               vbo.vert_buf->data<char>().data() + vbo.sub_update_range.start());
+      }
+      vbo.use_sub_update = false;
     }
   }
 }
@@ -1081,7 +1147,26 @@ void PBVHBatches::update(const PBVH_GPU_Args &args)
   if (!this->lines_index) {
     create_index(args);
   }
+  Array<char> previous;
   for (PBVHVbo &vbo : this->vbos) {
+    /* Buffers keep their data after uploading (see #create_vbo), so it can be compared with the
+     * new data to only upload what changed. */
+    const gpu::VertBuf &vert_buf = *vbo.vert_buf;
+    if (vbo.use_sub_update && !vbo.sub_update_range.is_empty()) {
+      /* The previous partial update wasn't flushed, the data doesn't match the GPU anymore. */
+      GPU_vertbuf_tag_dirty(vbo.vert_buf);
+      vbo.use_sub_update = false;
+    }
+    if ((vert_buf.flag & GPU_VERTBUF_DATA_UPLOADED) && !(vert_buf.flag & GPU_VERTBUF_DATA_DIRTY) &&
+        vbo.vert_buf->data<char>().data())
+    {
+      const Span<char> data = vbo.vert_buf->data<char>().take_front(vert_buf.size_used_get());
+      previous.reinitialize(data.size());
+      previous.as_mutable_span().copy_from(data);
+    }
+    else {
+      previous.reinitialize(0);
+    }
     switch (args.pbvh_type) {
       case bke::pbvh::Type::Mesh:
         fill_vbo_faces(vbo, args);
@@ -1093,6 +1178,7 @@ void PBVHBatches::update(const PBVH_GPU_Args &args)
         fill_vbo_bmesh(vbo, args);
         break;
     }
+    tag_vbo_upload(vbo, previous);
   }
 }
 
@@ -1144,7 +1230,7 @@ int PBVHBatches::create_vbo(const AttributeRequest &request, const PBVH_GPU_Args
   }
 
   vbos.append_as(request);
-  vbos.last().vert_buf = GPU_vertbuf_create_with_format_ex(format, GPU_USAGE_STATIC);
+  vbos.last().vert_buf = GPU_vertbuf_create_with_format_ex(format, GPU_USAGE_DYNAMIC);
   switch (args.pbvh_type) {
     case bke::pbvh::Type::Mesh:
       fill_vbo_faces(vbos.last(), args);
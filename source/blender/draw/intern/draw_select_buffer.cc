@@ -17,7 +17,11 @@
 
 #include "DNA_screen_types.h"
 
+#include "GPU_compute.hh"
 #include "GPU_select.hh"
+#include "GPU_shader.hh"
+#include "GPU_state.hh"
+#include "GPU_storage_buffer.hh"
 
 #include "DEG_depsgraph.hh"
 #include "DEG_depsgraph_query.hh"
@@ -27,6 +31,7 @@
 
 #include "draw_manager_c.hh"
 
+#include "../engines/select/select_defines.hh"
 #include "../engines/select/select_engine.hh"
 
 using blender::int2;
@@ -130,34 +135,99 @@ uint *DRW_select_buffer_read(
  *
  * \{ */
 
-uint *DRW_select_buffer_bitmap_from_rect(
-    Depsgraph *depsgraph, ARegion *region, View3D *v3d, const rcti *rect, uint *r_bitmap_len)
+/**
+ * Fill the bitmap of the select IDs found in \a rect on the GPU, only the bitmap is read back.
+ *
+ * \param circle_radius: When not negative, only pixels inside the circle inscribed in \a rect are
+ * tested, \a rect must then be a square of `circle_radius * 2 + 1` pixels.
+ * \param mask: Optional bitmap of the pixels of \a rect to test, in rows of the rect width.
+ */
+static uint *select_buffer_bitmap_from_region(Depsgraph *depsgraph,
+                                              ARegion *region,
+                                              View3D *v3d,
+                                              const rcti *rect,
+                                              const int circle_radius,
+                                              const BLI_bitmap *mask,
+                                              uint *r_bitmap_len)
 {
   SELECTID_Context *select_ctx = DRW_select_engine_context_get();
 
-  rcti rect_px = *rect;
-  rect_px.xmax += 1;
-  rect_px.ymax += 1;
+  rcti r{};
+  r.xmin = 0;
+  r.xmax = region->winx;
+  r.ymin = 0;
+  r.ymax = region->winy;
 
-  uint buf_len;
-  uint *buf = DRW_select_buffer_read(depsgraph, region, v3d, &rect_px, &buf_len);
-  if (buf == nullptr) {
+  rcti rect_clamp = *rect;
+  if (!BLI_rcti_isect(&r, &rect_clamp, &rect_clamp)) {
+    return nullptr;
+  }
+
+  DRW_gpu_context_enable();
+
+  RegionView3D *rv3d = static_cast<RegionView3D *>(region->regiondata);
+  if (select_ctx->is_dirty(rv3d)) {
+    /* Update drawing. */
+    DRW_draw_select_id(depsgraph, region, v3d);
+  }
+
+  if (select_ctx->index_drawn_len <= 1) {
+    GPU_framebuffer_restore();
+    DRW_gpu_context_disable();
     return nullptr;
   }
 
-  BLI_assert(select_ctx->index_drawn_len > 0);
   const uint bitmap_len = select_ctx->index_drawn_len - 1;
+  const int2 rect_min(rect->xmin, rect->ymin);
+  const int2 rect_size(BLI_rcti_size_x(rect), BLI_rcti_size_y(rect));
+
+  GPUTexture *select_id_tx = DRW_engine_select_texture_get();
+  BLI_assert(region->winx == GPU_texture_width(select_id_tx) &&
+             region->winy == GPU_texture_height(select_id_tx));
+
+  /* The select texture is attached to the select frame-buffer. */
+  GPU_framebuffer_restore();
+
+  GPUStorageBuf *bitmap_ssbo = GPU_storagebuf_create_ex(
+      BLI_BITMAP_SIZE(bitmap_len), nullptr, GPU_USAGE_DEVICE_ONLY, "select_bitmap");
+  GPU_storagebuf_clear_to_zero(bitmap_ssbo);
+  GPUStorageBuf *mask_ssbo = nullptr;
+  if (mask) {
+    mask_ssbo = GPU_storagebuf_create_ex(BLI_BITMAP_SIZE(rect_size.x * rect_size.y),
+                                         mask,
+                                         GPU_USAGE_STATIC,
+                                         "select_bitmap_mask");
+  }
+
+  GPUShader *shader = DRW_engine_select_bitmap_shader_get(mask != nullptr);
+  GPU_shader_bind(shader);
+  GPU_shader_uniform_2iv(shader, "rect_min", rect_min);
+  GPU_shader_uniform_2iv(shader, "rect_size", rect_size);
+  GPU_shader_uniform_1i(shader, "circle_radius", circle_radius);
+  GPU_shader_uniform_1i(shader, "bitmap_len", int(bitmap_len));
+  GPU_texture_bind(select_id_tx, GPU_shader_get_sampler_binding(shader, "select_id_tx"));
+  GPU_storagebuf_bind(bitmap_ssbo, GPU_shader_get_ssbo_binding(shader, "out_bitmap_buf"));
+  if (mask_ssbo) {
+    GPU_storagebuf_bind(mask_ssbo, GPU_shader_get_ssbo_binding(shader, "mask_buf"));
+  }
+
+  GPU_compute_dispatch(shader,
+                       divide_ceil_u(rect_size.x, SELECT_BITMAP_GROUP_SIZE),
+                       divide_ceil_u(rect_size.y, SELECT_BITMAP_GROUP_SIZE),
+                       1);
+  GPU_memory_barrier(GPU_BARRIER_BUFFER_UPDATE);
 
   BLI_bitmap *bitmap_buf = BLI_BITMAP_NEW(bitmap_len, __func__);
-  const uint *buf_iter = buf;
-  while (buf_len--) {
-    const uint index = *buf_iter - 1;
-    if (index < bitmap_len) {
-      BLI_BITMAP_ENABLE(bitmap_buf, index);
-    }
-    buf_iter++;
+  GPU_storagebuf_read(bitmap_ssbo, bitmap_buf);
+
+  GPU_shader_unbind();
+  GPU_texture_unbind(select_id_tx);
+  GPU_storagebuf_free(bitmap_ssbo);
+  if (mask_ssbo) {
+    GPU_storagebuf_free(mask_ssbo);
   }
-  MEM_freeN((void *)buf);
+
+  DRW_gpu_context_disable();
 
   if (r_bitmap_len) {
     *r_bitmap_len = bitmap_len;
@@ -166,6 +236,17 @@ uint *DRW_select_buffer_bitmap_from_rect(
   return bitmap_buf;
 }
 
+uint *DRW_select_buffer_bitmap_from_rect(
+    Depsgraph *depsgraph, ARegion *region, View3D *v3d, const rcti *rect, uint *r_bitmap_len)
+{
+  rcti rect_px = *rect;
+  rect_px.xmax += 1;
+  rect_px.ymax += 1;
+
+  return select_buffer_bitmap_from_region(
+      depsgraph, region, v3d, &rect_px, -1, nullptr, r_bitmap_len);
+}
+
 uint *DRW_select_buffer_bitmap_from_circle(Depsgraph *depsgraph,
                                            ARegion *region,
                                            View3D *v3d,
@@ -173,44 +254,14 @@ uint *DRW_select_buffer_bitmap_from_circle(Depsgraph *depsgraph,
                                            const int radius,
                                            uint *r_bitmap_len)
 {
-  SELECTID_Context *select_ctx = DRW_select_engine_context_get();
-
   rcti rect{};
   rect.xmin = center[0] - radius;
   rect.xmax = center[0] + radius + 1;
   rect.ymin = center[1] - radius;
   rect.ymax = center[1] + radius + 1;
 
-  const uint *buf = DRW_select_buffer_read(depsgraph, region, v3d, &rect, nullptr);
-
-  if (buf == nullptr) {
-    return nullptr;
-  }
-
-  BLI_assert(select_ctx->index_drawn_len > 0);
-  const uint bitmap_len = select_ctx->index_drawn_len - 1;
-
-  BLI_bitmap *bitmap_buf = BLI_BITMAP_NEW(bitmap_len, __func__);
-  const uint *buf_iter = buf;
-  const int radius_sq = radius * radius;
-  for (int yc = -radius; yc <= radius; yc++) {
-    for (int xc = -radius; xc <= radius; xc++, buf_iter++) {
-      if (xc * xc + yc * yc < radius_sq) {
-        /* Intentionally wrap to max value if this is zero. */
-        const uint index = *buf_iter - 1;
-        if (index < bitmap_len) {
-          BLI_BITMAP_ENABLE(bitmap_buf, index);
-        }
-      }
-    }
-  }
-  MEM_freeN((void *)buf);
-
-  if (r_bitmap_len) {
-    *r_bitmap_len = bitmap_len;
-  }
-
-  return bitmap_buf;
+  return select_buffer_bitmap_from_region(
+      depsgraph, region, v3d, &rect, radius, nullptr, r_bitmap_len);
 }
 
 struct PolyMaskData {
@@ -236,19 +287,12 @@ uint *DRW_select_buffer_bitmap_from_poly(Depsgraph *depsgraph,
                                          const rcti *rect,
                                          uint *r_bitmap_len)
 {
-  SELECTID_Context *select_ctx = DRW_select_engine_context_get();
-
   rcti rect_px = *rect;
   rect_px.xmax += 1;
   rect_px.ymax += 1;
 
-  uint buf_len;
-  uint *buf = DRW_select_buffer_read(depsgraph, region, v3d, &rect_px, &buf_len);
-  if (buf == nullptr) {
-    return nullptr;
-  }
-
-  BLI_bitmap *buf_mask = BLI_BITMAP_NEW(buf_len, __func__);
+  const int mask_len = BLI_rcti_size_x(&rect_px) * BLI_rcti_size_y(&rect_px);
+  BLI_bitmap *buf_mask = BLI_BITMAP_NEW(mask_len, __func__);
 
   PolyMaskData poly_mask_data;
   poly_mask_data.px = buf_mask;
@@ -262,27 +306,10 @@ uint *DRW_select_buffer_bitmap_from_poly(Depsgraph *depsgraph,
                                 drw_select_mask_px_cb,
                                 &poly_mask_data);
 
-  BLI_assert(select_ctx->index_drawn_len > 0);
-  const uint bitmap_len = select_ctx->index_drawn_len - 1;
-
-  BLI_bitmap *bitmap_buf = BLI_BITMAP_NEW(bitmap_len, __func__);
-  const uint *buf_iter = buf;
-  int i = 0;
-  while (buf_len--) {
-    const uint index = *buf_iter - 1;
-    if (index < bitmap_len && BLI_BITMAP_TEST(buf_mask, i)) {
-      BLI_BITMAP_ENABLE(bitmap_buf, index);
-    }
-    buf_iter++;
-    i++;
-  }
-  MEM_freeN((void *)buf);
+  uint *bitmap_buf = select_buffer_bitmap_from_region(
+      depsgraph, region, v3d, &rect_px, -1, buf_mask, r_bitmap_len);
   MEM_freeN(buf_mask);
 
-  if (r_bitmap_len) {
-    *r_bitmap_len = bitmap_len;
-  }
-
   return bitmap_buf;
 }
 
@@ -43,6 +43,9 @@ class View {
   UniformArrayBuffer<ViewCullingData, DRW_VIEW_MAX> culling_freeze_;
   /** Result of the visibility computation. 1 bit or 1 or 2 word per resource ID per view. */
   VisibilityBuf visibility_buf_;
+  /** Depth pyramid of the occluders used by the visibility computation. Not owned. */
+  GPUTexture *occlusion_hiz_tx_ = nullptr;
+  float2 occlusion_uv_scale_ = float2(1.0f);
 
   const char *debug_name_;
 
@@ -79,6 +82,20 @@ class View {
     do_visibility_ = enable;
   }
 
+  /**
+   * Also cull the resources that are completely behind the occluders stored in \a hiz_tx, a
+   * max depth pyramid rendered from this view. \a uv_scale is the ratio between the rendered
+   * area and the texture size. Pass nullptr to disable. Only supported for single views.
+   * The depth has to match the current state of the view, as visibility is recomputed on each
+   * submission.
+   */
+  void occlusion_test_set(GPUTexture *hiz_tx, float2 uv_scale = float2(1.0f))
+  {
+    BLI_assert(hiz_tx == nullptr || view_len_ == 1);
+    occlusion_hiz_tx_ = hiz_tx;
+    occlusion_uv_scale_ = uv_scale;
+  }
+
   /**
    * Update culling data using a compute shader.
    * This is to be used if the matrices were updated externally
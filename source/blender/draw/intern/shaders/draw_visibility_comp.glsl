@@ -6,6 +6,8 @@
  * Compute visibility of each resource bounds for a given view.
  */
 /* TODO(fclem): This could be augmented by a 2 pass occlusion culling system. */
+/* With DRW_VISIBILITY_OCCLUSION, the bounds are also tested against a depth pyramid of the
+ * occluders that were already rendered (max depth per texel). */
 
 #pragma BLENDER_REQUIRE(common_view_lib.glsl)
 #pragma BLENDER_REQUIRE(common_math_lib.glsl)
@@ -24,6 +26,56 @@ void mask_visibility_bit(uint view_id)
   }
 }
 
+#ifdef DRW_VISIBILITY_OCCLUSION
+/**
+ * Return true if the box is behind the depth stored in the HiZ buffer for all the pixels it
+ * covers.
+ * Conservative: any box crossing the near plane or covering too many texels is considered visible.
+ */
+bool is_occluded(IsectBox box)
+{
+  mat4 persmat = drw_view.winmat * drw_view.viewmat;
+  vec2 ndc_min = vec2(1e30);
+  vec2 ndc_max = vec2(-1e30);
+  float depth_min = 1.0;
+  for (int i = 0; i < 8; i++) {
+    vec4 hs_corner = persmat * vec4(box.corners[i], 1.0);
+    if (hs_corner.w <= 0.0) {
+      return false;
+    }
+    vec3 ndc_corner = hs_corner.xyz / hs_corner.w;
+    ndc_min = min(ndc_min, ndc_corner.xy);
+    ndc_max = max(ndc_max, ndc_corner.xy);
+    depth_min = min(depth_min, ndc_corner.z * 0.5 + 0.5);
+  }
+  if (depth_min <= 0.0) {
+    return false;
+  }
+  /* The HiZ buffer can be bigger than the render extent. */
+  vec2 hiz_extent = vec2(textureSize(hiz_tx, 0)) * hiz_uv_scale;
+  vec2 texel_min = saturate(ndc_min * 0.5 + 0.5) * hiz_extent;
+  vec2 texel_max = saturate(ndc_max * 0.5 + 0.5) * hiz_extent;
+  /* Choose the mip level where the box covers at most 2x2 texels. */
+  float extent = max(texel_max.x - texel_min.x, texel_max.y - texel_min.y);
+  int lod = clamp(int(ceil(log2(max(extent, 1.0)))), 0, hiz_lod_max);
+  ivec2 lod_texel_min = ivec2(texel_min) >> lod;
+  ivec2 lod_texel_max = ivec2(texel_max) >> lod;
+  if (any(greaterThan(lod_texel_max - lod_texel_min, ivec2(1)))) {
+    /* Clamped to the last mip level, too big to test. */
+    return false;
+  }
+  ivec2 lod_extent_max = textureSize(hiz_tx, lod) - 1;
+  lod_texel_max = min(lod_texel_max, lod_extent_max);
+  vec4 samp;
+  samp.x = texelFetch(hiz_tx, lod_texel_min, lod).r;
+  samp.y = texelFetch(hiz_tx, ivec2(lod_texel_max.x, lod_texel_min.y), lod).r;
+  samp.z = texelFetch(hiz_tx, ivec2(lod_texel_min.x, lod_texel_max.y), lod).r;
+  samp.w = texelFetch(hiz_tx, lod_texel_max, lod).r;
+  float occluder_depth = max_v4(samp);
+  return depth_min > occluder_depth;
+}
+#endif
+
 void main()
 {
   if (int(gl_GlobalInvocationID.x) >= resource_len) {
@@ -46,17 +98,18 @@ void main()
         /* View disabled. */
         mask_visibility_bit(drw_view_id);
       }
-      else if (intersect_view(inscribed_sphere) == true) {
-        /* Visible. */
-      }
-      else if (intersect_view(bounding_sphere) == false) {
+      else if (intersect_view(inscribed_sphere) == false &&
+               (intersect_view(bounding_sphere) == false || intersect_view(box) == false))
+      {
         /* Not visible. */
         mask_visibility_bit(drw_view_id);
       }
-      else if (intersect_view(box) == false) {
-        /* Not visible. */
+#ifdef DRW_VISIBILITY_OCCLUSION
+      else if (is_occluded(box)) {
+        /* Hidden behind the occluders. */
         mask_visibility_bit(drw_view_id);
       }
+#endif
     }
   }
   else {
@@ -8,12 +8,15 @@
 
 #include "MEM_guardedalloc.h"
 
+#include <algorithm>
 #include <cstdlib>
 
+#include "BLI_array.hh"
 #include "BLI_dlrbTree.h"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_matrix.hh"
+#include "BLI_threads.h"
 
 #include "DNA_anim_types.h"
 #include "DNA_armature_types.h"
@@ -21,11 +24,13 @@
 
 #include "BKE_action.h"
 #include "BKE_anim_data.hh"
+#include "BKE_callbacks.hh"
 #include "BKE_main.hh"
 #include "BKE_scene.hh"
 
 #include "DEG_depsgraph.hh"
 #include "DEG_depsgraph_build.hh"
+#include "DEG_depsgraph_frame_parallel.hh"
 #include "DEG_depsgraph_query.hh"
 
 #include "GPU_batch.hh"
@@ -38,6 +43,10 @@
 
 #include "CLG_log.h"
 
+#ifdef WITH_PYTHON
+#  include "BPY_extern.h"
+#endif
+
 static CLG_LogRef LOG = {"ed.anim.motion_paths"};
 
 /* Motion path needing to be baked (mpt) */
@@ -65,10 +74,11 @@ static void motionpaths_calc_update_scene(Depsgraph *depsgraph)
   BKE_scene_graph_update_for_newframe(depsgraph);
 }
 
-Depsgraph *animviz_depsgraph_build(Main *bmain,
-                                   Scene *scene,
-                                   ViewLayer *view_layer,
-                                   ListBase *targets)
+/* Build a depsgraph which only contains the targets and their dependencies. */
+static Depsgraph *motionpaths_depsgraph_new(Main *bmain,
+                                           Scene *scene,
+                                           ViewLayer *view_layer,
+                                           ListBase *targets)
 {
   /* Allocate dependency graph. */
   Depsgraph *depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
@@ -85,6 +95,15 @@ Depsgraph *animviz_depsgraph_build(Main *bmain,
 
   /* Build graph from all requested IDs. */
   DEG_graph_build_from_ids(depsgraph, ids);
+  return depsgraph;
+}
+
+Depsgraph *animviz_depsgraph_build(Main *bmain,
+                                   Scene *scene,
+                                   ViewLayer *view_layer,
+                                   ListBase *targets)
+{
+  Depsgraph *depsgraph = motionpaths_depsgraph_new(bmain, scene, view_layer, targets);
 
   /* Update once so we can access pointers of evaluated animation data. */
   motionpaths_calc_update_scene(depsgraph);
@@ -147,7 +166,8 @@ static void motionpaths_calc_bake_targets(ListBase *targets,
     /* get the relevant cache vert to write to */
     bMotionPathVert *mpv = mpath->points + (cframe - mpath->start_frame);
 
-    Object *ob_eval = mpt->ob_eval;
+    /* Not #MPathTarget.ob_eval, frames may be evaluated in other depsgraphs. */
+    Object *ob_eval = DEG_get_evaluated_object(depsgraph, mpt->ob);
 
     /* Lookup evaluated pose channel, here because the depsgraph
      * evaluation can change them so they are not cached in mpt. */
@@ -395,6 +415,61 @@ void animviz_motionpath_compute_range(Object *ob, Scene *scene)
   ED_keylist_free(keylist);
 }
 
+/**
+ * Calculate the paths over the range with several copies of the temporary \a depsgraph, which
+ * evaluate frames at the same time. Returns false when the frames have to be evaluated one after
+ * another in \a depsgraph instead.
+ */
+static bool motionpaths_calc_frames_parallel(Depsgraph *depsgraph,
+                                             Scene *scene,
+                                             ListBase *targets,
+                                             const int sfra,
+                                             const int efra)
+{
+  using namespace blender;
+  /* Every depsgraph evaluates all targets for its first frame, so only use more of them for
+   * longer ranges. */
+  const int frames_num = efra - sfra + 1;
+  const int graphs_num = std::min(std::clamp(BLI_system_thread_count() / 2, 1, 4),
+                                  frames_num / 8);
+  if (graphs_num < 2) {
+    return false;
+  }
+#ifdef WITH_PYTHON
+  /* Handlers may change the scene on every frame, they need the frames in order. */
+  if (BPY_app_handlers_has(BKE_CB_EVT_FRAME_CHANGE_PRE) ||
+      BPY_app_handlers_has(BKE_CB_EVT_FRAME_CHANGE_POST))
+  {
+    return false;
+  }
+#endif
+  if (!DEG_frame_parallel_evaluation_supported(depsgraph)) {
+    return false;
+  }
+
+  Main *bmain = DEG_get_bmain(depsgraph);
+  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
+  Array<Depsgraph *> graphs(graphs_num);
+  graphs[0] = depsgraph;
+  for (const int i : graphs.index_range().drop_front(1)) {
+    graphs[i] = motionpaths_depsgraph_new(bmain, scene, view_layer, targets);
+  }
+
+  Array<float> frames(frames_num);
+  for (const int i : frames.index_range()) {
+    frames[i] = float(sfra + i);
+  }
+  DEG_evaluate_frames_parallel(graphs, frames, [&](Depsgraph *graph, const float frame) {
+    motionpaths_calc_bake_targets(targets, int(frame), graph, scene->camera);
+    return true;
+  });
+
+  for (Depsgraph *graph : graphs.as_span().drop_front(1)) {
+    DEG_graph_free(graph);
+  }
+  return true;
+}
+
 void animviz_calc_motionpaths(Depsgraph *depsgraph,
                               Main *bmain,
                               Scene *scene,
@@ -503,6 +578,11 @@ void animviz_calc_motionpaths(Depsgraph *depsgraph,
             sfra,
             efra,
             efra - sfra + 1);
+  /* The active depsgraph is only used for the current frame. */
+  const bool use_parallel = !is_active_depsgraph && range != ANIMVIZ_CALC_RANGE_CURRENT_FRAME;
+  if (use_parallel && motionpaths_calc_frames_parallel(depsgraph, scene, targets, sfra, efra)) {
+    sfra = efra + 1;
+  }
   for (scene->r.cfra = sfra; scene->r.cfra <= efra; scene->r.cfra++) {
     if (range == ANIMVIZ_CALC_RANGE_CURRENT_FRAME) {
       /* For current frame, only update tagged. */
@@ -115,6 +115,15 @@ struct FileIndexerType {
    * next time that read_index is called it will read the entries from the index.
    */
   FileIndexerUpdateIndexFunc update_index;
+
+  /**
+   * The index always contains all data-blocks of a blend file, so it can also be used when only
+   * the groups, or the data-blocks of a single group, are listed (e.g. when linking or appending).
+   * Entries that are not part of the listing are skipped.
+   *
+   * When not set, the index is only used when all data-blocks of a file are listed.
+   */
+  bool use_for_partial_listing;
 };
 
 /* `file_indexer.cc` */
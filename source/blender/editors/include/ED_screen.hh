@@ -506,6 +506,16 @@ int ED_screen_animation_play(bContext *C, int sync, int mode);
  */
 bScreen *ED_screen_animation_playing(const wmWindowManager *wm);
 bScreen *ED_screen_animation_no_scrub(const wmWindowManager *wm);
+/**
+ * Wait for the frame which is evaluated in the background during animation playback (see
+ * #UserDef_Experimental.use_background_playback_evaluation). Must be called before original
+ * data-blocks are modified or depsgraphs are tagged while the animation is playing.
+ */
+void ED_screen_animation_background_evaluation_wait();
+/**
+ * Free the depsgraph used for background evaluation during animation playback.
+ */
+void ED_screen_animation_background_evaluation_free();
 
 /* screen keymaps */
 /* called in `spacetypes.cc`. */
@@ -449,6 +449,7 @@ static int edbm_delete_exec(bContext *C, wmOperator *op)
   for (Object *obedit : objects) {
     BMEditMesh *em = BKE_editmesh_from_object(obedit);
     const int type = RNA_enum_get(op->ptr, "type");
+    const int totelem_prev = em->bm->totvert + em->bm->totedge + em->bm->totloop;
 
     switch (type) {
       case MESH_DELETE_VERT: /* Erase Vertices */
@@ -508,6 +509,12 @@ static int edbm_delete_exec(bContext *C, wmOperator *op)
 
     BM_custom_loop_normals_from_vector_layer(em->bm, false);
 
+    /* Deleting most of the mesh leaves the remaining elements scattered in mostly unused memory,
+     * move them together to speed up further editing. */
+    if (em->bm->totvert + em->bm->totedge + em->bm->totloop < totelem_prev / 2) {
+      BM_mesh_compact(em->bm);
+    }
+
     EDBMUpdate_Params params{};
     params.calc_looptris = true;
     params.calc_normals = false;
@@ -1657,6 +1657,7 @@ void EDBM_update(Mesh *mesh, const EDBMUpdate_Params *params)
   BMEditMesh *em = mesh->runtime->edit_mesh.get();
   /* Order of calling isn't important. */
   DEG_id_tag_update(&mesh->id, ID_RECALC_GEOMETRY);
+  em->is_positions_only_update = false;
   WM_main_add_notifier(NC_GEOM | ND_DATA, &mesh->id);
 
   if (params->calc_normals && params->calc_looptris) {
@@ -1342,7 +1342,7 @@ void constraint_dependency_update(Main *bmain, Object *ob)
   if (ob->pose) {
     object_pose_tag_update(bmain, ob);
   }
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, &ob->id);
 }
 
 void constraint_tag_update(Main *bmain, Object *ob, bConstraint *con)
@@ -1375,7 +1375,7 @@ void constraint_dependency_tag_update(Main *bmain, Object *ob, bConstraint *con)
   if (ob->pose) {
     object_pose_tag_update(bmain, ob);
   }
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, &ob->id);
 }
 
 bool constraint_move_to_index(Object *ob, bConstraint *con, const int index)
@@ -1450,7 +1450,7 @@ static int constraint_delete_exec(bContext *C, wmOperator *op)
     constraint_update(bmain, ob);
 
     /* relations */
-    DEG_relations_tag_update(bmain);
+    DEG_id_relations_tag_update(bmain, &ob->id);
 
     /* notifiers */
     WM_event_add_notifier(C, NC_OBJECT | ND_CONSTRAINT | NA_REMOVED, ob);
@@ -1539,7 +1539,7 @@ static int constraint_apply_exec(bContext *C, wmOperator *op)
   /* Needed to set the flags on pose-bones correctly. */
   constraint_update(bmain, ob);
 
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, &ob->id);
   WM_event_add_notifier(C, NC_OBJECT | ND_CONSTRAINT | NA_REMOVED, ob);
   if (pchan) {
     WM_event_add_notifier(C, NC_OBJECT | ND_POSE, ob);
@@ -1639,7 +1639,7 @@ static int constraint_copy_exec(bContext *C, wmOperator *op)
   /* Needed to set the flags on pose-bones correctly. */
   constraint_update(bmain, ob);
 
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, &ob->id);
   WM_event_add_notifier(C, NC_OBJECT | ND_CONSTRAINT | NA_ADDED, ob);
 
   if (RNA_boolean_get(op->ptr, "report")) {
@@ -252,7 +252,7 @@ ModifierData *modifier_add(
   BKE_object_modifier_set_active(ob, new_md);
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, &ob->id);
 
   return new_md;
 }
@@ -407,7 +407,7 @@ bool modifier_remove(ReportList *reports, Main *bmain, Scene *scene, Object *ob,
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, &ob->id);
 
   return true;
 }
@@ -430,7 +430,7 @@ void modifiers_clear(Main *bmain, Scene *scene, Object *ob)
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, &ob->id);
 }
 
 static bool object_modifier_check_move_before(ReportList *reports,
@@ -584,7 +584,7 @@ void modifier_link(bContext *C, Object *ob_dst, Object *ob_src)
   DEG_id_tag_update(&ob_dst->id, ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_ANIMATION);
 
   Main *bmain = CTX_data_main(C);
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, &ob_dst->id);
 }
 
 bool modifier_copy_to_object(Main *bmain,
@@ -629,7 +629,7 @@ bool modifier_copy_to_object(Main *bmain,
 
   WM_main_add_notifier(NC_OBJECT | ND_MODIFIER, ob_dst);
   DEG_id_tag_update(&ob_dst->id, ID_RECALC_GEOMETRY | ID_RECALC_ANIMATION);
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, &ob_dst->id);
   return true;
 }
 
@@ -1763,6 +1763,7 @@ void ED_screen_animation_timer(bContext *C, int redraws, int sync, int enable)
     WM_event_timer_remove(wm, win, stopscreen->animtimer);
     stopscreen->animtimer = nullptr;
   }
+  ED_screen_animation_background_evaluation_free();
 
   if (enable) {
     ScreenAnimData *sad = static_cast<ScreenAnimData *>(
@@ -1851,12 +1852,8 @@ void ED_screen_animation_timer_update(bScreen *screen, int redraws)
   }
 }
 
-void ED_update_for_newframe(Main *bmain, Depsgraph *depsgraph)
+void screen_scene_camera_switch_update(Main *bmain, Scene *scene)
 {
-  Scene *scene = DEG_get_input_scene(depsgraph);
-
-  DEG_time_tag_update(bmain);
-
 #ifdef DURIAN_CAMERA_SWITCH
   void *camera = BKE_scene_camera_switch_find(scene);
   if (camera && scene->camera != camera) {
@@ -1867,7 +1864,22 @@ void ED_update_for_newframe(Main *bmain, Depsgraph *depsgraph)
     }
     DEG_id_tag_update(&scene->id, ID_RECALC_SYNC_TO_EVAL);
   }
+#else
+  UNUSED_VARS(bmain, scene);
 #endif
+}
+
+void ED_update_for_newframe(Main *bmain, Depsgraph *depsgraph)
+{
+  Scene *scene = DEG_get_input_scene(depsgraph);
+
+  /* The depsgraphs of the main database can not be tagged while a frame is evaluated in the
+   * background. */
+  ED_screen_animation_background_evaluation_wait();
+
+  DEG_time_tag_update(bmain);
+
+  screen_scene_camera_switch_update(bmain, scene);
 
   ED_clip_update_frame(bmain, scene->r.cfra);
 
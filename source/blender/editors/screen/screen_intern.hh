@@ -15,8 +15,10 @@ struct AZone;
 struct bContext;
 struct bContextDataResult;
 struct bScreen;
+struct Depsgraph;
 struct Main;
 struct rcti;
+struct Scene;
 struct ScrAreaMap;
 struct ScrEdge;
 struct ScrVert;
@@ -105,6 +107,10 @@ void screen_data_copy(bScreen *to, bScreen *from);
  */
 void screen_new_activate_prepare(const wmWindow *win, bScreen *screen_new);
 void screen_change_update(bContext *C, wmWindow *win, bScreen *screen);
+/**
+ * Switch the scene camera to the camera bound to the markers of the current frame.
+ */
+void screen_scene_camera_switch_update(Main *bmain, Scene *scene);
 /**
  * \return the screen to activate.
  * \warning The returned screen may not always equal \a screen_new!
@@ -182,6 +188,24 @@ short screen_geom_find_area_split_point(const ScrArea *area,
  */
 void screen_geom_select_connected_edge(const wmWindow *win, ScrEdge *edge);
 
+/* `screen_playback_evaluation.cc` */
+
+/**
+ * Animation playback step which evaluates the next frame in a background thread, while the state
+ * of \a displayed_frame is drawn. The scene frame must be set to the frame that playback steps
+ * to, it is set to the frame of the state that is displayed after the step.
+ *
+ * \param jumped: The playback jumped to another frame, which is evaluated immediately.
+ * \param r_frame_changed: Set to whether another frame is displayed after the step.
+ * \return false when background evaluation is not used for this step, the caller is responsible
+ * for the evaluation of the new frame then.
+ */
+bool screen_animation_background_evaluation_step(bContext *C,
+                                                 Depsgraph *depsgraph,
+                                                 int displayed_frame,
+                                                 bool jumped,
+                                                 bool *r_frame_changed);
+
 /* `screen_context.cc` */
 
 /**
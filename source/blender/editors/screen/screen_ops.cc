@@ -5221,6 +5221,7 @@ static int screen_animation_step_invoke(bContext *C, wmOperator * /*op*/, const
   Scene *scene_eval = (depsgraph != nullptr) ? DEG_get_evaluated_scene(depsgraph) : nullptr;
   ScreenAnimData *sad = static_cast<ScreenAnimData *>(wt->customdata);
   wmWindowManager *wm = CTX_wm_manager(C);
+  const int displayed_frame = scene->r.cfra;
   int sync;
   double time;
 
@@ -5353,7 +5354,9 @@ static int screen_animation_step_invoke(bContext *C, wmOperator * /*op*/, const
     sad->flag |= ANIMPLAY_FLAG_JUMPED;
   }
 
-  if (sad->flag & ANIMPLAY_FLAG_JUMPED) {
+  const bool jumped = (sad->flag & ANIMPLAY_FLAG_JUMPED) != 0;
+  if (jumped) {
+    ED_screen_animation_background_evaluation_wait();
     DEG_id_tag_update(&scene->id, ID_RECALC_FRAME_CHANGE);
 #ifdef PROFILE_AUDIO_SYNCH
     old_frame = scene->r.cfra;
@@ -5361,36 +5364,44 @@ static int screen_animation_step_invoke(bContext *C, wmOperator * /*op*/, const
   }
 
   /* Since we follow draw-flags, we can't send notifier but tag regions ourselves. */
+  bool frame_changed = true;
   if (depsgraph != nullptr) {
-    ED_update_for_newframe(bmain, depsgraph);
+    if (!screen_animation_background_evaluation_step(
+            C, depsgraph, displayed_frame, jumped, &frame_changed))
+    {
+      ED_update_for_newframe(bmain, depsgraph);
+    }
   }
 
-  LISTBASE_FOREACH (wmWindow *, window, &wm->windows) {
-    const bScreen *win_screen = WM_window_get_active_screen(window);
+  /* Without a frame change, the next frame is still being evaluated in the background. */
+  if (frame_changed) {
+    LISTBASE_FOREACH (wmWindow *, window, &wm->windows) {
+      const bScreen *win_screen = WM_window_get_active_screen(window);
 
-    LISTBASE_FOREACH (ScrArea *, area, &win_screen->areabase) {
-      LISTBASE_FOREACH (ARegion *, region, &area->regionbase) {
-        bool redraw = false;
-        if (region == sad->region) {
-          redraw = true;
-        }
-        else if (match_region_with_redraws(area,
-                                           eRegion_Type(region->regiontype),
-                                           eScreen_Redraws_Flag(sad->redraws),
-                                           sad->from_anim_edit))
-        {
-          redraw = true;
-        }
+      LISTBASE_FOREACH (ScrArea *, area, &win_screen->areabase) {
+        LISTBASE_FOREACH (ARegion *, region, &area->regionbase) {
+          bool redraw = false;
+          if (region == sad->region) {
+            redraw = true;
+          }
+          else if (match_region_with_redraws(area,
+                                             eRegion_Type(region->regiontype),
+                                             eScreen_Redraws_Flag(sad->redraws),
+                                             sad->from_anim_edit))
+          {
+            redraw = true;
+          }
 
-        if (redraw) {
-          screen_animation_region_tag_redraw(
-              C, area, region, scene, eScreen_Redraws_Flag(sad->redraws));
+          if (redraw) {
+            screen_animation_region_tag_redraw(
+                C, area, region, scene, eScreen_Redraws_Flag(sad->redraws));
+          }
         }
       }
     }
   }
 
-  if (U.uiflag & USER_SHOW_FPS) {
+  if ((U.uiflag & USER_SHOW_FPS) && frame_changed) {
     /* Update frame rate info too.
      * NOTE: this may not be accurate enough, since we might need this after modifiers/etc.
      * have been calculated instead of just before updates have been done? */
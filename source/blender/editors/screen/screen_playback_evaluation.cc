@@ -0,0 +1,277 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup edscr
+ *
+ * Evaluation of the next frame of the animation playback in a background thread.
+ *
+ * A second depsgraph is built for the view layer. While the depsgraph of the view layer is drawn,
+ * the next frame is evaluated in the second depsgraph. Once that evaluation is finished, the two
+ * depsgraphs are swapped, so the evaluation of a frame and the drawing of the previous frame
+ * overlap. The background depsgraph is not active while it is evaluated, so it does not write to
+ * the original data-blocks, and the state that is written back by active depsgraphs is synced on
+ * the main thread when depsgraphs are swapped.
+ *
+ * Original data-blocks must not be modified and depsgraphs must not be tagged while a frame is
+ * evaluated, so the window manager waits for the evaluation before handling any other event.
+ */
+
+#include <atomic>
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
+
+#include "BLI_string.h"
+#include "BLI_task.h"
+
+#include "BKE_animsys.h"
+#include "BKE_callbacks.hh"
+#include "BKE_context.hh"
+#include "BKE_global.hh"
+#include "BKE_image.h"
+#include "BKE_layer.hh"
+#include "BKE_object.hh"
+#include "BKE_scene.hh"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
+#include "DEG_depsgraph_debug.hh"
+#include "DEG_depsgraph_frame_parallel.hh"
+#include "DEG_depsgraph_query.hh"
+
+#include "ED_clip.hh"
+#include "ED_screen.hh"
+
+#include "screen_intern.hh"
+
+struct PlaybackEvaluation {
+  Scene *scene;
+  ViewLayer *view_layer;
+  /** Depsgraph which is evaluated in the background, not stored in the scene. */
+  Depsgraph *depsgraph;
+  /** Frame which is (being) evaluated in #depsgraph. */
+  int frame;
+  /** Runs the evaluation, null when no frame is evaluated. */
+  TaskPool *task_pool;
+  /** Set from the evaluation thread once #frame is evaluated. */
+  std::atomic<bool> is_evaluated;
+  /** The evaluated state of #depsgraph can be displayed. */
+  bool has_result;
+};
+
+/** Only accessed from the main thread. */
+static PlaybackEvaluation *playback_evaluation = nullptr;
+
+static PlaybackEvaluation *playback_evaluation_new(Main *bmain,
+                                                   Scene *scene,
+                                                   ViewLayer *view_layer)
+{
+  PlaybackEvaluation *evaluation = MEM_new<PlaybackEvaluation>(__func__);
+  evaluation->scene = scene;
+  evaluation->view_layer = view_layer;
+  evaluation->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
+  evaluation->frame = 0;
+  evaluation->task_pool = nullptr;
+  evaluation->is_evaluated = false;
+  evaluation->has_result = false;
+
+  /* Same as the depsgraphs of the scene, it becomes one of them when swapped. */
+  char name[1024];
+  SNPRINTF(name, "%s :: %s", scene->id.name, view_layer->name);
+  DEG_debug_name_set(evaluation->depsgraph, name);
+  DEG_enable_editors_update(evaluation->depsgraph);
+  DEG_graph_build_from_view_layer(evaluation->depsgraph);
+  return evaluation;
+}
+
+static void playback_evaluation_wait(PlaybackEvaluation &evaluation)
+{
+  if (evaluation.task_pool == nullptr) {
+    return;
+  }
+  BLI_task_pool_work_and_wait(evaluation.task_pool);
+  BLI_task_pool_free(evaluation.task_pool);
+  evaluation.task_pool = nullptr;
+  evaluation.has_result = true;
+}
+
+static void playback_evaluation_task(TaskPool *__restrict pool, void * /*taskdata*/)
+{
+  PlaybackEvaluation *evaluation = static_cast<PlaybackEvaluation *>(
+      BLI_task_pool_user_data(pool));
+  DEG_evaluate_on_framechange(
+      evaluation->depsgraph, float(evaluation->frame), DEG_EVALUATE_SYNC_WRITEBACK_NO);
+  evaluation->is_evaluated = true;
+}
+
+static bool playback_evaluation_supported(const Scene *scene,
+                                          ViewLayer *view_layer,
+                                          const Depsgraph *depsgraph)
+{
+  if (!U.experimental.use_background_playback_evaluation || G.is_rendering) {
+    return false;
+  }
+  /* Drawing in edit, sculpt and paint modes uses and modifies original data. */
+  BKE_view_layer_synced_ensure(scene, view_layer);
+  const Object *obact = BKE_view_layer_active_object_get(view_layer);
+  if (obact != nullptr && obact->mode != OB_MODE_OBJECT) {
+    return false;
+  }
+  /* Same requirements as evaluation of several frames at once: the evaluated state of a frame can
+   * not depend on the previous frames, and evaluation can not modify shared data. */
+  return DEG_frame_parallel_evaluation_supported(depsgraph);
+}
+
+/**
+ * Start the evaluation of \a frame, called from the main thread. Everything that is done for a
+ * frame change outside of the depsgraph evaluation is done here already.
+ */
+static void playback_evaluation_start(Main *bmain, PlaybackEvaluation &evaluation, const int frame)
+{
+  BLI_assert(evaluation.task_pool == nullptr);
+  Scene *scene = evaluation.scene;
+
+  const int displayed_frame = scene->r.cfra;
+  scene->r.cfra = frame;
+  BKE_callback_exec_id(bmain, &scene->id, BKE_CB_EVT_FRAME_CHANGE_PRE);
+  screen_scene_camera_switch_update(bmain, scene);
+  ED_clip_update_frame(bmain, frame);
+  BKE_image_editors_update_frame(bmain, frame);
+  scene->r.cfra = displayed_frame;
+
+  DEG_graph_relations_update(evaluation.depsgraph);
+
+  evaluation.frame = frame;
+  evaluation.is_evaluated = false;
+  evaluation.has_result = false;
+  evaluation.task_pool = BLI_task_pool_create_background(&evaluation, TASK_PRIORITY_HIGH);
+  BLI_task_pool_push(evaluation.task_pool, playback_evaluation_task, nullptr, false, nullptr);
+}
+
+/**
+ * Make the evaluated depsgraph the depsgraph of the view layer, and keep the one that was
+ * displayed for the evaluation of the next frame.
+ */
+static void playback_evaluation_display(Main *bmain, PlaybackEvaluation &evaluation)
+{
+  BLI_assert(evaluation.has_result);
+  Scene *scene = evaluation.scene;
+  Depsgraph *depsgraph = evaluation.depsgraph;
+
+  scene->r.cfra = evaluation.frame;
+  Depsgraph *depsgraph_displayed = BKE_scene_replace_depsgraph(
+      scene, evaluation.view_layer, depsgraph);
+  DEG_make_inactive(depsgraph_displayed);
+  DEG_make_active(depsgraph);
+  evaluation.depsgraph = depsgraph_displayed;
+  evaluation.has_result = false;
+
+  /* Write back the state that active depsgraphs write to the original data-blocks during
+   * evaluation, which is used by the interface and by operators. */
+  BKE_animsys_evaluate_all_animation(bmain, depsgraph, float(evaluation.frame));
+  DEGObjectIterSettings deg_iter_settings{};
+  deg_iter_settings.depsgraph = depsgraph;
+  deg_iter_settings.flags = DEG_ITER_OBJECT_FLAG_LINKED_DIRECTLY |
+                            DEG_ITER_OBJECT_FLAG_LINKED_INDIRECTLY |
+                            DEG_ITER_OBJECT_FLAG_LINKED_VIA_SET;
+  DEG_OBJECT_ITER_BEGIN (&deg_iter_settings, object) {
+    BKE_object_sync_to_original(depsgraph, object);
+  }
+  DEG_OBJECT_ITER_END;
+
+  BKE_scene_update_sound(depsgraph, bmain);
+  BKE_callback_exec_id_depsgraph(bmain, &scene->id, depsgraph, BKE_CB_EVT_FRAME_CHANGE_POST);
+
+  const bool is_time_update = true;
+  DEG_editors_update(depsgraph, is_time_update);
+  const bool backup = false;
+  DEG_ids_clear_recalc(depsgraph, backup);
+}
+
+bool screen_animation_background_evaluation_step(bContext *C,
+                                                 Depsgraph *depsgraph,
+                                                 const int displayed_frame,
+                                                 const bool jumped,
+                                                 bool *r_frame_changed)
+{
+  Main *bmain = CTX_data_main(C);
+  Scene *scene = DEG_get_input_scene(depsgraph);
+  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
+  *r_frame_changed = true;
+
+  if (playback_evaluation != nullptr &&
+      (playback_evaluation->scene != scene || playback_evaluation->view_layer != view_layer))
+  {
+    ED_screen_animation_background_evaluation_free();
+  }
+  if (!playback_evaluation_supported(scene, view_layer, depsgraph)) {
+    ED_screen_animation_background_evaluation_free();
+    return false;
+  }
+  if (jumped) {
+    /* The evaluated frame is not the one to display anymore. */
+    if (playback_evaluation != nullptr) {
+      playback_evaluation_wait(*playback_evaluation);
+      playback_evaluation->has_result = false;
+    }
+    return false;
+  }
+
+  const int target_frame = scene->r.cfra;
+  if (playback_evaluation == nullptr) {
+    playback_evaluation = playback_evaluation_new(bmain, scene, view_layer);
+  }
+  PlaybackEvaluation &evaluation = *playback_evaluation;
+
+  if (evaluation.task_pool != nullptr) {
+    if (!evaluation.is_evaluated) {
+      /* Keep displaying the current frame until the next one is evaluated. */
+      scene->r.cfra = displayed_frame;
+      *r_frame_changed = false;
+      return true;
+    }
+    playback_evaluation_wait(evaluation);
+  }
+
+  int frame = displayed_frame;
+  if (evaluation.has_result) {
+    frame = evaluation.frame;
+    playback_evaluation_display(bmain, evaluation);
+  }
+  else {
+    scene->r.cfra = displayed_frame;
+    *r_frame_changed = false;
+  }
+
+  /* Step as far from the newly displayed frame as the playback stepped from the previously
+   * displayed frame. Past the end of the range the playback jumps, which is evaluated in the
+   * displayed depsgraph by the next step. */
+  const int next_frame = frame + (target_frame - displayed_frame);
+  if (next_frame != frame && IN_RANGE_INCL(next_frame, PSFRA, PEFRA)) {
+    playback_evaluation_start(bmain, evaluation, next_frame);
+  }
+  return true;
+}
+
+void ED_screen_animation_background_evaluation_wait()
+{
+  if (playback_evaluation != nullptr) {
+    playback_evaluation_wait(*playback_evaluation);
+  }
+}
+
+void ED_screen_animation_background_evaluation_free()
+{
+  if (playback_evaluation == nullptr) {
+    return;
+  }
+  playback_evaluation_wait(*playback_evaluation);
+  DEG_graph_free(playback_evaluation->depsgraph);
+  MEM_delete(playback_evaluation);
+  playback_evaluation = nullptr;
+}
@@ -6771,6 +6771,18 @@ void filter_region_clip_factors(const SculptSession &ss,
   }
 }
 
+/**
+ * Squared distance of the position projected on the plane through the brush location, same as
+ * #closest_to_plane_normalized_v3 but inlined in the loops over all node vertices.
+ */
+BLI_INLINE float tube_distance_squared(const float3 &location,
+                                       const float3 &view_normal,
+                                       const float3 &position)
+{
+  const float3 offset = position - location;
+  return math::length_squared(offset - view_normal * math::dot(offset, view_normal));
+}
+
 void calc_brush_distances_squared(const SculptSession &ss,
                                   const Span<float3> positions,
                                   const Span<int> verts,
@@ -6783,12 +6795,8 @@ void calc_brush_distances_squared(const SculptSession &ss,
   if (falloff_shape == PAINT_FALLOFF_SHAPE_TUBE && (ss.cache || ss.filter_cache)) {
     /* The tube falloff shape requires the cached view normal. */
     const float3 &view_normal = ss.cache ? ss.cache->view_normal : ss.filter_cache->view_normal;
-    float4 test_plane;
-    plane_from_point_normal_v3(test_plane, test_location, view_normal);
     for (const int i : verts.index_range()) {
-      float3 projected;
-      closest_to_plane_normalized_v3(projected, test_plane, positions[verts[i]]);
-      r_distances[i] = math::distance_squared(projected, test_location);
+      r_distances[i] = tube_distance_squared(test_location, view_normal, positions[verts[i]]);
     }
   }
   else {
@@ -6821,12 +6829,8 @@ void calc_brush_distances_squared(const SculptSession &ss,
   if (falloff_shape == PAINT_FALLOFF_SHAPE_TUBE && (ss.cache || ss.filter_cache)) {
     /* The tube falloff shape requires the cached view normal. */
     const float3 &view_normal = ss.cache ? ss.cache->view_normal : ss.filter_cache->view_normal;
-    float4 test_plane;
-    plane_from_point_normal_v3(test_plane, test_location, view_normal);
     for (const int i : positions.index_range()) {
-      float3 projected;
-      closest_to_plane_normalized_v3(projected, test_plane, positions[i]);
-      r_distances[i] = math::distance_squared(projected, test_location);
+      r_distances[i] = tube_distance_squared(test_location, view_normal, positions[i]);
     }
   }
   else {
@@ -6851,10 +6855,9 @@ void filter_distances_with_radius(const float radius,
                                   const Span<float> distances,
                                   const MutableSpan<float> factors)
 {
+  /* Written without a branch so the loop is vectorized. */
   for (const int i : distances.index_range()) {
-    if (distances[i] > radius) {
-      factors[i] = 0.0f;
-    }
+    factors[i] = distances[i] > radius ? 0.0f : factors[i];
   }
 }
 
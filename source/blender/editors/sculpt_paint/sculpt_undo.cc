@@ -1686,6 +1686,41 @@ static size_t node_size_in_bytes(const Node &node)
   return size;
 }
 
+/**
+ * Only keep the vertices of position undo nodes which were actually moved. The whole node is
+ * stored when the stroke starts, because original positions are needed for all its vertices
+ * during the stroke, but most nodes touched by a dab only change a part of their vertices. The
+ * shared vertices at the end of the node aren't used after the stroke either.
+ */
+static void compact_position_node(const Span<float3> positions, Node &unode)
+{
+  if (unode.position.is_empty() || !unode.orig_position.is_empty() || !unode.mask.is_empty() ||
+      !unode.col.is_empty() || !unode.vert_hidden.is_empty() || !unode.grids.is_empty())
+  {
+    return;
+  }
+  const Span<int> verts = unode.vert_indices.as_span().take_front(unode.unique_verts_num);
+  Vector<int> changed;
+  for (const int i : verts.index_range()) {
+    /* No need for float comparison here (memory is exactly equal or not). */
+    if (memcmp(&unode.position[i], &positions[verts[i]], sizeof(float3)) != 0) {
+      changed.append(i);
+    }
+  }
+  if (changed.size() == unode.vert_indices.size()) {
+    return;
+  }
+  Array<int> vert_indices(changed.size());
+  Array<float3> position(changed.size());
+  for (const int i : changed.index_range()) {
+    vert_indices[i] = verts[changed[i]];
+    position[i] = unode.position[changed[i]];
+  }
+  unode.vert_indices = std::move(vert_indices);
+  unode.position = std::move(position);
+  unode.unique_verts_num = changed.size();
+}
+
 void push_end_ex(Object &ob, const bool use_nested_undo)
 {
   StepData *step_data = get_step_data();
@@ -1702,6 +1737,18 @@ void push_end_ex(Object &ob, const bool use_nested_undo)
     unode->normal = {};
   }
 
+  const SculptSession *ss = ob.sculpt;
+  if (ss && ss->pbvh && ss->pbvh->type() == bke::pbvh::Type::Mesh && !ss->shapekey_active &&
+      !ss->deform_modifiers_active)
+  {
+    const Span<float3> positions = static_cast<const Mesh *>(ob.data)->vert_positions();
+    threading::parallel_for(step_data->nodes.index_range(), 1, [&](const IndexRange range) {
+      for (const int i : range) {
+        compact_position_node(positions, *step_data->nodes[i]);
+      }
+    });
+  }
+
   step_data->undo_size = threading::parallel_reduce(
       step_data->nodes.index_range(),
       16,
@@ -14,3 +14,9 @@
  * set it won't use indexing. It is added to increase the code clarity.
  */
 extern const FileIndexerType file_indexer_noop;
+
+/**
+ * Indexer that caches the contents of blend files on disk, used when linking or appending. It
+ * avoids opening libraries again when browsing them, also across sessions.
+ */
+extern const FileIndexerType file_indexer_library;
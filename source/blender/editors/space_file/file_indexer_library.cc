@@ -0,0 +1,237 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup edfile
+ *
+ * Indexer for the contents of blend files shown when linking or appending.
+ *
+ * Listing the data-blocks of a library requires opening the file and scanning all its blocks,
+ * which is slow for large files or files on network drives. This indexer keeps a small binary
+ * cache per blend file in #BKE_appdir_folder_caches, so browsing the same libraries again (also
+ * in later sessions) doesn't need to open them.
+ *
+ * The index stores all linkable data-blocks of the file (their ID type, name and a few flags) and
+ * is validated against the size and modification time of the blend file. Asset meta-data and
+ * previews are not stored: data-blocks that are assets get empty meta-data, previews are still
+ * loaded from the blend file on demand.
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "file_indexer.hh"
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_asset_types.h"
+
+#include "BLI_fileops.h"
+#include "BLI_hash.hh"
+#include "BLI_linklist.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_string_ref.hh"
+
+#include "BKE_appdir.hh"
+#include "BKE_asset.hh"
+
+#include "CLG_log.h"
+
+static CLG_LogRef LOG = {"ed.file.indexer"};
+
+namespace blender::ed::file::indexer {
+
+/** Increase when the layout of the index file changes, older index files are ignored. */
+constexpr uint32_t LIBRARY_INDEX_VERSION = 1;
+constexpr char LIBRARY_INDEX_MAGIC[8] = {'B', 'L', 'E', 'N', 'D', 'L', 'I', 'X'};
+
+enum eLibraryIndexEntryFlag : uint8_t {
+  LIBRARY_INDEX_ENTRY_IS_ASSET = (1 << 0),
+  LIBRARY_INDEX_ENTRY_NO_PREVIEW = (1 << 1),
+};
+
+struct LibraryIndexHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t entries_num;
+  /** Size and modification time of the indexed blend file, used to detect outdated indices. */
+  int64_t file_size;
+  int64_t file_mtime;
+};
+
+struct LibraryIndexEntryHeader {
+  int16_t idcode;
+  uint8_t flag;
+  uint8_t name_len;
+};
+
+/**
+ * \return absolute path to the index file of the given blend file.
+ *
+ * `BKE_appdir_folder_caches/library-indices/<blend-file-path-hash>.index`
+ */
+static std::string library_index_file_path(const char *blend_filepath)
+{
+  char index_path[FILE_MAX];
+  BKE_appdir_folder_caches(index_path, sizeof(index_path));
+  BLI_path_append(index_path, sizeof(index_path), "library-indices");
+
+  char index_filename[64];
+  SNPRINTF(index_filename,
+           "%016llx.index",
+           (unsigned long long)get_default_hash(StringRef(blend_filepath)));
+  BLI_path_append(index_path, sizeof(index_path), index_filename);
+  return index_path;
+}
+
+static bool library_index_file_stat(const char *blend_filepath,
+                                    int64_t *r_file_size,
+                                    int64_t *r_file_mtime)
+{
+  BLI_stat_t st;
+  if (BLI_stat(blend_filepath, &st) == -1) {
+    return false;
+  }
+  *r_file_size = int64_t(st.st_size);
+  *r_file_mtime = int64_t(st.st_mtime);
+  return true;
+}
+
+static eFileIndexerResult read_index(const char *file_name,
+                                     FileIndexerEntries *entries,
+                                     int *r_read_entries_len,
+                                     void * /*user_data*/)
+{
+  *r_read_entries_len = 0;
+
+  int64_t file_size, file_mtime;
+  if (!library_index_file_stat(file_name, &file_size, &file_mtime)) {
+    return FILE_INDEXER_NEEDS_UPDATE;
+  }
+
+  const std::string index_path = library_index_file_path(file_name);
+  FILE *file = BLI_fopen(index_path.c_str(), "rb");
+  if (file == nullptr) {
+    return FILE_INDEXER_NEEDS_UPDATE;
+  }
+
+  LibraryIndexHeader header;
+  if (fread(&header, sizeof(header), 1, file) != 1 ||
+      memcmp(header.magic, LIBRARY_INDEX_MAGIC, sizeof(header.magic)) != 0 ||
+      header.version != LIBRARY_INDEX_VERSION || header.file_size != file_size ||
+      header.file_mtime != file_mtime)
+  {
+    fclose(file);
+    return FILE_INDEXER_NEEDS_UPDATE;
+  }
+
+  FileIndexerEntries read_entries = {nullptr};
+  bool is_valid = true;
+  for (uint32_t i = 0; i < header.entries_num; i++) {
+    LibraryIndexEntryHeader entry_header;
+    char name[sizeof(BLODataBlockInfo::name)];
+    if (fread(&entry_header, sizeof(entry_header), 1, file) != 1 ||
+        entry_header.name_len >= sizeof(name) ||
+        fread(name, 1, entry_header.name_len, file) != entry_header.name_len)
+    {
+      is_valid = false;
+      break;
+    }
+    name[entry_header.name_len] = '\0';
+
+    FileIndexerEntry *entry = static_cast<FileIndexerEntry *>(
+        MEM_callocN(sizeof(FileIndexerEntry), __func__));
+    entry->idcode = entry_header.idcode;
+    STRNCPY(entry->datablock_info.name, name);
+    entry->datablock_info.no_preview_found = (entry_header.flag &
+                                              LIBRARY_INDEX_ENTRY_NO_PREVIEW) != 0;
+    if (entry_header.flag & LIBRARY_INDEX_ENTRY_IS_ASSET) {
+      entry->datablock_info.asset_data = BKE_asset_metadata_create();
+      entry->datablock_info.free_asset_data = true;
+    }
+    BLI_linklist_prepend(&read_entries.entries, entry);
+  }
+  fclose(file);
+
+  if (!is_valid) {
+    CLOG_WARN(&LOG, "Ignoring corrupt library index [%s].", index_path.c_str());
+    ED_file_indexer_entries_clear(&read_entries);
+    return FILE_INDEXER_NEEDS_UPDATE;
+  }
+
+  /* Entries were prepended, restore the order in which they were written. */
+  BLI_linklist_reverse(&read_entries.entries);
+  entries->entries = read_entries.entries;
+  *r_read_entries_len = int(header.entries_num);
+  return FILE_INDEXER_ENTRIES_LOADED;
+}
+
+static void update_index(const char *file_name, FileIndexerEntries *entries, void * /*user_data*/)
+{
+  int64_t file_size, file_mtime;
+  if (!library_index_file_stat(file_name, &file_size, &file_mtime)) {
+    return;
+  }
+
+  const std::string index_path = library_index_file_path(file_name);
+  if (!BLI_file_ensure_parent_dir_exists(index_path.c_str())) {
+    return;
+  }
+
+  /* Write to a temporary file first, so concurrent readers never see a partial index. */
+  const std::string index_path_temp = index_path + "@";
+  FILE *file = BLI_fopen(index_path_temp.c_str(), "wb");
+  if (file == nullptr) {
+    return;
+  }
+
+  LibraryIndexHeader header;
+  memcpy(header.magic, LIBRARY_INDEX_MAGIC, sizeof(header.magic));
+  header.version = LIBRARY_INDEX_VERSION;
+  header.entries_num = uint32_t(BLI_linklist_count(entries->entries));
+  header.file_size = file_size;
+  header.file_mtime = file_mtime;
+
+  bool success = fwrite(&header, sizeof(header), 1, file) == 1;
+  for (const LinkNode *ln = entries->entries; ln && success; ln = ln->next) {
+    const FileIndexerEntry *entry = static_cast<const FileIndexerEntry *>(ln->link);
+    const BLODataBlockInfo &info = entry->datablock_info;
+
+    LibraryIndexEntryHeader entry_header;
+    entry_header.idcode = entry->idcode;
+    entry_header.flag = 0;
+    if (info.asset_data) {
+      entry_header.flag |= LIBRARY_INDEX_ENTRY_IS_ASSET;
+    }
+    if (info.no_preview_found) {
+      entry_header.flag |= LIBRARY_INDEX_ENTRY_NO_PREVIEW;
+    }
+    entry_header.name_len = uint8_t(BLI_strnlen(info.name, sizeof(info.name) - 1));
+
+    success = fwrite(&entry_header, sizeof(entry_header), 1, file) == 1 &&
+              fwrite(info.name, 1, entry_header.name_len, file) == entry_header.name_len;
+  }
+  success &= fclose(file) == 0;
+
+  if (!success || BLI_rename_overwrite(index_path_temp.c_str(), index_path.c_str()) != 0) {
+    BLI_delete(index_path_temp.c_str(), false, false);
+    CLOG_WARN(&LOG, "Unable to write library index [%s].", index_path.c_str());
+    return;
+  }
+  CLOG_INFO(&LOG, 1, "Updated library index for [%s] in [%s].", file_name, index_path.c_str());
+}
+
+constexpr FileIndexerType library_indexer()
+{
+  FileIndexerType indexer = {nullptr};
+  indexer.read_index = read_index;
+  indexer.update_index = update_index;
+  indexer.use_for_partial_listing = true;
+  return indexer;
+}
+
+}  // namespace blender::ed::file::indexer
+
+const FileIndexerType file_indexer_library = blender::ed::file::indexer::library_indexer();
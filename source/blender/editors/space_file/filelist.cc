@@ -37,6 +37,7 @@
 #include "BLI_ghash.h"
 #include "BLI_linklist.h"
 #include "BLI_math_vector.h"
+#include "BLI_set.hh"
 #include "BLI_stack.h"
 #include "BLI_string_utils.hh"
 #include "BLI_task.h"
@@ -1594,6 +1595,21 @@ static void filelist_cache_previews_clear(FileListEntryCache *cache)
   }
 }
 
+/**
+ * Restart the generation of previews, so that the entries which are pushed next are previewed
+ * first. Previews that are done, including the ones that finish while running tasks are canceled,
+ * are kept instead of being generated again.
+ */
+static void filelist_cache_previews_restart(FileList *filelist)
+{
+  FileListEntryCache *cache = &filelist->filelist_cache;
+  if (cache->previews_pool) {
+    BLI_task_pool_cancel(cache->previews_pool);
+    filelist_cache_previews_update(filelist);
+    filelist_cache_previews_clear(cache);
+  }
+}
+
 static void filelist_cache_previews_free(FileListEntryCache *cache)
 {
   if (cache->previews_pool) {
@@ -2427,8 +2443,7 @@ bool filelist_file_cache_block(FileList *filelist, const int index)
        * if needed, and remove everything from working queue - we'll add all newly needed
        * entries at the end. */
       if (cache->flags & FLC_PREVIEWS_ACTIVE) {
-        filelist_cache_previews_update(filelist);
-        filelist_cache_previews_clear(cache);
+        filelist_cache_previews_restart(filelist);
       }
 
       //          printf("\tpreview cleaned up...\n");
@@ -2542,8 +2557,7 @@ bool filelist_file_cache_block(FileList *filelist, const int index)
   }
   else if ((cache->block_center_index != index) && (cache->flags & FLC_PREVIEWS_ACTIVE)) {
     /* We try to always preview visible entries first, so 'restart' preview background task. */
-    filelist_cache_previews_update(filelist);
-    filelist_cache_previews_clear(cache);
+    filelist_cache_previews_restart(filelist);
   }
 
   //  printf("Re-queueing previews...\n");
@@ -3297,6 +3311,84 @@ static int filelist_readjob_list_lib_populate_from_index(FileListReadJob *job_pa
   return read_from_index + navigate_to_parent_len;
 }
 
+/**
+ * Populate \a entries from an index that contains all data-blocks of the library (see
+ * #FileIndexerType.use_for_partial_listing), for listings that only need a part of it: the
+ * data-blocks of a single group, or only the groups when not listing recursively.
+ */
+static int filelist_readjob_list_lib_populate_from_full_index(
+    FileListReadJob *job_params,
+    ListBase *entries,
+    const ListLibOptions options,
+    const char *group,
+    const FileIndexerEntries *indexer_entries)
+{
+  int entries_len = 0;
+  if (options & LIST_LIB_ADD_PARENT) {
+    FileListInternEntry *entry = filelist_readjob_list_lib_navigate_to_parent_entry_create(
+        job_params);
+    BLI_addtail(entries, entry);
+    entries_len++;
+  }
+
+  const int group_idcode = group ? groupname_to_code(group) : 0;
+  Set<short> added_groups;
+  for (const LinkNode *ln = indexer_entries->entries; ln; ln = ln->next) {
+    FileIndexerEntry *indexer_entry = static_cast<FileIndexerEntry *>(ln->link);
+    if (group) {
+      if (indexer_entry->idcode != group_idcode) {
+        continue;
+      }
+      filelist_readjob_list_lib_add_datablock(job_params,
+                                              entries,
+                                              &indexer_entry->datablock_info,
+                                              false,
+                                              indexer_entry->idcode,
+                                              group);
+      entries_len++;
+      continue;
+    }
+
+    const char *group_name = BKE_idtype_idcode_to_name(indexer_entry->idcode);
+    if (added_groups.add(indexer_entry->idcode)) {
+      FileListInternEntry *group_entry = filelist_readjob_list_lib_group_create(
+          job_params, indexer_entry->idcode, group_name);
+      BLI_addtail(entries, group_entry);
+      entries_len++;
+    }
+    if (options & LIST_LIB_RECURSIVE) {
+      filelist_readjob_list_lib_add_datablock(job_params,
+                                              entries,
+                                              &indexer_entry->datablock_info,
+                                              true,
+                                              indexer_entry->idcode,
+                                              group_name);
+      entries_len++;
+    }
+  }
+  return entries_len;
+}
+
+/**
+ * Fill \a indexer_entries with all data-blocks of all linkable groups of the library.
+ */
+static void filelist_readjob_list_lib_full_index_create(BlendHandle *libfiledata,
+                                                        const ListLibOptions options,
+                                                        FileIndexerEntries *indexer_entries)
+{
+  LinkNode *groups = BLO_blendhandle_get_linkable_groups(libfiledata);
+  for (LinkNode *ln = groups; ln; ln = ln->next) {
+    const char *group_name = static_cast<char *>(ln->link);
+    const int idcode = groupname_to_code(group_name);
+    int datablock_len;
+    LinkNode *datablock_infos = BLO_blendhandle_get_datablock_info(
+        libfiledata, idcode, options & LIST_LIB_ASSETS_ONLY, &datablock_len);
+    ED_file_indexer_entries_extend_from_datablock_infos(indexer_entries, datablock_infos, idcode);
+    BLO_datablock_info_linklist_free(datablock_infos);
+  }
+  BLI_linklist_freeN(groups);
+}
+
 /**
  * \return The number of entries found if the \a root path points to a valid library file.
  *         Otherwise returns no value (#std::nullopt).
@@ -3327,22 +3419,27 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
   const bool has_group = group != nullptr;
 
   /* Try read from indexer_runtime. */
-  /* Indexing returns all entries in a blend file. We should ignore the index when listing a group
-   * inside a blend file, so the `entries` isn't filled with undesired entries.
-   * This happens when linking or appending data-blocks, where you can navigate into a group (ie
-   * Materials/Objects) where you only want to work with partial indexes.
+  /* Indexing returns all entries in a blend file. Unless the indexer supports partial listings,
+   * we should ignore the index when listing a group inside a blend file, so the `entries` isn't
+   * filled with undesired entries. This happens when linking or appending data-blocks, where you
+   * can navigate into a group (ie Materials/Objects) where you only want to work with partial
+   * indexes.
    *
-   * Adding support for partial reading/updating indexes would increase the complexity.
-   */
-  const bool use_indexer = !has_group;
+   * Indexers that support partial listings always store all data-blocks of the file and the
+   * entries are filtered here instead. */
+  const bool use_full_index = indexer_runtime->callbacks->use_for_partial_listing;
+  const bool use_indexer = !has_group || use_full_index;
   FileIndexerEntries indexer_entries = {nullptr};
   if (use_indexer) {
     int read_from_index = 0;
     eFileIndexerResult indexer_result = indexer_runtime->callbacks->read_index(
         dir, &indexer_entries, &read_from_index, indexer_runtime->user_data);
     if (indexer_result == FILE_INDEXER_ENTRIES_LOADED) {
-      int entries_read = filelist_readjob_list_lib_populate_from_index(
-          job_params, entries, options, read_from_index, &indexer_entries);
+      int entries_read = use_full_index ?
+                             filelist_readjob_list_lib_populate_from_full_index(
+                                 job_params, entries, options, group, &indexer_entries) :
+                             filelist_readjob_list_lib_populate_from_index(
+                                 job_params, entries, options, read_from_index, &indexer_entries);
       ED_file_indexer_entries_clear(&indexer_entries);
       return entries_read;
     }
@@ -3355,6 +3452,19 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
     return std::nullopt;
   }
 
+  if (use_full_index) {
+    /* Index all data-blocks of the library once, the listing itself is created from the index so
+     * the file doesn't have to be scanned again for the partial listing. */
+    filelist_readjob_list_lib_full_index_create(libfiledata, options, &indexer_entries);
+    BLO_blendhandle_close(libfiledata);
+
+    indexer_runtime->callbacks->update_index(dir, &indexer_entries, indexer_runtime->user_data);
+    int entries_read = filelist_readjob_list_lib_populate_from_full_index(
+        job_params, entries, options, group, &indexer_entries);
+    ED_file_indexer_entries_clear(&indexer_entries);
+    return entries_read;
+  }
+
   /* Add current parent when requested. */
   /* Is the navigate to previous level added to the list of entries. When added the return value
    * should be increased to match the actual number of entries added. It is introduced to keep
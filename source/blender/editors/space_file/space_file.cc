@@ -258,6 +258,9 @@ static void file_refresh(const bContext *C, ScrArea *area)
     filelist_setindexer(
         sfile->files, use_asset_indexer ? &asset::index::file_indexer_asset : &file_indexer_noop);
   }
+  else {
+    filelist_setindexer(sfile->files, &file_indexer_library);
+  }
 
   /* Update the active indices of bookmarks & co. */
   sfile->systemnr = fsmenu_get_active_indices(fsmenu, FS_CATEGORY_SYSTEM, params->dir);
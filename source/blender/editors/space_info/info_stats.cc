@@ -8,6 +8,7 @@
 
 #include <cstdio>
 #include <cstring>
+#include <utility>
 
 #include "MEM_guardedalloc.h"
 
@@ -62,6 +63,9 @@
 #include "UI_resources.hh"
 
 #include "GPU_capabilities.hh"
+#include "GPU_storage_buffer.hh"
+#include "GPU_texture.hh"
+#include "GPU_vertex_buffer.hh"
 
 ENUM_OPERATORS(eUserpref_StatusBar_Flag, STATUSBAR_SHOW_VERSION)
 
@@ -686,6 +690,29 @@ const char *ED_info_statusbar_string_ex(Main *bmain,
     uintptr_t mem_in_use = MEM_get_memory_in_use();
     BLI_str_format_byte_unit(formatted_mem, mem_in_use, false);
     ofs += BLI_snprintf_rlen(info + ofs, len, IFACE_("Memory: %s"), formatted_mem);
+
+    /* Memory of the categories that are in use, see #MEM_use_memory_categories. */
+    if (MEM_memory_categories_enabled()) {
+      const char *separator = " (";
+      for (int i = MEM_CATEGORY_OTHER + 1; i < MEM_CATEGORY_NUM; i++) {
+        const eMEM_Category category = eMEM_Category(i);
+        const size_t category_mem = MEM_category_get_memory_in_use(category);
+        if (category_mem == 0) {
+          continue;
+        }
+        BLI_str_format_byte_unit(formatted_mem, int64_t(category_mem), false);
+        ofs += BLI_snprintf_rlen(info + ofs,
+                                 len - ofs,
+                                 "%s%s: %s",
+                                 separator,
+                                 IFACE_(MEM_category_name(category)),
+                                 formatted_mem);
+        separator = ", ";
+      }
+      if (!STREQ(separator, " (")) {
+        ofs += BLI_snprintf_rlen(info + ofs, len - ofs, ")");
+      }
+    }
   }
 
   /* GPU VRAM status. */
@@ -709,6 +736,25 @@ const char *ED_info_statusbar_string_ex(Main *bmain,
       /* Can only show amount of GPU VRAM available. */
       ofs += BLI_snprintf_rlen(info + ofs, len - ofs, IFACE_("VRAM: %.1f GiB Free"), gpu_free_gb);
     }
+
+    /* Part of the memory allocated by Blender itself, per type of resource. */
+    const std::pair<const char *, size_t> gpu_usages[] = {
+        {IFACE_("Textures"), GPU_texture_memory_usage_get()},
+        {IFACE_("Meshes"), GPU_vertbuf_get_memory_usage()},
+        {IFACE_("Buffers"), GPU_storagebuf_memory_usage_get()},
+    };
+    const char *separator = " (";
+    for (const auto &[name, usage] : gpu_usages) {
+      if (usage == 0) {
+        continue;
+      }
+      BLI_str_format_byte_unit(formatted_mem, int64_t(usage), false);
+      ofs += BLI_snprintf_rlen(info + ofs, len - ofs, "%s%s: %s", separator, name, formatted_mem);
+      separator = ", ";
+    }
+    if (!STREQ(separator, " (")) {
+      ofs += BLI_snprintf_rlen(info + ofs, len - ofs, ")");
+    }
   }
 
   /* Blender version. */
@@ -81,27 +81,30 @@ Vector<Sequence *> sequencer_visible_strips_get(const bContext *C)
 Vector<Sequence *> sequencer_visible_strips_get(const Scene *scene, const View2D *v2d)
 {
   const Editing *ed = SEQ_editing_get(scene);
-  Vector<Sequence *> strips;
 
-  LISTBASE_FOREACH (Sequence *, seq, ed->seqbasep) {
+  /* Only strips overlapping the visible frames are checked, the rest is skipped by the lookup. */
+  Vector<Sequence *> strips = SEQ_sequence_lookup_strips_in_range(
+      scene, ed->seqbasep, int(floorf(v2d->cur.xmin)) - 1, int(floorf(v2d->cur.xmax)) + 1);
+
+  strips.remove_if([&](const Sequence *seq) {
     if (min_ii(SEQ_time_left_handle_frame_get(scene, seq), SEQ_time_start_frame_get(seq)) >
         v2d->cur.xmax)
     {
-      continue;
+      return true;
     }
     if (max_ii(SEQ_time_right_handle_frame_get(scene, seq),
                SEQ_time_content_end_frame_get(scene, seq)) < v2d->cur.xmin)
     {
-      continue;
+      return true;
     }
     if (seq->machine + 1.0f < v2d->cur.ymin) {
-      continue;
+      return true;
     }
     if (seq->machine > v2d->cur.ymax) {
-      continue;
+      return true;
     }
-    strips.append(seq);
-  }
+    return false;
+  });
   return strips;
 }
 
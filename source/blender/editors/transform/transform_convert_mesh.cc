@@ -2098,6 +2098,10 @@ static void recalcData_mesh(TransInfo *t)
 
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
     DEG_id_tag_update(static_cast<ID *>(tc->obedit->data), ID_RECALC_GEOMETRY);
+    /* Correcting custom data modifies the UVs as well. */
+    const TransCustomDataMesh *tcmd = static_cast<TransCustomDataMesh *>(tc->custom.type.data);
+    BKE_editmesh_from_object(tc->obedit)->is_positions_only_update = !(tcmd &&
+                                                                        tcmd->cd_layer_correct);
 
     mesh_partial_update(t, tc, &partial_state);
   }
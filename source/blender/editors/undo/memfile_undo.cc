@@ -13,6 +13,7 @@
 
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
+#include "BLI_vector.hh"
 
 #include "DNA_ID.h"
 #include "DNA_collection_types.h"
@@ -54,6 +55,57 @@ struct MemFileUndoStep {
   MemFileUndoData *data;
 };
 
+/**
+ * Number of most recent memfile undo steps which are never compressed. Older steps are compressed
+ * since they are unlikely to be used again, at the cost of some extra time when they are.
+ */
+#define MEMFILE_UNDO_UNCOMPRESSED_STEPS_NUM 4
+
+/** All memfile undo steps of the stack, from oldest to newest. */
+static blender::Vector<MemFileUndoStep *> memfile_undosys_steps_get(UndoStack *ustack)
+{
+  blender::Vector<MemFileUndoStep *> steps;
+  LISTBASE_FOREACH (UndoStep *, us_iter, &ustack->steps) {
+    if (us_iter->type == BKE_UNDOSYS_TYPE_MEMFILE) {
+      steps.append((MemFileUndoStep *)us_iter);
+    }
+  }
+  return steps;
+}
+
+static blender::Vector<MemFile *> memfile_undosys_steps_memfiles_get(
+    blender::Span<MemFileUndoStep *> steps)
+{
+  blender::Vector<MemFile *> memfiles;
+  for (MemFileUndoStep *us : steps) {
+    memfiles.append(&us->data->memfile);
+  }
+  return memfiles;
+}
+
+/** Keep the memory usage of the undo steps in sync after (de)compressing some of them. */
+static void memfile_undosys_steps_size_update(blender::Span<MemFileUndoStep *> steps)
+{
+  for (MemFileUndoStep *us : steps) {
+    if (us->data->memfile.chunks.first != nullptr) {
+      us->data->undo_size = us->data->memfile.size;
+      us->step.data_size = us->data->undo_size;
+    }
+  }
+}
+
+/** Make sure the memfile of \a us can be read. */
+static void memfile_undosys_step_decompress(UndoStack *ustack, MemFileUndoStep *us)
+{
+  const blender::Vector<MemFileUndoStep *> steps = memfile_undosys_steps_get(ustack);
+  const int64_t index = steps.first_index_of_try(us);
+  if (index == -1) {
+    return;
+  }
+  BLO_memfile_decompress(memfile_undosys_steps_memfiles_get(steps), index);
+  memfile_undosys_steps_size_update(steps);
+}
+
 static bool memfile_undosys_poll(bContext *C)
 {
   /* other poll functions must run first, this is a catch-all. */
@@ -84,9 +136,22 @@ static bool memfile_undosys_step_encode(bContext * /*C*/, Main *bmain, UndoStep
   /* can be null, use when set. */
   MemFileUndoStep *us_prev = (MemFileUndoStep *)BKE_undosys_step_find_by_type(
       ustack, BKE_UNDOSYS_TYPE_MEMFILE);
+  if (us_prev) {
+    /* The previous step is used as reference to share unchanged chunks. */
+    memfile_undosys_step_decompress(ustack, us_prev);
+  }
   us->data = BKE_memfile_undo_encode(bmain, us_prev ? us_prev->data : nullptr);
   us->step.data_size = us->data->undo_size;
 
+  /* Compress the steps getting old. The new step is not part of the stack yet. */
+  blender::Vector<MemFileUndoStep *> steps = memfile_undosys_steps_get(ustack);
+  steps.append(us);
+  const blender::Vector<MemFile *> memfiles = memfile_undosys_steps_memfiles_get(steps);
+  for (int64_t i = 0; i + MEMFILE_UNDO_UNCOMPRESSED_STEPS_NUM < memfiles.size(); i++) {
+    BLO_memfile_compress(memfiles, i);
+  }
+  memfile_undosys_steps_size_update(steps);
+
   /* Store the fact that we should not re-use old data with that undo step, and reset the Main
    * flag. */
   us->step.use_old_bmain_data = !bmain->use_memfile_full_barrier;
@@ -202,6 +267,7 @@ static void memfile_undosys_step_decode(
   ED_preview_kill_jobs(CTX_wm_manager(C), bmain);
 
   MemFileUndoStep *us = (MemFileUndoStep *)us_p;
+  memfile_undosys_step_decompress(ED_undo_stack_get(), us);
   BKE_memfile_undo_decode(us->data, undo_direction, use_old_bmain_data, C);
 
   for (UndoStep *us_iter = us_p->next; us_iter; us_iter = us_iter->next) {
@@ -239,6 +239,9 @@ void ED_editors_exit(Main *bmain, bool do_undo_system)
     return;
   }
 
+  /* The depsgraph used for playback evaluation references data-blocks of the main database. */
+  ED_screen_animation_background_evaluation_free();
+
   /* Frees all edit-mode undo-steps. */
   if (do_undo_system && G_MAIN->wm.first) {
     wmWindowManager *wm = static_cast<wmWindowManager *>(G_MAIN->wm.first);
@@ -11,6 +11,8 @@
  * another #Graph again).
  */
 
+#include <atomic>
+
 #include "BLI_vector.hh"
 #include "BLI_vector_set.hh"
 
@@ -106,6 +108,12 @@ class GraphExecutor : public LazyFunction {
    */
   const NodeExecuteWrapper *node_execute_wrapper_;
 
+  /**
+   * Execution time of every node in microseconds, measured in the most recent evaluation. This
+   * is used to estimate whether it's worth running scheduled nodes on other threads.
+   */
+  mutable Array<std::atomic<int32_t>> node_run_times_us_;
+
   /**
    * When a graph is executed, various things have to be allocated (e.g. the state of all nodes).
    * Instead of doing many small allocations, a single bigger allocation is done. This struct
@@ -17,6 +17,8 @@ class ProcedureExecutor : public MultiFunction {
  private:
   Signature signature_;
   const Procedure &procedure_;
+  /** Number of indices processed at once, so that the variable buffers stay in cache. */
+  int64_t chunk_size_;
 
  public:
   ProcedureExecutor(const Procedure &procedure);
@@ -55,6 +55,12 @@
 
 namespace blender::fn::lazy_function {
 
+/**
+ * Scheduled nodes that took at least this long in total (in microseconds) in the previous
+ * evaluation are worth executing in a separate task, despite the threading overhead.
+ */
+static constexpr int64_t expensive_nodes_run_time_us = 200;
+
 enum class NodeScheduleState : uint8_t {
   /**
    * Default state of every node.
@@ -256,6 +262,24 @@ struct ScheduledNodes {
     return priority_.size() + normal_.size();
   }
 
+  /**
+   * Sum of the execution times of the scheduled nodes in previous evaluations, except for the
+   * node that is executed next.
+   */
+  int64_t run_time_after_next_us(const Span<std::atomic<int32_t>> node_run_times_us) const
+  {
+    int64_t run_time = 0;
+    for (const Span<const FunctionNode *> nodes : {priority_.as_span(), normal_.as_span()}) {
+      for (const FunctionNode *node : nodes) {
+        run_time += node_run_times_us[node->index_in_graph()].load(std::memory_order_relaxed);
+      }
+    }
+    if (const FunctionNode *next_node = this->peek_next_node()) {
+      run_time -= node_run_times_us[next_node->index_in_graph()].load(std::memory_order_relaxed);
+    }
+    return run_time;
+  }
+
   /**
    * Split up the scheduled nodes into two groups that can be worked on in parallel.
    */
@@ -269,6 +293,34 @@ struct ScheduledNodes {
     priority_.resize(priority_split);
     normal_.resize(normal_split);
   }
+
+  /**
+   * Move all scheduled nodes except for the one that is executed next into \a other.
+   */
+  void split_after_next_into(ScheduledNodes &other)
+  {
+    BLI_assert(this != &other);
+    const FunctionNode *next_node = this->pop_next_node();
+    other.priority_.extend(priority_);
+    other.normal_.extend(normal_);
+    priority_.clear();
+    normal_.clear();
+    if (next_node != nullptr) {
+      priority_.append(next_node);
+    }
+  }
+
+ private:
+  const FunctionNode *peek_next_node() const
+  {
+    if (!this->priority_.is_empty()) {
+      return this->priority_.last();
+    }
+    if (!this->normal_.is_empty()) {
+      return this->normal_.last();
+    }
+    return nullptr;
+  }
 };
 
 struct CurrentTask {
@@ -823,6 +875,19 @@ class Executor {
           this->push_to_task_pool(std::move(split_nodes));
         }
       }
+      /* Nodes that took long to execute in previous evaluations are likely to take long again.
+       * Let other threads start working on them while this thread executes the next node. Cheap
+       * nodes stay together in the same task. */
+      else if (current_task.scheduled_nodes.nodes_num() > 1 &&
+               current_task.scheduled_nodes.run_time_after_next_us(self_.node_run_times_us_) >=
+                   expensive_nodes_run_time_us)
+      {
+        if (this->try_enable_multi_threading()) {
+          std::unique_ptr<ScheduledNodes> split_nodes = std::make_unique<ScheduledNodes>();
+          current_task.scheduled_nodes.split_after_next_into(*split_nodes);
+          this->push_to_task_pool(std::move(split_nodes));
+        }
+      }
     }
   }
 
@@ -1448,12 +1513,18 @@ inline void Executor::execute_node(const FunctionNode &node,
   };
 
   lazy_threading::HintReceiver blocking_hint_receiver{blocking_hint_fn};
+  const timeit::TimePoint start_time = timeit::Clock::now();
   if (self_.node_execute_wrapper_) {
     self_.node_execute_wrapper_->execute_node(node, node_params, fn_context);
   }
   else {
     fn.execute(node_params, fn_context);
   }
+  const int64_t run_time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                                  timeit::Clock::now() - start_time)
+                                  .count();
+  self_.node_run_times_us_[node.index_in_graph()].store(
+      int32_t(std::min<int64_t>(run_time_us, INT32_MAX)), std::memory_order_relaxed);
 
   if (self_.logger_ != nullptr) {
     self_.logger_->log_after_node_execute(node, node_params, fn_context);
@@ -1473,11 +1544,16 @@ GraphExecutor::GraphExecutor(const Graph &graph,
       graph_output_index_by_socket_index_(graph.graph_outputs().size(), -1),
       logger_(logger),
       side_effect_provider_(side_effect_provider),
-      node_execute_wrapper_(node_execute_wrapper)
+      node_execute_wrapper_(node_execute_wrapper),
+      node_run_times_us_(graph.nodes().size())
 {
   /* The graph executor can handle partial execution when there are still missing inputs. */
   allow_missing_requested_inputs_ = true;
 
+  for (std::atomic<int32_t> &run_time : node_run_times_us_) {
+    run_time.store(0, std::memory_order_relaxed);
+  }
+
   for (const int i : graph_inputs_.index_range()) {
     const OutputSocket &socket = *graph_inputs_[i];
     BLI_assert(socket.node().is_interface());
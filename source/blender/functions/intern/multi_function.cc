@@ -47,10 +47,9 @@ static int64_t compute_grain_size(const ExecutionHints &hints, const IndexMask &
     grain_size = std::max(grain_size, thread_based_grain_size);
   }
   if (hints.allocates_array) {
-    const int64_t max_grain_size = 10000;
     /* Avoid allocating many large intermediate arrays. Better process data in smaller chunks to
      * keep peak memory usage lower. */
-    grain_size = std::min(grain_size, max_grain_size);
+    grain_size = std::min(grain_size, hints.max_grain_size);
   }
   return grain_size;
 }
@@ -2,13 +2,40 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <algorithm>
+
 #include "FN_multi_function_procedure_executor.hh"
 
 #include "BLI_stack.hh"
 
 namespace blender::fn::multi_function {
 
-ProcedureExecutor::ProcedureExecutor(const Procedure &procedure) : procedure_(procedure)
+/**
+ * Find how many indices can be processed at once while the buffers of all variables fit into
+ * (a share of) the L2 cache. All instructions are executed for one chunk before the next chunk,
+ * so the intermediate values are not streamed through main memory.
+ */
+static int64_t procedure_chunk_size(const Procedure &procedure)
+{
+  const int64_t cache_budget = 256 * 1024;
+  const int64_t min_chunk_size = 1024;
+  const int64_t max_chunk_size = 10000;
+
+  /* This is an upper bound, buffers of variables that are not alive at the same time are reused
+   * during execution. For vector variables only the per index bookkeeping is counted. */
+  int64_t bytes_per_index = 0;
+  for (const Variable *variable : procedure.variables()) {
+    const DataType data_type = variable->data_type();
+    bytes_per_index += data_type.is_single() ? data_type.single_type().size() : 32;
+  }
+  if (bytes_per_index == 0) {
+    return max_chunk_size;
+  }
+  return std::clamp(cache_budget / bytes_per_index, min_chunk_size, max_chunk_size);
+}
+
+ProcedureExecutor::ProcedureExecutor(const Procedure &procedure)
+    : procedure_(procedure), chunk_size_(procedure_chunk_size(procedure))
 {
   SignatureBuilder builder("Procedure Executor", signature_);
 
@@ -1246,6 +1273,7 @@ MultiFunction::ExecutionHints ProcedureExecutor::get_execution_hints() const
   ExecutionHints hints;
   hints.allocates_array = true;
   hints.min_grain_size = 10000;
+  hints.max_grain_size = chunk_size_;
   return hints;
 }
 
@@ -5,6 +5,8 @@
 #pragma once
 
 #include "BLI_index_mask.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 struct PointCloud;
 namespace blender::bke {
@@ -17,6 +19,24 @@ class AnonymousAttributePropagationInfo;
 
 namespace blender::geometry {
 
+/**
+ * Find the selected points that are within \a merge_distance of another selected point. Points
+ * are visited in index order, and every point that has not been merged yet becomes the target of
+ * all points in its range that have not been merged yet either. Merges are never chained, so the
+ * result only depends on the order of the points.
+ *
+ * For small distances compared to the size of the point set, a uniform grid is used to find the
+ * points in range in parallel, otherwise a KD tree is used. Both give the same result.
+ *
+ * \param r_dest_map: Must be initialized to -1. Merged points are set to the index of the point
+ * they are merged into, points that other points are merged into are set to their own index.
+ * \return The number of merged points.
+ */
+int find_points_to_merge(Span<float3> positions,
+                         const IndexMask &selection,
+                         float merge_distance,
+                         MutableSpan<int> r_dest_map);
+
 /**
  * Merge selected points into other selected points within the \a merge_distance. The merged
  * indices favor speed over accuracy, since the results will depend on the order of the points.
@@ -8,7 +8,6 @@
 #include "BLI_array.hh"
 #include "BLI_bit_vector.hh"
 #include "BLI_index_mask.hh"
-#include "BLI_kdtree.h"
 #include "BLI_math_vector.h"
 #include "BLI_offset_indices.hh"
 #include "BLI_vector.hh"
@@ -18,6 +17,7 @@
 #include "DNA_meshdata_types.h"
 
 #include "GEO_mesh_merge_by_distance.hh"
+#include "GEO_point_merge_by_distance.hh"
 #include "GEO_randomize.hh"
 
 #ifdef USE_WELD_DEBUG_TIME
@@ -1699,16 +1699,8 @@ std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
                                                  const float merge_distance)
 {
   Array<int> vert_dest_map(mesh.verts_num, OUT_OF_CONTEXT);
-
-  KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
-
-  const Span<float3> positions = mesh.vert_positions();
-  selection.foreach_index([&](const int64_t i) { BLI_kdtree_3d_insert(tree, i, positions[i]); });
-
-  BLI_kdtree_3d_balance(tree);
-  const int vert_kill_len = BLI_kdtree_3d_calc_duplicates_fast(
-      tree, merge_distance, true, vert_dest_map.data());
-  BLI_kdtree_3d_free(tree);
+  const int vert_kill_len = find_points_to_merge(
+      mesh.vert_positions(), selection, merge_distance, vert_dest_map);
 
   if (vert_kill_len == 0) {
     return std::nullopt;
@@ -2,9 +2,14 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <array>
+
 #include "BLI_array_utils.hh"
+#include "BLI_bounds.hh"
 #include "BLI_kdtree.h"
+#include "BLI_math_vector.hh"
 #include "BLI_offset_indices.hh"
+#include "BLI_sort.hh"
 #include "BLI_task.hh"
 
 #include "DNA_pointcloud_types.h"
@@ -17,6 +22,195 @@
 
 namespace blender::geometry {
 
+static int find_points_to_merge_kdtree(const Span<float3> positions,
+                                       const IndexMask &selection,
+                                       const float merge_distance,
+                                       MutableSpan<int> r_dest_map)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
+  selection.foreach_index([&](const int64_t i) { BLI_kdtree_3d_insert(tree, i, positions[i]); });
+  BLI_kdtree_3d_balance(tree);
+  const int duplicate_count = BLI_kdtree_3d_calc_duplicates_fast(
+      tree, merge_distance, true, r_dest_map.data());
+  BLI_kdtree_3d_free(tree);
+  return duplicate_count;
+}
+
+/** Number of bits used for the grid cell coordinate on every axis in #grid_cell_key. */
+static constexpr int grid_axis_bits = 21;
+
+/**
+ * Combine the grid cell coordinates into a single key. When sorted, cells that only differ in
+ * their z coordinate are next to each other.
+ */
+static uint64_t grid_cell_key(const int x, const int y, const int z)
+{
+  return (uint64_t(x) << (2 * grid_axis_bits)) | (uint64_t(y) << grid_axis_bits) | uint64_t(z);
+}
+
+/**
+ * Find the points to merge with a uniform grid with cells the size of the merge distance, so that
+ * all points in range of a point are in the neighboring cells. Returns #std::nullopt when the grid
+ * would be slower than the KD tree, because there are too many points per cell or too many cells.
+ */
+static std::optional<int> find_points_to_merge_grid(const Span<float3> positions,
+                                                    const IndexMask &selection,
+                                                    const float merge_distance,
+                                                    MutableSpan<int> r_dest_map)
+{
+  /* Only use the grid when the selection is large enough for the parallel search to pay off. */
+  const int points_num = selection.size();
+  if (points_num < 10000 || !(merge_distance > 0.0f)) {
+    return std::nullopt;
+  }
+  const Bounds<float3> bounds = *bounds::min_max(selection, positions);
+  const float3 cells_num = (bounds.max - bounds.min) / merge_distance;
+  /* Also catches non-finite positions. */
+  if (!(math::reduce_max(cells_num) < float((1 << grid_axis_bits) - 2))) {
+    return std::nullopt;
+  }
+
+  /* Points are identified by their index in the selection below, which has the same order. */
+  Array<int> selected_indices(points_num);
+  selection.to_indices<int>(selected_indices);
+  Array<float3> selected_positions(points_num);
+  array_utils::gather(positions, selection, selected_positions.as_mutable_span());
+
+  /* Sort the points by their grid cell, and by index within every cell. */
+  Array<int3> point_cells(points_num);
+  Array<uint64_t> point_keys(points_num);
+  threading::parallel_for(IndexRange(points_num), 4096, [&](const IndexRange range) {
+    for (const int pos : range) {
+      const int3 cell = int3((selected_positions[pos] - bounds.min) / merge_distance);
+      point_cells[pos] = cell;
+      point_keys[pos] = grid_cell_key(cell.x, cell.y, cell.z);
+    }
+  });
+  Array<int> sorted_points(points_num);
+  array_utils::fill_index_range<int>(sorted_points);
+  parallel_sort(sorted_points.begin(), sorted_points.end(), [&](const int a, const int b) {
+    return point_keys[a] < point_keys[b] || (point_keys[a] == point_keys[b] && a < b);
+  });
+
+  Vector<uint64_t> cell_keys;
+  Vector<int> cell_offsets_data;
+  for (const int i : sorted_points.index_range()) {
+    const uint64_t key = point_keys[sorted_points[i]];
+    if (cell_keys.is_empty() || cell_keys.last() != key) {
+      cell_keys.append(key);
+      cell_offsets_data.append(i);
+    }
+  }
+  cell_offsets_data.append(points_num);
+  const OffsetIndices<int> cell_offsets(cell_offsets_data.as_span());
+  const Span<uint64_t> keys = cell_keys;
+
+  /* Every point is compared with the points in 27 cells. When the points are clustered much
+   * closer together than the merge distance, the KD tree skips more of these comparisons. */
+  int64_t points_per_cell_sq_sum = 0;
+  for (const int cell_index : cell_offsets.index_range()) {
+    points_per_cell_sq_sum += int64_t(cell_offsets[cell_index].size()) *
+                              cell_offsets[cell_index].size();
+  }
+  if (points_per_cell_sq_sum > int64_t(points_num) * 64) {
+    return std::nullopt;
+  }
+
+  /* Call the function for every pair of points in range, where the first point is in the given
+   * cell and the second point has a higher index (the first point may become its merge target). */
+  const float merge_distance_sq = merge_distance * merge_distance;
+  auto foreach_pair_in_range = [&](const int cell_index, auto &&fn) {
+    const Span<int> cell_points = sorted_points.as_span().slice(cell_offsets[cell_index]);
+    const int3 cell = point_cells[cell_points.first()];
+    /* The neighbor cells with the same x and y coordinates are next to each other. */
+    std::array<IndexRange, 9> neighbor_cell_ranges;
+    int neighbor_cell_ranges_num = 0;
+    for (int x = cell.x - 1; x <= cell.x + 1; x++) {
+      for (int y = cell.y - 1; y <= cell.y + 1; y++) {
+        if (x < 0 || y < 0) {
+          continue;
+        }
+        const uint64_t *first = std::lower_bound(
+            keys.begin(), keys.end(), grid_cell_key(x, y, std::max(cell.z - 1, 0)));
+        const uint64_t *last = std::upper_bound(first, keys.end(), grid_cell_key(x, y, cell.z + 1));
+        neighbor_cell_ranges[neighbor_cell_ranges_num++] = IndexRange::from_begin_end(
+            first - keys.begin(), last - keys.begin());
+      }
+    }
+    for (const int pos : cell_points) {
+      const float3 &position = selected_positions[pos];
+      for (const IndexRange cells : Span(neighbor_cell_ranges).take_front(neighbor_cell_ranges_num))
+      {
+        for (const int other_pos : sorted_points.as_span().slice(cell_offsets[cells])) {
+          if (other_pos > pos &&
+              math::distance_squared(position, selected_positions[other_pos]) <= merge_distance_sq)
+          {
+            fn(pos, other_pos);
+          }
+        }
+      }
+    }
+  };
+
+  /* Find the points in range in parallel, in two passes to avoid reallocations. */
+  Array<int> in_range_offsets_data(points_num + 1, 0);
+  threading::parallel_for(cell_keys.index_range(), 256, [&](const IndexRange range) {
+    for (const int cell_index : range) {
+      foreach_pair_in_range(cell_index, [&](const int pos, const int /*other_pos*/) {
+        in_range_offsets_data[pos]++;
+      });
+    }
+  });
+  const OffsetIndices<int> in_range_offsets = offset_indices::accumulate_counts_to_offsets(
+      in_range_offsets_data);
+  Array<int> in_range(in_range_offsets.total_size());
+  Array<int> in_range_num(points_num, 0);
+  threading::parallel_for(cell_keys.index_range(), 256, [&](const IndexRange range) {
+    for (const int cell_index : range) {
+      foreach_pair_in_range(cell_index, [&](const int pos, const int other_pos) {
+        in_range[in_range_offsets[pos][in_range_num[pos]++]] = other_pos;
+      });
+    }
+  });
+
+  /* Assigning merge targets depends on the previous points, so it is done in order. This only
+   * visits the points found above, which is cheap compared to the search. */
+  int duplicate_count = 0;
+  for (const int pos : IndexRange(points_num)) {
+    const int i = selected_indices[pos];
+    if (!ELEM(r_dest_map[i], -1, i)) {
+      continue;
+    }
+    bool found_duplicate = false;
+    for (const int other_pos : in_range.as_span().slice(in_range_offsets[pos])) {
+      const int other_i = selected_indices[other_pos];
+      if (r_dest_map[other_i] == -1) {
+        r_dest_map[other_i] = i;
+        duplicate_count++;
+        found_duplicate = true;
+      }
+    }
+    if (found_duplicate) {
+      /* Prevent chains of merged points. */
+      r_dest_map[i] = i;
+    }
+  }
+  return duplicate_count;
+}
+
+int find_points_to_merge(const Span<float3> positions,
+                         const IndexMask &selection,
+                         const float merge_distance,
+                         MutableSpan<int> r_dest_map)
+{
+  if (const std::optional<int> duplicate_count = find_points_to_merge_grid(
+          positions, selection, merge_distance, r_dest_map))
+  {
+    return *duplicate_count;
+  }
+  return find_points_to_merge_kdtree(positions, selection, merge_distance, r_dest_map);
+}
+
 PointCloud *point_merge_by_distance(const PointCloud &src_points,
                                     const float merge_distance,
                                     const IndexMask &selection,
@@ -26,37 +220,20 @@ PointCloud *point_merge_by_distance(const PointCloud &src_points,
   const Span<float3> positions = src_points.positions();
   const int src_size = positions.size();
 
-  /* Create the KD tree based on only the selected points, to speed up merge detection and
-   * balancing. */
-  KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
-  selection.foreach_index_optimized<int64_t>(
-      [&](const int64_t i, const int64_t pos) { BLI_kdtree_3d_insert(tree, pos, positions[i]); });
-  BLI_kdtree_3d_balance(tree);
-
-  /* Find the duplicates in the KD tree. Because the tree only contains the selected points, the
-   * resulting indices are indices into the selection, rather than indices of the source point
-   * cloud. */
-  Array<int> selection_merge_indices(selection.size(), -1);
-  const int duplicate_count = BLI_kdtree_3d_calc_duplicates_fast(
-      tree, merge_distance, false, selection_merge_indices.data());
-  BLI_kdtree_3d_free(tree);
+  /* Points that are not merged keep the -1 value. */
+  Array<int> dest_map(src_size, -1);
+  const int duplicate_count = find_points_to_merge(positions, selection, merge_distance, dest_map);
 
   /* Create the new point cloud and add it to a temporary component for the attribute API. */
   const int dst_size = src_size - duplicate_count;
   PointCloud *dst_pointcloud = BKE_pointcloud_new_nomain(dst_size);
   bke::MutableAttributeAccessor dst_attributes = dst_pointcloud->attributes_for_write();
 
-  /* By default, every point is just "merged" with itself. Then fill in the results of the merge
-   * finding, converting from indices into the selection to indices into the full input point
-   * cloud. */
+  /* By default, every point is just "merged" with itself. */
   Array<int> merge_indices(src_size);
-  array_utils::fill_index_range<int>(merge_indices);
-
-  selection.foreach_index([&](const int src_index, const int pos) {
-    const int merge_index = selection_merge_indices[pos];
-    if (merge_index != -1) {
-      const int src_merge_index = selection[merge_index];
-      merge_indices[src_index] = src_merge_index;
+  threading::parallel_for(merge_indices.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      merge_indices[i] = dest_map[i] == -1 ? i : dest_map[i];
     }
   });
 
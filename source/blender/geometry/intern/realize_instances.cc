@@ -52,6 +52,14 @@ struct OrderedAttributes {
   }
 };
 
+/**
+ * Elements that are realized in one task, when tasks are balanced by the number of elements of
+ * the realized instances. Every instance also adds #realize_task_overhead_size to that, for the
+ * work that is done for every instance regardless of its size.
+ */
+static constexpr int64_t realize_tasks_grain_size = 4096;
+static constexpr int64_t realize_task_overhead_size = 32;
+
 struct AttributeFallbacksArray {
   /**
    * Instance attribute values used as fallback when the geometry does not have the
@@ -1204,19 +1212,31 @@ static void execute_realize_pointcloud_tasks(const RealizeInstancesOptions &opti
         attribute_id, bke::AttrDomain::Point, data_type));
   }
 
-  /* Actually execute all tasks. */
-  threading::parallel_for(tasks.index_range(), 100, [&](const IndexRange task_range) {
-    for (const int task_index : task_range) {
-      const RealizePointCloudTask &task = tasks[task_index];
-      execute_realize_pointcloud_task(options,
-                                      task,
-                                      ordered_attributes,
-                                      dst_attribute_writers,
-                                      point_radii.span,
-                                      point_ids.span,
-                                      positions.span);
-    }
+  /* Actually execute all tasks. Instances of very different sizes are often mixed, so balance the
+   * work by the number of realized points. */
+  const auto task_sizes = threading::accumulated_task_sizes([&](const IndexRange range) {
+    const int end = range.one_after_last() < tasks.size() ?
+                        tasks[range.one_after_last()].start_index :
+                        tot_points;
+    return int64_t(end - tasks[range.first()].start_index) +
+           range.size() * realize_task_overhead_size;
   });
+  threading::parallel_for(
+      tasks.index_range(),
+      realize_tasks_grain_size,
+      [&](const IndexRange task_range) {
+        for (const int task_index : task_range) {
+          const RealizePointCloudTask &task = tasks[task_index];
+          execute_realize_pointcloud_task(options,
+                                          task,
+                                          ordered_attributes,
+                                          dst_attribute_writers,
+                                          point_radii.span,
+                                          point_ids.span,
+                                          positions.span);
+        }
+      },
+      task_sizes);
 
   /* Tag modified attributes. */
   for (GSpanAttributeWriter &dst_attribute : dst_attribute_writers) {
@@ -1562,23 +1582,37 @@ static void execute_realize_mesh_tasks(const RealizeInstancesOptions &options,
       CustomData_set_layer_render(&dst_mesh->corner_data, CD_PROP_FLOAT2, id);
     }
   }
-  /* Actually execute all tasks. */
-  threading::parallel_for(tasks.index_range(), 100, [&](const IndexRange task_range) {
-    for (const int task_index : task_range) {
-      const RealizeMeshTask &task = tasks[task_index];
-      execute_realize_mesh_task(options,
-                                task,
-                                ordered_attributes,
-                                dst_attribute_writers,
-                                dst_positions,
-                                dst_edges,
-                                dst_face_offsets,
-                                dst_corner_verts,
-                                dst_corner_edges,
-                                vertex_ids.span,
-                                material_indices.span);
-    }
+  /* Actually execute all tasks. Instances of very different sizes are often mixed, so balance the
+   * work by the number of realized vertices and face corners. */
+  const auto task_sizes = threading::accumulated_task_sizes([&](const IndexRange range) {
+    const MeshElementStartIndices &start = tasks[range.first()].start_indices;
+    const MeshElementStartIndices end = range.one_after_last() < tasks.size() ?
+                                            tasks[range.one_after_last()].start_indices :
+                                            MeshElementStartIndices{
+                                                tot_vertices, tot_edges, tot_faces, tot_loops};
+    return int64_t(end.vertex - start.vertex) + int64_t(end.loop - start.loop) +
+           range.size() * realize_task_overhead_size;
   });
+  threading::parallel_for(
+      tasks.index_range(),
+      realize_tasks_grain_size,
+      [&](const IndexRange task_range) {
+        for (const int task_index : task_range) {
+          const RealizeMeshTask &task = tasks[task_index];
+          execute_realize_mesh_task(options,
+                                    task,
+                                    ordered_attributes,
+                                    dst_attribute_writers,
+                                    dst_positions,
+                                    dst_edges,
+                                    dst_face_offsets,
+                                    dst_corner_verts,
+                                    dst_corner_edges,
+                                    vertex_ids.span,
+                                    material_indices.span);
+        }
+      },
+      task_sizes);
 
   /* Tag modified attributes. */
   for (GSpanAttributeWriter &dst_attribute : dst_attribute_writers) {
@@ -1899,25 +1933,37 @@ static void execute_realize_curve_tasks(const RealizeInstancesOptions &options,
         "custom_normal", bke::AttrDomain::Point);
   }
 
-  /* Actually execute all tasks. */
-  threading::parallel_for(tasks.index_range(), 100, [&](const IndexRange task_range) {
-    for (const int task_index : task_range) {
-      const RealizeCurveTask &task = tasks[task_index];
-      execute_realize_curve_task(options,
-                                 all_curves_info,
-                                 task,
-                                 ordered_attributes,
-                                 dst_curves,
-                                 dst_attribute_writers,
-                                 point_ids.span,
-                                 handle_left.span,
-                                 handle_right.span,
-                                 radius.span,
-                                 nurbs_weight.span,
-                                 resolution.span,
-                                 custom_normal.span);
-    }
+  /* Actually execute all tasks. Instances of very different sizes are often mixed, so balance the
+   * work by the number of realized points. */
+  const auto task_sizes = threading::accumulated_task_sizes([&](const IndexRange range) {
+    const int end = range.one_after_last() < tasks.size() ?
+                        tasks[range.one_after_last()].start_indices.point :
+                        points_num;
+    return int64_t(end - tasks[range.first()].start_indices.point) +
+           range.size() * realize_task_overhead_size;
   });
+  threading::parallel_for(
+      tasks.index_range(),
+      realize_tasks_grain_size,
+      [&](const IndexRange task_range) {
+        for (const int task_index : task_range) {
+          const RealizeCurveTask &task = tasks[task_index];
+          execute_realize_curve_task(options,
+                                     all_curves_info,
+                                     task,
+                                     ordered_attributes,
+                                     dst_curves,
+                                     dst_attribute_writers,
+                                     point_ids.span,
+                                     handle_left.span,
+                                     handle_right.span,
+                                     radius.span,
+                                     nurbs_weight.span,
+                                     resolution.span,
+                                     custom_normal.span);
+        }
+      },
+      task_sizes);
 
   /* Type counts have to be updated eagerly. */
   dst_curves.runtime->type_counts.fill(0);
@@ -54,6 +54,7 @@ bool GPU_shader_draw_parameters_support();
 bool GPU_hdr_support();
 bool GPU_texture_view_support();
 bool GPU_stencil_export_support();
+bool GPU_timer_query_support();
 
 bool GPU_mem_stats_supported();
 void GPU_mem_stats_get(int *r_totalmem, int *r_freemem);
@@ -88,3 +88,8 @@ void GPU_storagebuf_copy_sub_from_vertbuf(GPUStorageBuf *ssbo,
  * NOTE: Internally, this is only required for the OpenGL backend.
  */
 void GPU_storagebuf_sync_as_indirect_buffer(GPUStorageBuf *ssbo);
+
+/**
+ * Returns the size of all currently allocated storage buffers in bytes.
+ */
+size_t GPU_storagebuf_memory_usage_get();
@@ -1057,7 +1057,12 @@ const char *GPU_texture_format_name(eGPUTextureFormat format);
  * \note that does not mean all of the textures are inside VRAM. Drivers can swap the texture
  * memory back and forth depending on usage.
  */
-unsigned int GPU_texture_memory_usage_get();
+size_t GPU_texture_memory_usage_get();
+
+/**
+ * Returns the number of bytes used by the data of \a texture, including all its mip levels.
+ */
+size_t GPU_texture_memory_size(const GPUTexture *texture);
 
 /**
  * Update sampler states depending on user settings.
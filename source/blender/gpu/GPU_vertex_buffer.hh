@@ -284,7 +284,7 @@ void GPU_vertbuf_wrap_handle(blender::gpu::VertBuf *verts, uint64_t handle);
 void GPU_vertbuf_update_sub(blender::gpu::VertBuf *verts, uint start, uint len, const void *data);
 
 /* Metrics */
-uint GPU_vertbuf_get_memory_usage();
+size_t GPU_vertbuf_get_memory_usage();
 
 /* Macros */
 #define GPU_VERTBUF_DISCARD_SAFE(verts) \
@@ -16,6 +16,8 @@ namespace blender::gpu {
 
 enum GPUQueryType {
   GPU_QUERY_OCCLUSION = 0,
+  /** Only supported when #GPU_timer_query_support() returns true. */
+  GPU_QUERY_TIMESTAMP = 1,
 };
 
 class QueryPool {
@@ -41,6 +43,18 @@ class QueryPool {
    * drawn.
    */
   virtual void get_occlusion_result(MutableSpan<uint32_t> r_values) = 0;
+
+  /**
+   * Record the GPU time at which all previously submitted commands are completed. Only valid for
+   * #GPU_QUERY_TIMESTAMP pools, which do not use #begin_query and #end_query.
+   */
+  virtual void query_timestamp() = 0;
+
+  /**
+   * Must be fed with a buffer large enough to contain all the timestamps issued.
+   * Result for each query is in nanoseconds.
+   */
+  virtual void get_timestamp_result(MutableSpan<uint64_t> r_values) = 0;
 };
 
 }  // namespace blender::gpu
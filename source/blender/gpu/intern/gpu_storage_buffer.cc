@@ -28,18 +28,22 @@
 
 namespace blender::gpu {
 
+size_t StorageBuf::memory_usage = 0;
+
 StorageBuf::StorageBuf(size_t size, const char *name)
 {
   /* Make sure that UBO is padded to size of vec4 */
   BLI_assert((size % 16) == 0);
 
   size_in_bytes_ = size;
+  memory_usage += size_in_bytes_;
 
   STRNCPY(name_, name);
 }
 
 StorageBuf::~StorageBuf()
 {
+  memory_usage -= size_in_bytes_;
   MEM_SAFE_FREE(data_);
 }
 
@@ -125,4 +129,9 @@ void GPU_storagebuf_sync_as_indirect_buffer(GPUStorageBuf *ssbo)
   unwrap(ssbo)->sync_as_indirect_buffer();
 }
 
+size_t GPU_storagebuf_memory_usage_get()
+{
+  return StorageBuf::memory_usage;
+}
+
 /** \} */
@@ -29,6 +29,10 @@ class VertBuf;
  * Base class which is then specialized for each implementation (GL, VK, ...).
  */
 class StorageBuf {
+ public:
+  /** Sum of the sizes of all storage buffers, in bytes. */
+  static size_t memory_usage;
+
  protected:
   /** Data size in bytes. */
   size_t size_in_bytes_;
@@ -39,8 +39,12 @@ Texture::Texture(const char *name)
   gpu_image_usage_flags_ = GPU_TEXTURE_USAGE_GENERAL;
 }
 
+size_t Texture::memory_usage = 0;
+
 Texture::~Texture()
 {
+  memory_usage -= memory_size_;
+
   for (int i = 0; i < ARRAY_SIZE(fb_); i++) {
     if (fb_[i] != nullptr) {
       fb_[i]->attachment_remove(fb_attachment_[i]);
@@ -54,6 +58,25 @@ Texture::~Texture()
 #endif
 }
 
+size_t Texture::memory_size_calc() const
+{
+  const bool is_compressed = (format_flag_ & GPU_FORMAT_COMPRESSED) != 0;
+  size_t size = 0;
+  for (int mip = 0; mip < max_ii(1, mipmaps_); mip++) {
+    int extent[3] = {1, 1, 1};
+    this->mip_size_get(mip, extent);
+    if (is_compressed) {
+      /* Compressed formats are stored in blocks of 4x4 pixels. */
+      size += size_t(divide_ceil_u(extent[0], 4)) * size_t(divide_ceil_u(extent[1], 4)) *
+              size_t(extent[2]) * to_block_size(format_);
+    }
+    else {
+      size += size_t(extent[0]) * size_t(extent[1]) * size_t(extent[2]) * to_bytesize(format_);
+    }
+  }
+  return size;
+}
+
 bool Texture::init_1D(int w, int layers, int mip_len, eGPUTextureFormat format)
 {
   w_ = w;
@@ -245,10 +268,14 @@ using namespace blender::gpu;
 
 /* ------ Memory Management ------ */
 
-uint GPU_texture_memory_usage_get()
+size_t GPU_texture_memory_usage_get()
+{
+  return Texture::memory_usage;
+}
+
+size_t GPU_texture_memory_size(const GPUTexture *tex)
 {
-  /* TODO(fclem): Do that inside the new Texture class. */
-  return 0;
+  return reinterpret_cast<const Texture *>(tex)->memory_size_calc();
 }
 
 /* ------ Creation ------ */
@@ -293,6 +320,7 @@ static inline GPUTexture *gpu_texture_create(const char *name,
     delete tex;
     return nullptr;
   }
+  tex->memory_usage_track();
   if (pixels) {
     tex->update(data_format, pixels);
   }
@@ -399,6 +427,7 @@ GPUTexture *GPU_texture_create_compressed_2d(const char *name,
     delete tex;
     return nullptr;
   }
+  tex->memory_usage_track();
   if (data) {
     size_t ofs = 0;
     for (int mip = 0; mip < miplen; mip++) {
@@ -83,6 +83,9 @@ ENUM_OPERATORS(eGPUSamplerFormat, GPU_SAMPLER_TYPE_UINT)
  */
 class Texture {
  public:
+  /** Sum of #memory_size_ of all textures, in bytes. */
+  static size_t memory_usage;
+
   /** Internal Sampler state. */
   GPUSamplerState sampler_state = GPUSamplerState::default_sampler();
   /** Reference counter. */
@@ -115,6 +118,8 @@ class Texture {
   int mipmaps_ = -1;
   /** For error checking */
   int mip_min_ = 0, mip_max_ = 0;
+  /** Size of the texture data counted in #memory_usage. Zero for views and buffer textures. */
+  size_t memory_size_ = 0;
 
   /** For debugging */
   char name_[DEBUG_NAME_LEN];
@@ -252,6 +257,15 @@ class Texture {
     return mipmaps_;
   }
 
+  /** Number of bytes used by the texture data, including all mip levels. */
+  size_t memory_size_calc() const;
+  /** Start counting the texture data in #memory_usage, once the texture is initialized. */
+  void memory_usage_track()
+  {
+    memory_size_ = memory_size_calc();
+    memory_usage += memory_size_;
+  }
+
   eGPUTextureFormat format_get() const
   {
     return format_;
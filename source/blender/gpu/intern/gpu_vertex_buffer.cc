@@ -302,7 +302,7 @@ void GPU_vertbuf_tag_dirty(VertBuf *verts)
   verts->flag |= GPU_VERTBUF_DATA_DIRTY;
 }
 
-uint GPU_vertbuf_get_memory_usage()
+size_t GPU_vertbuf_get_memory_usage()
 {
   return VertBuf::memory_usage;
 }
@@ -126,4 +126,16 @@ void MTLQueryPool::get_occlusion_result(MutableSpan<uint32_t> r_values)
   ctx->set_visibility_buffer(nullptr);
 }
 
+void MTLQueryPool::query_timestamp()
+{
+  /* Counter sample buffers are not used, #GCaps.timer_query_support is false. */
+  BLI_assert_unreachable();
+}
+
+void MTLQueryPool::get_timestamp_result(MutableSpan<uint64_t> r_values)
+{
+  BLI_assert_unreachable();
+  r_values.fill(0);
+}
+
 }  // namespace blender::gpu
@@ -33,16 +33,22 @@ void GLQueryPool::reset(GPUQueryType type)
 }
 #endif
 
-void GLQueryPool::begin_query()
+GLuint GLQueryPool::query_next()
 {
-  /* TODO: add assert about expected usage. */
   while (query_issued_ >= query_ids_.size()) {
     int64_t prev_size = query_ids_.size();
     int64_t chunk_size = prev_size == 0 ? query_ids_.capacity() : QUERY_CHUNCK_LEN;
     query_ids_.resize(prev_size + chunk_size);
     glGenQueries(chunk_size, &query_ids_[prev_size]);
   }
-  glBeginQuery(gl_type_, query_ids_[query_issued_++]);
+  return query_ids_[query_issued_++];
+}
+
+void GLQueryPool::begin_query()
+{
+  /* TODO: add assert about expected usage. */
+  BLI_assert(type_ != GPU_QUERY_TIMESTAMP);
+  glBeginQuery(gl_type_, query_next());
 }
 
 void GLQueryPool::end_query()
@@ -61,4 +67,23 @@ void GLQueryPool::get_occlusion_result(MutableSpan<uint32_t> r_values)
   }
 }
 
+void GLQueryPool::query_timestamp()
+{
+  BLI_assert(type_ == GPU_QUERY_TIMESTAMP);
+  glQueryCounter(query_next(), GL_TIMESTAMP);
+}
+
+void GLQueryPool::get_timestamp_result(MutableSpan<uint64_t> r_values)
+{
+  BLI_assert(type_ == GPU_QUERY_TIMESTAMP);
+  BLI_assert(r_values.size() == query_issued_);
+
+  for (int i = 0; i < query_issued_; i++) {
+    /* NOTE: This is a sync point. */
+    GLuint64 value = 0;
+    glGetQueryObjectui64v(query_ids_[i], GL_QUERY_RESULT, &value);
+    r_values[i] = value;
+  }
+}
+
 }  // namespace blender::gpu
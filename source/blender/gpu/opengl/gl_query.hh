@@ -39,6 +39,13 @@ class GLQueryPool : public QueryPool {
   void end_query() override;
 
   void get_occlusion_result(MutableSpan<uint32_t> r_values) override;
+
+  void query_timestamp() override;
+  void get_timestamp_result(MutableSpan<uint64_t> r_values) override;
+
+ private:
+  /** Return the next unused query object, allocating more when needed. */
+  GLuint query_next();
 };
 
 static inline GLenum to_gl(GPUQueryType type)
@@ -47,6 +54,9 @@ static inline GLenum to_gl(GPUQueryType type)
     /* TODO(fclem): try with GL_ANY_SAMPLES_PASSED​. */
     return GL_SAMPLES_PASSED;
   }
+  if (type == GPU_QUERY_TIMESTAMP) {
+    return GL_TIMESTAMP;
+  }
   BLI_assert(0);
   return GL_SAMPLES_PASSED;
 }
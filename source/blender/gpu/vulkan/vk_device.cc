@@ -19,7 +19,13 @@
 
 #include "GPU_capabilities.hh"
 
+#include "MEM_guardedalloc.h"
+
+#include "BKE_appdir.hh"
+
+#include "BLI_fileops.h"
 #include "BLI_math_matrix_types.hh"
+#include "BLI_path_util.h"
 
 #include "GHOST_C-api.h"
 
@@ -52,6 +58,7 @@ void VKDevice::deinit()
     thread_data_.clear();
   }
   pipelines.free_data();
+  write_pipeline_cache();
   vkDestroyPipelineCache(vk_device_, vk_pipeline_cache_, vk_allocation_callbacks);
   descriptor_set_layouts_.deinit();
   vmaDestroyAllocator(mem_allocator_);
@@ -183,12 +190,109 @@ void VKDevice::init_memory_allocator()
   vmaCreateAllocator(&info, &mem_allocator_);
 }
 
+/**
+ * Pipelines compiled in previous sessions are stored in the user cache folder, so shaders of
+ * scenes that were opened before don't have to be compiled by the driver again.
+ */
+static std::string pipeline_cache_filepath_get()
+{
+  char cache_dir[FILE_MAX];
+  if (!BKE_appdir_folder_caches(cache_dir, sizeof(cache_dir))) {
+    return "";
+  }
+  char filepath[FILE_MAX];
+  BLI_path_join(filepath, sizeof(filepath), cache_dir, "vk-pipeline-cache.bin");
+  return filepath;
+}
+
+/** Don't let the cache file grow without limits, drivers don't remove unused pipelines. */
+constexpr size_t PIPELINE_CACHE_SIZE_MAX = 256 * 1024 * 1024;
+
+/**
+ * Drivers validate the cache data themselves, but not all of them are robust against data of
+ * other devices or driver versions, so only pass data that was written for this one.
+ */
+static bool pipeline_cache_is_compatible(const VkPhysicalDeviceProperties &properties,
+                                         const void *data,
+                                         const size_t data_size)
+{
+  if (data_size < sizeof(VkPipelineCacheHeaderVersionOne)) {
+    return false;
+  }
+  VkPipelineCacheHeaderVersionOne header;
+  memcpy(&header, data, sizeof(header));
+  return header.headerSize >= sizeof(header) &&
+         header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+         header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+         memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
 void VKDevice::init_pipeline_cache()
 {
   VK_ALLOCATION_CALLBACKS;
   VkPipelineCacheCreateInfo create_info = {};
   create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-  vkCreatePipelineCache(vk_device_, &create_info, vk_allocation_callbacks, &vk_pipeline_cache_);
+
+  void *cache_data = nullptr;
+  const std::string filepath = pipeline_cache_filepath_get();
+  if (!filepath.empty() && BLI_exists(filepath.c_str())) {
+    size_t cache_data_size = 0;
+    cache_data = BLI_file_read_binary_as_mem(filepath.c_str(), 0, &cache_data_size);
+    if (cache_data &&
+        pipeline_cache_is_compatible(vk_physical_device_properties_, cache_data, cache_data_size))
+    {
+      create_info.initialDataSize = cache_data_size;
+      create_info.pInitialData = cache_data;
+    }
+  }
+
+  if (vkCreatePipelineCache(
+          vk_device_, &create_info, vk_allocation_callbacks, &vk_pipeline_cache_) != VK_SUCCESS &&
+      create_info.pInitialData != nullptr)
+  {
+    /* Fall back to an empty cache when the driver rejects the data. */
+    create_info.initialDataSize = 0;
+    create_info.pInitialData = nullptr;
+    vkCreatePipelineCache(vk_device_, &create_info, vk_allocation_callbacks, &vk_pipeline_cache_);
+  }
+  MEM_SAFE_FREE(cache_data);
+}
+
+void VKDevice::write_pipeline_cache() const
+{
+  const std::string filepath = pipeline_cache_filepath_get();
+  if (filepath.empty() || vk_pipeline_cache_ == VK_NULL_HANDLE) {
+    return;
+  }
+  size_t data_size = 0;
+  if (vkGetPipelineCacheData(vk_device_, vk_pipeline_cache_, &data_size, nullptr) != VK_SUCCESS ||
+      data_size == 0 || data_size > PIPELINE_CACHE_SIZE_MAX)
+  {
+    return;
+  }
+  Array<uint8_t> data(data_size);
+  if (vkGetPipelineCacheData(vk_device_, vk_pipeline_cache_, &data_size, data.data()) !=
+      VK_SUCCESS)
+  {
+    return;
+  }
+
+  /* Write to a temporary file first, other instances of Blender may read the cache. */
+  const std::string filepath_temp = filepath + "@";
+  if (!BLI_file_ensure_parent_dir_exists(filepath_temp.c_str())) {
+    return;
+  }
+  FILE *file = BLI_fopen(filepath_temp.c_str(), "wb");
+  if (file == nullptr) {
+    return;
+  }
+  const bool success = fwrite(data.data(), 1, data_size, file) == data_size;
+  if ((fclose(file) == 0) && success) {
+    BLI_rename_overwrite(filepath_temp.c_str(), filepath.c_str());
+  }
+  else {
+    BLI_delete(filepath_temp.c_str(), false, false);
+  }
 }
 
 void VKDevice::init_dummy_buffer(VKContext &context)
@@ -305,6 +305,8 @@ class VKDevice : public NonCopyable {
   void init_debug_callbacks();
   void init_memory_allocator();
   void init_pipeline_cache();
+  /** Store the pipeline cache on disk, to be loaded by #init_pipeline_cache in a next session. */
+  void write_pipeline_cache() const;
   /**
    * Initialize the functions struct with extension specific function pointer.
    */
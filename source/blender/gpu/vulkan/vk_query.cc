@@ -119,4 +119,16 @@ void VKQueryPool::get_occlusion_result(MutableSpan<uint32_t> r_values)
   }
 }
 
+void VKQueryPool::query_timestamp()
+{
+  /* Timestamps are not recorded by the render graph, #GCaps.timer_query_support is false. */
+  BLI_assert_unreachable();
+}
+
+void VKQueryPool::get_timestamp_result(MutableSpan<uint64_t> r_values)
+{
+  BLI_assert_unreachable();
+  r_values.fill(0);
+}
+
 }  // namespace blender::gpu
@@ -30,6 +30,8 @@ class VKQueryPool : public QueryPool {
   void begin_query() override;
   void end_query() override;
   void get_occlusion_result(MutableSpan<uint32_t> r_values) override;
+  void query_timestamp() override;
+  void get_timestamp_result(MutableSpan<uint64_t> r_values) override;
 
  private:
   uint32_t query_index_in_pool() const;
@@ -21,6 +21,9 @@ namespace blender::gpu {
 VKVertexBuffer::~VKVertexBuffer()
 {
   release_data();
+  if (buffer_.is_allocated()) {
+    memory_usage -= buffer_.size_in_bytes();
+  }
 }
 
 void VKVertexBuffer::bind_as_ssbo(uint binding)
@@ -214,6 +217,9 @@ void VKVertexBuffer::allocate()
 
   buffer_.create(size_alloc_get(), GPU_USAGE_STATIC, vk_buffer_usage, false);
   debug::object_label(buffer_.vk_handle(), "VertexBuffer");
+  if (buffer_.is_allocated()) {
+    memory_usage += buffer_.size_in_bytes();
+  }
 }
 
 }  // namespace blender::gpu
@@ -95,6 +95,9 @@ enum eImBufFlags {
   IB_multilayer = 1 << 7,
   IB_metadata = 1 << 8,
   IB_animdeinterlace = 1 << 9,
+  /** Decode movies with a hardware device when one is available (not combined with
+   * de-interlacing), falling back to software decoding. */
+  IB_animhwdecode = 1 << 11,
   /** Do not clear image pixel buffer to zero. Without this flag, allocating
    * a new ImBuf does clear the pixel data to zero (transparent black). If
    * whole pixel data is overwritten after allocation, then this flag can be
@@ -41,6 +41,14 @@ void IMB_moviecache_set_priority_callback(MovieCache *cache,
                                           MovieCachePriorityDeleterFP prioritydeleterfp);
 
 void IMB_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf);
+/**
+ * Same as #IMB_moviecache_put, with the time in seconds it took to create the image buffer.
+ *
+ * In caches without priority callback, buffers are freed in least recently used order when the
+ * memory limit is reached. Buffers which take longer to create per byte of memory are kept for
+ * longer, #IMB_moviecache_put uses a cost of zero.
+ */
+void IMB_moviecache_put_ex(MovieCache *cache, void *userkey, ImBuf *ibuf, float cost);
 bool IMB_moviecache_put_if_possible(MovieCache *cache, void *userkey, ImBuf *ibuf);
 ImBuf *IMB_moviecache_get(MovieCache *cache, void *userkey, bool *r_is_cached_empty);
 void IMB_moviecache_remove(MovieCache *cache, void *userkey);
@@ -47,6 +47,11 @@ struct ImBufAnim {
   AVFrame *pFrameRGB;
   AVFrame *pFrameDeinterlaced;
   SwsContext *img_convert_ctx;
+  /** Pixel format #img_convert_ctx converts from, an `AVPixelFormat`. */
+  int img_convert_src_format;
+  /** Pixel format of frames decoded by the hardware device, `AV_PIX_FMT_NONE` when decoding in
+   * software. */
+  int hw_pix_fmt;
   int videoStream;
 
   AVFrame *pFrame;
@@ -44,7 +44,9 @@ extern "C" {
 #  include <libavcodec/avcodec.h>
 #  include <libavformat/avformat.h>
 #  include <libavutil/cpu.h>
+#  include <libavutil/hwcontext.h>
 #  include <libavutil/imgutils.h>
+#  include <libavutil/pixdesc.h>
 #  include <libavutil/rational.h>
 #  include <libswscale/swscale.h>
 
@@ -162,6 +164,131 @@ void IMB_suffix_anim(ImBufAnim *anim, const char *suffix)
 
 #ifdef WITH_FFMPEG
 
+/**
+ * Hardware device types used for decoding when #IB_animhwdecode is set, in order of preference.
+ * Frames are copied back to system memory after decoding, so only the device types which are
+ * available on the platform matter, the rest of the pipeline does not change.
+ */
+static const AVHWDeviceType ffmpeg_hw_device_types[] = {
+    AV_HWDEVICE_TYPE_VIDEOTOOLBOX,
+    AV_HWDEVICE_TYPE_D3D11VA,
+    AV_HWDEVICE_TYPE_CUDA,
+    AV_HWDEVICE_TYPE_VAAPI,
+};
+
+static AVPixelFormat ffmpeg_hw_get_format(AVCodecContext *codec_ctx, const AVPixelFormat *pix_fmts)
+{
+  const ImBufAnim *anim = static_cast<const ImBufAnim *>(codec_ctx->opaque);
+  for (const AVPixelFormat *pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if (*pix_fmt == anim->hw_pix_fmt) {
+      return *pix_fmt;
+    }
+  }
+  /* The device can't decode the stream (profile, bit depth or resolution), fall back to the
+   * first software format. */
+  for (const AVPixelFormat *pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if ((av_pix_fmt_desc_get(*pix_fmt)->flags & AV_PIX_FMT_FLAG_HWACCEL) == 0) {
+      return *pix_fmt;
+    }
+  }
+  return AV_PIX_FMT_NONE;
+}
+
+/**
+ * Attach the first hardware device which supports the codec to the codec context. Decoding stays
+ * in software when no device can be created.
+ */
+static void ffmpeg_hw_decoder_setup(ImBufAnim *anim, const AVCodec *codec, AVCodecContext *ctx)
+{
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+  /* De-interlacing works on the pixel format of the stream. */
+  if ((anim->ib_flags & IB_animhwdecode) == 0 || (anim->ib_flags & IB_animdeinterlace)) {
+    return;
+  }
+
+  for (const AVHWDeviceType device_type : ffmpeg_hw_device_types) {
+    for (int i = 0;; i++) {
+      const AVCodecHWConfig *config = avcodec_get_hw_config(codec, i);
+      if (config == nullptr) {
+        break;
+      }
+      if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) == 0 ||
+          config->device_type != device_type)
+      {
+        continue;
+      }
+      AVBufferRef *device_ctx = nullptr;
+      if (av_hwdevice_ctx_create(&device_ctx, device_type, nullptr, nullptr, 0) < 0) {
+        break;
+      }
+      /* The codec context owns the reference and releases it when freed. */
+      ctx->hw_device_ctx = device_ctx;
+      ctx->opaque = anim;
+      ctx->get_format = ffmpeg_hw_get_format;
+      anim->hw_pix_fmt = config->pix_fmt;
+      av_log(ctx,
+             AV_LOG_INFO,
+             "Using %s hardware decoding\n",
+             av_hwdevice_get_type_name(device_type));
+      return;
+    }
+  }
+}
+
+/**
+ * Get a scaling context converting frames of the \a src_format to RGBA, with the color range
+ * and coefficients of the stream.
+ */
+static SwsContext *ffmpeg_sws_context_create(ImBufAnim *anim, const int src_format)
+{
+  /* The following for color space determination */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+
+  SwsContext *img_convert_ctx = BKE_ffmpeg_sws_get_context(anim->x,
+                                                           anim->y,
+                                                           src_format,
+                                                           AV_PIX_FMT_RGBA,
+                                                           SWS_BILINEAR | SWS_PRINT_INFO |
+                                                               SWS_FULL_CHR_H_INT);
+  if (!img_convert_ctx) {
+    return nullptr;
+  }
+  anim->img_convert_src_format = src_format;
+
+  /* Try do detect if input has 0-255 YCbCR range (JFIF, JPEG, Motion-JPEG). */
+  if (!sws_getColorspaceDetails(img_convert_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation))
+  {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(img_convert_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation))
+    {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+
+  return img_convert_ctx;
+}
+
 static int startffmpeg(ImBufAnim *anim)
 {
   int i, video_stream_index;
@@ -175,11 +302,6 @@ static int startffmpeg(ImBufAnim *anim)
   double frs_den;
   int streamcount;
 
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-
   if (anim == nullptr) {
     return (-1);
   }
@@ -243,6 +365,8 @@ static int startffmpeg(ImBufAnim *anim)
     pCodecCtx->thread_type = FF_THREAD_SLICE;
   }
 
+  ffmpeg_hw_decoder_setup(anim, pCodec, pCodecCtx);
+
   if (avcodec_open2(pCodecCtx, pCodec, nullptr) < 0) {
     avformat_close_input(&pFormatCtx);
     return -1;
@@ -415,12 +539,7 @@ static int startffmpeg(ImBufAnim *anim)
         1);
   }
 
-  anim->img_convert_ctx = BKE_ffmpeg_sws_get_context(anim->x,
-                                                     anim->y,
-                                                     anim->pCodecCtx->pix_fmt,
-                                                     AV_PIX_FMT_RGBA,
-                                                     SWS_BILINEAR | SWS_PRINT_INFO |
-                                                         SWS_FULL_CHR_H_INT);
+  anim->img_convert_ctx = ffmpeg_sws_context_create(anim, anim->pCodecCtx->pix_fmt);
 
   if (!anim->img_convert_ctx) {
     fprintf(stderr, "Can't transform color space??? Bailing out...\n");
@@ -435,35 +554,6 @@ static int startffmpeg(ImBufAnim *anim)
     return -1;
   }
 
-  /* Try do detect if input has 0-255 YCbCR range (JFIF, JPEG, Motion-JPEG). */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation))
-  {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation))
-    {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
-
   return 0;
 }
 
@@ -549,6 +639,18 @@ static void ffmpeg_postprocess(ImBufAnim *anim, AVFrame *input, ImBuf *ibuf)
          input->data[2],
          input->data[3]);
 
+  if (input->format != anim->img_convert_src_format) {
+    /* Frames copied from a hardware device use the transfer format of the device (e.g. NV12 or
+     * P010), which is only known once the first frame is decoded. */
+    SwsContext *img_convert_ctx = ffmpeg_sws_context_create(anim, input->format);
+    if (!img_convert_ctx) {
+      fprintf(stderr, "ffmpeg_fetchibuf: can't convert from the decoded pixel format\n");
+      return;
+    }
+    BKE_ffmpeg_sws_release_context(anim->img_convert_ctx);
+    anim->img_convert_ctx = img_convert_ctx;
+  }
+
   if (anim->ib_flags & IB_animdeinterlace) {
     if (av_image_deinterlace(anim->pFrameDeinterlaced,
                              anim->pFrame,
@@ -685,6 +787,35 @@ static int ffmpeg_read_video_frame(ImBufAnim *anim, AVPacket *packet)
   return ret;
 }
 
+/**
+ * Copy the frame from the hardware device to system memory, frames decoded in software are
+ * left as they are.
+ */
+static bool ffmpeg_hw_frame_transfer(ImBufAnim *anim)
+{
+  if (anim->pFrame->format != anim->hw_pix_fmt) {
+    return true;
+  }
+  AVFrame *sw_frame = av_frame_alloc();
+  if (av_hwframe_transfer_data(sw_frame, anim->pFrame, 0) < 0 ||
+      av_frame_copy_props(sw_frame, anim->pFrame) < 0)
+  {
+    av_log(anim->pFormatCtx, AV_LOG_ERROR, "  HARDWARE FRAME TRANSFER FAILED\n");
+    av_frame_free(&sw_frame);
+    return false;
+  }
+  av_frame_unref(anim->pFrame);
+  av_frame_move_ref(anim->pFrame, sw_frame);
+  av_frame_free(&sw_frame);
+  return true;
+}
+
+static bool ffmpeg_receive_frame(ImBufAnim *anim)
+{
+  return avcodec_receive_frame(anim->pCodecCtx, anim->pFrame) == 0 &&
+         ffmpeg_hw_frame_transfer(anim);
+}
+
 /* decode one video frame also considering the packet read into cur_packet */
 static int ffmpeg_decode_video_frame(ImBufAnim *anim)
 {
@@ -692,7 +823,7 @@ static int ffmpeg_decode_video_frame(ImBufAnim *anim)
 
   /* Sometimes, decoder returns more than one frame per sent packet. Check if frames are available.
    * This frames must be read, otherwise decoding will fail. See #91405. */
-  anim->pFrame_complete = avcodec_receive_frame(anim->pCodecCtx, anim->pFrame) == 0;
+  anim->pFrame_complete = ffmpeg_receive_frame(anim);
   if (anim->pFrame_complete) {
     av_log(anim->pFormatCtx, AV_LOG_DEBUG, "  DECODE FROM CODEC BUFFER\n");
     ffmpeg_decode_store_frame_pts(anim);
@@ -719,7 +850,7 @@ static int ffmpeg_decode_video_frame(ImBufAnim *anim)
            (anim->cur_packet->flags & AV_PKT_FLAG_KEY) ? " KEY" : "");
 
     avcodec_send_packet(anim->pCodecCtx, anim->cur_packet);
-    anim->pFrame_complete = avcodec_receive_frame(anim->pCodecCtx, anim->pFrame) == 0;
+    anim->pFrame_complete = ffmpeg_receive_frame(anim);
 
     if (anim->pFrame_complete) {
       ffmpeg_decode_store_frame_pts(anim);
@@ -732,7 +863,7 @@ static int ffmpeg_decode_video_frame(ImBufAnim *anim)
   if (rval == AVERROR_EOF) {
     /* Flush any remaining frames out of the decoder. */
     avcodec_send_packet(anim->pCodecCtx, nullptr);
-    anim->pFrame_complete = avcodec_receive_frame(anim->pCodecCtx, anim->pFrame) == 0;
+    anim->pFrame_complete = ffmpeg_receive_frame(anim);
 
     if (anim->pFrame_complete) {
       ffmpeg_decode_store_frame_pts(anim);
@@ -29,6 +29,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_map.hh"
 #include "BLI_math_color.h"
 #include "BLI_math_color.hh"
 #include "BLI_rect.h"
@@ -100,8 +101,20 @@ struct ColormanageProcessor {
   OCIO_ConstCPUProcessorRcPtr *cpu_processor;
   CurveMapping *curve_mapping;
   bool is_data_result;
+  /** #cpu_processor is owned by #global_display_processors and is not freed with this. */
+  bool cpu_processor_is_cached;
 };
 
+/**
+ * Display processors without exposure, gamma or white balance adjustments, by look, view,
+ * display and input color space. Those are the processors used to display most images, building
+ * them for every image which is drawn takes longer than applying them to small images.
+ *
+ * Adjusted processors are not cached, their settings are mostly changed interactively, there
+ * would be a cached processor for every step of the adjustment. Protected by #processor_lock.
+ */
+static blender::Map<std::string, OCIO_ConstCPUProcessorRcPtr *> global_display_processors;
+
 static struct global_gpu_state {
   /* GPU shader currently bound. */
   bool gpu_shader_bound;
@@ -756,6 +769,11 @@ void colormanagement_exit()
   memset(&global_gpu_state, 0, sizeof(global_gpu_state));
   memset(&global_color_picking_state, 0, sizeof(global_color_picking_state));
 
+  for (OCIO_ConstCPUProcessorRcPtr *cpu_processor : global_display_processors.values()) {
+    OCIO_cpuProcessorRelease(cpu_processor);
+  }
+  global_display_processors.clear_and_shrink();
+
   colormanage_free_config();
   OCIO_exit();
 }
@@ -923,6 +941,61 @@ static OCIO_ConstCPUProcessorRcPtr *create_display_buffer_processor(const char *
   return cpu_processor;
 }
 
+/**
+ * Same as #create_display_buffer_processor, using the cached processor when there are no
+ * adjustments. \a r_is_cached is set when the processor is owned by the cache.
+ */
+static OCIO_ConstCPUProcessorRcPtr *display_buffer_processor_get(const char *look,
+                                                                 const char *view_transform,
+                                                                 const char *display,
+                                                                 const float exposure,
+                                                                 const float gamma,
+                                                                 const float temperature,
+                                                                 const float tint,
+                                                                 const bool use_white_balance,
+                                                                 const char *from_colorspace,
+                                                                 bool *r_is_cached)
+{
+  *r_is_cached = false;
+  if (exposure != 0.0f || gamma != 1.0f || use_white_balance) {
+    return create_display_buffer_processor(look,
+                                           view_transform,
+                                           display,
+                                           exposure,
+                                           gamma,
+                                           temperature,
+                                           tint,
+                                           use_white_balance,
+                                           from_colorspace);
+  }
+
+  const bool use_look = colormanage_use_look(look, view_transform);
+  std::string key = std::string(use_look ? look : "") + '\n' + view_transform + '\n' + display +
+                    '\n' + from_colorspace;
+
+  BLI_mutex_lock(&processor_lock);
+  OCIO_ConstCPUProcessorRcPtr *cpu_processor = global_display_processors.lookup_default(key,
+                                                                                      nullptr);
+  if (cpu_processor == nullptr) {
+    cpu_processor = create_display_buffer_processor(look,
+                                                    view_transform,
+                                                    display,
+                                                    exposure,
+                                                    gamma,
+                                                    temperature,
+                                                    tint,
+                                                    use_white_balance,
+                                                    from_colorspace);
+    if (cpu_processor != nullptr) {
+      global_display_processors.add_new(std::move(key), cpu_processor);
+    }
+  }
+  BLI_mutex_unlock(&processor_lock);
+
+  *r_is_cached = cpu_processor != nullptr;
+  return cpu_processor;
+}
+
 static OCIO_ConstProcessorRcPtr *create_colorspace_transform_processor(const char *from_colorspace,
                                                                        const char *to_colorspace)
 {
@@ -3994,7 +4067,7 @@ ColormanageProcessor *IMB_colormanagement_display_processor_new(
   }
 
   const bool use_white_balance = applied_view_settings->flag & COLORMANAGE_VIEW_USE_WHITE_BALANCE;
-  cm_processor->cpu_processor = create_display_buffer_processor(
+  cm_processor->cpu_processor = display_buffer_processor_get(
       applied_view_settings->look,
       applied_view_settings->view_transform,
       display_settings->display_device,
@@ -4003,7 +4076,8 @@ ColormanageProcessor *IMB_colormanagement_display_processor_new(
       applied_view_settings->temperature,
       applied_view_settings->tint,
       use_white_balance,
-      global_role_scene_linear);
+      global_role_scene_linear,
+      &cm_processor->cpu_processor_is_cached);
 
   if (applied_view_settings->flag & COLORMANAGE_VIEW_USE_CURVES) {
     cm_processor->curve_mapping = BKE_curvemapping_copy(applied_view_settings->curve_mapping);
@@ -4177,7 +4251,7 @@ void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
   if (cm_processor->curve_mapping) {
     BKE_curvemapping_free(cm_processor->curve_mapping);
   }
-  if (cm_processor->cpu_processor) {
+  if (cm_processor->cpu_processor && !cm_processor->cpu_processor_is_cached) {
     OCIO_cpuProcessorRelease(cm_processor->cpu_processor);
   }
 
@@ -8,6 +8,8 @@
 
 #undef DEBUG_MESSAGES
 
+#include <algorithm>
+#include <climits>
 #include <cstdlib> /* for qsort */
 #include <memory.h>
 #include <mutex>
@@ -43,6 +45,9 @@ static MEM_CacheLimiterC *limitor = nullptr;
  * so regular mutex will not work here, hence the recursive lock. */
 static std::recursive_mutex limitor_lock;
 
+/** Incremented for every put and get of a buffer, protected by #limitor_lock. */
+static uint64_t limitor_access_clock = 0;
+
 struct MovieCache {
   char name[64];
 
@@ -79,6 +84,10 @@ struct MovieCacheItem {
   void *priority_data;
   /* Indicates that #ibuf is null, because there was an error during load. */
   bool added_empty;
+  /** Time in seconds it took to create #ibuf. */
+  float cost;
+  /** Value of #limitor_access_clock when #ibuf was last put or used. */
+  uint64_t last_access;
 };
 
 static uint moviecache_hashhash(const void *keyv)
@@ -213,13 +222,26 @@ static int get_item_priority(void *item_v, int default_priority)
   int priority;
 
   if (!cache->getitempriorityfp) {
-    PRINT("%s: cache '%s' item %p use default priority %d\n",
+    /* The cache limiter passes the insertion order as default priority, use the access order
+     * instead. The age of buffers is divided by the milliseconds it took to create every megabyte
+     * of them, so buffers which are expensive to recreate are kept for longer. */
+    double age = double(limitor_access_clock - item->last_access);
+    if (item->ibuf && item->cost > 0.0f) {
+      const double size_in_mb = std::max(double(get_size_in_memory(item->ibuf)) / (1 << 20),
+                                         1.0);
+      age /= 1.0 + (item->cost * 1000.0) / size_in_mb;
+    }
+    priority = -int(std::min(age, double(INT_MAX)));
+
+    PRINT("%s: cache '%s' item %p use access order priority %d (default %d)\n",
           __func__,
           cache->name,
           item,
+          priority,
           default_priority);
+    UNUSED_VARS(default_priority);
 
-    return default_priority;
+    return priority;
   }
 
   priority = cache->getitempriorityfp(cache->last_userkey, item->priority_data);
@@ -306,7 +328,8 @@ void IMB_moviecache_set_priority_callback(MovieCache *cache,
   cache->prioritydeleterfp = prioritydeleterfp;
 }
 
-static void do_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf, bool need_lock)
+static void do_moviecache_put(
+    MovieCache *cache, void *userkey, ImBuf *ibuf, const float cost, bool need_lock)
 {
   MovieCacheKey *key;
   MovieCacheItem *item;
@@ -333,6 +356,8 @@ static void do_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf, boo
   item->c_handle = nullptr;
   item->priority_data = nullptr;
   item->added_empty = ibuf == nullptr;
+  item->cost = cost;
+  item->last_access = 0;
 
   if (cache->getprioritydatafp) {
     item->priority_data = cache->getprioritydatafp(userkey);
@@ -348,6 +373,7 @@ static void do_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf, boo
     limitor_lock.lock();
   }
 
+  item->last_access = ++limitor_access_clock;
   item->c_handle = MEM_CacheLimiter_insert(limitor, item);
 
   MEM_CacheLimiter_ref(item->c_handle);
@@ -366,7 +392,12 @@ static void do_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf, boo
 
 void IMB_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf)
 {
-  do_moviecache_put(cache, userkey, ibuf, true);
+  do_moviecache_put(cache, userkey, ibuf, 0.0f, true);
+}
+
+void IMB_moviecache_put_ex(MovieCache *cache, void *userkey, ImBuf *ibuf, const float cost)
+{
+  do_moviecache_put(cache, userkey, ibuf, cost, true);
 }
 
 bool IMB_moviecache_put_if_possible(MovieCache *cache, void *userkey, ImBuf *ibuf)
@@ -381,7 +412,7 @@ bool IMB_moviecache_put_if_possible(MovieCache *cache, void *userkey, ImBuf *ibu
   mem_in_use = MEM_CacheLimiter_get_memory_in_use(limitor);
 
   if (mem_in_use + elem_size <= mem_limit) {
-    do_moviecache_put(cache, userkey, ibuf, false);
+    do_moviecache_put(cache, userkey, ibuf, 0.0f, false);
     result = true;
   }
 
@@ -415,6 +446,7 @@ ImBuf *IMB_moviecache_get(MovieCache *cache, void *userkey, bool *r_is_cached_em
     if (item->ibuf) {
       limitor_lock.lock();
       MEM_CacheLimiter_touch(item->c_handle);
+      item->last_access = ++limitor_access_clock;
       limitor_lock.unlock();
 
       IMB_refImBuf(item->ibuf);
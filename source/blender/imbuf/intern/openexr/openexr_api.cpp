@@ -50,6 +50,7 @@
 #include <OpenEXR/ImfRgbaFile.h>
 #include <OpenEXR/ImfStandardAttributes.h>
 #include <OpenEXR/ImfStringAttribute.h>
+#include <OpenEXR/ImfTiledRgbaFile.h>
 #include <OpenEXR/ImfVersion.h>
 
 /* multiview/multipart */
@@ -2267,6 +2268,60 @@ ImBuf *imb_load_openexr(const uchar *mem, size_t size, int flags, char colorspac
   }
 }
 
+/**
+ * Create a thumbnail of a tiled file with mip-map or rip-map levels from the smallest level that
+ * is at least as large as the thumbnail, instead of decoding the full resolution image.
+ */
+static ImBuf *imb_exr_thumbnail_from_levels(TiledRgbaInputFile &file,
+                                            const int dest_w,
+                                            const int dest_h)
+{
+  int lx = 0;
+  int ly = 0;
+  if (file.levelMode() == MIPMAP_LEVELS) {
+    while (lx + 1 < file.numLevels() && file.levelWidth(lx + 1) >= dest_w &&
+           file.levelHeight(lx + 1) >= dest_h)
+    {
+      lx++;
+    }
+    ly = lx;
+  }
+  else {
+    while (lx + 1 < file.numXLevels() && file.levelWidth(lx + 1) >= dest_w) {
+      lx++;
+    }
+    while (ly + 1 < file.numYLevels() && file.levelHeight(ly + 1) >= dest_h) {
+      ly++;
+    }
+  }
+
+  const Box2i level_dw = file.dataWindowForLevel(lx, ly);
+  const int level_w = level_dw.max.x - level_dw.min.x + 1;
+  const int level_h = level_dw.max.y - level_dw.min.y + 1;
+
+  Imf::Array2D<Imf::Rgba> pixels(level_h, level_w);
+  file.setFrameBuffer(&pixels[0][0] - level_dw.min.x - level_dw.min.y * level_w, 1, level_w);
+  file.readTiles(0, file.numXTiles(lx) - 1, 0, file.numYTiles(ly) - 1, lx, ly);
+
+  ImBuf *ibuf = IMB_allocImBuf(dest_w, dest_h, 32, IB_rectfloat);
+  for (int h = 0; h < dest_h; h++) {
+    const int source_y = std::min(int(int64_t(h) * level_h / dest_h), level_h - 1);
+    for (int w = 0; w < dest_w; w++) {
+      const int source_x = std::min(int(int64_t(w) * level_w / dest_w), level_w - 1);
+      const Imf::Rgba &source_px = pixels[source_y][source_x];
+      float *dest_px = &ibuf->float_buffer.data[(h * dest_w + w) * 4];
+      dest_px[0] = source_px.r;
+      dest_px[1] = source_px.g;
+      dest_px[2] = source_px.b;
+      dest_px[3] = source_px.a;
+    }
+  }
+
+  /* Rows were stored from the top of the image. */
+  IMB_flipy(ibuf);
+  return ibuf;
+}
+
 ImBuf *imb_load_filepath_thumbnail_openexr(const char *filepath,
                                            const int /*flags*/,
                                            const size_t max_thumb_size,
@@ -2327,6 +2382,20 @@ ImBuf *imb_load_filepath_thumbnail_openexr(const char *filepath,
     int dest_w = std::max(int(source_w * scale_factor), 1);
     int dest_h = std::max(int(source_h * scale_factor), 1);
 
+    /* Reading rows of scan-line images still decodes most of the file, but tiled images may have
+     * smaller levels of the image stored already. */
+    if (file->header().hasTileDescription() &&
+        file->header().tileDescription().mode != ONE_LEVEL)
+    {
+      delete file;
+      file = nullptr;
+      stream->seekg(0);
+      TiledRgbaInputFile tiled_file(*stream, 1);
+      ImBuf *ibuf = imb_exr_thumbnail_from_levels(tiled_file, dest_w, dest_h);
+      delete stream;
+      return ibuf;
+    }
+
     ImBuf *ibuf = IMB_allocImBuf(dest_w, dest_h, 32, IB_rectfloat);
 
     /* A single row of source pixels. */
@@ -443,6 +443,13 @@ struct ScaleDownX {
   }
 };
 
+/**
+ * The vertical passes process the image in chunks of columns, one row after the other, so reads
+ * and writes are contiguous. The sampling positions only depend on the row, so the results are
+ * the same as filtering every column on its own.
+ */
+static constexpr int scale_y_columns_chunk = 256;
+
 struct ScaleDownY {
   template<typename T>
   static void op(const T *src, T *dst, int ibufx, int ibufy, int /*newx*/, int newy, bool threaded)
@@ -453,26 +460,42 @@ struct ScaleDownY {
 
     const int grain_size = threaded ? 32 : ibufx;
     threading::parallel_for(IndexRange(ibufx), grain_size, [&](IndexRange range) {
-      for (const int x : range) {
-        const T *src_ptr = src + x;
-        T *dst_ptr = dst + x;
+      float4 val[scale_y_columns_chunk];
+      float4 nval[scale_y_columns_chunk];
+      for (int64_t x_start = range.start(); x_start < range.one_after_last();
+           x_start += scale_y_columns_chunk)
+      {
+        const int width = int(std::min<int64_t>(scale_y_columns_chunk,
+                                                range.one_after_last() - x_start));
+        const T *src_ptr = src + x_start;
+        T *dst_ptr = dst + x_start;
         float sample = 0.0f;
-        float4 val(0.0f);
+        for (int i = 0; i < width; i++) {
+          val[i] = float4(0.0f);
+        }
 
         for (int y = 0; y < newy; y++) {
-          float4 nval = -val * sample;
+          for (int i = 0; i < width; i++) {
+            nval[i] = -val[i] * sample;
+          }
           sample += add;
           while (sample >= 1.0f) {
             sample -= 1.0f;
-            nval += load_pixel(src_ptr);
+            for (int i = 0; i < width; i++) {
+              nval[i] += load_pixel(src_ptr + i);
+            }
             src_ptr += ibufx;
           }
 
-          val = load_pixel(src_ptr);
+          for (int i = 0; i < width; i++) {
+            val[i] = load_pixel(src_ptr + i);
+          }
           src_ptr += ibufx;
 
-          float4 pix = (nval + sample * val) * inv_add;
-          store_pixel(pix, dst_ptr);
+          for (int i = 0; i < width; i++) {
+            float4 pix = (nval[i] + sample * val[i]) * inv_add;
+            store_pixel(pix, dst_ptr + i);
+          }
           dst_ptr += ibufx;
 
           sample -= 1.0f;
@@ -551,15 +574,24 @@ struct ScaleUpY {
     else {
       const int grain_size = threaded ? 32 : ibufx;
       threading::parallel_for(IndexRange(ibufx), grain_size, [&](IndexRange range) {
-        for (const int x : range) {
+        float4 val[scale_y_columns_chunk];
+        float4 nval[scale_y_columns_chunk];
+        float4 diff[scale_y_columns_chunk];
+        for (int64_t x_start = range.start(); x_start < range.one_after_last();
+             x_start += scale_y_columns_chunk)
+        {
+          const int width = int(std::min<int64_t>(scale_y_columns_chunk,
+                                                  range.one_after_last() - x_start));
           float sample = -0.5f + add * 0.5f;
           int counter = 0;
-          const T *src_ptr = src + x;
-          T *dst_ptr = dst + x;
+          const T *src_ptr = src + x_start;
+          T *dst_ptr = dst + x_start;
 
-          float4 val = load_pixel(src_ptr);
-          float4 nval = load_pixel(src_ptr + ibufx);
-          float4 diff = nval - val;
+          for (int i = 0; i < width; i++) {
+            val[i] = load_pixel(src_ptr + i);
+            nval[i] = load_pixel(src_ptr + ibufx + i);
+            diff[i] = nval[i] - val[i];
+          }
           if (ibufy > 2) {
             src_ptr += ibufx * 2;
             counter += 2;
@@ -568,16 +600,21 @@ struct ScaleUpY {
           for (int y = 0; y < newy; y++) {
             if (sample >= 1.0f) {
               sample -= 1.0f;
-              val = nval;
-              nval = load_pixel(src_ptr);
-              diff = nval - val;
+              for (int i = 0; i < width; i++) {
+                val[i] = nval[i];
+                nval[i] = load_pixel(src_ptr + i);
+                diff[i] = nval[i] - val[i];
+              }
               if (counter + 1 < ibufy) {
                 src_ptr += ibufx;
                 ++counter;
               }
             }
-            float4 pix = val + blender::math::max(sample, 0.0f) * diff;
-            store_pixel(pix, dst_ptr);
+            const float factor = blender::math::max(sample, 0.0f);
+            for (int i = 0; i < width; i++) {
+              float4 pix = val[i] + factor * diff[i];
+              store_pixel(pix, dst_ptr + i);
+            }
             dst_ptr += ibufx;
             sample += add;
           }
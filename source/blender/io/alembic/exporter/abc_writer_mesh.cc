@@ -10,7 +10,9 @@
 #include "abc_hierarchy_iterator.h"
 #include "intern/abc_axis_conversion.h"
 
+#include "BLI_map.hh"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_lib_id.hh"
@@ -378,9 +380,11 @@ bool ABCGenericMeshWriter::get_velocities(Mesh *mesh, std::vector<Imath::V3f> &v
   vels.clear();
   vels.resize(totverts);
 
-  for (int i = 0; i < totverts; i++) {
-    copy_yup_from_zup(vels[i].getValue(), mesh_velocities[i]);
-  }
+  threading::parallel_for(IndexRange(totverts), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(vels[i].getValue(), mesh_velocities[i]);
+    }
+  });
 
   return true;
 }
@@ -393,23 +397,24 @@ void ABCGenericMeshWriter::get_geo_groups(Object *object,
   const VArraySpan<int> material_indices = *attributes.lookup_or_default<int>(
       "material_index", bke::AttrDomain::Face, 0);
 
+  /* Look up the group of every material slot once, instead of building the material name for
+   * every face. Slots without a material have no group. */
+  Map<short, std::vector<int32_t> *> slot_groups;
   for (const int i : material_indices.index_range()) {
-    short mnr = material_indices[i];
-
-    Material *mat = BKE_object_material_get(object, mnr + 1);
+    const short mnr = material_indices[i];
 
-    if (!mat) {
-      continue;
-    }
-
-    std::string name = args_.hierarchy_iterator->get_id_name(&mat->id);
+    std::vector<int32_t> *group = slot_groups.lookup_or_add_cb(
+        mnr, [&]() -> std::vector<int32_t> * {
+          Material *mat = BKE_object_material_get(object, mnr + 1);
+          if (!mat) {
+            return nullptr;
+          }
+          return &geo_groups[args_.hierarchy_iterator->get_id_name(&mat->id)];
+        });
 
-    if (geo_groups.find(name) == geo_groups.end()) {
-      std::vector<int32_t> faceArray;
-      geo_groups[name] = faceArray;
+    if (group != nullptr) {
+      group->push_back(i);
     }
-
-    geo_groups[name].push_back(i);
   }
 
   if (geo_groups.empty()) {
@@ -435,9 +440,11 @@ static void get_vertices(Mesh *mesh, std::vector<Imath::V3f> &points)
   points.resize(mesh->verts_num);
 
   const Span<float3> positions = mesh->vert_positions();
-  for (int i = 0, e = mesh->verts_num; i < e; i++) {
-    copy_yup_from_zup(points[i].getValue(), positions[i]);
-  }
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(points[i].getValue(), positions[i]);
+    }
+  });
 }
 
 static void get_topology(Mesh *mesh,
@@ -449,19 +456,19 @@ static void get_topology(Mesh *mesh,
 
   face_verts.clear();
   loop_counts.clear();
-  face_verts.reserve(corner_verts.size());
-  loop_counts.reserve(faces.size());
+  face_verts.resize(corner_verts.size());
+  loop_counts.resize(faces.size());
 
   /* NOTE: data needs to be written in the reverse order. */
-  for (const int i : faces.index_range()) {
-    const IndexRange face = faces[i];
-    loop_counts.push_back(face.size());
-
-    int corner = face.start() + (face.size() - 1);
-    for (int j = 0; j < face.size(); j++, corner--) {
-      face_verts.push_back(corner_verts[corner]);
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange face = faces[i];
+      loop_counts[i] = face.size();
+      for (const int j : face.index_range()) {
+        face_verts[face[j]] = corner_verts[face.last(j)];
+      }
     }
-  }
+  });
 }
 
 static void get_edge_creases(Mesh *mesh,
@@ -12,6 +12,9 @@
 #include "BKE_mesh.hh"
 
 #include "BLI_array.hh"
+#include "BLI_memory_utils.hh"
+#include "BLI_mmap.h"
+#include "BLI_utildefines.h"
 
 #include "DNA_mesh_types.h"
 
@@ -36,8 +39,25 @@ Mesh *read_stl_binary(FILE *file, const bool use_custom_normals)
     return BKE_mesh_new_nomain(0, 0, 0, 0);
   }
 
-  Array<PackedTriangle> tris_buf(chunk_size);
   STLMeshHelper stl_mesh(num_tris, use_custom_normals);
+
+  /* Use the triangles directly from the mapped file when possible, that avoids copying them and
+   * allows merging the vertices in parallel. */
+  const size_t tris_offset = BINARY_HEADER_SIZE + sizeof(uint32_t);
+  BLI_mmap_file *mmap_file = BLI_mmap_open(fileno(file));
+  if (mmap_file != nullptr) {
+    BLI_SCOPED_DEFER([&]() { BLI_mmap_free(mmap_file); });
+    if (BLI_mmap_get_length(mmap_file) >= tris_offset + BINARY_STRIDE * num_tris) {
+      const PackedTriangle *tris = static_cast<const PackedTriangle *>(
+          POINTER_OFFSET(BLI_mmap_get_pointer(mmap_file), tris_offset));
+      stl_mesh.add_triangles(Span<PackedTriangle>(tris, num_tris));
+      return stl_mesh.to_mesh();
+    }
+  }
+
+  /* Mapping the file seeks to its end. */
+  fseek(file, tris_offset, SEEK_SET);
+  Array<PackedTriangle> tris_buf(chunk_size);
   size_t num_read_tris;
   while ((num_read_tris = fread(tris_buf.data(), sizeof(PackedTriangle), chunk_size, file))) {
     for (size_t i = 0; i < num_read_tris; i++) {
@@ -6,11 +6,15 @@
  * \ingroup stl
  */
 
+#include <array>
+#include <cstring>
 #include <iostream>
 
 #include "BKE_mesh.hh"
 
+#include "BLI_array.hh"
 #include "BLI_array_utils.hh"
+#include "BLI_sort.hh"
 #include "BLI_span.hh"
 
 #include "DNA_mesh_types.h"
@@ -23,6 +27,7 @@ namespace blender::io::stl {
 STLMeshHelper::STLMeshHelper(int tris_num, bool use_custom_normals)
     : use_custom_normals_(use_custom_normals)
 {
+  tris_num_ = tris_num;
   degenerate_tris_num_ = 0;
   duplicate_tris_num_ = 0;
   tris_.reserve(tris_num);
@@ -33,11 +38,77 @@ STLMeshHelper::STLMeshHelper(int tris_num, bool use_custom_normals)
   }
 }
 
+int STLMeshHelper::vert_index_of_or_add(const float3 &position)
+{
+  if (vert_indices_.is_empty()) {
+    vert_indices_.reserve(tris_num_ * 3);
+  }
+  return vert_indices_.lookup_or_add_cb(position,
+                                        [&]() { return verts_.append_and_get_index(position); });
+}
+
 bool STLMeshHelper::add_triangle(const PackedTriangle &data)
 {
-  int v1_id = verts_.index_of_or_add(data.vertices[0]);
-  int v2_id = verts_.index_of_or_add(data.vertices[1]);
-  int v3_id = verts_.index_of_or_add(data.vertices[2]);
+  const int v1_id = vert_index_of_or_add(data.vertices[0]);
+  const int v2_id = vert_index_of_or_add(data.vertices[1]);
+  const int v3_id = vert_index_of_or_add(data.vertices[2]);
+  return add_triangle_verts(v1_id, v2_id, v3_id, data.normal);
+}
+
+void STLMeshHelper::add_triangles(const Span<PackedTriangle> tris)
+{
+  BLI_assert(verts_.is_empty());
+  const int corners_num = tris.size() * 3;
+
+  /* Positions are compared bit-wise, which gives a strict order for all values. */
+  const auto corner_key = [&](const int corner) {
+    const float3 position = tris[corner / 3].vertices[corner % 3];
+    std::array<uint32_t, 3> key;
+    memcpy(key.data(), &position, sizeof(key));
+    return key;
+  };
+
+  /* Corners with equal positions are sorted by their index, so the first corner of every group
+   * of equal positions is the one that uses the vertex first. */
+  Array<int> sorted_corners(corners_num);
+  array_utils::fill_index_range<int>(sorted_corners);
+  parallel_sort(sorted_corners.begin(), sorted_corners.end(), [&](const int a, const int b) {
+    const std::array<uint32_t, 3> key_a = corner_key(a);
+    const std::array<uint32_t, 3> key_b = corner_key(b);
+    return (key_a < key_b) || (key_a == key_b && a < b);
+  });
+
+  Array<int> corner_verts(corners_num);
+  for (int i = 0; i < corners_num;) {
+    const int first_corner = sorted_corners[i];
+    const std::array<uint32_t, 3> key = corner_key(first_corner);
+    for (; i < corners_num && corner_key(sorted_corners[i]) == key; i++) {
+      corner_verts[sorted_corners[i]] = first_corner;
+    }
+  }
+
+  /* Number the vertices in the order in which they are used first. The first corner of a vertex
+   * always comes before the other corners, so it was already replaced by the vertex index. */
+  for (const int corner : IndexRange(corners_num)) {
+    const int first_corner = corner_verts[corner];
+    corner_verts[corner] = (first_corner == corner) ?
+                               verts_.append_and_get_index(tris[corner / 3].vertices[corner % 3]) :
+                               corner_verts[first_corner];
+  }
+
+  for (const int tri : tris.index_range()) {
+    add_triangle_verts(corner_verts[tri * 3 + 0],
+                       corner_verts[tri * 3 + 1],
+                       corner_verts[tri * 3 + 2],
+                       tris[tri].normal);
+  }
+}
+
+bool STLMeshHelper::add_triangle_verts(const int v1_id,
+                                       const int v2_id,
+                                       const int v3_id,
+                                       const float3 &normal)
+{
   if ((v1_id == v2_id) || (v1_id == v3_id) || (v2_id == v3_id)) {
     degenerate_tris_num_++;
     return false;
@@ -48,7 +119,7 @@ bool STLMeshHelper::add_triangle(const PackedTriangle &data)
   }
 
   if (use_custom_normals_) {
-    loop_normals_.append_n_times(data.normal, 3);
+    loop_normals_.append_n_times(normal, 3);
   }
   return true;
 }
@@ -10,7 +10,9 @@
 
 #include <cstdint>
 
+#include "BLI_map.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 #include "BLI_vector.hh"
 #include "BLI_vector_set.hh"
 #include "stl_data.hh"
@@ -49,9 +51,12 @@ class Triangle {
 
 class STLMeshHelper {
  private:
-  VectorSet<float3> verts_;
+  Vector<float3> verts_;
+  /* Index of every position in #verts_, only used when triangles are added one by one. */
+  Map<float3, int> vert_indices_;
   VectorSet<Triangle> tris_;
   Vector<float3> loop_normals_;
+  int tris_num_;
   int degenerate_tris_num_;
   int duplicate_tris_num_;
   const bool use_custom_normals_;
@@ -64,7 +69,17 @@ class STLMeshHelper {
    */
   bool add_triangle(const PackedTriangle &data);
 
+  /* Adds all triangles at once, which can't be combined with #add_triangle. Duplicate vertices
+   * are found by sorting the corners in parallel instead of looking up every vertex in a hash
+   * table, the vertex order is the same as when adding the triangles one by one.
+   */
+  void add_triangles(Span<PackedTriangle> tris);
+
   Mesh *to_mesh();
+
+ private:
+  bool add_triangle_verts(int v1_id, int v2_id, int v3_id, const float3 &normal);
+  int vert_index_of_or_add(const float3 &position);
 };
 
 }  // namespace blender::io::stl
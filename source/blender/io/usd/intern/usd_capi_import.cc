@@ -25,6 +25,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_timeit.hh"
 
 #include "BLT_translation.hh"
@@ -333,6 +334,17 @@ static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
     }
   }
 
+  /* Read the data of the prims which does not depend on the main database in parallel, mainly
+   * the conversion of meshes. */
+  const Span<USDPrimReader *> readers = archive->readers();
+  threading::parallel_for(readers.index_range(), 1, [&](const IndexRange range) {
+    for (USDPrimReader *reader : readers.slice(range)) {
+      if (reader && !G.is_break) {
+        reader->prefetch_object_data(0.0);
+      }
+    }
+  });
+
   /* Setup parenthood and read actual object data. */
   i = 0;
   for (USDPrimReader *reader : archive->readers()) {
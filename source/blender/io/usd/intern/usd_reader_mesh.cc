@@ -16,6 +16,7 @@
 #include "BKE_attribute.hh"
 #include "BKE_customdata.hh"
 #include "BKE_geometry_set.hh"
+#include "BKE_lib_id.hh"
 #include "BKE_main.hh"
 #include "BKE_material.h"
 #include "BKE_mesh.hh"
@@ -161,6 +162,14 @@ USDMeshReader::USDMeshReader(const pxr::UsdPrim &prim,
 {
 }
 
+USDMeshReader::~USDMeshReader()
+{
+  /* The import was canceled before the prefetched mesh was used. */
+  if (prefetched_mesh_ != nullptr) {
+    BKE_id_free(nullptr, prefetched_mesh_);
+  }
+}
+
 static std::optional<bke::AttrDomain> convert_usd_varying_to_blender(const pxr::TfToken usd_domain)
 {
   static const blender::Map<pxr::TfToken, bke::AttrDomain> domain_map = []() {
@@ -194,7 +203,7 @@ void USDMeshReader::create_object(Main *bmain, const double /*motionSampleTime*/
   object_->data = mesh;
 }
 
-void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+void USDMeshReader::prefetch_object_data(const double motionSampleTime)
 {
   Mesh *mesh = (Mesh *)object_->data;
 
@@ -205,6 +214,23 @@ void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
   Mesh *read_mesh = this->read_mesh(mesh, params, nullptr);
 
   is_initial_load_ = false;
+  is_mesh_prefetched_ = true;
+  if (read_mesh != mesh) {
+    prefetched_mesh_ = read_mesh;
+  }
+}
+
+void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+{
+  Mesh *mesh = (Mesh *)object_->data;
+
+  if (!is_mesh_prefetched_) {
+    this->prefetch_object_data(motionSampleTime);
+  }
+  Mesh *read_mesh = prefetched_mesh_ ? prefetched_mesh_ : mesh;
+  is_mesh_prefetched_ = false;
+  prefetched_mesh_ = nullptr;
+
   if (read_mesh != mesh) {
     BKE_mesh_nomain_to_mesh(read_mesh, mesh, object_);
   }
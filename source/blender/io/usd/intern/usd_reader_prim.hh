@@ -108,6 +108,11 @@ class USDPrimReader {
   virtual bool valid() const;
 
   virtual void create_object(Main *bmain, double motionSampleTime) = 0;
+  /**
+   * Read the data that #read_object_data needs without accessing \a bmain, called before it.
+   * This is called from multiple threads for different readers at the same time.
+   */
+  virtual void prefetch_object_data(double /*motionSampleTime*/){};
   virtual void read_object_data(Main * /*bmain*/, double /*motionSampleTime*/){};
 
   Object *object() const;
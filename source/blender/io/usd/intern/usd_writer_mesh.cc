@@ -578,7 +578,7 @@ static void get_positions(const Mesh *mesh, USDMeshData &usd_mesh_data)
   usd_mesh_data.points = pxr::VtArray<pxr::GfVec3f>(positions.begin(), positions.end());
 }
 
-static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
+static void get_face_groups(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
   /* Only construct face groups (a.k.a. geometry subsets) when we need them for material
    * assignments. */
@@ -591,7 +591,10 @@ static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
       usd_mesh_data.face_groups.lookup_or_add_default(indices_span[i]).push_back(i);
     }
   }
+}
 
+static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
+{
   usd_mesh_data.face_vertex_counts.resize(mesh->faces_num);
   const OffsetIndices faces = mesh->faces();
   offset_indices::copy_group_sizes(
@@ -648,10 +651,42 @@ static void get_vert_creases(const Mesh *mesh, USDMeshData &usd_mesh_data)
   }
 }
 
+void USDGenericMeshWriter::get_topology_data(const Mesh *mesh, USDMeshData &usd_mesh_data)
+{
+  const ImplicitSharingInfo *face_offsets_sharing_info = mesh->runtime->face_offsets_sharing_info;
+  const ImplicitSharingInfo *corner_verts_sharing_info =
+      mesh->attributes().lookup<int>(".corner_vert").sharing_info;
+
+  if (face_offsets_sharing_info != nullptr && corner_verts_sharing_info != nullptr &&
+      face_offsets_sharing_info == prev_face_offsets_sharing_info_.get() &&
+      corner_verts_sharing_info == prev_corner_verts_sharing_info_.get())
+  {
+    /* The arrays are the same as in the previous frame, they can't have been modified since
+     * they are still shared with this writer. */
+    usd_mesh_data.face_vertex_counts = prev_face_vertex_counts_;
+    usd_mesh_data.face_indices = prev_face_indices_;
+    return;
+  }
+
+  get_loops_polys(mesh, usd_mesh_data);
+
+  prev_face_offsets_sharing_info_.reset();
+  prev_corner_verts_sharing_info_.reset();
+  prev_face_vertex_counts_ = usd_mesh_data.face_vertex_counts;
+  prev_face_indices_ = usd_mesh_data.face_indices;
+  if (face_offsets_sharing_info != nullptr && corner_verts_sharing_info != nullptr) {
+    face_offsets_sharing_info->add_user();
+    prev_face_offsets_sharing_info_ = ImplicitSharingPtr<>(face_offsets_sharing_info);
+    corner_verts_sharing_info->add_user();
+    prev_corner_verts_sharing_info_ = ImplicitSharingPtr<>(corner_verts_sharing_info);
+  }
+}
+
 void USDGenericMeshWriter::get_geometry_data(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
   get_positions(mesh, usd_mesh_data);
-  get_loops_polys(mesh, usd_mesh_data);
+  get_face_groups(mesh, usd_mesh_data);
+  get_topology_data(mesh, usd_mesh_data);
   get_edge_creases(mesh, usd_mesh_data);
   get_vert_creases(mesh, usd_mesh_data);
 }
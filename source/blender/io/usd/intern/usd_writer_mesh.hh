@@ -5,6 +5,7 @@
 
 #include "usd_writer_abstract.hh"
 
+#include "BLI_implicit_sharing_ptr.hh"
 #include "BLI_map.hh"
 
 #include <pxr/usd/usdGeom/mesh.h>
@@ -37,12 +38,22 @@ class USDGenericMeshWriter : public USDAbstractWriter {
   /* Mapping from material slot number to array of face indices with that material. */
   using MaterialFaceGroups = Map<short, pxr::VtIntArray>;
 
+  /* Topology written for the previous frame. While the mesh of the next frame still shares its
+   * topology arrays with it, for example when it is only deformed, the USD arrays are reused.
+   * That avoids copying the topology, and the sparse value writer recognizes the identical arrays
+   * without comparing their elements. */
+  ImplicitSharingPtr<> prev_face_offsets_sharing_info_;
+  ImplicitSharingPtr<> prev_corner_verts_sharing_info_;
+  pxr::VtIntArray prev_face_vertex_counts_;
+  pxr::VtIntArray prev_face_indices_;
+
   void write_mesh(HierarchyContext &context, Mesh *mesh, const SubsurfModifierData *subsurfData);
   pxr::TfToken get_subdiv_scheme(const SubsurfModifierData *subsurfData);
   void write_subdiv(const pxr::TfToken &subdiv_scheme,
                     const pxr::UsdGeomMesh &usd_mesh,
                     const SubsurfModifierData *subsurfData);
   void get_geometry_data(const Mesh *mesh, struct USDMeshData &usd_mesh_data);
+  void get_topology_data(const Mesh *mesh, struct USDMeshData &usd_mesh_data);
   void assign_materials(const HierarchyContext &context,
                         const pxr::UsdGeomMesh &usd_mesh,
                         const MaterialFaceGroups &usd_face_groups);
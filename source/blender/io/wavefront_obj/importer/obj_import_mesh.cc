@@ -69,10 +69,9 @@ Object *MeshFromGeometry::create_mesh_object(
     Main *bmain,
     Map<std::string, std::unique_ptr<MTLMaterial>> &materials,
     Map<std::string, Material *> &created_materials,
-    const OBJImportParams &import_params)
+    const OBJImportParams &import_params,
+    Mesh *mesh)
 {
-  Mesh *mesh = this->create_mesh(import_params);
-
   if (mesh == nullptr) {
     return nullptr;
   }
@@ -36,10 +36,15 @@ class MeshFromGeometry : NonMovable, NonCopyable {
 
   Mesh *create_mesh(const OBJImportParams &import_params);
 
+  /**
+   * Create the object for a mesh created by #create_mesh, which is moved into the object data.
+   * Unlike #create_mesh, this adds data-blocks to \a bmain and can't run in parallel.
+   */
   Object *create_mesh_object(Main *bmain,
                              Map<std::string, std::unique_ptr<MTLMaterial>> &materials,
                              Map<std::string, Material *> &created_materials,
-                             const OBJImportParams &import_params);
+                             const OBJImportParams &import_params,
+                             Mesh *mesh);
 
  private:
   /**
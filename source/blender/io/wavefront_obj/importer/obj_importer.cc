@@ -8,11 +8,13 @@
 
 #include <string>
 
+#include "BLI_array.hh"
 #include "BLI_map.hh"
 #include "BLI_set.hh"
 #include "BLI_sort.hh"
 #include "BLI_string.h"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 
 #include "BKE_context.hh"
 #include "BKE_curve_legacy_convert.hh"
@@ -80,23 +82,27 @@ static void geometry_to_blender_geometry_set(const OBJImportParams &import_param
                                              const GlobalVertices &global_vertices,
                                              Vector<bke::GeometrySet> &geometries)
 {
-  for (const std::unique_ptr<Geometry> &geometry : all_geometries) {
-    bke::GeometrySet geometry_set;
-
-    if (geometry->geom_type_ == GEOM_MESH) {
-      MeshFromGeometry mesh_ob_from_geometry{*geometry, global_vertices};
-      Mesh *mesh = mesh_ob_from_geometry.create_mesh(import_params);
-      geometry_set = bke::GeometrySet::from_mesh(mesh);
-    }
-    else if (geometry->geom_type_ == GEOM_CURVE) {
-      CurveFromGeometry curve_ob_from_geometry(*geometry, global_vertices);
-      Curve *curve = curve_ob_from_geometry.create_curve();
-      Curves *curves_id = bke::curve_legacy_to_curves(*curve);
-      geometry_set = bke::GeometrySet::from_curves(curves_id);
+  /* Nothing is added to the main database, so all geometries are created in parallel. */
+  const int64_t geometries_start = geometries.size();
+  geometries.resize(geometries_start + all_geometries.size());
+  threading::parallel_for(all_geometries.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const std::unique_ptr<Geometry> &geometry = all_geometries[i];
+      bke::GeometrySet &geometry_set = geometries[geometries_start + i];
+
+      if (geometry->geom_type_ == GEOM_MESH) {
+        MeshFromGeometry mesh_ob_from_geometry{*geometry, global_vertices};
+        Mesh *mesh = mesh_ob_from_geometry.create_mesh(import_params);
+        geometry_set = bke::GeometrySet::from_mesh(mesh);
+      }
+      else if (geometry->geom_type_ == GEOM_CURVE) {
+        CurveFromGeometry curve_ob_from_geometry(*geometry, global_vertices);
+        Curve *curve = curve_ob_from_geometry.create_curve();
+        Curves *curves_id = bke::curve_legacy_to_curves(*curve);
+        geometry_set = bke::GeometrySet::from_curves(curves_id);
+      }
     }
-
-    geometries.append(std::move(geometry_set));
-  }
+  });
 }
 
 /**
@@ -122,16 +128,29 @@ static void geometry_to_blender_objects(Main *bmain,
         return BLI_strcasecmp(na, nb) < 0;
       });
 
+  /* Building the meshes is most of the work and does not touch the main database, so it is done
+   * in parallel before the objects are created. */
+  Array<Mesh *> meshes(all_geometries.size(), nullptr);
+  threading::parallel_for(all_geometries.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      if (all_geometries[i]->geom_type_ == GEOM_MESH) {
+        MeshFromGeometry mesh_ob_from_geometry{*all_geometries[i], global_vertices};
+        meshes[i] = mesh_ob_from_geometry.create_mesh(import_params);
+      }
+    }
+  });
+
   /* Create all the objects. */
   Vector<Object *> objects;
   objects.reserve(all_geometries.size());
   Set<Collection *> collections;
-  for (const std::unique_ptr<Geometry> &geometry : all_geometries) {
+  for (const int64_t i : all_geometries.index_range()) {
+    const std::unique_ptr<Geometry> &geometry = all_geometries[i];
     Object *obj = nullptr;
     if (geometry->geom_type_ == GEOM_MESH) {
       MeshFromGeometry mesh_ob_from_geometry{*geometry, global_vertices};
       obj = mesh_ob_from_geometry.create_mesh_object(
-          bmain, materials, created_materials, import_params);
+          bmain, materials, created_materials, import_params, meshes[i]);
     }
     else if (geometry->geom_type_ == GEOM_CURVE) {
       CurveFromGeometry curve_ob_from_geometry(*geometry, global_vertices);
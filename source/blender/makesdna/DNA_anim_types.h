@@ -1161,6 +1161,11 @@ typedef struct AnimData {
 
   /** Runtime data, for depsgraph evaluation. */
   FCurve **driver_array;
+  /**
+   * Runtime data, for depsgraph evaluation. Resolved RNA paths of the active action's F-Curves,
+   * see #BKE_animsys_eval_animdata.
+   */
+  struct AnimDataPathCache *path_cache;
 
   /* settings for animation evaluation */
   /** User-defined settings. */
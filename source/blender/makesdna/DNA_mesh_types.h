@@ -18,6 +18,7 @@
 
 #  include <optional>
 
+#  include "BLI_index_mask_fwd.hh"
 #  include "BLI_math_vector_types.hh"
 #  include "BLI_memory_counter_fwd.hh"
 
@@ -400,6 +401,12 @@ typedef struct Mesh {
 
   /** Call after changing vertex positions to tag lazily calculated caches for recomputation. */
   void tag_positions_changed();
+  /**
+   * Like #tag_positions_changed, but only \a changed_verts were moved. Cached face and vertex
+   * normals are updated for the surrounding faces and vertices instead of being recomputed for
+   * the whole mesh. Corner normals are still tagged for recomputation.
+   */
+  void tag_positions_changed_partial(const blender::IndexMask &changed_verts);
   /** Call after moving every mesh vertex by the same translation. */
   void tag_positions_changed_uniformly();
   /** Like #tag_positions_changed but doesn't tag normals; they must be updated separately. */
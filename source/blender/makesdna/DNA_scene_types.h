@@ -2137,7 +2137,8 @@ enum {
   R_SIMPLIFY = 1 << 24,
   R_EDGE_FRS = 1 << 25,        /* R_EDGE reserved for Freestyle */
   R_PERSISTENT_DATA = 1 << 26, /* Keep data around for re-render. */
-  R_MODE_UNUSED_27 = 1 << 27,  /* cleared */
+  /** Write animation frames in the background while the next frame renders. */
+  R_SAVE_ASYNC = 1 << 27,
 };
 
 /** #RenderData::seq_flag */
@@ -2556,6 +2557,7 @@ enum {
   FFMPEG_AUTOSPLIT_OUTPUT = (1 << 1),
   FFMPEG_LOSSLESS_OUTPUT = (1 << 2),
   FFMPEG_USE_MAX_B_FRAMES = (1 << 3),
+  FFMPEG_USE_HARDWARE_ENCODER = (1 << 4),
 };
 
 /** #Paint::flags */
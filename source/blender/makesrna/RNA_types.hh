@@ -330,6 +330,13 @@ enum PropertyFlag {
    */
   PROP_DEG_SYNC_ONLY = (1 << 9),
 
+  /**
+   * Property only changes a setting stored in its data-block itself, not any data owned by the
+   * data-block (like mesh attributes or shape key positions). Evaluated data-blocks are then
+   * updated without copying the data they own again, see #DEG_id_tag_update_parameters_only.
+   */
+  PROP_DEG_PARAMETERS_ONLY = (1 << 3),
+
   /**
    * File-paths that refer to output get a special treatment such
    * as having the +/- operators available in the file browser.
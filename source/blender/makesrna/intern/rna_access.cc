@@ -2336,6 +2336,9 @@ static void rna_property_update(
         if (prop->flag & PROP_DEG_SYNC_ONLY) {
           DEG_id_tag_update(ptr->owner_id, ID_RECALC_SYNC_TO_EVAL);
         }
+        else if (prop->flag & PROP_DEG_PARAMETERS_ONLY) {
+          DEG_id_tag_update_parameters_only(bmain, ptr->owner_id, 0);
+        }
         else {
           DEG_id_tag_update(ptr->owner_id, ID_RECALC_SYNC_TO_EVAL | ID_RECALC_PARAMETERS);
         }
@@ -2358,8 +2361,15 @@ static void rna_property_update(
      * So editing custom properties only causes updates in the UI,
      * keep this exception because it happens to be useful for driving settings.
      * Python developers on the other hand will need to manually 'update_tag', see: #74000. */
-    DEG_id_tag_update(ptr->owner_id,
-                      ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_PARAMETERS);
+    if (ptr->data == ptr->owner_id) {
+      /* Custom properties of the data-block itself, no need to copy all its data again. */
+      DEG_id_tag_update_parameters_only(
+          bmain, ptr->owner_id, ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY);
+    }
+    else {
+      DEG_id_tag_update(ptr->owner_id,
+                        ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_PARAMETERS);
+    }
 
     /* When updating an ID pointer property, tag depsgraph for update. */
     if (prop->type == PROP_POINTER && RNA_struct_is_ID(RNA_property_pointer_type(ptr, prop))) {
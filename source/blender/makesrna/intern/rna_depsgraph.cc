@@ -289,6 +289,97 @@ static void rna_Depsgraph_debug_stats(Depsgraph *depsgraph, char *result)
                outer);
 }
 
+/* ******************** Operation Profile ***************** */
+
+static void rna_DepsgraphOperationProfile_id_name_get(PointerRNA *ptr, char *value)
+{
+  const DEGOperationProfileEntry *entry = static_cast<DEGOperationProfileEntry *>(ptr->data);
+  strcpy(value, entry->id_name.c_str());
+}
+
+static int rna_DepsgraphOperationProfile_id_name_length(PointerRNA *ptr)
+{
+  const DEGOperationProfileEntry *entry = static_cast<DEGOperationProfileEntry *>(ptr->data);
+  return int(entry->id_name.size());
+}
+
+static void rna_DepsgraphOperationProfile_component_get(PointerRNA *ptr, char *value)
+{
+  const DEGOperationProfileEntry *entry = static_cast<DEGOperationProfileEntry *>(ptr->data);
+  strcpy(value, entry->component_name.c_str());
+}
+
+static int rna_DepsgraphOperationProfile_component_length(PointerRNA *ptr)
+{
+  const DEGOperationProfileEntry *entry = static_cast<DEGOperationProfileEntry *>(ptr->data);
+  return int(entry->component_name.size());
+}
+
+static void rna_DepsgraphOperationProfile_operation_get(PointerRNA *ptr, char *value)
+{
+  const DEGOperationProfileEntry *entry = static_cast<DEGOperationProfileEntry *>(ptr->data);
+  strcpy(value, entry->operation_name.c_str());
+}
+
+static int rna_DepsgraphOperationProfile_operation_length(PointerRNA *ptr)
+{
+  const DEGOperationProfileEntry *entry = static_cast<DEGOperationProfileEntry *>(ptr->data);
+  return int(entry->operation_name.size());
+}
+
+static int rna_DepsgraphOperationProfile_thread_index_get(PointerRNA *ptr)
+{
+  const DEGOperationProfileEntry *entry = static_cast<DEGOperationProfileEntry *>(ptr->data);
+  return entry->thread_index;
+}
+
+static float rna_DepsgraphOperationProfile_start_time_get(PointerRNA *ptr)
+{
+  const DEGOperationProfileEntry *entry = static_cast<DEGOperationProfileEntry *>(ptr->data);
+  return float(entry->start_time);
+}
+
+static float rna_DepsgraphOperationProfile_duration_get(PointerRNA *ptr)
+{
+  const DEGOperationProfileEntry *entry = static_cast<DEGOperationProfileEntry *>(ptr->data);
+  return float(entry->duration);
+}
+
+static bool rna_Depsgraph_use_operation_profile_get(PointerRNA *ptr)
+{
+  Depsgraph *depsgraph = static_cast<Depsgraph *>(ptr->data);
+  return DEG_debug_operation_profile_is_enabled(depsgraph);
+}
+
+static void rna_Depsgraph_use_operation_profile_set(PointerRNA *ptr, bool value)
+{
+  Depsgraph *depsgraph = static_cast<Depsgraph *>(ptr->data);
+  DEG_debug_operation_profile_enable(depsgraph, value);
+}
+
+static void rna_Depsgraph_operation_profile_begin(CollectionPropertyIterator *iter,
+                                                  PointerRNA *ptr)
+{
+  Depsgraph *depsgraph = static_cast<Depsgraph *>(ptr->data);
+  const blender::Span<DEGOperationProfileEntry> profile = DEG_debug_operation_profile_get(
+      depsgraph);
+  rna_iterator_array_begin(iter,
+                           const_cast<DEGOperationProfileEntry *>(profile.data()),
+                           sizeof(DEGOperationProfileEntry),
+                           int(profile.size()),
+                           false,
+                           nullptr);
+}
+
+static void rna_Depsgraph_operation_profile_write_trace(Depsgraph *depsgraph,
+                                                        ReportList *reports,
+                                                        const char *filepath)
+{
+  if (!DEG_debug_operation_profile_write_trace(depsgraph, filepath)) {
+    BKE_reportf(reports, RPT_ERROR, "Could not write trace to \"%s\"", filepath);
+  }
+}
+
 static void rna_Depsgraph_update(Depsgraph *depsgraph, Main *bmain, ReportList *reports)
 {
   if (DEG_is_evaluating(depsgraph)) {
@@ -676,6 +767,61 @@ static void rna_def_depsgraph_update(BlenderRNA *brna)
   RNA_def_property_boolean_funcs(prop, "rna_DepsgraphUpdate_is_updated_shading_get", nullptr);
 }
 
+static void rna_def_depsgraph_operation_profile(BlenderRNA *brna)
+{
+  StructRNA *srna;
+  PropertyRNA *prop;
+
+  srna = RNA_def_struct(brna, "DepsgraphOperationProfile", nullptr);
+  RNA_def_struct_ui_text(
+      srna, "Dependency Graph Operation Profile", "Evaluation of a dependency graph operation");
+
+  prop = RNA_def_property(srna, "id_name", PROP_STRING, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_string_funcs(prop,
+                                "rna_DepsgraphOperationProfile_id_name_get",
+                                "rna_DepsgraphOperationProfile_id_name_length",
+                                nullptr);
+  RNA_def_property_ui_text(
+      prop, "ID Name", "Name of the data-block the operation belongs to, including the ID code");
+
+  prop = RNA_def_property(srna, "component", PROP_STRING, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_string_funcs(prop,
+                                "rna_DepsgraphOperationProfile_component_get",
+                                "rna_DepsgraphOperationProfile_component_length",
+                                nullptr);
+  RNA_def_property_ui_text(prop, "Component", "Component of the data-block, e.g. geometry");
+
+  prop = RNA_def_property(srna, "operation", PROP_STRING, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_string_funcs(prop,
+                                "rna_DepsgraphOperationProfile_operation_get",
+                                "rna_DepsgraphOperationProfile_operation_length",
+                                nullptr);
+  RNA_def_property_ui_text(prop, "Operation", "");
+
+  prop = RNA_def_property(srna, "thread_index", PROP_INT, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_int_funcs(
+      prop, "rna_DepsgraphOperationProfile_thread_index_get", nullptr, nullptr);
+  RNA_def_property_ui_text(
+      prop, "Thread", "Identifier of the thread which evaluated the operation");
+
+  prop = RNA_def_property(srna, "start_time", PROP_FLOAT, PROP_TIME_ABSOLUTE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_float_funcs(
+      prop, "rna_DepsgraphOperationProfile_start_time_get", nullptr, nullptr);
+  RNA_def_property_ui_text(
+      prop, "Start Time", "Start of the evaluation in seconds, relative to the graph evaluation");
+
+  prop = RNA_def_property(srna, "duration", PROP_FLOAT, PROP_TIME_ABSOLUTE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_float_funcs(
+      prop, "rna_DepsgraphOperationProfile_duration_get", nullptr, nullptr);
+  RNA_def_property_ui_text(prop, "Duration", "Evaluation time in seconds");
+}
+
 static void rna_def_depsgraph(BlenderRNA *brna)
 {
   StructRNA *srna;
@@ -726,6 +872,42 @@ static void rna_def_depsgraph(BlenderRNA *brna)
       parm, PROP_THICK_WRAP, ParameterFlag(0)); /* needed for string return value */
   RNA_def_function_output(func, parm);
 
+  /* Operation profile. */
+
+  prop = RNA_def_property(srna, "use_operation_profile", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_funcs(
+      prop, "rna_Depsgraph_use_operation_profile_get", "rna_Depsgraph_use_operation_profile_set");
+  RNA_def_property_ui_text(prop,
+                           "Operation Profile",
+                           "Record the start time, duration and thread of every operation "
+                           "evaluated by the dependency graph");
+
+  prop = RNA_def_property(srna, "operation_profile", PROP_COLLECTION, PROP_NONE);
+  RNA_def_property_struct_type(prop, "DepsgraphOperationProfile");
+  RNA_def_property_collection_funcs(prop,
+                                    "rna_Depsgraph_operation_profile_begin",
+                                    "rna_iterator_array_next",
+                                    "rna_iterator_array_end",
+                                    "rna_iterator_array_get",
+                                    nullptr,
+                                    nullptr,
+                                    nullptr,
+                                    nullptr);
+  RNA_def_property_ui_text(prop,
+                           "Operation Profile",
+                           "Operations evaluated during the last evaluation, ordered by start "
+                           "time (only recorded when the operation profile is enabled)");
+
+  func = RNA_def_function(
+      srna, "operation_profile_write_trace", "rna_Depsgraph_operation_profile_write_trace");
+  RNA_def_function_ui_description(func,
+                                  "Write the operation profile in the Chrome trace event "
+                                  "format, which can be opened with Perfetto");
+  RNA_def_function_flag(func, FUNC_USE_REPORTS);
+  parm = RNA_def_string_file_path(
+      func, "filepath", nullptr, FILE_MAX, "File Name", "Output path for the trace file");
+  RNA_def_parameter_flags(parm, PropertyFlag(0), PARM_REQUIRED);
+
   /* Updates. */
 
   func = RNA_def_function(srna, "update", "rna_Depsgraph_update");
@@ -845,6 +1027,7 @@ void RNA_def_depsgraph(BlenderRNA *brna)
 {
   rna_def_depsgraph_instance(brna);
   rna_def_depsgraph_update(brna);
+  rna_def_depsgraph_operation_profile(brna);
   rna_def_depsgraph(brna);
 }
 
@@ -977,22 +977,26 @@ static void rna_def_keyblock(BlenderRNA *brna)
       prop, nullptr, "rna_ShapeKey_value_set", "rna_ShapeKey_value_range");
   RNA_def_property_ui_range(prop, -10.0f, 10.0f, 10, 3);
   RNA_def_property_ui_text(prop, "Value", "Value of shape key at the current frame");
+  RNA_def_property_flag(prop, PROP_DEG_PARAMETERS_ONLY);
   RNA_def_property_update(prop, 0, "rna_Key_update_data");
 
   prop = RNA_def_property(srna, "interpolation", PROP_ENUM, PROP_NONE);
   RNA_def_property_enum_sdna(prop, nullptr, "type");
   RNA_def_property_enum_items(prop, rna_enum_keyblock_type_items);
   RNA_def_property_ui_text(prop, "Interpolation", "Interpolation type for absolute shape keys");
+  RNA_def_property_flag(prop, PROP_DEG_PARAMETERS_ONLY);
   RNA_def_property_update(prop, 0, "rna_Key_update_data");
 
   prop = RNA_def_property(srna, "vertex_group", PROP_STRING, PROP_NONE);
   RNA_def_property_string_sdna(prop, nullptr, "vgroup");
   RNA_def_property_ui_text(prop, "Vertex Group", "Vertex weight group, to blend with basis shape");
+  RNA_def_property_flag(prop, PROP_DEG_PARAMETERS_ONLY);
   RNA_def_property_update(prop, 0, "rna_Key_update_data");
 
   prop = RNA_def_property(srna, "relative_key", PROP_POINTER, PROP_NONE);
   RNA_def_property_struct_type(prop, "ShapeKey");
-  RNA_def_property_flag(prop, PROP_EDITABLE | PROP_NEVER_NULL | PROP_PTR_NO_OWNERSHIP);
+  RNA_def_property_flag(
+      prop, PROP_EDITABLE | PROP_NEVER_NULL | PROP_PTR_NO_OWNERSHIP | PROP_DEG_PARAMETERS_ONLY);
   RNA_def_property_pointer_funcs(
       prop, "rna_ShapeKey_relative_key_get", "rna_ShapeKey_relative_key_set", nullptr, nullptr);
   RNA_def_property_ui_text(prop, "Relative Key", "Shape used as a relative key");
@@ -1003,6 +1007,7 @@ static void rna_def_keyblock(BlenderRNA *brna)
   RNA_def_property_override_flag(prop, PROPOVERRIDE_OVERRIDABLE_LIBRARY);
   RNA_def_property_ui_text(prop, "Mute", "Toggle this shape key");
   RNA_def_property_ui_icon(prop, ICON_CHECKBOX_HLT, -1);
+  RNA_def_property_flag(prop, PROP_DEG_PARAMETERS_ONLY);
   RNA_def_property_update(prop, 0, "rna_Key_update_data");
 
   prop = RNA_def_property(srna, "lock_shape", PROP_BOOLEAN, PROP_NONE);
@@ -1010,6 +1015,7 @@ static void rna_def_keyblock(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Lock Shape", "Protect the shape key from accidental sculpting and editing");
   RNA_def_property_ui_icon(prop, ICON_UNLOCKED, 1);
+  RNA_def_property_flag(prop, PROP_DEG_PARAMETERS_ONLY);
   RNA_def_property_update(prop, 0, "rna_Key_update_data");
 
   prop = RNA_def_property(srna, "slider_min", PROP_FLOAT, PROP_NONE);
@@ -1018,6 +1024,7 @@ static void rna_def_keyblock(BlenderRNA *brna)
   RNA_def_property_float_funcs(
       prop, nullptr, "rna_ShapeKey_slider_min_set", "rna_ShapeKey_slider_min_range");
   RNA_def_property_ui_text(prop, "Slider Min", "Minimum for slider");
+  RNA_def_property_flag(prop, PROP_DEG_PARAMETERS_ONLY);
   RNA_def_property_update(prop, 0, "rna_ShapeKey_update_minmax");
 
   prop = RNA_def_property(srna, "slider_max", PROP_FLOAT, PROP_NONE);
@@ -1027,6 +1034,7 @@ static void rna_def_keyblock(BlenderRNA *brna)
   RNA_def_property_float_funcs(
       prop, nullptr, "rna_ShapeKey_slider_max_set", "rna_ShapeKey_slider_max_range");
   RNA_def_property_ui_text(prop, "Slider Max", "Maximum for slider");
+  RNA_def_property_flag(prop, PROP_DEG_PARAMETERS_ONLY);
   RNA_def_property_update(prop, 0, "rna_ShapeKey_update_minmax");
 
   prop = RNA_def_property(srna, "data", PROP_COLLECTION, PROP_NONE);
@@ -22,6 +22,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_path_util.h"
+
 #include "BLT_translation.hh"
 
 #include "BKE_animsys.h"
@@ -48,6 +50,13 @@
 #include "WM_types.hh"
 
 #include "MOD_nodes.hh"
+#include "NOD_geometry_nodes_log.hh"
+
+/** Formats of #NodesModifier.profile_write. */
+enum {
+  NODES_MODIFIER_PROFILE_FORMAT_TRACE = 0,
+  NODES_MODIFIER_PROFILE_FORMAT_SUMMARY = 1,
+};
 
 const EnumPropertyItem rna_enum_object_modifier_type_items[] = {
     RNA_ENUM_ITEM_HEADING(N_("Modify"), nullptr),
@@ -847,6 +856,7 @@ static const EnumPropertyItem grease_pencil_build_time_mode_items[] = {
 #  include "DNA_particle_types.h"
 
 #  include "BKE_cachefile.hh"
+#  include "BKE_compute_contexts.hh"
 #  include "BKE_context.hh"
 #  include "BKE_deform.hh"
 #  include "BKE_material.h"
@@ -855,6 +865,7 @@ static const EnumPropertyItem grease_pencil_build_time_mode_items[] = {
 #  include "BKE_object.hh"
 #  include "BKE_particle.h"
 
+#  include "BLI_fileops.h"
 #  include "BLI_sort_utils.h"
 #  include "BLI_string_utils.hh"
 
@@ -1981,6 +1992,129 @@ static StructRNA *rna_NodesModifierBake_data_block_typef(PointerRNA *ptr)
   return ID_code_to_RNA_type(data_block->id_type);
 }
 
+static bool rna_NodesModifier_use_profile_get(PointerRNA *ptr)
+{
+  const NodesModifierData *nmd = static_cast<const NodesModifierData *>(ptr->data);
+  return nmd->runtime->use_profile;
+}
+
+static void rna_NodesModifier_use_profile_set(PointerRNA *ptr, const bool value)
+{
+  NodesModifierData *nmd = static_cast<NodesModifierData *>(ptr->data);
+  nmd->runtime->use_profile = value;
+}
+
+/**
+ * The profile is created from the log of the last evaluation, it is empty when the modifier has
+ * not been evaluated in the active depsgraph yet.
+ */
+static blender::Span<blender::nodes::geo_eval_log::NodeProfile> nodes_modifier_profile_get(
+    NodesModifierData &nmd)
+{
+  if (nmd.node_group == nullptr || !nmd.runtime->eval_log) {
+    return {};
+  }
+  const blender::bke::ModifierComputeContext modifier_compute_context{nullptr, nmd.modifier.name};
+  return nmd.runtime->eval_log->ensure_node_profile(*nmd.node_group,
+                                                    modifier_compute_context.hash());
+}
+
+static void rna_NodesModifier_profile_nodes_begin(CollectionPropertyIterator *iter,
+                                                  PointerRNA *ptr)
+{
+  using blender::nodes::geo_eval_log::NodeProfile;
+  NodesModifierData *nmd = static_cast<NodesModifierData *>(ptr->data);
+  const blender::Span<NodeProfile> profile = nodes_modifier_profile_get(*nmd);
+  rna_iterator_array_begin(iter,
+                           const_cast<NodeProfile *>(profile.data()),
+                           sizeof(NodeProfile),
+                           int(profile.size()),
+                           false,
+                           nullptr);
+}
+
+static int rna_NodesModifier_active_profile_node_index_get(PointerRNA *ptr)
+{
+  const NodesModifierData *nmd = static_cast<const NodesModifierData *>(ptr->data);
+  return nmd->runtime->active_profile_node_index;
+}
+
+static void rna_NodesModifier_active_profile_node_index_set(PointerRNA *ptr, const int value)
+{
+  NodesModifierData *nmd = static_cast<NodesModifierData *>(ptr->data);
+  nmd->runtime->active_profile_node_index = value;
+}
+
+static void rna_NodesModifier_profile_write(NodesModifierData *nmd,
+                                            ReportList *reports,
+                                            const char *filepath,
+                                            const int format)
+{
+  if (nmd->node_group == nullptr || !nmd->runtime->eval_log) {
+    BKE_report(reports, RPT_ERROR, "The modifier has not been evaluated yet");
+    return;
+  }
+  const blender::bke::ModifierComputeContext modifier_compute_context{nullptr,
+                                                                      nmd->modifier.name};
+  blender::nodes::geo_eval_log::GeoModifierLog &eval_log = *nmd->runtime->eval_log;
+  const std::string json = format == NODES_MODIFIER_PROFILE_FORMAT_TRACE ?
+                               eval_log.profile_trace_json(*nmd->node_group,
+                                                           modifier_compute_context.hash()) :
+                               eval_log.profile_summary_json(*nmd->node_group,
+                                                             modifier_compute_context.hash());
+  FILE *file = BLI_fopen(filepath, "wb");
+  if (file == nullptr) {
+    BKE_reportf(reports, RPT_ERROR, "Could not write profile to \"%s\"", filepath);
+    return;
+  }
+  const bool success = fwrite(json.data(), 1, json.size(), file) == json.size();
+  if (fclose(file) != 0 || !success) {
+    BKE_reportf(reports, RPT_ERROR, "Could not write profile to \"%s\"", filepath);
+  }
+}
+
+static void rna_NodesModifierProfileNode_node_group_name_get(PointerRNA *ptr, char *value)
+{
+  const auto *profile = static_cast<const blender::nodes::geo_eval_log::NodeProfile *>(ptr->data);
+  strcpy(value, profile->node_group_name.c_str());
+}
+
+static int rna_NodesModifierProfileNode_node_group_name_length(PointerRNA *ptr)
+{
+  const auto *profile = static_cast<const blender::nodes::geo_eval_log::NodeProfile *>(ptr->data);
+  return profile->node_group_name.size();
+}
+
+static void rna_NodesModifierProfileNode_node_name_get(PointerRNA *ptr, char *value)
+{
+  const auto *profile = static_cast<const blender::nodes::geo_eval_log::NodeProfile *>(ptr->data);
+  strcpy(value, profile->node_name.c_str());
+}
+
+static int rna_NodesModifierProfileNode_node_name_length(PointerRNA *ptr)
+{
+  const auto *profile = static_cast<const blender::nodes::geo_eval_log::NodeProfile *>(ptr->data);
+  return profile->node_name.size();
+}
+
+static int rna_NodesModifierProfileNode_executions_get(PointerRNA *ptr)
+{
+  const auto *profile = static_cast<const blender::nodes::geo_eval_log::NodeProfile *>(ptr->data);
+  return profile->executions_num;
+}
+
+static float rna_NodesModifierProfileNode_run_time_get(PointerRNA *ptr)
+{
+  const auto *profile = static_cast<const blender::nodes::geo_eval_log::NodeProfile *>(ptr->data);
+  return std::chrono::duration<float>(profile->run_time).count();
+}
+
+static float rna_NodesModifierProfileNode_output_geometry_memory_get(PointerRNA *ptr)
+{
+  const auto *profile = static_cast<const blender::nodes::geo_eval_log::NodeProfile *>(ptr->data);
+  return float(profile->output_geometry_bytes);
+}
+
 bool rna_GreasePencilModifier_material_poll(PointerRNA *ptr, PointerRNA value)
 {
   Object *ob = reinterpret_cast<Object *>(ptr->owner_id);
@@ -7865,10 +7999,73 @@ static void rna_def_modifier_nodes_panels(BlenderRNA *brna)
   RNA_def_struct_ui_text(srna, "Panels", "State of all panels defined by the node group");
 }
 
+static void rna_def_modifier_nodes_profile_node(BlenderRNA *brna)
+{
+  StructRNA *srna;
+  PropertyRNA *prop;
+
+  srna = RNA_def_struct(brna, "NodesModifierProfileNode", nullptr);
+  RNA_def_struct_ui_text(
+      srna, "Node Profile", "Run time and memory statistics of a node in the last evaluation");
+
+  prop = RNA_def_property(srna, "node_group_name", PROP_STRING, PROP_NONE);
+  RNA_def_property_string_funcs(prop,
+                                "rna_NodesModifierProfileNode_node_group_name_get",
+                                "rna_NodesModifierProfileNode_node_group_name_length",
+                                nullptr);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(prop, "Node Group", "Name of the node group that contains the node");
+
+  prop = RNA_def_property(srna, "node_name", PROP_STRING, PROP_NONE);
+  RNA_def_property_string_funcs(prop,
+                                "rna_NodesModifierProfileNode_node_name_get",
+                                "rna_NodesModifierProfileNode_node_name_length",
+                                nullptr);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(prop, "Node", "Name of the node");
+  RNA_def_struct_name_property(srna, prop);
+
+  prop = RNA_def_property(srna, "executions", PROP_INT, PROP_NONE);
+  RNA_def_property_int_funcs(prop, "rna_NodesModifierProfileNode_executions_get", nullptr, nullptr);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(
+      prop, "Executions", "Number of times the node has been executed in all instances");
+
+  prop = RNA_def_property(srna, "run_time", PROP_FLOAT, PROP_TIME_ABSOLUTE);
+  RNA_def_property_float_funcs(prop, "rna_NodesModifierProfileNode_run_time_get", nullptr, nullptr);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(prop, "Run Time", "Time spent in the node, in seconds");
+
+  prop = RNA_def_property(srna, "output_geometry_memory", PROP_FLOAT, PROP_NONE);
+  RNA_def_property_float_funcs(
+      prop, "rna_NodesModifierProfileNode_output_geometry_memory_get", nullptr, nullptr);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(prop,
+                           "Output Geometry Memory",
+                           "Memory used by the largest geometry output of the node, in bytes. "
+                           "Only recorded when memory profiling is enabled");
+}
+
 static void rna_def_modifier_nodes(BlenderRNA *brna)
 {
   StructRNA *srna;
   PropertyRNA *prop;
+  FunctionRNA *func;
+  PropertyRNA *parm;
+
+  static const EnumPropertyItem profile_format_items[] = {
+      {NODES_MODIFIER_PROFILE_FORMAT_TRACE,
+       "TRACE",
+       0,
+       "Trace",
+       "Every node execution in the Chrome trace event format, which can be opened with Perfetto"},
+      {NODES_MODIFIER_PROFILE_FORMAT_SUMMARY,
+       "SUMMARY",
+       0,
+       "Summary",
+       "Run time and memory of every node as JSON, grouped by node group"},
+      {0, nullptr, 0, nullptr, nullptr},
+  };
 
   rna_def_modifier_nodes_data_block(brna);
 
@@ -7878,6 +8075,8 @@ static void rna_def_modifier_nodes(BlenderRNA *brna)
   rna_def_modifier_nodes_panel(brna);
   rna_def_modifier_nodes_panels(brna);
 
+  rna_def_modifier_nodes_profile_node(brna);
+
   srna = RNA_def_struct(brna, "NodesModifier", "Modifier");
   RNA_def_struct_ui_text(srna, "Nodes Modifier", "");
   RNA_def_struct_sdna(srna, "NodesModifierData");
@@ -7922,6 +8121,57 @@ static void rna_def_modifier_nodes(BlenderRNA *brna)
   rna_def_modifier_panel_open_prop(srna, "open_bake_data_blocks_panel", 4);
 
   RNA_define_lib_overridable(false);
+
+  prop = RNA_def_property(srna, "use_profile", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_funcs(
+      prop, "rna_NodesModifier_use_profile_get", "rna_NodesModifier_use_profile_set");
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Profile Memory",
+                           "Also record the memory used by the geometry output of every node for "
+                           "the node profile, which makes the evaluation slower");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
+  prop = RNA_def_property(srna, "profile_nodes", PROP_COLLECTION, PROP_NONE);
+  RNA_def_property_struct_type(prop, "NodesModifierProfileNode");
+  RNA_def_property_collection_funcs(prop,
+                                    "rna_NodesModifier_profile_nodes_begin",
+                                    "rna_iterator_array_next",
+                                    "rna_iterator_array_end",
+                                    "rna_iterator_array_get",
+                                    nullptr,
+                                    nullptr,
+                                    nullptr,
+                                    nullptr);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(prop,
+                           "Node Profile",
+                           "Run time of the nodes in the last evaluation, combined for all "
+                           "instances of a node group and sorted by run time");
+
+  prop = RNA_def_property(srna, "active_profile_node_index", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_int_funcs(prop,
+                             "rna_NodesModifier_active_profile_node_index_get",
+                             "rna_NodesModifier_active_profile_node_index_set",
+                             nullptr);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE);
+  RNA_def_property_ui_text(
+      prop, "Active Profile Node Index", "Index of the active item in the node profile list");
+  RNA_def_property_update(prop, NC_OBJECT | ND_MODIFIER, nullptr);
+
+  func = RNA_def_function(srna, "profile_write", "rna_NodesModifier_profile_write");
+  RNA_def_function_ui_description(func, "Write the node profile of the last evaluation to a file");
+  RNA_def_function_flag(func, FUNC_USE_REPORTS);
+  parm = RNA_def_string_file_path(
+      func, "filepath", nullptr, FILE_MAX, "File Name", "Output path for the profile");
+  RNA_def_parameter_flags(parm, PropertyFlag(0), PARM_REQUIRED);
+  RNA_def_enum(func,
+               "format",
+               profile_format_items,
+               NODES_MODIFIER_PROFILE_FORMAT_TRACE,
+               "Format",
+               "File format of the profile");
 }
 
 static void rna_def_modifier_mesh_to_volume(BlenderRNA *brna)
@@ -6631,6 +6631,15 @@ static void rna_def_scene_ffmpeg_settings(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Autosplit Output", "Autosplit output at 2GB boundary");
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
 
+  prop = RNA_def_property(srna, "use_hardware_encoder", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flags", FFMPEG_USE_HARDWARE_ENCODER);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Encoding",
+                           "Encode H.264 with a hardware encoder (NVENC, Quick Sync, VideoToolbox "
+                           "or AMF) when one is available, otherwise use the software encoder");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
+
   prop = RNA_def_property(srna, "use_lossless_output", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, nullptr, "flags", FFMPEG_LOSSLESS_OUTPUT);
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
@@ -7056,6 +7065,16 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Overwrite", "Overwrite existing files while rendering");
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
 
+  prop = RNA_def_property(srna, "use_save_async", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "mode", R_SAVE_ASYNC);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(
+      prop,
+      "Save in Background",
+      "Save rendered frames of image sequences while the next frame renders, render write "
+      "handlers are called once a frame is saved, which may be after the next frame started");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
+
   prop = RNA_def_property(srna, "use_compositing", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, nullptr, "scemode", R_DOCOMP);
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
@@ -7424,7 +7443,10 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
 
   prop = RNA_def_property(srna, "simplify_child_particles", PROP_FLOAT, PROP_FACTOR);
   RNA_def_property_float_sdna(prop, nullptr, "simplify_particles");
-  RNA_def_property_ui_text(prop, "Simplify Child Particles", "Global child particles percentage");
+  RNA_def_property_ui_text(
+      prop,
+      "Simplify Child Particles",
+      "Global child particles percentage, also used for the number of displayed hair curves");
   RNA_def_property_update(prop, 0, "rna_Scene_simplify_update");
 
   prop = RNA_def_property(srna, "simplify_subdivision_render", PROP_INT, PROP_UNSIGNED);
@@ -7437,7 +7459,10 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
   prop = RNA_def_property(srna, "simplify_child_particles_render", PROP_FLOAT, PROP_FACTOR);
   RNA_def_property_float_sdna(prop, nullptr, "simplify_particles_render");
   RNA_def_property_ui_text(
-      prop, "Simplify Child Particles", "Global child particles percentage during rendering");
+      prop,
+      "Simplify Child Particles",
+      "Global child particles percentage during rendering, also used for the number of rendered "
+      "hair curves");
   RNA_def_property_update(prop, 0, "rna_Scene_simplify_update");
 
   prop = RNA_def_property(srna, "simplify_volumes", PROP_FLOAT, PROP_FACTOR);
@@ -33,7 +33,11 @@
 #  include "BKE_editmesh.hh"
 #  include "BKE_global.hh"
 #  include "BKE_image.h"
+#  include "BKE_node.hh"
+#  include "BKE_node_runtime.hh"
+#  include "BKE_report.hh"
 #  include "BKE_scene.hh"
+#  include "BKE_scene_runtime.hh"
 #  include "BKE_writemovie.hh"
 
 #  include "DEG_depsgraph_query.hh"
@@ -183,6 +187,25 @@ static void rna_Scene_sequencer_editing_free(Scene *scene)
   SEQ_editing_free(scene, true);
 }
 
+static float rna_Scene_compositor_node_execution_time(Scene *scene,
+                                                       ReportList *reports,
+                                                       bNode *node)
+{
+  if (scene->nodetree == nullptr || &node->owner_tree() != scene->nodetree) {
+    BKE_reportf(reports, RPT_ERROR, "Node '%s' is not in the compositing node tree", node->name);
+    return -1.0f;
+  }
+
+  const bNodeInstanceKey key = blender::bke::node_instance_key(
+      blender::bke::NODE_INSTANCE_KEY_BASE, scene->nodetree, node);
+  const blender::timeit::Nanoseconds *execution_time =
+      scene->runtime->compositor.per_node_execution_time.lookup_ptr(key);
+  if (execution_time == nullptr) {
+    return -1.0f;
+  }
+  return std::chrono::duration<float, std::milli>(*execution_time).count();
+}
+
 #  ifdef WITH_ALEMBIC
 
 static void rna_Scene_alembic_export(Scene *scene,
@@ -344,6 +367,29 @@ void RNA_api_scene(StructRNA *srna)
   func = RNA_def_function(srna, "sequence_editor_clear", "rna_Scene_sequencer_editing_free");
   RNA_def_function_ui_description(func, "Clear sequence editor in this scene");
 
+  /* Compositor. */
+  func = RNA_def_function(
+      srna, "compositor_node_execution_time", "rna_Scene_compositor_node_execution_time");
+  RNA_def_function_ui_description(
+      func,
+      "Get the execution time of a node of the compositing node tree during the last interactive "
+      "compositing, the time of group nodes includes all the nodes inside the group. Nodes "
+      "executed on the GPU are timed on the GPU when supported");
+  RNA_def_function_flag(func, FUNC_USE_REPORTS);
+  parm = RNA_def_pointer(func, "node", "Node", "", "Node of the compositing node tree");
+  RNA_def_parameter_flags(parm, PROP_NEVER_NULL, PARM_REQUIRED);
+  parm = RNA_def_float(func,
+                       "time",
+                       0.0f,
+                       -1.0f,
+                       FLT_MAX,
+                       "",
+                       "Execution time in milliseconds, -1 if the node was not timed, for "
+                       "instance because it was executed together with other pixel-wise nodes",
+                       -1.0f,
+                       FLT_MAX);
+  RNA_def_function_return(func, parm);
+
 #  ifdef WITH_ALEMBIC
   /* XXX Deprecated, will be removed in 2.8 in favor of calling the export operator. */
   func = RNA_def_function(srna, "alembic_export", "rna_Scene_alembic_export");
@@ -6074,6 +6074,15 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Memory Cache Limit", "Memory cache limit (in megabytes)");
   RNA_def_property_update(prop, 0, "rna_Userdef_memcache_update");
 
+  prop = RNA_def_property(srna, "use_sequencer_hardware_decoding", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(
+      prop, nullptr, "sequencer_editor_flag", USER_SEQ_ED_HARDWARE_DECODING);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Decoding",
+                           "Decode movie strips with the GPU or a dedicated video decoder when "
+                           "one supports the movie, falling back to software decoding (applies to "
+                           "movies opened afterwards)");
+
   /* Sequencer disk cache */
 
   prop = RNA_def_property(srna, "use_sequencer_disk_cache", PROP_BOOLEAN, PROP_NONE);
@@ -7443,6 +7452,23 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
   RNA_def_property_boolean_sdna(prop, nullptr, "enable_new_cpu_compositor", 1);
   RNA_def_property_ui_text(prop, "CPU Compositor", "Enable the new CPU compositor");
 
+  prop = RNA_def_property(srna, "use_background_playback_evaluation", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "use_background_playback_evaluation", 1);
+  RNA_def_property_ui_text(prop,
+                           "Background Playback Evaluation",
+                           "Evaluate the next frame of the animation playback in a background "
+                           "thread while the current frame is drawn, for scenes without "
+                           "simulations. Uses a second copy of the evaluated scene");
+
+  prop = RNA_def_property(srna, "use_volume_delay_load", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "use_volume_delay_load", 1);
+  RNA_def_property_ui_text(prop,
+                           "Volume Delay Loading",
+                           "Only read the voxel data of OpenVDB grids from disk when it is "
+                           "accessed, which reduces memory usage when only parts of large files "
+                           "are used. The files are memory mapped and must not be modified while "
+                           "they are used");
+
   prop = RNA_def_property(srna, "use_all_linked_data_direct", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_ui_text(
       prop,
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+
 struct NodesModifierData;
 struct Object;
 
@@ -23,6 +26,8 @@ void MOD_nodes_update_interface(Object *object, NodesModifierData *nmd);
 
 namespace blender {
 
+struct NodesModifierEvalCache;
+
 struct NodesModifierRuntime {
   /**
    * Contains logged information from the last evaluation.
@@ -37,6 +42,24 @@ struct NodesModifierRuntime {
    * used by the evaluated modifier.
    */
   std::shared_ptr<bke::bake::ModifierCache> cache;
+  /**
+   * Inputs and result of the last evaluation of an evaluated modifier, to reuse the result when
+   * the modifier is evaluated again with the same inputs. Not shared with the original modifier.
+   */
+  std::shared_ptr<NodesModifierEvalCache> eval_cache;
+  /**
+   * Number of evaluations that reused the previous result or that had to compute it, only counted
+   * when the inputs could be compared. Stored in the original modifier to display them.
+   */
+  std::atomic<int64_t> eval_cache_hits = 0;
+  std::atomic<int64_t> eval_cache_misses = 0;
+  /**
+   * Also log the memory used by the geometries output by every node, for the node profile. Only
+   * used in the original modifier.
+   */
+  bool use_profile = false;
+  /** Active item in the list of profiled nodes in the UI. */
+  int active_profile_node_index = 0;
 };
 
 void nodes_modifier_data_block_destruct(NodesModifierDataBlock *data_block, bool do_id_user);
@@ -9,18 +9,22 @@
 #include <cstring>
 #include <fmt/format.h>
 #include <iostream>
+#include <optional>
 #include <sstream>
 #include <string>
 
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array.hh"
+#include "BLI_implicit_sharing_ptr.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_vector_types.hh"
 #include "BLI_multi_value_map.hh"
 #include "BLI_path_util.h"
 #include "BLI_set.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
+#include "BLI_task_trace.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_array_utils.hh"
@@ -40,6 +44,7 @@
 #include "DNA_view3d_types.h"
 #include "DNA_windowmanager_types.h"
 
+#include "BKE_anim_data.hh"
 #include "BKE_attribute_math.hh"
 #include "BKE_bake_data_block_map.hh"
 #include "BKE_bake_geometry_nodes_modifier.hh"
@@ -961,27 +966,110 @@ static BakeFrameIndices get_bake_frame_indices(
   return frame_indices;
 }
 
+static std::optional<bke::bake::BakeState> load_baked_frame(const bake::NodeBakeCache &bake_cache,
+                                                            const bake::FrameCache &frame_cache)
+{
+  bke::bake::DiskBlobReader blob_reader{*bake_cache.blobs_dir};
+  fstream meta_file{*frame_cache.meta_path};
+  return bke::bake::deserialize_bake(meta_file, blob_reader, *bake_cache.blob_sharing);
+}
+
 static void ensure_bake_loaded(bake::NodeBakeCache &bake_cache, bake::FrameCache &frame_cache)
 {
-  if (!frame_cache.state.items_by_id.is_empty()) {
-    return;
-  }
   if (!bake_cache.blobs_dir) {
     return;
   }
   if (!frame_cache.meta_path) {
     return;
   }
-  bke::bake::DiskBlobReader blob_reader{*bake_cache.blobs_dir};
-  fstream meta_file{*frame_cache.meta_path};
-  std::optional<bke::bake::BakeState> bake_state = bke::bake::deserialize_bake(
-      meta_file, blob_reader, *bake_cache.blob_sharing);
+  if (frame_cache.is_prefetching) {
+    /* Loading the frame again would only compete with the prefetch for the disk. */
+    BLI_task_pool_work_and_wait(bake_cache.prefetch_pool);
+  }
+  std::lock_guard lock{bake_cache.prefetch_mutex};
+  if (!frame_cache.state.items_by_id.is_empty()) {
+    return;
+  }
+  std::optional<bke::bake::BakeState> bake_state = load_baked_frame(bake_cache, frame_cache);
   if (!bake_state.has_value()) {
     return;
   }
   frame_cache.state = std::move(*bake_state);
 }
 
+/** Number of frames that are loaded ahead of the current frame during playback. */
+static constexpr int bake_prefetch_frames_num = 8;
+
+struct BakePrefetchTask {
+  bake::NodeBakeCache *bake_cache;
+  bake::FrameCache *frame_cache;
+};
+
+static void bake_prefetch_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  const BakePrefetchTask &task = *static_cast<const BakePrefetchTask *>(taskdata);
+  bake::FrameCache &frame_cache = *task.frame_cache;
+  if (!BLI_task_pool_current_canceled(pool)) {
+    /* Load without the lock, so that frames which are loaded already can still be read. */
+    std::optional<bke::bake::BakeState> bake_state = load_baked_frame(*task.bake_cache,
+                                                                      frame_cache);
+    std::lock_guard lock{task.bake_cache->prefetch_mutex};
+    if (bake_state && frame_cache.state.items_by_id.is_empty()) {
+      frame_cache.state = std::move(*bake_state);
+    }
+  }
+  frame_cache.is_prefetching = false;
+}
+
+/**
+ * Start loading the frames that follow \a frame_index in the playback direction in the
+ * background, when the frames are read one after another. Baked frames stay loaded once they
+ * were read anyway, so this only loads them earlier.
+ */
+static void prefetch_baked_frames(bake::NodeBakeCache &bake_cache, const int frame_index)
+{
+  const std::optional<int> last_frame_index = bake_cache.last_read_frame_index;
+  bake_cache.last_read_frame_index = frame_index;
+  if (!last_frame_index || !bake_cache.blobs_dir || G.is_rendering) {
+    return;
+  }
+  const int direction = frame_index - *last_frame_index;
+  if (!ELEM(direction, -1, 1)) {
+    return;
+  }
+  for (int i = 1; i <= bake_prefetch_frames_num; i++) {
+    const int prefetch_index = frame_index + i * direction;
+    if (!bake_cache.frames.index_range().contains(prefetch_index)) {
+      break;
+    }
+    bake::FrameCache &frame_cache = *bake_cache.frames[prefetch_index];
+    if (!frame_cache.meta_path || frame_cache.is_prefetching) {
+      continue;
+    }
+    {
+      std::lock_guard lock{bake_cache.prefetch_mutex};
+      if (!frame_cache.state.items_by_id.is_empty()) {
+        continue;
+      }
+    }
+    if (bake_cache.prefetch_pool == nullptr) {
+      bake_cache.prefetch_pool = BLI_task_pool_create_background(nullptr, TASK_PRIORITY_LOW);
+    }
+    frame_cache.is_prefetching = true;
+    BakePrefetchTask *task = MEM_new<BakePrefetchTask>(__func__);
+    task->bake_cache = &bake_cache;
+    task->frame_cache = &frame_cache;
+    BLI_task_pool_push(
+        bake_cache.prefetch_pool,
+        bake_prefetch_task_run,
+        task,
+        true,
+        [](TaskPool * /*pool*/, void *taskdata) {
+          MEM_delete(static_cast<BakePrefetchTask *>(taskdata));
+        });
+  }
+}
+
 static bool try_find_baked_data(bake::NodeBakeCache &bake,
                                 const Main &bmain,
                                 const Object &object,
@@ -1326,6 +1414,9 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
   {
     bake::FrameCache &frame_cache = *node_cache.bake.frames[frame_index];
     ensure_bake_loaded(node_cache.bake, frame_cache);
+    if (depsgraph_is_active_) {
+      prefetch_baked_frames(node_cache.bake, frame_index);
+    }
     auto &read_single_info = zone_behavior.output.emplace<sim_output::ReadSingle>();
     read_single_info.state = frame_cache.state;
   }
@@ -1339,6 +1430,9 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
     bake::FrameCache &next_frame_cache = *node_cache.bake.frames[next_frame_index];
     ensure_bake_loaded(node_cache.bake, prev_frame_cache);
     ensure_bake_loaded(node_cache.bake, next_frame_cache);
+    if (depsgraph_is_active_) {
+      prefetch_baked_frames(node_cache.bake, next_frame_index);
+    }
     auto &read_interpolated_info = zone_behavior.output.emplace<sim_output::ReadInterpolated>();
     read_interpolated_info.mix_factor = (float(current_frame_) - float(prev_frame_cache.frame)) /
                                         (float(next_frame_cache.frame) -
@@ -1469,6 +1563,9 @@ class NodesModifierBakeParams : public nodes::GeoNodesBakeParams {
   {
     bake::FrameCache &frame_cache = *node_cache.bake.frames[frame_index];
     ensure_bake_loaded(node_cache.bake, frame_cache);
+    if (depsgraph_is_active_) {
+      prefetch_baked_frames(node_cache.bake, frame_index);
+    }
     if (this->check_read_error(frame_cache, behavior)) {
       return;
     }
@@ -1485,6 +1582,9 @@ class NodesModifierBakeParams : public nodes::GeoNodesBakeParams {
     bake::FrameCache &next_frame_cache = *node_cache.bake.frames[next_frame_index];
     ensure_bake_loaded(node_cache.bake, prev_frame_cache);
     ensure_bake_loaded(node_cache.bake, next_frame_cache);
+    if (depsgraph_is_active_) {
+      prefetch_baked_frames(node_cache.bake, next_frame_index);
+    }
     if (this->check_read_error(prev_frame_cache, behavior) ||
         this->check_read_error(next_frame_cache, behavior))
     {
@@ -1672,6 +1772,289 @@ static void add_data_block_items_writeback(const ModifierEvalContext &ctx,
       });
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Reuse of the Previous Evaluation
+ *
+ * The depsgraph re-evaluates the modifier whenever its inputs may have changed, which is
+ * conservative: every frame when there is a Scene Time node anywhere in the node tree, even when
+ * it is not used, or when a driver changes a property of the object that the node tree does not
+ * use. The inputs of every evaluation are compared with the inputs of the previous one, and the
+ * previous result is reused when they are the same.
+ * \{ */
+
+struct IDPropertyNoUserDeleter {
+  void operator()(IDProperty *property) const
+  {
+    IDP_FreeProperty_ex(property, false);
+  }
+};
+
+/**
+ * Inputs of a geometry nodes evaluation that the result depends on. Only created when the
+ * evaluation does not depend on any other data, see #nodes_modifier_eval_inputs_gather.
+ */
+struct NodesModifierEvalInputs {
+  struct Layer {
+    int domain;
+    int type;
+    std::string name;
+    int flag;
+    int active;
+    int active_rnd;
+    /** Holds a user, so the data can't be freed and the pointer can't be reused meanwhile. */
+    ImplicitSharingPtr<> sharing_info;
+    int64_t version;
+
+    friend bool operator==(const Layer &a, const Layer &b)
+    {
+      return a.domain == b.domain && a.type == b.type && a.name == b.name && a.flag == b.flag &&
+             a.active == b.active && a.active_rnd == b.active_rnd &&
+             a.sharing_info == b.sharing_info && a.version == b.version;
+    }
+  };
+
+  int verts_num;
+  int edges_num;
+  int faces_num;
+  int corners_num;
+  Vector<Layer> layers;
+  Vector<std::string> vertex_group_names;
+  Vector<const Material *> materials;
+  std::string geometry_name;
+
+  /** Copy of the modifier properties, without users of the referenced data-blocks. */
+  std::unique_ptr<IDProperty, IDPropertyNoUserDeleter> properties;
+  /** #DEG_id_tag_stamp_get of the node tree and of all node groups it uses. */
+  Vector<uint64_t> tree_tag_stamps;
+  float4x4 object_to_world;
+  /** Only set when the node tree uses the scene time. */
+  std::optional<float> frame;
+  int eval_flag;
+
+  friend bool operator==(const NodesModifierEvalInputs &a, const NodesModifierEvalInputs &b)
+  {
+    return a.verts_num == b.verts_num && a.edges_num == b.edges_num &&
+           a.faces_num == b.faces_num && a.corners_num == b.corners_num &&
+           a.layers == b.layers && a.vertex_group_names == b.vertex_group_names &&
+           a.materials == b.materials && a.geometry_name == b.geometry_name &&
+           IDP_EqualsProperties_ex(a.properties.get(), b.properties.get(), true) &&
+           a.tree_tag_stamps == b.tree_tag_stamps && a.object_to_world == b.object_to_world &&
+           a.frame == b.frame && a.eval_flag == b.eval_flag;
+  }
+};
+
+struct NodesModifierEvalCache {
+  NodesModifierEvalInputs inputs;
+  bke::GeometrySet result;
+};
+
+/**
+ * Nodes whose output depends on data that is not compared for the reuse of the previous result,
+ * like the evaluated state of other objects or animated images.
+ */
+static bool node_prevents_eval_cache(const bNode &node)
+{
+  static const Set<StringRef> idnames = {"GeometryNodeBake",
+                                         "GeometryNodeCollectionInfo",
+                                         "GeometryNodeImageInfo",
+                                         "GeometryNodeImageTexture",
+                                         "GeometryNodeInputActiveCamera",
+                                         "GeometryNodeObjectInfo",
+                                         "GeometryNodeSelfObject",
+                                         "GeometryNodeSimulationInput",
+                                         "GeometryNodeSimulationOutput"};
+  return idnames.contains(node.idname);
+}
+
+/**
+ * Gather the inputs of the nodes which are used to compute the group outputs of the tree, nodes
+ * in unused branches are ignored.
+ *
+ * \return False if the nodes depend on data that is not gathered.
+ */
+static bool tree_eval_inputs_gather(const bNodeTree &tree,
+                                    const Depsgraph &depsgraph,
+                                    Set<const bNodeTree *> &checked_groups,
+                                    NodesModifierEvalInputs &inputs,
+                                    bool &r_uses_time)
+{
+  if (!checked_groups.add(&tree)) {
+    return true;
+  }
+  /* Animated values of nodes are not compared. */
+  if (BKE_animdata_id_is_animated(&tree.id)) {
+    return false;
+  }
+  inputs.tree_tag_stamps.append(DEG_id_tag_stamp_get(&depsgraph, &tree.id));
+
+  tree.ensure_topology_cache();
+  const bNode *output_node = tree.group_output_node();
+  if (output_node == nullptr) {
+    return true;
+  }
+  Set<const bNode *> used_nodes = {output_node};
+  Vector<const bNode *> nodes_to_check = {output_node};
+  const auto add_used_node = [&](const bNode *node) {
+    if (used_nodes.add(node)) {
+      nodes_to_check.append(node);
+    }
+  };
+  while (!nodes_to_check.is_empty()) {
+    const bNode &node = *nodes_to_check.pop_last();
+    if (node_prevents_eval_cache(node)) {
+      return false;
+    }
+    if (STREQ(node.idname, "GeometryNodeInputSceneTime")) {
+      r_uses_time = true;
+    }
+    if (node.is_group() && node.id != nullptr) {
+      if (!tree_eval_inputs_gather(*reinterpret_cast<const bNodeTree *>(node.id),
+                                   depsgraph,
+                                   checked_groups,
+                                   inputs,
+                                   r_uses_time))
+      {
+        return false;
+      }
+    }
+    /* The input node of a zone is used by the output node, even when it is not linked. */
+    if (const bke::bNodeZoneType *zone_type = bke::zone_type_by_node_type(node.type)) {
+      if (node.type == zone_type->output_type) {
+        if (const bNode *input_node = zone_type->get_corresponding_input(tree, node)) {
+          add_used_node(input_node);
+        }
+      }
+    }
+    for (const bNodeSocket *socket : node.input_sockets()) {
+      if (!socket->is_available()) {
+        continue;
+      }
+      for (const bNodeLink *link : socket->directly_linked_links()) {
+        if (link->is_used()) {
+          add_used_node(link->fromnode);
+        }
+      }
+    }
+  }
+  return true;
+}
+
+static bool mesh_eval_inputs_gather(const Mesh &mesh, NodesModifierEvalInputs &inputs)
+{
+  /* Edit-mesh wrappers don't store their data in the custom data layers. */
+  if (mesh.runtime->wrapper_type != ME_WRAPPER_TYPE_MDATA) {
+    return false;
+  }
+  inputs.verts_num = mesh.verts_num;
+  inputs.edges_num = mesh.edges_num;
+  inputs.faces_num = mesh.faces_num;
+  inputs.corners_num = mesh.corners_num;
+  const std::array<const CustomData *, 4> domains = {
+      &mesh.vert_data, &mesh.edge_data, &mesh.face_data, &mesh.corner_data};
+  for (const int domain : IndexRange(domains.size())) {
+    const CustomData &data = *domains[domain];
+    for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+      if (layer.data != nullptr && layer.sharing_info == nullptr) {
+        return false;
+      }
+      ImplicitSharingPtr<> sharing_info;
+      if (layer.sharing_info != nullptr) {
+        layer.sharing_info->add_user();
+        sharing_info = ImplicitSharingPtr<>(layer.sharing_info);
+      }
+      const int64_t version = layer.sharing_info ? layer.sharing_info->version() : 0;
+      inputs.layers.append({domain,
+                            layer.type,
+                            layer.name,
+                            layer.flag,
+                            layer.active,
+                            layer.active_rnd,
+                            std::move(sharing_info),
+                            version});
+    }
+  }
+  if (mesh.face_offset_indices != nullptr) {
+    const ImplicitSharingInfo *face_offsets = mesh.runtime->face_offsets_sharing_info;
+    if (face_offsets == nullptr) {
+      return false;
+    }
+    const int64_t version = face_offsets->version();
+    face_offsets->add_user();
+    inputs.layers.append({-1, -1, "", 0, 0, 0, ImplicitSharingPtr<>(face_offsets), version});
+  }
+  LISTBASE_FOREACH (const bDeformGroup *, group, &mesh.vertex_group_names) {
+    inputs.vertex_group_names.append(group->name);
+  }
+  for (const int i : IndexRange(mesh.totcol)) {
+    inputs.materials.append(mesh.mat[i]);
+  }
+  return true;
+}
+
+/**
+ * Gather the inputs of the evaluation of the modifier.
+ *
+ * \return Nothing when the result of the evaluation can't be reused for the same inputs.
+ */
+static std::optional<NodesModifierEvalInputs> nodes_modifier_eval_inputs_gather(
+    const NodesModifierData &nmd,
+    const ModifierEvalContext &ctx,
+    const bke::GeometrySet &geometry_set)
+{
+  if (ctx.flag & (MOD_APPLY_ORCO | MOD_APPLY_TO_ORIGINAL)) {
+    return std::nullopt;
+  }
+  /* The state of simulations and bakes depends on the previous frames. */
+  if (nmd.bakes_num > 0) {
+    return std::nullopt;
+  }
+
+  NodesModifierEvalInputs inputs;
+  inputs.geometry_name = geometry_set.name;
+  for (const bke::GeometryComponent::Type type : geometry_set.gather_component_types(true, true)) {
+    if (type != bke::GeometryComponent::Type::Mesh) {
+      return std::nullopt;
+    }
+  }
+  if (const Mesh *mesh = geometry_set.get_mesh()) {
+    if (!mesh_eval_inputs_gather(*mesh, inputs)) {
+      return std::nullopt;
+    }
+  }
+
+  if (nmd.settings.properties != nullptr) {
+    bool has_data_block_input = false;
+    IDP_foreach_property(nmd.settings.properties, IDP_TYPE_FILTER_ID, [&](IDProperty *id_prop) {
+      const ID *id = IDP_Id(id_prop);
+      if (id != nullptr && GS(id->name) != ID_MA) {
+        has_data_block_input = true;
+      }
+    });
+    /* The evaluated state of objects, collections and images is not compared. */
+    if (has_data_block_input) {
+      return std::nullopt;
+    }
+    inputs.properties.reset(
+        IDP_CopyProperty_ex(nmd.settings.properties, LIB_ID_CREATE_NO_USER_REFCOUNT));
+  }
+
+  bool uses_time = false;
+  Set<const bNodeTree *> checked_groups;
+  if (!tree_eval_inputs_gather(
+          *nmd.node_group, *ctx.depsgraph, checked_groups, inputs, uses_time))
+  {
+    return std::nullopt;
+  }
+  if (uses_time) {
+    inputs.frame = DEG_get_ctime(ctx.depsgraph);
+  }
+  inputs.object_to_world = ctx.object->object_to_world();
+  inputs.eval_flag = ctx.flag;
+  return inputs;
+}
+
+/** \} */
+
 static void modifyGeometry(ModifierData *md,
                            const ModifierEvalContext *ctx,
                            bke::GeometrySet &geometry_set)
@@ -1683,6 +2066,7 @@ static void modifyGeometry(ModifierData *md,
   }
   NodesModifierData *nmd_orig = reinterpret_cast<NodesModifierData *>(
       BKE_modifier_get_original(ctx->object, &nmd->modifier));
+  threading::trace::ScopedLabel trace_label("Geometry Nodes");
 
   const bNodeTree &tree = *nmd->node_group;
   check_property_socket_sync(ctx->object, md);
@@ -1745,12 +2129,28 @@ static void modifyGeometry(ModifierData *md,
 
     find_socket_log_contexts(*nmd, *ctx, socket_log_contexts);
     call_data.socket_log_contexts = &socket_log_contexts;
+    call_data.log_output_geometry_sizes = nmd_orig->runtime->use_profile;
   }
 
   nodes::GeoNodesSideEffectNodes side_effect_nodes;
   find_side_effect_nodes(*nmd, *ctx, side_effect_nodes, socket_log_contexts);
   call_data.side_effect_nodes = &side_effect_nodes;
 
+  /* Viewer and gizmo nodes have to be evaluated again for their side effects. */
+  std::optional<NodesModifierEvalInputs> eval_inputs;
+  if (side_effect_nodes.nodes_by_context.size() == 0) {
+    eval_inputs = nodes_modifier_eval_inputs_gather(*nmd, *ctx, geometry_set);
+  }
+  if (eval_inputs) {
+    const NodesModifierEvalCache *eval_cache = nmd->runtime->eval_cache.get();
+    if (eval_cache != nullptr && eval_cache->inputs == *eval_inputs) {
+      geometry_set = eval_cache->result;
+      nmd_orig->runtime->eval_cache_hits++;
+      return;
+    }
+    nmd_orig->runtime->eval_cache_misses++;
+  }
+
   bke::ModifierComputeContext modifier_compute_context{nullptr, nmd->modifier.name};
 
   geometry_set = nodes::execute_geometry_nodes_on_geometry(tree,
@@ -1783,6 +2183,14 @@ static void modifyGeometry(ModifierData *md,
       }
     }
   }
+
+  if (eval_inputs) {
+    nmd->runtime->eval_cache = std::make_shared<NodesModifierEvalCache>(
+        NodesModifierEvalCache{std::move(*eval_inputs), geometry_set});
+  }
+  else {
+    nmd->runtime->eval_cache.reset();
+  }
 }
 
 static Mesh *modify_mesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *mesh)
@@ -2311,6 +2719,15 @@ static void draw_manage_panel(const bContext *C,
   {
     draw_named_attributes_panel(panel_layout, nmd);
   }
+
+  const int64_t eval_cache_hits = nmd.runtime->eval_cache_hits;
+  const int64_t eval_cache_misses = nmd.runtime->eval_cache_misses;
+  if (eval_cache_hits + eval_cache_misses > 0) {
+    const std::string text = fmt::format(RPT_("Reused results: {} of {} evaluations"),
+                                         eval_cache_hits,
+                                         eval_cache_hits + eval_cache_misses);
+    uiItemL(layout, text.c_str(), ICON_INFO);
+  }
 }
 
 static void panel_draw(const bContext *C, Panel *panel)
@@ -894,6 +894,87 @@ static bool lineart_shadow_cast_onto_triangle(LineartData *ld,
   return true;
 }
 
+static void lineart_shadow_cast_single_edge(LineartData *ld,
+                                            LineartShadowEdge *sedge,
+                                            const int thread_id)
+{
+  LineartTriangleThread *tri;
+  double at_1, at_2;
+  double fb_co_1[4], fb_co_2[4];
+  double global_1[3], global_2[3];
+  bool facing_light;
+
+  LRT_EDGE_BA_MARCHING_BEGIN(sedge->fbc1, sedge->fbc2)
+  {
+    for (int i = 0; i < nba->triangle_count; i++) {
+      tri = (LineartTriangleThread *)nba->linked_triangles[i];
+      /* If we are already testing the edge in this thread, then don't do it. */
+      if (tri->testing_e[thread_id] == (LineartEdge *)sedge || tri->base.mat_occlusion == 0 ||
+          lineart_edge_from_triangle(
+              (LineartTriangle *)tri, sedge->e_ref, ld->conf.allow_overlapping_edges))
+      {
+        continue;
+      }
+      tri->testing_e[thread_id] = (LineartEdge *)sedge;
+
+      if (lineart_shadow_cast_onto_triangle(ld,
+                                            (LineartTriangle *)tri,
+                                            sedge,
+                                            &at_1,
+                                            &at_2,
+                                            fb_co_1,
+                                            fb_co_2,
+                                            global_1,
+                                            global_2,
+                                            &facing_light))
+      {
+        lineart_shadow_edge_cut(ld,
+                                sedge,
+                                at_1,
+                                at_2,
+                                global_1,
+                                global_2,
+                                fb_co_1,
+                                fb_co_2,
+                                facing_light,
+                                tri->base.target_reference);
+      }
+    }
+    LRT_EDGE_BA_MARCHING_NEXT(sedge->fbc1, sedge->fbc2);
+  }
+  LRT_EDGE_BA_MARCHING_END;
+}
+
+struct LineartShadowCastData {
+  LineartData *ld;
+  /** Index of the first shadow edge which isn't handled by any thread yet. */
+  int scheduled_count;
+};
+
+static void lineart_shadow_cast_worker(TaskPool *__restrict pool, void *taskdata)
+{
+  LineartShadowCastData *data = static_cast<LineartShadowCastData *>(
+      BLI_task_pool_user_data(pool));
+  LineartData *ld = data->ld;
+  const int thread_id = POINTER_AS_INT(taskdata);
+
+  while (true) {
+    BLI_spin_lock(&ld->lock_task);
+    const int starting_index = data->scheduled_count;
+    data->scheduled_count += LRT_THREAD_EDGE_COUNT;
+    BLI_spin_unlock(&ld->lock_task);
+
+    if (starting_index >= ld->shadow_edges_count) {
+      break;
+    }
+    const int end_index = std::min(starting_index + LRT_THREAD_EDGE_COUNT,
+                                   ld->shadow_edges_count);
+    for (int edge_i = starting_index; edge_i < end_index; edge_i++) {
+      lineart_shadow_cast_single_edge(ld, &ld->shadow_edges[edge_i], thread_id);
+    }
+  }
+}
+
 /* The one step all to cast all visible edges in light camera back to other geometries behind them,
  * the result of this step can then be generated as actual LineartEdge's for occlusion test in view
  * camera. */
@@ -902,55 +983,19 @@ static void lineart_shadow_cast(LineartData *ld, bool transform_edge_cuts, bool
 
   lineart_shadow_create_shadow_edge_array(ld, transform_edge_cuts, do_light_contour);
 
-  /* Keep it single threaded for now because the loop will write "done" pointers to triangles. */
-  for (int edge_i = 0; edge_i < ld->shadow_edges_count; edge_i++) {
-    LineartShadowEdge *sedge = &ld->shadow_edges[edge_i];
-
-    LineartTriangleThread *tri;
-    double at_1, at_2;
-    double fb_co_1[4], fb_co_2[4];
-    double global_1[3], global_2[3];
-    bool facing_light;
+  /* Every shadow edge only cuts its own segments, segment memory is given out thread safely. Like
+   * for occlusion, every thread marks the triangles it tested with its own slot of
+   * #LineartTriangleThread::testing_e. */
+  LineartShadowCastData data{};
+  data.ld = ld;
+  data.scheduled_count = 0;
 
-    LRT_EDGE_BA_MARCHING_BEGIN(sedge->fbc1, sedge->fbc2)
-    {
-      for (int i = 0; i < nba->triangle_count; i++) {
-        tri = (LineartTriangleThread *)nba->linked_triangles[i];
-        if (tri->testing_e[0] == (LineartEdge *)sedge || tri->base.mat_occlusion == 0 ||
-            lineart_edge_from_triangle(
-                (LineartTriangle *)tri, sedge->e_ref, ld->conf.allow_overlapping_edges))
-        {
-          continue;
-        }
-        tri->testing_e[0] = (LineartEdge *)sedge;
-
-        if (lineart_shadow_cast_onto_triangle(ld,
-                                              (LineartTriangle *)tri,
-                                              sedge,
-                                              &at_1,
-                                              &at_2,
-                                              fb_co_1,
-                                              fb_co_2,
-                                              global_1,
-                                              global_2,
-                                              &facing_light))
-        {
-          lineart_shadow_edge_cut(ld,
-                                  sedge,
-                                  at_1,
-                                  at_2,
-                                  global_1,
-                                  global_2,
-                                  fb_co_1,
-                                  fb_co_2,
-                                  facing_light,
-                                  tri->base.target_reference);
-        }
-      }
-      LRT_EDGE_BA_MARCHING_NEXT(sedge->fbc1, sedge->fbc2);
-    }
-    LRT_EDGE_BA_MARCHING_END;
+  TaskPool *tp = BLI_task_pool_create(&data, TASK_PRIORITY_HIGH);
+  for (int i = 0; i < ld->thread_count; i++) {
+    BLI_task_pool_push(tp, lineart_shadow_cast_worker, POINTER_FROM_INT(i), false, nullptr);
   }
+  BLI_task_pool_work_and_wait(tp);
+  BLI_task_pool_free(tp);
 }
 
 /* For each [segment] on a shadow shadow_edge, 1 LineartEdge will be generated with a cast shadow
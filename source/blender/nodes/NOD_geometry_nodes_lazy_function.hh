@@ -238,6 +238,11 @@ struct GeoNodesCallData {
    * If this is null, all socket values will be logged.
    */
   const Set<ComputeContextHash> *socket_log_contexts = nullptr;
+  /**
+   * Log the memory used by geometries output by every node, in all compute contexts. This is
+   * used for profiling, counting the memory usage adds overhead for every geometry output.
+   */
+  bool log_output_geometry_sizes = false;
 
   /**
    * Data from the modifier that is being evaluated.
@@ -230,6 +230,10 @@ class GeoTreeLogger {
   struct EvaluatedGizmoNode {
     int32_t node_id;
   };
+  struct NodeOutputGeometrySize {
+    int32_t node_id;
+    int64_t bytes;
+  };
 
   linear_allocator::ChunkedList<WarningWithNode> node_warnings;
   linear_allocator::ChunkedList<SocketValueLog, 16> input_socket_values;
@@ -240,6 +244,8 @@ class GeoTreeLogger {
   linear_allocator::ChunkedList<DebugMessage> debug_messages;
   /** Keeps track of which gizmo nodes have been tracked by this evaluation. */
   linear_allocator::ChunkedList<EvaluatedGizmoNode> evaluated_gizmo_nodes;
+  /** Memory used by geometries output by nodes, only logged when profiling is enabled. */
+  linear_allocator::ChunkedList<NodeOutputGeometrySize, 16> node_output_geometry_sizes;
 
   GeoTreeLogger();
   ~GeoTreeLogger();
@@ -265,6 +271,8 @@ class GeoNodeLog {
    * inside.
    */
   std::chrono::nanoseconds run_time{0};
+  /** Memory used by the largest geometry output of the node, in bytes. */
+  int64_t output_geometry_bytes = 0;
   /** Maps from socket indices to their values. */
   Map<int, ValueLog *> input_values_;
   Map<int, ValueLog *> output_values_;
@@ -279,6 +287,20 @@ class GeoNodeLog {
 
 class GeoModifierLog;
 
+/**
+ * Run time and memory statistics of a node, combined for all evaluations of the node in the
+ * different instances of its node group.
+ */
+struct NodeProfile {
+  std::string node_group_name;
+  std::string node_name;
+  /** Number of times the node has been executed, e.g. in separate repeat zone iterations. */
+  int executions_num = 0;
+  std::chrono::nanoseconds run_time{0};
+  /** Memory used by the largest geometry output of the node, in bytes. */
+  int64_t output_geometry_bytes = 0;
+};
+
 /**
  * Contains data that has been logged for a specific node group in a context. If the same node
  * group is used multiple times, there will be a different #GeoTreeLog for every instance.
@@ -299,6 +321,7 @@ class GeoTreeLog {
   bool reduced_used_named_attributes_ = false;
   bool reduced_debug_messages_ = false;
   bool reduced_evaluated_gizmo_nodes_ = false;
+  bool reduced_node_output_geometry_sizes_ = false;
 
  public:
   Map<int32_t, GeoNodeLog> nodes;
@@ -320,6 +343,7 @@ class GeoTreeLog {
   void ensure_used_named_attributes();
   void ensure_debug_messages();
   void ensure_evaluated_gizmo_nodes();
+  void ensure_node_output_geometry_sizes();
 
   ValueLog *find_socket_value_log(const bNodeSocket &query_socket);
   [[nodiscard]] bool try_convert_primitive_socket_value(const GenericValueLog &value_log,
@@ -365,11 +389,38 @@ class GeoModifierLog {
    * A #GeoTreeLog for every compute context. Those are created lazily when requested by UI code.
    */
   Map<ComputeContextHash, std::unique_ptr<GeoTreeLog>> tree_logs_;
+  /** Created lazily by #ensure_node_profile. */
+  std::optional<Vector<NodeProfile>> node_profile_;
+
+  /**
+   * Find the node tree that is evaluated in every logged compute context, starting at the root
+   * context of the modifier.
+   */
+  Map<ComputeContextHash, const bNodeTree *> find_tree_by_context(
+      const bNodeTree &root_tree, const ComputeContextHash &root_context_hash);
 
  public:
   GeoModifierLog();
   ~GeoModifierLog();
 
+  /**
+   * Combine the logged run times and output geometry sizes of all nodes, sorted by run time.
+   * Nodes of the same node group are combined for all instances of the group.
+   */
+  Span<NodeProfile> ensure_node_profile(const bNodeTree &root_tree,
+                                        const ComputeContextHash &root_context_hash);
+  /**
+   * Export the logged node executions in the Chrome trace event format, which can be loaded in
+   * Perfetto. Events are grouped by the thread that logged them.
+   */
+  std::string profile_trace_json(const bNodeTree &root_tree,
+                                 const ComputeContextHash &root_context_hash);
+  /**
+   * Export the node profile as JSON, grouped by node group.
+   */
+  std::string profile_summary_json(const bNodeTree &root_tree,
+                                   const ComputeContextHash &root_context_hash);
+
   /**
    * Get a thread-local logger for the current node tree.
    */
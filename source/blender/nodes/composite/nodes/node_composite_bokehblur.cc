@@ -6,7 +6,11 @@
  * \ingroup cmpnodes
  */
 
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
 #include "BLI_math_base.hh"
+#include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
 
 #include "UI_interface.hh"
@@ -14,6 +18,7 @@
 
 #include "GPU_texture.hh"
 
+#include "COM_algorithm_fft_convolution.hh"
 #include "COM_algorithm_parallel_reduction.hh"
 #include "COM_node_operation.hh"
 #include "COM_utilities.hh"
@@ -82,6 +87,13 @@ class BokehBlurOperation : public NodeOperation {
 
   void execute_constant_size()
   {
+    if (int(compute_blur_radius()) >= FFT_CONVOLUTION_MINIMUM_RADIUS &&
+        is_fft_convolution_supported())
+    {
+      execute_constant_size_fft();
+      return;
+    }
+
     GPUShader *shader = context().get_shader("compositor_bokeh_blur");
     GPU_shader_bind(shader);
 
@@ -116,6 +128,99 @@ class BokehBlurOperation : public NodeOperation {
     input_mask.unbind_as_texture();
   }
 
+  /* The cost of direct convolution grows with the square of the radius, so large radii are
+   * convolved in the frequency domain on the CPU instead, which quickly outweighs the cost of
+   * reading back the inputs. This matches the compositor_bokeh_blur shader, except that the
+   * weights are not interpolated. */
+  void execute_constant_size_fft()
+  {
+    const int radius = int(compute_blur_radius());
+    const bool extend_bounds = get_extend_bounds();
+
+    const Result &input_image = get_input("Image");
+    const Result &input_weights = get_input("Bokeh");
+    const Result &input_mask = get_input("Bounding box");
+
+    Domain domain = compute_domain();
+    if (extend_bounds) {
+      /* Add a radius amount of pixels in both sides of the image, hence the multiply by 2. */
+      domain.size += int2(radius * 2);
+    }
+
+    Result &output_image = get_result("Image");
+    output_image.allocate_texture(domain);
+
+    GPU_memory_barrier(GPU_BARRIER_TEXTURE_UPDATE);
+    const int2 image_size = input_image.domain().size;
+    float4 *image = static_cast<float4 *>(GPU_texture_read(input_image, GPU_DATA_FLOAT, 0));
+    const int2 weights_size = input_weights.is_single_value() ? int2(1) :
+                                                                input_weights.domain().size;
+    float4 *weights = input_weights.is_single_value() ?
+                          nullptr :
+                          static_cast<float4 *>(
+                              GPU_texture_read(input_weights, GPU_DATA_FLOAT, 0));
+    const int2 mask_size = input_mask.is_single_value() ? int2(1) : input_mask.domain().size;
+    float *mask = input_mask.is_single_value() ?
+                      nullptr :
+                      static_cast<float *>(GPU_texture_read(input_mask, GPU_DATA_FLOAT, 0));
+
+    /* Same as texture_load in shaders, which clamps to the edges. */
+    const auto load_image = [&](const int2 texel) {
+      const int2 clamped_texel = math::clamp(texel, int2(0), image_size - 1);
+      return image[clamped_texel.y * int64_t(image_size.x) + clamped_texel.x];
+    };
+
+    Array<float4> output(int64_t(domain.size.x) * domain.size.y);
+    fft_convolve(
+        domain.size,
+        radius,
+        [&](const int2 texel) {
+          if (!extend_bounds) {
+            return load_image(texel);
+          }
+          /* If bounds are extended, the input is treated as padded by a radius amount of pixels
+           * with a transparent color. */
+          const int2 image_texel = texel - radius;
+          const bool is_inside_image = image_texel.x >= 0 && image_texel.y >= 0 &&
+                                       image_texel.x < image_size.x &&
+                                       image_texel.y < image_size.y;
+          return is_inside_image ? load_image(image_texel) : float4(0.0f);
+        },
+        [&](const int2 offset) {
+          if (weights == nullptr) {
+            return input_weights.get_color_value();
+          }
+          /* The weights are inverted along both directions, see the load_weight function in the
+           * compositor_bokeh_blur shader for more information. */
+          const float2 coordinates = 1.0f - ((float2(offset) + float2(radius + 0.5f)) /
+                                             (radius * 2.0f + 1.0f));
+          const int2 texel = math::clamp(
+              int2(coordinates * float2(weights_size)), int2(0), weights_size - 1);
+          return weights[texel.y * int64_t(weights_size.x) + texel.x];
+        },
+        [&](const int2 texel, const float4 color) {
+          const int2 mask_texel = math::clamp(texel, int2(0), mask_size - 1);
+          const float mask_value = mask == nullptr ?
+                                       input_mask.get_float_value() :
+                                       mask[mask_texel.y * int64_t(mask_size.x) + mask_texel.x];
+          /* The mask input is treated as a boolean. If it is zero, then no blurring happens for
+           * this pixel. */
+          output[texel.y * int64_t(domain.size.x) + texel.x] = mask_value == 0.0f ?
+                                                                   load_image(texel) :
+                                                                   color;
+        });
+
+    MEM_freeN(image);
+    if (weights) {
+      MEM_freeN(weights);
+    }
+    if (mask) {
+      MEM_freeN(mask);
+    }
+
+    GPU_texture_update(output_image, GPU_DATA_FLOAT, output.data());
+  }
+
   void execute_variable_size()
   {
     const int search_radius = compute_variable_size_search_radius();
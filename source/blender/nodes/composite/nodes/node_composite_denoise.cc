@@ -6,6 +6,8 @@
  * \ingroup cmpnodes
  */
 
+#include "BLI_hash.hh"
+#include "BLI_span.hh"
 #include "BLI_system.h"
 
 #include "MEM_guardedalloc.h"
@@ -102,9 +104,6 @@ class DenoiseOperation : public NodeOperation {
     }
 
 #ifdef WITH_OPENIMAGEDENOISE
-    oidn::DeviceRef device = oidn::newDevice(oidn::DeviceType::CPU);
-    device.commit();
-
     const int width = input_image.domain().size.x;
     const int height = input_image.domain().size.y;
     const int pixel_stride = sizeof(float) * 4;
@@ -114,6 +113,56 @@ class DenoiseOperation : public NodeOperation {
      * it in-place. */
     GPU_memory_barrier(GPU_BARRIER_TEXTURE_UPDATE);
     float *color = static_cast<float *>(GPU_texture_read(input_image, data_format, 0));
+
+    /* Download the auxiliary passes that are used, see below. */
+    float *albedo = nullptr;
+    Result &input_albedo = get_input("Albedo");
+    if (!input_albedo.is_single_value()) {
+      albedo = static_cast<float *>(GPU_texture_read(input_albedo, data_format, 0));
+    }
+    float *normal = nullptr;
+    Result &input_normal = get_input("Normal");
+    if (albedo && !input_normal.is_single_value()) {
+      normal = static_cast<float *>(GPU_texture_read(input_normal, data_format, 0));
+    }
+
+    /* Identify the denoised image and auxiliary passes by the hash of their inputs and settings,
+     * such that they are only denoised again when they change. */
+    const int2 size = input_image.domain().size;
+    const int64_t pixels_count = int64_t(width) * height * 4;
+    const uint64_t albedo_hash = albedo ? hash_denoise_input({albedo, pixels_count}, 1) : 0;
+    const uint64_t normal_hash = normal ? hash_denoise_input({normal, pixels_count}, 2) : 0;
+    const uint64_t image_hash = hash_denoise_input(
+        {color, pixels_count},
+        get_default_hash(albedo_hash, normal_hash, use_hdr(), int(get_prefilter_mode())));
+
+    DenoisedImageContainer &denoised_images = context().cache_manager().denoised_images;
+    const DenoisedImageKey albedo_key(albedo_hash, size);
+    const DenoisedImageKey normal_key(normal_hash, size);
+    const DenoisedImageKey image_key(image_hash, size);
+
+    /* Get the cached auxiliary passes even if the image is cached, to keep them cached for when
+     * only the image changes. */
+    const DenoisedImage *denoised_albedo = albedo && should_denoise_auxiliary_passes() ?
+                                               denoised_images.get(albedo_key) :
+                                               nullptr;
+    const DenoisedImage *denoised_normal = normal && should_denoise_auxiliary_passes() ?
+                                               denoised_images.get(normal_key) :
+                                               nullptr;
+
+    output_image.allocate_texture(input_image.domain());
+
+    if (const DenoisedImage *denoised_image = denoised_images.get(image_key)) {
+      GPU_texture_update(output_image, data_format, denoised_image->pixels.data());
+      MEM_freeN(color);
+      MEM_SAFE_FREE(albedo);
+      MEM_SAFE_FREE(normal);
+      return;
+    }
+
+    oidn::DeviceRef device = oidn::newDevice(oidn::DeviceType::CPU);
+    device.commit();
+
     oidn::FilterRef filter = device.newFilter("RT");
     filter.setImage("color", color, oidn::Format::Float3, width, height, 0, pixel_stride);
     filter.setImage("output", color, oidn::Format::Float3, width, height, 0, pixel_stride);
@@ -121,14 +170,13 @@ class DenoiseOperation : public NodeOperation {
     filter.set("cleanAux", auxiliary_passes_are_clean());
     filter.setProgressMonitorFunction(oidn_progress_monitor_function, &context());
 
-    /* If the albedo input is not a single value input, download the albedo texture, denoise it
-     * in-place if denoising auxiliary passes is needed, and set it to the main filter. */
-    float *albedo = nullptr;
-    Result &input_albedo = get_input("Albedo");
-    if (!input_albedo.is_single_value()) {
-      albedo = static_cast<float *>(GPU_texture_read(input_albedo, data_format, 0));
-
-      if (should_denoise_auxiliary_passes()) {
+    /* If the albedo input is not a single value input, denoise it in-place if denoising auxiliary
+     * passes is needed, and set it to the main filter. */
+    if (albedo) {
+      if (denoised_albedo) {
+        MutableSpan<float>(albedo, pixels_count).copy_from(denoised_albedo->pixels);
+      }
+      else if (should_denoise_auxiliary_passes()) {
         oidn::FilterRef albedoFilter = device.newFilter("RT");
         albedoFilter.setImage(
             "albedo", albedo, oidn::Format::Float3, width, height, 0, pixel_stride);
@@ -137,21 +185,23 @@ class DenoiseOperation : public NodeOperation {
         albedoFilter.setProgressMonitorFunction(oidn_progress_monitor_function, &context());
         albedoFilter.commit();
         albedoFilter.execute();
+        if (!context().is_canceled()) {
+          denoised_images.add(albedo_key, {albedo, pixels_count});
+        }
       }
 
       filter.setImage("albedo", albedo, oidn::Format::Float3, width, height, 0, pixel_stride);
     }
 
-    /* If the albedo and normal inputs are not single value inputs, download the normal texture,
-     * denoise it in-place if denoising auxiliary passes is needed, and set it to the main filter.
-     * Notice that we also consider the albedo input because OIDN doesn't support denoising with
-     * only the normal auxiliary pass. */
-    float *normal = nullptr;
-    Result &input_normal = get_input("Normal");
-    if (albedo && !input_normal.is_single_value()) {
-      normal = static_cast<float *>(GPU_texture_read(input_normal, data_format, 0));
-
-      if (should_denoise_auxiliary_passes()) {
+    /* If the albedo and normal inputs are not single value inputs, denoise the normal in-place if
+     * denoising auxiliary passes is needed, and set it to the main filter. Notice that we also
+     * consider the albedo input because OIDN doesn't support denoising with only the normal
+     * auxiliary pass. */
+    if (normal) {
+      if (denoised_normal) {
+        MutableSpan<float>(normal, pixels_count).copy_from(denoised_normal->pixels);
+      }
+      else if (should_denoise_auxiliary_passes()) {
         oidn::FilterRef normalFilter = device.newFilter("RT");
         normalFilter.setImage(
             "normal", normal, oidn::Format::Float3, width, height, 0, pixel_stride);
@@ -160,6 +210,9 @@ class DenoiseOperation : public NodeOperation {
         normalFilter.setProgressMonitorFunction(oidn_progress_monitor_function, &context());
         normalFilter.commit();
         normalFilter.execute();
+        if (!context().is_canceled()) {
+          denoised_images.add(normal_key, {normal, pixels_count});
+        }
       }
 
       filter.setImage("normal", normal, oidn::Format::Float3, width, height, 0, pixel_stride);
@@ -167,8 +220,10 @@ class DenoiseOperation : public NodeOperation {
 
     filter.commit();
     filter.execute();
+    if (!context().is_canceled()) {
+      denoised_images.add(image_key, {color, pixels_count});
+    }
 
-    output_image.allocate_texture(input_image.domain());
     GPU_texture_update(output_image, data_format, color);
 
     MEM_freeN(color);
@@ -5,8 +5,21 @@
 #include "node_geometry_util.hh"
 #include "node_util.hh"
 
+#include "DNA_mesh_types.h"
 #include "DNA_space_types.h"
 
+#include "BLI_generic_key.hh"
+#include "BLI_hash.hh"
+#include "BLI_implicit_sharing.hh"
+#include "BLI_listbase.h"
+#include "BLI_memory_cache.hh"
+#include "BLI_memory_counter.hh"
+
+#include "BKE_customdata.hh"
+#include "BKE_deform.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.h"
+#include "BKE_mesh.hh"
 #include "BKE_node.hh"
 
 #include "NOD_rna_define.hh"
@@ -49,6 +62,179 @@ void search_link_ops_for_import_node(GatherLinkSearchOpParams &params)
   }
 }
 
+/**
+ * Identifies the data of a mesh and an operation on it. The arrays of the mesh are identified by
+ * their #ImplicitSharingInfo and its version, everything else that is copied to the result is
+ * compared by value.
+ */
+class MeshOperationKey : public GenericKey {
+ public:
+  std::string operation;
+  Vector<int64_t> parameters;
+  Vector<const ImplicitSharingInfo *> sharing_infos;
+  Vector<int64_t> versions;
+  /** Sizes, layer types, material pointers and other settings of the mesh. */
+  Vector<int64_t> settings;
+  /** Names of the layers, vertex groups and active attributes, separated by null characters. */
+  std::string names;
+  /**
+   * The stored key is a weak user of all sharing infos, so that their addresses are not reused
+   * for other data while the key exists.
+   */
+  bool is_weak_user = false;
+
+  MeshOperationKey() = default;
+  MeshOperationKey(const MeshOperationKey &other) = delete;
+  MeshOperationKey &operator=(const MeshOperationKey &other) = delete;
+
+  ~MeshOperationKey() override
+  {
+    if (is_weak_user) {
+      for (const ImplicitSharingInfo *sharing_info : this->sharing_infos) {
+        sharing_info->remove_weak_user_and_delete_if_last();
+      }
+    }
+  }
+
+  uint64_t hash() const override
+  {
+    return get_default_hash(get_default_hash(this->operation, this->parameters, this->names),
+                            this->sharing_infos,
+                            this->versions,
+                            this->settings);
+  }
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    if (const auto *other_typed = dynamic_cast<const MeshOperationKey *>(&other)) {
+      return this->operation == other_typed->operation &&
+             this->parameters == other_typed->parameters &&
+             this->sharing_infos == other_typed->sharing_infos &&
+             this->versions == other_typed->versions && this->settings == other_typed->settings &&
+             this->names == other_typed->names;
+    }
+    return false;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    auto key = std::make_unique<MeshOperationKey>();
+    key->operation = this->operation;
+    key->parameters = this->parameters;
+    key->sharing_infos = this->sharing_infos;
+    key->versions = this->versions;
+    key->settings = this->settings;
+    key->names = this->names;
+    for (const ImplicitSharingInfo *sharing_info : key->sharing_infos) {
+      sharing_info->add_weak_user();
+    }
+    key->is_weak_user = true;
+    return key;
+  }
+
+  void add_name(const StringRefNull name)
+  {
+    this->names.append(name.c_str(), name.size() + 1);
+  }
+
+  /**
+   * Only arrays that are shared with other owners are identified. Arrays that are owned by the
+   * mesh alone are usually created during this evaluation, those would only add a new entry to
+   * the cache for every evaluation.
+   */
+  bool add_shared_data(const ImplicitSharingInfo *sharing_info)
+  {
+    if (sharing_info == nullptr || sharing_info->is_mutable()) {
+      return false;
+    }
+    this->sharing_infos.append(sharing_info);
+    this->versions.append(sharing_info->version());
+    return true;
+  }
+
+  bool add_custom_data(const CustomData &data)
+  {
+    for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+      if (!this->add_shared_data(layer.sharing_info)) {
+        return false;
+      }
+      this->settings.append(layer.type);
+      this->settings.append(layer.flag);
+      this->add_name(layer.name);
+    }
+    return true;
+  }
+
+  bool add_mesh(const Mesh &mesh)
+  {
+    if (mesh.faces_num > 0 && !this->add_shared_data(mesh.runtime->face_offsets_sharing_info)) {
+      return false;
+    }
+    for (const CustomData *data :
+         {&mesh.vert_data, &mesh.edge_data, &mesh.face_data, &mesh.corner_data})
+    {
+      if (!this->add_custom_data(*data)) {
+        return false;
+      }
+      this->settings.append(-1);
+    }
+    this->settings.extend({mesh.verts_num, mesh.edges_num, mesh.faces_num, mesh.corners_num});
+    this->settings.extend({mesh.flag, mesh.texspace_flag, mesh.vertex_group_active_index});
+    for (const int i : IndexRange(mesh.totcol)) {
+      this->settings.append(int64_t(intptr_t(mesh.mat[i])));
+    }
+    LISTBASE_FOREACH (const bDeformGroup *, group, &mesh.vertex_group_names) {
+      this->add_name(group->name);
+    }
+    this->add_name(mesh.active_color_attribute ? mesh.active_color_attribute : "");
+    this->add_name(mesh.default_color_attribute ? mesh.default_color_attribute : "");
+    return true;
+  }
+};
+
+class MeshOperationValue : public memory_cache::CachedValue {
+ public:
+  Mesh *mesh = nullptr;
+
+  ~MeshOperationValue() override
+  {
+    if (this->mesh) {
+      BKE_id_free(nullptr, this->mesh);
+    }
+  }
+
+  void count_memory(MemoryCounter &memory) const override
+  {
+    if (this->mesh) {
+      this->mesh->count_memory(memory);
+    }
+  }
+};
+
+Mesh *mesh_operation_cached(const Mesh &mesh,
+                            const StringRefNull operation,
+                            const Span<int64_t> parameters,
+                            const FunctionRef<Mesh *()> compute_fn)
+{
+  MeshOperationKey key;
+  key.operation = operation;
+  key.parameters = parameters;
+  if (!key.add_mesh(mesh)) {
+    return compute_fn();
+  }
+  const std::shared_ptr<const MeshOperationValue> value = memory_cache::get<MeshOperationValue>(
+      key, [&]() {
+        auto value = std::make_unique<MeshOperationValue>();
+        value->mesh = compute_fn();
+        return value;
+      });
+  if (value->mesh == nullptr) {
+    return nullptr;
+  }
+  /* The copy shares all arrays and runtime caches with the cached mesh. */
+  return BKE_mesh_copy_for_eval(*value->mesh);
+}
+
 namespace enums {
 
 const EnumPropertyItem *attribute_type_type_with_socket_fn(bContext * /*C*/,
@@ -18,6 +18,7 @@
 
 struct BVHTreeFromMesh;
 struct GeometrySet;
+struct Mesh;
 namespace blender::nodes {
 class GatherAddNodeSearchParams;
 class GatherLinkSearchOpParams;
@@ -44,6 +45,21 @@ void get_closest_in_bvhtree(BVHTreeFromMesh &tree_data,
 
 int apply_offset_in_cyclic_range(IndexRange range, int start_index, int offset);
 
+/**
+ * Get the result of a deterministic operation on a mesh from the #memory_cache, or compute it
+ * and add it to the cache. Entries are found by the implicit-sharing identity of the arrays of
+ * \a mesh, so that a mesh that did not change since the previous evaluation of the node tree
+ * (e.g. the original mesh of the modifier) does not have to be processed again.
+ *
+ * \param operation: Name that is unique for the operation, with \a parameters it identifies
+ * everything else the result depends on.
+ * \return A mesh which is owned by the caller, or null if \a compute_fn returned null.
+ */
+Mesh *mesh_operation_cached(const Mesh &mesh,
+                            StringRefNull operation,
+                            Span<int64_t> parameters,
+                            FunctionRef<Mesh *()> compute_fn);
+
 void mix_baked_data_item(eNodeSocketDatatype socket_type,
                          void *prev,
                          const void *next,
@@ -2,7 +2,6 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
-#include "BLI_kdtree.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_rotation.h"
 #include "BLI_noise.hh"
@@ -19,6 +18,7 @@
 #include "UI_interface.hh"
 #include "UI_resources.hh"
 
+#include "GEO_point_merge_by_distance.hh"
 #include "GEO_randomize.hh"
 
 #include "node_geometry_util.hh"
@@ -100,6 +100,11 @@ static math::Quaternion normal_to_rotation(const float3 normal)
   return math::normalize(math::Quaternion(quat));
 }
 
+/**
+ * Every triangle has its own random number generator, so the points can be generated in parallel
+ * and the result does not depend on the number of threads. The points are counted first, so
+ * that they are written to their final position directly.
+ */
 static void sample_mesh_surface(const Mesh &mesh,
                                 const float base_density,
                                 const Span<float> density_factors,
@@ -112,54 +117,56 @@ static void sample_mesh_surface(const Mesh &mesh,
   const Span<int> corner_verts = mesh.corner_verts();
   const Span<int3> corner_tris = mesh.corner_tris();
 
-  for (const int tri_i : corner_tris.index_range()) {
+  auto tri_rng_and_point_amount = [&](const int tri_i, RandomNumberGenerator &r_rng) {
     const int3 &tri = corner_tris[tri_i];
-    const int v0_loop = tri[0];
-    const int v1_loop = tri[1];
-    const int v2_loop = tri[2];
-    const float3 &v0_pos = positions[corner_verts[v0_loop]];
-    const float3 &v1_pos = positions[corner_verts[v1_loop]];
-    const float3 &v2_pos = positions[corner_verts[v2_loop]];
-
     float corner_tri_density_factor = 1.0f;
     if (!density_factors.is_empty()) {
-      const float v0_density_factor = std::max(0.0f, density_factors[v0_loop]);
-      const float v1_density_factor = std::max(0.0f, density_factors[v1_loop]);
-      const float v2_density_factor = std::max(0.0f, density_factors[v2_loop]);
+      const float v0_density_factor = std::max(0.0f, density_factors[tri[0]]);
+      const float v1_density_factor = std::max(0.0f, density_factors[tri[1]]);
+      const float v2_density_factor = std::max(0.0f, density_factors[tri[2]]);
       corner_tri_density_factor = (v0_density_factor + v1_density_factor + v2_density_factor) /
                                   3.0f;
     }
-    const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
+    const float area = area_tri_v3(positions[corner_verts[tri[0]]],
+                                   positions[corner_verts[tri[1]]],
+                                   positions[corner_verts[tri[2]]]);
 
     const int corner_tri_seed = noise::hash(tri_i, seed);
-    RandomNumberGenerator corner_tri_rng(corner_tri_seed);
-
-    const int point_amount = corner_tri_rng.round_probabilistic(area * base_density *
-                                                                corner_tri_density_factor);
-
-    for (int i = 0; i < point_amount; i++) {
-      const float3 bary_coord = corner_tri_rng.get_barycentric_coordinates();
-      float3 point_pos;
-      interp_v3_v3v3v3(point_pos, v0_pos, v1_pos, v2_pos, bary_coord);
-      r_positions.append(point_pos);
-      r_bary_coords.append(bary_coord);
-      r_tri_indices.append(tri_i);
-    }
-  }
-}
-
-BLI_NOINLINE static KDTree_3d *build_kdtree(Span<float3> positions)
-{
-  KDTree_3d *kdtree = BLI_kdtree_3d_new(positions.size());
-
-  int i_point = 0;
-  for (const float3 position : positions) {
-    BLI_kdtree_3d_insert(kdtree, i_point, position);
-    i_point++;
-  }
+    r_rng = RandomNumberGenerator(corner_tri_seed);
+    return r_rng.round_probabilistic(area * base_density * corner_tri_density_factor);
+  };
 
-  BLI_kdtree_3d_balance(kdtree);
-  return kdtree;
+  Array<int> point_offsets_data(corner_tris.size() + 1);
+  threading::parallel_for(corner_tris.index_range(), 2048, [&](const IndexRange range) {
+    for (const int tri_i : range) {
+      RandomNumberGenerator corner_tri_rng;
+      point_offsets_data[tri_i] = tri_rng_and_point_amount(tri_i, corner_tri_rng);
+    }
+  });
+  const OffsetIndices<int> point_offsets = offset_indices::accumulate_counts_to_offsets(
+      point_offsets_data);
+
+  r_positions.resize(point_offsets.total_size());
+  r_bary_coords.resize(point_offsets.total_size());
+  r_tri_indices.resize(point_offsets.total_size());
+  threading::parallel_for(corner_tris.index_range(), 1024, [&](const IndexRange range) {
+    for (const int tri_i : range) {
+      /* Generate the same random numbers as when counting the points. */
+      RandomNumberGenerator corner_tri_rng;
+      tri_rng_and_point_amount(tri_i, corner_tri_rng);
+
+      const int3 &tri = corner_tris[tri_i];
+      const float3 &v0_pos = positions[corner_verts[tri[0]]];
+      const float3 &v1_pos = positions[corner_verts[tri[1]]];
+      const float3 &v2_pos = positions[corner_verts[tri[2]]];
+      for (const int point_i : point_offsets[tri_i]) {
+        const float3 bary_coord = corner_tri_rng.get_barycentric_coordinates();
+        interp_v3_v3v3v3(r_positions[point_i], v0_pos, v1_pos, v2_pos, bary_coord);
+        r_bary_coords[point_i] = bary_coord;
+        r_tri_indices[point_i] = tri_i;
+      }
+    }
+  });
 }
 
 BLI_NOINLINE static void update_elimination_mask_for_close_points(
@@ -169,32 +176,20 @@ BLI_NOINLINE static void update_elimination_mask_for_close_points(
     return;
   }
 
-  KDTree_3d *kdtree = build_kdtree(positions);
-  BLI_SCOPED_DEFER([&]() { BLI_kdtree_3d_free(kdtree); });
+  /* Points are kept in index order, a point is eliminated when it is closer than the minimum
+   * distance to a point that is kept. That is the same as merging points, with the kept points
+   * as merge targets. */
+  Array<int> dest_map(positions.size(), -1);
+  geometry::find_points_to_merge(
+      positions, IndexMask(positions.size()), minimum_distance, dest_map);
 
-  for (const int i : positions.index_range()) {
-    if (elimination_mask[i]) {
-      continue;
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (!ELEM(dest_map[i], -1, i)) {
+        elimination_mask[i] = true;
+      }
     }
-
-    struct CallbackData {
-      int index;
-      MutableSpan<bool> elimination_mask;
-    } callback_data = {i, elimination_mask};
-
-    BLI_kdtree_3d_range_search_cb(
-        kdtree,
-        positions[i],
-        minimum_distance,
-        [](void *user_data, int index, const float * /*co*/, float /*dist_sq*/) {
-          CallbackData &callback_data = *static_cast<CallbackData *>(user_data);
-          if (index != callback_data.index) {
-            callback_data.elimination_mask[index] = true;
-          }
-          return true;
-        },
-        &callback_data);
-  }
+  });
 }
 
 BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
@@ -205,26 +200,29 @@ BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
     const MutableSpan<bool> elimination_mask)
 {
   const Span<int3> corner_tris = mesh.corner_tris();
-  for (const int i : bary_coords.index_range()) {
-    if (elimination_mask[i]) {
-      continue;
-    }
+  threading::parallel_for(bary_coords.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (elimination_mask[i]) {
+        continue;
+      }
 
-    const int3 &tri = corner_tris[tri_indices[i]];
-    const float3 bary_coord = bary_coords[i];
+      const int3 &tri = corner_tris[tri_indices[i]];
+      const float3 bary_coord = bary_coords[i];
 
-    const float v0_density_factor = std::max(0.0f, density_factors[tri[0]]);
-    const float v1_density_factor = std::max(0.0f, density_factors[tri[1]]);
-    const float v2_density_factor = std::max(0.0f, density_factors[tri[2]]);
+      const float v0_density_factor = std::max(0.0f, density_factors[tri[0]]);
+      const float v1_density_factor = std::max(0.0f, density_factors[tri[1]]);
+      const float v2_density_factor = std::max(0.0f, density_factors[tri[2]]);
 
-    const float probability = v0_density_factor * bary_coord.x + v1_density_factor * bary_coord.y +
-                              v2_density_factor * bary_coord.z;
+      const float probability = v0_density_factor * bary_coord.x +
+                                v1_density_factor * bary_coord.y +
+                                v2_density_factor * bary_coord.z;
 
-    const float hash = noise::hash_float_to_float(bary_coord);
-    if (hash > probability) {
-      elimination_mask[i] = true;
+      const float hash = noise::hash_float_to_float(bary_coord);
+      if (hash > probability) {
+        elimination_mask[i] = true;
+      }
     }
-  }
+  });
 }
 
 BLI_NOINLINE static void eliminate_points_based_on_mask(const Span<bool> elimination_mask,
@@ -248,39 +246,43 @@ BLI_NOINLINE static void interpolate_attribute(const Mesh &mesh,
                                                const GVArray &source_data,
                                                GMutableSpan output_data)
 {
-  switch (source_domain) {
-    case AttrDomain::Point: {
-      bke::mesh_surface_sample::sample_point_attribute(mesh.corner_verts(),
-                                                       mesh.corner_tris(),
-                                                       tri_indices,
-                                                       bary_coords,
-                                                       source_data,
-                                                       IndexMask(output_data.size()),
-                                                       output_data);
-      break;
-    }
-    case AttrDomain::Corner: {
-      bke::mesh_surface_sample::sample_corner_attribute(mesh.corner_tris(),
+  /* The sampling functions are single threaded, so they are called for chunks of the points. */
+  threading::parallel_for(IndexRange(output_data.size()), 4096, [&](const IndexRange range) {
+    const IndexMask mask(range);
+    switch (source_domain) {
+      case AttrDomain::Point: {
+        bke::mesh_surface_sample::sample_point_attribute(mesh.corner_verts(),
+                                                         mesh.corner_tris(),
+                                                         tri_indices,
+                                                         bary_coords,
+                                                         source_data,
+                                                         mask,
+                                                         output_data);
+        break;
+      }
+      case AttrDomain::Corner: {
+        bke::mesh_surface_sample::sample_corner_attribute(mesh.corner_tris(),
+                                                          tri_indices,
+                                                          bary_coords,
+                                                          source_data,
+                                                          mask,
+                                                          output_data);
+        break;
+      }
+      case AttrDomain::Face: {
+        bke::mesh_surface_sample::sample_face_attribute(mesh.corner_tri_faces(),
                                                         tri_indices,
-                                                        bary_coords,
                                                         source_data,
-                                                        IndexMask(output_data.size()),
+                                                        mask,
                                                         output_data);
-      break;
+        break;
+      }
+      default: {
+        /* Not supported currently. */
+        return;
+      }
     }
-    case AttrDomain::Face: {
-      bke::mesh_surface_sample::sample_face_attribute(mesh.corner_tri_faces(),
-                                                      tri_indices,
-                                                      source_data,
-                                                      IndexMask(output_data.size()),
-                                                      output_data);
-      break;
-    }
-    default: {
-      /* Not supported currently. */
-      return;
-    }
-  }
+  });
 }
 
 BLI_NOINLINE static void propagate_existing_attributes(
@@ -66,7 +66,10 @@ static void node_geo_exec(GeoNodeExecParams params)
 
   geometry_set.modify_geometry_sets([&](GeometrySet &geometry_set) {
     if (const Mesh *mesh = geometry_set.get_mesh()) {
-      geometry_set.replace_mesh(simple_subdivide_mesh(*mesh, level));
+      /* Subdividing an unchanged mesh again when other parts of the tree are tweaked is slow for
+       * higher levels. */
+      geometry_set.replace_mesh(mesh_operation_cached(
+          *mesh, "Subdivide Mesh", {level}, [&]() { return simple_subdivide_mesh(*mesh, level); }));
     }
   });
 #else
@@ -23,6 +23,13 @@ static void node_declare(NodeDeclarationBuilder &b)
   b.add_output<decl::Geometry>("Instances").propagate_all();
 }
 
+/** Same as `transform *= math::from_location<float4x4>(translation)`. */
+static void translate_local(float4x4 &transform, const float3 &translation)
+{
+  transform[3] += transform[0] * translation.x + transform[1] * translation.y +
+                  transform[2] * translation.z;
+}
+
 static void scale_instances(GeoNodeExecParams &params, bke::Instances &instances)
 {
   const bke::InstancesFieldContext context{instances};
@@ -45,16 +52,21 @@ static void scale_instances(GeoNodeExecParams &params, bke::Instances &instances
     float4x4 &instance_transform = transforms[i];
 
     if (local_spaces[i]) {
-      instance_transform *= math::from_location<float4x4>(pivot);
+      translate_local(instance_transform, pivot);
       rescale_m4(instance_transform.ptr(), scales[i]);
-      instance_transform *= math::from_location<float4x4>(-pivot);
+      translate_local(instance_transform, -pivot);
     }
     else {
-      const float4x4 original_transform = instance_transform;
-      instance_transform = math::from_location<float4x4>(pivot);
-      rescale_m4(instance_transform.ptr(), scales[i]);
-      instance_transform *= math::from_location<float4x4>(-pivot);
-      instance_transform *= original_transform;
+      /* Multiply with the scale around the pivot from the left. That only changes the first three
+       * rows: every row is scaled and the last row, weighted by the pivot offset, is added. */
+      const float3 scale = scales[i];
+      const float3 offset = pivot * (float3(1.0f) - scale);
+      for (const int col : IndexRange(4)) {
+        float4 &column = instance_transform[col];
+        column.x = scale.x * column.x + offset.x * column.w;
+        column.y = scale.y * column.y + offset.y * column.w;
+        column.z = scale.z * column.z + offset.z * column.w;
+      }
     }
   });
 }
@@ -38,7 +38,11 @@ static void translate_instances(GeoNodeExecParams &params, bke::Instances &insta
 
   selection.foreach_index(GrainSize(1024), [&](const int64_t i) {
     if (local_spaces[i]) {
-      transforms[i] *= math::from_location<float4x4>(translations[i]);
+      /* Same as multiplying with a translation matrix, which only changes the last column. */
+      float4x4 &transform = transforms[i];
+      const float3 translation = translations[i];
+      transform[3] += transform[0] * translation.x + transform[1] * translation.y +
+                      transform[2] * translation.z;
     }
     else {
       transforms[i].location() += translations[i];
@@ -20,6 +20,9 @@
  * complexity. So far, this does not seem to be a performance issue.
  */
 
+#include <atomic>
+#include <mutex>
+
 #include "NOD_geometry_exec.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
 #include "NOD_multi_function.hh"
@@ -34,6 +37,7 @@
 #include "BLI_hash_md5.hh"
 #include "BLI_lazy_threading.hh"
 #include "BLI_map.hh"
+#include "BLI_memory_counter.hh"
 
 #include "DNA_ID.h"
 
@@ -1648,6 +1652,16 @@ class RepeatBodyNodeExecuteWrapper : public lf::GraphExecutorNodeExecuteWrapper
  public:
   const bNode *repeat_output_bnode_ = nullptr;
   VectorSet<lf::FunctionNode *> *lf_body_nodes_ = nullptr;
+  /** Inputs of the loop body which pass geometry from one iteration to the next. */
+  Span<int> geometry_input_indices_;
+  /**
+   * Components of the geometry that is passed into the first iteration. Loop body nodes may be
+   * executed at the same time while they request their inputs, so this is protected by a mutex.
+   */
+  mutable Set<const bke::GeometryComponent *> zone_input_components_;
+  mutable std::mutex zone_input_components_mutex_;
+  /** Only report shared geometries once per evaluation of the zone. */
+  mutable std::atomic<bool> shared_geometry_reported_ = false;
 
   void execute_node(const lf::FunctionNode &node,
                     lf::Params &params,
@@ -1670,10 +1684,80 @@ class RepeatBodyNodeExecuteWrapper : public lf::GraphExecutorNodeExecuteWrapper
     body_user_data.log_socket_values = should_log_socket_values_for_context(
         user_data, body_compute_context.hash());
 
+    if (iteration == 0) {
+      this->gather_zone_input_components(params);
+    }
+    else {
+      this->report_shared_geometry(params, context);
+    }
+
     GeoNodesLFLocalUserData body_local_user_data{body_user_data};
     lf::Context body_context{context.storage, &body_user_data, &body_local_user_data};
     fn.execute(params, body_context);
   }
+
+ private:
+  void gather_zone_input_components(lf::Params &params) const
+  {
+    std::lock_guard lock{zone_input_components_mutex_};
+    for (const int input_index : geometry_input_indices_) {
+      if (const bke::GeometrySet *geometry = params.try_get_input_data_ptr<bke::GeometrySet>(
+              input_index))
+      {
+        for (const bke::GeometryComponent *component : geometry->get_components()) {
+          zone_input_components_.add(component);
+        }
+      }
+    }
+  }
+
+  /**
+   * The geometry passed from one iteration to the next is moved, so it is expected to have a
+   * single user once it has been changed in the loop. If it is still shared, e.g. because a node
+   * in the body keeps a reference to its input, every write in the next iteration has to copy
+   * the data first. Components that come from outside of the zone unchanged are skipped, they
+   * are only copied when they are changed for the first time.
+   */
+  void report_shared_geometry(lf::Params &params, const lf::Context &context) const
+  {
+    if (shared_geometry_reported_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    for (const int input_index : geometry_input_indices_) {
+      const bke::GeometrySet *geometry = params.try_get_input_data_ptr<bke::GeometrySet>(
+          input_index);
+      if (geometry == nullptr) {
+        continue;
+      }
+      const Vector<const bke::GeometryComponent *> components = geometry->get_components();
+      std::lock_guard lock{zone_input_components_mutex_};
+      if (std::all_of(components.begin(),
+                      components.end(),
+                      [&](const bke::GeometryComponent *component) {
+                        return component->is_mutable() ||
+                               zone_input_components_.contains(component);
+                      }))
+      {
+        continue;
+      }
+      if (shared_geometry_reported_.exchange(true)) {
+        return;
+      }
+      GeoNodesLFUserData &user_data = *static_cast<GeoNodesLFUserData *>(context.user_data);
+      GeoNodesLFLocalUserData &local_user_data = *static_cast<GeoNodesLFLocalUserData *>(
+          context.local_user_data);
+      if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(
+              user_data))
+      {
+        tree_logger->node_warnings.append(
+            *tree_logger->allocator,
+            {repeat_output_bnode_->identifier,
+             {NodeWarningType::Info,
+              N_("Geometry is shared between iterations, changing it requires a copy")}});
+      }
+      return;
+    }
+  }
 };
 
 /**
@@ -1719,6 +1803,7 @@ struct RepeatEvalStorage {
   bool multi_threading_enabled = false;
   Vector<int> input_index_map;
   Vector<int> output_index_map;
+  Vector<int> body_geometry_input_indices;
 };
 
 class LazyFunctionForRepeatZone : public LazyFunction {
@@ -2014,6 +2099,13 @@ class LazyFunctionForRepeatZone : public LazyFunction {
     eval_storage.body_execute_wrapper.emplace();
     eval_storage.body_execute_wrapper->repeat_output_bnode_ = &repeat_output_bnode_;
     eval_storage.body_execute_wrapper->lf_body_nodes_ = &lf_body_nodes;
+    for (const int input_index : body_fn_.indices.inputs.main) {
+      if (body_fn_.function->inputs()[input_index].type->is<bke::GeometrySet>()) {
+        eval_storage.body_geometry_input_indices.append(input_index);
+      }
+    }
+    eval_storage.body_execute_wrapper->geometry_input_indices_ =
+        eval_storage.body_geometry_input_indices;
     eval_storage.side_effect_provider.emplace();
     eval_storage.side_effect_provider->repeat_output_bnode_ = &repeat_output_bnode_;
     eval_storage.side_effect_provider->lf_body_nodes_ = lf_body_nodes;
@@ -2068,7 +2160,9 @@ class GeometryNodesLazyFunctionLogger : public lf::GraphExecutor::Logger {
                         const lf::Context &context) const override
   {
     auto &user_data = *static_cast<GeoNodesLFUserData *>(context.user_data);
-    if (!user_data.log_socket_values) {
+    const bool log_output_geometry_size = user_data.call_data->log_output_geometry_sizes &&
+                                          value.type()->is<bke::GeometrySet>();
+    if (!user_data.log_socket_values && !log_output_geometry_size) {
       return;
     }
     auto &local_user_data = *static_cast<GeoNodesLFLocalUserData *>(context.local_user_data);
@@ -2083,6 +2177,13 @@ class GeometryNodesLazyFunctionLogger : public lf::GraphExecutor::Logger {
       return;
     }
 
+    if (log_output_geometry_size) {
+      this->log_output_geometry_size(*tree_logger, bsockets, *value.get<bke::GeometrySet>());
+      if (!user_data.log_socket_values) {
+        return;
+      }
+    }
+
     for (const bNodeSocket *bsocket : bsockets) {
       /* Avoid logging to some sockets when the same value will also be logged to a linked socket.
        * This reduces the number of logged values without losing information. */
@@ -2097,6 +2198,28 @@ class GeometryNodesLazyFunctionLogger : public lf::GraphExecutor::Logger {
     }
   }
 
+  void log_output_geometry_size(geo_eval_log::GeoTreeLogger &tree_logger,
+                                const Span<const bNodeSocket *> bsockets,
+                                const bke::GeometrySet &geometry) const
+  {
+    /* The same value is also forwarded to the linked inputs, only count it for the output. */
+    const bNodeSocket *output_bsocket = nullptr;
+    for (const bNodeSocket *bsocket : bsockets) {
+      if (bsocket->is_output() && !bsocket->owner_node().is_reroute()) {
+        output_bsocket = bsocket;
+        break;
+      }
+    }
+    if (output_bsocket == nullptr) {
+      return;
+    }
+    MemoryCount memory;
+    MemoryCounter memory_counter{memory};
+    geometry.count_memory(memory_counter);
+    tree_logger.node_output_geometry_sizes.append(
+        *tree_logger.allocator, {output_bsocket->owner_node().identifier, memory.total_bytes});
+  }
+
   static inline std::mutex dump_error_context_mutex;
 
   void dump_when_outputs_are_missing(const lf::FunctionNode &node,
@@ -2,9 +2,13 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <sstream>
+
 #include "NOD_geometry_nodes_lazy_function.hh"
 #include "NOD_geometry_nodes_log.hh"
 
+#include "BLI_serialize.hh"
+
 #include "BKE_compute_contexts.hh"
 #include "BKE_curves.hh"
 #include "BKE_geometry_nodes_gizmos_transforms.hh"
@@ -442,6 +446,22 @@ void GeoTreeLog::ensure_evaluated_gizmo_nodes()
   }
 }
 
+void GeoTreeLog::ensure_node_output_geometry_sizes()
+{
+  if (reduced_node_output_geometry_sizes_) {
+    return;
+  }
+  for (const GeoTreeLogger *tree_logger : tree_loggers_) {
+    for (const GeoTreeLogger::NodeOutputGeometrySize &size :
+         tree_logger->node_output_geometry_sizes)
+    {
+      int64_t &bytes = this->nodes.lookup_or_add_default(size.node_id).output_geometry_bytes;
+      bytes = std::max(bytes, size.bytes);
+    }
+  }
+  reduced_node_output_geometry_sizes_ = true;
+}
+
 ValueLog *GeoTreeLog::find_socket_value_log(const bNodeSocket &query_socket)
 {
   /**
@@ -587,6 +607,220 @@ GeoTreeLog &GeoModifierLog::get_tree_log(const ComputeContextHash &compute_conte
   return reduced_tree_log;
 }
 
+Map<ComputeContextHash, const bNodeTree *> GeoModifierLog::find_tree_by_context(
+    const bNodeTree &root_tree, const ComputeContextHash &root_context_hash)
+{
+  Map<ComputeContextHash, const GeoTreeLogger *> logger_by_context;
+  for (LocalData &local_data : data_per_thread_) {
+    for (const auto item : local_data.tree_logger_by_context.items()) {
+      logger_by_context.add(item.key, item.value.get());
+    }
+  }
+
+  Map<ComputeContextHash, const bNodeTree *> tree_by_context;
+  tree_by_context.add(root_context_hash, &root_tree);
+  /* Contexts are only resolved once their parent is, the nesting depth is generally small. */
+  bool found_new_context = true;
+  while (found_new_context) {
+    found_new_context = false;
+    for (const auto item : logger_by_context.items()) {
+      const GeoTreeLogger &tree_logger = *item.value;
+      if (!tree_logger.parent_hash || tree_by_context.contains(item.key)) {
+        continue;
+      }
+      const bNodeTree *parent_tree = tree_by_context.lookup_default(*tree_logger.parent_hash,
+                                                                    nullptr);
+      if (parent_tree == nullptr) {
+        continue;
+      }
+      const bNodeTree *tree = parent_tree;
+      if (tree_logger.parent_node_id) {
+        const bNode *parent_node = parent_tree->node_by_id(*tree_logger.parent_node_id);
+        if (parent_node == nullptr) {
+          continue;
+        }
+        if (parent_node->is_group()) {
+          if (parent_node->id == nullptr) {
+            continue;
+          }
+          tree = reinterpret_cast<const bNodeTree *>(parent_node->id);
+        }
+      }
+      tree_by_context.add_new(item.key, tree);
+      found_new_context = true;
+    }
+  }
+  return tree_by_context;
+}
+
+Span<NodeProfile> GeoModifierLog::ensure_node_profile(const bNodeTree &root_tree,
+                                                      const ComputeContextHash &root_context_hash)
+{
+  if (node_profile_) {
+    return *node_profile_;
+  }
+  const Map<ComputeContextHash, const bNodeTree *> tree_by_context = this->find_tree_by_context(
+      root_tree, root_context_hash);
+
+  Map<std::pair<const bNodeTree *, int32_t>, NodeProfile> profile_by_node;
+  auto get_node_profile = [&](const bNodeTree &tree, const int32_t node_id) -> NodeProfile * {
+    const bNode *node = tree.node_by_id(node_id);
+    if (node == nullptr) {
+      return nullptr;
+    }
+    return &profile_by_node.lookup_or_add_cb({&tree, node_id}, [&]() {
+      NodeProfile profile;
+      profile.node_group_name = tree.id.name + 2;
+      profile.node_name = node->name;
+      return profile;
+    });
+  };
+
+  for (LocalData &local_data : data_per_thread_) {
+    for (const auto item : local_data.tree_logger_by_context.items()) {
+      const bNodeTree *tree = tree_by_context.lookup_default(item.key, nullptr);
+      if (tree == nullptr) {
+        continue;
+      }
+      const GeoTreeLogger &tree_logger = *item.value;
+      for (const GeoTreeLogger::NodeExecutionTime &timings : tree_logger.node_execution_times) {
+        if (NodeProfile *profile = get_node_profile(*tree, timings.node_id)) {
+          profile->executions_num++;
+          profile->run_time += timings.end - timings.start;
+        }
+      }
+      for (const GeoTreeLogger::NodeOutputGeometrySize &size :
+           tree_logger.node_output_geometry_sizes)
+      {
+        if (NodeProfile *profile = get_node_profile(*tree, size.node_id)) {
+          profile->output_geometry_bytes = std::max(profile->output_geometry_bytes, size.bytes);
+        }
+      }
+    }
+  }
+
+  Vector<NodeProfile> &node_profile = node_profile_.emplace();
+  for (NodeProfile &profile : profile_by_node.values()) {
+    node_profile.append(std::move(profile));
+  }
+  std::sort(node_profile.begin(),
+            node_profile.end(),
+            [](const NodeProfile &a, const NodeProfile &b) { return a.run_time > b.run_time; });
+  return node_profile;
+}
+
+static double duration_to_us(const std::chrono::nanoseconds duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+std::string GeoModifierLog::profile_trace_json(const bNodeTree &root_tree,
+                                               const ComputeContextHash &root_context_hash)
+{
+  namespace serialize = io::serialize;
+  const Map<ComputeContextHash, const bNodeTree *> tree_by_context = this->find_tree_by_context(
+      root_tree, root_context_hash);
+
+  std::optional<TimePoint> first_start;
+  for (LocalData &local_data : data_per_thread_) {
+    for (const destruct_ptr<GeoTreeLogger> &tree_logger :
+         local_data.tree_logger_by_context.values())
+    {
+      for (const GeoTreeLogger::NodeExecutionTime &timings : tree_logger->node_execution_times) {
+        first_start = first_start ? std::min(*first_start, timings.start) : timings.start;
+      }
+    }
+  }
+
+  serialize::DictionaryValue root;
+  serialize::ArrayValue &events = *root.append_array("traceEvents");
+  root.append_str("displayTimeUnit", "ms");
+
+  int thread_index = 0;
+  for (LocalData &local_data : data_per_thread_) {
+    /* Every thread has its own loggers, so use them to tell apart threads in the trace. */
+    thread_index++;
+    for (const auto item : local_data.tree_logger_by_context.items()) {
+      const bNodeTree *tree = tree_by_context.lookup_default(item.key, nullptr);
+      if (tree == nullptr) {
+        continue;
+      }
+      Map<int32_t, int64_t> output_bytes_by_node;
+      for (const GeoTreeLogger::NodeOutputGeometrySize &size :
+           item.value->node_output_geometry_sizes)
+      {
+        int64_t &bytes = output_bytes_by_node.lookup_or_add(size.node_id, 0);
+        bytes = std::max(bytes, size.bytes);
+      }
+      for (const GeoTreeLogger::NodeExecutionTime &timings : item.value->node_execution_times) {
+        const bNode *node = tree->node_by_id(timings.node_id);
+        if (node == nullptr) {
+          continue;
+        }
+        serialize::DictionaryValue &event = *events.append_dict();
+        event.append_str("name", node->name);
+        event.append_str("cat", "geometry_nodes");
+        event.append_str("ph", "X");
+        event.append_int("pid", 1);
+        event.append_int("tid", thread_index);
+        event.append_double("ts", duration_to_us(timings.start - *first_start));
+        event.append_double("dur", duration_to_us(timings.end - timings.start));
+        serialize::DictionaryValue &args = *event.append_dict("args");
+        args.append_str("node_group", tree->id.name + 2);
+        if (const int64_t *bytes = output_bytes_by_node.lookup_ptr(timings.node_id)) {
+          args.append_int("output_geometry_bytes", *bytes);
+        }
+      }
+    }
+  }
+
+  std::stringstream stream;
+  serialize::JsonFormatter formatter;
+  formatter.serialize(stream, root);
+  return stream.str();
+}
+
+std::string GeoModifierLog::profile_summary_json(const bNodeTree &root_tree,
+                                                 const ComputeContextHash &root_context_hash)
+{
+  namespace serialize = io::serialize;
+  const Span<NodeProfile> node_profile = this->ensure_node_profile(root_tree, root_context_hash);
+
+  /* The profile is sorted by run time already, so the nodes in every group are as well. */
+  Map<StringRef, std::chrono::nanoseconds> run_time_by_group;
+  MultiValueMap<StringRef, const NodeProfile *> profiles_by_group;
+  for (const NodeProfile &profile : node_profile) {
+    run_time_by_group.lookup_or_add(profile.node_group_name, {}) += profile.run_time;
+    profiles_by_group.add(profile.node_group_name, &profile);
+  }
+  Vector<StringRef> groups(run_time_by_group.keys().begin(), run_time_by_group.keys().end());
+  std::sort(groups.begin(), groups.end(), [&](const StringRef a, const StringRef b) {
+    return run_time_by_group.lookup(a) > run_time_by_group.lookup(b);
+  });
+
+  serialize::DictionaryValue root;
+  serialize::ArrayValue &groups_value = *root.append_array("node_groups");
+  for (const StringRef group : groups) {
+    serialize::DictionaryValue &group_value = *groups_value.append_dict();
+    group_value.append_str("name", std::string(group));
+    group_value.append_double("run_time_us", duration_to_us(run_time_by_group.lookup(group)));
+    serialize::ArrayValue &nodes_value = *group_value.append_array("nodes");
+    for (const NodeProfile *profile : profiles_by_group.lookup(group)) {
+      serialize::DictionaryValue &node_value = *nodes_value.append_dict();
+      node_value.append_str("name", profile->node_name);
+      node_value.append_int("executions", profile->executions_num);
+      node_value.append_double("run_time_us", duration_to_us(profile->run_time));
+      node_value.append_int("output_geometry_bytes", profile->output_geometry_bytes);
+    }
+  }
+
+  std::stringstream stream;
+  serialize::JsonFormatter formatter;
+  formatter.indentation_len = 2;
+  formatter.serialize(stream, root);
+  return stream.str();
+}
+
 static void find_tree_zone_hash_recursive(
     const bNodeTreeZone &zone,
     ComputeContextBuilder &compute_context_builder,
@@ -269,6 +269,25 @@ class NoiseFunction : public mf::MultiFunction {
     const bool compute_factor = !r_factor.is_empty();
     const bool compute_color = !r_color.is_empty();
 
+    if (dimensions_ == 3 && detail.is_single() && roughness.is_single() &&
+        lacunarity.is_single() && offset.is_single() && gain.is_single() &&
+        distortion.is_single())
+    {
+      const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
+      this->call_3d_batched(mask,
+                            vector,
+                            scale,
+                            math::clamp(detail.get_internal_single(), 0.0f, 15.0f),
+                            math::max(roughness.get_internal_single(), 0.0f),
+                            lacunarity.get_internal_single(),
+                            offset.get_internal_single(),
+                            gain.get_internal_single(),
+                            distortion.get_internal_single(),
+                            r_factor,
+                            r_color);
+      return;
+    }
+
     switch (dimensions_) {
       case 1: {
         const VArray<float> &w = params.readonly_single_input<float>(0, "W");
@@ -416,6 +435,71 @@ class NoiseFunction : public mf::MultiFunction {
     }
   }
 
+  /**
+   * When the noise parameters are the same for all elements, many positions can be evaluated at
+   * once with the vectorized noise functions.
+   */
+  void call_3d_batched(const IndexMask &mask,
+                       const VArray<float3> &vector,
+                       const VArray<float> &scale,
+                       const float detail,
+                       const float roughness,
+                       const float lacunarity,
+                       const float offset,
+                       const float gain,
+                       const float distortion,
+                       MutableSpan<float> r_factor,
+                       MutableSpan<ColorGeometry4f> r_color) const
+  {
+    constexpr int64_t batch_size = 256;
+    std::array<float3, batch_size> positions_buffer;
+    std::array<float, batch_size> factors_buffer;
+    std::array<float3, batch_size> colors_buffer;
+    mask.foreach_segment([&](const IndexMaskSegment segment) {
+      for (int64_t start = 0; start < segment.size(); start += batch_size) {
+        const IndexMaskSegment batch = segment.slice(
+            start, std::min(batch_size, segment.size() - start));
+        const MutableSpan<float3> positions(positions_buffer.data(), batch.size());
+        for (const int64_t i : batch.index_range()) {
+          positions[i] = vector[batch[i]] * scale[batch[i]];
+        }
+        if (!r_factor.is_empty()) {
+          const MutableSpan<float> factors(factors_buffer.data(), batch.size());
+          noise::perlin_fractal_distorted(positions,
+                                          detail,
+                                          roughness,
+                                          lacunarity,
+                                          offset,
+                                          gain,
+                                          distortion,
+                                          type_,
+                                          normalize_,
+                                          factors);
+          for (const int64_t i : batch.index_range()) {
+            r_factor[batch[i]] = factors[i];
+          }
+        }
+        if (!r_color.is_empty()) {
+          const MutableSpan<float3> colors(colors_buffer.data(), batch.size());
+          noise::perlin_float3_fractal_distorted(positions,
+                                                 detail,
+                                                 roughness,
+                                                 lacunarity,
+                                                 offset,
+                                                 gain,
+                                                 distortion,
+                                                 type_,
+                                                 normalize_,
+                                                 colors);
+          for (const int64_t i : batch.index_range()) {
+            const float3 &c = colors[i];
+            r_color[batch[i]] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
+          }
+        }
+      }
+    });
+  }
+
   ExecutionHints get_execution_hints() const override
   {
     ExecutionHints hints;
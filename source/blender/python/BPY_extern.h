@@ -70,6 +70,11 @@ void BPY_modules_update(void);
 void BPY_modules_load_user(struct bContext *C);
 
 void BPY_app_handlers_reset(bool do_all);
+/**
+ * Check whether any Python handler is registered for the callback event type
+ * (#eCbEvent), without the GIL being held by the caller.
+ */
+bool BPY_app_handlers_has(int event);
 
 /**
  * Run on exit to free any cached data.
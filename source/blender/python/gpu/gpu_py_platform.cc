@@ -15,6 +15,9 @@
 
 #include "GPU_context.hh"
 #include "GPU_platform.hh"
+#include "GPU_storage_buffer.hh"
+#include "GPU_texture.hh"
+#include "GPU_vertex_buffer.hh"
 
 #include "gpu_py.hh"
 #include "gpu_py_platform.hh" /* Own include. */
@@ -148,6 +151,34 @@ static PyObject *pygpu_platform_backend_type_get(PyObject * /*self*/)
   return PyUnicode_FromString(backend);
 }
 
+PyDoc_STRVAR(
+    /* Wrap. */
+    pygpu_platform_memory_usage_get_doc,
+    ".. function:: memory_usage_get()\n"
+    "\n"
+    "   Get the GPU memory allocated by Blender, per type of resource.\n"
+    "\n"
+    "   :return: Sizes in bytes, with the keys 'TEXTURES', 'VERTEX_BUFFERS' and "
+    "'STORAGE_BUFFERS'.\n"
+    "   :rtype: dict[str, int]\n");
+static PyObject *pygpu_platform_memory_usage_get(PyObject * /*self*/)
+{
+  BPYGPU_IS_INIT_OR_ERROR_OBJ;
+
+  PyObject *result = PyDict_New();
+  PyObject *item;
+  item = PyLong_FromSize_t(GPU_texture_memory_usage_get());
+  PyDict_SetItemString(result, "TEXTURES", item);
+  Py_DECREF(item);
+  item = PyLong_FromSize_t(GPU_vertbuf_get_memory_usage());
+  PyDict_SetItemString(result, "VERTEX_BUFFERS", item);
+  Py_DECREF(item);
+  item = PyLong_FromSize_t(GPU_storagebuf_memory_usage_get());
+  PyDict_SetItemString(result, "STORAGE_BUFFERS", item);
+  Py_DECREF(item);
+  return result;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -180,6 +211,10 @@ static PyMethodDef pygpu_platform__tp_methods[] = {
      (PyCFunction)pygpu_platform_backend_type_get,
      METH_NOARGS,
      pygpu_platform_backend_type_get_doc},
+    {"memory_usage_get",
+     (PyCFunction)pygpu_platform_memory_usage_get,
+     METH_NOARGS,
+     pygpu_platform_memory_usage_get_doc},
     {nullptr, nullptr, 0, nullptr},
 };
 
@@ -35,6 +35,8 @@
 #include "bpy_app_icons.h"
 #include "bpy_app_timers.h"
 
+#include "BLI_task_trace.hh"
+#include "BLI_timeit.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_appdir.hh"
@@ -42,6 +44,8 @@
 #include "BKE_global.hh"
 #include "BKE_main.hh"
 
+#include "BLO_readfile.hh"
+
 #include "DNA_ID.h"
 
 #include "UI_interface_icons.hh"
@@ -340,6 +344,38 @@ static PyObject *bpy_app_tempdir_get(PyObject * /*self*/, void * /*closure*/)
   return PyC_UnicodeFromBytes(BKE_tempdir_session());
 }
 
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_file_read_durations_doc,
+    "Dictionary of the time (in seconds) spent in the different stages of the last blend-file "
+    "load (read-only)");
+static PyObject *bpy_app_file_read_durations_get(PyObject * /*self*/, void * /*closure*/)
+{
+  const BlendFileReadDurations *duration = WM_file_read_last_durations_get();
+  const struct {
+    const char *name;
+    double value;
+  } items[] = {
+      {"whole", duration->whole},
+      {"read_data", duration->read_data},
+      {"versioning", duration->versioning},
+      {"libraries", duration->libraries},
+      {"lib_link", duration->lib_link},
+      {"lib_overrides", duration->lib_overrides},
+      {"lib_overrides_resync", duration->lib_overrides_resync},
+      {"setup", duration->setup},
+      {"post", duration->post},
+  };
+
+  PyObject *result = PyDict_New();
+  for (const auto &item : items) {
+    PyObject *value = PyFloat_FromDouble(item.value);
+    PyDict_SetItemString(result, item.name, value);
+    Py_DECREF(value);
+  }
+  return result;
+}
+
 PyDoc_STRVAR(
     /* Wrap. */
     bpy_app_driver_dict_doc,
@@ -481,6 +517,11 @@ static PyGetSetDef bpy_app_getsets[] = {
      bpy_app_debug_doc,
      (void *)G_DEBUG_SIMDATA},
     {"debug_io", bpy_app_debug_get, bpy_app_debug_set, bpy_app_debug_doc, (void *)G_DEBUG_IO},
+    {"debug_startup",
+     bpy_app_debug_get,
+     bpy_app_debug_set,
+     bpy_app_debug_doc,
+     (void *)G_DEBUG_STARTUP},
 
     {"use_event_simulate",
      bpy_app_global_flag_get,
@@ -501,6 +542,11 @@ static PyGetSetDef bpy_app_getsets[] = {
      nullptr},
     {"tempdir", bpy_app_tempdir_get, nullptr, bpy_app_tempdir_doc, nullptr},
     {"driver_namespace", bpy_app_driver_dict_get, nullptr, bpy_app_driver_dict_doc, nullptr},
+    {"file_read_durations",
+     bpy_app_file_read_durations_get,
+     nullptr,
+     bpy_app_file_read_durations_doc,
+     nullptr},
 
     {"render_icon_size",
      bpy_app_preview_render_size_get,
@@ -618,6 +664,199 @@ static PyObject *bpy_app_help_text(PyObject * /*self*/, PyObject *args, PyObject
   return result;
 }
 
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_task_trace_start_doc,
+    ".. staticmethod:: task_trace_start()\n"
+    "\n"
+    "   Start recording the execution of threaded tasks, "
+    "events of a previous trace are discarded.\n");
+static PyObject *bpy_app_task_trace_start(PyObject * /*self*/, PyObject * /*args*/)
+{
+  blender::threading::trace::start();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_task_trace_stop_doc,
+    ".. staticmethod:: task_trace_stop(filepath)\n"
+    "\n"
+    "   Stop recording the execution of threaded tasks and write the trace to a file.\n"
+    "   The file uses the Chrome trace event format, "
+    "it can be viewed with ``chrome://tracing`` or https://ui.perfetto.dev.\n"
+    "\n"
+    "   :arg filepath: The file to write the trace to.\n"
+    "   :type filepath: str\n");
+static PyObject *bpy_app_task_trace_stop(PyObject * /*self*/, PyObject *args, PyObject *kwds)
+{
+  const char *filepath;
+  static const char *_keywords[] = {"filepath", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "s" /* `filepath` */
+      ":task_trace_stop",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, &filepath)) {
+    return nullptr;
+  }
+
+  blender::threading::trace::stop();
+  if (!blender::threading::trace::chrome_trace_write(filepath)) {
+    PyErr_Format(PyExc_OSError, "Unable to write task trace to \"%s\"", filepath);
+    return nullptr;
+  }
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_timer_stats_enable_doc,
+    ".. staticmethod:: timer_stats_enable(enable)\n"
+    "\n"
+    "   Enable or disable the accumulation of timing statistics of instrumented code.\n"
+    "\n"
+    "   :arg enable: Whether timing statistics are accumulated.\n"
+    "   :type enable: bool\n");
+static PyObject *bpy_app_timer_stats_enable(PyObject * /*self*/, PyObject *args, PyObject *kwds)
+{
+  bool enable;
+  static const char *_keywords[] = {"enable", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "O&" /* `enable` */
+      ":timer_stats_enable",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, PyC_ParseBool, &enable)) {
+    return nullptr;
+  }
+  blender::timeit::timer_stats_enable(enable);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_timer_stats_reset_doc,
+    ".. staticmethod:: timer_stats_reset()\n"
+    "\n"
+    "   Clear the accumulated timing statistics.\n");
+static PyObject *bpy_app_timer_stats_reset(PyObject * /*self*/, PyObject * /*args*/)
+{
+  blender::timeit::timer_stats_reset();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_timer_stats_doc,
+    ".. staticmethod:: timer_stats()\n"
+    "\n"
+    "   Return the timing statistics accumulated since the last reset.\n"
+    "\n"
+    "   :return: A dictionary, the keys are the paths of nested timing scopes "
+    "(names separated by a slash), the values are dictionaries with the number of times the "
+    "scope was entered (``count``) and the ``total``, ``min`` and ``max`` durations in "
+    "seconds.\n"
+    "   :rtype: dict[str, dict[str, int | float]]\n");
+static PyObject *bpy_app_timer_stats(PyObject * /*self*/, PyObject * /*args*/)
+{
+  using namespace blender::timeit;
+  const auto to_seconds = [](const Nanoseconds duration) {
+    return PyFloat_FromDouble(double(duration.count()) / 1.0e9);
+  };
+  /* Steals the reference to the value. */
+  const auto dict_set_item = [](PyObject *dict, const char *key, PyObject *value) {
+    PyDict_SetItemString(dict, key, value);
+    Py_DECREF(value);
+  };
+  PyObject *result = PyDict_New();
+  for (const TimerStats &stats : timer_stats_get()) {
+    PyObject *item = PyDict_New();
+    dict_set_item(item, "count", PyLong_FromLongLong(stats.count));
+    dict_set_item(item, "total", to_seconds(stats.total_time));
+    dict_set_item(item, "min", to_seconds(stats.min_time));
+    dict_set_item(item, "max", to_seconds(stats.max_time));
+    dict_set_item(result, stats.path.c_str(), item);
+  }
+  return result;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_memory_categories_enable_doc,
+    ".. staticmethod:: memory_categories_enable(enable)\n"
+    "\n"
+    "   Enable or disable attributing new memory allocations to categories like meshes or "
+    "images. Only memory allocated while enabled is counted.\n"
+    "\n"
+    "   :arg enable: Whether allocations are attributed to categories.\n"
+    "   :type enable: bool\n");
+static PyObject *bpy_app_memory_categories_enable(PyObject * /*self*/,
+                                                  PyObject *args,
+                                                  PyObject *kwds)
+{
+  bool enable;
+  static const char *_keywords[] = {"enable", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "O&" /* `enable` */
+      ":memory_categories_enable",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, PyC_ParseBool, &enable)) {
+    return nullptr;
+  }
+  MEM_use_memory_categories(enable);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_memory_categories_reset_peak_doc,
+    ".. staticmethod:: memory_categories_reset_peak()\n"
+    "\n"
+    "   Reset the peak memory usage of all memory categories to their current usage.\n");
+static PyObject *bpy_app_memory_categories_reset_peak(PyObject * /*self*/, PyObject * /*args*/)
+{
+  MEM_category_reset_peak_memory();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_memory_categories_doc,
+    ".. staticmethod:: memory_categories()\n"
+    "\n"
+    "   Return the memory usage per category.\n"
+    "\n"
+    "   :return: A dictionary, the keys are the category names, the values are dictionaries with "
+    "the memory currently in use (``in_use``) and the peak memory usage since the last reset "
+    "(``peak``) in bytes. The ``Other`` category contains all memory that is not attributed to "
+    "another category, its peak is not tracked.\n"
+    "   :rtype: dict[str, dict[str, int]]\n");
+static PyObject *bpy_app_memory_categories(PyObject * /*self*/, PyObject * /*args*/)
+{
+  /* Steals the reference to the value. */
+  const auto dict_set_item = [](PyObject *dict, const char *key, PyObject *value) {
+    PyDict_SetItemString(dict, key, value);
+    Py_DECREF(value);
+  };
+  PyObject *result = PyDict_New();
+  for (int i = 0; i < MEM_CATEGORY_NUM; i++) {
+    const eMEM_Category category = eMEM_Category(i);
+    PyObject *item = PyDict_New();
+    dict_set_item(item, "in_use", PyLong_FromSize_t(MEM_category_get_memory_in_use(category)));
+    dict_set_item(item, "peak", PyLong_FromSize_t(MEM_category_get_peak_memory(category)));
+    dict_set_item(result, MEM_category_name(category), item);
+  }
+  return result;
+}
+
 #if (defined(__GNUC__) && !defined(__clang__))
 #  pragma GCC diagnostic push
 #  pragma GCC diagnostic ignored "-Wcast-function-type"
@@ -632,6 +871,38 @@ static PyMethodDef bpy_app_methods[] = {
      (PyCFunction)bpy_app_help_text,
      METH_VARARGS | METH_KEYWORDS | METH_STATIC,
      bpy_app_help_text_doc},
+    {"task_trace_start",
+     (PyCFunction)bpy_app_task_trace_start,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_task_trace_start_doc},
+    {"task_trace_stop",
+     (PyCFunction)bpy_app_task_trace_stop,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     bpy_app_task_trace_stop_doc},
+    {"timer_stats_enable",
+     (PyCFunction)bpy_app_timer_stats_enable,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     bpy_app_timer_stats_enable_doc},
+    {"timer_stats_reset",
+     (PyCFunction)bpy_app_timer_stats_reset,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_timer_stats_reset_doc},
+    {"timer_stats",
+     (PyCFunction)bpy_app_timer_stats,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_timer_stats_doc},
+    {"memory_categories_enable",
+     (PyCFunction)bpy_app_memory_categories_enable,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     bpy_app_memory_categories_enable_doc},
+    {"memory_categories_reset_peak",
+     (PyCFunction)bpy_app_memory_categories_reset_peak,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_memory_categories_reset_peak_doc},
+    {"memory_categories",
+     (PyCFunction)bpy_app_memory_categories,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_memory_categories_doc},
     {nullptr, nullptr, 0, nullptr},
 };
 
@@ -288,6 +288,18 @@ PyObject *BPY_app_handlers_struct()
   return ret;
 }
 
+bool BPY_app_handlers_has(const int event)
+{
+  BLI_assert(event >= 0 && event < BKE_CB_EVT_TOT);
+  if (py_cb_array[event] == nullptr) {
+    return false;
+  }
+  const PyGILState_STATE gilstate = PyGILState_Ensure();
+  const bool has_handlers = PyList_GET_SIZE(py_cb_array[event]) > 0;
+  PyGILState_Release(gilstate);
+  return has_handlers;
+}
+
 void BPY_app_handlers_reset(const bool do_all)
 {
   PyGILState_STATE gilstate;
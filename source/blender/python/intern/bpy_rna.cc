@@ -23,9 +23,11 @@
 #include "BLI_bitmap.h"
 #include "BLI_dynstr.h"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_math_rotation.h"
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BPY_extern.h"
 #include "BPY_extern_clog.h"
@@ -5774,6 +5776,464 @@ static PyObject *pyrna_prop_collection_foreach_set(BPy_PropertyRNA *self, PyObje
   return foreach_getset(self, args, 1);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Collection Batch Get/Set
+ *
+ * Access properties of all items of a collection through property paths in a single call.
+ * \{ */
+
+/** A property path of a batch access, and the values of all items for that path. */
+struct BatchPropertyPath {
+  const char *path = nullptr;
+  /**
+   * The path is the identifier of a property of the items. The property only depends on the
+   * type of the item then, it is looked up once per type.
+   */
+  bool is_identifier = false;
+  blender::Map<StructRNA *, PropertyRNA *> props_by_type;
+
+  /** Set once the path is resolved for the first item, all items must match it. */
+  bool is_resolved = false;
+  PropertyType type = PROP_BOOLEAN;
+  int array_len = 0;
+  /** Size of the values of an item in #data. */
+  size_t item_size = 0;
+  blender::Vector<char> data;
+};
+
+static bool batch_path_is_identifier(const char *path)
+{
+  if (path[0] == '\0' || isdigit(path[0])) {
+    return false;
+  }
+  for (const char *c = path; *c; c++) {
+    if (!(isalnum(*c) || *c == '_')) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static const char *batch_path_format(const PropertyType type)
+{
+  switch (type) {
+    case PROP_BOOLEAN:
+      return "?";
+    case PROP_FLOAT:
+      return "f";
+    default:
+      return "i";
+  }
+}
+
+static size_t batch_path_value_size(const PropertyType type)
+{
+  switch (type) {
+    case PROP_BOOLEAN:
+      return sizeof(bool);
+    case PROP_FLOAT:
+      return sizeof(float);
+    default:
+      return sizeof(int);
+  }
+}
+
+/**
+ * Parse the paths argument of #pyrna_prop_collection_batch_get and
+ * #pyrna_prop_collection_batch_set. The strings are owned by \a r_paths_fast.
+ */
+static bool batch_paths_parse(PyObject *py_paths,
+                              const char *function_name,
+                              PyObject **r_paths_fast,
+                              blender::Vector<BatchPropertyPath> &r_paths)
+{
+  PyObject *paths_fast = PySequence_Fast(py_paths, "expected a sequence of strings");
+  if (paths_fast == nullptr) {
+    return false;
+  }
+  const Py_ssize_t paths_num = PySequence_Fast_GET_SIZE(paths_fast);
+  PyObject **paths_items = PySequence_Fast_ITEMS(paths_fast);
+  r_paths.resize(paths_num);
+  for (const Py_ssize_t i : blender::IndexRange(paths_num)) {
+    const char *path = PyUnicode_Check(paths_items[i]) ? PyUnicode_AsUTF8(paths_items[i]) :
+                                                          nullptr;
+    if (path == nullptr) {
+      PyErr_Format(PyExc_TypeError,
+                   "%s(..) expected paths to be strings, not a %.200s",
+                   function_name,
+                   Py_TYPE(paths_items[i])->tp_name);
+      Py_DECREF(paths_fast);
+      return false;
+    }
+    r_paths[i].path = path;
+    r_paths[i].is_identifier = batch_path_is_identifier(path);
+  }
+  *r_paths_fast = paths_fast;
+  return true;
+}
+
+/**
+ * Resolve \a path for an item of the collection, and check that it is a property with the same
+ * type and array length as for the previous items.
+ */
+static bool batch_path_resolve(BatchPropertyPath &path,
+                               const char *function_name,
+                               PointerRNA *item_ptr,
+                               PointerRNA *r_ptr,
+                               PropertyRNA **r_prop)
+{
+  PropertyRNA *prop = nullptr;
+  if (path.is_identifier) {
+    prop = path.props_by_type.lookup_or_add_cb(
+        item_ptr->type, [&]() { return RNA_struct_find_property(item_ptr, path.path); });
+    *r_ptr = *item_ptr;
+  }
+  else if (!RNA_path_resolve_property(item_ptr, path.path, r_ptr, &prop)) {
+    prop = nullptr;
+  }
+  if (prop == nullptr) {
+    PyErr_Format(PyExc_AttributeError,
+                 "%s(..) '%.200s' elements have no property '%.200s'",
+                 function_name,
+                 RNA_struct_identifier(item_ptr->type),
+                 path.path);
+    return false;
+  }
+
+  const PropertyType type = RNA_property_type(prop);
+  const int array_len = RNA_property_array_length(r_ptr, prop);
+  if (!path.is_resolved) {
+    if (!ELEM(type, PROP_BOOLEAN, PROP_INT, PROP_FLOAT, PROP_ENUM)) {
+      PyErr_Format(PyExc_TypeError,
+                   "%s(..) property '%.200s' is not a boolean, int, float or enum property",
+                   function_name,
+                   path.path);
+      return false;
+    }
+    path.is_resolved = true;
+    path.type = type;
+    path.array_len = array_len;
+    path.item_size = batch_path_value_size(type) * std::max(array_len, 1);
+  }
+  else if (type != path.type || array_len != path.array_len) {
+    PyErr_Format(PyExc_TypeError,
+                 "%s(..) property '%.200s' has a different type or array length in '%.200s'",
+                 function_name,
+                 path.path,
+                 RNA_struct_identifier(item_ptr->type));
+    return false;
+  }
+  *r_prop = prop;
+  return true;
+}
+
+static void batch_path_value_get(const BatchPropertyPath &path,
+                                 PointerRNA *ptr,
+                                 PropertyRNA *prop,
+                                 void *r_value)
+{
+  switch (path.type) {
+    case PROP_BOOLEAN:
+      if (path.array_len > 0) {
+        RNA_property_boolean_get_array(ptr, prop, static_cast<bool *>(r_value));
+      }
+      else {
+        *static_cast<bool *>(r_value) = RNA_property_boolean_get(ptr, prop);
+      }
+      break;
+    case PROP_INT:
+      if (path.array_len > 0) {
+        RNA_property_int_get_array(ptr, prop, static_cast<int *>(r_value));
+      }
+      else {
+        *static_cast<int *>(r_value) = RNA_property_int_get(ptr, prop);
+      }
+      break;
+    case PROP_FLOAT:
+      if (path.array_len > 0) {
+        RNA_property_float_get_array(ptr, prop, static_cast<float *>(r_value));
+      }
+      else {
+        *static_cast<float *>(r_value) = RNA_property_float_get(ptr, prop);
+      }
+      break;
+    case PROP_ENUM:
+      *static_cast<int *>(r_value) = RNA_property_enum_get(ptr, prop);
+      break;
+    default:
+      BLI_assert_unreachable();
+      break;
+  }
+}
+
+static void batch_path_value_set(const BatchPropertyPath &path,
+                                 PointerRNA *ptr,
+                                 PropertyRNA *prop,
+                                 const void *value)
+{
+  switch (path.type) {
+    case PROP_BOOLEAN:
+      if (path.array_len > 0) {
+        RNA_property_boolean_set_array(ptr, prop, static_cast<const bool *>(value));
+      }
+      else {
+        RNA_property_boolean_set(ptr, prop, *static_cast<const bool *>(value));
+      }
+      break;
+    case PROP_INT:
+      if (path.array_len > 0) {
+        RNA_property_int_set_array(ptr, prop, static_cast<const int *>(value));
+      }
+      else {
+        RNA_property_int_set(ptr, prop, *static_cast<const int *>(value));
+      }
+      break;
+    case PROP_FLOAT:
+      if (path.array_len > 0) {
+        RNA_property_float_set_array(ptr, prop, static_cast<const float *>(value));
+      }
+      else {
+        RNA_property_float_set(ptr, prop, *static_cast<const float *>(value));
+      }
+      break;
+    case PROP_ENUM:
+      RNA_property_enum_set(ptr, prop, *static_cast<const int *>(value));
+      break;
+    default:
+      BLI_assert_unreachable();
+      break;
+  }
+}
+
+/** Create a memory view of the values of all items, with one row per item. */
+static PyObject *batch_path_values_as_memoryview(const BatchPropertyPath &path,
+                                                 const int items_num)
+{
+  PyObject *bytes = PyByteArray_FromStringAndSize(path.data.data(), path.data.size());
+  if (bytes == nullptr) {
+    return nullptr;
+  }
+  PyObject *view = PyMemoryView_FromObject(bytes);
+  Py_DECREF(bytes);
+  if (view == nullptr || !path.is_resolved) {
+    return view;
+  }
+  PyObject *shape = (path.array_len > 0) ? Py_BuildValue("(ii)", items_num, path.array_len) :
+                                           Py_BuildValue("(i)", items_num);
+  PyObject *result = PyObject_CallMethod(view, "cast", "sN", batch_path_format(path.type), shape);
+  Py_DECREF(view);
+  return result;
+}
+
+/** Copy the values for all items given for \a path into its data. */
+static bool batch_path_values_from_py(BatchPropertyPath &path,
+                                      const char *function_name,
+                                      PyObject *py_values,
+                                      const int items_num)
+{
+  const Py_ssize_t values_num = Py_ssize_t(items_num) * std::max(path.array_len, 1);
+  path.data.resize(path.item_size * items_num);
+
+  if (PyObject_CheckBuffer(py_values)) {
+    Py_buffer buf;
+    if (PyObject_GetBuffer(py_values, &buf, PyBUF_ND | PyBUF_FORMAT) == -1) {
+      /* Fall back to accessing the values as a sequence. */
+      PyErr_Clear();
+    }
+    else {
+      const char format = buf.format ? *buf.format : 'B';
+      const bool is_compat = (format == *batch_path_format(path.type)) &&
+                             size_t(buf.len) == size_t(path.data.size());
+      if (is_compat) {
+        memcpy(path.data.data(), buf.buf, path.data.size());
+      }
+      PyBuffer_Release(&buf);
+      if (is_compat) {
+        return true;
+      }
+    }
+  }
+
+  PyObject *values_fast = PySequence_Fast(py_values, "expected a sequence or buffer of values");
+  if (values_fast == nullptr) {
+    return false;
+  }
+  const PyTypeObject *py_type = (path.type == PROP_FLOAT)   ? &PyFloat_Type :
+                                (path.type == PROP_BOOLEAN) ? &PyBool_Type :
+                                                              &PyLong_Type;
+  const int result = PyC_AsArray_FAST(path.data.data(),
+                                      batch_path_value_size(path.type),
+                                      values_fast,
+                                      values_num,
+                                      py_type,
+                                      function_name);
+  Py_DECREF(values_fast);
+  return result != -1;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    pyrna_prop_collection_batch_get_doc,
+    ".. method:: batch_get(paths)\n"
+    "\n"
+    "   Get the values of several properties of all items in the collection at once. Paths are "
+    "relative to the items, e.g. ``\"location\"``, ``'[\"prop\"]'`` or "
+    "``\"rigid_body.mass\"``, and must resolve to boolean, int, float or enum properties with "
+    "the same array length for all items.\n"
+    "\n"
+    "   :arg paths: Property paths relative to the items.\n"
+    "   :type paths: Sequence[str]\n"
+    "   :return: A memory view for every path, with one row of values per item. Enum "
+    "properties give their integer value.\n"
+    "   :rtype: tuple[memoryview, ...]\n");
+static PyObject *pyrna_prop_collection_batch_get(BPy_PropertyRNA *self, PyObject *value)
+{
+  PYRNA_PROP_CHECK_OBJ(self);
+
+  PyObject *paths_fast;
+  blender::Vector<BatchPropertyPath> paths;
+  if (!batch_paths_parse(value, "batch_get", &paths_fast, paths)) {
+    return nullptr;
+  }
+
+  const int items_num = RNA_property_collection_length(&self->ptr, self->prop);
+  bool ok = true;
+  int item_index = 0;
+  RNA_PROP_BEGIN (&self->ptr, itemptr, self->prop) {
+    if (item_index == items_num) {
+      break;
+    }
+    for (BatchPropertyPath &path : paths) {
+      PointerRNA ptr;
+      PropertyRNA *prop;
+      if (!batch_path_resolve(path, "batch_get", &itemptr, &ptr, &prop)) {
+        ok = false;
+        break;
+      }
+      if (path.data.is_empty()) {
+        path.data.resize(path.item_size * items_num);
+      }
+      batch_path_value_get(path, &ptr, prop, &path.data[path.item_size * item_index]);
+    }
+    if (!ok) {
+      break;
+    }
+    item_index++;
+  }
+  RNA_PROP_END;
+
+  PyObject *result = nullptr;
+  if (ok) {
+    result = PyTuple_New(paths.size());
+    for (const int i : paths.index_range()) {
+      PyObject *view = batch_path_values_as_memoryview(paths[i], items_num);
+      if (view == nullptr) {
+        Py_DECREF(result);
+        result = nullptr;
+        break;
+      }
+      PyTuple_SET_ITEM(result, i, view);
+    }
+  }
+
+  Py_DECREF(paths_fast);
+  return result;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    pyrna_prop_collection_batch_set_doc,
+    ".. method:: batch_set(paths, values)\n"
+    "\n"
+    "   Set the values of several properties of all items in the collection at once, the "
+    "counterpart of :meth:`batch_get`.\n"
+    "\n"
+    "   :arg paths: Property paths relative to the items.\n"
+    "   :type paths: Sequence[str]\n"
+    "   :arg values: The values of every path, a buffer or a flat sequence with the values of "
+    "all items after each other.\n"
+    "   :type values: Sequence[Buffer | Sequence[bool | int | float]]\n");
+static PyObject *pyrna_prop_collection_batch_set(BPy_PropertyRNA *self, PyObject *args)
+{
+  PYRNA_PROP_CHECK_OBJ(self);
+
+  PyObject *py_paths, *py_values;
+  if (!PyArg_ParseTuple(args, "OO:batch_set", &py_paths, &py_values)) {
+    return nullptr;
+  }
+
+  PyObject *paths_fast;
+  blender::Vector<BatchPropertyPath> paths;
+  if (!batch_paths_parse(py_paths, "batch_set", &paths_fast, paths)) {
+    return nullptr;
+  }
+  PyObject *values_fast = PySequence_Fast(py_values, "batch_set(..) expected a sequence");
+  if (values_fast == nullptr) {
+    Py_DECREF(paths_fast);
+    return nullptr;
+  }
+  if (PySequence_Fast_GET_SIZE(values_fast) != paths.size()) {
+    PyErr_Format(PyExc_ValueError,
+                 "batch_set(..) expected %d sequences of values, not %d",
+                 int(paths.size()),
+                 int(PySequence_Fast_GET_SIZE(values_fast)));
+    Py_DECREF(values_fast);
+    Py_DECREF(paths_fast);
+    return nullptr;
+  }
+  PyObject **values_items = PySequence_Fast_ITEMS(values_fast);
+
+  bContext *C = BPY_context_get();
+  const int items_num = RNA_property_collection_length(&self->ptr, self->prop);
+  bool ok = true;
+  int item_index = 0;
+  RNA_PROP_BEGIN (&self->ptr, itemptr, self->prop) {
+    if (item_index == items_num) {
+      break;
+    }
+    for (const int i : paths.index_range()) {
+      BatchPropertyPath &path = paths[i];
+      PointerRNA ptr;
+      PropertyRNA *prop;
+      if (!batch_path_resolve(path, "batch_set", &itemptr, &ptr, &prop)) {
+        ok = false;
+        break;
+      }
+      /* The values can only be read once the type of the property is known. */
+      if (path.data.is_empty() &&
+          !batch_path_values_from_py(path, "batch_set(..)", values_items[i], items_num))
+      {
+        ok = false;
+        break;
+      }
+      if (!RNA_property_editable(&ptr, prop)) {
+        PyErr_Format(PyExc_AttributeError,
+                     "batch_set(..) property '%.200s' of '%.200s' is read-only",
+                     path.path,
+                     RNA_struct_identifier(itemptr.type));
+        ok = false;
+        break;
+      }
+      batch_path_value_set(path, &ptr, prop, &path.data[path.item_size * item_index]);
+      RNA_property_update(C, &ptr, prop);
+    }
+    if (!ok) {
+      break;
+    }
+    item_index++;
+  }
+  RNA_PROP_END;
+
+  Py_DECREF(values_fast);
+  Py_DECREF(paths_fast);
+  if (!ok) {
+    return nullptr;
+  }
+  Py_RETURN_NONE;
+}
+
+/** \} */
+
 static PyObject *pyprop_array_foreach_getset(BPy_PropertyArrayRNA *self,
                                              PyObject *args,
                                              const bool do_set)
@@ -6139,6 +6599,14 @@ static PyMethodDef pyrna_prop_collection_methods[] = {
      (PyCFunction)pyrna_prop_collection_foreach_set,
      METH_VARARGS,
      pyrna_prop_collection_foreach_set_doc},
+    {"batch_get",
+     (PyCFunction)pyrna_prop_collection_batch_get,
+     METH_O,
+     pyrna_prop_collection_batch_get_doc},
+    {"batch_set",
+     (PyCFunction)pyrna_prop_collection_batch_set,
+     METH_VARARGS,
+     pyrna_prop_collection_batch_set_doc},
 
     {"keys", (PyCFunction)pyrna_prop_collection_keys, METH_NOARGS, pyrna_prop_collection_keys_doc},
     {"items",
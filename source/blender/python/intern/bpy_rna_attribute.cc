@@ -0,0 +1,239 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * This file extends geometry attributes with C/Python API methods, for access to the attribute
+ * arrays through the buffer protocol, which can't be defined in RNA.
+ */
+
+#define PY_SSIZE_T_CLEAN
+
+#include <Python.h>
+
+#include "BLI_string.h"
+#include "BLI_utildefines.h"
+
+#include "BKE_attribute.h"
+#include "BKE_curves.hh"
+#include "BKE_customdata.hh"
+#include "BKE_mesh_types.hh"
+
+#include "DEG_depsgraph.hh"
+
+#include "DNA_customdata_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_pointcloud_types.h"
+
+#include "WM_api.hh"
+#include "WM_types.hh"
+
+#include "../generic/py_capi_utils.h"
+#include "../generic/python_compat.h"
+
+#include "bpy_rna.h"
+#include "bpy_rna_attribute.h" /* Declare #BPY_rna_attribute_as_buffer_method_def. */
+
+/* -------------------------------------------------------------------- */
+/** \name Attribute As Buffer
+ * \{ */
+
+/**
+ * The layout of one element of an attribute type in the buffer protocol: the format of its
+ * values, and the dimensions of the value array of one element.
+ */
+struct AttributeBufferLayout {
+  /** A string literal, referenced by the memory view. */
+  const char *format;
+  Py_ssize_t itemsize;
+  int item_ndim;
+  Py_ssize_t item_shape[2];
+};
+
+static bool attribute_buffer_layout_get(const eCustomDataType type,
+                                        AttributeBufferLayout *r_layout)
+{
+  switch (type) {
+    case CD_PROP_FLOAT:
+      *r_layout = {"f", 4, 0, {0, 0}};
+      return true;
+    case CD_PROP_FLOAT2:
+      *r_layout = {"f", 4, 1, {2, 0}};
+      return true;
+    case CD_PROP_FLOAT3:
+      *r_layout = {"f", 4, 1, {3, 0}};
+      return true;
+    case CD_PROP_COLOR:
+    case CD_PROP_QUATERNION:
+      *r_layout = {"f", 4, 1, {4, 0}};
+      return true;
+    case CD_PROP_FLOAT4X4:
+      *r_layout = {"f", 4, 2, {4, 4}};
+      return true;
+    case CD_PROP_BYTE_COLOR:
+      *r_layout = {"B", 1, 1, {4, 0}};
+      return true;
+    case CD_PROP_INT8:
+      *r_layout = {"b", 1, 0, {0, 0}};
+      return true;
+    case CD_PROP_INT32:
+      *r_layout = {"i", 4, 0, {0, 0}};
+      return true;
+    case CD_PROP_INT32_2D:
+      *r_layout = {"i", 4, 1, {2, 0}};
+      return true;
+    case CD_PROP_BOOL:
+      *r_layout = {"?", 1, 0, {0, 0}};
+      return true;
+    default:
+      return false;
+  }
+}
+
+/** Tag the owner of a changed attribute, like changes through the RNA API. */
+static void attribute_tag_changed(const AttributeOwner &owner,
+                                  ID *id,
+                                  const CustomDataLayer *layer)
+{
+  const bool is_position = STREQ(layer->name, "position");
+  switch (owner.type()) {
+    case AttributeOwnerType::Mesh:
+      if (is_position) {
+        owner.get_mesh()->tag_positions_changed();
+      }
+      break;
+    case AttributeOwnerType::PointCloud:
+      if (is_position) {
+        owner.get_pointcloud()->tag_positions_changed();
+      }
+      break;
+    case AttributeOwnerType::Curves:
+      if (is_position) {
+        owner.get_curves()->geometry.wrap().tag_positions_changed();
+      }
+      break;
+    default:
+      break;
+  }
+
+  if (id->us > 0) {
+    DEG_id_tag_update(id, 0);
+    WM_main_add_notifier(NC_GEOM | ND_DATA, id);
+  }
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_rna_attribute_as_buffer_doc,
+    ".. method:: as_buffer(*, writable=False)\n"
+    "\n"
+    "   Access the values of the attribute without copying them, through a memory view that can "
+    "be used with the buffer protocol (e.g. ``numpy.asarray(attribute.as_buffer())``). The "
+    "first dimension of the view is the number of elements in the attribute domain, followed by "
+    "the dimensions of a single value (e.g. 3 for vectors, 4 by 4 for matrices).\n"
+    "\n"
+    "   The view is only valid until the geometry is changed in any other way, it must not be "
+    "used afterwards. Writable views make the attribute data mutable and tag the geometry for "
+    "an update when they are created, changes to the values are taken into account by the next "
+    "evaluation of the dependency graph.\n"
+    "\n"
+    "   Only mesh, point cloud and curves attributes are supported, string attributes and mesh "
+    "attributes in edit-mode are not.\n"
+    "\n"
+    "   :arg writable: Allow the values to be changed through the view.\n"
+    "   :type writable: bool\n"
+    "   :return: The values of the attribute.\n"
+    "   :rtype: memoryview\n");
+static PyObject *bpy_rna_attribute_as_buffer(PyObject *self, PyObject *args, PyObject *kwds)
+{
+  BPy_StructRNA *pyrna = (BPy_StructRNA *)self;
+  PYRNA_STRUCT_CHECK_OBJ(pyrna);
+  ID *id = pyrna->ptr.owner_id;
+  CustomDataLayer *layer = static_cast<CustomDataLayer *>(pyrna->ptr.data);
+
+  bool writable = false;
+
+  static const char *_keywords[] = {"writable", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "|$" /* Optional keyword only arguments. */
+      "O&" /* `writable` */
+      ":as_buffer",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, PyC_ParseBool, &writable)) {
+    return nullptr;
+  }
+
+  AttributeOwner owner = AttributeOwner::from_id(id);
+  if (!owner.is_valid() || !ELEM(owner.type(),
+                                 AttributeOwnerType::Mesh,
+                                 AttributeOwnerType::PointCloud,
+                                 AttributeOwnerType::Curves))
+  {
+    PyErr_SetString(PyExc_TypeError,
+                    "as_buffer: only mesh, point cloud and curves attributes are supported");
+    return nullptr;
+  }
+  if (owner.type() == AttributeOwnerType::Mesh && owner.get_mesh()->runtime->edit_mesh) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "as_buffer: mesh attributes are not available in edit-mode");
+    return nullptr;
+  }
+  AttributeBufferLayout layout;
+  if (!attribute_buffer_layout_get(eCustomDataType(layer->type), &layout)) {
+    PyErr_Format(
+        PyExc_TypeError, "as_buffer: type of attribute \"%s\" not supported", layer->name);
+    return nullptr;
+  }
+  if (writable && ID_IS_LINKED(id)) {
+    PyErr_Format(PyExc_AttributeError, "as_buffer: data-block \"%s\" is linked", id->name + 2);
+    return nullptr;
+  }
+
+  const int length = BKE_attribute_data_length(owner, layer);
+  if (writable) {
+    CustomData_ensure_data_is_mutable(layer, length);
+    attribute_tag_changed(owner, id, layer);
+  }
+
+  /* A memory view needs a valid pointer, even when it is empty. */
+  static char empty_data = 0;
+
+  Py_ssize_t shape[3] = {length, layout.item_shape[0], layout.item_shape[1]};
+  Py_buffer view{};
+  view.buf = (length > 0 && layer->data) ? layer->data : &empty_data;
+  view.obj = nullptr;
+  view.len = Py_ssize_t(length) * Py_ssize_t(CustomData_get_elem_size(layer));
+  view.itemsize = layout.itemsize;
+  view.readonly = !writable;
+  view.ndim = 1 + layout.item_ndim;
+  /* The shape is copied by the memory view. */
+  view.format = const_cast<char *>(layout.format);
+  view.shape = shape;
+  view.strides = nullptr;
+  view.suboffsets = nullptr;
+  view.internal = nullptr;
+  return PyMemoryView_FromBuffer(&view);
+}
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wcast-function-type"
+#endif
+
+PyMethodDef BPY_rna_attribute_as_buffer_method_def = {
+    "as_buffer",
+    (PyCFunction)bpy_rna_attribute_as_buffer,
+    METH_VARARGS | METH_KEYWORDS,
+    bpy_rna_attribute_as_buffer_doc,
+};
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic pop
+#endif
+
+/** \} */
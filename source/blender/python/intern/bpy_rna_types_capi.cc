@@ -23,6 +23,7 @@
 
 #include "bpy_library.h"
 #include "bpy_rna.h"
+#include "bpy_rna_attribute.h"
 #include "bpy_rna_callback.h"
 #include "bpy_rna_context.h"
 #include "bpy_rna_data.h"
@@ -30,6 +31,7 @@
 #include "bpy_rna_text.h"
 #include "bpy_rna_types_capi.h"
 #include "bpy_rna_ui.h"
+#include "bpy_rna_view_layer.h"
 
 #include "bpy_rna_operator.h"
 
@@ -101,6 +103,28 @@ static PyMethodDef pyrna_text_methods[] = {
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name View Layer
+ * \{ */
+
+static PyMethodDef pyrna_view_layer_methods[] = {
+    {nullptr, nullptr, 0, nullptr}, /* #BPY_rna_view_layer_evaluate_frames_method_def */
+    {nullptr, nullptr, 0, nullptr},
+};
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Attribute
+ * \{ */
+
+static PyMethodDef pyrna_attribute_methods[] = {
+    {nullptr, nullptr, 0, nullptr}, /* #BPY_rna_attribute_as_buffer_method_def */
+    {nullptr, nullptr, 0, nullptr},
+};
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Window Manager Clipboard Property
  *
@@ -306,6 +330,16 @@ void BPY_rna_types_extend_capi()
   BLI_assert(ARRAY_SIZE(pyrna_text_methods) == 3);
   pyrna_struct_type_extend_capi(&RNA_Text, pyrna_text_methods, nullptr);
 
+  /* ViewLayer */
+  ARRAY_SET_ITEMS(pyrna_view_layer_methods, BPY_rna_view_layer_evaluate_frames_method_def);
+  BLI_assert(ARRAY_SIZE(pyrna_view_layer_methods) == 2);
+  pyrna_struct_type_extend_capi(&RNA_ViewLayer, pyrna_view_layer_methods, nullptr);
+
+  /* Attribute */
+  ARRAY_SET_ITEMS(pyrna_attribute_methods, BPY_rna_attribute_as_buffer_method_def);
+  BLI_assert(ARRAY_SIZE(pyrna_attribute_methods) == 2);
+  pyrna_struct_type_extend_capi(&RNA_Attribute, pyrna_attribute_methods, nullptr);
+
   /* wmOperator */
   ARRAY_SET_ITEMS(pyrna_operator_methods, BPY_rna_operator_poll_message_set_method_def);
   BLI_assert(ARRAY_SIZE(pyrna_operator_methods) == 2);
@@ -0,0 +1,182 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * This file extends the view layer with C/Python API methods, for functions that take Python
+ * callbacks and can't be defined in RNA.
+ */
+
+#define PY_SSIZE_T_CLEAN
+
+#include <algorithm>
+
+#include <Python.h>
+
+#include "BLI_array.hh"
+#include "BLI_threads.h"
+
+#include "BKE_global.hh"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
+#include "DEG_depsgraph_frame_parallel.hh"
+
+#include "DNA_layer_types.h"
+#include "DNA_scene_types.h"
+
+#include "RNA_access.hh"
+#include "RNA_prototypes.hh"
+
+#include "../generic/py_capi_utils.h"
+#include "../generic/python_compat.h"
+
+#include "bpy_rna.h"
+#include "bpy_rna_view_layer.h" /* Declare #BPY_rna_view_layer_evaluate_frames_method_def. */
+
+/* -------------------------------------------------------------------- */
+/** \name View Layer Evaluate Frames
+ * \{ */
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_rna_view_layer_evaluate_frames_doc,
+    ".. method:: evaluate_frames(frames, callback, *, depsgraphs_num=0)\n"
+    "\n"
+    "   Evaluate frames of the scene in depsgraphs that are separate from the depsgraph of the "
+    "view layer, several frames at the same time. The scene frame is not changed and frame "
+    "change handlers are not called.\n"
+    "\n"
+    "   Nothing is evaluated when the evaluated state of a frame depends on the previous frames "
+    "(e.g. simulations and point caches), in that case the frames have to be set on the scene "
+    "one after another instead.\n"
+    "\n"
+    "   :arg frames: The frames to evaluate.\n"
+    "   :type frames: Sequence of float\n"
+    "   :arg callback: Called for every frame in order, with the depsgraph the frame is evaluated "
+    "in and the frame as arguments: ``callback(depsgraph, frame)``. The evaluated data can be "
+    "accessed with :class:`bpy.types.ID.evaluated_get`. The depsgraph must not be accessed once "
+    "the callback returned.\n"
+    "   :type callback: Callable[[:class:`bpy.types.Depsgraph`, float], None]\n"
+    "   :arg depsgraphs_num: The number of frames evaluated at the same time. Every depsgraph "
+    "has its own copy of the evaluated scene, zero uses up to four depsgraphs depending on the "
+    "number of threads.\n"
+    "   :type depsgraphs_num: int\n"
+    "   :return: False when the frames of the scene can't be evaluated separately.\n"
+    "   :rtype: bool\n");
+static PyObject *bpy_rna_view_layer_evaluate_frames(PyObject *self, PyObject *args, PyObject *kwds)
+{
+  using namespace blender;
+  BPy_StructRNA *pyrna = (BPy_StructRNA *)self;
+  ViewLayer *view_layer = static_cast<ViewLayer *>(pyrna->ptr.data);
+  Scene *scene = reinterpret_cast<Scene *>(pyrna->ptr.owner_id);
+
+  PyObject *py_frames;
+  PyObject *py_callback;
+  int depsgraphs_num = 0;
+
+  static const char *_keywords[] = {"frames", "callback", "depsgraphs_num", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "O"  /* `frames` */
+      "O"  /* `callback` */
+      "|$" /* Optional keyword only arguments. */
+      "i"  /* `depsgraphs_num` */
+      ":evaluate_frames",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(
+          args, kwds, &_parser, &py_frames, &py_callback, &depsgraphs_num))
+  {
+    return nullptr;
+  }
+  if (!PyCallable_Check(py_callback)) {
+    PyErr_SetString(PyExc_TypeError, "evaluate_frames: callback must be callable");
+    return nullptr;
+  }
+  if (depsgraphs_num < 0) {
+    PyErr_SetString(PyExc_ValueError, "evaluate_frames: depsgraphs_num must not be negative");
+    return nullptr;
+  }
+
+  PyObject *py_frames_fast = PySequence_Fast(py_frames, "evaluate_frames: expected a sequence");
+  if (py_frames_fast == nullptr) {
+    return nullptr;
+  }
+  Array<float> frames(PySequence_Fast_GET_SIZE(py_frames_fast));
+  const int frames_result = PyC_AsArray_FAST(frames.data(),
+                                             sizeof(float),
+                                             py_frames_fast,
+                                             frames.size(),
+                                             &PyFloat_Type,
+                                             "evaluate_frames: frames");
+  Py_DECREF(py_frames_fast);
+  if (frames_result == -1) {
+    return nullptr;
+  }
+  if (frames.is_empty()) {
+    Py_RETURN_TRUE;
+  }
+
+  if (depsgraphs_num == 0) {
+    depsgraphs_num = std::clamp(BLI_system_thread_count() / 2, 1, 4);
+  }
+  depsgraphs_num = std::min<int>(depsgraphs_num, frames.size());
+
+  Main *bmain = G_MAIN;
+  Array<Depsgraph *> graphs(depsgraphs_num);
+  for (Depsgraph *&graph : graphs) {
+    graph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
+    DEG_graph_build_from_view_layer(graph);
+  }
+
+  bool is_supported = DEG_frame_parallel_evaluation_supported(graphs.first());
+  bool has_error = false;
+  if (is_supported) {
+    /* Release the GIL while frames are evaluated, Python drivers are evaluated in other
+     * threads. It is only held again while the callback runs. */
+    PyThreadState *thread_state = PyEval_SaveThread();
+    DEG_evaluate_frames_parallel(graphs, frames, [&](Depsgraph *depsgraph, const float frame) {
+      PyEval_RestoreThread(thread_state);
+      PointerRNA depsgraph_ptr = RNA_pointer_create(nullptr, &RNA_Depsgraph, depsgraph);
+      PyObject *py_depsgraph = pyrna_struct_CreatePyObject(&depsgraph_ptr);
+      PyObject *result = PyObject_CallFunction(py_callback, "Of", py_depsgraph, frame);
+      Py_DECREF(py_depsgraph);
+      has_error = result == nullptr;
+      Py_XDECREF(result);
+      thread_state = PyEval_SaveThread();
+      return !has_error;
+    });
+    PyEval_RestoreThread(thread_state);
+  }
+
+  for (Depsgraph *graph : graphs) {
+    DEG_graph_free(graph);
+  }
+
+  if (has_error) {
+    return nullptr;
+  }
+  return PyBool_FromLong(is_supported);
+}
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wcast-function-type"
+#endif
+
+PyMethodDef BPY_rna_view_layer_evaluate_frames_method_def = {
+    "evaluate_frames",
+    (PyCFunction)bpy_rna_view_layer_evaluate_frames,
+    METH_VARARGS | METH_KEYWORDS,
+    bpy_rna_view_layer_evaluate_frames_doc,
+};
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic pop
+#endif
+
+/** \} */
@@ -36,6 +36,7 @@
 
 #include "WM_api.hh"
 
+#include "GPU_capabilities.hh"
 #include "GPU_context.hh"
 
 #include "render_types.h"
@@ -81,6 +82,12 @@ class TexturePool : public realtime_compositor::TexturePool {
     Vector<GPUTexture *> &available_textures = available_textures_.lookup_or_add_default(key);
     GPUTexture *texture = nullptr;
     if (available_textures.is_empty()) {
+      /* The textures of the previous evaluation that were not acquired yet would only be freed
+       * after the evaluation. Free them before allocating more when the GPU is low on memory, at
+       * the cost of allocating them again if they are acquired later in the evaluation. */
+      if (is_gpu_memory_low()) {
+        free_available_textures();
+      }
       texture = GPU_texture_create_2d("compositor_texture_pool",
                                       size.x,
                                       size.y,
@@ -104,15 +111,34 @@ class TexturePool : public realtime_compositor::TexturePool {
     /* Free all textures in the available textures vectors. The fact that they still exist in those
      * vectors after evaluation means they were not acquired during the evaluation, and are thus
      * consequently no longer used. */
+    free_available_textures();
+
+    /* Move all textures in-use to be available textures for the next evaluation. */
+    available_textures_ = textures_in_use_;
+    textures_in_use_.clear();
+  }
+
+ private:
+  void free_available_textures()
+  {
     for (Vector<GPUTexture *> &available_textures : available_textures_.values()) {
       for (GPUTexture *texture : available_textures) {
         GPU_texture_free(texture);
       }
+      available_textures.clear();
     }
+  }
 
-    /* Move all textures in-use to be available textures for the next evaluation. */
-    available_textures_ = textures_in_use_;
-    textures_in_use_.clear();
+  /** Less than a tenth of the GPU memory is free, only known for some GPU backends. */
+  static bool is_gpu_memory_low()
+  {
+    if (!GPU_mem_stats_supported()) {
+      return false;
+    }
+    int total_memory = 0;
+    int free_memory = 0;
+    GPU_mem_stats_get(&total_memory, &free_memory);
+    return total_memory > 0 && free_memory < total_memory / 10;
   }
 };
 
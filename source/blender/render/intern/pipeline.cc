@@ -36,6 +36,7 @@
 #include "BLI_rect.h"
 #include "BLI_set.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_time.h"
 #include "BLI_timecode.h"
@@ -2221,6 +2222,33 @@ bool RE_WriteRenderViewsMovie(ReportList *reports,
   return ok;
 }
 
+/** Print the time spent on the frame, and the part of it spent on saving it. */
+static void render_frame_time_print(Render *re, const bool do_write_file)
+{
+  char time_str[FILE_MAX];
+  const double render_time = re->i.lastframetime;
+  re->i.lastframetime = BLI_time_now_seconds() - re->i.starttime;
+
+  BLI_timecode_string_from_time_simple(time_str, sizeof(time_str), re->i.lastframetime);
+  std::string message = fmt::format("Time: {}", time_str);
+
+  if (do_write_file) {
+    BLI_timecode_string_from_time_simple(
+        time_str, sizeof(time_str), re->i.lastframetime - render_time);
+    message = fmt::format("{} (Saving: {})", message, time_str);
+  }
+  printf("%s\n", message.c_str());
+  /* Flush stdout to be sure python callbacks are printing stuff after blender. */
+  fflush(stdout);
+
+  /* NOTE: using G_MAIN seems valid here???
+   * Not sure it's actually even used anyway, we could as well pass nullptr? */
+  render_callback_exec_string(re, G_MAIN, BKE_CB_EVT_RENDER_STATS, message.c_str());
+
+  fputc('\n', stdout);
+  fflush(stdout);
+}
+
 static bool do_write_image_or_movie(Render *re,
                                     Main *bmain,
                                     Scene *scene,
@@ -2230,7 +2258,6 @@ static bool do_write_image_or_movie(Render *re,
 {
   char filepath[FILE_MAX];
   RenderResult rres;
-  double render_time;
   bool ok = true;
   RenderEngineType *re_type = RE_engines_find(re->r.engine);
 
@@ -2268,27 +2295,98 @@ static bool do_write_image_or_movie(Render *re,
     RE_ReleaseResultImageViews(re, &rres);
   }
 
-  render_time = re->i.lastframetime;
-  re->i.lastframetime = BLI_time_now_seconds() - re->i.starttime;
+  render_frame_time_print(re, do_write_file);
 
-  BLI_timecode_string_from_time_simple(filepath, sizeof(filepath), re->i.lastframetime);
-  std::string message = fmt::format("Time: {}", filepath);
+  return ok;
+}
 
-  if (do_write_file) {
-    BLI_timecode_string_from_time_simple(
-        filepath, sizeof(filepath), re->i.lastframetime - render_time);
-    message = fmt::format("{} (Saving: {})", message, filepath);
+/**
+ * An image sequence frame which is written in a background thread while the next frame renders,
+ * see #R_SAVE_ASYNC.
+ */
+struct RenderFrameWrite {
+  Render *re;
+  Scene *scene;
+  /** Copy of the render result of the frame, owned by the write. */
+  RenderResult *rr;
+  char filepath[FILE_MAX];
+  int frame;
+  bool ok;
+};
+
+static void render_frame_write_task(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  RenderFrameWrite *frame_write = static_cast<RenderFrameWrite *>(taskdata);
+  frame_write->ok = BKE_image_render_write(frame_write->re->reports,
+                                           frame_write->rr,
+                                           frame_write->scene,
+                                           true,
+                                           frame_write->filepath);
+}
+
+/**
+ * Wait for the pending frame write and run the write callbacks for it, with the frame of the
+ * scene set to the written frame. Returns false when the write failed.
+ */
+static bool render_frame_write_finish(Render *re,
+                                      TaskPool *pool,
+                                      RenderFrameWrite **frame_write_p)
+{
+  RenderFrameWrite *frame_write = *frame_write_p;
+  if (frame_write == nullptr) {
+    return true;
   }
-  printf("%s\n", message.c_str());
-  /* Flush stdout to be sure python callbacks are printing stuff after blender. */
-  fflush(stdout);
+  BLI_task_pool_work_and_wait(pool);
+  *frame_write_p = nullptr;
 
-  /* NOTE: using G_MAIN seems valid here???
-   * Not sure it's actually even used anyway, we could as well pass nullptr? */
-  render_callback_exec_string(re, G_MAIN, BKE_CB_EVT_RENDER_STATS, message.c_str());
+  const bool ok = frame_write->ok;
+  RE_FreeRenderResult(frame_write->rr);
+  if (ok) {
+    Scene *scene = frame_write->scene;
+    const int cfra = scene->r.cfra;
+    scene->r.cfra = frame_write->frame;
+    render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+    scene->r.cfra = cfra;
+  }
+  MEM_delete(frame_write);
+  return ok;
+}
 
-  fputc('\n', stdout);
-  fflush(stdout);
+/**
+ * Same as #do_write_image_or_movie for image sequences, but only copies the render result of the
+ * frame and writes it in the background. Only one frame is written at a time to bound the memory
+ * usage, so this waits for the write of the previous frame first. Returns false when the write of
+ * the previous frame failed.
+ */
+static bool do_write_image_async(
+    Render *re, Main *bmain, Scene *scene, TaskPool *pool, RenderFrameWrite **frame_write_p)
+{
+  const bool ok = render_frame_write_finish(re, pool, frame_write_p);
+
+  RenderFrameWrite *frame_write = MEM_new<RenderFrameWrite>(__func__);
+  frame_write->re = re;
+  frame_write->scene = scene;
+  frame_write->frame = scene->r.cfra;
+  frame_write->ok = false;
+
+  RenderResult rres;
+  RE_AcquireResultImageViews(re, &rres);
+  frame_write->rr = RE_DuplicateRenderResult(&rres);
+  RE_ReleaseResultImageViews(re, &rres);
+
+  BKE_image_path_from_imformat(frame_write->filepath,
+                               scene->r.pic,
+                               BKE_main_blendfile_path(bmain),
+                               scene->r.cfra,
+                               &scene->r.im_format,
+                               (scene->r.scemode & R_EXTENSION) != 0,
+                               true,
+                               nullptr);
+
+  *frame_write_p = frame_write;
+  BLI_task_pool_push(pool, render_frame_write_task, frame_write, false, nullptr);
+
+  render_frame_time_print(re, true);
 
   return ok;
 }
@@ -2416,6 +2514,13 @@ void RE_RenderAnim(Render *re,
   re->flag |= R_ANIMATION;
   DEG_graph_id_tag_update(re->main, re->pipeline_depsgraph, &re->scene->id, ID_RECALC_AUDIO_MUTE);
 
+  /* Write image sequence frames in a background thread while the next frame renders. */
+  TaskPool *write_pool = nullptr;
+  RenderFrameWrite *frame_write = nullptr;
+  if ((rd.mode & R_SAVE_ASYNC) && !is_movie && do_write_file) {
+    write_pool = BLI_task_pool_create_background(nullptr, TASK_PRIORITY_HIGH);
+  }
+
   scene->r.subframe = 0.0f;
   for (nfra = sfra, scene->r.cfra = sfra; scene->r.cfra <= efra; scene->r.cfra++) {
     char filepath[FILE_MAX];
@@ -2536,7 +2641,12 @@ void RE_RenderAnim(Render *re,
     const bool should_write = !(re->flag & R_SKIP_WRITE);
     if (re->test_break_cb(re->tbh) == 0) {
       if (!G.is_break && should_write) {
-        if (!do_write_image_or_movie(re, bmain, scene, mh, totvideos, nullptr)) {
+        if (write_pool) {
+          if (!do_write_image_async(re, bmain, scene, write_pool, &frame_write)) {
+            G.is_break = true;
+          }
+        }
+        else if (!do_write_image_or_movie(re, bmain, scene, mh, totvideos, nullptr)) {
           G.is_break = true;
         }
       }
@@ -2580,12 +2690,21 @@ void RE_RenderAnim(Render *re,
     if (G.is_break == false) {
       /* keep after file save */
       render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_POST);
-      if (should_write) {
+      /* With background writing, the callbacks run once the frame is written. */
+      if (should_write && write_pool == nullptr) {
         render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
       }
     }
   }
 
+  if (write_pool) {
+    /* Always finish writing the last frame, also when the render is canceled. */
+    if (!render_frame_write_finish(re, write_pool, &frame_write)) {
+      G.is_break = true;
+    }
+    BLI_task_pool_free(write_pool);
+  }
+
   /* end movie */
   if (is_movie && do_write_file) {
     re_movie_free_all(re, mh, totvideos);
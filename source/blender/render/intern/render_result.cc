@@ -19,8 +19,10 @@
 #include "BLI_rect.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_appdir.hh"
 #include "BKE_global.hh"
@@ -379,16 +381,29 @@ void render_result_passes_allocated_ensure(RenderResult *rr)
     return;
   }
 
+  blender::Vector<RenderPass *> passes;
   LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
     LISTBASE_FOREACH (RenderPass *, rp, &rl->passes) {
       if (rl->exrhandle != nullptr && !STREQ(rp->name, RE_PASSNAME_COMBINED)) {
         continue;
       }
 
-      render_layer_allocate_pass(rr, rp);
+      passes.append(rp);
     }
   }
 
+  /* Results with many view layers, views and utility passes (AOVs, cryptomatte) have many
+   * passes, allocate and initialize them in parallel. Isolate the tasks since the result mutex
+   * is usually locked by the caller. */
+  blender::threading::isolate_task([&]() {
+    blender::threading::parallel_for(
+        passes.index_range(), 1, [&](const blender::IndexRange range) {
+          for (const int64_t i : range) {
+            render_layer_allocate_pass(rr, passes[i]);
+          }
+        });
+  });
+
   rr->passes_allocated = true;
 }
 
@@ -804,6 +819,9 @@ static void do_merge_tile(
 
 void render_result_merge(RenderResult *rr, RenderResult *rrpart)
 {
+  /* Target and tile buffers of the passes to merge. */
+  blender::Vector<std::pair<RenderPass *, RenderPass *>> passes;
+
   LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
     RenderLayer *rlp = RE_GetRenderLayer(rrpart, rl->name);
 
@@ -828,17 +846,33 @@ void render_result_merge(RenderResult *rr, RenderResult *rrpart)
           continue;
         }
 
-        do_merge_tile(rr,
-                      rrpart,
-                      rpass->ibuf->float_buffer.data,
-                      rpassp->ibuf->float_buffer.data,
-                      rpass->channels);
+        passes.append({rpass, rpassp});
 
         /* manually get next render pass */
         rpassp = rpassp->next;
       }
     }
   }
+
+  const auto merge_passes = [&](const blender::IndexRange range) {
+    for (const int64_t i : range) {
+      const auto [rpass, rpassp] = passes[i];
+      do_merge_tile(rr,
+                    rrpart,
+                    rpass->ibuf->float_buffer.data,
+                    rpassp->ibuf->float_buffer.data,
+                    rpass->channels);
+    }
+  };
+
+  /* Merging small tiles is faster without threading. Isolate the tasks since the result mutex is
+   * usually locked by the caller. */
+  if (size_t(rrpart->rectx) * size_t(rrpart->recty) * size_t(passes.size()) < 256 * 256) {
+    merge_passes(passes.index_range());
+    return;
+  }
+  blender::threading::isolate_task(
+      [&]() { blender::threading::parallel_for(passes.index_range(), 1, merge_passes); });
 }
 
 /** \} */
@@ -27,6 +27,11 @@ bool SEQ_proxy_rebuild_context(Main *bmain,
                                ListBase *queue,
                                bool build_only_on_bad_performance);
 void SEQ_proxy_rebuild(SeqIndexBuildContext *context, wmJobWorkerStatus *worker_status);
+/**
+ * Movie proxies and timecodes are built from their own decoder, without rendering the strip, so
+ * they can be built at the same time as other such contexts.
+ */
+bool SEQ_proxy_rebuild_is_threadsafe(const SeqIndexBuildContext *context);
 void SEQ_proxy_rebuild_finish(SeqIndexBuildContext *context, bool stop);
 void SEQ_proxy_set(Sequence *seq, bool value);
 bool SEQ_can_use_proxy(const SeqRenderData *context, const Sequence *seq, int psize);
@@ -8,6 +8,8 @@
  * \ingroup sequencer
  */
 
+#include "BLI_vector.hh"
+
 #include "DNA_scene_types.h"
 
 struct BlendDataReader;
@@ -119,8 +121,10 @@ void SEQ_eval_sequences(Depsgraph *depsgraph, Scene *scene, ListBase *seqbase);
 
 enum eSequenceLookupTag {
   SEQ_LOOKUP_TAG_INVALID = (1 << 0),
+  /** Frame ranges of strips changed, the strip range index is rebuilt. */
+  SEQ_LOOKUP_TAG_RANGES = (1 << 1),
 };
-ENUM_OPERATORS(eSequenceLookupTag, SEQ_LOOKUP_TAG_INVALID)
+ENUM_OPERATORS(eSequenceLookupTag, SEQ_LOOKUP_TAG_RANGES)
 
 /**
  * Find a sequence with a given name.
@@ -134,6 +138,20 @@ ENUM_OPERATORS(eSequenceLookupTag, SEQ_LOOKUP_TAG_INVALID)
  */
 Sequence *SEQ_sequence_lookup_seq_by_name(const Scene *scene, const char *key);
 
+/**
+ * Find strips of \a seqbase whose handles or content overlap the frame range
+ * `[frame_start, frame_end)`, in the order of the list. The strips are found in an interval index
+ * which is built on first use and rebuilt after strip frame ranges change.
+ *
+ * Callers filter the result further, the content of a strip may extend past its handles.
+ *
+ * \param scene: scene that owns lookup hash
+ */
+blender::Vector<Sequence *> SEQ_sequence_lookup_strips_in_range(const Scene *scene,
+                                                               const ListBase *seqbase,
+                                                               int frame_start,
+                                                               int frame_end);
+
 /**
  * Free lookup hash data.
  *
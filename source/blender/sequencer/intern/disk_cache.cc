@@ -26,6 +26,7 @@
 #include "BLI_fileops_types.h"
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_main.hh"
@@ -44,8 +45,9 @@
  * For each cached non-temp image, image data and supplementary info are written to HDD.
  * Multiple(DCACHE_IMAGES_PER_FILE) images share the same file.
  * Each of these files contains header DiskCacheHeader followed by image data.
- * ZLIB compression with user definable level can be used to compress image data(per image)
- * Images are written in order in which they are rendered.
+ * ZSTD compression with user definable level can be used to compress image data(per image)
+ * Images are written in order in which they are rendered, from a background task so that
+ * compression and file IO do not block rendering. The image stays referenced until written.
  * Overwriting of individual entry is not possible.
  * Stored images are deleted by invalidation, or when size of all files exceeds maximum
  * size specified in user preferences.
@@ -79,6 +81,8 @@ struct SeqDiskCache {
   ListBase files;
   ThreadMutex read_write_mutex;
   size_t size_total;
+  /** Serial background pool which writes and compresses images, see #DiskCacheWriteTask. */
+  TaskPool *write_pool;
 };
 
 struct DiskCacheFile {
@@ -403,6 +407,10 @@ void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
   int start;
   int end;
 
+  /* Drop the queued writes instead of waiting for them, they may store invalidated images. Images
+   * that are still valid are written again when they are rendered after being evicted. */
+  BLI_task_pool_cancel(disk_cache->write_pool);
+
   BLI_mutex_lock(&disk_cache->read_write_mutex);
 
   start = SEQ_time_left_handle_frame_get(scene, seq_changed) - DCACHE_IMAGES_PER_FILE;
@@ -478,7 +486,9 @@ static size_t seq_disk_cache_write_header(FILE *file, const DiskCacheHeader *hea
   return fwrite(header, sizeof(*header), 1, file);
 }
 
-static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCacheHeader *header)
+static int seq_disk_cache_add_header_entry(const float frame_index,
+                                           ImBuf *ibuf,
+                                           DiskCacheHeader *header)
 {
   int i;
   uint64_t offset = sizeof(*header);
@@ -511,7 +521,7 @@ static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCa
   }
 
   header->entry[i].offset = offset;
-  header->entry[i].frameno = key->frame_index;
+  header->entry[i].frameno = frame_index;
 
   /* Store colorspace name of ibuf. */
   const char *colorspace_name;
@@ -539,13 +549,13 @@ static int seq_disk_cache_get_header_entry(SeqCacheKey *key, const DiskCacheHead
   return -1;
 }
 
-bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+static bool seq_disk_cache_write_file_ex(SeqDiskCache *disk_cache,
+                                         const char *filepath,
+                                         const float frame_index,
+                                         ImBuf *ibuf)
 {
   BLI_mutex_lock(&disk_cache->read_write_mutex);
 
-  char filepath[FILE_MAX];
-
-  seq_disk_cache_get_file_path(disk_cache, key, filepath, sizeof(filepath));
   BLI_file_ensure_parent_dir_exists(filepath);
 
   /* Touch the file. */
@@ -570,7 +580,7 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return false;
   }
-  int entry_index = seq_disk_cache_add_header_entry(key, ibuf, &header);
+  int entry_index = seq_disk_cache_add_header_entry(frame_index, ibuf, &header);
 
   size_t bytes_written = deflate_imbuf_to_file(
       ibuf, file, seq_disk_cache_compression_level(), &header.entry[entry_index]);
@@ -592,6 +602,53 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
   return false;
 }
 
+/**
+ * Image queued for writing. The file path is resolved when the write is queued, because the
+ * cache key and the strip it points to may be freed before the task runs.
+ */
+struct DiskCacheWriteTask {
+  char filepath[FILE_MAX];
+  float frame_index;
+  ImBuf *ibuf;
+};
+
+static void seq_disk_cache_write_task_free(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  DiskCacheWriteTask *write_task = static_cast<DiskCacheWriteTask *>(taskdata);
+  IMB_freeImBuf(write_task->ibuf);
+  MEM_freeN(write_task);
+}
+
+static void seq_disk_cache_write_task(TaskPool *__restrict pool, void *taskdata)
+{
+  SeqDiskCache *disk_cache = static_cast<SeqDiskCache *>(BLI_task_pool_user_data(pool));
+  DiskCacheWriteTask *write_task = static_cast<DiskCacheWriteTask *>(taskdata);
+  if (BLI_task_pool_current_canceled(pool)) {
+    return;
+  }
+  seq_disk_cache_write_file_ex(
+      disk_cache, write_task->filepath, write_task->frame_index, write_task->ibuf);
+  seq_disk_cache_enforce_limits(disk_cache);
+}
+
+void seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+{
+  DiskCacheWriteTask *write_task = static_cast<DiskCacheWriteTask *>(
+      MEM_mallocN(sizeof(DiskCacheWriteTask), __func__));
+  seq_disk_cache_get_file_path(
+      disk_cache, key, write_task->filepath, sizeof(write_task->filepath));
+  write_task->frame_index = key->frame_index;
+  /* Cached images are not modified, so the image can be compressed while it is in use. */
+  IMB_refImBuf(ibuf);
+  write_task->ibuf = ibuf;
+
+  BLI_task_pool_push(disk_cache->write_pool,
+                     seq_disk_cache_write_task,
+                     write_task,
+                     true,
+                     seq_disk_cache_write_task_free);
+}
+
 ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
 {
   BLI_mutex_lock(&disk_cache->read_write_mutex);
@@ -668,6 +725,7 @@ SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene)
       MEM_callocN(sizeof(SeqDiskCache), "SeqDiskCache"));
   disk_cache->bmain = bmain;
   BLI_mutex_init(&disk_cache->read_write_mutex);
+  disk_cache->write_pool = BLI_task_pool_create_background_serial(disk_cache, TASK_PRIORITY_LOW);
   seq_disk_cache_handle_versioning(disk_cache);
   seq_disk_cache_get_files(disk_cache, seq_disk_cache_base_dir());
   disk_cache->timestamp = scene->ed->disk_cache_timestamp;
@@ -677,6 +735,8 @@ SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene)
 
 void seq_disk_cache_free(SeqDiskCache *disk_cache)
 {
+  /* Finish the queued writes, so the cache is complete when the file is opened again. */
+  BLI_task_pool_free(disk_cache->write_pool);
   BLI_freelistN(&disk_cache->files);
   BLI_mutex_end(&disk_cache->read_write_mutex);
   MEM_freeN(disk_cache);
@@ -20,6 +20,7 @@
 #include "SEQ_iterator.hh"
 #include "SEQ_relations.hh"
 #include "SEQ_render.hh"
+#include "SEQ_sequencer.hh"
 #include "SEQ_time.hh"
 
 using blender::VectorSet;
@@ -137,7 +138,9 @@ static VectorSet<Sequence *> query_strips_at_frame(const Scene *scene,
 {
   VectorSet<Sequence *> strips;
 
-  LISTBASE_FOREACH (Sequence *, strip, seqbase) {
+  for (Sequence *strip :
+       SEQ_sequence_lookup_strips_in_range(scene, seqbase, timeline_frame, timeline_frame + 1))
+  {
     if (SEQ_time_strip_intersects_frame(scene, strip, timeline_frame)) {
       strips.add(strip);
     }
@@ -8,12 +8,22 @@
  * \ingroup bke
  */
 
+#include <algorithm>
+#include <atomic>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 
+#include "BLI_array.hh"
+#include "BLI_task.h"
+#include "BLI_threads.h"
+#include "BLI_time.h"
+#include "BLI_vector.hh"
+
 #include "BKE_context.hh"
+#include "BKE_global.hh"
 
 #include "SEQ_proxy.hh"
 #include "SEQ_relations.hh"
@@ -31,15 +41,95 @@ static void proxy_freejob(void *pjv)
   MEM_freeN(pj);
 }
 
+struct ProxyBuildTask {
+  SeqIndexBuildContext *context;
+  /** Status of this build only, #wmJobWorkerStatus::stop is copied from the job. */
+  wmJobWorkerStatus status;
+};
+
+struct ProxyBuildPool {
+  blender::Array<ProxyBuildTask> tasks;
+  /** Index of the next task to start. */
+  std::atomic<int> next_task = 0;
+  /** Number of pool tasks that found no task left to start. */
+  std::atomic<int> finished_workers = 0;
+};
+
+static void proxy_build_pool_worker(TaskPool *__restrict pool, void * /*taskdata*/)
+{
+  ProxyBuildPool *build_pool = static_cast<ProxyBuildPool *>(BLI_task_pool_user_data(pool));
+  for (int i = build_pool->next_task++; i < build_pool->tasks.size(); i = build_pool->next_task++)
+  {
+    ProxyBuildTask &task = build_pool->tasks[i];
+    if (!task.status.stop) {
+      SEQ_proxy_rebuild(task.context, &task.status);
+    }
+    task.status.progress = 1.0f;
+  }
+  build_pool->finished_workers++;
+}
+
+/**
+ * Build the movie proxies and timecodes of several strips at the same time. Every movie is read
+ * by its own decoder which writes all proxy sizes and timecodes in one pass, decoding and encoding
+ * use several threads each already, so only a few movies are built at once to keep disk access
+ * mostly sequential. Progress and cancellation are passed between the job and the builds here.
+ */
+static void proxy_build_parallel(blender::Span<SeqIndexBuildContext *> contexts,
+                                 wmJobWorkerStatus *worker_status)
+{
+  ProxyBuildPool build_pool;
+  build_pool.tasks.reinitialize(contexts.size());
+  for (const int i : contexts.index_range()) {
+    build_pool.tasks[i].context = contexts[i];
+    build_pool.tasks[i].status = {};
+  }
+
+  const int workers_num = std::clamp<int>(
+      std::min<int>(BLI_system_thread_count() / 4, contexts.size()), 1, 4);
+  TaskPool *task_pool = BLI_task_pool_create_background(&build_pool, TASK_PRIORITY_LOW);
+  for (int i = 0; i < workers_num; i++) {
+    BLI_task_pool_push(task_pool, proxy_build_pool_worker, nullptr, false, nullptr);
+  }
+
+  while (build_pool.finished_workers < workers_num) {
+    BLI_time_sleep_ms(50);
+    const bool stop = worker_status->stop || G.is_break;
+    float progress = 0.0f;
+    for (ProxyBuildTask &task : build_pool.tasks) {
+      task.status.stop = stop;
+      progress += task.status.progress;
+    }
+    worker_status->progress = progress / build_pool.tasks.size();
+    worker_status->do_update = true;
+  }
+
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
+}
+
 /* Only this runs inside thread. */
 static void proxy_startjob(void *pjv, wmJobWorkerStatus *worker_status)
 {
   ProxyJob *pj = static_cast<ProxyJob *>(pjv);
 
+  blender::Vector<SeqIndexBuildContext *> threadsafe_contexts;
+  LISTBASE_FOREACH (LinkData *, link, &pj->queue) {
+    SeqIndexBuildContext *context = static_cast<SeqIndexBuildContext *>(link->data);
+    if (SEQ_proxy_rebuild_is_threadsafe(context)) {
+      threadsafe_contexts.append(context);
+    }
+  }
+  if (!threadsafe_contexts.is_empty()) {
+    proxy_build_parallel(threadsafe_contexts, worker_status);
+  }
+
   LISTBASE_FOREACH (LinkData *, link, &pj->queue) {
     SeqIndexBuildContext *context = static_cast<SeqIndexBuildContext *>(link->data);
 
-    SEQ_proxy_rebuild(context, worker_status);
+    if (!worker_status->stop && !SEQ_proxy_rebuild_is_threadsafe(context)) {
+      SEQ_proxy_rebuild(context, worker_status);
+    }
 
     if (worker_status->stop) {
       pj->stop = true;
@@ -25,6 +25,7 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
+#include "BLI_task.hh"
 
 #include "BKE_anim_data.hh"
 #include "BKE_animsys.h"
@@ -635,40 +636,38 @@ static void sequencer_preprocess_transform_crop(
 
 static void multibuf(ImBuf *ibuf, const float fmul, const bool multiply_alpha)
 {
-  uchar *rt;
-  float *rt_float;
+  using namespace blender;
+  const IndexRange pixels(IMB_get_rect_len(ibuf));
 
-  int a;
-
-  rt = ibuf->byte_buffer.data;
-  rt_float = ibuf->float_buffer.data;
-
-  if (rt) {
+  if (uchar *rect = ibuf->byte_buffer.data) {
     const int imul = int(256.0f * fmul);
-    a = ibuf->x * ibuf->y;
-    while (a--) {
-      rt[0] = min_ii((imul * rt[0]) >> 8, 255);
-      rt[1] = min_ii((imul * rt[1]) >> 8, 255);
-      rt[2] = min_ii((imul * rt[2]) >> 8, 255);
-      if (multiply_alpha) {
-        rt[3] = min_ii((imul * rt[3]) >> 8, 255);
+    threading::parallel_for(pixels, 64 * 1024, [&](const IndexRange range) {
+      for (uchar *rt = rect + range.first() * 4, *rt_end = rt + range.size() * 4; rt < rt_end;
+           rt += 4)
+      {
+        rt[0] = min_ii((imul * rt[0]) >> 8, 255);
+        rt[1] = min_ii((imul * rt[1]) >> 8, 255);
+        rt[2] = min_ii((imul * rt[2]) >> 8, 255);
+        if (multiply_alpha) {
+          rt[3] = min_ii((imul * rt[3]) >> 8, 255);
+        }
       }
-
-      rt += 4;
-    }
-  }
-  if (rt_float) {
-    a = ibuf->x * ibuf->y;
-    while (a--) {
-      rt_float[0] *= fmul;
-      rt_float[1] *= fmul;
-      rt_float[2] *= fmul;
-      if (multiply_alpha) {
-        rt_float[3] *= fmul;
+    });
+  }
+  if (float *rect_float = ibuf->float_buffer.data) {
+    threading::parallel_for(pixels, 64 * 1024, [&](const IndexRange range) {
+      for (float *rt = rect_float + range.first() * 4, *rt_end = rt + range.size() * 4;
+           rt < rt_end;
+           rt += 4)
+      {
+        rt[0] *= fmul;
+        rt[1] *= fmul;
+        rt[2] *= fmul;
+        if (multiply_alpha) {
+          rt[3] *= fmul;
+        }
       }
-
-      rt_float += 4;
-    }
+    });
   }
 }
 
@@ -9,6 +9,10 @@
 #include "SEQ_sequencer.hh"
 #include "sequencer.hh"
 
+#include "SEQ_animation.hh"
+#include "SEQ_time.hh"
+
+#include "DNA_anim_types.h"
 #include "DNA_listBase.h"
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
@@ -16,8 +20,12 @@
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
+#include "BLI_math_base.h"
+#include "BLI_sort.hh"
+#include "BLI_string.h"
 #include "BLI_sys_types.h"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 #include "BLI_vector_set.hh"
 
 #include <cstring>
@@ -26,10 +34,45 @@
 
 static ThreadMutex lookup_lock = BLI_MUTEX_INITIALIZER;
 
+/**
+ * Frame range of a strip in a #StripRangeIndex, covering both the handles and the content, so
+ * still frames and content outside of the handles which is drawn in the timeline are included.
+ */
+struct StripRange {
+  int start;
+  int end;
+  /** Largest #end in the sub-tree of this range in the implicit tree. */
+  int max_end;
+  /** Position of the strip in the list, to return strips in list order. */
+  int list_index;
+  Sequence *seq;
+};
+
+/**
+ * Static interval tree over the strip ranges of one list of strips. Ranges are sorted by their
+ * start, and the sorted array is used as an implicit balanced binary tree: leaves are at even
+ * indices, and the node at level `k` covers `2^(k+1) - 1` consecutive ranges around its index.
+ * Every node stores the largest end of its sub-tree, so whole sub-trees which end before a query
+ * are skipped. Finding the strips at a frame is `O(log(n) + k)` instead of a scan of all strips.
+ */
+struct StripRangeIndex {
+  blender::Vector<StripRange> ranges;
+  int max_level = -1;
+  /**
+   * List bounds at the time the index was built. Strips are appended to lists in many places
+   * (duplication, pasting, un-grouping of meta strips), a changed list is detected by these
+   * without every such place having to tag the lookup.
+   */
+  const void *seqbase_first = nullptr;
+  const void *seqbase_last = nullptr;
+};
+
 struct SequenceLookup {
   GHash *seq_by_name;
   GHash *meta_by_seq;
   blender::Map<const Sequence *, blender::VectorSet<Sequence *>> effects_by_seq;
+  /** Built on demand for every list of strips which is queried, see #SEQ_LOOKUP_TAG_RANGES. */
+  blender::Map<const ListBase *, StripRangeIndex> ranges_by_seqbase;
   eSequenceLookupTag tag;
 };
 
@@ -124,12 +167,162 @@ static void seq_sequence_lookup_update_if_needed(const Scene *scene, SequenceLoo
     return;
   }
   if (*lookup && seq_sequence_lookup_is_valid(*lookup)) {
+    if ((*lookup)->tag & SEQ_LOOKUP_TAG_RANGES) {
+      (*lookup)->ranges_by_seqbase.clear();
+      (*lookup)->tag &= ~SEQ_LOOKUP_TAG_RANGES;
+    }
     return;
   }
 
   seq_sequence_lookup_rebuild(scene, lookup);
 }
 
+static void strip_range_index_build(const Scene *scene,
+                                    const ListBase *seqbase,
+                                    StripRangeIndex &index)
+{
+  index.seqbase_first = seqbase->first;
+  index.seqbase_last = seqbase->last;
+
+  int list_index = 0;
+  LISTBASE_FOREACH (Sequence *, seq, seqbase) {
+    StripRange range;
+    range.start = min_ii(SEQ_time_left_handle_frame_get(scene, seq),
+                         int(SEQ_time_start_frame_get(seq)));
+    range.end = max_ii(SEQ_time_right_handle_frame_get(scene, seq),
+                       int(SEQ_time_content_end_frame_get(scene, seq)));
+    range.max_end = range.end;
+    range.list_index = list_index++;
+    range.seq = seq;
+    index.ranges.append(range);
+  }
+
+  blender::parallel_sort(
+      index.ranges.begin(), index.ranges.end(), [](const StripRange &a, const StripRange &b) {
+        return a.start < b.start;
+      });
+
+  blender::MutableSpan<StripRange> ranges = index.ranges;
+  const int size = ranges.size();
+  if (size == 0) {
+    index.max_level = -1;
+    return;
+  }
+
+  /* Leaves are at even indices. Nodes of every level take the largest end of their children, the
+   * right child of the last node of a level may be past the end of the array, in that case the
+   * largest end of the last nodes (#last_max_end of #last_index) is used. */
+  int last_index = 0;
+  int last_max_end = 0;
+  for (int i = 0; i < size; i += 2) {
+    last_index = i;
+    last_max_end = ranges[i].end;
+  }
+  int level = 1;
+  for (; (1 << level) <= size; level++) {
+    const int half_width = 1 << (level - 1);
+    for (int i = (half_width << 1) - 1; i < size; i += half_width << 2) {
+      const int left_max_end = ranges[i - half_width].max_end;
+      const int right_max_end = (i + half_width < size) ? ranges[i + half_width].max_end :
+                                                          last_max_end;
+      ranges[i].max_end = max_iii(ranges[i].end, left_max_end, right_max_end);
+    }
+    last_index = ((last_index >> level) & 1) ? last_index - half_width : last_index + half_width;
+    if (last_index < size) {
+      last_max_end = max_ii(last_max_end, ranges[last_index].max_end);
+    }
+  }
+  index.max_level = level - 1;
+}
+
+/** Add ranges of \a index overlapping `[frame_start, frame_end)` to \a r_ranges. */
+static void strip_range_index_query(const StripRangeIndex &index,
+                                    const int frame_start,
+                                    const int frame_end,
+                                    blender::Vector<const StripRange *> &r_ranges)
+{
+  struct StackItem {
+    int index;
+    int level;
+    bool left_done;
+  };
+
+  const blender::Span<StripRange> ranges = index.ranges;
+  const int size = ranges.size();
+  if (index.max_level < 0) {
+    return;
+  }
+
+  blender::Vector<StackItem, 64> stack;
+  stack.append({(1 << index.max_level) - 1, index.max_level, false});
+  while (!stack.is_empty()) {
+    const StackItem item = stack.pop_last();
+    if (item.level <= 3) {
+      /* Scan small sub-trees linearly. */
+      const int i_start = item.index >> item.level << item.level;
+      const int i_end = std::min(i_start + (1 << (item.level + 1)) - 1, size);
+      for (int i = i_start; i < i_end && ranges[i].start < frame_end; i++) {
+        if (frame_start < ranges[i].end) {
+          r_ranges.append(&ranges[i]);
+        }
+      }
+    }
+    else if (!item.left_done) {
+      /* Visit the left child first, it may be past the end of the array for the last nodes. */
+      const int left = item.index - (1 << (item.level - 1));
+      stack.append({item.index, item.level, true});
+      if (left >= size || ranges[left].max_end > frame_start) {
+        stack.append({left, item.level - 1, false});
+      }
+    }
+    else if (item.index < size && ranges[item.index].start < frame_end) {
+      /* Ranges to the right start later, they are only visited when this one starts in time. */
+      if (frame_start < ranges[item.index].end) {
+        r_ranges.append(&ranges[item.index]);
+      }
+      stack.append({item.index + (1 << (item.level - 1)), item.level - 1, false});
+    }
+  }
+}
+
+/**
+ * Animated timing properties change strip ranges on frame changes without tagging the lookup, the
+ * index is not used in that case.
+ */
+static bool strip_ranges_are_animated(const Scene *scene)
+{
+  const char *prefix = "sequence_editor.sequences_all[";
+  const char *timing_properties[] = {"].frame_", "].animation_offset_", "].speed_factor"};
+  const auto is_timing_path = [&](const FCurve *fcu) {
+    if (fcu->rna_path == nullptr || !STRPREFIX(fcu->rna_path, prefix)) {
+      return false;
+    }
+    for (const char *property : timing_properties) {
+      if (strstr(fcu->rna_path, property)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  Scene *scene_mut = const_cast<Scene *>(scene);
+  if (SEQ_animation_curves_exist(scene_mut)) {
+    LISTBASE_FOREACH (const FCurve *, fcu, &scene->adt->action->curves) {
+      if (is_timing_path(fcu)) {
+        return true;
+      }
+    }
+  }
+  if (SEQ_animation_drivers_exist(scene_mut)) {
+    LISTBASE_FOREACH (const FCurve *, fcu, &scene->adt->drivers) {
+      if (is_timing_path(fcu)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 void SEQ_sequence_lookup_free(const Scene *scene)
 {
   BLI_assert(scene->ed);
@@ -173,6 +366,50 @@ blender::Span<Sequence *> seq_sequence_lookup_effects_by_seq(const Scene *scene,
   return effects.as_span();
 }
 
+blender::Vector<Sequence *> SEQ_sequence_lookup_strips_in_range(const Scene *scene,
+                                                               const ListBase *seqbase,
+                                                               const int frame_start,
+                                                               const int frame_end)
+{
+  BLI_assert(scene->ed);
+  blender::Vector<Sequence *> strips;
+
+  if (strip_ranges_are_animated(scene)) {
+    LISTBASE_FOREACH (Sequence *, seq, seqbase) {
+      const int start = min_ii(SEQ_time_left_handle_frame_get(scene, seq),
+                               int(SEQ_time_start_frame_get(seq)));
+      const int end = max_ii(SEQ_time_right_handle_frame_get(scene, seq),
+                             int(SEQ_time_content_end_frame_get(scene, seq)));
+      if (start < frame_end && frame_start < end) {
+        strips.append(seq);
+      }
+    }
+    return strips;
+  }
+
+  BLI_mutex_lock(&lookup_lock);
+  seq_sequence_lookup_update_if_needed(scene, &scene->ed->runtime.sequence_lookup);
+  SequenceLookup *lookup = scene->ed->runtime.sequence_lookup;
+  StripRangeIndex &index = lookup->ranges_by_seqbase.lookup_or_add_default(seqbase);
+  if (index.max_level == -1 || index.seqbase_first != seqbase->first ||
+      index.seqbase_last != seqbase->last)
+  {
+    index = {};
+    strip_range_index_build(scene, seqbase, index);
+  }
+
+  blender::Vector<const StripRange *> ranges;
+  strip_range_index_query(index, frame_start, frame_end, ranges);
+  std::sort(ranges.begin(), ranges.end(), [](const StripRange *a, const StripRange *b) {
+    return a->list_index < b->list_index;
+  });
+  for (const StripRange *range : ranges) {
+    strips.append(range->seq);
+  }
+  BLI_mutex_unlock(&lookup_lock);
+  return strips;
+}
+
 void SEQ_sequence_lookup_tag(const Scene *scene, eSequenceLookupTag tag)
 {
   if (!scene->ed) {
@@ -112,6 +112,7 @@ static void sequence_invalidate_cache(Scene *scene,
   }
 
   blender::seq::media_presence_invalidate_strip(scene, seq);
+  SEQ_sequence_lookup_tag(scene, SEQ_LOOKUP_TAG_RANGES);
   sequence_do_invalidate_dependent(scene, seq, &ed->seqbase);
   DEG_id_tag_update(&scene->id, ID_RECALC_SEQUENCER_STRIPS);
   SEQ_prefetch_stop(scene);
@@ -153,6 +154,7 @@ void SEQ_relations_invalidate_cache_in_range(Scene *scene,
                                              int invalidate_types)
 {
   seq_cache_cleanup_sequence(scene, seq, range_mask, invalidate_types, true);
+  SEQ_sequence_lookup_tag(scene, SEQ_LOOKUP_TAG_RANGES);
   seq_relations_find_and_invalidate_metas(scene, seq, nullptr);
 }
 
@@ -160,6 +160,9 @@ void seq_update_sound_bounds_recursive(const Scene *scene, Sequence *metaseq)
 
 void SEQ_time_update_meta_strip_range(const Scene *scene, Sequence *seq_meta)
 {
+  /* Called after the timing of any strip changed, also for strips which are not in meta-strips. */
+  SEQ_sequence_lookup_tag(scene, SEQ_LOOKUP_TAG_RANGES);
+
   if (seq_meta == nullptr) {
     return;
   }
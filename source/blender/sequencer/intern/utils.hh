@@ -13,4 +13,6 @@ struct Scene;
 
 bool sequencer_seq_generates_image(Sequence *seq);
 void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile);
+/** #ImBuf flags movie strips are opened with. */
+int seq_open_anim_flags_get(const Sequence *seq);
 Sequence *SEQ_get_meta_by_seqbase(ListBase *seqbase_main, ListBase *meta_seqbase);
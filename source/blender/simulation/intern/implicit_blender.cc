@@ -17,9 +17,12 @@
 #  include "DNA_scene_types.h"
 #  include "DNA_texture_types.h"
 
+#  include "BLI_array.hh"
+#  include "BLI_index_range.hh"
 #  include "BLI_math_geom.h"
 #  include "BLI_math_matrix.h"
 #  include "BLI_math_vector.h"
+#  include "BLI_task.hh"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.hh"
@@ -32,9 +35,14 @@
 #    pragma GCC diagnostic ignored "-Wtype-limits"
 #  endif
 
-#  ifdef _OPENMP
-#    define CLOTH_OPENMP_LIMIT 512
-#  endif
+/* Number of vertices processed together by the threads working on long vectors. */
+#  define CLOTH_VERTS_GRAIN_SIZE 1024
+/**
+ * Size of the chunks of long vectors that are summed up separately. It must not depend on the
+ * number of threads: floating point addition is not associative, and the simulation has to give
+ * the same results every time it is run.
+ */
+#  define CLOTH_VERTS_SUM_CHUNK_SIZE 1024
 
 // #define DEBUG_TIME
 
@@ -173,15 +181,26 @@ DO_INLINE void submul_lfvectorS(float (*to)[3], float (*fLongVector)[3], float s
 /* dot product for big vector */
 DO_INLINE float dot_lfvector(float (*fLongVectorA)[3], float (*fLongVectorB)[3], uint verts)
 {
-  long i = 0;
-  float temp = 0.0;
-  /* XXX brecht, disabled this for now (first schedule line was already disabled),
-   * due to non-commutative nature of floating point ops this makes the sim give
-   * different results each time you run it!
-   * schedule(guided, 2) */
-  // #pragma omp parallel for reduction(+: temp) if (verts > CLOTH_OPENMP_LIMIT)
-  for (i = 0; i < long(verts); i++) {
-    temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+  using namespace blender;
+  /* Sum up chunks of a fixed size in parallel, and then the sums of the chunks in order, so that
+   * the order of the additions doesn't depend on the scheduling of the threads. */
+  const IndexRange all_verts(verts);
+  const int64_t chunks_num = divide_ceil_u(verts, CLOTH_VERTS_SUM_CHUNK_SIZE);
+  Array<float> chunk_sums(chunks_num);
+  threading::parallel_for(chunk_sums.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      float temp = 0.0f;
+      const IndexRange chunk_verts = all_verts.drop_front(chunk * CLOTH_VERTS_SUM_CHUNK_SIZE)
+                                         .take_front(CLOTH_VERTS_SUM_CHUNK_SIZE);
+      for (const int64_t i : chunk_verts) {
+        temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+      }
+      chunk_sums[chunk] = temp;
+    }
+  });
+  float temp = 0.0f;
+  for (const float chunk_sum : chunk_sums) {
+    temp += chunk_sum;
   }
   return temp;
 }
@@ -201,11 +220,12 @@ DO_INLINE void add_lfvector_lfvector(float (*to)[3],
 DO_INLINE void add_lfvector_lfvectorS(
     float (*to)[3], float (*fLongVectorA)[3], float (*fLongVectorB)[3], float bS, uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
-  }
+  using namespace blender;
+  threading::parallel_for(IndexRange(verts), CLOTH_VERTS_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
+    }
+  });
 }
 /* `A = B * float + C * float` -> for big vector */
 DO_INLINE void add_lfvectorS_lfvectorS(float (*to)[3],
@@ -215,11 +235,12 @@ DO_INLINE void add_lfvectorS_lfvectorS(float (*to)[3],
                                        float bS,
                                        uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    VECADDSS(to[i], fLongVectorA[i], aS, fLongVectorB[i], bS);
-  }
+  using namespace blender;
+  threading::parallel_for(IndexRange(verts), CLOTH_VERTS_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      VECADDSS(to[i], fLongVectorA[i], aS, fLongVectorB[i], bS);
+    }
+  });
 }
 /* `A = B - C * float` -> for big vector. */
 DO_INLINE void sub_lfvector_lfvectorS(
@@ -236,11 +257,12 @@ DO_INLINE void sub_lfvector_lfvector(float (*to)[3],
                                      float (*fLongVectorB)[3],
                                      uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    sub_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
-  }
+  using namespace blender;
+  threading::parallel_for(IndexRange(verts), CLOTH_VERTS_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      sub_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
+    }
+  });
 }
 ///////////////////////////
 // 3x3 matrix
@@ -582,35 +604,86 @@ DO_INLINE void initdiag_bfmatrix(fmatrix3x3 *matrix, float m3[3][3])
   }
 }
 
+/**
+ * The off-diagonal blocks of a big matrix which are in the row or column of every vertex, so that
+ * multiplications can be done for every vertex separately. All big matrices with spring blocks
+ * have the same layout.
+ */
+struct VertBlocks {
+  /* Start of the blocks of every vertex in #blocks, followed by the number of all blocks. */
+  int *offsets;
+  /* Block indices in increasing order, `~index` for blocks in the column of the vertex. */
+  int *blocks;
+};
+
+DO_INLINE void create_vert_blocks(VertBlocks *vert_blocks, uint verts, uint springs)
+{
+  vert_blocks->offsets = (int *)MEM_mallocN(sizeof(int) * (verts + 1),
+                                            "cloth_vert_block_offsets");
+  vert_blocks->blocks = (int *)MEM_mallocN(sizeof(int) * 2 * springs, "cloth_vert_blocks");
+}
+
+DO_INLINE void del_vert_blocks(VertBlocks *vert_blocks)
+{
+  MEM_SAFE_FREE(vert_blocks->offsets);
+  MEM_SAFE_FREE(vert_blocks->blocks);
+}
+
+/* Gather the blocks of all vertices, from the first \a springs spring blocks of the matrix. */
+static void build_vert_blocks(VertBlocks *vert_blocks, const fmatrix3x3 *matrix, uint springs)
+{
+  const uint vcount = matrix[0].vcount;
+  int *offsets = vert_blocks->offsets;
+
+  memset(offsets, 0, sizeof(int) * (vcount + 1));
+  for (uint i = vcount; i < vcount + springs; i++) {
+    offsets[matrix[i].r]++;
+    offsets[matrix[i].c]++;
+  }
+  /* Turn the counts into the end of the blocks of every vertex. */
+  for (uint i = 1; i < vcount; i++) {
+    offsets[i] += offsets[i - 1];
+  }
+  /* Filling in backwards order moves the offsets to the start of the blocks of every vertex. */
+  for (int i = int(vcount + springs) - 1; i >= int(vcount); i--) {
+    vert_blocks->blocks[--offsets[matrix[i].c]] = ~i;
+    vert_blocks->blocks[--offsets[matrix[i].r]] = i;
+  }
+  offsets[vcount] = int(2 * springs);
+}
+
 /* SPARSE SYMMETRIC multiply big matrix with long vector. */
 /* STATUS: verified */
-DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
+DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3],
+                                     fmatrix3x3 *from,
+                                     lfVector *fLongVector,
+                                     const VertBlocks &vert_blocks)
 {
+  using namespace blender;
   uint vcount = from[0].vcount;
-  lfVector *temp = create_lfvector(vcount);
-
-  zero_lfvector(to, vcount);
-
-#  pragma omp parallel sections if (vcount > CLOTH_OPENMP_LIMIT)
-  {
-#  pragma omp section
-    {
-      for (uint i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
-        /* This is the lower triangle of the sparse matrix,
-         * therefore multiplication occurs with transposed sub-matrices. */
-        muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
-      }
-    }
-#  pragma omp section
-    {
-      for (uint i = 0; i < from[0].vcount + from[0].scount; i++) {
-        muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
+
+  /* Every vertex only writes its own row of the result. The operations are done in the same
+   * order as when multiplying all blocks one after another, so the result doesn't depend on
+   * threading. */
+  threading::parallel_for(IndexRange(vcount), CLOTH_VERTS_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      float lower[3] = {0.0f, 0.0f, 0.0f};
+      float upper[3] = {0.0f, 0.0f, 0.0f};
+      muladd_fmatrix_fvector(upper, from[i].m, fLongVector[i]);
+      for (int k = vert_blocks.offsets[i]; k < vert_blocks.offsets[i + 1]; k++) {
+        const int block = vert_blocks.blocks[k];
+        if (block >= 0) {
+          muladd_fmatrix_fvector(upper, from[block].m, fLongVector[from[block].c]);
+        }
+        else {
+          /* This is the lower triangle of the sparse matrix,
+           * therefore multiplication occurs with transposed sub-matrices. */
+          muladd_fmatrixT_fvector(lower, from[~block].m, fLongVector[from[~block].r]);
+        }
       }
+      add_v3_v3v3(to[i], lower, upper);
     }
-  }
-  add_lfvector_lfvector(to, to, temp, from[0].vcount);
-
-  del_lfvector(temp);
+  });
 }
 
 /* SPARSE SYMMETRIC sub big matrix with big matrix. */
@@ -619,12 +692,13 @@ DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector
 DO_INLINE void subadd_bfmatrixS_bfmatrixS(
     fmatrix3x3 *to, fmatrix3x3 *from, float aS, fmatrix3x3 *matrix, float bS)
 {
-  uint i = 0;
-
-  /* process diagonal elements */
-  for (i = 0; i < matrix[0].vcount + matrix[0].scount; i++) {
-    subadd_fmatrixS_fmatrixS(to[i].m, from[i].m, aS, matrix[i].m, bS);
-  }
+  using namespace blender;
+  const IndexRange blocks(matrix[0].vcount + matrix[0].scount);
+  threading::parallel_for(blocks, CLOTH_VERTS_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      subadd_fmatrixS_fmatrixS(to[i].m, from[i].m, aS, matrix[i].m, bS);
+    }
+  });
 }
 
 ///////////////////////////////////////////////////////////////////
@@ -652,6 +726,7 @@ struct Implicit_Data {
   lfVector *z;          /* target velocity in constrained directions */
   fmatrix3x3 *S;        /* filtering matrix for constraints */
   fmatrix3x3 *P, *Pinv; /* pre-conditioning matrix */
+  VertBlocks vert_blocks; /* spring blocks of every vertex */
 };
 
 Implicit_Data *SIM_mass_spring_solver_create(int numverts, int numsprings)
@@ -676,6 +751,7 @@ Implicit_Data *SIM_mass_spring_solver_create(int numverts, int numsprings)
   id->B = create_lfvector(numverts);
   id->dV = create_lfvector(numverts);
   id->z = create_lfvector(numverts);
+  create_vert_blocks(&id->vert_blocks, numverts, numsprings);
 
   initdiag_bfmatrix(id->bigI, I);
 
@@ -702,6 +778,7 @@ void SIM_mass_spring_solver_free(Implicit_Data *id)
   del_lfvector(id->B);
   del_lfvector(id->dV);
   del_lfvector(id->z);
+  del_vert_blocks(&id->vert_blocks);
 
   MEM_freeN(id);
 }
@@ -742,11 +819,13 @@ BLI_INLINE void root_to_world_m3(Implicit_Data *data,
 
 DO_INLINE void filter(lfVector *V, fmatrix3x3 *S)
 {
-  uint i = 0;
-
-  for (i = 0; i < S[0].vcount; i++) {
-    mul_m3_v3(S[i].m, V[S[i].r]);
-  }
+  using namespace blender;
+  threading::parallel_for(
+      IndexRange(S[0].vcount), CLOTH_VERTS_GRAIN_SIZE, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          mul_m3_v3(S[i].m, V[S[i].r]);
+        }
+      });
 }
 
 /* this version of the CG algorithm does not work very well with partial constraints
@@ -821,6 +900,7 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const VertBlocks &vert_blocks,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
@@ -848,7 +928,7 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector(AdV, lA, ldV, vert_blocks);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -871,7 +951,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector(q, lA, c, vert_blocks);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -1131,7 +1211,10 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* Only the spring blocks which were added for the current forces are used. */
+  build_vert_blocks(&data->vert_blocks, data->A, data->num_blocks);
+
+  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V, data->vert_blocks);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1140,7 +1223,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, data->vert_blocks, data->B, data->z, data->S, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
@@ -30,6 +30,7 @@
 #include "WM_types.hh"
 
 struct ARegion;
+struct BlendFileReadDurations;
 struct GHashIterator;
 struct GPUViewport;
 struct ID;
@@ -379,6 +380,10 @@ bool WM_stereo3d_enabled(wmWindow *win, bool skip_stereo3d_check);
 
 void WM_file_autoexec_init(const char *filepath);
 bool WM_file_read(bContext *C, const char *filepath, ReportList *reports);
+/**
+ * Time spent in the different stages of the last successful #WM_file_read.
+ */
+const BlendFileReadDurations *WM_file_read_last_durations_get();
 void WM_file_autosave_init(wmWindowManager *wm);
 bool WM_file_recover_last_session(bContext *C, ReportList *reports);
 void WM_file_tag_modified();
@@ -1608,6 +1613,7 @@ enum eWM_JobType {
   WM_JOB_TYPE_CALCULATE_SIMULATION_NODES,
   WM_JOB_TYPE_BAKE_GEOMETRY_NODES,
   WM_JOB_TYPE_UV_PACK,
+  WM_JOB_TYPE_AUTOSAVE,
   /* Add as needed, bake, seq proxy build
    * if having hard coded values is a problem. */
 };
@@ -500,6 +500,11 @@ void wm_event_do_depsgraph(bContext *C, bool is_after_open_file)
      * and for until then we have to accept ambiguities when object is shared
      * across visible view layers and has overrides on it. */
     Depsgraph *depsgraph = BKE_scene_ensure_depsgraph(bmain, scene, view_layer);
+    if (is_after_open_file || !DEG_is_fully_evaluated(depsgraph)) {
+      /* Update callbacks and evaluation can modify data used by the evaluation of the next
+       * playback frame. */
+      ED_screen_animation_background_evaluation_wait();
+    }
     if (is_after_open_file) {
       DEG_graph_tag_on_visible_update(depsgraph, true);
     }
@@ -542,6 +547,10 @@ static void wm_event_timers_execute(bContext *C)
    * when calling code that assumes that there is always a window in the context (which many
    * operators do). */
   CTX_wm_window_set(C, static_cast<wmWindow *>(wm->windows.first));
+  if (BLI_timer_has_due()) {
+    /* Timers can modify data used by the evaluation of the next playback frame. */
+    ED_screen_animation_background_evaluation_wait();
+  }
   BLI_timer_execute();
   CTX_wm_window_set(C, nullptr);
 }
@@ -3961,11 +3970,35 @@ static eHandlerActionFlag wm_event_do_handlers_area_regions(bContext *C,
   return wm_event_do_region_handlers(C, event, region_hovered);
 }
 
+/**
+ * Check for events other than the timer of the animation playback, which can modify the data
+ * used by the evaluation of the next playback frame.
+ */
+static bool wm_event_queue_has_non_playback_events(const wmWindowManager *wm)
+{
+  const bScreen *screen_playing = ED_screen_animation_playing(wm);
+  LISTBASE_FOREACH (const wmWindow *, win, &wm->windows) {
+    LISTBASE_FOREACH (const wmEvent *, event, &win->event_queue) {
+      if (screen_playing && event->type == TIMER0 &&
+          event->customdata == screen_playing->animtimer)
+      {
+        continue;
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
 void wm_event_do_handlers(bContext *C)
 {
   wmWindowManager *wm = CTX_wm_manager(C);
   BLI_assert(ED_undo_is_state_valid(C));
 
+  if (wm_event_queue_has_non_playback_events(wm)) {
+    ED_screen_animation_background_evaluation_wait();
+  }
+
   /* Begin GPU render boundary - Certain event handlers require GPU usage. */
   GPU_render_begin();
 
@@ -72,6 +72,7 @@
 #include "BKE_context.hh"
 #include "BKE_global.hh"
 #include "BKE_idprop.hh"
+#include "BKE_idtype.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_lib_override.hh"
 #include "BKE_lib_remap.hh"
@@ -900,58 +901,50 @@ static void wm_read_callback_post_wrapper(bContext *C, const char *filepath, con
 /** \name Read Main Blend-File API
  * \{ */
 
-static void file_read_reports_finalize(BlendFileReadReport *bf_reports)
+/** Durations of the last main blend-file read, see #WM_file_read_last_durations_get. */
+static BlendFileReadDurations wm_file_read_last_durations = {};
+
+const BlendFileReadDurations *WM_file_read_last_durations_get()
 {
-  double duration_whole_minutes, duration_whole_seconds;
-  double duration_libraries_minutes, duration_libraries_seconds;
-  double duration_lib_override_minutes, duration_lib_override_seconds;
+  return &wm_file_read_last_durations;
+}
+
+static void file_read_reports_log_duration(const char *label, const double duration)
+{
+  double duration_minutes, duration_seconds;
+  BLI_math_time_seconds_decompose(
+      duration, nullptr, nullptr, &duration_minutes, &duration_seconds, nullptr);
+  CLOG_INFO(&LOG, 0, "%s: %.0fm%.2fs", label, duration_minutes, duration_seconds);
+}
+
+static void file_read_reports_finalize(Main *bmain, BlendFileReadReport *bf_reports)
+{
+  const BlendFileReadDurations &duration = bf_reports->duration;
+  wm_file_read_last_durations = duration;
+
   double duration_lib_override_resync_minutes, duration_lib_override_resync_seconds;
   double duration_lib_override_recursive_resync_minutes,
       duration_lib_override_recursive_resync_seconds;
 
-  BLI_math_time_seconds_decompose(bf_reports->duration.whole,
-                                  nullptr,
-                                  nullptr,
-                                  &duration_whole_minutes,
-                                  &duration_whole_seconds,
-                                  nullptr);
-  BLI_math_time_seconds_decompose(bf_reports->duration.libraries,
-                                  nullptr,
-                                  nullptr,
-                                  &duration_libraries_minutes,
-                                  &duration_libraries_seconds,
-                                  nullptr);
-  BLI_math_time_seconds_decompose(bf_reports->duration.lib_overrides,
-                                  nullptr,
-                                  nullptr,
-                                  &duration_lib_override_minutes,
-                                  &duration_lib_override_seconds,
-                                  nullptr);
-  BLI_math_time_seconds_decompose(bf_reports->duration.lib_overrides_resync,
+  BLI_math_time_seconds_decompose(duration.lib_overrides_resync,
                                   nullptr,
                                   nullptr,
                                   &duration_lib_override_resync_minutes,
                                   &duration_lib_override_resync_seconds,
                                   nullptr);
-  BLI_math_time_seconds_decompose(bf_reports->duration.lib_overrides_recursive_resync,
+  BLI_math_time_seconds_decompose(duration.lib_overrides_recursive_resync,
                                   nullptr,
                                   nullptr,
                                   &duration_lib_override_recursive_resync_minutes,
                                   &duration_lib_override_recursive_resync_seconds,
                                   nullptr);
 
-  CLOG_INFO(
-      &LOG, 0, "Blender file read in %.0fm%.2fs", duration_whole_minutes, duration_whole_seconds);
-  CLOG_INFO(&LOG,
-            0,
-            " * Loading libraries: %.0fm%.2fs",
-            duration_libraries_minutes,
-            duration_libraries_seconds);
-  CLOG_INFO(&LOG,
-            0,
-            " * Applying overrides: %.0fm%.2fs",
-            duration_lib_override_minutes,
-            duration_lib_override_seconds);
+  file_read_reports_log_duration("Blender file read in", duration.whole);
+  file_read_reports_log_duration(" * Reading data", duration.read_data);
+  file_read_reports_log_duration(" * Versioning", duration.versioning);
+  file_read_reports_log_duration(" * Loading libraries", duration.libraries);
+  file_read_reports_log_duration("   * Linking data", duration.lib_link);
+  file_read_reports_log_duration(" * Applying overrides", duration.lib_overrides);
   CLOG_INFO(&LOG,
             0,
             " * Resyncing overrides: %.0fm%.2fs (%d root overrides), including recursive "
@@ -961,6 +954,22 @@ static void file_read_reports_finalize(BlendFileReadReport *bf_reports)
             bf_reports->count.resynced_lib_overrides,
             duration_lib_override_recursive_resync_minutes,
             duration_lib_override_recursive_resync_seconds);
+  file_read_reports_log_duration(" * Setting up data", duration.setup);
+  file_read_reports_log_duration(" * Post-read handling", duration.post);
+
+  if (CLOG_CHECK(&LOG, 1)) {
+    ListBase *lb;
+    FOREACH_MAIN_LISTBASE_BEGIN (bmain, lb) {
+      if (const ID *id = static_cast<const ID *>(lb->first)) {
+        CLOG_INFO(&LOG,
+                  1,
+                  " * %s: %d",
+                  BKE_idtype_idcode_to_name_plural(GS(id->name)),
+                  BLI_listbase_count(lb));
+      }
+    }
+    FOREACH_MAIN_LISTBASE_END;
+  }
 
   if (bf_reports->resynced_lib_overrides_libraries_count != 0) {
     for (LinkNode *node_lib = bf_reports->resynced_lib_overrides_libraries; node_lib != nullptr;
@@ -1081,6 +1090,7 @@ bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
       const int G_f_orig = G.f;
 
       /* Frees the current main and replaces it with the new one read from file. */
+      bf_reports.duration.setup = BLI_time_now_seconds();
       BKE_blendfile_read_setup_readfile(
           C, bfd, &params, wm_setup_data, &bf_reports, false, nullptr);
       bmain = CTX_data_main(C);
@@ -1088,6 +1098,7 @@ bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
       /* Finalize handling of WM, using the read WM and/or the current WM depending on things like
        * whether the UI is loaded from the .blend file or not, etc. */
       wm_file_read_setup_wm_finalize(C, bmain, wm_setup_data);
+      bf_reports.duration.setup = BLI_time_now_seconds() - bf_reports.duration.setup;
 
       if (G.f != G_f_orig) {
         const int flags_keep = G_FLAG_ALL_RUNTIME;
@@ -1109,10 +1120,12 @@ bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
       read_file_post_params.reset_app_template = false;
       read_file_post_params.success = true;
       read_file_post_params.is_alloc = false;
+      bf_reports.duration.post = BLI_time_now_seconds();
       wm_file_read_post(C, filepath, &read_file_post_params);
+      bf_reports.duration.post = BLI_time_now_seconds() - bf_reports.duration.post;
 
       bf_reports.duration.whole = BLI_time_now_seconds() - bf_reports.duration.whole;
-      file_read_reports_finalize(&bf_reports);
+      file_read_reports_finalize(CTX_data_main(C), &bf_reports);
 
       success = true;
     }
@@ -2186,6 +2199,19 @@ bool WM_autosave_is_scheduled(wmWindowManager *wm)
   return wm->autosave_scheduled;
 }
 
+static void wm_autosave_write_startjob(void *customdata, wmJobWorkerStatus *worker_status)
+{
+  const BlendFileDeferredWrite *deferred_write = static_cast<BlendFileDeferredWrite *>(
+      customdata);
+  BLO_write_file_deferred_finish(deferred_write, worker_status->reports, &worker_status->progress);
+  worker_status->do_update = true;
+}
+
+static void wm_autosave_write_freejob(void *customdata)
+{
+  BLO_write_file_deferred_free(static_cast<BlendFileDeferredWrite *>(customdata));
+}
+
 void WM_autosave_write(wmWindowManager *wm, Main *bmain)
 {
   ED_editors_flush_edits(bmain);
@@ -2197,7 +2223,24 @@ void WM_autosave_write(wmWindowManager *wm, Main *bmain)
 
   /* Error reporting into console. */
   BlendFileWriteParams params{};
-  BLO_write_file(bmain, filepath, fileflags, &params, nullptr);
+  if (G.background) {
+    BLO_write_file(bmain, filepath, fileflags, &params, nullptr);
+  }
+  else if (!WM_jobs_test(wm, wm, WM_JOB_TYPE_AUTOSAVE)) {
+    /* Only serialize the data here, writing it to disk can be slow (e.g. on network drives), so
+     * do that in a background job to avoid blocking the UI. If the previous auto-save is still
+     * being written, skip this one. */
+    if (BlendFileDeferredWrite *deferred_write = BLO_write_file_deferred_begin(
+            bmain, filepath, fileflags, &params, nullptr))
+    {
+      wmJob *wm_job = WM_jobs_get(
+          wm, nullptr, wm, "Auto-Saving", WM_JOB_PROGRESS, WM_JOB_TYPE_AUTOSAVE);
+      WM_jobs_customdata_set(wm_job, deferred_write, wm_autosave_write_freejob);
+      WM_jobs_timer(wm_job, 0.1, 0, 0);
+      WM_jobs_callbacks(wm_job, wm_autosave_write_startjob, nullptr, nullptr, nullptr);
+      WM_jobs_start(wm, wm_job);
+    }
+  }
 
   /* Restart auto-save timer. */
   wm_autosave_timer_end(wm);
@@ -27,6 +27,7 @@
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_time.h"
 #include "BLI_timer.h"
 #include "BLI_utildefines.h"
 
@@ -194,8 +195,24 @@ static void sound_jack_sync_callback(Main *bmain, int mode, double time)
   }
 }
 
+/**
+ * Print the time spent in a stage of #WM_init since \a r_time_stage with `--debug-startup`,
+ * and reset \a r_time_stage for the next stage.
+ */
+static void wm_init_stage_time_print(const char *stage, double *r_time_stage)
+{
+  if ((G.debug & G_DEBUG_STARTUP) == 0) {
+    return;
+  }
+  const double time = BLI_time_now_seconds();
+  printf("Startup: %-32s %9.4f s\n", stage, time - *r_time_stage);
+  *r_time_stage = time;
+}
+
 void WM_init(bContext *C, int argc, const char **argv)
 {
+  const double time_start = BLI_time_now_seconds();
+  double time_stage = time_start;
 
   if (!G.background) {
     wm_ghost_init(C); /* NOTE: it assigns C to ghost! */
@@ -222,6 +239,7 @@ void WM_init(bContext *C, int argc, const char **argv)
   BKE_library_callback_remap_editor_id_reference_set(WM_main_remap_editor_id_reference);
   BKE_spacedata_callback_id_remap_set(ED_spacedata_id_remap_single);
   DEG_editors_set_update_cb(ED_render_id_flush_update, ED_render_scene_update);
+  wm_init_stage_time_print("Types registration", &time_stage);
 
   ED_spacetypes_init();
 
@@ -233,6 +251,7 @@ void WM_init(bContext *C, int argc, const char **argv)
   /* Must call first before doing any `.blend` file reading,
    * since versioning code may create new IDs. See #57066. */
   BLT_lang_set(nullptr);
+  wm_init_stage_time_print("Space-types, fonts & translation", &time_stage);
 
   /* Init icons & previews before reading .blend files for preview icons, which can
    * get triggered by the depsgraph. This is also done in background mode
@@ -245,6 +264,7 @@ void WM_init(bContext *C, int argc, const char **argv)
   /* Studio-lights needs to be init before we read the home-file,
    * otherwise the versioning cannot find the default studio-light. */
   BKE_studiolight_init();
+  wm_init_stage_time_print("Icons & studio-lights", &time_stage);
 
   BLI_assert((G.fileflags & G_FILE_NO_UI) == 0);
 
@@ -281,6 +301,7 @@ void WM_init(bContext *C, int argc, const char **argv)
   /* NOTE: leave `G_MAIN->filepath` set to an empty string since this
    * matches behavior after loading a new file. */
   BLI_assert(G_MAIN->filepath[0] == '\0');
+  wm_init_stage_time_print("Startup & preferences files", &time_stage);
 
   /* Call again to set from preferences. */
   BLT_lang_set(nullptr);
@@ -305,15 +326,18 @@ void WM_init(bContext *C, int argc, const char **argv)
     UI_init();
     GPU_context_end_frame(GPU_context_active_get());
     GPU_render_end();
+    wm_init_stage_time_print("GPU & interface", &time_stage);
   }
 
   blender::bke::subdiv::init();
 
   ED_spacemacros_init();
+  wm_init_stage_time_print("Operator macros", &time_stage);
 
 #ifdef WITH_PYTHON
   BPY_python_start(C, argc, argv);
   BPY_python_reset(C);
+  wm_init_stage_time_print("Python & scripts", &time_stage);
 #else
   UNUSED_VARS(argc, argv);
 #endif
@@ -344,15 +368,23 @@ void WM_init(bContext *C, int argc, const char **argv)
   WM_keyconfig_update_postpone_begin();
 
   WM_keyconfig_init(C);
+  wm_init_stage_time_print("Key-maps", &time_stage);
 
   /* Load add-ons after key-maps have been initialized (but before the blend file has been read),
    * important to guarantee default key-maps have been declared & before post-read handlers run. */
   wm_init_scripts_extensions_once(C);
+  wm_init_stage_time_print("Add-ons & extensions", &time_stage);
 
   WM_keyconfig_update_postpone_end();
   WM_keyconfig_update(static_cast<wmWindowManager *>(G_MAIN->wm.first));
+  wm_init_stage_time_print("Key-maps update", &time_stage);
 
   wm_homefile_read_post(C, params_file_read_post);
+  wm_init_stage_time_print("Startup file post-read", &time_stage);
+
+  if (G.debug & G_DEBUG_STARTUP) {
+    printf("Startup: %-32s %9.4f s\n", "Total", BLI_time_now_seconds() - time_start);
+  }
 }
 
 static bool wm_init_splash_show_on_startup_check()
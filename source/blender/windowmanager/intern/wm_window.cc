@@ -1782,9 +1782,12 @@ static bool wm_window_timers_process(const bContext *C, int *sleep_us_p)
     }
 
     if (wt->event_type == TIMERJOBS) {
+      /* Finished jobs write their results to the main database. */
+      ED_screen_animation_background_evaluation_wait();
       wm_jobs_timer(wm, wt);
     }
     else if (wt->event_type == TIMERAUTOSAVE) {
+      ED_screen_animation_background_evaluation_wait();
       wm_autosave_timer(bmain, wm, wt);
     }
     else if (wt->event_type == TIMERNOTIFIER) {
@@ -9,8 +9,12 @@
 #ifndef WITH_PYTHON_MODULE
 
 #  include <cerrno>
+#  include <chrono>
+#  include <condition_variable>
 #  include <cstdlib>
 #  include <cstring>
+#  include <mutex>
+#  include <thread>
 
 #  include "MEM_guardedalloc.h"
 
@@ -28,13 +32,16 @@
 #  include "BLI_string.h"
 #  include "BLI_string_utf8.h"
 #  include "BLI_system.h"
+#  include "BLI_task_trace.hh"
 #  include "BLI_threads.h"
+#  include "BLI_timeit.hh"
 #  include "BLI_utildefines.h"
 #  ifndef NDEBUG
 #    include "BLI_mempool.h"
 #  endif
 
 #  include "BKE_appdir.hh"
+#  include "BKE_blender.hh"
 #  include "BKE_blender_cli_command.hh"
 #  include "BKE_blender_version.h"
 #  include "BKE_blendfile.hh"
@@ -739,6 +746,10 @@ static void print_help(bArgs *ba, bool all)
   }
   BLI_args_print_arg_doc(ba, "--debug-memory");
   BLI_args_print_arg_doc(ba, "--debug-jobs");
+  BLI_args_print_arg_doc(ba, "--debug-startup");
+  BLI_args_print_arg_doc(ba, "--debug-task-trace");
+  BLI_args_print_arg_doc(ba, "--debug-timer-stats");
+  BLI_args_print_arg_doc(ba, "--debug-memory-categories");
   BLI_args_print_arg_doc(ba, "--debug-python");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-eval");
@@ -1274,6 +1285,9 @@ static const char arg_handle_debug_mode_generic_set_doc_xr_time[] =
 static const char arg_handle_debug_mode_generic_set_doc_jobs[] =
     "\n\t"
     "Enable time profiling for background jobs.";
+static const char arg_handle_debug_mode_generic_set_doc_startup[] =
+    "\n\t"
+    "Enable time profiling of the startup, for each initialization stage and each add-on.";
 static const char arg_handle_debug_mode_generic_set_doc_depsgraph[] =
     "\n\t"
     "Enable all debug messages from dependency graph.";
@@ -1385,6 +1399,134 @@ static int arg_handle_debug_value_set(int argc, const char **argv, void * /*data
   return 0;
 }
 
+static char debug_task_trace_filepath[FILE_MAX] = "";
+
+static void debug_task_trace_write_atexit(void * /*user_data*/)
+{
+  blender::threading::trace::stop();
+  if (!blender::threading::trace::chrome_trace_write(debug_task_trace_filepath)) {
+    fprintf(stderr, "Error: unable to write task trace to '%s'\n", debug_task_trace_filepath);
+  }
+}
+
+static const char arg_handle_debug_task_trace_set_doc[] =
+    "<filepath>\n"
+    "\tRecord the execution of threaded tasks and write it to <filepath> on exit.\n"
+    "\tThe trace uses the Chrome trace event format, it can be viewed with 'chrome://tracing'\n"
+    "\tor 'https://ui.perfetto.dev'.";
+static int arg_handle_debug_task_trace_set(int argc, const char **argv, void * /*data*/)
+{
+  const char *arg_id = "--debug-task-trace";
+  if (argc > 1) {
+    if (debug_task_trace_filepath[0] == '\0') {
+      BKE_blender_atexit_register(debug_task_trace_write_atexit, nullptr);
+    }
+    STRNCPY(debug_task_trace_filepath, argv[1]);
+    BLI_path_abs_from_cwd(debug_task_trace_filepath, sizeof(debug_task_trace_filepath));
+    blender::threading::trace::start();
+    return 1;
+  }
+  fprintf(stderr, "\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+
+static void debug_timer_stats_print_atexit(void * /*user_data*/)
+{
+  const std::string report = blender::timeit::timer_stats_report();
+  printf("Timer statistics:\n%s", report.c_str());
+}
+
+static const char arg_handle_debug_timer_stats_set_doc[] =
+    "\n"
+    "\tAccumulate the timing statistics of instrumented code and print them on exit.";
+static int arg_handle_debug_timer_stats_set(int /*argc*/, const char ** /*argv*/, void * /*data*/)
+{
+  if (!blender::timeit::timer_stats_enabled()) {
+    BKE_blender_atexit_register(debug_timer_stats_print_atexit, nullptr);
+  }
+  blender::timeit::timer_stats_enable(true);
+  return 0;
+}
+
+/** Periodically prints the memory usage per category, for e.g. monitoring render farm jobs. */
+struct MemoryCategoriesLogger {
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool stop = false;
+  std::thread thread;
+};
+/* Never freed, so that the thread is still joinable when the process exits without #WM_exit. */
+static MemoryCategoriesLogger *debug_memory_categories_logger = nullptr;
+
+static void debug_memory_categories_print()
+{
+  printf("Memory categories:");
+  for (int i = 0; i < MEM_CATEGORY_NUM; i++) {
+    const eMEM_Category category = eMEM_Category(i);
+    char in_use_str[BLI_STR_FORMAT_INT64_BYTE_UNIT_SIZE];
+    BLI_str_format_byte_unit(in_use_str, int64_t(MEM_category_get_memory_in_use(category)), false);
+    if (category == MEM_CATEGORY_OTHER) {
+      printf(" %s %s", MEM_category_name(category), in_use_str);
+      continue;
+    }
+    char peak_str[BLI_STR_FORMAT_INT64_BYTE_UNIT_SIZE];
+    BLI_str_format_byte_unit(peak_str, int64_t(MEM_category_get_peak_memory(category)), false);
+    printf(", %s %s (peak %s)", MEM_category_name(category), in_use_str, peak_str);
+  }
+  printf("\n");
+  fflush(stdout);
+}
+
+static void debug_memory_categories_print_atexit(void * /*user_data*/)
+{
+  if (MemoryCategoriesLogger *logger = debug_memory_categories_logger) {
+    {
+      std::lock_guard lock{logger->mutex};
+      logger->stop = true;
+    }
+    logger->condition.notify_one();
+    logger->thread.join();
+  }
+  debug_memory_categories_print();
+}
+
+static const char arg_handle_debug_memory_categories_set_doc[] =
+    "<seconds>\n"
+    "\tAttribute memory to categories like meshes, images and draw caches, and print the memory\n"
+    "\tusage per category every <seconds> and on exit. Use 0 to only print it on exit.";
+static int arg_handle_debug_memory_categories_set(int argc, const char **argv, void * /*data*/)
+{
+  const char *arg_id = "--debug-memory-categories";
+  if (argc > 1) {
+    const char *err_msg = nullptr;
+    int interval;
+    if (!parse_int_clamp(argv[1], nullptr, 0, INT_MAX, &interval, &err_msg)) {
+      fprintf(stderr, "\nError: %s '%s %s'.\n", err_msg, arg_id, argv[1]);
+      return 1;
+    }
+    if (MEM_memory_categories_enabled()) {
+      return 1;
+    }
+    MEM_use_memory_categories(true);
+    BKE_blender_atexit_register(debug_memory_categories_print_atexit, nullptr);
+    if (interval > 0) {
+      MemoryCategoriesLogger *logger = new MemoryCategoriesLogger();
+      logger->thread = std::thread([logger, interval]() {
+        std::unique_lock lock{logger->mutex};
+        while (!logger->condition.wait_for(
+            lock, std::chrono::seconds(interval), [&]() { return logger->stop; }))
+        {
+          debug_memory_categories_print();
+        }
+      });
+      debug_memory_categories_logger = logger;
+    }
+    return 1;
+  }
+  fprintf(stderr, "\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+
 static const char arg_handle_debug_gpu_set_doc[] =
     "\n"
     "\tEnable GPU debug context and information for OpenGL 4.3+.";
@@ -2719,6 +2861,19 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
                "--debug-jobs",
                CB_EX(arg_handle_debug_mode_generic_set, jobs),
                (void *)G_DEBUG_JOBS);
+  BLI_args_add(ba,
+               nullptr,
+               "--debug-startup",
+               CB_EX(arg_handle_debug_mode_generic_set, startup),
+               (void *)G_DEBUG_STARTUP);
+  BLI_args_add(ba, nullptr, "--debug-task-trace", CB(arg_handle_debug_task_trace_set), nullptr);
+  BLI_args_add(
+      ba, nullptr, "--debug-timer-stats", CB(arg_handle_debug_timer_stats_set), nullptr);
+  BLI_args_add(ba,
+               nullptr,
+               "--debug-memory-categories",
+               CB(arg_handle_debug_memory_categories_set),
+               nullptr);
   BLI_args_add(ba, nullptr, "--debug-gpu", CB(arg_handle_debug_gpu_set), nullptr);
   BLI_args_add(ba,
                nullptr,
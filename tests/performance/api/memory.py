@@ -0,0 +1,39 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# Memory usage of the Blender process, for tests to report a `peak_memory` output in bytes
+# from the function that runs in Blender.
+
+import sys
+
+
+def reset_peak_memory() -> None:
+    # Reset the peak memory to the current memory usage, so only the memory used by the measured
+    # part of a test is reported. Only supported on Linux, elsewhere the peak memory of the whole
+    # process is reported.
+    try:
+        with open('/proc/self/clear_refs', 'w') as f:
+            f.write('5')
+    except OSError:
+        pass
+
+
+def peak_memory() -> float:
+    # Peak resident memory of the process in bytes, or -1.0 when not supported by the platform.
+    try:
+        with open('/proc/self/status') as f:
+            for line in f:
+                if line.startswith('VmHWM:'):
+                    return float(line.split()[1]) * 1024
+    except OSError:
+        pass
+
+    try:
+        import resource
+    except ImportError:
+        return -1.0
+
+    peak = float(resource.getrusage(resource.RUSAGE_SELF).ru_maxrss)
+    # Reported in bytes on macOS, kilobytes elsewhere.
+    return peak if sys.platform == 'darwin' else peak * 1024
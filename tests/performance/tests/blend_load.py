@@ -19,6 +19,10 @@ def _run(filepath):
     elapsed_time = time.time() - start_time
 
     result = {'time': elapsed_time}
+    # Break down the time spent in the different stages of loading.
+    for stage, duration in bpy.app.file_read_durations.items():
+        if stage != 'whole':
+            result['time_' + stage] = duration
     return result
 
 
@@ -0,0 +1,65 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _run(args):
+    import bpy
+    import time
+
+    scene = bpy.context.scene
+    scene.render.use_compositing = True
+    scene.render.compositor_device = args['device']
+
+    # The benchmark files are expected to have no Render Layers node, so rendering only executes
+    # the compositor. Execute once first to not measure the shader compilation of the GPU
+    # compositor and the loading of images.
+    bpy.ops.render.render()
+
+    api.reset_peak_memory()
+
+    test_time_start = time.time()
+    measured_times = []
+
+    min_measurements = 5
+    max_measurements = 100
+    timeout = 10
+
+    while True:
+        start_time = time.time()
+        bpy.ops.render.render()
+        elapsed_time = time.time() - start_time
+        measured_times.append(elapsed_time)
+
+        if len(measured_times) >= min_measurements and test_time_start + timeout < time.time():
+            break
+        if len(measured_times) >= max_measurements:
+            break
+
+    average_time = sum(measured_times) / len(measured_times)
+    result = {'time': average_time, 'peak_memory': api.peak_memory()}
+    return result
+
+
+class CompositorTest(api.Test):
+    def __init__(self, filepath, device):
+        self.filepath = filepath
+        self.device = device
+
+    def name(self):
+        return f"{self.filepath.stem}_{self.device.lower()}"
+
+    def category(self):
+        return "compositor"
+
+    def run(self, env, device_id):
+        args = {'device': self.device}
+        result, _ = env.run_in_blender(_run, args, [self.filepath])
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('compositor/*')
+    return [CompositorTest(filepath, device) for filepath in filepaths for device in ('CPU', 'GPU')]
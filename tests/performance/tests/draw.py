@@ -0,0 +1,78 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+LOG_KEY = "DRAW_PERFORMANCE: "
+
+
+def _run(args):
+    import bpy
+    import time
+
+    window = bpy.context.window_manager.windows[0]
+    area = next(area for area in window.screen.areas if area.type == 'VIEW_3D')
+    area.spaces[0].shading.type = 'SOLID'
+
+    meshes = {ob.data for ob in bpy.context.view_layer.objects if ob.type == 'MESH'}
+
+    with bpy.context.temp_override(window=window, area=area):
+        # Draw once first to not measure shader compilation.
+        bpy.ops.wm.redraw_timer(type='DRAW', iterations=1)
+
+        api.reset_peak_memory()
+
+        num_iterations = 10
+
+        # Redraw without changes, to separate the draw time from the extraction time.
+        start_time = time.time()
+        bpy.ops.wm.redraw_timer(type='DRAW', iterations=num_iterations)
+        draw_time = (time.time() - start_time) / num_iterations
+
+        # Tag all meshes as changed, so every redraw extracts the batch caches again.
+        start_time = time.time()
+        for _ in range(num_iterations):
+            for mesh in meshes:
+                mesh.update()
+            bpy.ops.wm.redraw_timer(type='DRAW', iterations=1)
+        extract_time = (time.time() - start_time) / num_iterations
+
+    result = {'time': extract_time - draw_time,
+              'time_draw': draw_time,
+              'peak_memory': api.peak_memory()}
+    print(f"{LOG_KEY}{result}")
+
+    # Results are read from the log, quit once the event loop runs.
+    bpy.app.timers.register(lambda: bpy.ops.wm.quit_blender(), first_interval=0.0)
+
+
+class DrawExtractTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "draw"
+
+    def use_background(self):
+        return False
+
+    def run(self, env, device_id):
+        args = {}
+        _, log = env.run_in_blender(_run, args, [self.filepath], foreground=True)
+        for line in log:
+            if line.startswith(LOG_KEY):
+                result_str = line[len(LOG_KEY):]
+                result = eval(result_str)
+                return result
+
+        raise Exception("No draw performance result found in log.")
+
+
+def generate(env):
+    # The benchmark files are expected to contain a 3D viewport in the active screen.
+    filepaths = env.find_blend_files('draw/*')
+    return [DrawExtractTest(filepath) for filepath in filepaths]
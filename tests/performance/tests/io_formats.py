@@ -0,0 +1,105 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+FORMATS = {
+    # Format: (file extension, build option required for the format or None).
+    'obj': ('.obj', None),
+    'ply': ('.ply', None),
+    'usd': ('.usdc', 'usd'),
+    'alembic': ('.abc', 'alembic'),
+}
+
+
+def _export(format, filepath):
+    import bpy
+
+    if format == 'obj':
+        bpy.ops.wm.obj_export(filepath=filepath)
+    elif format == 'ply':
+        bpy.ops.wm.ply_export(filepath=filepath)
+    elif format == 'usd':
+        bpy.ops.wm.usd_export(filepath=filepath)
+    elif format == 'alembic':
+        bpy.ops.wm.alembic_export(filepath=filepath, as_background_job=False)
+
+
+def _import(format, filepath):
+    import bpy
+
+    if format == 'obj':
+        bpy.ops.wm.obj_import(filepath=filepath)
+    elif format == 'ply':
+        bpy.ops.wm.ply_import(filepath=filepath)
+    elif format == 'usd':
+        bpy.ops.wm.usd_import(filepath=filepath)
+    elif format == 'alembic':
+        bpy.ops.wm.alembic_import(filepath=filepath, as_background_job=False)
+
+
+def _run(args):
+    import bpy
+    import time
+
+    format = args['format']
+    filepath = args['filepath']
+
+    # Export once to ensure the scene is evaluated and the output is cached by the OS.
+    _export(format, filepath)
+
+    if args['direction'] == 'export':
+        api.reset_peak_memory()
+        start_time = time.time()
+        _export(format, filepath)
+        elapsed_time = time.time() - start_time
+    else:
+        bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+        api.reset_peak_memory()
+        start_time = time.time()
+        _import(format, filepath)
+        elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time, 'peak_memory': api.peak_memory()}
+    return result
+
+
+def _build_options(args):
+    import bpy
+    return {option: getattr(bpy.app.build_options, option) for option in ('usd', 'alembic')}
+
+
+class IOTest(api.Test):
+    def __init__(self, filepath, format, direction):
+        self.filepath = filepath
+        self.format = format
+        self.direction = direction
+
+    def name(self):
+        return f"{self.filepath.stem}_{self.format}_{self.direction}"
+
+    def category(self):
+        return "io"
+
+    def run(self, env, device_id):
+        extension, build_option = FORMATS[self.format]
+        if build_option:
+            build_options, _ = env.run_in_blender(_build_options, {})
+            if not build_options.get(build_option):
+                raise Exception(f"Blender is built without {build_option} support")
+
+        args = {'format': self.format,
+                'direction': self.direction,
+                'filepath': str(env.log_file.parent / (env.log_file.stem + extension))}
+        result, _ = env.run_in_blender(_run, args, [self.filepath])
+        return result
+
+
+def generate(env):
+    # The benchmark files contain the scenes to export, and to import again after exporting them.
+    filepaths = env.find_blend_files('io/*')
+    return [IOTest(filepath, format, direction)
+            for filepath in filepaths
+            for format in FORMATS
+            for direction in ('import', 'export')]
@@ -0,0 +1,128 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import time
+
+LOG_KEY = "SEQUENCER_PERFORMANCE: "
+
+
+def _run_render(args):
+    import bpy
+
+    scene = bpy.context.scene
+    scene.render.use_sequencer = True
+
+    # Disable the caches, every frame is rendered from the strips.
+    ed = scene.sequence_editor
+    ed.use_cache_raw = False
+    ed.use_cache_preprocessed = False
+    ed.use_cache_composite = False
+    ed.use_cache_final = False
+
+    api.reset_peak_memory()
+
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_frames = 0
+
+    while elapsed_time < 10.0:
+        for i in range(scene.frame_start, scene.frame_end + 1):
+            scene.frame_set(i)
+            bpy.ops.render.render()
+
+        num_frames += scene.frame_end + 1 - scene.frame_start
+        elapsed_time = time.time() - start_time
+
+    time_per_frame = elapsed_time / num_frames
+
+    result = {'time': time_per_frame, 'peak_memory': api.peak_memory()}
+    return result
+
+
+def _run_prefetch(args):
+    import bpy
+
+    global start_record_time
+    start_record_time = None
+
+    scene = bpy.context.scene
+    scene.sync_mode = 'NONE'
+    scene.sequence_editor.use_prefetch = True
+    scene.frame_set(scene.frame_start)
+
+    # Play back in the first sequencer preview of the file, with an empty cache so all frames
+    # are produced by the prefetching while playing.
+    window = bpy.context.window_manager.windows[0]
+    area = next(area for area in window.screen.areas if area.type == 'SEQUENCE_EDITOR')
+    with bpy.context.temp_override(window=window, area=area):
+        bpy.ops.sequencer.refresh_all()
+        api.reset_peak_memory()
+        bpy.app.handlers.frame_change_post.append(_prefetch_frame_change_handler)
+        bpy.ops.screen.animation_play()
+
+
+def _prefetch_frame_change_handler(scene):
+    import bpy
+
+    global start_record_time
+
+    if start_record_time is None:
+        start_record_time = time.perf_counter()
+    elif scene.frame_current == scene.frame_end:
+        elapsed_time = time.perf_counter() - start_record_time
+        num_frames = scene.frame_end - scene.frame_start
+        bpy.ops.screen.animation_cancel()
+        bpy.app.handlers.frame_change_post.remove(_prefetch_frame_change_handler)
+        result = {'time': elapsed_time / num_frames, 'peak_memory': api.peak_memory()}
+        print(f"{LOG_KEY}{result}")
+        bpy.ops.wm.quit_blender()
+
+
+class SequencerRenderTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return f"{self.filepath.stem}_render"
+
+    def category(self):
+        return "sequencer"
+
+    def run(self, env, device_id):
+        args = {}
+        result, _ = env.run_in_blender(_run_render, args, [self.filepath])
+        return result
+
+
+class SequencerPrefetchTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return f"{self.filepath.stem}_prefetch"
+
+    def category(self):
+        return "sequencer"
+
+    def use_background(self):
+        return False
+
+    def run(self, env, device_id):
+        args = {}
+        _, log = env.run_in_blender(_run_prefetch, args, [self.filepath], foreground=True)
+        for line in log:
+            if line.startswith(LOG_KEY):
+                result_str = line[len(LOG_KEY):]
+                result = eval(result_str)
+                return result
+
+        raise Exception("No sequencer playback performance result found in log.")
+
+
+def generate(env):
+    # The benchmark files are expected to contain a sequencer preview in the active screen.
+    filepaths = env.find_blend_files('sequencer/*')
+    return ([SequencerRenderTest(filepath) for filepath in filepaths] +
+            [SequencerPrefetchTest(filepath) for filepath in filepaths])
@@ -0,0 +1,80 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+LOG_KEY = "UNDO_PERFORMANCE: "
+NUM_STEPS = 20
+
+
+def _run(args):
+    import bpy
+    import time
+
+    # Global undo operators need a window, run them in the first one.
+    window = bpy.context.window_manager.windows[0]
+    with bpy.context.temp_override(window=window):
+        objects = [ob for ob in bpy.context.view_layer.objects if ob.library is None]
+        bpy.ops.ed.undo_push(message="Initial")
+
+        api.reset_peak_memory()
+
+        # Memfile undo steps that each change a few objects of the file.
+        push_time = 0.0
+        for i in range(NUM_STEPS):
+            for ob in objects[i::NUM_STEPS]:
+                ob.location.x += 1.0
+            start_time = time.time()
+            bpy.ops.ed.undo_push(message=f"Step {i}")
+            push_time += time.time() - start_time
+
+        start_time = time.time()
+        for _ in range(NUM_STEPS):
+            bpy.ops.ed.undo()
+        undo_time = time.time() - start_time
+
+        start_time = time.time()
+        for _ in range(NUM_STEPS):
+            bpy.ops.ed.redo()
+        redo_time = time.time() - start_time
+
+    result = {'time': (undo_time + redo_time) / (2 * NUM_STEPS),
+              'time_push': push_time / NUM_STEPS,
+              'time_undo': undo_time / NUM_STEPS,
+              'time_redo': redo_time / NUM_STEPS,
+              'peak_memory': api.peak_memory()}
+    print(f"{LOG_KEY}{result}")
+
+    # Results are read from the log, quit once the event loop runs.
+    bpy.app.timers.register(lambda: bpy.ops.wm.quit_blender(), first_interval=0.0)
+
+
+class UndoTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "undo"
+
+    def use_background(self):
+        return False
+
+    def run(self, env, device_id):
+        args = {}
+        _, log = env.run_in_blender(_run, args, [self.filepath], foreground=True)
+        for line in log:
+            if line.startswith(LOG_KEY):
+                result_str = line[len(LOG_KEY):]
+                result = eval(result_str)
+                return result
+
+        raise Exception("No undo performance result found in log.")
+
+
+def generate(env):
+    filepaths = env.find_blend_files('undo/*')
+    return [UndoTest(filepath) for filepath in filepaths]